@@ -19,14 +19,14 @@
 
 namespace pw::allocator::internal {
 
-// GenericBlockAllocatorBenchmark methods
+// GenericAllocatorBenchmark methods
 
-void GenericBlockAllocatorBenchmark::BeforeAllocate(const Layout& layout) {
+void GenericAllocatorBenchmark::BeforeAllocate(const Layout& layout) {
   size_ = layout.size();
   DoBefore();
 }
 
-void GenericBlockAllocatorBenchmark::AfterAllocate(const void* ptr) {
+void GenericAllocatorBenchmark::AfterAllocate(const void* ptr) {
   DoAfter();
   if (ptr == nullptr) {
     data_.failed = true;
@@ -36,12 +36,13 @@ void GenericBlockAllocatorBenchmark::AfterAllocate(const void* ptr) {
   Update();
 }
 
-void GenericBlockAllocatorBenchmark::BeforeDeallocate(const void* ptr) {
-  size_ = GetBlockInnerSize(ptr);
+void GenericAllocatorBenchmark::BeforeDeallocate(const void* ptr,
+                                                 const Layout& layout) {
+  size_ = GetInnerSize(ptr, layout);
   DoBefore();
 }
 
-void GenericBlockAllocatorBenchmark::AfterDeallocate() {
+void GenericAllocatorBenchmark::AfterDeallocate() {
   DoAfter();
   data_.failed = false;
   PW_CHECK(num_allocations_ != 0);
@@ -49,37 +50,39 @@ void GenericBlockAllocatorBenchmark::AfterDeallocate() {
   Update();
 }
 
-void GenericBlockAllocatorBenchmark::BeforeReallocate(const Layout& layout) {
+void GenericAllocatorBenchmark::BeforeReallocate(const Layout& layout) {
   size_ = layout.size();
   DoBefore();
 }
 
-void GenericBlockAllocatorBenchmark::AfterReallocate(const void* new_ptr) {
+void GenericAllocatorBenchmark::AfterReallocate(const void* new_ptr) {
   DoAfter();
   data_.failed = new_ptr == nullptr;
   Update();
 }
 
-void GenericBlockAllocatorBenchmark::DoBefore() {
+void GenericAllocatorBenchmark::DoBefore() {
   start_ = chrono::SystemClock::now();
 }
 
-void GenericBlockAllocatorBenchmark::DoAfter() {
+void GenericAllocatorBenchmark::DoAfter() {
   auto finish = chrono::SystemClock::now();
   PW_ASSERT(start_.has_value());
   auto elapsed = finish - start_.value();
   data_.nanoseconds =
       std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
 
-  IterateOverBlocks(data_);
-  Fragmentation fragmentation = GetBlockFragmentation();
-  data_.fragmentation = CalculateFragmentation(fragmentation);
+  data_.largest = GetLargestAvailable();
+  Fragmentation fragmentation = GetFragmentation();
+  data_.fragmentation =
+      fragmentation.sum == 0 ? 0.f : CalculateFragmentation(fragmentation);
 }
 
-void GenericBlockAllocatorBenchmark::Update() {
+void GenericAllocatorBenchmark::Update() {
   measurements_.GetByCount(num_allocations_).Update(data_);
   measurements_.GetByFragmentation(data_.fragmentation).Update(data_);
   measurements_.GetBySize(size_).Update(data_);
+  measurements_.UpdateSummary(data_);
 }
 
 }  // namespace pw::allocator::internal
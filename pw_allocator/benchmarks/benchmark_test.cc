@@ -14,6 +14,9 @@
 
 #include "pw_allocator/benchmarks/benchmark.h"
 
+#include <algorithm>
+#include <cstddef>
+
 #include "pw_allocator/benchmarks/measurements.h"
 #include "pw_allocator/fragmentation.h"
 #include "pw_allocator/test_harness.h"
@@ -29,15 +32,18 @@ constexpr size_t kMaxSize = 64;
 using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<kCapacity>;
 using Benchmark =
     ::pw::allocator::DefaultBlockAllocatorBenchmark<AllocatorForTest>;
+using GenericBenchmark =
+    ::pw::allocator::DefaultAllocatorBenchmark<AllocatorForTest>;
 using ::pw::allocator::CalculateFragmentation;
 using ::pw::allocator::Measurement;
 using ::pw::allocator::Measurements;
 using ::pw::allocator::test::AllocationRequest;
+using ::pw::allocator::test::DeallocationRequest;
 using ::pw::allocator::test::kToken;
 using ::pw::allocator::test::Request;
 
-template <typename GetByKey>
-bool IsChanged(Benchmark& benchmark, GetByKey get_by_key) {
+template <typename BenchmarkType, typename GetByKey>
+bool IsChanged(BenchmarkType& benchmark, GetByKey get_by_key) {
   return get_by_key(benchmark.measurements()).count() != 0;
 }
 
@@ -125,7 +131,8 @@ TEST(BenchmarkTest, ByFragmentation) {
   EXPECT_TRUE(ByFragmentationChanged(benchmark, 0.8f));
 }
 
-bool BySizeChanged(Benchmark& benchmark, size_t size) {
+template <typename BenchmarkType>
+bool BySizeChanged(BenchmarkType& benchmark, size_t size) {
   return IsChanged(benchmark, [size](Measurements& m) -> Measurement<size_t>& {
     return m.GetBySize(size);
   });
@@ -169,4 +176,49 @@ TEST(BenchmarkTest, BySize) {
   EXPECT_FALSE(BySizeChanged(benchmark, 15));
 }
 
+TEST(BenchmarkTest, PeakFragmentation) {
+  AllocatorForTest allocator;
+  Benchmark benchmark(kToken, allocator);
+  benchmark.set_prng_seed(1);
+  benchmark.set_available(kCapacity);
+
+  float peak = 0.f;
+  for (size_t i = 0; i < 1000; ++i) {
+    benchmark.GenerateRequest(kMaxSize);
+    peak = std::max(peak,
+                    CalculateFragmentation(allocator.MeasureFragmentation()));
+  }
+  EXPECT_GT(peak, 0.f);
+  EXPECT_FLOAT_EQ(benchmark.measurements().peak_fragmentation(), peak);
+  EXPECT_GE(benchmark.measurements().p99(), benchmark.measurements().p50());
+}
+
+TEST(AllocatorBenchmarkTest, BySizeWithoutFragmentation) {
+  AllocatorForTest allocator;
+  GenericBenchmark benchmark(kToken, allocator);
+  benchmark.set_prng_seed(1);
+  benchmark.set_available(kCapacity);
+  AllocationRequest request;
+  request.alignment = alignof(std::max_align_t);
+
+  EXPECT_FALSE(BySizeChanged(benchmark, 256));
+  request.size = 256;
+  EXPECT_TRUE(benchmark.HandleRequest(request));
+  EXPECT_TRUE(BySizeChanged(benchmark, 256));
+
+  // Deallocations use the allocator's usable layout.
+  EXPECT_FALSE(BySizeChanged(benchmark, 1024));
+  request.size = 1024;
+  EXPECT_TRUE(benchmark.HandleRequest(request));
+  EXPECT_TRUE(benchmark.HandleRequest(DeallocationRequest{1}));
+  EXPECT_EQ(benchmark.measurements().GetBySize(1024).count(), 2u);
+
+  for (size_t i = 0; i < 100; ++i) {
+    benchmark.GenerateRequest(kMaxSize);
+  }
+  EXPECT_EQ(benchmark.measurements().GetByFragmentation(0.2f).count(), 0u);
+  EXPECT_FLOAT_EQ(benchmark.measurements().peak_fragmentation(), 0.f);
+  benchmark.Reset();
+}
+
 }  // namespace
@@ -18,6 +18,7 @@
 
 #include "pw_allocator/benchmarks/benchmark.h"
 #include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/workload.h"
 #include "pw_allocator/best_fit.h"
 
 namespace pw::allocator {
@@ -25,6 +26,9 @@ namespace pw::allocator {
 constexpr metric::Token kBestFitBenchmark =
     PW_TOKENIZE_STRING("best fit benchmark");
 
+constexpr metric::Token kBestFitTraceBenchmark =
+    PW_TOKENIZE_STRING("best fit workload trace benchmark");
+
 std::array<std::byte, benchmarks::kCapacity> buffer;
 
 void DoBestFitBenchmark() {
@@ -36,9 +40,17 @@ void DoBestFitBenchmark() {
   benchmark.metrics().Dump();
 }
 
+void DoBestFitTraceBenchmark() {
+  BestFitAllocator allocator(buffer);
+  DefaultBlockAllocatorBenchmark benchmark(kBestFitTraceBenchmark, allocator);
+  benchmark.HandleRequests(benchmarks::GetWorkloadTrace());
+  benchmark.metrics().Dump();
+}
+
 }  // namespace pw::allocator
 
 int main() {
   pw::allocator::DoBestFitBenchmark();
+  pw::allocator::DoBestFitTraceBenchmark();
   return 0;
 }
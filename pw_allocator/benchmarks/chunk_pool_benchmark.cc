@@ -0,0 +1,89 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/benchmarks/benchmark.h"
+#include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/workload.h"
+#include "pw_allocator/chunk_pool.h"
+#include "pw_result/result.h"
+
+namespace pw::allocator {
+
+constexpr metric::Token kChunkPoolBenchmark =
+    PW_TOKENIZE_STRING("chunk pool benchmark");
+
+constexpr metric::Token kChunkPoolTraceBenchmark =
+    PW_TOKENIZE_STRING("chunk pool workload trace benchmark");
+
+// Chunks are large enough for the most common packet sizes in the workload
+// trace. Since the test harness aligns requests to at most their size, aligning
+// chunks to their size allows any request that fits to succeed.
+constexpr size_t kChunkSize = 512;
+
+alignas(kChunkSize) std::array<std::byte, benchmarks::kCapacity> buffer;
+
+/// Adapts a `ChunkPool` to the `Allocator` interface so that it can be
+/// benchmarked. Requests that do not fit in a chunk fail.
+class ChunkPoolAllocator : public Allocator {
+ public:
+  ChunkPoolAllocator(ByteSpan region, Layout layout)
+      : Allocator(ChunkPool::kCapabilities), pool_(region, layout) {}
+
+ private:
+  void* DoAllocate(Layout layout) override {
+    const Layout& chunk = pool_.layout();
+    if (layout.size() > chunk.size() ||
+        layout.alignment() > chunk.alignment()) {
+      return nullptr;
+    }
+    return pool_.Allocate();
+  }
+
+  void DoDeallocate(void* ptr) override { pool_.Deallocate(ptr); }
+
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override {
+    return GetInfo(pool_, info_type, ptr);
+  }
+
+  ChunkPool pool_;
+};
+
+void DoChunkPoolBenchmark() {
+  ChunkPoolAllocator allocator(buffer, Layout(kChunkSize, kChunkSize));
+  DefaultAllocatorBenchmark benchmark(kChunkPoolBenchmark, allocator);
+  benchmark.set_prng_seed(1);
+  benchmark.set_available(benchmarks::kCapacity);
+  benchmark.GenerateRequests(kChunkSize, benchmarks::kNumRequests);
+  benchmark.metrics().Dump();
+}
+
+void DoChunkPoolTraceBenchmark() {
+  ChunkPoolAllocator allocator(buffer, Layout(kChunkSize, kChunkSize));
+  DefaultAllocatorBenchmark benchmark(kChunkPoolTraceBenchmark, allocator);
+  benchmark.HandleRequests(benchmarks::GetWorkloadTrace());
+  benchmark.metrics().Dump();
+}
+
+}  // namespace pw::allocator
+
+int main() {
+  pw::allocator::DoChunkPoolBenchmark();
+  pw::allocator::DoChunkPoolTraceBenchmark();
+  return 0;
+}
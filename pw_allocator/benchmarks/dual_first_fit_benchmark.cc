@@ -18,6 +18,7 @@
 
 #include "pw_allocator/benchmarks/benchmark.h"
 #include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/workload.h"
 #include "pw_allocator/first_fit.h"
 
 namespace pw::allocator {
@@ -25,6 +26,9 @@ namespace pw::allocator {
 constexpr metric::Token kDualFirstFitBenchmark =
     PW_TOKENIZE_STRING("dual first fit benchmark");
 
+constexpr metric::Token kDualFirstFitTraceBenchmark =
+    PW_TOKENIZE_STRING("dual first fit workload trace benchmark");
+
 std::array<std::byte, benchmarks::kCapacity> buffer;
 
 void DoDualFirstFitBenchmark() {
@@ -37,9 +41,19 @@ void DoDualFirstFitBenchmark() {
   benchmark.metrics().Dump();
 }
 
+void DoDualFirstFitTraceBenchmark() {
+  FirstFitAllocator allocator(buffer);
+  allocator.set_threshold(benchmarks::kMaxSize / 2);
+  DefaultBlockAllocatorBenchmark benchmark(kDualFirstFitTraceBenchmark,
+                                           allocator);
+  benchmark.HandleRequests(benchmarks::GetWorkloadTrace());
+  benchmark.metrics().Dump();
+}
+
 }  // namespace pw::allocator
 
 int main() {
   pw::allocator::DoDualFirstFitBenchmark();
+  pw::allocator::DoDualFirstFitTraceBenchmark();
   return 0;
 }
@@ -18,6 +18,7 @@
 
 #include "pw_allocator/benchmarks/benchmark.h"
 #include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/workload.h"
 #include "pw_allocator/first_fit.h"
 
 namespace pw::allocator {
@@ -25,6 +26,9 @@ namespace pw::allocator {
 constexpr metric::Token kFirstFitBenchmark =
     PW_TOKENIZE_STRING("first fit benchmark");
 
+constexpr metric::Token kFirstFitTraceBenchmark =
+    PW_TOKENIZE_STRING("first fit workload trace benchmark");
+
 std::array<std::byte, benchmarks::kCapacity> buffer;
 
 void DoFirstFitBenchmark() {
@@ -36,9 +40,17 @@ void DoFirstFitBenchmark() {
   benchmark.metrics().Dump();
 }
 
+void DoFirstFitTraceBenchmark() {
+  FirstFitAllocator allocator(buffer);
+  DefaultBlockAllocatorBenchmark benchmark(kFirstFitTraceBenchmark, allocator);
+  benchmark.HandleRequests(benchmarks::GetWorkloadTrace());
+  benchmark.metrics().Dump();
+}
+
 }  // namespace pw::allocator
 
 int main() {
   pw::allocator::DoFirstFitBenchmark();
+  pw::allocator::DoFirstFitTraceBenchmark();
   return 0;
 }
@@ -19,6 +19,7 @@
 
 #include "pw_allocator/benchmarks/benchmark.h"
 #include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/workload.h"
 #include "pw_allocator/first_fit.h"
 
 namespace pw::allocator {
@@ -26,6 +27,9 @@ namespace pw::allocator {
 constexpr metric::Token kLastFitBenchmark =
     PW_TOKENIZE_STRING("last fit benchmark");
 
+constexpr metric::Token kLastFitTraceBenchmark =
+    PW_TOKENIZE_STRING("last fit workload trace benchmark");
+
 std::array<std::byte, benchmarks::kCapacity> buffer;
 
 void DoLastFitBenchmark() {
@@ -38,9 +42,18 @@ void DoLastFitBenchmark() {
   benchmark.metrics().Dump();
 }
 
+void DoLastFitTraceBenchmark() {
+  FirstFitAllocator allocator(buffer);
+  allocator.set_threshold(std::numeric_limits<size_t>::max());
+  DefaultBlockAllocatorBenchmark benchmark(kLastFitTraceBenchmark, allocator);
+  benchmark.HandleRequests(benchmarks::GetWorkloadTrace());
+  benchmark.metrics().Dump();
+}
+
 }  // namespace pw::allocator
 
 int main() {
   pw::allocator::DoLastFitBenchmark();
+  pw::allocator::DoLastFitTraceBenchmark();
   return 0;
 }
@@ -0,0 +1,68 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/benchmarks/benchmark.h"
+#include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/throughput.h"
+#include "pw_allocator/benchmarks/workload.h"
+#include "pw_allocator/libc_allocator.h"
+
+namespace pw::allocator {
+
+// Benchmarks the platform's `malloc` and `free` as a point of comparison. These
+// are already thread-safe, so throughput is measured without an additional
+// lock.
+
+constexpr metric::Token kLibCBenchmark =
+    PW_TOKENIZE_STRING("libc allocator benchmark");
+
+constexpr metric::Token kLibCTraceBenchmark =
+    PW_TOKENIZE_STRING("libc allocator workload trace benchmark");
+
+constexpr metric::Token kLibCThroughput =
+    PW_TOKENIZE_STRING("libc allocator throughput");
+
+void DoLibCBenchmark() {
+  LibCAllocator& allocator = GetLibCAllocator();
+  DefaultAllocatorBenchmark benchmark(kLibCBenchmark, allocator);
+  benchmark.set_prng_seed(1);
+  benchmark.set_available(benchmarks::kCapacity);
+  benchmark.GenerateRequests(benchmarks::kMaxSize, benchmarks::kNumRequests);
+  benchmark.metrics().Dump();
+}
+
+void DoLibCTraceBenchmark() {
+  LibCAllocator& allocator = GetLibCAllocator();
+  DefaultAllocatorBenchmark benchmark(kLibCTraceBenchmark, allocator);
+  benchmark.HandleRequests(benchmarks::GetWorkloadTrace());
+  benchmark.metrics().Dump();
+}
+
+void DoLibCThroughputBenchmark() {
+  ThroughputBenchmark benchmark(kLibCThroughput, GetLibCAllocator());
+  benchmark.Run(benchmarks::kMaxSize, benchmarks::kNumRequests);
+  benchmark.metrics().Dump();
+}
+
+}  // namespace pw::allocator
+
+int main() {
+  pw::allocator::DoLibCBenchmark();
+  pw::allocator::DoLibCTraceBenchmark();
+  pw::allocator::DoLibCThroughputBenchmark();
+  return 0;
+}
@@ -14,6 +14,11 @@
 
 #include "pw_allocator/benchmarks/measurements.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "lib/stdcompat/bit.h"
+
 namespace pw::allocator {
 namespace internal {
 
@@ -46,11 +51,61 @@ void GenericMeasurement::Update(const BenchmarkSample& data) {
   }
 }
 
+// LatencyHistogram methods
+
+size_t LatencyHistogram::GetBin(uint64_t nanoseconds) {
+  if (nanoseconds < kNumSubBins) {
+    return static_cast<size_t>(nanoseconds);
+  }
+  // Use the position of the most significant bit to select a power of two, and
+  // the next `kSubBinBits` bits to select a bin within it.
+  size_t exponent = static_cast<size_t>(cpp20::bit_width(nanoseconds)) - 1;
+  size_t shift = exponent - kSubBinBits;
+  size_t sub_bin = static_cast<size_t>(nanoseconds >> shift) - kNumSubBins;
+  return ((shift + 1) << kSubBinBits) + sub_bin;
+}
+
+uint64_t LatencyHistogram::GetMidpoint(size_t bin) {
+  if (bin < kNumSubBins) {
+    return bin;
+  }
+  size_t shift = (bin >> kSubBinBits) - 1;
+  uint64_t lower = uint64_t(kNumSubBins + (bin % kNumSubBins)) << shift;
+  uint64_t width = uint64_t(1) << shift;
+  return lower + width / 2;
+}
+
+void LatencyHistogram::Add(uint64_t nanoseconds) {
+  ++bins_[GetBin(nanoseconds)];
+  ++count_;
+}
+
+uint64_t LatencyHistogram::Percentile(float percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  // Use the nearest-rank method.
+  auto rank = static_cast<size_t>(std::ceil(percentile * count_ / 100.f));
+  rank = std::clamp(rank, size_t(1), count_);
+  size_t seen = 0;
+  for (size_t bin = 0; bin < kNumBins; ++bin) {
+    seen += bins_[bin];
+    if (seen >= rank) {
+      return GetMidpoint(bin);
+    }
+  }
+  return GetMidpoint(kNumBins - 1);
+}
+
 }  // namespace internal
 
 // Measurements methods
 
 Measurements::Measurements(metric::Token name) : metrics_(name) {
+  metrics_.Add(p50_);
+  metrics_.Add(p90_);
+  metrics_.Add(p99_);
+  metrics_.Add(peak_fragmentation_);
   metrics_.Add(metrics_by_count_);
   metrics_.Add(metrics_by_fragmentation_);
   metrics_.Add(metrics_by_size_);
@@ -77,6 +132,16 @@ void Measurements::Clear() {
   by_size_.clear();
 }
 
+void Measurements::UpdateSummary(const internal::BenchmarkSample& data) {
+  latencies_.Add(data.nanoseconds);
+  p50_.Set(static_cast<float>(latencies_.Percentile(50.f)));
+  p90_.Set(static_cast<float>(latencies_.Percentile(90.f)));
+  p99_.Set(static_cast<float>(latencies_.Percentile(99.f)));
+  if (data.fragmentation > peak_fragmentation_.value()) {
+    peak_fragmentation_.Set(data.fragmentation);
+  }
+}
+
 Measurement<size_t>& Measurements::GetByCount(size_t count) {
   PW_ASSERT(!by_count_.empty());
   auto iter = by_count_.upper_bound(count);
@@ -22,6 +22,7 @@ namespace {
 using pw::allocator::Measurement;
 using pw::allocator::Measurements;
 using pw::allocator::internal::BenchmarkSample;
+using pw::allocator::internal::LatencyHistogram;
 
 constexpr pw::metric::Token kName = PW_TOKENIZE_STRING("test");
 
@@ -177,4 +178,50 @@ TEST(MeasurementsTest, BySize) {
   EXPECT_EQ(&(by_size.GetBySize(size_t(-1))), &at_least_256);
 }
 
+TEST(LatencyHistogramTest, Percentile_Empty) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Percentile(50.f), 0u);
+}
+
+TEST(LatencyHistogramTest, Percentile_SmallValuesAreExact) {
+  LatencyHistogram histogram;
+  histogram.Add(0);
+  histogram.Add(1);
+  histogram.Add(2);
+  histogram.Add(3);
+  EXPECT_EQ(histogram.count(), 4u);
+  EXPECT_EQ(histogram.Percentile(25.f), 0u);
+  EXPECT_EQ(histogram.Percentile(50.f), 1u);
+  EXPECT_EQ(histogram.Percentile(75.f), 2u);
+  EXPECT_EQ(histogram.Percentile(100.f), 3u);
+}
+
+TEST(LatencyHistogramTest, Percentile_LargeValuesAreApproximate) {
+  LatencyHistogram histogram;
+  for (uint64_t i = 1; i <= 100; ++i) {
+    histogram.Add(i * 1000);
+  }
+  auto within = [](uint64_t actual, uint64_t expected) {
+    return actual >= expected - expected / 8 &&
+           actual <= expected + expected / 8;
+  };
+  EXPECT_TRUE(within(histogram.Percentile(50.f), 50000));
+  EXPECT_TRUE(within(histogram.Percentile(90.f), 90000));
+  EXPECT_TRUE(within(histogram.Percentile(99.f), 99000));
+}
+
+TEST(MeasurementsTest, UpdateSummary) {
+  TestMeasurements measurements;
+  BenchmarkSample data;
+  for (uint64_t i = 0; i < 100; ++i) {
+    data.nanoseconds = i < 90 ? 2 : 3;
+    data.fragmentation = i == 50 ? 0.5f : 0.1f;
+    measurements.UpdateSummary(data);
+  }
+  EXPECT_FLOAT_EQ(measurements.p50(), 2.f);
+  EXPECT_FLOAT_EQ(measurements.p90(), 2.f);
+  EXPECT_FLOAT_EQ(measurements.p99(), 3.f);
+  EXPECT_FLOAT_EQ(measurements.peak_fragmentation(), 0.5f);
+}
+
 }  // namespace
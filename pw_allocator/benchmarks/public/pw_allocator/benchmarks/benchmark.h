@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <optional>
 
@@ -27,21 +28,21 @@
 namespace pw::allocator {
 namespace internal {
 
-/// Base class for benchmarking block allocators.
+/// Base class for benchmarking allocators.
 ///
 /// This class extends the test harness to sample data relevant to benchmarking
-/// the performance of a blockallocator before and after each request. It is not
-/// templated and avoids any types related to the specific block allocator.
+/// the performance of an allocator before and after each request. It is not
+/// templated and avoids any types related to the specific allocator.
 ///
 /// Callers should not use this class directly, and instead using
-/// `BlockAllocatorBenchmark`.
-class GenericBlockAllocatorBenchmark : public pw::allocator::test::TestHarness {
+/// `AllocatorBenchmark` or `BlockAllocatorBenchmark`.
+class GenericAllocatorBenchmark : public pw::allocator::test::TestHarness {
  public:
   metric::Group& metrics() { return measurements_.metrics(); }
   Measurements& measurements() { return measurements_; }
 
  protected:
-  constexpr explicit GenericBlockAllocatorBenchmark(Measurements& measurements)
+  constexpr explicit GenericAllocatorBenchmark(Measurements& measurements)
       : measurements_(measurements) {}
 
  private:
@@ -52,7 +53,7 @@ class GenericBlockAllocatorBenchmark : public pw::allocator::test::TestHarness {
   void AfterAllocate(const void* ptr) override;
 
   /// @copydoc test::TestHarness::BeforeAllocate
-  void BeforeDeallocate(const void* ptr) override;
+  void BeforeDeallocate(const void* ptr, const Layout& layout) override;
 
   /// @copydoc test::TestHarness::BeforeAllocate
   void AfterDeallocate() override;
@@ -72,14 +73,16 @@ class GenericBlockAllocatorBenchmark : public pw::allocator::test::TestHarness {
   /// Updates the `measurements` with data from an allocator request.
   void Update();
 
-  /// Returns the inner size of block from is usable space.
-  virtual size_t GetBlockInnerSize(const void* ptr) const = 0;
+  /// Returns the usable size of an allocation made with the given `layout`.
+  virtual size_t GetInnerSize(const void* ptr, const Layout& layout) const = 0;
 
-  /// Iterates over an allocators blocks and collects benchmark data.
-  virtual void IterateOverBlocks(BenchmarkSample& data) const = 0;
+  /// Returns the size of the single largest allocation that could succeed, or
+  /// 0 if this cannot be determined.
+  virtual size_t GetLargestAvailable() const = 0;
 
-  /// Measures the current fragmentation of an allocator.
-  virtual Fragmentation GetBlockFragmentation() const = 0;
+  /// Measures the current fragmentation of an allocator. Returns an empty
+  /// `Fragmentation` if this cannot be determined.
+  virtual Fragmentation GetFragmentation() const = 0;
 
   std::optional<chrono::SystemClock::time_point> start_;
   size_t num_allocations_ = 0;
@@ -90,6 +93,54 @@ class GenericBlockAllocatorBenchmark : public pw::allocator::test::TestHarness {
 
 }  // namespace internal
 
+/// Test harness used for benchmarking allocators.
+///
+/// This class records measurements aggregated from benchmarking samples of a
+/// sequence of allocator requests. The `Measurements` objects must outlive the
+/// benchmark test harness.
+///
+/// Any `Allocator` may be benchmarked with this class. Since generic allocators
+/// cannot be inspected, deallocations are measured using the requested sizes,
+/// and no fragmentation or largest available allocation are recorded. Use
+/// `BlockAllocatorBenchmark` for block allocators to include these.
+///
+/// @tparam   AllocatorType  Type of the allocator being benchmarked.
+template <typename AllocatorType>
+class AllocatorBenchmark : public internal::GenericAllocatorBenchmark {
+ public:
+  AllocatorBenchmark(Measurements& measurements, AllocatorType& allocator)
+      : internal::GenericAllocatorBenchmark(measurements) {
+    set_allocator(&allocator);
+  }
+
+ private:
+  /// @copydoc GenericAllocatorBenchmark::GetInnerSize
+  size_t GetInnerSize(const void*, const Layout& layout) const override {
+    return layout.size();
+  }
+
+  /// @copydoc GenericAllocatorBenchmark::GetLargestAvailable
+  size_t GetLargestAvailable() const override { return 0; }
+
+  /// @copydoc GenericAllocatorBenchmark::GetFragmentation
+  Fragmentation GetFragmentation() const override { return Fragmentation(); }
+};
+
+/// Allocator benchmark that use a default set of measurements
+///
+/// This class simplifies the set up of an allocator benchmark by defining a
+/// default set of metrics and linking all the relevant metrics together.
+template <typename AllocatorType>
+class DefaultAllocatorBenchmark : public AllocatorBenchmark<AllocatorType> {
+ public:
+  DefaultAllocatorBenchmark(metric::Token name, AllocatorType& allocator)
+      : AllocatorBenchmark<AllocatorType>(measurements_, allocator),
+        measurements_(name) {}
+
+ private:
+  DefaultMeasurements measurements_;
+};
+
 /// test harness used for benchmarking block allocators.
 ///
 /// This class records measurements aggregated from benchmarking samples of a
@@ -98,11 +149,10 @@ class GenericBlockAllocatorBenchmark : public pw::allocator::test::TestHarness {
 ///
 /// @tparam   AllocatorType  Type of the block allocator being benchmarked.
 template <typename AllocatorType>
-class BlockAllocatorBenchmark
-    : public internal::GenericBlockAllocatorBenchmark {
+class BlockAllocatorBenchmark : public internal::GenericAllocatorBenchmark {
  public:
   BlockAllocatorBenchmark(Measurements& measurements, AllocatorType& allocator)
-      : internal::GenericBlockAllocatorBenchmark(measurements),
+      : internal::GenericAllocatorBenchmark(measurements),
         allocator_(allocator) {
     set_allocator(&allocator);
   }
@@ -110,14 +160,14 @@ class BlockAllocatorBenchmark
  private:
   using BlockType = typename AllocatorType::BlockType;
 
-  /// @copydoc GenericBlockAllocatorBenchmark::GetBlockInnerSize
-  size_t GetBlockInnerSize(const void* ptr) const override;
+  /// @copydoc GenericAllocatorBenchmark::GetInnerSize
+  size_t GetInnerSize(const void* ptr, const Layout&) const override;
 
-  /// @copydoc GenericBlockAllocatorBenchmark::IterateOverBlocks
-  void IterateOverBlocks(internal::BenchmarkSample& data) const override;
+  /// @copydoc GenericAllocatorBenchmark::GetLargestAvailable
+  size_t GetLargestAvailable() const override;
 
-  /// @copydoc GenericBlockAllocatorBenchmark::GetBlockFragmentation
-  Fragmentation GetBlockFragmentation() const override;
+  /// @copydoc GenericAllocatorBenchmark::GetFragmentation
+  Fragmentation GetFragmentation() const override;
 
   AllocatorType& allocator_;
 };
@@ -141,26 +191,25 @@ class DefaultBlockAllocatorBenchmark
 // Template method implementations
 
 template <typename AllocatorType>
-size_t BlockAllocatorBenchmark<AllocatorType>::GetBlockInnerSize(
-    const void* ptr) const {
+size_t BlockAllocatorBenchmark<AllocatorType>::GetInnerSize(
+    const void* ptr, const Layout&) const {
   const auto* block = BlockType::FromUsableSpace(ptr);
   return block->InnerSize();
 }
 
 template <typename AllocatorType>
-void BlockAllocatorBenchmark<AllocatorType>::IterateOverBlocks(
-    internal::BenchmarkSample& data) const {
-  data.largest = 0;
+size_t BlockAllocatorBenchmark<AllocatorType>::GetLargestAvailable() const {
+  size_t largest = 0;
   for (const auto* block : allocator_.blocks()) {
     if (block->IsFree()) {
-      data.largest = std::max(data.largest, block->InnerSize());
+      largest = std::max(largest, block->InnerSize());
     }
   }
+  return largest;
 }
 
 template <typename AllocatorType>
-Fragmentation BlockAllocatorBenchmark<AllocatorType>::GetBlockFragmentation()
-    const {
+Fragmentation BlockAllocatorBenchmark<AllocatorType>::GetFragmentation() const {
   return allocator_.MeasureFragmentation();
 }
 
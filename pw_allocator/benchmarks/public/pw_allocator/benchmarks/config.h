@@ -21,4 +21,14 @@ inline constexpr size_t kCapacity = 0x4000000;  // 64 MiB
 inline constexpr size_t kMaxSize = 0x2000;      // 8 KiB
 inline constexpr size_t kNumRequests = 40000;
 
+// Limits on the trace recorded from the simulated workload.
+inline constexpr size_t kNumTraceRequests = 20000;
+inline constexpr size_t kMaxTraceAllocations = 256;
+
+// Maximum number of threads used to measure throughput, and the amount of
+// memory each thread tries to keep allocated. The latter is kept small so that
+// the test harness's own bookkeeping does not dominate the measurement.
+inline constexpr size_t kMaxThreads = 4;
+inline constexpr size_t kThroughputAvailable = 0x40000;  // 256 KiB
+
 }  // namespace pw::allocator::benchmarks
@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
@@ -23,14 +24,15 @@ namespace pw::allocator {
 namespace internal {
 
 // Forward declaration for friending.
-class GenericBlockAllocatorBenchmark;
+class GenericAllocatorBenchmark;
 
 /// Collection data relating to an allocating request.
 struct BenchmarkSample {
   /// How many nanoseconds the request took.
   uint64_t nanoseconds = 0;
 
-  /// Current fragmentation reported by the block allocaor.
+  /// Current fragmentation reported by the block allocator, or 0 if the
+  /// allocator does not report fragmentation.
   float fragmentation = 0.f;
 
   /// Current single largest allocation that could succeed.
@@ -74,6 +76,37 @@ class GenericMeasurement {
   size_t count_ = 0;
 };
 
+/// Approximate distribution of request latencies.
+///
+/// Latencies are counted in log-linear bins: each power of two is split into
+/// four equal bins, which bounds the error of any reported percentile to
+/// 12.5% while using a fixed, small amount of memory regardless of the number
+/// of samples.
+class LatencyHistogram {
+ public:
+  size_t count() const { return count_; }
+
+  /// Adds a single latency sample.
+  void Add(uint64_t nanoseconds);
+
+  /// Returns the approximate latency that `percentile` percent of samples do
+  /// not exceed, or 0 if no samples have been added.
+  ///
+  /// @param  percentile  Value in the range (0, 100].
+  uint64_t Percentile(float percentile) const;
+
+ private:
+  static constexpr size_t kSubBinBits = 2;
+  static constexpr size_t kNumSubBins = size_t(1) << kSubBinBits;
+  static constexpr size_t kNumBins = kNumSubBins * (64 - kSubBinBits + 1);
+
+  static size_t GetBin(uint64_t nanoseconds);
+  static uint64_t GetMidpoint(size_t bin);
+
+  std::array<uint32_t, kNumBins> bins_{};
+  size_t count_ = 0;
+};
+
 }  // namespace internal
 
 /// An accumulation of samples into a single measurement.
@@ -100,6 +133,9 @@ class Measurement : public internal::GenericMeasurement,
 /// * The number of allocator requests that have been performed.
 /// * The level of fragmentation as measured by the block allocator.
 /// * The size of the most recent allocator request.
+///
+/// It also summarizes all samples with the median, 90th and 99th percentile
+/// response times and the peak fragmentation that was observed.
 class Measurements {
  public:
   explicit Measurements(metric::Token name);
@@ -109,6 +145,14 @@ class Measurements {
   Measurement<float>& GetByFragmentation(float fragmentation);
   Measurement<size_t>& GetBySize(size_t size);
 
+  float p50() const { return p50_.value(); }
+  float p90() const { return p90_.value(); }
+  float p99() const { return p99_.value(); }
+  float peak_fragmentation() const { return peak_fragmentation_.value(); }
+
+  /// Adds a sample to the summary metrics.
+  void UpdateSummary(const internal::BenchmarkSample& data);
+
  protected:
   void AddByCount(Measurement<size_t>& measurement);
   void AddByFragmentation(Measurement<float>& measurement);
@@ -119,10 +163,16 @@ class Measurements {
 
  private:
   // Allow the benchmark harness to retrieve measurements.
-  friend class internal::GenericBlockAllocatorBenchmark;
+  friend class internal::GenericAllocatorBenchmark;
 
   metric::Group metrics_;
 
+  PW_METRIC(p50_, "median response time (ns)", 0.f);
+  PW_METRIC(p90_, "90th percentile response time (ns)", 0.f);
+  PW_METRIC(p99_, "99th percentile response time (ns)", 0.f);
+  PW_METRIC(peak_fragmentation_, "peak fragmentation metric", 0.f);
+  internal::LatencyHistogram latencies_;
+
   PW_METRIC_GROUP(metrics_by_count_, "by allocation count");
   IntrusiveMap<size_t, Measurement<size_t>> by_count_;
 
@@ -0,0 +1,125 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/layout.h"
+#include "pw_allocator/test_harness.h"
+#include "pw_containers/vector.h"
+#include "pw_result/result.h"
+
+namespace pw::allocator {
+namespace internal {
+
+/// Base class for recording allocator requests.
+///
+/// This class forwards requests to another allocator, and records each one as
+/// a `test::Request` that can be replayed by a `test::TestHarness`. It is not
+/// templated on the number of requests or allocations it can track.
+///
+/// Callers should not use this class directly, and instead use
+/// `RecordingAllocator`.
+class GenericRecordingAllocator : public Allocator {
+ public:
+  /// Returns the requests recorded so far.
+  const Vector<test::Request>& requests() const { return requests_; }
+
+  /// Returns whether the recorder has run out of room, and has stopped
+  /// recording requests.
+  bool full() const { return full_; }
+
+ protected:
+  GenericRecordingAllocator(Allocator& allocator,
+                            Vector<test::Request>& requests,
+                            Vector<void*>& allocations)
+      : Allocator(allocator.capabilities()),
+        allocator_(allocator),
+        requests_(requests),
+        allocations_(allocations) {}
+
+ private:
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr, Layout) override { DoDeallocate(ptr); }
+
+  /// @copydoc Allocator::Resize
+  ///
+  /// The test harness has no equivalent request, so this always fails. Callers
+  /// will fall back to `Reallocate`, which is recorded.
+  bool DoResize(void*, size_t) override { return false; }
+
+  /// @copydoc Allocator::Reallocate
+  void* DoReallocate(void* ptr, Layout new_layout) override;
+
+  /// @copydoc Allocator::GetAllocated
+  size_t DoGetAllocated() const override { return allocator_.GetAllocated(); }
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override {
+    return GetInfo(allocator_, info_type, ptr);
+  }
+
+  /// Returns whether another request and allocation can be recorded. Once this
+  /// returns false, it always returns false.
+  bool CanRecord();
+
+  /// Returns the index the test harness would use for a given pointer, or
+  /// `allocations_.size()` if the pointer was not recorded.
+  size_t IndexOf(const void* ptr) const;
+
+  Allocator& allocator_;
+  Vector<test::Request>& requests_;
+
+  /// Recorded allocations, in the same order as the test harness keeps them.
+  Vector<void*>& allocations_;
+
+  bool full_ = false;
+};
+
+}  // namespace internal
+
+/// Wraps an `Allocator` and records the sequence of requests made to it.
+///
+/// The recorded requests can be replayed against other allocators using
+/// `test::TestHarness::HandleRequests`, e.g. to benchmark different allocators
+/// with a trace captured from a real workload.
+///
+/// The test harness stores its bookkeeping in each allocation, and so cannot
+/// replay requests smaller than `test::TestHarness::Allocation`. These are
+/// rounded up when recorded. Resizing in place is not recorded, and always
+/// fails. Once either limit below is reached, the allocator stops recording
+/// and simply forwards requests.
+///
+/// @tparam   kMaxRequests      Maximum number of requests to record.
+/// @tparam   kMaxAllocations   Maximum number of outstanding allocations.
+template <size_t kMaxRequests, size_t kMaxAllocations>
+class RecordingAllocator : public internal::GenericRecordingAllocator {
+ public:
+  explicit RecordingAllocator(Allocator& allocator)
+      : internal::GenericRecordingAllocator(
+            allocator, requests_, allocations_) {}
+
+ private:
+  Vector<test::Request, kMaxRequests> requests_;
+  Vector<void*, kMaxAllocations> allocations_;
+};
+
+}  // namespace pw::allocator
@@ -0,0 +1,72 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/test_harness.h"
+#include "pw_metric/metric.h"
+#include "pw_thread/test_thread_context.h"
+
+namespace pw::allocator {
+
+/// Measures the throughput of an allocator shared by several threads.
+///
+/// Each thread uses its own `test::TestHarness` to generate a sequence of
+/// pseudorandom requests. The allocator must be safe to use from multiple
+/// threads, e.g. a `SynchronizedAllocator`. Throughput is reported as the total
+/// number of requests handled per second, using 1, 2, and 4 threads.
+class ThroughputBenchmark {
+ public:
+  ThroughputBenchmark(metric::Token name, Allocator& allocator);
+
+  metric::Group& metrics() { return metrics_; }
+
+  float one_thread() const { return one_thread_.value(); }
+  float two_threads() const { return two_threads_.value(); }
+  float four_threads() const { return four_threads_.value(); }
+
+  /// Measures throughput with each number of threads.
+  ///
+  /// @param  max_size      Maximum size of each allocation request.
+  /// @param  num_requests  Number of requests made by each thread.
+  void Run(size_t max_size, size_t num_requests);
+
+ private:
+  struct Worker {
+    test::TestHarness harness;
+    size_t max_size = 0;
+    size_t num_requests = 0;
+
+    void Run() { harness.GenerateRequests(max_size, num_requests); }
+  };
+
+  /// Returns the number of requests per second handled by `num_threads`.
+  float Measure(size_t num_threads, size_t max_size, size_t num_requests);
+
+  Allocator& allocator_;
+  metric::Group metrics_;
+  PW_METRIC(one_thread_, "requests per second with 1 thread", 0.f);
+  PW_METRIC(two_threads_, "requests per second with 2 threads", 0.f);
+  PW_METRIC(four_threads_, "requests per second with 4 threads", 0.f);
+
+  std::array<Worker, benchmarks::kMaxThreads> workers_;
+  std::array<thread::test::TestThreadContext, benchmarks::kMaxThreads>
+      contexts_;
+};
+
+}  // namespace pw::allocator
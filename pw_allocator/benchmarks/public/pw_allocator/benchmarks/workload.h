@@ -0,0 +1,36 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_allocator/test_harness.h"
+#include "pw_containers/vector.h"
+
+namespace pw::allocator::benchmarks {
+
+/// Returns a trace of allocator requests recorded from a simulated workload.
+///
+/// Unlike the uniformly random requests generated by `test::TestHarness`, the
+/// workload mimics the allocation patterns of a typical communications stack:
+/// * A few long-lived objects, e.g. services and channels, which are allocated
+///   at startup and occasionally replaced.
+/// * A queue of short-lived packet buffers, mostly small with occasional
+///   MTU-sized ones, which are freed in the order they were allocated.
+/// * Buffers that grow by repeated reallocation, e.g. while assembling a
+///   larger message.
+///
+/// The trace is recorded once using a `RecordingAllocator`, and may be
+/// replayed against any allocator using `test::TestHarness::HandleRequests`.
+const Vector<test::Request>& GetWorkloadTrace();
+
+}  // namespace pw::allocator::benchmarks
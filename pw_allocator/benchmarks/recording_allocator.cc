@@ -0,0 +1,85 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/benchmarks/recording_allocator.h"
+
+#include <algorithm>
+
+namespace pw::allocator::internal {
+namespace {
+
+/// Returns the layout the test harness can replay for a given request.
+Layout ReplayableLayout(Layout layout) {
+  constexpr Layout kMinLayout = Layout::Of<test::TestHarness::Allocation>();
+  return Layout(std::max(layout.size(), kMinLayout.size()),
+                std::max(layout.alignment(), kMinLayout.alignment()));
+}
+
+}  // namespace
+
+bool GenericRecordingAllocator::CanRecord() {
+  if (requests_.full() || allocations_.full()) {
+    full_ = true;
+  }
+  return !full_;
+}
+
+size_t GenericRecordingAllocator::IndexOf(const void* ptr) const {
+  auto iter = std::find(allocations_.begin(), allocations_.end(), ptr);
+  return static_cast<size_t>(iter - allocations_.begin());
+}
+
+void* GenericRecordingAllocator::DoAllocate(Layout layout) {
+  void* ptr = allocator_.Allocate(layout);
+  if (!CanRecord()) {
+    return ptr;
+  }
+  Layout replayable = ReplayableLayout(layout);
+  requests_.push_back(
+      test::AllocationRequest{replayable.size(), replayable.alignment()});
+  if (ptr != nullptr) {
+    allocations_.push_back(ptr);
+  }
+  return ptr;
+}
+
+void GenericRecordingAllocator::DoDeallocate(void* ptr) {
+  size_t index = IndexOf(ptr);
+  if (index != allocations_.size() && CanRecord()) {
+    requests_.push_back(test::DeallocationRequest{index});
+    allocations_.erase(allocations_.begin() + index);
+  }
+  allocator_.Deallocate(ptr);
+}
+
+void* GenericRecordingAllocator::DoReallocate(void* ptr, Layout new_layout) {
+  if (ptr == nullptr) {
+    return DoAllocate(new_layout);
+  }
+  size_t index = IndexOf(ptr);
+  if (index == allocations_.size() || !CanRecord()) {
+    return allocator_.Reallocate(ptr, new_layout);
+  }
+  size_t new_size = ReplayableLayout(new_layout).size();
+  requests_.push_back(test::ReallocationRequest{index, new_size});
+
+  // Like the test harness, move the reallocated pointer to the back of the
+  // list, whether or not it was moved.
+  allocations_.erase(allocations_.begin() + index);
+  void* new_ptr = allocator_.Reallocate(ptr, new_layout);
+  allocations_.push_back(new_ptr == nullptr ? ptr : new_ptr);
+  return new_ptr;
+}
+
+}  // namespace pw::allocator::internal
@@ -0,0 +1,142 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/benchmarks/recording_allocator.h"
+
+#include <cstddef>
+#include <variant>
+
+#include "pw_allocator/test_harness.h"
+#include "pw_allocator/testing.h"
+#include "pw_containers/vector.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+constexpr size_t kCapacity = 4096;
+
+using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<kCapacity>;
+using Recorder = ::pw::allocator::RecordingAllocator<16, 4>;
+using ::pw::allocator::Layout;
+using ::pw::allocator::test::AllocationRequest;
+using ::pw::allocator::test::DeallocationRequest;
+using ::pw::allocator::test::ReallocationRequest;
+using ::pw::allocator::test::Request;
+using ::pw::allocator::test::TestHarness;
+
+constexpr Layout kMinLayout = Layout::Of<TestHarness::Allocation>();
+
+bool Equal(const Request& lhs, const Request& rhs) {
+  if (lhs.index() != rhs.index()) {
+    return false;
+  }
+  if (const auto* a = std::get_if<AllocationRequest>(&lhs)) {
+    const auto& b = std::get<AllocationRequest>(rhs);
+    return a->size == b.size && a->alignment == b.alignment;
+  }
+  if (const auto* a = std::get_if<DeallocationRequest>(&lhs)) {
+    return a->index == std::get<DeallocationRequest>(rhs).index;
+  }
+  const auto& a = std::get<ReallocationRequest>(lhs);
+  const auto& b = std::get<ReallocationRequest>(rhs);
+  return a.index == b.index && a.new_size == b.new_size;
+}
+
+TEST(RecordingAllocatorTest, RecordsRequests) {
+  AllocatorForTest allocator;
+  Recorder recorder(allocator);
+
+  void* ptr0 = recorder.Allocate(Layout(64, 8));
+  void* ptr1 = recorder.Allocate(Layout(1, 1));
+  void* ptr2 = recorder.Allocate(Layout(128, 16));
+  ASSERT_NE(ptr0, nullptr);
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+
+  recorder.Deallocate(ptr1);
+  ptr0 = recorder.Reallocate(ptr0, Layout(256, 8));
+  ASSERT_NE(ptr0, nullptr);
+  recorder.Deallocate(ptr0);
+  recorder.Deallocate(ptr2);
+
+  const auto& requests = recorder.requests();
+  ASSERT_EQ(requests.size(), 7u);
+
+  const auto& alloc0 = std::get<AllocationRequest>(requests[0]);
+  EXPECT_EQ(alloc0.size, 64u);
+  EXPECT_EQ(alloc0.alignment, 8u);
+
+  // Requests too small for the test harness are rounded up.
+  const auto& alloc1 = std::get<AllocationRequest>(requests[1]);
+  EXPECT_EQ(alloc1.size, kMinLayout.size());
+  EXPECT_EQ(alloc1.alignment, kMinLayout.alignment());
+
+  EXPECT_EQ(std::get<DeallocationRequest>(requests[3]).index, 1u);
+
+  const auto& realloc = std::get<ReallocationRequest>(requests[4]);
+  EXPECT_EQ(realloc.index, 0u);
+  EXPECT_EQ(realloc.new_size, 256u);
+
+  // Reallocated pointers move to the back, as in the test harness.
+  EXPECT_EQ(std::get<DeallocationRequest>(requests[5]).index, 1u);
+  EXPECT_EQ(std::get<DeallocationRequest>(requests[6]).index, 0u);
+}
+
+TEST(RecordingAllocatorTest, StopsWhenFull) {
+  AllocatorForTest allocator;
+  Recorder recorder(allocator);
+  void* ptrs[5];
+  for (void*& ptr : ptrs) {
+    ptr = recorder.Allocate(Layout(32, 8));
+    ASSERT_NE(ptr, nullptr);
+  }
+  EXPECT_TRUE(recorder.full());
+  EXPECT_EQ(recorder.requests().size(), 4u);
+  for (void* ptr : ptrs) {
+    recorder.Deallocate(ptr);
+  }
+  EXPECT_EQ(recorder.requests().size(), 4u);
+}
+
+TEST(RecordingAllocatorTest, ReplayMatchesRecording) {
+  AllocatorForTest allocator1;
+  Recorder original(allocator1);
+  void* a = original.Allocate(Layout(32, 8));
+  void* b = original.Allocate(Layout(48, 16));
+  void* c = original.Allocate(Layout(96, 8));
+  original.Deallocate(b);
+  a = original.Reallocate(a, Layout(160, 8));
+  b = original.Allocate(Layout(24, 8));
+  original.Deallocate(c);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+
+  // Replay the trace through a second recorder. The test harness frees any
+  // remaining allocations from the front of its list when finished.
+  AllocatorForTest allocator2;
+  Recorder replayed(allocator2);
+  TestHarness harness(replayed);
+  harness.HandleRequests(original.requests());
+  original.Deallocate(a);
+  original.Deallocate(b);
+
+  const auto& expected = original.requests();
+  const auto& actual = replayed.requests();
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_TRUE(Equal(actual[i], expected[i]));
+  }
+}
+
+}  // namespace
@@ -0,0 +1,85 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/benchmarks/benchmark.h"
+#include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/throughput.h"
+#include "pw_allocator/benchmarks/workload.h"
+#include "pw_allocator/synchronized_allocator.h"
+#include "pw_allocator/tlsf_allocator.h"
+#include "pw_sync/interrupt_spin_lock.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::allocator {
+
+// Benchmarks a `TlsfAllocator` guarded by a lock. The single-threaded results
+// can be compared with those of `tlsf_benchmark` to measure the overhead of
+// locking. The multithreaded results measure the effect of lock contention.
+
+constexpr metric::Token kSynchronizedBenchmark =
+    PW_TOKENIZE_STRING("synchronized allocator benchmark");
+
+constexpr metric::Token kSynchronizedTraceBenchmark =
+    PW_TOKENIZE_STRING("synchronized allocator workload trace benchmark");
+
+constexpr metric::Token kMutexThroughput =
+    PW_TOKENIZE_STRING("synchronized allocator throughput with mutex");
+
+constexpr metric::Token kSpinLockThroughput =
+    PW_TOKENIZE_STRING("synchronized allocator throughput with spin lock");
+
+std::array<std::byte, benchmarks::kCapacity> buffer;
+
+void DoSynchronizedBenchmark() {
+  TlsfAllocator tlsf(buffer);
+  SynchronizedAllocator<sync::Mutex> allocator(tlsf);
+  DefaultAllocatorBenchmark benchmark(kSynchronizedBenchmark, allocator);
+  benchmark.set_prng_seed(1);
+  benchmark.set_available(benchmarks::kCapacity);
+  benchmark.GenerateRequests(benchmarks::kMaxSize, benchmarks::kNumRequests);
+  benchmark.metrics().Dump();
+}
+
+void DoSynchronizedTraceBenchmark() {
+  TlsfAllocator tlsf(buffer);
+  SynchronizedAllocator<sync::Mutex> allocator(tlsf);
+  DefaultAllocatorBenchmark benchmark(kSynchronizedTraceBenchmark, allocator);
+  benchmark.HandleRequests(benchmarks::GetWorkloadTrace());
+  benchmark.metrics().Dump();
+}
+
+template <typename LockType>
+void DoSynchronizedThroughputBenchmark(metric::Token name) {
+  TlsfAllocator tlsf(buffer);
+  SynchronizedAllocator<LockType> allocator(tlsf);
+  ThroughputBenchmark benchmark(name, allocator);
+  benchmark.Run(benchmarks::kMaxSize, benchmarks::kNumRequests);
+  benchmark.metrics().Dump();
+}
+
+}  // namespace pw::allocator
+
+int main() {
+  pw::allocator::DoSynchronizedBenchmark();
+  pw::allocator::DoSynchronizedTraceBenchmark();
+  pw::allocator::DoSynchronizedThroughputBenchmark<pw::sync::Mutex>(
+      pw::allocator::kMutexThroughput);
+  pw::allocator::DoSynchronizedThroughputBenchmark<
+      pw::sync::InterruptSpinLock>(pw::allocator::kSpinLockThroughput);
+  return 0;
+}
@@ -0,0 +1,77 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/throughput.h"
+#include "pw_allocator/synchronized_allocator.h"
+#include "pw_allocator/thread_caching_allocator.h"
+#include "pw_allocator/tlsf_allocator.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::allocator {
+
+// Benchmarks a `ThreadCachingAllocator` in front of a `TlsfAllocator` guarded
+// by a mutex, and compares its throughput with that of the synchronized
+// allocator alone. Small requests fit the caches' size classes, while the
+// default requests are mostly passed through to the underlying allocator.
+
+constexpr metric::Token kSynchronizedSmallThroughput = PW_TOKENIZE_STRING(
+    "synchronized allocator throughput with small requests");
+
+constexpr metric::Token kThreadCachingSmallThroughput = PW_TOKENIZE_STRING(
+    "thread caching allocator throughput with small requests");
+
+constexpr metric::Token kThreadCachingThroughput =
+    PW_TOKENIZE_STRING("thread caching allocator throughput");
+
+using CachingAllocator = ThreadCachingAllocator<sync::Mutex>;
+
+std::array<std::byte, benchmarks::kCapacity> buffer;
+
+void DoSynchronizedThroughputBenchmark(metric::Token name, size_t max_size) {
+  TlsfAllocator tlsf(buffer);
+  SynchronizedAllocator<sync::Mutex> allocator(tlsf);
+  ThroughputBenchmark benchmark(name, allocator);
+  benchmark.Run(max_size, benchmarks::kNumRequests);
+  benchmark.metrics().Dump();
+}
+
+void DoThreadCachingThroughputBenchmark(metric::Token name, size_t max_size) {
+  TlsfAllocator tlsf(buffer);
+  SynchronizedAllocator<sync::Mutex> synchronized(tlsf);
+  CachingAllocator allocator(synchronized);
+  ThroughputBenchmark benchmark(name, allocator);
+  benchmark.Run(max_size, benchmarks::kNumRequests);
+  benchmark.metrics().Dump();
+}
+
+}  // namespace pw::allocator
+
+int main() {
+  using pw::allocator::CachingAllocator;
+  pw::allocator::DoSynchronizedThroughputBenchmark(
+      pw::allocator::kSynchronizedSmallThroughput,
+      CachingAllocator::kMaxCachedSize);
+  pw::allocator::DoThreadCachingThroughputBenchmark(
+      pw::allocator::kThreadCachingSmallThroughput,
+      CachingAllocator::kMaxCachedSize);
+  pw::allocator::DoThreadCachingThroughputBenchmark(
+      pw::allocator::kThreadCachingThroughput,
+      pw::allocator::benchmarks::kMaxSize);
+  return 0;
+}
@@ -0,0 +1,75 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/benchmarks/throughput.h"
+
+#include <chrono>
+
+#include "pw_assert/check.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_thread/thread.h"
+
+static_assert(PW_THREAD_JOINING_ENABLED,
+              "ThroughputBenchmark requires joinable threads");
+
+namespace pw::allocator {
+
+ThroughputBenchmark::ThroughputBenchmark(metric::Token name,
+                                         Allocator& allocator)
+    : allocator_(allocator), metrics_(name) {
+  metrics_.Add(one_thread_);
+  metrics_.Add(two_threads_);
+  metrics_.Add(four_threads_);
+}
+
+void ThroughputBenchmark::Run(size_t max_size, size_t num_requests) {
+  one_thread_.Set(Measure(1, max_size, num_requests));
+  two_threads_.Set(Measure(2, max_size, num_requests));
+  four_threads_.Set(Measure(4, max_size, num_requests));
+}
+
+float ThroughputBenchmark::Measure(size_t num_threads,
+                                   size_t max_size,
+                                   size_t num_requests) {
+  PW_CHECK_UINT_LE(num_threads, benchmarks::kMaxThreads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    Worker& worker = workers_[i];
+    worker.harness.set_allocator(&allocator_);
+    worker.harness.set_prng_seed(i + 1);
+    worker.harness.set_available(benchmarks::kThroughputAvailable);
+    worker.max_size = max_size;
+    worker.num_requests = num_requests;
+  }
+
+  std::array<Thread, benchmarks::kMaxThreads> threads;
+  auto start = chrono::SystemClock::now();
+  for (size_t i = 0; i < num_threads; ++i) {
+    Worker* worker = &workers_[i];
+    threads[i] = Thread(contexts_[i].options(), [worker] { worker->Run(); });
+  }
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads[i].join();
+  }
+  auto elapsed = chrono::SystemClock::now() - start;
+
+  auto nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  if (nanoseconds <= 0) {
+    return 0.f;
+  }
+  float total = static_cast<float>(num_threads * num_requests);
+  return total * 1e9f / static_cast<float>(nanoseconds);
+}
+
+}  // namespace pw::allocator
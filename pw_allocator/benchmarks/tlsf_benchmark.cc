@@ -18,6 +18,7 @@
 
 #include "pw_allocator/benchmarks/benchmark.h"
 #include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/workload.h"
 #include "pw_allocator/tlsf_allocator.h"
 
 namespace pw::allocator {
@@ -25,6 +26,9 @@ namespace pw::allocator {
 constexpr metric::Token kTlsfBenchmark =
     PW_TOKENIZE_STRING("two-layer, segregated-fit benchmark");
 
+constexpr metric::Token kTlsfTraceBenchmark =
+    PW_TOKENIZE_STRING("two-layer, segregated-fit workload trace benchmark");
+
 std::array<std::byte, benchmarks::kCapacity> buffer;
 
 void DoTlsfBenchmark() {
@@ -36,9 +40,17 @@ void DoTlsfBenchmark() {
   benchmark.metrics().Dump();
 }
 
+void DoTlsfTraceBenchmark() {
+  TlsfAllocator allocator(buffer);
+  DefaultBlockAllocatorBenchmark benchmark(kTlsfTraceBenchmark, allocator);
+  benchmark.HandleRequests(benchmarks::GetWorkloadTrace());
+  benchmark.metrics().Dump();
+}
+
 }  // namespace pw::allocator
 
 int main() {
   pw::allocator::DoTlsfBenchmark();
+  pw::allocator::DoTlsfTraceBenchmark();
   return 0;
 }
@@ -0,0 +1,120 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/benchmarks/workload.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/recording_allocator.h"
+#include "pw_allocator/libc_allocator.h"
+#include "pw_containers/inline_queue.h"
+#include "pw_random/xor_shift.h"
+
+namespace pw::allocator::benchmarks {
+namespace {
+
+constexpr size_t kNumLongLived = 32;
+constexpr size_t kMaxQueued = 16;
+constexpr size_t kMaxGrowth = 4096;
+
+using Recorder = RecordingAllocator<kNumTraceRequests, kMaxTraceAllocations>;
+
+/// Returns a random value in the range [min, max).
+size_t RandomSize(random::XorShiftStarRng64& prng, size_t min, size_t max) {
+  size_t value;
+  prng.GetInt(value);
+  return min + value % (max - min);
+}
+
+/// Returns the size of a packet buffer. Most packets are small control or
+/// acknowledgement packets, some carry data, and a few are MTU-sized.
+size_t PacketSize(random::XorShiftStarRng64& prng) {
+  size_t selector = RandomSize(prng, 0, 100);
+  if (selector < 70) {
+    return RandomSize(prng, 16, 128);
+  }
+  if (selector < 95) {
+    return RandomSize(prng, 128, 512);
+  }
+  return RandomSize(prng, 1024, 1500);
+}
+
+/// Grows a buffer from a small size to a random larger one, then frees it.
+void GrowBuffer(Allocator& allocator, random::XorShiftStarRng64& prng) {
+  size_t size = 64;
+  size_t final_size = RandomSize(prng, size, kMaxGrowth);
+  void* ptr = allocator.Allocate(Layout(size, alignof(std::max_align_t)));
+  while (ptr != nullptr && size < final_size) {
+    size *= 2;
+    void* new_ptr =
+        allocator.Reallocate(ptr, Layout(size, alignof(std::max_align_t)));
+    if (new_ptr == nullptr) {
+      break;
+    }
+    ptr = new_ptr;
+  }
+  allocator.Deallocate(ptr);
+}
+
+void RunWorkload(Recorder& recorder) {
+  random::XorShiftStarRng64 prng(1);
+  std::array<void*, kNumLongLived> long_lived;
+  for (void*& ptr : long_lived) {
+    ptr = recorder.Allocate(Layout(RandomSize(prng, 64, 1024)));
+  }
+
+  InlineQueue<void*, kMaxQueued> packets;
+  while (!recorder.full()) {
+    size_t selector = RandomSize(prng, 0, 100);
+    if (selector < 2) {
+      void*& ptr = long_lived[RandomSize(prng, 0, kNumLongLived)];
+      recorder.Deallocate(ptr);
+      ptr = recorder.Allocate(Layout(RandomSize(prng, 64, 1024)));
+    } else if (selector < 7) {
+      GrowBuffer(recorder, prng);
+    } else {
+      if (packets.full()) {
+        recorder.Deallocate(packets.front());
+        packets.pop();
+      }
+      void* ptr = recorder.Allocate(Layout(PacketSize(prng)));
+      if (ptr != nullptr) {
+        packets.push(ptr);
+      }
+    }
+  }
+
+  while (!packets.empty()) {
+    recorder.Deallocate(packets.front());
+    packets.pop();
+  }
+  for (void* ptr : long_lived) {
+    recorder.Deallocate(ptr);
+  }
+}
+
+}  // namespace
+
+const Vector<test::Request>& GetWorkloadTrace() {
+  static Recorder recorder(GetLibCAllocator());
+  if (recorder.requests().empty()) {
+    RunWorkload(recorder);
+  }
+  return recorder.requests();
+}
+
+}  // namespace pw::allocator::benchmarks
@@ -18,6 +18,7 @@
 
 #include "pw_allocator/benchmarks/benchmark.h"
 #include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/workload.h"
 #include "pw_allocator/worst_fit.h"
 
 namespace pw::allocator {
@@ -25,6 +26,9 @@ namespace pw::allocator {
 constexpr metric::Token kWorstFitBenchmark =
     PW_TOKENIZE_STRING("worst fit benchmark");
 
+constexpr metric::Token kWorstFitTraceBenchmark =
+    PW_TOKENIZE_STRING("worst fit workload trace benchmark");
+
 std::array<std::byte, benchmarks::kCapacity> buffer;
 
 void DoWorstFitBenchmark() {
@@ -36,9 +40,17 @@ void DoWorstFitBenchmark() {
   benchmark.metrics().Dump();
 }
 
+void DoWorstFitTraceBenchmark() {
+  WorstFitAllocator allocator(buffer);
+  DefaultBlockAllocatorBenchmark benchmark(kWorstFitTraceBenchmark, allocator);
+  benchmark.HandleRequests(benchmarks::GetWorkloadTrace());
+  benchmark.metrics().Dump();
+}
+
 }  // namespace pw::allocator
 
 int main() {
   pw::allocator::DoWorstFitBenchmark();
+  pw::allocator::DoWorstFitTraceBenchmark();
   return 0;
 }
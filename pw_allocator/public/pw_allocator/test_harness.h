@@ -145,11 +145,14 @@ class TestHarness {
 
   /// Derived classes may add callbacks that are invoked before and after each
   /// de/re/allocation to record additional data about the allocator.
+  ///
+  /// `BeforeDeallocate` is passed the layout that was used to allocate the
+  /// memory being freed.
   virtual void BeforeAllocate(const Layout&) {}
   virtual void AfterAllocate(const void*) {}
   virtual void BeforeReallocate(const Layout&) {}
   virtual void AfterReallocate(const void*) {}
-  virtual void BeforeDeallocate(const void*) {}
+  virtual void BeforeDeallocate(const void*, const Layout&) {}
   virtual void AfterDeallocate() {}
 
   /// Adds a pointer to the vector of allocated pointers.
@@ -0,0 +1,320 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/capability.h"
+#include "pw_allocator/layout.h"
+#include "pw_allocator/synchronized_allocator.h"
+#include "pw_bytes/alignment.h"
+#include "pw_metric/thread_shard.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::allocator {
+
+/// Wraps a `SynchronizedAllocator` with per-thread caches of small blocks.
+///
+/// Small requests are rounded up to one of a few power-of-two size classes.
+/// Each thread allocates from and frees to the free lists of its own cache,
+/// and only takes the lock of the underlying allocator to refill or flush a
+/// list in batches of several blocks. Larger or over-aligned requests are
+/// passed through to the underlying allocator.
+///
+/// Each allocation is prefixed with a small header that records the size class
+/// and the requested layout. As a result, this allocator implements
+/// `kImplementsGetRequestedLayout` and can be wrapped by a `TrackingAllocator`.
+/// Blocks held in the caches still count as allocated by the underlying
+/// allocator, and are included in `GetAllocated`.
+///
+/// Threads are assigned to caches by their stack address, using
+/// `pw::metric::ThisThreadShard`. Each cache has its own lock, so threads that
+/// share a cache remain correct, but contend with each other.
+///
+/// @tparam LockType    The type of lock used by the underlying allocator and
+///                     by each cache.
+/// @tparam kNumCaches  The number of caches shared by all threads.
+template <typename LockType, size_t kNumCaches = 4>
+class ThreadCachingAllocator : public Allocator {
+ public:
+  /// Number of size classes. The smallest class is `kMinCachedSize` bytes,
+  /// and each class is twice the size of the previous one.
+  static constexpr size_t kNumSizeClasses = 5;
+  static constexpr size_t kMinCachedSize = 16;
+  static constexpr size_t kMaxCachedSize = kMinCachedSize
+                                           << (kNumSizeClasses - 1);
+
+  /// Maximum number of free blocks kept per size class in each cache.
+  static constexpr size_t kCacheDepth = 8;
+
+  /// Number of blocks moved between a cache and the underlying allocator at
+  /// once.
+  static constexpr size_t kBatchSize = kCacheDepth / 2;
+
+  explicit ThreadCachingAllocator(SynchronizedAllocator<LockType>& allocator)
+      : Allocator(allocator.capabilities() | kImplementsGetRequestedLayout),
+        allocator_(allocator) {}
+
+  ~ThreadCachingAllocator() override { Flush(); }
+
+  /// Returns every cached block to the underlying allocator.
+  void Flush() {
+    for (Cache& cache : caches_) {
+      std::lock_guard lock(cache.lock);
+      auto borrowed = allocator_.Borrow();
+      for (FreeList& list : cache.lists) {
+        while (list.head != nullptr) {
+          borrowed->Deallocate(list.Pop());
+        }
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t kAlignment = alignof(std::max_align_t);
+  static constexpr uint8_t kUncached = 0xFF;
+
+  /// Precedes every allocation, immediately before the returned pointer.
+  struct Header {
+    size_t requested_size;
+    uint8_t alignment_shift;
+    uint8_t size_class;
+  };
+
+  static constexpr size_t kHeaderSize = AlignUp(sizeof(Header), kAlignment);
+
+  /// A free block in a cache, which stores the link to the next free block.
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct FreeList {
+    FreeBlock* head = nullptr;
+    size_t count = 0;
+
+    void Push(void* ptr) {
+      auto* block = static_cast<FreeBlock*>(ptr);
+      block->next = head;
+      head = block;
+      ++count;
+    }
+
+    void* Pop() {
+      FreeBlock* block = head;
+      head = block->next;
+      --count;
+      return block;
+    }
+  };
+
+  struct Cache {
+    LockType lock;
+    std::array<FreeList, kNumSizeClasses> lists PW_GUARDED_BY(lock);
+  };
+
+  /// Returns the size class for a request, or `kUncached` if the request is
+  /// not cached.
+  static constexpr uint8_t SizeClassOf(Layout layout) {
+    if (layout.size() > kMaxCachedSize || layout.alignment() > kAlignment) {
+      return kUncached;
+    }
+    uint8_t size_class = 0;
+    while ((kMinCachedSize << size_class) < layout.size()) {
+      ++size_class;
+    }
+    return size_class;
+  }
+
+  static constexpr size_t ClassSize(uint8_t size_class) {
+    return kMinCachedSize << size_class;
+  }
+
+  /// Layout of the blocks requested from the underlying allocator for a class.
+  static constexpr Layout ClassLayout(uint8_t size_class) {
+    return Layout(kHeaderSize + ClassSize(size_class), kAlignment);
+  }
+
+  /// Returns the number of bytes between the start of an uncached block and
+  /// the pointer returned to the caller.
+  static constexpr size_t PrefixSize(size_t alignment) {
+    return alignment > kHeaderSize ? alignment : kHeaderSize;
+  }
+
+  static Header& HeaderOf(const void* ptr) {
+    auto* bytes = static_cast<std::byte*>(const_cast<void*>(ptr));
+    return *std::launder(reinterpret_cast<Header*>(bytes - kHeaderSize));
+  }
+
+  /// Returns the pointer to the block obtained from the underlying allocator.
+  static void* BlockOf(const void* ptr) {
+    const Header& header = HeaderOf(ptr);
+    size_t prefix = header.size_class == kUncached
+                        ? PrefixSize(size_t{1} << header.alignment_shift)
+                        : kHeaderSize;
+    return static_cast<std::byte*>(const_cast<void*>(ptr)) - prefix;
+  }
+
+  static uint8_t AlignmentShift(size_t alignment) {
+    uint8_t shift = 0;
+    while ((size_t{1} << shift) < alignment) {
+      ++shift;
+    }
+    return shift;
+  }
+
+  /// Writes the header to a block and returns the pointer to its usable space.
+  static void* Prepare(void* block,
+                       size_t prefix,
+                       Layout layout,
+                       uint8_t size_class) {
+    auto* ptr = static_cast<std::byte*>(block) + prefix;
+    new (ptr - kHeaderSize) Header{layout.size(),
+                                   AlignmentShift(layout.alignment()),
+                                   size_class};
+    return ptr;
+  }
+
+  /// Returns the cache used by the calling thread.
+  Cache& CurrentCache() {
+    return caches_[metric::ThisThreadShard() % kNumCaches];
+  }
+
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override {
+    uint8_t size_class = SizeClassOf(layout);
+    if (size_class == kUncached) {
+      size_t prefix = PrefixSize(layout.alignment());
+      size_t alignment =
+          layout.alignment() > kAlignment ? layout.alignment() : kAlignment;
+      void* block =
+          allocator_.Allocate(Layout(prefix + layout.size(), alignment));
+      if (block == nullptr) {
+        return nullptr;
+      }
+      return Prepare(block, prefix, layout, size_class);
+    }
+
+    Cache& cache = CurrentCache();
+    std::lock_guard lock(cache.lock);
+    FreeList& list = cache.lists[size_class];
+    if (list.head == nullptr) {
+      Refill(list, size_class);
+      if (list.head == nullptr) {
+        return nullptr;
+      }
+    }
+    return Prepare(list.Pop(), kHeaderSize, layout, size_class);
+  }
+
+  /// Allocates up to a batch of blocks for a list while holding the lock of
+  /// the underlying allocator once.
+  void Refill(FreeList& list, uint8_t size_class) {
+    auto borrowed = allocator_.Borrow();
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      void* block = borrowed->Allocate(ClassLayout(size_class));
+      if (block == nullptr) {
+        break;
+      }
+      list.Push(block);
+    }
+  }
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr) override {
+    uint8_t size_class = HeaderOf(ptr).size_class;
+    void* block = BlockOf(ptr);
+    if (size_class == kUncached) {
+      allocator_.Deallocate(block);
+      return;
+    }
+
+    Cache& cache = CurrentCache();
+    std::lock_guard lock(cache.lock);
+    FreeList& list = cache.lists[size_class];
+    if (list.count >= kCacheDepth) {
+      // Return a batch of blocks while holding the lock of the underlying
+      // allocator once.
+      auto borrowed = allocator_.Borrow();
+      for (size_t i = 0; i < kBatchSize; ++i) {
+        borrowed->Deallocate(list.Pop());
+      }
+    }
+    list.Push(block);
+  }
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr, Layout) override { DoDeallocate(ptr); }
+
+  /// @copydoc Allocator::Resize
+  bool DoResize(void* ptr, size_t new_size) override {
+    Header& header = HeaderOf(ptr);
+    if (header.size_class == kUncached) {
+      size_t prefix = PrefixSize(size_t{1} << header.alignment_shift);
+      if (!allocator_.Resize(BlockOf(ptr), prefix + new_size)) {
+        return false;
+      }
+    } else if (new_size > ClassSize(header.size_class)) {
+      return false;
+    }
+    header.requested_size = new_size;
+    return true;
+  }
+
+  /// @copydoc Allocator::GetAllocated
+  size_t DoGetAllocated() const override { return allocator_.GetAllocated(); }
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override {
+    if (ptr == nullptr && info_type != InfoType::kCapacity) {
+      return Status::NotFound();
+    }
+    switch (info_type) {
+      case InfoType::kRequestedLayoutOf: {
+        const Header& header = HeaderOf(ptr);
+        return Layout(header.requested_size,
+                      size_t{1} << header.alignment_shift);
+      }
+      case InfoType::kUsableLayoutOf: {
+        const Header& header = HeaderOf(ptr);
+        if (header.size_class != kUncached) {
+          return Layout(ClassSize(header.size_class), kAlignment);
+        }
+        size_t alignment = size_t{1} << header.alignment_shift;
+        Result<Layout> usable = GetInfo(allocator_, info_type, BlockOf(ptr));
+        if (!usable.ok()) {
+          return usable.status();
+        }
+        return Layout(usable->size() - PrefixSize(alignment), alignment);
+      }
+      case InfoType::kAllocatedLayoutOf:
+      case InfoType::kRecognizes:
+        return GetInfo(allocator_, info_type, BlockOf(ptr));
+      case InfoType::kCapacity:
+      default:
+        return GetInfo(allocator_, info_type, ptr);
+    }
+  }
+
+  SynchronizedAllocator<LockType>& allocator_;
+  std::array<Cache, kNumCaches> caches_;
+};
+
+}  // namespace pw::allocator
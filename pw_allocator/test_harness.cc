@@ -59,7 +59,9 @@ void TestHarness::GenerateRequest(size_t max_size) {
     // scale between:
     // * when empty, an 80% chance to allocate and a 10% chance to deallocate
     // * when full, a 30% chance to allocate and a 60% chance to deallocate
-    dealloc_threshold = 80 - (allocated_ * 50) / available_.value();
+    // Past 160% of the available memory, no more allocations are generated.
+    size_t used = (allocated_ * 50) / available_.value();
+    dealloc_threshold = 80 - std::min(used, size_t(80));
   }
   do {
     size_t request_type;
@@ -140,7 +142,7 @@ bool TestHarness::HandleRequest(const Request& request) {
           if (old == nullptr) {
             return false;
           }
-          BeforeDeallocate(old);
+          BeforeDeallocate(old, old->layout);
           allocator_->Deallocate(old);
           AfterDeallocate();
 
@@ -183,7 +185,7 @@ void TestHarness::AddAllocation(void* ptr, Layout layout) {
     // needs the layout to be at least `Layout::Of<Allocation>` in order
     // to persist details about it. If either the size or alignment is too
     // small, deallocate immediately.
-    BeforeDeallocate(ptr);
+    BeforeDeallocate(ptr, layout);
     allocator_->Deallocate(ptr);
     AfterDeallocate();
     return;
@@ -0,0 +1,217 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/thread_caching_allocator.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/metrics.h"
+#include "pw_allocator/synchronized_allocator.h"
+#include "pw_allocator/test_harness.h"
+#include "pw_allocator/testing.h"
+#include "pw_allocator/tracking_allocator.h"
+#include "pw_sync/mutex.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+// Test fixtures.
+
+static constexpr size_t kCapacity = 8192;
+static constexpr size_t kMaxSize = 512;
+static constexpr size_t kNumThreads = 3;
+static constexpr size_t kNumRequests = 500;
+
+using ::pw::allocator::Layout;
+using ::pw::allocator::SynchronizedAllocator;
+using ::pw::allocator::ThreadCachingAllocator;
+using ::pw::allocator::test::TestHarness;
+using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<kCapacity>;
+using CachingAllocator = ThreadCachingAllocator<pw::sync::Mutex>;
+
+// Exposes the protected layout accessors for testing.
+class CachingAllocatorForTest : public CachingAllocator {
+ public:
+  using CachingAllocator::CachingAllocator;
+  using CachingAllocator::GetRequestedLayout;
+  using CachingAllocator::GetUsableLayout;
+  using CachingAllocator::Recognizes;
+};
+
+class ThreadCachingAllocatorTest : public ::testing::Test {
+ protected:
+  size_t num_underlying_allocations() const {
+    return underlying_.metrics().num_allocations.value();
+  }
+
+  size_t num_underlying_deallocations() const {
+    return underlying_.metrics().num_deallocations.value();
+  }
+
+  AllocatorForTest underlying_;
+  SynchronizedAllocator<pw::sync::Mutex> synchronized_{underlying_};
+  CachingAllocatorForTest allocator_{synchronized_};
+};
+
+// Unit tests.
+
+TEST_F(ThreadCachingAllocatorTest, ServesRequestsFromCache) {
+  void* ptr1 = allocator_.Allocate(Layout(24, 8));
+  ASSERT_NE(ptr1, nullptr);
+  EXPECT_EQ(num_underlying_allocations(), CachingAllocator::kBatchSize);
+  allocator_.Deallocate(ptr1);
+  EXPECT_EQ(num_underlying_deallocations(), 0u);
+
+  void* ptr2 = allocator_.Allocate(Layout(32, 4));
+  ASSERT_NE(ptr2, nullptr);
+  EXPECT_EQ(num_underlying_allocations(), CachingAllocator::kBatchSize);
+  allocator_.Deallocate(ptr2);
+}
+
+TEST_F(ThreadCachingAllocatorTest, RefillsAndFlushesInBatches) {
+  std::array<void*, CachingAllocator::kCacheDepth + 1> ptrs;
+  for (void*& ptr : ptrs) {
+    ptr = allocator_.Allocate(Layout(16, 1));
+    ASSERT_NE(ptr, nullptr);
+  }
+  // Every refill requests a whole batch from the underlying allocator.
+  EXPECT_EQ(num_underlying_allocations() % CachingAllocator::kBatchSize, 0u);
+  EXPECT_LT(num_underlying_allocations(),
+            ptrs.size() + CachingAllocator::kBatchSize);
+
+  for (void* ptr : ptrs) {
+    allocator_.Deallocate(ptr);
+  }
+  EXPECT_EQ(num_underlying_deallocations(), CachingAllocator::kBatchSize);
+
+  allocator_.Flush();
+  EXPECT_EQ(num_underlying_allocations(), num_underlying_deallocations());
+}
+
+TEST_F(ThreadCachingAllocatorTest, PassesThroughLargeAndOverAlignedRequests) {
+  Layout large(CachingAllocator::kMaxCachedSize + 1, 4);
+  void* ptr1 = allocator_.Allocate(large);
+  ASSERT_NE(ptr1, nullptr);
+  EXPECT_EQ(num_underlying_allocations(), 1u);
+
+  Layout over_aligned(16, alignof(std::max_align_t) * 4);
+  void* ptr2 = allocator_.Allocate(over_aligned);
+  ASSERT_NE(ptr2, nullptr);
+  EXPECT_EQ(num_underlying_allocations(), 2u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr2) % over_aligned.alignment(), 0u);
+
+  EXPECT_EQ(allocator_.GetRequestedLayout(ptr1).value(), large);
+  EXPECT_EQ(allocator_.GetRequestedLayout(ptr2).value(), over_aligned);
+  EXPECT_GE(allocator_.GetUsableLayout(ptr1).value().size(), large.size());
+
+  allocator_.Deallocate(ptr1);
+  allocator_.Deallocate(ptr2);
+  EXPECT_EQ(num_underlying_deallocations(), 2u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ReportsLayouts) {
+  EXPECT_TRUE(allocator_.HasCapability(
+      pw::allocator::kImplementsGetRequestedLayout));
+
+  void* ptr = allocator_.Allocate(Layout(20, 4));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator_.GetRequestedLayout(ptr).value(), Layout(20, 4));
+  EXPECT_EQ(allocator_.GetUsableLayout(ptr).value().size(), 32u);
+  allocator_.Deallocate(ptr);
+}
+
+TEST_F(ThreadCachingAllocatorTest, RecognizesCachedAndUncachedBlocks) {
+  void* cached = allocator_.Allocate(Layout(20, 4));
+  ASSERT_NE(cached, nullptr);
+  void* uncached = allocator_.Allocate(
+      Layout(CachingAllocator::kMaxCachedSize + 1, alignof(std::max_align_t)));
+  ASSERT_NE(uncached, nullptr);
+
+  EXPECT_TRUE(allocator_.Recognizes(cached));
+  EXPECT_TRUE(allocator_.Recognizes(uncached));
+
+  allocator_.Deallocate(cached);
+  allocator_.Deallocate(uncached);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ResizesWithinSizeClass) {
+  void* ptr = allocator_.Allocate(Layout(20, 4));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_TRUE(allocator_.Resize(ptr, 32));
+  EXPECT_EQ(allocator_.GetRequestedLayout(ptr).value().size(), 32u);
+  EXPECT_FALSE(allocator_.Resize(ptr, 33));
+  allocator_.Deallocate(ptr);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ReallocatesAcrossSizeClasses) {
+  auto* ptr = static_cast<uint8_t*>(allocator_.Allocate(Layout(16, 1)));
+  ASSERT_NE(ptr, nullptr);
+  for (uint8_t i = 0; i < 16; ++i) {
+    ptr[i] = i;
+  }
+  ptr = static_cast<uint8_t*>(allocator_.Reallocate(ptr, Layout(100, 1)));
+  ASSERT_NE(ptr, nullptr);
+  for (uint8_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(ptr[i], i);
+  }
+  allocator_.Deallocate(ptr);
+}
+
+TEST_F(ThreadCachingAllocatorTest, CanBeTracked) {
+  using AllMetrics = ::pw::allocator::internal::AllMetrics;
+  pw::allocator::TrackingAllocator<AllMetrics> tracker(1, allocator_);
+  void* ptr1 = tracker.Allocate(Layout(24, 8));
+  void* ptr2 = tracker.Allocate(Layout(1000, 8));
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+  EXPECT_EQ(tracker.metrics().requested_bytes.value(), 1024u);
+
+  tracker.Deallocate(ptr1);
+  tracker.Deallocate(ptr2);
+  EXPECT_EQ(tracker.metrics().requested_bytes.value(), 0u);
+  EXPECT_EQ(tracker.metrics().num_allocations.value(), 2u);
+  EXPECT_EQ(tracker.metrics().num_deallocations.value(), 2u);
+}
+
+// TODO: https://pwbug.dev/365161669 - Express joinability as a build-system
+// constraint.
+#if PW_THREAD_JOINING_ENABLED
+
+TEST_F(ThreadCachingAllocatorTest, GenerateRequestsFromMultipleThreads) {
+  std::array<TestHarness, kNumThreads> harnesses;
+  std::array<pw::thread::test::TestThreadContext, kNumThreads> contexts;
+  std::array<pw::Thread, kNumThreads> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    TestHarness* harness = &harnesses[i];
+    harness->set_allocator(&allocator_);
+    harness->set_prng_seed(i + 1);
+    threads[i] = pw::Thread(contexts[i].options(), [harness] {
+      harness->GenerateRequests(kMaxSize, kNumRequests);
+      harness->Reset();
+    });
+  }
+  for (pw::Thread& thread : threads) {
+    thread.join();
+  }
+  allocator_.Flush();
+  EXPECT_EQ(num_underlying_allocations(), num_underlying_deallocations());
+}
+
+#endif  // PW_THREAD_JOINING_ENABLED
+
+}  // namespace
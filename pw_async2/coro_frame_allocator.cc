@@ -0,0 +1,152 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/coro_frame_allocator.h"
+
+#include <algorithm>
+#include <limits>
+#include <new>
+
+#include "pw_bytes/alignment.h"
+
+namespace pw::async2::internal {
+
+using ::pw::allocator::Layout;
+
+void GenericCoroFrameAllocator::ReleaseCachedFrames() {
+  for (size_t i = 0; i < num_size_classes_; ++i) {
+    CoroFrameSizeClass& size_class = size_classes_[i];
+    while (size_class.free_list != nullptr) {
+      std::byte* frame = size_class.free_list;
+      size_class.free_list =
+          *std::launder(reinterpret_cast<std::byte**>(frame));
+      DeallocateFrame(frame);
+    }
+    frames_cached_.Decrement(static_cast<uint32_t>(size_class.num_cached));
+    size_class.num_cached = 0;
+  }
+}
+
+void* GenericCoroFrameAllocator::DoAllocate(Layout layout) {
+  uint16_t index = FindOrClaimSizeClass(layout);
+  if (index == kUnclassified) {
+    unclassified_frames_.Increment();
+    return AllocateFrame(layout, kUnclassified);
+  }
+  CoroFrameSizeClass& size_class = size_classes_[index];
+  std::byte* frame = size_class.free_list;
+  if (frame == nullptr) {
+    return AllocateFrame(Layout(size_class.size, size_class.alignment), index);
+  }
+  size_class.free_list = *std::launder(reinterpret_cast<std::byte**>(frame));
+  --size_class.num_cached;
+  frames_cached_.Decrement();
+  frames_reused_.Increment();
+  return frame;
+}
+
+void GenericCoroFrameAllocator::DoDeallocate(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  uint16_t index = GetHeader(ptr).size_class;
+  if (index == kUnclassified) {
+    DeallocateFrame(ptr);
+    return;
+  }
+  CoroFrameSizeClass& size_class = size_classes_[index];
+  if (size_class.num_cached >= max_cached_per_class_) {
+    DeallocateFrame(ptr);
+    return;
+  }
+  std::byte** next = std::launder(reinterpret_cast<std::byte**>(ptr));
+  *next = size_class.free_list;
+  size_class.free_list = static_cast<std::byte*>(ptr);
+  ++size_class.num_cached;
+  frames_cached_.Increment();
+}
+
+Result<Layout> GenericCoroFrameAllocator::DoGetInfo(InfoType info_type,
+                                                    const void* ptr) const {
+  if (ptr == nullptr) {
+    return Status::NotFound();
+  }
+  const FrameHeader& header = GetHeader(ptr);
+  size_t alignment = header.size_class == kUnclassified
+                         ? alignof(FrameHeader)
+                         : size_classes_[header.size_class].alignment;
+  switch (info_type) {
+    case InfoType::kUsableLayoutOf:
+      return Layout(header.size, alignment);
+    case InfoType::kRequestedLayoutOf:
+    case InfoType::kAllocatedLayoutOf:
+    case InfoType::kCapacity:
+    case InfoType::kRecognizes:
+    default:
+      return Status::Unimplemented();
+  }
+}
+
+uint16_t GenericCoroFrameAllocator::FindOrClaimSizeClass(Layout layout) {
+  // Frames in the free list must be able to hold the next pointer.
+  size_t size = std::max(layout.size(), sizeof(std::byte*));
+  size_t alignment = std::max(layout.alignment(), alignof(std::byte*));
+  for (size_t i = 0; i < num_size_classes_; ++i) {
+    const CoroFrameSizeClass& size_class = size_classes_[i];
+    if (size_class.size == size && size_class.alignment == alignment) {
+      return static_cast<uint16_t>(i);
+    }
+  }
+  if (num_size_classes_ == size_classes_.size() ||
+      num_size_classes_ >= kUnclassified) {
+    return kUnclassified;
+  }
+  CoroFrameSizeClass& size_class = size_classes_[num_size_classes_];
+  size_class.size = size;
+  size_class.alignment = alignment;
+  return static_cast<uint16_t>(num_size_classes_++);
+}
+
+void* GenericCoroFrameAllocator::AllocateFrame(Layout layout,
+                                               uint16_t size_class) {
+  size_t alignment = std::max(layout.alignment(), alignof(FrameHeader));
+  size_t offset = AlignUp(sizeof(FrameHeader), alignment);
+  if (offset > std::numeric_limits<uint16_t>::max() ||
+      layout.size() > std::numeric_limits<uint32_t>::max()) {
+    return nullptr;
+  }
+  Layout block_layout(offset + layout.size(), alignment);
+  auto* block = static_cast<std::byte*>(allocator_.Allocate(block_layout));
+  if (block == nullptr) {
+    return nullptr;
+  }
+  void* frame = block + offset;
+  new (&GetHeader(frame)) FrameHeader{
+      .size = static_cast<uint32_t>(layout.size()),
+      .offset = static_cast<uint16_t>(offset),
+      .size_class = size_class,
+  };
+  allocated_ += block_layout.size();
+  frames_allocated_.Increment();
+  return frame;
+}
+
+void GenericCoroFrameAllocator::DeallocateFrame(void* ptr) {
+  const FrameHeader& header = GetHeader(ptr);
+  std::byte* block = static_cast<std::byte*>(ptr) - header.offset;
+  allocated_ -= header.offset + header.size;
+  allocator_.Deallocate(block);
+}
+
+}  // namespace pw::async2::internal
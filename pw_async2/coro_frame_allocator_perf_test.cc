@@ -0,0 +1,102 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/best_fit.h"
+#include "pw_allocator/tlsf_allocator.h"
+#include "pw_async2/coro.h"
+#include "pw_async2/coro_frame_allocator.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_status/status.h"
+
+namespace pw::async2 {
+namespace {
+
+using allocator::Allocator;
+using allocator::BestFitAllocator;
+using allocator::TlsfAllocator;
+
+constexpr size_t kHeapSize = 16384;
+
+// Number of unrelated allocations kept alive while coroutines are spawned, to
+// give the heap a realistic amount of existing state.
+constexpr size_t kNumLiveAllocations = 32;
+
+Coro<Result<int>> ReturnsValue(CoroContext&, int value) { co_return value; }
+
+Coro<Status> AddsValues(CoroContext& coro_cx, int& out) {
+  PW_CO_TRY_ASSIGN(int first, co_await ReturnsValue(coro_cx, 1));
+  PW_CO_TRY_ASSIGN(int second, co_await ReturnsValue(coro_cx, 2));
+  out += first + second;
+  co_return OkStatus();
+}
+
+/// Repeatedly spawns a coroutine with nested coroutines and runs it to
+/// completion, allocating coroutine frames from `frame_allocator`.
+void SpawnAndComplete(perf_test::State& state,
+                      Allocator& heap,
+                      Allocator& frame_allocator) {
+  std::array<void*, kNumLiveAllocations> live;
+  for (size_t i = 0; i < live.size(); ++i) {
+    live[i] = heap.Allocate(allocator::Layout(16 + (i % 4) * 24, 8));
+  }
+  CoroContext coro_cx(frame_allocator);
+  Dispatcher dispatcher;
+  int out = 0;
+  while (state.KeepRunning()) {
+    Coro<Status> coro = AddsValues(coro_cx, out);
+    PW_ASSERT(dispatcher.RunPendableUntilStalled(coro).IsReady());
+  }
+  for (void* ptr : live) {
+    heap.Deallocate(ptr);
+  }
+}
+
+void TlsfFrames(perf_test::State& state) {
+  static std::array<std::byte, kHeapSize> buffer;
+  TlsfAllocator<> heap(buffer);
+  SpawnAndComplete(state, heap, heap);
+}
+
+void BestFitFrames(perf_test::State& state) {
+  static std::array<std::byte, kHeapSize> buffer;
+  BestFitAllocator<> heap(buffer);
+  SpawnAndComplete(state, heap, heap);
+}
+
+void CachedTlsfFrames(perf_test::State& state) {
+  static std::array<std::byte, kHeapSize> buffer;
+  TlsfAllocator<> heap(buffer);
+  CoroFrameAllocator<4> frames(heap);
+  SpawnAndComplete(state, heap, frames);
+}
+
+void CachedBestFitFrames(perf_test::State& state) {
+  static std::array<std::byte, kHeapSize> buffer;
+  BestFitAllocator<> heap(buffer);
+  CoroFrameAllocator<4> frames(heap);
+  SpawnAndComplete(state, heap, frames);
+}
+
+PW_PERF_TEST(CoroSpawnWithTlsfAllocator, TlsfFrames);
+PW_PERF_TEST(CoroSpawnWithBestFitAllocator, BestFitFrames);
+PW_PERF_TEST(CoroSpawnWithCachedTlsfAllocator, CachedTlsfFrames);
+PW_PERF_TEST(CoroSpawnWithCachedBestFitAllocator, CachedBestFitFrames);
+
+}  // namespace
+}  // namespace pw::async2
@@ -0,0 +1,158 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/coro_frame_allocator.h"
+
+#include "pw_allocator/testing.h"
+#include "pw_async2/coro.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_status/status.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using ::pw::OkStatus;
+using ::pw::Result;
+using ::pw::Status;
+using ::pw::allocator::Layout;
+using ::pw::allocator::test::AllocatorForTest;
+using ::pw::async2::Coro;
+using ::pw::async2::CoroContext;
+using ::pw::async2::CoroFrameAllocator;
+using ::pw::async2::Dispatcher;
+using ::pw::async2::Poll;
+
+Coro<Result<int>> ReturnsFive(CoroContext&) { co_return 5; }
+
+Coro<Status> AddsFive(CoroContext& coro_cx, int& out) {
+  PW_CO_TRY_ASSIGN(int five, co_await ReturnsFive(coro_cx));
+  out += five;
+  co_return OkStatus();
+}
+
+Status RunToCompletion(Coro<Status>&& coro) {
+  Dispatcher dispatcher;
+  Poll<Status> result = dispatcher.RunPendableUntilStalled(coro);
+  return result.IsReady() ? *result : Status::DeadlineExceeded();
+}
+
+TEST(CoroFrameAllocatorTest, CoroutinesRunWithFrameAllocator) {
+  AllocatorForTest<1024> heap;
+  CoroFrameAllocator<4> frames(heap);
+  CoroContext coro_cx(frames);
+  int out = 0;
+  EXPECT_EQ(RunToCompletion(AddsFive(coro_cx, out)), OkStatus());
+  EXPECT_EQ(out, 5);
+  EXPECT_EQ(frames.num_size_classes(), 2u);
+}
+
+TEST(CoroFrameAllocatorTest, FramesAreReused) {
+  AllocatorForTest<1024> heap;
+  CoroFrameAllocator<4> frames(heap);
+  CoroContext coro_cx(frames);
+  int out = 0;
+  ASSERT_EQ(RunToCompletion(AddsFive(coro_cx, out)), OkStatus());
+  size_t num_allocations = heap.metrics().num_allocations.value();
+  size_t allocated = frames.GetAllocated();
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(RunToCompletion(AddsFive(coro_cx, out)), OkStatus());
+  }
+  EXPECT_EQ(out, 55);
+  EXPECT_EQ(heap.metrics().num_allocations.value(), num_allocations);
+  EXPECT_EQ(heap.metrics().num_deallocations.value(), 0u);
+  EXPECT_EQ(frames.GetAllocated(), allocated);
+}
+
+TEST(CoroFrameAllocatorTest, ReleaseCachedFramesReturnsMemory) {
+  AllocatorForTest<1024> heap;
+  CoroFrameAllocator<4> frames(heap);
+  CoroContext coro_cx(frames);
+  int out = 0;
+  ASSERT_EQ(RunToCompletion(AddsFive(coro_cx, out)), OkStatus());
+  EXPECT_NE(frames.GetAllocated(), 0u);
+
+  frames.ReleaseCachedFrames();
+  EXPECT_EQ(frames.GetAllocated(), 0u);
+  EXPECT_EQ(heap.metrics().num_deallocations.value(),
+            heap.metrics().num_allocations.value());
+  EXPECT_EQ(frames.num_size_classes(), 2u);
+}
+
+TEST(CoroFrameAllocatorTest, UnclassifiedSizesPassThrough) {
+  AllocatorForTest<1024> heap;
+  CoroFrameAllocator<1> frames(heap);
+  void* learned = frames.Allocate(Layout(64, 8));
+  ASSERT_NE(learned, nullptr);
+  void* other = frames.Allocate(Layout(32, 8));
+  ASSERT_NE(other, nullptr);
+  EXPECT_EQ(frames.num_size_classes(), 1u);
+
+  frames.Deallocate(other);
+  EXPECT_EQ(heap.metrics().num_deallocations.value(), 1u);
+  frames.Deallocate(learned);
+  EXPECT_EQ(heap.metrics().num_deallocations.value(), 1u);
+  EXPECT_EQ(frames.Allocate(Layout(64, 8)), learned);
+  frames.Deallocate(learned);
+}
+
+TEST(CoroFrameAllocatorTest, CacheLimitIsRespected) {
+  AllocatorForTest<1024> heap;
+  CoroFrameAllocator<1> frames(heap, 1);
+  void* ptr1 = frames.Allocate(Layout(64, 8));
+  void* ptr2 = frames.Allocate(Layout(64, 8));
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+
+  frames.Deallocate(ptr1);
+  EXPECT_EQ(heap.metrics().num_deallocations.value(), 0u);
+  frames.Deallocate(ptr2);
+  EXPECT_EQ(heap.metrics().num_deallocations.value(), 1u);
+}
+
+// Exposes the protected layout queries.
+class InspectableFrameAllocator : public CoroFrameAllocator<1> {
+ public:
+  using CoroFrameAllocator<1>::CoroFrameAllocator;
+  using CoroFrameAllocator<1>::GetRequestedLayout;
+  using CoroFrameAllocator<1>::GetUsableLayout;
+};
+
+TEST(CoroFrameAllocatorTest, ReportsUsableButNotRequestedLayout) {
+  AllocatorForTest<1024> heap;
+  InspectableFrameAllocator frames(heap);
+  EXPECT_FALSE(
+      frames.HasCapability(pw::allocator::kImplementsGetRequestedLayout));
+
+  // Rounded up to the size of the free list pointer.
+  void* ptr = frames.Allocate(Layout(1, 1));
+  ASSERT_NE(ptr, nullptr);
+
+  EXPECT_EQ(frames.GetRequestedLayout(ptr).status(), Status::Unimplemented());
+  Result<Layout> usable = frames.GetUsableLayout(ptr);
+  ASSERT_EQ(usable.status(), OkStatus());
+  EXPECT_GE(usable->size(), sizeof(void*));
+  frames.Deallocate(ptr);
+}
+
+TEST(CoroFrameAllocatorTest, RespectsAlignment) {
+  AllocatorForTest<1024> heap;
+  CoroFrameAllocator<2> frames(heap);
+  void* ptr = frames.Allocate(Layout(48, 64));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0u);
+  frames.Deallocate(ptr);
+}
+
+}  // namespace
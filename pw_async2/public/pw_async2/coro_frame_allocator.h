@@ -0,0 +1,185 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/capability.h"
+#include "pw_allocator/layout.h"
+#include "pw_metric/metric.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+
+namespace pw::async2 {
+namespace internal {
+
+/// A frame layout learned by a `CoroFrameAllocator`, along with the frames of
+/// that layout which are available for reuse.
+///
+/// Freed frames are kept on an intrusive free list, with the first
+/// ``sizeof(void*)`` bytes of each free frame storing a pointer to the next
+/// one, in the same manner as ``pw::allocator::ChunkPool``.
+struct CoroFrameSizeClass {
+  /// Size of the frames in this class, or zero if the class is unclaimed.
+  size_t size = 0;
+  size_t alignment = 0;
+  std::byte* free_list = nullptr;
+  size_t num_cached = 0;
+};
+
+/// Type-erased implementation of ``CoroFrameAllocator``.
+class GenericCoroFrameAllocator : public allocator::Allocator {
+ public:
+  // Frames of a size class are recycled for any request that rounds to the
+  // class's size, so only the usable layout of a frame is known.
+  static constexpr allocator::Capabilities kCapabilities =
+      allocator::kImplementsGetUsableLayout;
+
+  /// Returns all cached frames to the wrapped allocator.
+  ///
+  /// Learned sizes are retained, so subsequent frames of those sizes will be
+  /// cached again when freed.
+  void ReleaseCachedFrames();
+
+  /// Returns the number of frame sizes that have been learned so far.
+  size_t num_size_classes() const { return num_size_classes_; }
+
+  const metric::Group& metric_group() const { return metrics_; }
+  metric::Group& metric_group() { return metrics_; }
+
+ protected:
+  GenericCoroFrameAllocator(Allocator& allocator,
+                            span<CoroFrameSizeClass> size_classes,
+                            size_t max_cached_per_class)
+      : Allocator(kCapabilities),
+        allocator_(allocator),
+        size_classes_(size_classes),
+        max_cached_per_class_(max_cached_per_class) {}
+
+ private:
+  // Bookkeeping stored immediately before each frame.
+  struct FrameHeader {
+    uint32_t size;
+    uint16_t offset;
+    uint16_t size_class;
+  };
+
+  static constexpr uint16_t kUnclassified = 0xFFFF;
+
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(allocator::Layout layout) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr, allocator::Layout) override {
+    DoDeallocate(ptr);
+  }
+
+  /// @copydoc Allocator::GetAllocated
+  size_t DoGetAllocated() const override { return allocated_; }
+
+  /// @copydoc Deallocator::GetInfo
+  Result<allocator::Layout> DoGetInfo(InfoType info_type,
+                                      const void* ptr) const override;
+
+  /// Returns the index of the size class for the given layout, claiming an
+  /// unused class if needed, or `kUnclassified` if all classes are in use by
+  /// other layouts.
+  uint16_t FindOrClaimSizeClass(allocator::Layout layout);
+
+  /// Allocates a new frame with a header from the wrapped allocator.
+  void* AllocateFrame(allocator::Layout layout, uint16_t size_class);
+
+  /// Returns a frame and its header to the wrapped allocator.
+  void DeallocateFrame(void* ptr);
+
+  static FrameHeader& GetHeader(void* ptr) {
+    return *(static_cast<FrameHeader*>(ptr) - 1);
+  }
+
+  static const FrameHeader& GetHeader(const void* ptr) {
+    return *(static_cast<const FrameHeader*>(ptr) - 1);
+  }
+
+  Allocator& allocator_;
+  span<CoroFrameSizeClass> size_classes_;
+  size_t num_size_classes_ = 0;
+  size_t max_cached_per_class_;
+  size_t allocated_ = 0;
+
+  PW_METRIC_GROUP(metrics_, "pw::async2::CoroFrameAllocator");
+  PW_METRIC(metrics_, frames_reused_, "frames_reused", 0u);
+  PW_METRIC(metrics_, frames_allocated_, "frames_allocated", 0u);
+  PW_METRIC(metrics_, frames_cached_, "frames_cached", 0u);
+  PW_METRIC(metrics_, unclassified_frames_, "unclassified_frames", 0u);
+};
+
+}  // namespace internal
+
+/// Allocator for coroutine frames that recycles freed frames by size.
+///
+/// Every function returning a `Coro<T>` has a single frame size that is fixed
+/// at compile time, so a program that repeatedly spawns the same coroutines
+/// requests the same handful of sizes over and over. This allocator learns
+/// those sizes as frames are requested, up to ``kNumSizeClasses`` distinct
+/// sizes, and keeps freed frames of each size on a free list instead of
+/// returning them to the wrapped allocator. Subsequent frames of that size are
+/// then allocated in constant time without touching the wrapped allocator,
+/// which also keeps short-lived frames from fragmenting its heap.
+///
+/// Frames with sizes that do not fit in a learned class are passed through to
+/// the wrapped allocator. Up to ``max_cached_per_class`` frames are retained
+/// per class; beyond that, freed frames are returned to the wrapped allocator.
+///
+/// Like most allocators, this type is not thread-safe. Coroutines are
+/// allocated and freed by the dispatcher thread that owns their
+/// ``CoroContext``, so a frame allocator per dispatcher acts as a thread-local
+/// cache. If frames are shared between threads, wrap this allocator in a
+/// ``pw::allocator::SynchronizedAllocator``.
+///
+/// @code{.cpp}
+///   pw::allocator::TlsfAllocator<> heap(buffer);
+///   pw::async2::CoroFrameAllocator<4> frames(heap);
+///   pw::async2::CoroContext coro_cx(frames);
+/// @endcode
+///
+/// @tparam   kNumSizeClasses   Maximum number of distinct frame sizes to cache.
+template <size_t kNumSizeClasses>
+class CoroFrameAllocator : public internal::GenericCoroFrameAllocator {
+ public:
+  static_assert(kNumSizeClasses > 0);
+
+  /// Constructs a frame allocator.
+  ///
+  /// @param  allocator             Allocator used to obtain frames that are
+  ///                               not available in the cache.
+  /// @param  max_cached_per_class  Maximum number of freed frames to retain
+  ///                               for each learned size.
+  explicit CoroFrameAllocator(allocator::Allocator& allocator,
+                              size_t max_cached_per_class = SIZE_MAX)
+      : internal::GenericCoroFrameAllocator(
+            allocator, size_classes_, max_cached_per_class) {}
+
+  ~CoroFrameAllocator() override { ReleaseCachedFrames(); }
+
+ private:
+  std::array<internal::CoroFrameSizeClass, kNumSizeClasses> size_classes_;
+};
+
+}  // namespace pw::async2
@@ -17,6 +17,8 @@
 #include "pw_blob_store/blob_store.h"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 
 #include "pw_assert/check.h"
 #include "pw_blob_store/internal/metadata_format.h"
@@ -88,6 +90,14 @@ Status BlobStore::LoadMetadata() {
     return Status::NotFound();
   }
 
+  // A pipelined write was interrupted. Its sectors past the write were never
+  // erased, so it can only be resumed as a pipelined write.
+  if (metadata.version ==
+      internal::MetadataVersion::kPipelinedWriteInProgress) {
+    write_mode_ = WriteMode::kPipelined;
+    return Status::NotFound();
+  }
+
   if (!ValidateChecksum(metadata.v1_metadata.data_size_bytes,
                         metadata.v1_metadata.checksum)
            .ok()) {
@@ -129,6 +139,13 @@ Status BlobStore::OpenWrite() {
   // overwriten on write Close.
   Invalidate().IgnoreError();
 
+  if (write_mode_ == WriteMode::kPipelined) {
+    if (Status status = MarkPipelinedWriteInProgress(); !status.ok()) {
+      writer_open_ = false;
+      return status;
+    }
+  }
+
   return OkStatus();
 }
 
@@ -150,7 +167,12 @@ StatusWithSize BlobStore::ResumeWrite() {
   // Invalidate return status can be safely be ignored, only KVS::Delete can
   // result in an error and that KVS entry will overwriten on write Close.
   Invalidate().IgnoreError();
-  StatusWithSize written_sws = partition_.EndOfWrittenData();
+  if (write_mode_ == WriteMode::kPipelined) {
+    PW_TRY_WITH_SIZE(MarkPipelinedWriteInProgress());
+  }
+  StatusWithSize written_sws = write_mode_ == WriteMode::kPipelined
+                                   ? EndOfPipelinedData()
+                                   : partition_.EndOfWrittenData();
   PW_TRY_WITH_SIZE(StatusWithSize(written_sws.status(), 0));
 
   // Round down to the number of fully written sectors.
@@ -173,6 +195,8 @@ StatusWithSize BlobStore::ResumeWrite() {
 
   flash_address_ = written_bytes_on_resume;
   write_address_ = written_bytes_on_resume;
+  erased_end_ = written_bytes_on_resume +
+                sectors_to_erase * partition_.sector_size_bytes();
   valid_data_ = true;
   writer_open_ = true;
 
@@ -428,18 +452,97 @@ Status BlobStore::CommitToFlash(ConstByteSpan source, size_t data_bytes) {
     data_bytes = source.size_bytes();
   }
 
+  const bool pipelined = write_mode_ == WriteMode::kPipelined;
+  if (pipelined) {
+    if (Status status = EraseAhead(flash_address_ + source.size_bytes());
+        !status.ok()) {
+      valid_data_ = false;
+      return status;
+    }
+  }
+
   flash_erased_ = false;
-  StatusWithSize result = partition_.Write(flash_address_, source);
+  Status status = partition_.Write(flash_address_, source).status();
+
+  // Pipelined writes verify each commit while it is fresh, instead of reading
+  // back the whole blob on close. Without a checksum algorithm there is
+  // nothing to verify against on close either, so skip the read back.
+  if (status.ok() && pipelined && checksum_algo_ != nullptr) {
+    status = VerifyCommit(flash_address_, source);
+  }
+
   flash_address_ += data_bytes;
   if (checksum_algo_ != nullptr) {
     checksum_algo_->Update(source.first(data_bytes));
   }
 
-  if (!result.status().ok()) {
+  if (!status.ok()) {
     valid_data_ = false;
   }
 
-  return result.status();
+  return status;
+}
+
+Status BlobStore::EraseAhead(kvs::FlashPartition::Address write_end) {
+  const size_t sector_size = partition_.sector_size_bytes();
+
+  // Keep one sector of look-ahead past the sector being written.
+  const size_t erase_end =
+      std::min(((write_end + sector_size - 1) / sector_size + 1) * sector_size,
+               partition_.size_bytes());
+  if (erased_end_ >= erase_end) {
+    return OkStatus();
+  }
+
+  // erased_end_ is always sector aligned.
+  const size_t erased_end_misalignment = erased_end_ % sector_size;
+  PW_DCHECK_UINT_EQ(erased_end_misalignment, 0);
+  PW_TRY(
+      partition_.Erase(erased_end_, (erase_end - erased_end_) / sector_size));
+  erased_end_ = erase_end;
+  return OkStatus();
+}
+
+Status BlobStore::VerifyCommit(kvs::FlashPartition::Address address,
+                               ConstByteSpan source) {
+  constexpr size_t kReadBufferSizeBytes = 32;
+  std::array<std::byte, kReadBufferSizeBytes> buffer;
+  while (!source.empty()) {
+    const size_t read_size = std::min(source.size_bytes(), buffer.size());
+    PW_TRY(partition_.Read(address, span(buffer).first(read_size)));
+    if (std::memcmp(buffer.data(), source.data(), read_size) != 0) {
+      PW_LOG_ERROR("Blob data at 0x%x does not match the data written",
+                   static_cast<unsigned>(address));
+      return Status::DataLoss();
+    }
+    address += read_size;
+    source = source.subspan(read_size);
+  }
+  return OkStatus();
+}
+
+StatusWithSize BlobStore::EndOfPipelinedData() {
+  const size_t sector_size = partition_.sector_size_bytes();
+
+  constexpr size_t kReadBufferSizeBytes = 32;
+  std::array<std::byte, kReadBufferSizeBytes> buffer;
+  for (size_t sector = 0; sector < partition_.sector_count(); ++sector) {
+    const kvs::FlashPartition::Address sector_start = sector * sector_size;
+    bool erased = true;
+    for (size_t offset = 0; erased && offset < sector_size;
+         offset += buffer.size()) {
+      const size_t read_size = std::min(sector_size - offset, buffer.size());
+      ByteSpan data = span(buffer).first(read_size);
+      PW_TRY_WITH_SIZE(partition_.Read(sector_start + offset, data));
+      erased = std::all_of(data.begin(), data.end(), [this](std::byte b) {
+        return b == partition_.erased_memory_content();
+      });
+    }
+    if (erased) {
+      return StatusWithSize(sector_start);
+    }
+  }
+  return StatusWithSize(partition_.size_bytes());
 }
 
 // Needs to be in .cc file since PW_CHECK doesn't like being in .h files.
@@ -457,6 +560,12 @@ size_t BlobStore::WriteBufferBytesFree() const {
 
 Status BlobStore::EraseIfNeeded() {
   if (flash_address_ == 0) {
+    if (write_mode_ == WriteMode::kPipelined) {
+      // Sectors are erased just ahead of the data as it is committed. The blob
+      // is valid from the start, just as if the partition had been erased.
+      valid_data_ = true;
+      return OkStatus();
+    }
     // Always just erase. Erase is smart enough to only erase if needed.
     return Erase();
   }
@@ -518,6 +627,7 @@ Status BlobStore::Erase() {
   PW_TRY(partition_.Erase());
 
   flash_erased_ = true;
+  erased_end_ = partition_.size_bytes();
 
   // Blob data is considered valid as soon as the flash is erased. Even though
   // there are 0 bytes written, they are valid.
@@ -532,6 +642,7 @@ Status BlobStore::Invalidate() {
   ResetChecksum();
   write_address_ = 0;
   flash_address_ = 0;
+  erased_end_ = flash_erased_ ? partition_.size_bytes() : 0;
   file_name_length_ = 0;
 
   Status status = kvs_.acquire()->Delete(MetadataKey());
@@ -539,6 +650,13 @@ Status BlobStore::Invalidate() {
   return (status.ok() || status.IsNotFound()) ? OkStatus() : Status::Internal();
 }
 
+Status BlobStore::MarkPipelinedWriteInProgress() {
+  BlobMetadataHeader marker;
+  marker.reset();
+  marker.version = internal::MetadataVersion::kPipelinedWriteInProgress;
+  return kvs_.acquire()->Put(MetadataKey(), as_bytes(span(&marker, 1)));
+}
+
 Status BlobStore::ValidateChecksum(size_t blob_size_bytes,
                                    ChecksumValue expected) {
   if (blob_size_bytes == 0) {
@@ -682,8 +800,9 @@ Status BlobStore::BlobWriter::WriteMetadata() {
   }
 
   // Check the in-memory checksum against the data that was actually committed
-  // to flash.
-  if (!store_.ValidateChecksum(store_.flash_address_, calculated_checksum)
+  // to flash. Pipelined writes already verified each commit as it was written.
+  if (store_.write_mode_ != WriteMode::kPipelined &&
+      !store_.ValidateChecksum(store_.flash_address_, calculated_checksum)
            .ok()) {
     PW_CHECK_OK(store_.Invalidate());
     return Status::DataLoss();
@@ -0,0 +1,378 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_assert/assert.h"
+#include "pw_blob_store/blob_store.h"
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/test_key_value_store.h"
+#include "pw_log/log.h"
+#include "pw_random/xor_shift.h"
+#include "pw_span/span.h"
+#include "pw_status/try.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::blob_store {
+namespace {
+
+constexpr size_t kFlashAlignment = 16;
+constexpr size_t kSectorSize = 512;
+constexpr size_t kSectorCount = 8;
+constexpr size_t kPartitionSize = kSectorSize * kSectorCount;
+
+// Simulated costs of flash operations, in arbitrary ticks. The ratios are
+// typical of NOR flash, where erasing a sector costs far more than
+// programming or reading it.
+constexpr uint64_t kEraseTicksPerSector = 20000;
+constexpr uint64_t kWriteTicksPerByte = 4;
+constexpr uint64_t kReadTicksPerByte = 1;
+
+// Fake flash that tallies the operations performed on it and their simulated
+// cost, and that can corrupt a write to exercise verification.
+class LatencyModelFlash
+    : public kvs::FakeFlashMemoryBuffer<kSectorSize, kSectorCount> {
+ public:
+  using Base = kvs::FakeFlashMemoryBuffer<kSectorSize, kSectorCount>;
+
+  explicit LatencyModelFlash(size_t alignment_bytes) : Base(alignment_bytes) {}
+
+  Status Erase(Address address, size_t num_sectors) override {
+    sectors_erased_ += num_sectors;
+    ticks_ += num_sectors * kEraseTicksPerSector;
+    return Base::Erase(address, num_sectors);
+  }
+
+  StatusWithSize Read(Address address, span<std::byte> output) override {
+    bytes_read_ += output.size();
+    ticks_ += output.size() * kReadTicksPerByte;
+    return Base::Read(address, output);
+  }
+
+  StatusWithSize Write(Address address, span<const std::byte> data) override {
+    bytes_written_ += data.size();
+    ticks_ += data.size() * kWriteTicksPerByte;
+    StatusWithSize result = Base::Write(address, data);
+    if (corrupt_next_write_ && result.ok()) {
+      // Model a bit that failed to program.
+      buffer()[address] ^= std::byte{0x01};
+      corrupt_next_write_ = false;
+    }
+    return result;
+  }
+
+  void ResetCounters() {
+    ticks_ = 0;
+    sectors_erased_ = 0;
+    bytes_read_ = 0;
+    bytes_written_ = 0;
+  }
+
+  void CorruptNextWrite() { corrupt_next_write_ = true; }
+
+  uint64_t ticks() const { return ticks_; }
+  size_t sectors_erased() const { return sectors_erased_; }
+  size_t bytes_read() const { return bytes_read_; }
+  size_t bytes_written() const { return bytes_written_; }
+
+ private:
+  uint64_t ticks_ = 0;
+  size_t sectors_erased_ = 0;
+  size_t bytes_read_ = 0;
+  size_t bytes_written_ = 0;
+  bool corrupt_next_write_ = false;
+};
+
+class BlobStorePipelinedWriteTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kBufferSize = 256;
+  static constexpr size_t kFlashWriteSize = 64;
+  static constexpr size_t kMetadataBufferSize =
+      BlobStore::BlobWriter::RequiredMetadataBufferSize(0);
+
+  BlobStorePipelinedWriteTest() : flash_(kFlashAlignment), partition_(&flash_) {
+    random::XorShiftStarRng64 rng(0x5eed);
+    rng.Get(source_buffer_);
+  }
+
+  // Fills the partition with a non-erased pattern, as left behind by an
+  // earlier, larger blob.
+  void InitFlashToStaleData() {
+    std::memset(flash_.buffer().data(), 0x5a, flash_.buffer().size());
+  }
+
+  // Writes source data in chunks of chunk_size, then closes the writer.
+  Status WriteBlob(BlobStore::BlobWriter& writer,
+                   ConstByteSpan data,
+                   size_t chunk_size) {
+    while (!data.empty()) {
+      const size_t write_size = std::min(data.size(), chunk_size);
+      PW_TRY(writer.Write(data.first(write_size)));
+      data = data.subspan(write_size);
+    }
+    return OkStatus();
+  }
+
+  void VerifyBlob(BlobStore& blob, ConstByteSpan expected) {
+    BlobStore::BlobReader reader(blob);
+    ASSERT_EQ(OkStatus(), reader.Open());
+    Result<ConstByteSpan> result = reader.GetMemoryMappedBlob();
+    ASSERT_EQ(OkStatus(), result.status());
+    ASSERT_EQ(expected.size(), result->size());
+    EXPECT_EQ(
+        std::memcmp(expected.data(), result->data(), expected.size()), 0);
+    EXPECT_EQ(OkStatus(), reader.Close());
+  }
+
+  LatencyModelFlash flash_;
+  kvs::FlashPartition partition_;
+  kvs::ChecksumCrc16 checksum_;
+  std::array<std::byte, kMetadataBufferSize> metadata_buffer_;
+  std::array<std::byte, kPartitionSize> source_buffer_;
+};
+
+TEST_F(BlobStorePipelinedWriteTest, SetWriteModeFailsWhileWriterOpen) {
+  BlobStoreBuffer<kBufferSize> blob(
+      "Mode", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  EXPECT_EQ(BlobStore::WriteMode::kEraseFirst, blob.write_mode());
+
+  BlobStore::BlobWriter writer(blob, metadata_buffer_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  EXPECT_EQ(Status::FailedPrecondition(),
+            blob.SetWriteMode(BlobStore::WriteMode::kPipelined));
+  ASSERT_EQ(OkStatus(), writer.Close());
+
+  EXPECT_EQ(OkStatus(), blob.SetWriteMode(BlobStore::WriteMode::kPipelined));
+  EXPECT_EQ(BlobStore::WriteMode::kPipelined, blob.write_mode());
+}
+
+TEST_F(BlobStorePipelinedWriteTest, ErasesOnlySectorsInUse) {
+  InitFlashToStaleData();
+  BlobStoreBuffer<kBufferSize> blob(
+      "InUse", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  ASSERT_EQ(OkStatus(), blob.SetWriteMode(BlobStore::WriteMode::kPipelined));
+
+  // Two and a half sectors, written in chunks unaligned to the flash write
+  // size.
+  ConstByteSpan data = span(source_buffer_).first(kSectorSize * 5 / 2);
+  flash_.ResetCounters();
+  BlobStore::BlobWriter writer(blob, metadata_buffer_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  ASSERT_EQ(OkStatus(), WriteBlob(writer, data, 100));
+  ASSERT_EQ(OkStatus(), writer.Close());
+
+  // The three sectors holding data, plus one sector of look-ahead.
+  EXPECT_EQ(flash_.sectors_erased(), 4u);
+  VerifyBlob(blob, data);
+
+  // Data survives a reload of the metadata.
+  BlobStoreBuffer<kBufferSize> reloaded(
+      "InUse", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+  ASSERT_EQ(OkStatus(), reloaded.Init());
+  VerifyBlob(reloaded, data);
+}
+
+TEST_F(BlobStorePipelinedWriteTest, ExplicitEraseIsNotRepeated) {
+  BlobStoreBuffer<kBufferSize> blob(
+      "Erased", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  ASSERT_EQ(OkStatus(), blob.SetWriteMode(BlobStore::WriteMode::kPipelined));
+
+  BlobStore::BlobWriter writer(blob, metadata_buffer_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  ASSERT_EQ(OkStatus(), writer.Erase());
+
+  flash_.ResetCounters();
+  ConstByteSpan data = span(source_buffer_).first(kSectorSize * 3);
+  ASSERT_EQ(OkStatus(), WriteBlob(writer, data, kSectorSize));
+  ASSERT_EQ(OkStatus(), writer.Close());
+  EXPECT_EQ(flash_.sectors_erased(), 0u);
+  VerifyBlob(blob, data);
+}
+
+TEST_F(BlobStorePipelinedWriteTest, CorruptCommitIsDetected) {
+  BlobStoreBuffer<kBufferSize> blob(
+      "Corrupt", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  ASSERT_EQ(OkStatus(), blob.SetWriteMode(BlobStore::WriteMode::kPipelined));
+
+  BlobStore::BlobWriter writer(blob, metadata_buffer_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  ConstByteSpan data = span(source_buffer_).first(kSectorSize);
+  ASSERT_EQ(OkStatus(), writer.Write(data.first(kFlashWriteSize)));
+
+  flash_.CorruptNextWrite();
+  EXPECT_EQ(Status::DataLoss(),
+            writer.Write(data.subspan(kFlashWriteSize, kFlashWriteSize)));
+  EXPECT_EQ(Status::DataLoss(), writer.Close());
+  EXPECT_FALSE(blob.HasData());
+}
+
+TEST_F(BlobStorePipelinedWriteTest, ResumeIgnoresStaleDataPastCursor) {
+  InitFlashToStaleData();
+  ConstByteSpan data = span(source_buffer_).first(kSectorSize * 6);
+
+  // Write three and a half sectors, then abandon the write.
+  {
+    BlobStoreBuffer<kBufferSize> blob(
+        "Resume", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+    ASSERT_EQ(OkStatus(), blob.Init());
+    ASSERT_EQ(OkStatus(), blob.SetWriteMode(BlobStore::WriteMode::kPipelined));
+    BlobStore::BlobWriter writer(blob, metadata_buffer_);
+    ASSERT_EQ(OkStatus(), writer.Open());
+    ASSERT_EQ(OkStatus(),
+              WriteBlob(writer, data.first(kSectorSize * 7 / 2), 256));
+    ASSERT_EQ(OkStatus(), writer.Abandon());
+  }
+
+  // Resume from a fresh instance, as after a reboot. The partially written
+  // sector and the one before it are dropped.
+  BlobStoreBuffer<kBufferSize> blob(
+      "Resume", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  ASSERT_EQ(OkStatus(), blob.SetWriteMode(BlobStore::WriteMode::kPipelined));
+  BlobStore::BlobWriter writer(blob, metadata_buffer_);
+  StatusWithSize resume_sws = writer.Resume();
+  ASSERT_EQ(OkStatus(), resume_sws.status());
+  EXPECT_EQ(resume_sws.size(), kSectorSize * 3);
+
+  ASSERT_EQ(OkStatus(),
+            WriteBlob(writer, data.subspan(resume_sws.size()), 256));
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(blob, data);
+}
+
+TEST_F(BlobStorePipelinedWriteTest, ResumeAfterRebootKeepsPipelinedMode) {
+  InitFlashToStaleData();
+  ConstByteSpan data = span(source_buffer_).first(kSectorSize * 6);
+
+  {
+    BlobStoreBuffer<kBufferSize> blob(
+        "Reboot", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+    ASSERT_EQ(OkStatus(), blob.Init());
+    ASSERT_EQ(OkStatus(), blob.SetWriteMode(BlobStore::WriteMode::kPipelined));
+    BlobStore::BlobWriter writer(blob, metadata_buffer_);
+    ASSERT_EQ(OkStatus(), writer.Open());
+    ASSERT_EQ(OkStatus(),
+              WriteBlob(writer, data.first(kSectorSize * 7 / 2), 256));
+    // Leaves the write as a reboot would.
+    ASSERT_EQ(OkStatus(), writer.Abandon());
+  }
+
+  // The write mode is not selected again after the reboot.
+  BlobStoreBuffer<kBufferSize> blob(
+      "Reboot", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  EXPECT_EQ(blob.write_mode(), BlobStore::WriteMode::kPipelined);
+  {
+    BlobStore::BlobWriter writer(blob, metadata_buffer_);
+    StatusWithSize resume_sws = writer.Resume();
+    ASSERT_EQ(OkStatus(), resume_sws.status());
+    EXPECT_EQ(resume_sws.size(), kSectorSize * 3);
+
+    ASSERT_EQ(OkStatus(),
+              WriteBlob(writer, data.subspan(resume_sws.size()), 256));
+    ASSERT_EQ(OkStatus(), writer.Close());
+  }
+  VerifyBlob(blob, data);
+
+  // Once the blob is closed, the default mode applies again.
+  BlobStoreBuffer<kBufferSize> rebooted(
+      "Reboot", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+  ASSERT_EQ(OkStatus(), rebooted.Init());
+  EXPECT_EQ(rebooted.write_mode(), BlobStore::WriteMode::kEraseFirst);
+  VerifyBlob(rebooted, data);
+}
+
+struct WriteCosts {
+  uint64_t ticks_to_first_commit;
+  uint64_t ticks_to_close;
+  size_t sectors_erased;
+  size_t bytes_read;
+};
+
+WriteCosts MeasureWrite(LatencyModelFlash& flash,
+                        BlobStore& blob,
+                        ByteSpan metadata_buffer,
+                        ConstByteSpan data,
+                        size_t chunk_size) {
+  WriteCosts costs{};
+  flash.ResetCounters();
+
+  BlobStore::BlobWriter writer(blob, metadata_buffer);
+  PW_ASSERT(writer.Open().ok());
+  PW_ASSERT(writer.Write(data.first(chunk_size)).ok());
+  costs.ticks_to_first_commit = flash.ticks();
+  data = data.subspan(chunk_size);
+  while (!data.empty()) {
+    PW_ASSERT(writer.Write(data.first(chunk_size)).ok());
+    data = data.subspan(chunk_size);
+  }
+  PW_ASSERT(writer.Close().ok());
+
+  costs.ticks_to_close = flash.ticks();
+  costs.sectors_erased = flash.sectors_erased();
+  costs.bytes_read = flash.bytes_read();
+  return costs;
+}
+
+TEST_F(BlobStorePipelinedWriteTest, LatencyModelComparison) {
+  // A blob using a quarter of the partition, streamed in 256 byte chunks.
+  ConstByteSpan data = span(source_buffer_).first(kSectorSize * 2);
+  constexpr size_t kChunkSize = 256;
+
+  BlobStoreBuffer<kBufferSize> erase_first(
+      "EraseFirst", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+  ASSERT_EQ(OkStatus(), erase_first.Init());
+  const WriteCosts erase_first_costs = MeasureWrite(
+      flash_, erase_first, metadata_buffer_, data, kChunkSize);
+  VerifyBlob(erase_first, data);
+
+  BlobStoreBuffer<kBufferSize> pipelined(
+      "Pipelined", partition_, &checksum_, kvs::TestKvs(), kFlashWriteSize);
+  ASSERT_EQ(OkStatus(), pipelined.Init());
+  ASSERT_EQ(OkStatus(),
+            pipelined.SetWriteMode(BlobStore::WriteMode::kPipelined));
+  const WriteCosts pipelined_costs =
+      MeasureWrite(flash_, pipelined, metadata_buffer_, data, kChunkSize);
+  VerifyBlob(pipelined, data);
+
+  PW_LOG_INFO("Erase first: %u ticks to first commit, %u to close",
+              static_cast<unsigned>(erase_first_costs.ticks_to_first_commit),
+              static_cast<unsigned>(erase_first_costs.ticks_to_close));
+  PW_LOG_INFO("Pipelined:   %u ticks to first commit, %u to close",
+              static_cast<unsigned>(pipelined_costs.ticks_to_first_commit),
+              static_cast<unsigned>(pipelined_costs.ticks_to_close));
+
+  // Only the sectors the blob uses, plus look-ahead, are erased.
+  EXPECT_EQ(erase_first_costs.sectors_erased, kSectorCount);
+  EXPECT_EQ(pipelined_costs.sectors_erased, 3u);
+  EXPECT_LT(pipelined_costs.ticks_to_first_commit,
+            erase_first_costs.ticks_to_first_commit);
+  EXPECT_LT(pipelined_costs.ticks_to_close, erase_first_costs.ticks_to_close);
+
+  // Verification reads the same number of bytes, spread across the commits
+  // instead of all at once in Close.
+  EXPECT_EQ(pipelined_costs.bytes_read, erase_first_costs.bytes_read);
+}
+
+}  // namespace
+}  // namespace pw::blob_store
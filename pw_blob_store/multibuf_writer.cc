@@ -0,0 +1,36 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_blob_store/multibuf_writer.h"
+
+#include "pw_bytes/span.h"
+#include "pw_status/try.h"
+
+namespace pw::blob_store {
+
+Status WriteMultiBuf(BlobStore::BlobWriter& writer,
+                     const multibuf::MultiBuf& data) {
+  if (!writer.IsOpen()) {
+    return Status::FailedPrecondition();
+  }
+  if (data.size() > writer.ConservativeWriteLimit()) {
+    return Status::ResourceExhausted();
+  }
+  for (const multibuf::Chunk& chunk : data.Chunks()) {
+    PW_TRY(writer.Write(ConstByteSpan(chunk.data(), chunk.size())));
+  }
+  return OkStatus();
+}
+
+}  // namespace pw::blob_store
@@ -0,0 +1,128 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_blob_store/multibuf_writer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include "pw_allocator/testing.h"
+#include "pw_assert/assert.h"
+#include "pw_blob_store/blob_store.h"
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/test_key_value_store.h"
+#include "pw_multibuf/from_span.h"
+#include "pw_random/xor_shift.h"
+#include "pw_span/span.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::blob_store {
+namespace {
+
+using ::pw::allocator::test::AllocatorForTest;
+
+class MultiBufWriterTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kFlashAlignment = 16;
+  static constexpr size_t kSectorSize = 1024;
+  static constexpr size_t kSectorCount = 2;
+  static constexpr size_t kBlobDataSize = kSectorSize * kSectorCount;
+  static constexpr size_t kBufferSize = 64;
+  static constexpr size_t kMetadataBufferSize =
+      BlobStore::BlobWriter::RequiredMetadataBufferSize(0);
+
+  MultiBufWriterTest()
+      : flash_(kFlashAlignment),
+        partition_(&flash_),
+        blob_("MultiBuf", partition_, &checksum_, kvs::TestKvs(), kBufferSize) {
+    random::XorShiftStarRng64 rng(0x1234);
+    rng.Get(source_buffer_);
+  }
+
+  void SetUp() override { ASSERT_EQ(OkStatus(), blob_.Init()); }
+
+  // Builds a MultiBuf that references consecutive regions of the source
+  // buffer, one chunk per size in chunk_sizes.
+  multibuf::MultiBuf MakeMultiBuf(span<const size_t> chunk_sizes) {
+    multibuf::MultiBuf buf;
+    size_t offset = 0;
+    for (size_t size : chunk_sizes) {
+      ByteSpan region = span(source_buffer_).subspan(offset, size);
+      std::optional<multibuf::MultiBuf> chunk =
+          multibuf::FromSpan(meta_alloc_, region, [](ByteSpan) {});
+      PW_ASSERT(chunk.has_value());
+      buf.PushSuffix(std::move(*chunk));
+      offset += size;
+    }
+    return buf;
+  }
+
+  kvs::FakeFlashMemoryBuffer<kSectorSize, kSectorCount> flash_;
+  kvs::FlashPartition partition_;
+  kvs::ChecksumCrc16 checksum_;
+  BlobStoreBuffer<kBufferSize> blob_;
+  AllocatorForTest<1024> meta_alloc_;
+  std::array<std::byte, kMetadataBufferSize> metadata_buffer_;
+  std::array<std::byte, kBlobDataSize> source_buffer_;
+};
+
+TEST_F(MultiBufWriterTest, WritesAllChunks) {
+  // Chunks both smaller and larger than the flash write size, and not aligned
+  // to it.
+  constexpr std::array<size_t, 4> kChunkSizes = {10, 300, 64, 650};
+  multibuf::MultiBuf buf = MakeMultiBuf(kChunkSizes);
+  ASSERT_EQ(buf.Chunks().size(), kChunkSizes.size());
+
+  BlobStore::BlobWriter writer(blob_, metadata_buffer_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  ASSERT_EQ(OkStatus(), WriteMultiBuf(writer, buf));
+  EXPECT_EQ(writer.CurrentSizeBytes(), buf.size());
+  ASSERT_EQ(OkStatus(), writer.Close());
+
+  BlobStore::BlobReader reader(blob_);
+  ASSERT_EQ(OkStatus(), reader.Open());
+  Result<ConstByteSpan> result = reader.GetMemoryMappedBlob();
+  ASSERT_EQ(OkStatus(), result.status());
+  ASSERT_EQ(result->size(), buf.size());
+  EXPECT_EQ(
+      std::memcmp(source_buffer_.data(), result->data(), result->size()), 0);
+  EXPECT_EQ(OkStatus(), reader.Close());
+}
+
+TEST_F(MultiBufWriterTest, FailsWhenClosed) {
+  constexpr std::array<size_t, 1> kChunkSizes = {64};
+  multibuf::MultiBuf buf = MakeMultiBuf(kChunkSizes);
+  BlobStore::BlobWriter writer(blob_, metadata_buffer_);
+  EXPECT_EQ(Status::FailedPrecondition(), WriteMultiBuf(writer, buf));
+}
+
+TEST_F(MultiBufWriterTest, WritesNothingWhenTooLarge) {
+  constexpr std::array<size_t, 2> kChunkSizes = {kBlobDataSize - 64, 64};
+  multibuf::MultiBuf buf = MakeMultiBuf(kChunkSizes);
+
+  BlobStore::BlobWriter writer(blob_, metadata_buffer_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  ASSERT_EQ(OkStatus(), writer.Write(span(source_buffer_).first(64)));
+  EXPECT_EQ(Status::ResourceExhausted(), WriteMultiBuf(writer, buf));
+  EXPECT_EQ(writer.CurrentSizeBytes(), 64u);
+  EXPECT_EQ(OkStatus(), writer.Close());
+}
+
+}  // namespace
+}  // namespace pw::blob_store
@@ -56,6 +56,19 @@ namespace pw::blob_store {
 //  3) BlobReader::Close().
 class BlobStore {
  public:
+  // How a BlobStore prepares flash and verifies data while writing a blob.
+  enum class WriteMode {
+    // Erase the whole partition before the first write, and re-read the whole
+    // blob to validate its checksum on Close. This is the default.
+    kEraseFirst,
+
+    // Erase sectors just ahead of the data as it is committed, and read back
+    // each commit to verify it as it is written. This spreads the erase and
+    // verification costs across the write, only erases the sectors the blob
+    // actually uses, and makes Close cost independent of the blob size.
+    kPipelined,
+  };
+
   // Implement the stream::Writer and erase interface for a BlobStore. If not
   // already erased, the Write will do any needed erase.
   //
@@ -446,7 +459,9 @@ class BlobStore {
         readers_open_(0),
         write_address_(0),
         flash_address_(0),
-        file_name_length_(0) {}
+        file_name_length_(0),
+        write_mode_(WriteMode::kEraseFirst),
+        erased_end_(0) {}
 
   BlobStore(const BlobStore&) = delete;
   BlobStore& operator=(const BlobStore&) = delete;
@@ -471,6 +486,26 @@ class BlobStore {
   // false -  Blob is either invalid or does not have any data bytes
   bool HasData() const { return (valid_data_ && ReadableDataBytes() > 0); }
 
+  // Select how subsequent blob writes erase flash and verify data. The mode
+  // can only be changed while no writer is open.
+  //
+  // The mode of a pipelined write that was abandoned or interrupted is kept in
+  // KVS, and Init() restores it, so that Resume() continues the write in the
+  // same mode. Select the mode again after Init() to start a new write in a
+  // different mode. Returns:
+  //
+  // OK - success.
+  // FAILED_PRECONDITION - a writer is open.
+  Status SetWriteMode(WriteMode mode) {
+    if (writer_open_) {
+      return Status::FailedPrecondition();
+    }
+    write_mode_ = mode;
+    return OkStatus();
+  }
+
+  WriteMode write_mode() const { return write_mode_; }
+
  private:
   Status LoadMetadata();
 
@@ -576,6 +611,26 @@ class BlobStore {
 
   Status EraseIfNeeded();
 
+  // Pipelined writes: erase any not yet erased sectors up to and including the
+  // sector after the one containing write_end, so that the next commit never
+  // waits on a sector erase in the common case.
+  Status EraseAhead(kvs::FlashPartition::Address write_end);
+
+  // Pipelined writes: read back data committed at address and compare it with
+  // the source. Returns DATA_LOSS on mismatch.
+  Status VerifyCommit(kvs::FlashPartition::Address address,
+                      ConstByteSpan source);
+
+  // Pipelined writes: size in bytes of the sectors before the first fully
+  // erased sector. Pipelined writes always keep the sector after the write
+  // cursor erased, so this bounds the data of an interrupted write.
+  StatusWithSize EndOfPipelinedData();
+
+  // Pipelined writes: record in KVS that a pipelined write is in progress, in
+  // place of the blob metadata. Init() then restores the pipelined write mode,
+  // so a write interrupted by a reboot is resumed as a pipelined write.
+  Status MarkPipelinedWriteInProgress();
+
   // Read valid data. Attempts to read the lesser of output.size_bytes() or
   // available bytes worth of data. Returns:
   //
@@ -675,6 +730,12 @@ class BlobStore {
 
   // Length of the stored blob's filename.
   size_t file_name_length_;
+
+  WriteMode write_mode_;
+
+  // Pipelined writes: flash from flash_address_ up to this address is known to
+  // be erased.
+  kvs::FlashPartition::Address erased_end_;
 };
 
 // Creates a BlobStore with the buffer of kBufferSizeBytes.
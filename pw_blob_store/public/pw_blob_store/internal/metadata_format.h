@@ -24,7 +24,12 @@ enum MetadataVersion : uint32_t {
   // Original metadata format does not include a version.
   kVersion1 = 0,
   kVersion2 = 0x1197851D,
-  kLatest = kVersion2
+  kLatest = kVersion2,
+
+  // Not a stored blob, but a marker that a pipelined write is in progress, so
+  // that an interrupted write is resumed in the same mode. Only the version of
+  // the header is meaningful.
+  kPipelinedWriteInProgress = 0x7E1D0F35,
 };
 
 // Technically the original BlobMetadataV1 was not packed.
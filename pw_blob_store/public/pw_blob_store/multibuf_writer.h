@@ -0,0 +1,39 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_blob_store/blob_store.h"
+#include "pw_multibuf/multibuf.h"
+#include "pw_status/status.h"
+
+namespace pw::blob_store {
+
+// Writes the contents of a MultiBuf to an open BlobWriter, one chunk at a
+// time, without first gathering the chunks into a contiguous buffer. With a
+// non-deferred writer, whole flash_write_size_bytes blocks are committed
+// directly from each chunk's memory; only partial blocks are staged in the
+// BlobStore's write buffer.
+//
+// Returns:
+//
+// OK - success.
+// FAILED_PRECONDITION - writer is not open.
+// RESOURCE_EXHAUSTED - the MultiBuf does not fit in the space currently
+//     available to the writer. No data written.
+// [error status] - a chunk failed to write. Any preceding chunks remain
+//     written.
+Status WriteMultiBuf(BlobStore::BlobWriter& writer,
+                     const multibuf::MultiBuf& data);
+
+}  // namespace pw::blob_store
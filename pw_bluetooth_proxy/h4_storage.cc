@@ -14,43 +14,81 @@
 
 #include "pw_bluetooth_proxy/internal/h4_storage.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <mutex>
 
+#include "lib/stdcompat/bit.h"
+#include "pw_allocator/layout.h"
 #include "pw_assert/check.h"
 
 namespace pw::bluetooth::proxy {
 
-std::array<containers::Pair<uint8_t*, bool>, H4Storage::kNumH4Buffs>
-H4Storage::InitOccupiedMap() {
-  std::lock_guard lock(storage_mutex_);
-  std::array<containers::Pair<uint8_t*, bool>, kNumH4Buffs> arr;
-  for (size_t i = 0; i < kNumH4Buffs; ++i) {
-    arr[i] = {h4_buffs_[i].data(), false};
+H4Storage::H4Storage(span<std::array<uint8_t, kH4BuffSize>> buffs)
+    : num_buffs_(buffs.size()) {
+  PW_CHECK(num_buffs_ <= kMaxNumH4Buffs,
+           "Invalid number of H4 buffers: %zu",
+           num_buffs_);
+  buffs_ = reinterpret_cast<uint8_t*>(buffs.data());
+  InitFreeBitmap();
+}
+
+H4Storage::H4Storage(Allocator& allocator, size_t num_buffs)
+    : allocator_(&allocator), num_buffs_(num_buffs) {
+  PW_CHECK(num_buffs_ > 0 && num_buffs_ <= kMaxNumH4Buffs,
+           "Invalid number of H4 buffers: %zu",
+           num_buffs_);
+  buffs_ = static_cast<uint8_t*>(
+      allocator_->Allocate(allocator::Layout(num_buffs_ * kH4BuffSize)));
+  PW_CHECK_NOTNULL(buffs_, "Failed to allocate %zu H4 buffers.", num_buffs_);
+  InitFreeBitmap();
+}
+
+H4Storage::~H4Storage() {
+  if (allocator_ != nullptr) {
+    allocator_->Deallocate(buffs_);
   }
-  return arr;
 }
 
-H4Storage::H4Storage() : h4_buff_occupied_(InitOccupiedMap()) {}
+void H4Storage::InitFreeBitmap() {
+  std::lock_guard lock(storage_mutex_);
+  for (size_t i = 0; i < num_buffs_; ++i) {
+    free_bitmap_[i / kBitsPerWord] |= uint32_t{1} << (i % kBitsPerWord);
+  }
+}
 
 std::optional<pw::span<uint8_t>> H4Storage::ReserveH4Buff() {
   std::lock_guard lock(storage_mutex_);
-  for (const auto& [buff, occupied] : h4_buff_occupied_) {
-    if (!occupied) {
-      h4_buff_occupied_.at(buff) = true;
-      pw::span<uint8_t> h4_buff = {buff, kH4BuffSize};
-      std::fill(h4_buff.begin(), h4_buff.end(), 0);
-      return h4_buff;
+  for (size_t word = 0; word < free_bitmap_.size(); ++word) {
+    if (free_bitmap_[word] == 0) {
+      continue;
     }
+    const size_t bit =
+        static_cast<size_t>(cpp20::countr_zero(free_bitmap_[word]));
+    free_bitmap_[word] &= ~(uint32_t{1} << bit);
+    pw::span<uint8_t> h4_buff = {
+        buffs_ + (word * kBitsPerWord + bit) * kH4BuffSize, kH4BuffSize};
+    std::fill(h4_buff.begin(), h4_buff.end(), 0);
+    return h4_buff;
   }
   return std::nullopt;
 }
 
 void H4Storage::ReleaseH4Buff(const uint8_t* buffer) {
   std::lock_guard lock(storage_mutex_);
-  PW_CHECK(h4_buff_occupied_.contains(const_cast<uint8_t*>(buffer)),
+  const uintptr_t address = reinterpret_cast<uintptr_t>(buffer);
+  const uintptr_t base = reinterpret_cast<uintptr_t>(buffs_);
+  const size_t offset = static_cast<size_t>(address - base);
+  const bool is_buffer_start = offset % kH4BuffSize == 0;
+  PW_CHECK(address >= base && offset < num_buffs_ * kH4BuffSize &&
+               is_buffer_start,
            "Received release callback for invalid buffer address.");
 
-  h4_buff_occupied_.at(const_cast<uint8_t*>(buffer)) = false;
+  const size_t index = offset / kH4BuffSize;
+  const uint32_t mask = uint32_t{1} << (index % kBitsPerWord);
+  PW_CHECK((free_bitmap_[index / kBitsPerWord] & mask) == 0,
+           "Received release callback for unoccupied buffer.");
+  free_bitmap_[index / kBitsPerWord] |= mask;
 }
 
 }  // namespace pw::bluetooth::proxy
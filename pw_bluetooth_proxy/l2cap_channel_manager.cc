@@ -14,9 +14,12 @@
 
 #include "pw_bluetooth_proxy/internal/l2cap_channel_manager.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <optional>
 
+#include "pw_assert/check.h"
 #include "pw_bluetooth_proxy/internal/acl_data_channel.h"
 #include "pw_bluetooth_proxy/internal/logical_transport.h"
 #include "pw_containers/algorithm.h"
@@ -28,6 +31,15 @@ namespace pw::bluetooth::proxy {
 
 L2capChannelManager::L2capChannelManager(AclDataChannel& acl_data_channel)
     : acl_data_channel_(acl_data_channel),
+      h4_storage_(inline_h4_buffs_),
+      lrd_channel_(channels_.end()),
+      round_robin_terminus_(channels_.end()) {}
+
+L2capChannelManager::L2capChannelManager(AclDataChannel& acl_data_channel,
+                                         Allocator& h4_allocator,
+                                         size_t num_h4_buffs)
+    : acl_data_channel_(acl_data_channel),
+      h4_storage_(h4_allocator, num_h4_buffs),
       lrd_channel_(channels_.end()),
       round_robin_terminus_(channels_.end()) {}
 
@@ -40,6 +52,8 @@ void L2capChannelManager::RegisterChannel(L2capChannel& channel) {
     ++before_it;
   }
   channels_.insert_after(before_it, channel);
+  channels_by_local_cid_.Add(channel);
+  channels_by_remote_cid_.Add(channel);
   if (lrd_channel_ == channels_.end()) {
     lrd_channel_ = channels_.begin();
   }
@@ -55,7 +69,10 @@ void L2capChannelManager::DeregisterChannelLocked(L2capChannel& channel) {
 
   // Channel will only be removed once, but DeregisterChannel() may be called
   // multiple times on the same channel so it's ok for this to return false.
-  channels_.remove(channel);
+  if (channels_.remove(channel)) {
+    channels_by_local_cid_.Remove(channel, channels_);
+    channels_by_remote_cid_.Remove(channel, channels_);
+  }
 
   // If `channel` was the only element in `channels_`, advancing channels just
   // wrapped them back on itself, so we reset it here.
@@ -77,6 +94,8 @@ void L2capChannelManager::DeregisterAndCloseChannels(L2capChannelEvent event) {
     channels_.pop_front();
     front.InternalClose(event);
   }
+  channels_by_local_cid_.Clear();
+  channels_by_remote_cid_.Clear();
   lrd_channel_ = channels_.end();
   round_robin_terminus_ = channels_.end();
 }
@@ -108,6 +127,10 @@ uint16_t L2capChannelManager::GetH4BuffSize() const {
   return H4Storage::GetH4BuffSize();
 }
 
+size_t L2capChannelManager::GetNumH4Buffs() const {
+  return h4_storage_.GetNumH4Buffs();
+}
+
 void L2capChannelManager::ForceDrainChannelQueues() {
   ReportNewTxPacketsOrCredits();
   DrainChannelQueuesIfNewTx();
@@ -228,31 +251,100 @@ std::optional<LockedL2capChannel> L2capChannelManager::FindChannelByRemoteCid(
 
 L2capChannel* L2capChannelManager::FindChannelByLocalCidLocked(
     uint16_t connection_handle, uint16_t local_cid) PW_NO_LOCK_SAFETY_ANALYSIS {
-  auto channel_it = containers::FindIf(
-      channels_, [connection_handle, local_cid](const L2capChannel& channel) {
-        return channel.connection_handle() == connection_handle &&
-               channel.local_cid() == local_cid;
-      });
-  if (channel_it == channels_.end()) {
-    return nullptr;
-  }
-  return &(*channel_it);
+  return channels_by_local_cid_.Find(connection_handle, local_cid, channels_);
 }
 
 L2capChannel* L2capChannelManager::FindChannelByRemoteCidLocked(
     uint16_t connection_handle,
     uint16_t remote_cid) PW_NO_LOCK_SAFETY_ANALYSIS {
-  auto channel_it = containers::FindIf(
-      channels_, [connection_handle, remote_cid](const L2capChannel& channel) {
-        return channel.connection_handle() == connection_handle &&
-               channel.remote_cid() == remote_cid;
+  return channels_by_remote_cid_.Find(connection_handle, remote_cid, channels_);
+}
+
+void L2capChannelManager::ChannelIndex::Add(L2capChannel& channel) {
+  ++num_channels_;
+  if (num_channels_ > kCapacity) {
+    // Too many channels to index. Lookups walk the channel list until enough
+    // channels are removed.
+    entries_.clear();
+    return;
+  }
+  auto [it, inserted] =
+      entries_.try_emplace(KeyOf(channel), Entry{&channel, 1});
+  if (!inserted) {
+    it->second.channel = nullptr;
+    ++it->second.count;
+  }
+}
+
+void L2capChannelManager::ChannelIndex::Remove(
+    L2capChannel& channel, IntrusiveForwardList<L2capChannel>& channels) {
+  --num_channels_;
+  if (num_channels_ == kCapacity) {
+    Rebuild(channels);
+    return;
+  }
+  if (num_channels_ > kCapacity) {
+    return;
+  }
+  const uint32_t key = KeyOf(channel);
+  auto it = entries_.find(key);
+  PW_CHECK(it != entries_.end());
+  if (--it->second.count == 0) {
+    entries_.erase(it);
+  } else if (it->second.count == 1) {
+    it->second.channel = Scan(key, channels);
+  }
+}
+
+void L2capChannelManager::ChannelIndex::Clear() {
+  num_channels_ = 0;
+  entries_.clear();
+}
+
+L2capChannel* L2capChannelManager::ChannelIndex::Find(
+    uint16_t connection_handle,
+    uint16_t cid,
+    IntrusiveForwardList<L2capChannel>& channels) const {
+  const uint32_t key = MakeKey(connection_handle, cid);
+  if (num_channels_ > kCapacity) {
+    return Scan(key, channels);
+  }
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  if (it->second.channel != nullptr) {
+    return it->second.channel;
+  }
+  return Scan(key, channels);
+}
+
+uint32_t L2capChannelManager::ChannelIndex::KeyOf(
+    const L2capChannel& channel) const {
+  return MakeKey(channel.connection_handle(), (channel.*cid_)());
+}
+
+L2capChannel* L2capChannelManager::ChannelIndex::Scan(
+    uint32_t key, IntrusiveForwardList<L2capChannel>& channels) const {
+  auto channel_it =
+      containers::FindIf(channels, [this, key](const L2capChannel& channel) {
+        return KeyOf(channel) == key;
       });
-  if (channel_it == channels_.end()) {
+  if (channel_it == channels.end()) {
     return nullptr;
   }
   return &(*channel_it);
 }
 
+void L2capChannelManager::ChannelIndex::Rebuild(
+    IntrusiveForwardList<L2capChannel>& channels) {
+  entries_.clear();
+  num_channels_ = 0;
+  for (L2capChannel& channel : channels) {
+    Add(channel);
+  }
+}
+
 void L2capChannelManager::Advance(
     IntrusiveForwardList<L2capChannel>::iterator& it) {
   if (++it == channels_.end()) {
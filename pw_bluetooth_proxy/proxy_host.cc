@@ -50,6 +50,29 @@ ProxyHost::ProxyHost(
       br_edr_acl_credits_to_reserve);
 }
 
+ProxyHost::ProxyHost(
+    pw::Function<void(H4PacketWithHci&& packet)>&& send_to_host_fn,
+    pw::Function<void(H4PacketWithH4&& packet)>&& send_to_controller_fn,
+    uint16_t le_acl_credits_to_reserve,
+    uint16_t br_edr_acl_credits_to_reserve,
+    Allocator& h4_allocator,
+    size_t num_acl_send_buffers)
+    : hci_transport_(std::move(send_to_host_fn),
+                     std::move(send_to_controller_fn)),
+      acl_data_channel_(hci_transport_,
+                        l2cap_channel_manager_,
+                        le_acl_credits_to_reserve,
+                        br_edr_acl_credits_to_reserve),
+      l2cap_channel_manager_(
+          acl_data_channel_, h4_allocator, num_acl_send_buffers) {
+  PW_LOG_INFO(
+      "btproxy: ProxyHost ctor - le_acl_credits_to_reserve: %u, "
+      "br_edr_acl_credits_to_reserve: %u, num_acl_send_buffers: %zu",
+      le_acl_credits_to_reserve,
+      br_edr_acl_credits_to_reserve,
+      num_acl_send_buffers);
+}
+
 ProxyHost::~ProxyHost() {
   PW_LOG_INFO("btproxy: ProxyHost dtor");
   acl_data_channel_.Reset();
@@ -453,6 +476,10 @@ uint16_t ProxyHost::GetNumFreeBrEdrAclPackets() const {
   return acl_data_channel_.GetNumFreeAclPackets(AclTransportType::kBrEdr);
 }
 
+size_t ProxyHost::GetNumAclSendBuffers() const {
+  return l2cap_channel_manager_.GetNumH4Buffs();
+}
+
 void ProxyHost::RegisterL2capStatusDelegate(L2capStatusDelegate& delegate) {
   l2cap_channel_manager_.RegisterStatusDelegate(delegate);
 }
@@ -0,0 +1,119 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_assert/check.h"
+#include "pw_bluetooth/emboss_util.h"
+#include "pw_bluetooth/hci_data.emb.h"
+#include "pw_bluetooth/hci_h4.emb.h"
+#include "pw_bluetooth/l2cap_frames.emb.h"
+#include "pw_bluetooth_proxy/basic_l2cap_channel.h"
+#include "pw_bluetooth_proxy/h4_packet.h"
+#include "pw_bluetooth_proxy/proxy_host.h"
+#include "pw_multibuf/simple_allocator_for_test.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::bluetooth::proxy {
+namespace {
+
+// Measures how fast the proxy hands ACL packets from the controller to 32
+// active channels spread over a few connections. Finding the channel of each
+// packet is on this path, so it shows the cost of the channel lookup.
+
+constexpr size_t kNumChannels = 32;
+constexpr size_t kNumConnections = 4;
+constexpr uint16_t kFirstHandle = 0x100;
+constexpr uint16_t kFirstLocalCid = 0x40;
+constexpr size_t kPayloadSize = 20;
+
+constexpr size_t kFrameSize =
+    emboss::AclDataFrameHeader::IntrinsicSizeInBytes() +
+    emboss::BasicL2capHeader::IntrinsicSizeInBytes() + kPayloadSize;
+
+uint16_t Handle(size_t channel) {
+  return static_cast<uint16_t>(kFirstHandle + channel % kNumConnections);
+}
+
+uint16_t LocalCid(size_t channel) {
+  return static_cast<uint16_t>(kFirstLocalCid + channel / kNumConnections);
+}
+
+// Writes a B-frame addressed to `channel` into `frame`.
+void BuildFrame(size_t channel, std::array<uint8_t, kFrameSize>& frame) {
+  frame.fill(0);
+  Result<emboss::AclDataFrameWriter> acl =
+      MakeEmbossWriter<emboss::AclDataFrameWriter>(frame);
+  PW_CHECK_OK(acl.status());
+  acl->header().handle().Write(Handle(channel));
+  acl->data_total_length().Write(
+      emboss::BasicL2capHeader::IntrinsicSizeInBytes() + kPayloadSize);
+  emboss::BFrameWriter bframe = emboss::MakeBFrameView(
+      acl->payload().BackingStorage().data(), acl->payload().SizeInBytes());
+  bframe.pdu_length().Write(kPayloadSize);
+  bframe.channel_id().Write(LocalCid(channel));
+}
+
+void RxToManyChannels(perf_test::State& state) {
+  multibuf::test::SimpleAllocatorForTest</*kDataSizeBytes=*/1024,
+                                         /*kMetaSizeBytes=*/2 * 1024>
+      rx_multibuf_allocator;
+  size_t to_host_called = 0;
+  size_t reads_called = 0;
+
+  ProxyHost proxy(
+      [&to_host_called](H4PacketWithHci&&) { ++to_host_called; },
+      [](H4PacketWithH4&&) {},
+      /*le_acl_credits_to_reserve=*/0,
+      /*br_edr_acl_credits_to_reserve=*/0);
+
+  std::array<std::optional<BasicL2capChannel>, kNumChannels> channels;
+  std::array<std::array<uint8_t, kFrameSize>, kNumChannels> frames;
+  for (size_t i = 0; i < kNumChannels; ++i) {
+    Result<BasicL2capChannel> channel = proxy.AcquireBasicL2capChannel(
+        rx_multibuf_allocator,
+        Handle(i),
+        LocalCid(i),
+        /*remote_cid=*/LocalCid(i),
+        AclTransportType::kLe,
+        /*payload_from_controller_fn=*/
+        [&reads_called](multibuf::MultiBuf&&) {
+          ++reads_called;
+          return std::nullopt;
+        },
+        /*payload_from_host_fn=*/nullptr,
+        /*event_fn=*/nullptr);
+    PW_CHECK_OK(channel.status());
+    channels[i].emplace(std::move(*channel));
+    BuildFrame(i, frames[i]);
+  }
+
+  size_t next = 0;
+  while (state.KeepRunning()) {
+    proxy.HandleH4HciFromController(
+        H4PacketWithHci{emboss::H4PacketType::ACL_DATA, frames[next]});
+    next = (next + 1) % kNumChannels;
+  }
+
+  PW_CHECK_UINT_EQ(to_host_called, 0u);
+  PW_CHECK_UINT_GT(reads_called, 0u);
+}
+
+PW_PERF_TEST(RxToManyChannels, RxToManyChannels);
+
+}  // namespace
+}  // namespace pw::bluetooth::proxy
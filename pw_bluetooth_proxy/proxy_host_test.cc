@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "pw_allocator/testing.h"
 #include "pw_bluetooth/emboss_util.h"
 #include "pw_bluetooth/hci_commands.emb.h"
 #include "pw_bluetooth/hci_common.emb.h"
@@ -1878,6 +1879,62 @@ TEST_F(MultiSendTest, CanOccupyAllThenReuseEachBuffer) {
   capture.in_flight_packets.clear();
 }
 
+TEST_F(MultiSendTest, AllocatedBuffersSetNumberOfSimultaneousSends) {
+  // More buffers than the default, to show the pool is not the inline one.
+  constexpr size_t kAclBuffersSize =
+      ProxyHost::GetNumSimultaneousAclSendsSupported() + 6;
+  constexpr size_t kMaxSendCount = kAclBuffersSize + 1;
+  struct {
+    size_t sends_called = 0;
+    pw::Vector<H4PacketWithH4, kMaxSendCount> in_flight_packets{};
+  } capture;
+
+  pw::Function<void(H4PacketWithHci && packet)>&& send_to_host_fn(
+      []([[maybe_unused]] H4PacketWithHci&& packet) {});
+  pw::Function<void(H4PacketWithH4 && packet)> send_to_controller_fn(
+      [&capture](H4PacketWithH4&& packet) {
+        capture.sends_called++;
+        capture.in_flight_packets.push_back(std::move(packet));
+      });
+
+  allocator::test::AllocatorForTest<kAclBuffersSize * 1026 + 1024> allocator;
+  ProxyHost proxy = ProxyHost(std::move(send_to_host_fn),
+                              std::move(send_to_controller_fn),
+                              /*le_acl_credits_to_reserve=*/kMaxSendCount,
+                              /*br_edr_acl_credits_to_reserve=*/0,
+                              allocator,
+                              kAclBuffersSize);
+  EXPECT_EQ(proxy.GetNumAclSendBuffers(), kAclBuffersSize);
+  PW_TEST_EXPECT_OK(
+      SendLeReadBufferResponseFromController(proxy, kMaxSendCount));
+
+  GattNotifyChannel channel = BuildGattNotifyChannel(proxy, {});
+  std::array<uint8_t, 1> attribute_value = {0xF};
+
+  // Occupy all H4 buffers.
+  for (size_t sent = 1; sent <= kAclBuffersSize; ++sent) {
+    PW_TEST_EXPECT_OK(channel.Write(MultiBufFromArray(attribute_value)).status);
+    EXPECT_EQ(capture.sends_called, sent);
+  }
+
+  // The next payload queues until an H4 buffer is released.
+  PW_TEST_EXPECT_OK(channel.Write(MultiBufFromArray(attribute_value)).status);
+  EXPECT_EQ(capture.sends_called, kAclBuffersSize);
+
+  {
+    // Release an H4 buffer outside of the container, as in
+    // CanOccupyAllThenReuseEachBuffer.
+    H4PacketWithH4 last_packet = std::move(capture.in_flight_packets.back());
+  }
+  capture.in_flight_packets.erase(
+      std::prev(capture.in_flight_packets.end(), 2));
+  EXPECT_EQ(capture.sends_called, kAclBuffersSize + 1);
+
+  // If captured packets are not reset here, they may destruct after the proxy
+  // and lead to a crash when trying to lock the proxy's destructed mutex.
+  capture.in_flight_packets.clear();
+}
+
 TEST_F(MultiSendTest, CanRepeatedlyReuseOneBuffer) {
   constexpr size_t kAclBuffersSize =
       ProxyHost::GetNumSimultaneousAclSendsSupported();
@@ -2230,6 +2287,76 @@ TEST_F(BasicL2capChannelTest, BasicRead) {
   EXPECT_EQ(capture.to_host_called, 0);
 }
 
+TEST_F(BasicL2capChannelTest, ReadsReachChannelAmongManyChannels) {
+  // More channels than the proxy indexes, so that lookups fall back to walking
+  // the channels until enough of them are closed.
+  constexpr size_t kNumChannels = 70;
+  constexpr size_t kNumConnections = 2;
+  constexpr uint16_t kFirstHandle = 0x100;
+  constexpr uint16_t kFirstLocalCid = 0x40;
+
+  struct {
+    int to_host_called = 0;
+    std::array<int, kNumChannels> reads_called{};
+  } capture;
+
+  pw::Function<void(H4PacketWithHci && packet)>&& send_to_host_fn(
+      [&capture](H4PacketWithHci&&) { ++capture.to_host_called; });
+  pw::Function<void(H4PacketWithH4 && packet)>&& send_to_controller_fn(
+      [](H4PacketWithH4&&) {});
+  ProxyHost proxy = ProxyHost(std::move(send_to_host_fn),
+                              std::move(send_to_controller_fn),
+                              /*le_acl_credits_to_reserve=*/0,
+                              /*br_edr_acl_credits_to_reserve=*/0);
+
+  auto handle = [](size_t i) {
+    return static_cast<uint16_t>(kFirstHandle + i % kNumConnections);
+  };
+  auto local_cid = [](size_t i) {
+    return static_cast<uint16_t>(kFirstLocalCid + i / kNumConnections);
+  };
+
+  std::vector<BasicL2capChannel> channels;
+  channels.reserve(kNumChannels);
+  for (size_t i = 0; i < kNumChannels; ++i) {
+    channels.push_back(BuildBasicL2capChannel(
+        proxy,
+        BasicL2capParameters{
+            .handle = handle(i),
+            .local_cid = local_cid(i),
+            .remote_cid = static_cast<uint16_t>(0x1000 + i),
+            .transport = AclTransportType::kLe,
+            .payload_from_controller_fn =
+                [&reads = capture.reads_called[i]](multibuf::MultiBuf&&) {
+                  ++reads;
+                  return std::nullopt;
+                },
+        }));
+  }
+
+  std::array<uint8_t, 1> payload = {0xAB};
+  for (size_t i = 0; i < kNumChannels; ++i) {
+    SendL2capBFrame(proxy, handle(i), payload, payload.size(), local_cid(i));
+    EXPECT_EQ(capture.reads_called[i], 1);
+  }
+  EXPECT_EQ(capture.to_host_called, 0);
+
+  // Close all but the first 10 channels, then read again.
+  constexpr size_t kNumRemaining = 10;
+  while (channels.size() > kNumRemaining) {
+    channels.pop_back();
+  }
+  for (size_t i = 0; i < kNumChannels; ++i) {
+    SendL2capBFrame(proxy, handle(i), payload, payload.size(), local_cid(i));
+  }
+  for (size_t i = 0; i < kNumChannels; ++i) {
+    EXPECT_EQ(capture.reads_called[i], i < kNumRemaining ? 2 : 1);
+  }
+  // Reads for closed channels are forwarded to the host.
+  EXPECT_EQ(capture.to_host_called,
+            static_cast<int>(kNumChannels - kNumRemaining));
+}
+
 TEST_F(BasicL2capChannelTest, BasicForward) {
   struct {
     int sends_called = 0;
@@ -0,0 +1,47 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstddef>
+
+// Number of H4 buffers for Tx packets held inline by `ProxyHost`. These are
+// used by `ProxyHost`s constructed without an H4 buffer allocator.
+//
+// Set this to 0 when every `ProxyHost` is given an allocator, so that it does
+// not carry unused buffers. A `ProxyHost` constructed without an allocator then
+// cannot send ACL packets.
+#ifndef PW_BLUETOOTH_PROXY_NUM_INLINE_H4_BUFFERS
+#define PW_BLUETOOTH_PROXY_NUM_INLINE_H4_BUFFERS 10
+#endif  // PW_BLUETOOTH_PROXY_NUM_INLINE_H4_BUFFERS
+
+// Number of L2CAP channels that are indexed for lookups of Rx packets by
+// connection handle and CID. Lookups walk the list of channels while more
+// channels are registered.
+//
+// `ProxyHost` holds two indexes of this capacity. Set this to 0 to disable
+// them.
+#ifndef PW_BLUETOOTH_PROXY_CHANNEL_INDEX_CAPACITY
+#define PW_BLUETOOTH_PROXY_CHANNEL_INDEX_CAPACITY 64
+#endif  // PW_BLUETOOTH_PROXY_CHANNEL_INDEX_CAPACITY
+
+namespace pw::bluetooth::proxy::internal::config {
+
+inline constexpr size_t kNumInlineH4Buffers =
+    PW_BLUETOOTH_PROXY_NUM_INLINE_H4_BUFFERS;
+
+inline constexpr size_t kChannelIndexCapacity =
+    PW_BLUETOOTH_PROXY_CHANNEL_INDEX_CAPACITY;
+
+}  // namespace pw::bluetooth::proxy::internal::config
@@ -14,19 +14,55 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 
-#include "pw_containers/flat_map.h"
+#include "pw_allocator/allocator.h"
 #include "pw_span/span.h"
 #include "pw_sync/lock_annotations.h"
 #include "pw_sync/mutex.h"
 
 namespace pw::bluetooth::proxy {
 
-// Contains a configurable array of buffers to hold H4 packets.
+// Manages a pool of buffers to hold H4 packets. The pool is either provided by
+// the owner or allocated from an `Allocator`, and free buffers are tracked in a
+// bitmap.
 class H4Storage {
  public:
-  H4Storage();
+  // Support big enough HCI packets to handle 3-DH5 baseband packets. Note this
+  // doesn't guarantee packets will fit since the controller can combine
+  // multiple baseband packets, but in practice that hasn't been observed.
+  // Max 3-DH5 payload (1021 bytes) + ACL header (4 bytes) + H4 type (1 byte)
+  // TODO: https://pwbug.dev/369849508 - Support variable size buffers with
+  // an allocator & replace this constant with total memory pool size.
+  static constexpr uint16_t kH4BuffSize = 1026;
+
+  // Maximum number of buffers in a pool.
+  static constexpr size_t kMaxNumH4Buffs = 256;
+
+  // Storage for a pool of `kNumBuffs` buffers owned outside of `H4Storage`.
+  template <size_t kNumBuffs>
+  using InlineBuffs =
+      std::array<std::array<uint8_t, kH4BuffSize>, kNumBuffs>;
+
+  // Uses `buffs` as the pool, which must outlive this object. `buffs` may be
+  // empty, in which case no buffer can be reserved. Crashes if `buffs` holds
+  // more than `kMaxNumH4Buffs` buffers.
+  explicit H4Storage(span<std::array<uint8_t, kH4BuffSize>> buffs);
+
+  // Allocates a pool of `num_buffs` buffers from `allocator`, which must
+  // outlive this object. Crashes if `num_buffs` is zero or more than
+  // `kMaxNumH4Buffs`, or if the pool cannot be allocated.
+  H4Storage(Allocator& allocator, size_t num_buffs);
+
+  H4Storage(const H4Storage&) = delete;
+  H4Storage& operator=(const H4Storage&) = delete;
+  H4Storage(H4Storage&&) = delete;
+  H4Storage& operator=(H4Storage&&) = delete;
+
+  ~H4Storage();
 
   // Returns a free H4 buffer and marks it as occupied. If all H4 buffers are
   // occupied, returns std::nullopt.
@@ -37,41 +73,35 @@ class H4Storage {
   // Marks an H4 buffer as unoccupied.
   void ReleaseH4Buff(const uint8_t* buffer);
 
-  // Returns the number of slots in `h4_buffs_`.
-  static constexpr size_t GetNumH4Buffs() { return kNumH4Buffs; }
+  // Returns the number of buffers in the pool.
+  size_t GetNumH4Buffs() const { return num_buffs_; }
 
-  // Returns the size of a slot in `h4_buffs_`.
+  // Returns the size of a buffer in the pool.
   static constexpr uint16_t GetH4BuffSize() { return kH4BuffSize; }
 
  private:
-  // TODO: https://pwbug.dev/353734827 - Allow container to specify constants.
-  // To pass the unit tests, kNumH4Buffs >= L2capCoc::QueueCapacity().
-  static constexpr size_t kNumH4Buffs = 10;
+  static constexpr size_t kBitsPerWord = 32;
 
-  // Support big enough HCI packets to handle 3-DH5 baseband packets. Note this
-  // doesn't guarantee packets will fit since the controller can combine
-  // multiple baseband packets, but in practice that hasn't been observed.
-  // Max 3-DH5 payload (1021 bytes) + ACL header (4 bytes) + H4 type (1 byte)
-  // TODO: https://pwbug.dev/369849508 - Support variable size buffers with
-  // an allocator & replace this constant with total memory pool size.
-  static constexpr uint16_t kH4BuffSize = 1026;
-
-  // Returns an initializer list for `h4_buff_occupied_` with each buffer
-  // address in `h4_buffs_` mapped to false.
-  std::array<containers::Pair<uint8_t*, bool>, kNumH4Buffs> InitOccupiedMap();
+  // Marks the first `num_buffs_` buffers as free.
+  void InitFreeBitmap();
 
   sync::Mutex storage_mutex_;
 
-  // Each buffer is meant to hold one H4 packet containing an ACL PDU.
-  std::array<std::array<uint8_t, kH4BuffSize>, kNumH4Buffs> h4_buffs_
-      PW_GUARDED_BY(storage_mutex_){};
+  // Allocator of `buffs_`, or nullptr if `buffs_` is owned by the caller.
+  Allocator* allocator_ = nullptr;
 
-  // Maps each H4 buffer to a flag that is set when the buffer holds an H4
-  // packet being sent through `acl_data_channel_` and cleared in that H4
-  // packet's release function to indicate that the H4 buffer is safe to
+  const size_t num_buffs_;
+
+  // `num_buffs_` contiguous buffers, each meant to hold one H4 packet
+  // containing an ACL PDU.
+  uint8_t* buffs_ = nullptr;
+
+  // Bit `i` is set when buffer `i` is free. It is cleared while the buffer
+  // holds an H4 packet being sent through `acl_data_channel_` and set again in
+  // that H4 packet's release function to indicate that the buffer is safe to
   // overwrite.
-  containers::FlatMap<uint8_t*, bool, kNumH4Buffs> h4_buff_occupied_
-      PW_GUARDED_BY(storage_mutex_);
+  std::array<uint32_t, kMaxNumH4Buffs / kBitsPerWord> free_bitmap_
+      PW_GUARDED_BY(storage_mutex_){};
 };
 
 }  // namespace pw::bluetooth::proxy
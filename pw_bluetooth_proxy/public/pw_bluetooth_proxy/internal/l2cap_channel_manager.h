@@ -14,15 +14,21 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 
+#include "pw_allocator/allocator.h"
 #include "pw_bluetooth_proxy/internal/acl_data_channel.h"
+#include "pw_bluetooth_proxy/internal/config.h"
 #include "pw_bluetooth_proxy/internal/h4_storage.h"
 #include "pw_bluetooth_proxy/internal/l2cap_channel.h"
 #include "pw_bluetooth_proxy/internal/l2cap_status_tracker.h"
 #include "pw_bluetooth_proxy/internal/locked_l2cap_channel.h"
 #include "pw_bluetooth_proxy/l2cap_channel_common.h"
+#include "pw_containers/inline_hash_map.h"
 
 namespace pw::bluetooth::proxy {
 
@@ -37,8 +43,18 @@ namespace pw::bluetooth::proxy {
 // around channels.
 class L2capChannelManager {
  public:
+  // Number of H4 buffers held inline, used when no H4 allocator is given.
+  static constexpr size_t kNumInlineH4Buffs =
+      internal::config::kNumInlineH4Buffers;
+
   L2capChannelManager(AclDataChannel& acl_data_channel);
 
+  // Same as above, but allocates `num_h4_buffs` H4 buffers for Tx packets from
+  // `h4_allocator` instead of using the inline H4 buffers.
+  L2capChannelManager(AclDataChannel& acl_data_channel,
+                      Allocator& h4_allocator,
+                      size_t num_h4_buffs);
+
   // Start proxying L2CAP packets addressed to `channel` arriving from
   // the controller and allow `channel` to send & queue Tx L2CAP packets.
   void RegisterChannel(L2capChannel& channel)
@@ -77,6 +93,9 @@ class L2capChannelManager {
   // Returns the size of an H4 buffer reserved for Tx packets.
   uint16_t GetH4BuffSize() const;
 
+  // Returns the number of H4 buffers reserved for Tx packets.
+  size_t GetNumH4Buffs() const;
+
   std::optional<LockedL2capChannel> FindChannelByLocalCid(
       uint16_t connection_handle, uint16_t local_cid);
 
@@ -139,6 +158,71 @@ class L2capChannelManager {
   }
 
  private:
+  // Index of the registered channels by connection handle and either local or
+  // remote CID, so that finding the channel of each ACL packet does not walk
+  // `channels_`.
+  //
+  // Several channels may share a key, e.g. all GATT notify channels of a
+  // connection use the ATT CID. Lookups of such keys walk `channels_` so that
+  // they find the same channel as they would without the index. The index is
+  // also bypassed while more than `kCapacity` channels are registered.
+  class ChannelIndex {
+   public:
+    static constexpr size_t kCapacity =
+        internal::config::kChannelIndexCapacity;
+
+    using CidGetter = uint16_t (L2capChannel::*)() const;
+
+    // `cid` returns the CID the channels are indexed by.
+    explicit ChannelIndex(CidGetter cid) : cid_(cid) {}
+
+    // Adds `channel`.
+    void Add(L2capChannel& channel);
+
+    // Removes `channel`, which was just removed from `channels`.
+    void Remove(L2capChannel& channel,
+                IntrusiveForwardList<L2capChannel>& channels);
+
+    // Removes all channels.
+    void Clear();
+
+    // Returns the channel in `channels` with `connection_handle` and `cid`, or
+    // nullptr if there is none.
+    L2capChannel* Find(uint16_t connection_handle,
+                       uint16_t cid,
+                       IntrusiveForwardList<L2capChannel>& channels) const;
+
+   private:
+    struct Entry {
+      // nullptr if more than one channel has the key.
+      L2capChannel* channel;
+      // Number of channels with the key.
+      size_t count;
+    };
+
+    static uint32_t MakeKey(uint16_t connection_handle, uint16_t cid) {
+      return (uint32_t{connection_handle} << 16) | cid;
+    }
+
+    uint32_t KeyOf(const L2capChannel& channel) const;
+
+    // Walks `channels` for the first channel with `key`.
+    L2capChannel* Scan(uint32_t key,
+                       IntrusiveForwardList<L2capChannel>& channels) const;
+
+    // Reindexes all of `channels`.
+    void Rebuild(IntrusiveForwardList<L2capChannel>& channels);
+
+    CidGetter cid_;
+
+    // Number of channels added and not removed.
+    size_t num_channels_ = 0;
+
+    // Unused if `kCapacity` is 0, in which case lookups always walk
+    // `channels_`.
+    InlineHashMap<uint32_t, Entry, std::max<size_t>(kCapacity, 1)> entries_;
+  };
+
   // Circularly advance `it`, wrapping around to front if `it` reaches the end.
   void Advance(IntrusiveForwardList<L2capChannel>::iterator& it)
       PW_EXCLUSIVE_LOCKS_REQUIRED(channels_mutex_);
@@ -151,6 +235,9 @@ class L2capChannelManager {
   // Reference to the ACL data channel owned by the proxy.
   AclDataChannel& acl_data_channel_;
 
+  // H4 packet buffers used when no H4 allocator is given.
+  H4Storage::InlineBuffs<kNumInlineH4Buffs> inline_h4_buffs_{};
+
   // Owns H4 packet buffers.
   H4Storage h4_storage_;
 
@@ -162,6 +249,12 @@ class L2capChannelManager {
   // List of registered L2CAP channels.
   IntrusiveForwardList<L2capChannel> channels_ PW_GUARDED_BY(channels_mutex_);
 
+  // Indexes of `channels_` by local and remote CID.
+  ChannelIndex channels_by_local_cid_ PW_GUARDED_BY(channels_mutex_){
+      &L2capChannel::local_cid};
+  ChannelIndex channels_by_remote_cid_ PW_GUARDED_BY(channels_mutex_){
+      &L2capChannel::remote_cid};
+
   // Iterator to "least recently drained" channel.
   IntrusiveForwardList<L2capChannel>::iterator lrd_channel_
       PW_GUARDED_BY(channels_mutex_);
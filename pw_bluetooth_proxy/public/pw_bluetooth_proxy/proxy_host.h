@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "pw_allocator/allocator.h"
 #include "pw_bluetooth_proxy/gatt_notify_channel.h"
 #include "pw_bluetooth_proxy/internal/acl_data_channel.h"
 #include "pw_bluetooth_proxy/internal/h4_storage.h"
@@ -46,6 +47,32 @@ class ProxyHost {
             uint16_t le_acl_credits_to_reserve,
             uint16_t br_edr_acl_credits_to_reserve);
 
+  /// Creates an `ProxyHost` that will process HCI packets, and that allocates
+  /// the buffers it uses to send ACL packets from `h4_allocator` rather than
+  /// using its `GetNumSimultaneousAclSendsSupported()` inline buffers. Builds
+  /// that only use this constructor should set
+  /// `PW_BLUETOOTH_PROXY_NUM_INLINE_H4_BUFFERS` to 0 so the proxy does not
+  /// carry the unused inline buffers.
+  /// @param[in] send_to_host_fn Callback that will be called when proxy wants
+  /// to send HCI packet towards the host.
+  /// @param[in] send_to_controller_fn - Callback that will be called when
+  /// proxy wants to send HCI packet towards the controller.
+  /// @param[in] le_acl_credits_to_reserve - How many buffers to reserve for the
+  /// proxy out of any LE ACL buffers received from controller.
+  /// @param[in] br_edr_acl_credits_to_reserve - How many buffers to reserve for
+  /// the proxy out of any BR/EDR ACL buffers received from controller.
+  /// @param[in] h4_allocator - Allocator for the ACL send buffers. Must outlive
+  /// the proxy.
+  /// @param[in] num_acl_send_buffers - How many ACL sends can be in-flight at
+  /// one time. Each buffer takes `GetMaxAclSendSize()` + 1 bytes. Must be
+  /// between 1 and 256.
+  ProxyHost(pw::Function<void(H4PacketWithHci&& packet)>&& send_to_host_fn,
+            pw::Function<void(H4PacketWithH4&& packet)>&& send_to_controller_fn,
+            uint16_t le_acl_credits_to_reserve,
+            uint16_t br_edr_acl_credits_to_reserve,
+            Allocator& h4_allocator,
+            size_t num_acl_send_buffers);
+
   ProxyHost() = delete;
   ProxyHost(const ProxyHost&) = delete;
   ProxyHost& operator=(const ProxyHost&) = delete;
@@ -303,12 +330,17 @@ class ProxyHost {
   /// Can be zero if the controller has not yet been initialized by the host.
   uint16_t GetNumFreeBrEdrAclPackets() const;
 
-  /// Returns the max number of LE ACL sends that can be in-flight at one time.
-  /// That is, ACL packets that have been sent and not yet released.
+  /// Returns the max number of LE ACL sends that can be in-flight at one time
+  /// for a proxy created without an `h4_allocator`. That is, ACL packets that
+  /// have been sent and not yet released.
   static constexpr size_t GetNumSimultaneousAclSendsSupported() {
-    return H4Storage::GetNumH4Buffs();
+    return L2capChannelManager::kNumInlineH4Buffs;
   }
 
+  /// Returns the max number of ACL sends that can be in-flight at one time for
+  /// this proxy. That is, ACL packets that have been sent and not yet released.
+  size_t GetNumAclSendBuffers() const;
+
   /// Returns the max LE ACL packet size supported to be sent.
   static constexpr size_t GetMaxAclSendSize() {
     return H4Storage::GetH4BuffSize() - sizeof(emboss::H4PacketType);
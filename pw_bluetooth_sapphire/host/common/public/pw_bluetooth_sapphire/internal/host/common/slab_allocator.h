@@ -14,6 +14,7 @@
 
 #pragma once
 #include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
+#include "pw_bluetooth_sapphire/internal/host/common/slab_pool.h"
 
 namespace bt {
 
@@ -24,6 +25,11 @@ inline constexpr size_t kLargeBufferSize = 2048;
 inline constexpr size_t kMaxNumSlabs = 100;
 inline constexpr size_t kSlabSize = 32767;
 
+// Number of buffers of each size in the pools backing NewBuffer(). Each pool
+// holds one slab's worth of buffers, allocated when it is first used.
+inline constexpr size_t kNumSmallBuffers = kSlabSize / kSmallBufferSize;
+inline constexpr size_t kNumLargeBuffers = kSlabSize / kLargeBufferSize;
+
 // Returns a slab-allocated byte buffer with |size| bytes of capacity. The
 // underlying allocation occupies |kSmallBufferSize| or |kLargeBufferSize| bytes
 // of memory, unless:
@@ -32,8 +38,16 @@ inline constexpr size_t kSlabSize = 32767;
 //  * |size| exceeds |kLargeBufferSize|, which falls back to the system
 //  allocator.
 //    NOTE: In this case, if allocation fails, panic.
+//  * the pool for |size| is exhausted, which also falls back to the system
+//  allocator.
+//
+// The contents of the returned buffer are zeroed.
 //
 // Returns nullptr for failures to allocate.
 [[nodiscard]] MutableByteBufferPtr NewBuffer(size_t size);
 
+// Returns the usage of the pools backing NewBuffer().
+SlabPoolMetrics SmallBufferPoolMetrics();
+SlabPoolMetrics LargeBufferPoolMetrics();
+
 }  // namespace bt
@@ -0,0 +1,163 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+#include <pw_allocator/chunk_pool.h>
+#include <pw_allocator/layout.h>
+#include <pw_bytes/span.h>
+#include <pw_sync/lock_annotations.h>
+#include <pw_sync/mutex.h>
+#include <pw_toolchain/no_destructor.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <optional>
+
+namespace bt {
+
+// Counters describing how a SlabPool has been used.
+struct SlabPoolMetrics {
+  // Number of objects currently allocated from the pool.
+  size_t in_use = 0;
+  // Largest value of |in_use| seen so far.
+  size_t peak_in_use = 0;
+  // Total number of allocations served from the pool.
+  uint64_t pool_allocations = 0;
+  // Total number of allocations that found the pool exhausted and fell back to
+  // the system allocator.
+  uint64_t fallback_allocations = 0;
+  // Bytes of storage reserved for the pool. Zero until the first allocation.
+  size_t storage_bytes = 0;
+};
+
+// A fixed-capacity pool of |NumObjects| slots of |ObjectSize| bytes, backed by
+// a pw::allocator::ChunkPool. The storage for all slots is obtained from the
+// system allocator in one block on the first allocation, so pools that are
+// never used take no memory. When the pool is exhausted, allocations fall back
+// to the system allocator. Thread-safe.
+template <size_t ObjectSize, size_t ObjectAlignment, size_t NumObjects>
+class SlabPool final {
+ public:
+  static constexpr size_t kSlotAlignment =
+      std::max(ObjectAlignment, pw::allocator::ChunkPool::kMinAlignment);
+  static constexpr size_t kSlotSize =
+      (std::max(ObjectSize, pw::allocator::ChunkPool::kMinSize) +
+       kSlotAlignment - 1) /
+      kSlotAlignment * kSlotAlignment;
+  static constexpr size_t kStorageSize = kSlotSize * NumObjects;
+
+  SlabPool() = default;
+
+  ~SlabPool() {
+    pool_.reset();
+    if (storage_ != nullptr) {
+      ::operator delete(storage_, std::align_val_t(kSlotAlignment));
+    }
+  }
+
+  SlabPool(const SlabPool&) = delete;
+  SlabPool& operator=(const SlabPool&) = delete;
+
+  // Returns memory for one object. Never returns nullptr; panics if the
+  // fallback to the system allocator fails.
+  void* Allocate() {
+    {
+      std::lock_guard lock(mutex_);
+      if (!pool_.has_value()) {
+        storage_ = static_cast<std::byte*>(
+            ::operator new(kStorageSize, std::align_val_t(kSlotAlignment)));
+        pool_.emplace(pw::ByteSpan(storage_, kStorageSize),
+                      pw::allocator::Layout(kSlotSize, kSlotAlignment));
+        metrics_.storage_bytes = kStorageSize;
+      }
+      void* ptr = pool_->Allocate();
+      if (ptr != nullptr) {
+        metrics_.pool_allocations++;
+        metrics_.in_use++;
+        metrics_.peak_in_use =
+            std::max(metrics_.peak_in_use, metrics_.in_use);
+        return ptr;
+      }
+      metrics_.fallback_allocations++;
+    }
+    return ::operator new(ObjectSize);
+  }
+
+  // Releases memory returned by Allocate().
+  void Deallocate(void* ptr) {
+    {
+      std::lock_guard lock(mutex_);
+      if (Contains(ptr)) {
+        pool_->Deallocate(ptr);
+        metrics_.in_use--;
+        return;
+      }
+    }
+    ::operator delete(ptr);
+  }
+
+  SlabPoolMetrics metrics() const {
+    std::lock_guard lock(mutex_);
+    return metrics_;
+  }
+
+ private:
+  bool Contains(const void* ptr) const PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (storage_ == nullptr) {
+      return false;
+    }
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    auto start = reinterpret_cast<uintptr_t>(storage_);
+    return address >= start && address < start + kStorageSize;
+  }
+
+  mutable pw::sync::Mutex mutex_;
+  std::byte* storage_ PW_GUARDED_BY(mutex_) = nullptr;
+  std::optional<pw::allocator::ChunkPool> pool_ PW_GUARDED_BY(mutex_);
+  SlabPoolMetrics metrics_ PW_GUARDED_BY(mutex_);
+};
+
+// Mixin that gives |T| class-specific operator new and delete backed by a
+// SlabPool of |NumObjects| objects, so that std::make_unique<T>() and
+// deleting a T through a pointer to one of its polymorphic bases both use the
+// pool. T must derive from SlabAllocated<T, NumObjects>. Allocations of
+// classes derived from T, which have a different size, use the system
+// allocator.
+template <typename T, size_t NumObjects>
+class SlabAllocated {
+ public:
+  static void* operator new(size_t size) {
+    if (size != sizeof(T)) {
+      return ::operator new(size);
+    }
+    return pool().Allocate();
+  }
+
+  static void operator delete(void* ptr) { pool().Deallocate(ptr); }
+
+  // Returns the usage of the pool backing T.
+  static SlabPoolMetrics slab_pool_metrics() { return pool().metrics(); }
+
+ private:
+  // The pool is never destroyed, so that objects released during static
+  // destruction can still be returned to it.
+  static auto& pool() {
+    static pw::NoDestructor<SlabPool<sizeof(T), alignof(T), NumObjects>> pool;
+    return *pool;
+  }
+};
+
+}  // namespace bt
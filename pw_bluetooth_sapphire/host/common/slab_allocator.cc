@@ -20,10 +20,45 @@
 #include "pw_bluetooth_sapphire/internal/host/common/slab_buffer.h"
 
 namespace bt {
+namespace {
+
+// Buffers of each size class are allocated from a pool of |NumBuffers|.
+template <size_t BufferSize, size_t NumBuffers>
+class PooledBuffer final
+    : public SlabBuffer<BufferSize>,
+      public SlabAllocated<PooledBuffer<BufferSize, NumBuffers>, NumBuffers> {
+ public:
+  explicit PooledBuffer(size_t size) : SlabBuffer<BufferSize>(size) {
+    // Pool slots are reused, so match DynamicByteBuffer, which zeroes its
+    // contents.
+    this->SetToZeros();
+  }
+};
+
+using SmallBuffer = PooledBuffer<kSmallBufferSize, kNumSmallBuffers>;
+using LargeBuffer = PooledBuffer<kLargeBufferSize, kNumLargeBuffers>;
+
+}  // namespace
 
 MutableByteBufferPtr NewBuffer(size_t size) {
-  // TODO(fxbug.dev/42058160): Use Pigweed's slab allocator
+  if (size == 0) {
+    return std::make_unique<DynamicByteBuffer>();
+  }
+  if (size <= kSmallBufferSize) {
+    return std::make_unique<SmallBuffer>(size);
+  }
+  if (size <= kLargeBufferSize) {
+    return std::make_unique<LargeBuffer>(size);
+  }
   return std::make_unique<DynamicByteBuffer>(size);
 }
 
+SlabPoolMetrics SmallBufferPoolMetrics() {
+  return SmallBuffer::slab_pool_metrics();
+}
+
+SlabPoolMetrics LargeBufferPoolMetrics() {
+  return LargeBuffer::slab_pool_metrics();
+}
+
 }  // namespace bt
@@ -14,6 +14,10 @@
 
 #include "pw_bluetooth_sapphire/internal/host/common/slab_allocator.h"
 
+#include <vector>
+
+#include "pw_bluetooth_sapphire/internal/host/common/slab_pool.h"
+
 #include "pw_unit_test/framework.h"
 
 namespace bt {
@@ -45,5 +49,83 @@ TEST(SlabAllocatorTest, NewBuffer) {
   EXPECT_EQ(0U, buffer->size());
 }
 
+TEST(SlabAllocatorTest, PooledBufferIsZeroed) {
+  auto buffer = NewBuffer(kSmallBufferSize);
+  ASSERT_TRUE(buffer);
+  buffer->Fill(0xff);
+  buffer = nullptr;
+
+  // The slot just released is reused and must not leak its old contents.
+  buffer = NewBuffer(kSmallBufferSize);
+  ASSERT_TRUE(buffer);
+  for (uint8_t byte : *buffer) {
+    EXPECT_EQ(0u, byte);
+  }
+}
+
+TEST(SlabAllocatorTest, PoolMetricsTrackUsage) {
+  const SlabPoolMetrics before = SmallBufferPoolMetrics();
+
+  auto buffer = NewBuffer(kSmallBufferSize / 2);
+  ASSERT_TRUE(buffer);
+  SlabPoolMetrics metrics = SmallBufferPoolMetrics();
+  EXPECT_EQ(before.in_use + 1, metrics.in_use);
+  EXPECT_EQ(before.pool_allocations + 1, metrics.pool_allocations);
+  EXPECT_LE(metrics.in_use, metrics.peak_in_use);
+
+  buffer = nullptr;
+  metrics = SmallBufferPoolMetrics();
+  EXPECT_EQ(before.in_use, metrics.in_use);
+  EXPECT_EQ(before.fallback_allocations, metrics.fallback_allocations);
+}
+
+TEST(SlabAllocatorTest, FallsBackWhenPoolIsExhausted) {
+  const SlabPoolMetrics before = LargeBufferPoolMetrics();
+  std::vector<MutableByteBufferPtr> buffers;
+  for (size_t i = before.in_use; i < kNumLargeBuffers; ++i) {
+    buffers.push_back(NewBuffer(kLargeBufferSize));
+  }
+  EXPECT_EQ(kNumLargeBuffers, LargeBufferPoolMetrics().in_use);
+
+  auto buffer = NewBuffer(kLargeBufferSize);
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(kLargeBufferSize, buffer->size());
+  EXPECT_EQ(before.fallback_allocations + 1,
+            LargeBufferPoolMetrics().fallback_allocations);
+
+  // Write over the whole fallback allocation (errors to be caught by sanitizer
+  // instrumentation).
+  buffer->Fill('m');
+  buffer = nullptr;
+  buffers.clear();
+  EXPECT_EQ(before.in_use, LargeBufferPoolMetrics().in_use);
+}
+
+TEST(SlabAllocatorTest, PoolStorageIsReservedOnFirstAllocation) {
+  using Pool = SlabPool<32, 8, 4>;
+  Pool pool;
+  EXPECT_EQ(0u, pool.metrics().storage_bytes);
+
+  void* first = pool.Allocate();
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(Pool::kStorageSize, pool.metrics().storage_bytes);
+  EXPECT_EQ(1u, pool.metrics().pool_allocations);
+
+  std::vector<void*> slots;
+  for (size_t i = 1; i < 4; ++i) {
+    slots.push_back(pool.Allocate());
+  }
+  void* fallback = pool.Allocate();
+  EXPECT_EQ(1u, pool.metrics().fallback_allocations);
+  EXPECT_EQ(Pool::kStorageSize, pool.metrics().storage_bytes);
+
+  pool.Deallocate(fallback);
+  for (void* slot : slots) {
+    pool.Deallocate(slot);
+  }
+  pool.Deallocate(first);
+  EXPECT_EQ(0u, pool.metrics().in_use);
+}
+
 }  // namespace
 }  // namespace bt
@@ -14,20 +14,41 @@
 
 #include "pw_bluetooth_sapphire/internal/host/gap/identity_resolving_list.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "pw_bluetooth_sapphire/internal/host/common/log.h"
+#include "pw_bluetooth_sapphire/internal/host/gap/gap.h"
 #include "pw_bluetooth_sapphire/internal/host/sm/util.h"
 
 namespace bt::gap {
 
+IdentityResolvingList::IdentityResolvingList(pw::async::Dispatcher& dispatcher)
+    : dispatcher_(dispatcher) {}
+
 void IdentityResolvingList::Add(DeviceAddress identity, const UInt128& irk) {
   bt_log(DEBUG, "gap", "Adding IRK for identity address %s", bt_str(identity));
-  registry_[identity] = irk;
+  auto iter = std::find(identities_.begin(), identities_.end(), identity);
+  if (iter != identities_.end()) {
+    keys_[static_cast<size_t>(std::distance(identities_.begin(), iter))] =
+        sm::util::ResolvingKey(irk);
+  } else {
+    identities_.push_back(identity);
+    keys_.emplace_back(irk);
+  }
+  InvalidateCache(identity, /*irk_added=*/true);
 }
 
 void IdentityResolvingList::Remove(DeviceAddress identity) {
   bt_log(
       DEBUG, "gap", "Removing IRK for identity address %s", bt_str(identity));
-  registry_.erase(identity);
+  auto iter = std::find(identities_.begin(), identities_.end(), identity);
+  if (iter == identities_.end()) {
+    return;
+  }
+  keys_.erase(keys_.begin() + std::distance(identities_.begin(), iter));
+  identities_.erase(iter);
+  InvalidateCache(identity, /*irk_added=*/false);
 }
 
 std::optional<DeviceAddress> IdentityResolvingList::Resolve(
@@ -36,15 +57,49 @@ std::optional<DeviceAddress> IdentityResolvingList::Resolve(
     return std::nullopt;
   }
 
-  for (const auto& [identity, irk] : registry_) {
-    if (sm::util::IrkCanResolveRpa(irk, rpa)) {
-      bt_log(
-          DEBUG, "gap", "RPA %s resolved to %s", bt_str(rpa), bt_str(identity));
-      return identity;
+  auto cached = cache_.find(rpa);
+  if (cached != cache_.end()) {
+    if (dispatcher_.now() < cached->second.expiry) {
+      stats_.cache_hits++;
+      return cached->second.identity;
     }
+    cache_.erase(cached);
   }
+  stats_.cache_misses++;
+
+  std::optional<DeviceAddress> identity;
+  std::optional<size_t> index = sm::util::ResolveRpa(keys_, rpa);
+  if (index) {
+    identity = identities_[*index];
+    bt_log(
+        DEBUG, "gap", "RPA %s resolved to %s", bt_str(rpa), bt_str(*identity));
+  }
+  CacheResult(rpa, identity);
+  return identity;
+}
 
-  return std::nullopt;
+void IdentityResolvingList::CacheResult(
+    const DeviceAddress& rpa, std::optional<DeviceAddress> identity) const {
+  const pw::chrono::SystemClock::time_point now = dispatcher_.now();
+  if (cache_.size() >= kMaxCachedRpas) {
+    for (auto iter = cache_.begin(); iter != cache_.end();) {
+      iter = now < iter->second.expiry ? std::next(iter) : cache_.erase(iter);
+    }
+  }
+  if (cache_.size() >= kMaxCachedRpas) {
+    cache_.erase(cache_.begin());
+    stats_.evictions++;
+  }
+  cache_[rpa] = CacheEntry{identity, now + kPrivateAddressTimeout};
+}
+
+void IdentityResolvingList::InvalidateCache(const DeviceAddress& identity,
+                                            bool irk_added) {
+  for (auto iter = cache_.begin(); iter != cache_.end();) {
+    const std::optional<DeviceAddress>& cached = iter->second.identity;
+    bool stale = cached ? *cached == identity : irk_added;
+    iter = stale ? cache_.erase(iter) : std::next(iter);
+  }
 }
 
 }  // namespace bt::gap
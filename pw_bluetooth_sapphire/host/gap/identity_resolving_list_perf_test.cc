@@ -0,0 +1,139 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <pw_assert/check.h>
+#include <pw_async/fake_dispatcher.h>
+#include <pw_log/log.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pw_bluetooth_sapphire/internal/host/common/device_address.h"
+#include "pw_bluetooth_sapphire/internal/host/common/random.h"
+#include "pw_bluetooth_sapphire/internal/host/common/uint128.h"
+#include "pw_bluetooth_sapphire/internal/host/gap/identity_resolving_list.h"
+#include "pw_bluetooth_sapphire/internal/host/sm/util.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace bt::gap {
+namespace {
+
+// Simulates a crowded scan environment: many bonded peers, and advertising
+// reports arriving round-robin from a population of nearby advertisers, most
+// of which are not bonded. Each advertiser keeps its RPA for the duration of
+// the test, as it would between rotations.
+
+// Number of bonded peers with IRKs in the resolving list.
+constexpr size_t kNumBondedPeers = 64;
+
+// Number of distinct advertisers in range, of which every tenth is bonded.
+constexpr size_t kNumAdvertisers = 200;
+
+// Number of advertising reports processed per iteration.
+constexpr size_t kNumReports = 1000;
+
+struct ScanEnvironment {
+  ScanEnvironment() {
+    for (size_t i = 0; i < kNumBondedPeers; i++) {
+      std::array<uint8_t, kDeviceAddressSize> bytes{};
+      bytes[0] = static_cast<uint8_t>(i);
+      identities.emplace_back(DeviceAddress::Type::kLEPublic, bytes);
+      irks.push_back(Random<UInt128>());
+      keys.emplace_back(irks.back());
+    }
+    for (size_t i = 0; i < kNumAdvertisers; i++) {
+      advertisers.push_back(sm::util::GenerateRpa(
+          i % 10 == 0 ? irks[i % kNumBondedPeers] : Random<UInt128>()));
+    }
+  }
+
+  std::vector<DeviceAddress> identities;
+  std::vector<UInt128> irks;
+  std::vector<sm::util::ResolvingKey> keys;
+  std::vector<DeviceAddress> advertisers;
+};
+
+const ScanEnvironment& Environment() {
+  static const ScanEnvironment environment;
+  return environment;
+}
+
+// Baseline: one IrkCanResolveRpa() call per IRK for every report.
+void ResolvePerIrk(pw::perf_test::State& state) {
+  const ScanEnvironment& env = Environment();
+  size_t resolved = 0;
+  while (state.KeepRunning()) {
+    for (size_t report = 0; report < kNumReports; report++) {
+      const DeviceAddress& rpa = env.advertisers[report % kNumAdvertisers];
+      for (const UInt128& irk : env.irks) {
+        if (sm::util::IrkCanResolveRpa(irk, rpa)) {
+          resolved++;
+          break;
+        }
+      }
+    }
+  }
+  PW_CHECK_UINT_NE(resolved, 0);
+}
+
+// Batched resolution against all IRKs, without caching. Each IRK's AES key
+// schedule was expanded once, when the environment was set up.
+void ResolveBatched(pw::perf_test::State& state) {
+  const ScanEnvironment& env = Environment();
+  size_t resolved = 0;
+  while (state.KeepRunning()) {
+    for (size_t report = 0; report < kNumReports; report++) {
+      const DeviceAddress& rpa = env.advertisers[report % kNumAdvertisers];
+      if (sm::util::ResolveRpa(env.keys, rpa)) {
+        resolved++;
+      }
+    }
+  }
+  PW_CHECK_UINT_NE(resolved, 0);
+}
+
+// IdentityResolvingList::Resolve(), which caches results per RPA.
+void ResolveCached(pw::perf_test::State& state) {
+  const ScanEnvironment& env = Environment();
+  pw::async::test::FakeDispatcher dispatcher;
+  IdentityResolvingList list(dispatcher);
+  for (size_t i = 0; i < kNumBondedPeers; i++) {
+    list.Add(env.identities[i], env.irks[i]);
+  }
+
+  size_t resolved = 0;
+  while (state.KeepRunning()) {
+    for (size_t report = 0; report < kNumReports; report++) {
+      if (list.Resolve(env.advertisers[report % kNumAdvertisers])) {
+        resolved++;
+      }
+    }
+  }
+  PW_CHECK_UINT_NE(resolved, 0);
+
+  const IdentityResolvingList::Stats& stats = list.stats();
+  PW_LOG_INFO("Resolving list cache: %zu hits, %zu misses, %zu evictions",
+              stats.cache_hits,
+              stats.cache_misses,
+              stats.evictions);
+}
+
+PW_PERF_TEST(ResolvePerIrk, ResolvePerIrk);
+PW_PERF_TEST(ResolveBatched, ResolveBatched);
+PW_PERF_TEST(ResolveCached, ResolveCached);
+
+}  // namespace
+}  // namespace bt::gap
@@ -14,7 +14,10 @@
 
 #include "pw_bluetooth_sapphire/internal/host/gap/identity_resolving_list.h"
 
+#include <pw_async/fake_dispatcher_fixture.h>
+
 #include "pw_bluetooth_sapphire/internal/host/common/random.h"
+#include "pw_bluetooth_sapphire/internal/host/gap/gap.h"
 #include "pw_bluetooth_sapphire/internal/host/sm/util.h"
 #include "pw_unit_test/framework.h"
 
@@ -26,14 +29,17 @@ const DeviceAddress kAddress1(DeviceAddress::Type::kLERandom,
 const DeviceAddress kAddress2(DeviceAddress::Type::kLERandom,
                               {0x66, 0x55, 0x44, 0x33, 0x22, 0x11});
 
-TEST(IdentityResolvingListTest, ResolveEmpty) {
-  IdentityResolvingList rl;
+class IdentityResolvingListTest
+    : public pw::async::test::FakeDispatcherFixture {
+ protected:
+  IdentityResolvingList rl{dispatcher()};
+};
+
+TEST_F(IdentityResolvingListTest, ResolveEmpty) {
   EXPECT_EQ(std::nullopt, rl.Resolve(kAddress1));
 }
 
-TEST(IdentityResolvingListTest, Resolve) {
-  IdentityResolvingList rl;
-
+TEST_F(IdentityResolvingListTest, Resolve) {
   // Populate the list with two resolvable identities.
   UInt128 irk1 = Random<UInt128>();
   UInt128 irk2 = Random<UInt128>();
@@ -70,8 +76,7 @@ TEST(IdentityResolvingListTest, Resolve) {
 }
 
 // Tests that an identity address can be assigned a new IRK.
-TEST(IdentityResolvingListTest, OverwriteIrk) {
-  IdentityResolvingList rl;
+TEST_F(IdentityResolvingListTest, OverwriteIrk) {
   UInt128 irk1 = Random<UInt128>();
   UInt128 irk2 = Random<UInt128>();
   DeviceAddress rpa1 = sm::util::GenerateRpa(irk1);
@@ -86,5 +91,73 @@ TEST(IdentityResolvingListTest, OverwriteIrk) {
   EXPECT_TRUE(rl.Resolve(rpa2));
 }
 
+TEST_F(IdentityResolvingListTest, CachesResolvedRpa) {
+  UInt128 irk = Random<UInt128>();
+  rl.Add(kAddress1, irk);
+  DeviceAddress rpa = sm::util::GenerateRpa(irk);
+
+  EXPECT_EQ(kAddress1, rl.Resolve(rpa));
+  EXPECT_EQ(kAddress1, rl.Resolve(rpa));
+  EXPECT_EQ(1u, rl.stats().cache_misses);
+  EXPECT_EQ(1u, rl.stats().cache_hits);
+}
+
+TEST_F(IdentityResolvingListTest, UnresolvedRpaIsCachedUntilIrkAdded) {
+  UInt128 irk = Random<UInt128>();
+  DeviceAddress rpa = sm::util::GenerateRpa(irk);
+
+  EXPECT_EQ(std::nullopt, rl.Resolve(rpa));
+  EXPECT_EQ(std::nullopt, rl.Resolve(rpa));
+  EXPECT_EQ(1u, rl.stats().cache_hits);
+
+  // Adding an IRK drops negative results, since the new IRK may resolve them.
+  rl.Add(kAddress1, irk);
+  EXPECT_EQ(kAddress1, rl.Resolve(rpa));
+  EXPECT_EQ(2u, rl.stats().cache_misses);
+}
+
+TEST_F(IdentityResolvingListTest, OverwriteIrkInvalidatesCachedResult) {
+  UInt128 irk = Random<UInt128>();
+  DeviceAddress rpa = sm::util::GenerateRpa(irk);
+  rl.Add(kAddress1, irk);
+  rl.Add(kAddress2, Random<UInt128>());
+  EXPECT_EQ(kAddress1, rl.Resolve(rpa));
+
+  // The cached result for kAddress1 is dropped; the new IRK doesn't resolve.
+  rl.Add(kAddress1, Random<UInt128>());
+  EXPECT_EQ(std::nullopt, rl.Resolve(rpa));
+}
+
+TEST_F(IdentityResolvingListTest, CachedResultsExpire) {
+  UInt128 irk = Random<UInt128>();
+  rl.Add(kAddress1, irk);
+  DeviceAddress rpa = sm::util::GenerateRpa(irk);
+  EXPECT_EQ(kAddress1, rl.Resolve(rpa));
+
+  RunFor(kPrivateAddressTimeout - std::chrono::milliseconds(1));
+  EXPECT_EQ(kAddress1, rl.Resolve(rpa));
+  EXPECT_EQ(1u, rl.stats().cache_misses);
+
+  RunFor(std::chrono::milliseconds(1));
+  EXPECT_EQ(kAddress1, rl.Resolve(rpa));
+  EXPECT_EQ(2u, rl.stats().cache_misses);
+}
+
+TEST_F(IdentityResolvingListTest, CacheIsBounded) {
+  rl.Add(kAddress1, Random<UInt128>());
+  for (size_t i = 0; i < IdentityResolvingList::kMaxCachedRpas; i++) {
+    rl.Resolve(sm::util::GenerateRpa(Random<UInt128>()));
+  }
+  EXPECT_EQ(0u, rl.stats().evictions);
+
+  rl.Resolve(sm::util::GenerateRpa(Random<UInt128>()));
+  EXPECT_EQ(1u, rl.stats().evictions);
+
+  // Expired entries are purged before anything unexpired is evicted.
+  RunFor(kPrivateAddressTimeout);
+  rl.Resolve(sm::util::GenerateRpa(Random<UInt128>()));
+  EXPECT_EQ(1u, rl.stats().evictions);
+}
+
 }  // namespace
 }  // namespace bt::gap
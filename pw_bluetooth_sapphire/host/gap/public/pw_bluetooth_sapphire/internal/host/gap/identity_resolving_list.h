@@ -13,12 +13,18 @@
 // the License.
 
 #pragma once
+#include <pw_async/dispatcher.h>
+#include <pw_chrono/system_clock.h>
+
+#include <cstddef>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "pw_bluetooth_sapphire/internal/host/common/device_address.h"
 #include "pw_bluetooth_sapphire/internal/host/common/macros.h"
 #include "pw_bluetooth_sapphire/internal/host/common/uint128.h"
+#include "pw_bluetooth_sapphire/internal/host/sm/util.h"
 
 namespace bt::gap {
 
@@ -26,10 +32,30 @@ namespace bt::gap {
 // given RPA. Resolution is performed using identity information stored in the
 // registry.
 //
+// Resolving an RPA costs one AES computation per registered IRK, and the same
+// RPA is typically seen in many advertising reports before its owner rotates
+// it. Each IRK's AES key schedule is expanded once, when the IRK is added, and
+// results are cached per RPA, including RPAs that no IRK resolves. Cached
+// results expire after kPrivateAddressTimeout, by which time the peer will
+// normally have moved on to a new RPA.
+//
 // TODO(fxbug.dev/42164183): Manage the controller-based list here.
 class IdentityResolvingList final {
  public:
-  IdentityResolvingList() = default;
+  // Maximum number of RPAs whose resolution results are cached. When the cache
+  // is full, expired entries are purged first and an arbitrary entry is
+  // evicted if none have expired.
+  static constexpr size_t kMaxCachedRpas = 256;
+
+  // Resolution counters, for diagnostics and benchmarks.
+  struct Stats {
+    size_t cache_hits = 0;
+    size_t cache_misses = 0;
+    size_t evictions = 0;
+  };
+
+  // |dispatcher| provides the time used to expire cached results.
+  explicit IdentityResolvingList(pw::async::Dispatcher& dispatcher);
   ~IdentityResolvingList() = default;
 
   // Associate the given |irk| with |identity|. If |identity| is already in the
@@ -44,9 +70,36 @@ class IdentityResolvingList final {
   // Otherwise, returns a value containing the identity address.
   std::optional<DeviceAddress> Resolve(DeviceAddress rpa) const;
 
+  const Stats& stats() const { return stats_; }
+
  private:
-  // Maps identity addresses to IRKs.
-  std::unordered_map<DeviceAddress, UInt128> registry_;
+  struct CacheEntry {
+    // The identity |rpa| resolved to, or std::nullopt if no IRK resolved it.
+    std::optional<DeviceAddress> identity;
+    pw::chrono::SystemClock::time_point expiry;
+  };
+
+  // Inserts a resolution result for |rpa| into the cache, evicting if needed.
+  void CacheResult(const DeviceAddress& rpa,
+                   std::optional<DeviceAddress> identity) const;
+
+  // Drops cached results that a change to |identity|'s IRK could invalidate:
+  // entries that resolved to |identity| and, if |irk_added| is set, all
+  // negative entries.
+  void InvalidateCache(const DeviceAddress& identity, bool irk_added);
+
+  pw::async::Dispatcher& dispatcher_;
+
+  // Registered identity addresses and their expanded IRKs, stored as parallel
+  // arrays so that all keys can be handed to sm::util::ResolveRpa() as one
+  // batch.
+  std::vector<DeviceAddress> identities_;
+  std::vector<sm::util::ResolvingKey> keys_;
+
+  // Maps RPAs to the result of resolving them. Mutable because resolution is
+  // logically const.
+  mutable std::unordered_map<DeviceAddress, CacheEntry> cache_;
+  mutable Stats stats_;
 
   BT_DISALLOW_COPY_ASSIGN_AND_MOVE(IdentityResolvingList);
 };
@@ -250,7 +250,7 @@ class PeerCache final {
   std::unordered_map<DeviceAddress, PeerId> address_map_;
 
   // The LE identity resolving list used to resolve RPAs.
-  IdentityResolvingList le_resolving_list_;
+  IdentityResolvingList le_resolving_list_{dispatcher_};
 
   CallbackId next_callback_id_ = 0u;
   std::unordered_map<CallbackId, PeerCallback> peer_updated_callbacks_;
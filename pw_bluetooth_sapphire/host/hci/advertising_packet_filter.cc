@@ -52,6 +52,7 @@ void AdvertisingPacketFilter::SetPacketFilters(
 
   scan_ids_.insert(scan_id);
   scan_id_to_filters_[scan_id] = filters;
+  filter_index_.Build(scan_id_to_filters_);
 
   if (!config_.offloading_enabled()) {
     return;
@@ -123,6 +124,7 @@ void AdvertisingPacketFilter::UnsetPacketFiltersInternal(ScanId scan_id,
   bt_log(INFO, "hci", "removing packet filters for scan id: %d", scan_id);
   scan_ids_.erase(scan_id);
   scan_id_to_filters_.erase(scan_id);
+  filter_index_.Build(scan_id_to_filters_);
 
   if (!config_.offloading_enabled()) {
     return;
@@ -172,15 +174,14 @@ std::unordered_set<AdvertisingPacketFilter::ScanId>
 AdvertisingPacketFilter::Matches(const AdvertisingData::ParseResult& ad,
                                  bool connectable,
                                  int8_t rssi) const {
-  std::unordered_set<ScanId> result;
-
-  for (uint16_t scan_id : scan_ids_) {
-    if (Matches(scan_id, ad, connectable, rssi)) {
-      result.insert(scan_id);
-    }
-  }
+  return filter_index_.Matches(ad, connectable, rssi);
+}
 
-  return result;
+std::unordered_set<AdvertisingPacketFilter::ScanId>
+AdvertisingPacketFilter::Matches(const ByteBuffer& data,
+                                 bool connectable,
+                                 int8_t rssi) const {
+  return filter_index_.Matches(data, connectable, rssi);
 }
 
 bool AdvertisingPacketFilter::Matches(ScanId scan_id,
@@ -29,6 +29,12 @@ void DiscoveryFilter::SetGeneralDiscoveryFlags() {
             static_cast<uint8_t>(AdvFlag::kLELimitedDiscoverableMode));
 }
 
+bool DiscoveryFilter::RequiresAdvertisingData() const {
+  return flags_ || !service_uuids_.empty() || !service_data_uuids_.empty() ||
+         !solicitation_uuids_.empty() || !name_substring_.empty() ||
+         manufacturer_code_;
+}
+
 bool DiscoveryFilter::Matches(
     const std::optional<std::reference_wrapper<const AdvertisingData>>
         advertising_data,
@@ -49,10 +55,7 @@ bool DiscoveryFilter::Matches(
 
   // Any of these filters being set requires us to have a valid
   // |advertising_data| to pass.
-  bool needs_ad_check = flags_ || !service_uuids_.empty() ||
-                        !service_data_uuids_.empty() ||
-                        !solicitation_uuids_.empty() ||
-                        !name_substring_.empty() || manufacturer_code_;
+  bool needs_ad_check = RequiresAdvertisingData();
 
   if (!advertising_data.has_value() && needs_ad_check) {
     return false;
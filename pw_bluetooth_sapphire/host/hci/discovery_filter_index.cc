@@ -0,0 +1,310 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_bluetooth_sapphire/internal/host/hci/discovery_filter_index.h"
+
+#include <pw_bytes/endian.h>
+#include <pw_preprocessor/compiler.h>
+
+#include <algorithm>
+#include <functional>
+
+#include "pw_bluetooth_sapphire/internal/host/common/supplement_data.h"
+#include "pw_bluetooth_sapphire/internal/host/hci-spec/constants.h"
+
+namespace bt::hci {
+namespace {
+
+// Returns true if any of the |uuid_size|-byte UUIDs in |uuids| is a key of
+// |index|.
+template <typename Index>
+bool ContainsUuidKey(const Index& index,
+                     const BufferView& uuids,
+                     size_t uuid_size) {
+  for (size_t offset = 0; offset + uuid_size <= uuids.size();
+       offset += uuid_size) {
+    UUID uuid;
+    if (UUID::FromBytes(uuids.view(offset, uuid_size), &uuid) &&
+        index.count(uuid) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+class DiscoveryFilterIndex::LazyAdvertisingData {
+ public:
+  LazyAdvertisingData(const ByteBuffer& data, size_t& parse_count)
+      : data_(&data), parse_count_(parse_count) {}
+  LazyAdvertisingData(const AdvertisingData::ParseResult& ad,
+                      size_t& parse_count)
+      : parsed_(&ad), parse_count_(parse_count) {}
+
+  // Returns the advertising data, parsing it on the first call, or
+  // std::nullopt if it is not valid.
+  bool is_parsed() const { return parsed_ != nullptr; }
+
+  // The unparsed advertising data. Only valid if !is_parsed().
+  const ByteBuffer& bytes() const { return *data_; }
+
+  std::optional<std::reference_wrapper<const AdvertisingData>> Get() {
+    if (!parsed_) {
+      owned_.emplace(AdvertisingData::FromBytes(*data_));
+      parsed_ = &owned_.value();
+      parse_count_++;
+    }
+    if (parsed_->is_error()) {
+      return std::nullopt;
+    }
+    return std::cref(parsed_->value());
+  }
+
+ private:
+  const ByteBuffer* data_ = nullptr;
+  const AdvertisingData::ParseResult* parsed_ = nullptr;
+  std::optional<AdvertisingData::ParseResult> owned_;
+  size_t& parse_count_;
+};
+
+void DiscoveryFilterIndex::Build(
+    const std::unordered_map<ScanId, std::vector<DiscoveryFilter>>& filters) {
+  filters_.clear();
+  unfiltered_scan_ids_.clear();
+  unindexed_.clear();
+  manufacturer_code_index_.clear();
+  service_uuid_index_.clear();
+  service_data_uuid_index_.clear();
+  solicitation_uuid_index_.clear();
+  min_indexed_rssi_floor_ = INT8_MAX;
+
+  for (const auto& [scan_id, scan_filters] : filters) {
+    if (scan_filters.empty()) {
+      unfiltered_scan_ids_.insert(scan_id);
+      continue;
+    }
+
+    for (const DiscoveryFilter& filter : scan_filters) {
+      // With a path loss threshold, a report may pass regardless of its RSSI
+      // and is checked against the advertised Tx power.
+      bool has_pathloss = filter.pathloss().has_value();
+      Entry entry{
+          scan_id,
+          filters_.size(),
+          filter.rssi() && !has_pathloss ? *filter.rssi() : kNoRssiFloor,
+          filter.RequiresAdvertisingData() || has_pathloss,
+      };
+      filters_.push_back(filter);
+
+      if (filter.manufacturer_code()) {
+        manufacturer_code_index_[*filter.manufacturer_code()].push_back(entry);
+      } else if (!filter.service_uuids().empty()) {
+        for (const UUID& uuid : filter.service_uuids()) {
+          service_uuid_index_[uuid].push_back(entry);
+        }
+      } else if (!filter.service_data_uuids().empty()) {
+        for (const UUID& uuid : filter.service_data_uuids()) {
+          service_data_uuid_index_[uuid].push_back(entry);
+        }
+      } else if (!filter.solicitation_uuids().empty()) {
+        for (const UUID& uuid : filter.solicitation_uuids()) {
+          solicitation_uuid_index_[uuid].push_back(entry);
+        }
+      } else {
+        unindexed_.push_back(entry);
+        continue;
+      }
+      min_indexed_rssi_floor_ =
+          std::min(min_indexed_rssi_floor_, entry.rssi_floor);
+    }
+  }
+
+  auto sort_bucket = [](Bucket& bucket) {
+    std::stable_sort(
+        bucket.begin(), bucket.end(), [](const Entry& a, const Entry& b) {
+          return a.rssi_floor < b.rssi_floor;
+        });
+  };
+  sort_bucket(unindexed_);
+  for (auto* index : {&service_uuid_index_,
+                      &service_data_uuid_index_,
+                      &solicitation_uuid_index_}) {
+    for (auto& [_, bucket] : *index) {
+      sort_bucket(bucket);
+    }
+  }
+  for (auto& [_, bucket] : manufacturer_code_index_) {
+    sort_bucket(bucket);
+  }
+}
+
+std::unordered_set<DiscoveryFilterIndex::ScanId> DiscoveryFilterIndex::Matches(
+    const ByteBuffer& data, bool connectable, int8_t rssi) const {
+  LazyAdvertisingData ad(data, parse_count_);
+  return Match(ad, connectable, rssi);
+}
+
+std::unordered_set<DiscoveryFilterIndex::ScanId> DiscoveryFilterIndex::Matches(
+    const AdvertisingData::ParseResult& ad,
+    bool connectable,
+    int8_t rssi) const {
+  LazyAdvertisingData lazy_ad(ad, parse_count_);
+  return Match(lazy_ad, connectable, rssi);
+}
+
+std::unordered_set<DiscoveryFilterIndex::ScanId> DiscoveryFilterIndex::Match(
+    LazyAdvertisingData& ad, bool connectable, int8_t rssi) const {
+  std::unordered_set<ScanId> result = unfiltered_scan_ids_;
+  MatchBucket(unindexed_, ad, connectable, rssi, result);
+
+  bool indexed = !manufacturer_code_index_.empty() ||
+                 !service_uuid_index_.empty() ||
+                 !service_data_uuid_index_.empty() ||
+                 !solicitation_uuid_index_.empty();
+  if (!indexed || ReportRssi(rssi) < min_indexed_rssi_floor_) {
+    return result;
+  }
+
+  // Walking the raw fields is much cheaper than parsing them, and most reports
+  // in a crowded environment carry none of the indexed keys.
+  if (!ad.is_parsed() && !ContainsIndexedKey(ad.bytes())) {
+    return result;
+  }
+
+  // Every indexed filter requires advertising data.
+  std::optional<std::reference_wrapper<const AdvertisingData>> data = ad.Get();
+  if (!data) {
+    return result;
+  }
+  const AdvertisingData& parsed = data->get();
+
+  if (!manufacturer_code_index_.empty()) {
+    for (uint16_t code : parsed.manufacturer_data_ids()) {
+      MatchKey(manufacturer_code_index_, code, ad, connectable, rssi, result);
+    }
+  }
+  if (!service_uuid_index_.empty()) {
+    for (const UUID& uuid : parsed.service_uuids()) {
+      MatchKey(service_uuid_index_, uuid, ad, connectable, rssi, result);
+    }
+  }
+  if (!service_data_uuid_index_.empty()) {
+    for (const UUID& uuid : parsed.service_data_uuids()) {
+      MatchKey(service_data_uuid_index_, uuid, ad, connectable, rssi, result);
+    }
+  }
+  if (!solicitation_uuid_index_.empty()) {
+    for (const UUID& uuid : parsed.solicitation_uuids()) {
+      MatchKey(solicitation_uuid_index_, uuid, ad, connectable, rssi, result);
+    }
+  }
+
+  return result;
+}
+
+void DiscoveryFilterIndex::MatchBucket(
+    const Bucket& bucket,
+    LazyAdvertisingData& ad,
+    bool connectable,
+    int8_t rssi,
+    std::unordered_set<ScanId>& result) const {
+  const int report_rssi = ReportRssi(rssi);
+  for (const Entry& entry : bucket) {
+    // Buckets are sorted by RSSI threshold, so no later filter can match.
+    if (entry.rssi_floor > report_rssi) {
+      break;
+    }
+    if (result.count(entry.scan_id) != 0) {
+      continue;
+    }
+
+    std::optional<std::reference_wrapper<const AdvertisingData>> data;
+    if (entry.needs_ad) {
+      data = ad.Get();
+    }
+    if (filters_[entry.filter].Matches(data, connectable, rssi)) {
+      result.insert(entry.scan_id);
+    }
+  }
+}
+
+bool DiscoveryFilterIndex::ContainsIndexedKey(const ByteBuffer& data) const {
+  SupplementDataReader reader(data);
+  if (!reader.is_valid()) {
+    return false;
+  }
+
+  DataType type;
+  BufferView field;
+  while (reader.GetNextField(&type, &field)) {
+    PW_MODIFY_DIAGNOSTICS_PUSH();
+    PW_MODIFY_DIAGNOSTIC(ignored, "-Wswitch-enum");
+    switch (type) {
+      case DataType::kManufacturerSpecificData: {
+        if (field.size() < kManufacturerSpecificDataSizeMin) {
+          break;
+        }
+        uint16_t code = pw::bytes::ConvertOrderFrom(
+            cpp20::endian::little,
+            field.view(0, kManufacturerIdSize).To<uint16_t>());
+        if (manufacturer_code_index_.count(code) != 0) {
+          return true;
+        }
+        break;
+      }
+      case DataType::kIncomplete16BitServiceUuids:
+      case DataType::kComplete16BitServiceUuids:
+      case DataType::kIncomplete32BitServiceUuids:
+      case DataType::kComplete32BitServiceUuids:
+      case DataType::kIncomplete128BitServiceUuids:
+      case DataType::kComplete128BitServiceUuids:
+        if (ContainsUuidKey(service_uuid_index_, field, SizeForType(type))) {
+          return true;
+        }
+        break;
+      case DataType::kServiceData16Bit:
+      case DataType::kServiceData32Bit:
+      case DataType::kServiceData128Bit: {
+        size_t uuid_size = SizeForType(type);
+        if (field.size() >= uuid_size &&
+            ContainsUuidKey(service_data_uuid_index_,
+                            field.view(0, uuid_size),
+                            uuid_size)) {
+          return true;
+        }
+        break;
+      }
+      case DataType::kSolicitationUuid16Bit:
+      case DataType::kSolicitationUuid32Bit:
+      case DataType::kSolicitationUuid128Bit:
+        if (ContainsUuidKey(
+                solicitation_uuid_index_, field, SizeForType(type))) {
+          return true;
+        }
+        break;
+      default:
+        break;
+    }
+    PW_MODIFY_DIAGNOSTICS_POP();
+  }
+  return false;
+}
+
+int DiscoveryFilterIndex::ReportRssi(int8_t rssi) {
+  // A report without RSSI only passes filters that have no RSSI threshold.
+  return rssi == hci_spec::kRSSIInvalid ? kNoRssiFloor : rssi;
+}
+
+}  // namespace bt::hci
@@ -0,0 +1,148 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <pw_assert/check.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "pw_bluetooth_sapphire/internal/host/common/advertising_data.h"
+#include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
+#include "pw_bluetooth_sapphire/internal/host/hci/discovery_filter.h"
+#include "pw_bluetooth_sapphire/internal/host/hci/discovery_filter_index.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace bt::hci {
+namespace {
+
+// Measures host-side advertising packet filtering for many concurrent scan
+// sessions. Each iteration processes one second of advertising reports at
+// 5000 reports per second, so the measured duration is the CPU time spent
+// filtering per second of scanning.
+
+using ScanId = DiscoveryFilterIndex::ScanId;
+using FilterMap = std::unordered_map<ScanId, std::vector<DiscoveryFilter>>;
+
+constexpr size_t kReportsPerSecond = 5000;
+
+// Number of distinct advertisements that the reports cycle through.
+constexpr size_t kNumAdvertisements = 100;
+
+constexpr uint16_t kServiceUuids[] = {
+    0x180d, 0x180f, 0x1812, 0x181a, 0x1826, 0xfe2c, 0xfd6f, 0xfeaa};
+constexpr uint16_t kCompanyIds[] = {
+    0x004c, 0x00e0, 0x0006, 0x0075, 0x0087, 0x0157, 0x0499, 0x0822};
+
+// Builds |num_scans| scan sessions, each filtering on one service UUID or one
+// manufacturer code, about half of them with an RSSI threshold.
+FilterMap MakeFilters(size_t num_scans) {
+  FilterMap filters;
+  for (size_t i = 0; i < num_scans; i++) {
+    DiscoveryFilter filter;
+    if (i % 2 == 0) {
+      filter.set_service_uuids({UUID(kServiceUuids[(i / 2) % 8])});
+    } else {
+      filter.set_manufacturer_code(kCompanyIds[(i / 2) % 8]);
+    }
+    if (i % 4 < 2) {
+      filter.set_rssi(-70);
+    }
+    filters[static_cast<ScanId>(i)] = {filter};
+  }
+  return filters;
+}
+
+struct Report {
+  DynamicByteBuffer data;
+  int8_t rssi;
+};
+
+const std::vector<Report>& Reports() {
+  static const std::vector<Report> reports = [] {
+    std::vector<Report> result;
+    for (size_t i = 0; i < kNumAdvertisements; i++) {
+      AdvertisingData ad;
+      PW_CHECK(ad.SetLocalName("device"));
+      // Most advertisers in a crowded environment match no filter.
+      uint16_t uuid = i % 5 == 0 ? kServiceUuids[i % 8] : 0x1800;
+      uint16_t company = i % 7 == 0 ? kCompanyIds[i % 8] : 0xffff;
+      PW_CHECK(ad.AddServiceUuid(UUID(uuid)));
+      PW_CHECK(
+          ad.SetManufacturerData(company, StaticByteBuffer(0x01).view()));
+      DynamicByteBuffer data(ad.CalculateBlockSize());
+      PW_CHECK(ad.WriteBlock(&data, std::nullopt));
+      int8_t rssi = static_cast<int8_t>(-40 - static_cast<int>(i % 50));
+      result.push_back({std::move(data), rssi});
+    }
+    return result;
+  }();
+  return reports;
+}
+
+// Baseline: parse every report and evaluate every filter of every session.
+void FilterLinear(pw::perf_test::State& state, size_t num_scans) {
+  const FilterMap filters = MakeFilters(num_scans);
+  const std::vector<Report>& reports = Reports();
+  size_t matches = 0;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kReportsPerSecond; i++) {
+      const Report& report = reports[i % kNumAdvertisements];
+      AdvertisingData::ParseResult ad =
+          AdvertisingData::FromBytes(report.data);
+      std::optional<std::reference_wrapper<const AdvertisingData>> ad_ref;
+      if (ad.is_ok()) {
+        ad_ref.emplace(ad.value());
+      }
+      std::unordered_set<ScanId> result;
+      for (const auto& [scan_id, scan_filters] : filters) {
+        for (const DiscoveryFilter& filter : scan_filters) {
+          if (filter.Matches(ad_ref, /*connectable=*/true, report.rssi)) {
+            result.insert(scan_id);
+            break;
+          }
+        }
+      }
+      matches += result.size();
+    }
+  }
+  PW_CHECK_UINT_NE(matches, 0);
+}
+
+void FilterIndexed(pw::perf_test::State& state, size_t num_scans) {
+  DiscoveryFilterIndex index;
+  index.Build(MakeFilters(num_scans));
+  const std::vector<Report>& reports = Reports();
+  size_t matches = 0;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kReportsPerSecond; i++) {
+      const Report& report = reports[i % kNumAdvertisements];
+      matches +=
+          index.Matches(report.data, /*connectable=*/true, report.rssi).size();
+    }
+  }
+  PW_CHECK_UINT_NE(matches, 0);
+}
+
+PW_PERF_TEST(FilterLinear8Scans, FilterLinear, 8);
+PW_PERF_TEST(FilterIndexed8Scans, FilterIndexed, 8);
+PW_PERF_TEST(FilterLinear32Scans, FilterLinear, 32);
+PW_PERF_TEST(FilterIndexed32Scans, FilterIndexed, 32);
+
+}  // namespace
+}  // namespace bt::hci
@@ -0,0 +1,315 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_bluetooth_sapphire/internal/host/hci/discovery_filter_index.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "pw_bluetooth_sapphire/internal/host/common/advertising_data.h"
+#include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
+#include "pw_bluetooth_sapphire/internal/host/hci-spec/constants.h"
+#include "pw_bluetooth_sapphire/internal/host/hci/discovery_filter.h"
+#include "pw_unit_test/framework.h"
+
+namespace bt::hci {
+namespace {
+
+using ScanId = DiscoveryFilterIndex::ScanId;
+using FilterMap = std::unordered_map<ScanId, std::vector<DiscoveryFilter>>;
+
+DynamicByteBuffer Serialize(const AdvertisingData& ad) {
+  DynamicByteBuffer bytes(ad.CalculateBlockSize());
+  EXPECT_TRUE(ad.WriteBlock(&bytes, std::nullopt));
+  return bytes;
+}
+
+DynamicByteBuffer ManufacturerData(uint16_t company_id) {
+  AdvertisingData ad;
+  EXPECT_TRUE(
+      ad.SetManufacturerData(company_id, StaticByteBuffer(0x01).view()));
+  return Serialize(ad);
+}
+
+DynamicByteBuffer ServiceUuidData(uint16_t uuid) {
+  AdvertisingData ad;
+  EXPECT_TRUE(ad.AddServiceUuid(UUID(uuid)));
+  return Serialize(ad);
+}
+
+// Evaluates every filter of every scan session, as a reference.
+std::unordered_set<ScanId> MatchLinear(const FilterMap& filters,
+                                       const ByteBuffer& data,
+                                       bool connectable,
+                                       int8_t rssi) {
+  AdvertisingData::ParseResult ad = AdvertisingData::FromBytes(data);
+  std::optional<std::reference_wrapper<const AdvertisingData>> ad_ref;
+  if (ad.is_ok()) {
+    ad_ref.emplace(ad.value());
+  }
+
+  std::unordered_set<ScanId> result;
+  for (const auto& [scan_id, scan_filters] : filters) {
+    if (scan_filters.empty()) {
+      result.insert(scan_id);
+    }
+    for (const DiscoveryFilter& filter : scan_filters) {
+      if (filter.Matches(ad_ref, connectable, rssi)) {
+        result.insert(scan_id);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+TEST(DiscoveryFilterIndexTest, EmptyIndexMatchesNothing) {
+  DiscoveryFilterIndex index;
+  EXPECT_TRUE(index.Matches(BufferView(), true, 0).empty());
+  EXPECT_EQ(0u, index.advertising_data_parse_count());
+}
+
+TEST(DiscoveryFilterIndexTest, ScanWithoutFiltersMatchesEverything) {
+  DiscoveryFilterIndex index;
+  index.Build({{0, {}}});
+  EXPECT_EQ(std::unordered_set<ScanId>({0}),
+            index.Matches(BufferView(), false, hci_spec::kRSSIInvalid));
+  EXPECT_EQ(0u, index.advertising_data_parse_count());
+}
+
+TEST(DiscoveryFilterIndexTest, DataNotParsedWhenNoFilterNeedsIt) {
+  DiscoveryFilter connectable;
+  connectable.set_connectable(true);
+  DiscoveryFilter nearby;
+  nearby.set_rssi(-60);
+
+  DiscoveryFilterIndex index;
+  index.Build({{0, {connectable}}, {1, {nearby}}});
+
+  DynamicByteBuffer data = ServiceUuidData(0x180d);
+  EXPECT_EQ(std::unordered_set<ScanId>({0, 1}), index.Matches(data, true, -50));
+  EXPECT_EQ(std::unordered_set<ScanId>({0}), index.Matches(data, true, -70));
+  EXPECT_EQ(std::unordered_set<ScanId>({1}), index.Matches(data, false, -50));
+  EXPECT_EQ(0u, index.advertising_data_parse_count());
+}
+
+TEST(DiscoveryFilterIndexTest, ManufacturerCode) {
+  DiscoveryFilter apple;
+  apple.set_manufacturer_code(0x004c);
+  DiscoveryFilter google;
+  google.set_manufacturer_code(0x00e0);
+
+  DiscoveryFilterIndex index;
+  index.Build({{0, {apple}}, {1, {google}}, {2, {apple, google}}});
+
+  EXPECT_EQ(std::unordered_set<ScanId>({0, 2}),
+            index.Matches(ManufacturerData(0x004c), true, 0));
+  EXPECT_EQ(std::unordered_set<ScanId>({1, 2}),
+            index.Matches(ManufacturerData(0x00e0), true, 0));
+  EXPECT_TRUE(index.Matches(ManufacturerData(0x0001), true, 0).empty());
+  EXPECT_TRUE(index.Matches(ServiceUuidData(0x004c), true, 0).empty());
+}
+
+TEST(DiscoveryFilterIndexTest, ServiceUuids) {
+  DiscoveryFilter heart_rate;
+  heart_rate.set_service_uuids({UUID(uint16_t{0x180d})});
+  DiscoveryFilter heart_rate_or_battery;
+  heart_rate_or_battery.set_service_uuids(
+      {UUID(uint16_t{0x180d}), UUID(uint16_t{0x180f})});
+
+  DiscoveryFilterIndex index;
+  index.Build({{0, {heart_rate}}, {1, {heart_rate_or_battery}}});
+
+  EXPECT_EQ(std::unordered_set<ScanId>({0, 1}),
+            index.Matches(ServiceUuidData(0x180d), true, 0));
+  EXPECT_EQ(std::unordered_set<ScanId>({1}),
+            index.Matches(ServiceUuidData(0x180f), true, 0));
+  EXPECT_TRUE(index.Matches(ServiceUuidData(0x1812), true, 0).empty());
+}
+
+TEST(DiscoveryFilterIndexTest, DataParsedOncePerReport) {
+  std::vector<DiscoveryFilter> filters(4);
+  filters[0].set_manufacturer_code(0x004c);
+  filters[1].set_service_uuids({UUID(uint16_t{0x180d})});
+  filters[2].set_name_substring("sensor");
+  filters[3].set_flags(0x02);
+
+  DiscoveryFilterIndex index;
+  index.Build({{0, {filters[0]}},
+               {1, {filters[1]}},
+               {2, {filters[2]}},
+               {3, {filters[3]}}});
+  index.Matches(ServiceUuidData(0x180d), true, 0);
+  EXPECT_EQ(1u, index.advertising_data_parse_count());
+}
+
+TEST(DiscoveryFilterIndexTest, DataWithoutIndexedKeysNotParsed) {
+  DiscoveryFilter apple;
+  apple.set_manufacturer_code(0x004c);
+  DiscoveryFilter heart_rate;
+  heart_rate.set_service_uuids({UUID(uint16_t{0x180d})});
+
+  DiscoveryFilterIndex index;
+  index.Build({{0, {apple}}, {1, {heart_rate}}});
+
+  AdvertisingData ad;
+  EXPECT_TRUE(ad.SetLocalName("device"));
+  EXPECT_TRUE(ad.AddServiceUuid(UUID(uint16_t{0x180f})));
+  EXPECT_TRUE(ad.SetManufacturerData(0x00e0, StaticByteBuffer(0x01).view()));
+  EXPECT_TRUE(index.Matches(Serialize(ad), true, 0).empty());
+  EXPECT_EQ(0u, index.advertising_data_parse_count());
+
+  EXPECT_TRUE(ad.AddServiceUuid(UUID(uint16_t{0x180d})));
+  EXPECT_EQ(std::unordered_set<ScanId>({1}),
+            index.Matches(Serialize(ad), true, 0));
+  EXPECT_EQ(1u, index.advertising_data_parse_count());
+}
+
+TEST(DiscoveryFilterIndexTest, WeakReportSkipsIndexedFilters) {
+  DiscoveryFilter filter;
+  filter.set_manufacturer_code(0x004c);
+  filter.set_rssi(-60);
+
+  DiscoveryFilterIndex index;
+  index.Build({{0, {filter}}});
+
+  DynamicByteBuffer data = ManufacturerData(0x004c);
+  EXPECT_TRUE(index.Matches(data, true, -70).empty());
+  EXPECT_TRUE(index.Matches(data, true, hci_spec::kRSSIInvalid).empty());
+  EXPECT_EQ(0u, index.advertising_data_parse_count());
+
+  EXPECT_EQ(std::unordered_set<ScanId>({0}), index.Matches(data, true, -50));
+  EXPECT_EQ(1u, index.advertising_data_parse_count());
+}
+
+TEST(DiscoveryFilterIndexTest, PathlossIgnoresRssiThreshold) {
+  DiscoveryFilter filter;
+  filter.set_rssi(-40);
+  filter.set_pathloss(70);
+
+  DiscoveryFilterIndex index;
+  index.Build({{0, {filter}}});
+
+  AdvertisingData ad;
+  ad.SetTxPower(10);
+  DynamicByteBuffer data = Serialize(ad);
+  EXPECT_EQ(std::unordered_set<ScanId>({0}), index.Matches(data, true, -50));
+  EXPECT_TRUE(index.Matches(data, true, -70).empty());
+}
+
+TEST(DiscoveryFilterIndexTest, InvalidDataOnlyMatchesFiltersWithoutDataFields) {
+  DiscoveryFilter connectable;
+  connectable.set_connectable(true);
+  DiscoveryFilter named;
+  named.set_name_substring("a");
+  DiscoveryFilter apple;
+  apple.set_manufacturer_code(0x004c);
+
+  DiscoveryFilterIndex index;
+  index.Build({{0, {connectable}}, {1, {named}}, {2, {apple}}});
+
+  // A field that claims to extend past the end of the data.
+  StaticByteBuffer invalid(0x05, 0xff, 0x4c);
+  EXPECT_EQ(std::unordered_set<ScanId>({0}), index.Matches(invalid, true, 0));
+}
+
+// Checks the index against evaluating every filter, across a mix of filter
+// kinds, advertising data and RSSI values.
+TEST(DiscoveryFilterIndexTest, MatchesLinearEvaluation) {
+  uint32_t seed = 1;
+  auto next = [&seed](uint32_t bound) {
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 16) % bound;
+  };
+  const uint16_t kUuids[] = {0x180d, 0x180f, 0x1812, 0xfe2c};
+  const uint16_t kCompanies[] = {0x004c, 0x00e0, 0x0006};
+
+  FilterMap filters;
+  for (ScanId scan_id = 0; scan_id < 24; scan_id++) {
+    std::vector<DiscoveryFilter>& scan_filters = filters[scan_id];
+    for (uint32_t i = next(3); i > 0; i--) {
+      DiscoveryFilter filter;
+      switch (next(6)) {
+        case 0:
+          filter.set_manufacturer_code(kCompanies[next(3)]);
+          break;
+        case 1:
+          filter.set_service_uuids({UUID(kUuids[next(4)])});
+          break;
+        case 2:
+          filter.set_service_data_uuids({UUID(kUuids[next(4)])});
+          break;
+        case 3:
+          filter.set_solicitation_uuids({UUID(kUuids[next(4)])});
+          break;
+        case 4:
+          filter.set_name_substring("dev");
+          break;
+        default:
+          break;
+      }
+      if (next(2) == 0) {
+        filter.set_rssi(static_cast<int8_t>(-40 - static_cast<int>(next(50))));
+      }
+      if (next(4) == 0) {
+        filter.set_pathloss(static_cast<int8_t>(next(80)));
+      }
+      if (next(3) == 0) {
+        filter.set_connectable(next(2) == 0);
+      }
+      scan_filters.push_back(filter);
+    }
+  }
+
+  DiscoveryFilterIndex index;
+  index.Build(filters);
+
+  for (int report = 0; report < 500; report++) {
+    AdvertisingData ad;
+    if (next(2) == 0) {
+      EXPECT_TRUE(
+          ad.SetManufacturerData(kCompanies[next(3)],
+                                 StaticByteBuffer(0x00).view()));
+    }
+    if (next(2) == 0) {
+      EXPECT_TRUE(ad.AddServiceUuid(UUID(kUuids[next(4)])));
+    }
+    if (next(3) == 0) {
+      EXPECT_TRUE(
+          ad.SetServiceData(UUID(kUuids[next(4)]), StaticByteBuffer(0x00)));
+    }
+    if (next(3) == 0) {
+      EXPECT_TRUE(ad.AddSolicitationUuid(UUID(kUuids[next(4)])));
+    }
+    if (next(3) == 0) {
+      EXPECT_TRUE(ad.SetLocalName(next(2) == 0 ? "device" : "other"));
+    }
+    if (next(3) == 0) {
+      ad.SetTxPower(static_cast<int8_t>(next(20)));
+    }
+    DynamicByteBuffer data = Serialize(ad);
+    bool connectable = next(2) == 0;
+    int8_t rssi = next(10) == 0
+                      ? hci_spec::kRSSIInvalid
+                      : static_cast<int8_t>(-30 - static_cast<int>(next(70)));
+
+    EXPECT_EQ(MatchLinear(filters, data, connectable, rssi),
+              index.Matches(data, connectable, rssi));
+  }
+}
+
+}  // namespace
+}  // namespace bt::hci
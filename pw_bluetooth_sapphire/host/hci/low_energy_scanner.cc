@@ -169,9 +169,8 @@ void LowEnergyScanner::NotifyPeerFound(const LowEnergyScanResult& result) {
 
   cached_scan_results_.push_back(result);
 
-  AdvertisingData::ParseResult ad = AdvertisingData::FromBytes(result.data());
-  std::unordered_set<uint16_t> scan_ids =
-      packet_filter_.Matches(ad, result.connectable(), result.rssi());
+  std::unordered_set<uint16_t> scan_ids = packet_filter_.Matches(
+      result.data(), result.connectable(), result.rssi());
 
   if (!scan_ids.empty()) {
     delegate()->OnPeerFound(scan_ids, result);
@@ -16,6 +16,7 @@
 
 #include "pw_bluetooth_sapphire/internal/host/common/bidirectional_multimap.h"
 #include "pw_bluetooth_sapphire/internal/host/hci/discovery_filter.h"
+#include "pw_bluetooth_sapphire/internal/host/hci/discovery_filter_index.h"
 #include "pw_bluetooth_sapphire/internal/host/hci/sequential_command_runner.h"
 #include "pw_bluetooth_sapphire/internal/host/transport/transport.h"
 
@@ -51,10 +52,19 @@ class AdvertisingPacketFilter {
     UnsetPacketFiltersInternal(scan_id, true);
   }
 
+  // Returns the scan ids whose filters match the given scan result. Candidate
+  // filters are found through a DiscoveryFilterIndex rather than by evaluating
+  // every filter of every scan id.
   std::unordered_set<ScanId> Matches(const AdvertisingData::ParseResult& ad,
                                      bool connectable,
                                      int8_t rssi) const;
 
+  // Same as above, but takes the unparsed advertising data, which is only
+  // parsed if some candidate filter needs it.
+  std::unordered_set<ScanId> Matches(const ByteBuffer& data,
+                                     bool connectable,
+                                     int8_t rssi) const;
+
   bool Matches(ScanId scan_id,
                const AdvertisingData::ParseResult& ad,
                bool connectable,
@@ -211,6 +221,10 @@ class AdvertisingPacketFilter {
   // are used to perform Host level packet filtering.
   std::unordered_map<ScanId, std::vector<DiscoveryFilter>> scan_id_to_filters_;
 
+  // Index over |scan_id_to_filters_| used to match scan results against the
+  // filters of every scan id at once. Rebuilt whenever the filters change.
+  DiscoveryFilterIndex filter_index_;
+
   // Map between a scan id and the indexes of its filters offloaded to the
   // Controller.
   BidirectionalMultimap<ScanId, FilterIndex> scan_id_to_index_;
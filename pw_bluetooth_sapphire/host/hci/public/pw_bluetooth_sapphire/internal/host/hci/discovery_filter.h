@@ -131,6 +131,10 @@ class DiscoveryFilter final {
     return solicitation_uuids_;
   }
 
+  // Returns true if any of the parameters set on this filter can only be
+  // satisfied by a scan result that has valid advertising data.
+  bool RequiresAdvertisingData() const;
+
   // Returns true, if the given LE scan result satisfies this filter. Otherwise
   // returns false. |advertising_data| should include scan response data, if
   // any.
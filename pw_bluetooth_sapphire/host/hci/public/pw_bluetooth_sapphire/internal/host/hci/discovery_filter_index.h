@@ -0,0 +1,142 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "pw_bluetooth_sapphire/internal/host/common/advertising_data.h"
+#include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
+#include "pw_bluetooth_sapphire/internal/host/common/uuid.h"
+#include "pw_bluetooth_sapphire/internal/host/hci/discovery_filter.h"
+
+namespace bt::hci {
+
+// A precompiled index over the DiscoveryFilters of every active scan session,
+// used to find the sessions that an advertising report matches without
+// evaluating every filter of every session.
+//
+// Each filter is filed under the most selective key it has: its manufacturer
+// code, otherwise its service UUIDs, service data UUIDs or solicitation UUIDs,
+// in that order. Filters with none of these keys are unindexed and are always
+// candidates. A report is only checked against the unindexed filters and the
+// filters filed under keys it contains. Within each bucket, filters are sorted
+// by their RSSI threshold so that a weak report stops the scan of a bucket
+// early.
+//
+// Advertising data is parsed lazily: a report given as raw bytes is parsed at
+// most once, and only if a candidate filter needs the advertising data. The raw
+// fields of a report are first scanned for indexed keys, so that reports which
+// carry none are not parsed at all.
+class DiscoveryFilterIndex final {
+ public:
+  using ScanId = uint16_t;
+
+  DiscoveryFilterIndex() = default;
+
+  // Replaces the contents of the index with |filters|. A scan session with no
+  // filters matches every report.
+  void Build(
+      const std::unordered_map<ScanId, std::vector<DiscoveryFilter>>& filters);
+
+  // Returns the scan sessions whose filters match the given report. |data| is
+  // the unparsed advertising data, including scan response data, if any.
+  std::unordered_set<ScanId> Matches(const ByteBuffer& data,
+                                     bool connectable,
+                                     int8_t rssi) const;
+
+  // Same as above, for a report whose advertising data was already parsed.
+  std::unordered_set<ScanId> Matches(const AdvertisingData::ParseResult& ad,
+                                     bool connectable,
+                                     int8_t rssi) const;
+
+  // Returns the number of times a report's advertising data was parsed by
+  // Matches(). This method is primarily used for testing.
+  size_t advertising_data_parse_count() const { return parse_count_; }
+
+ private:
+  // Advertising data that is parsed on first use.
+  class LazyAdvertisingData;
+
+  struct Entry {
+    ScanId scan_id;
+    // Index into |filters_|.
+    size_t filter;
+    // Reports with a lower RSSI cannot match this filter. kNoRssiFloor if the
+    // filter has no RSSI threshold, or if a path loss threshold may let a
+    // report pass regardless of its RSSI.
+    int rssi_floor;
+    // Whether evaluating this filter requires the advertising data.
+    bool needs_ad;
+  };
+  using Bucket = std::vector<Entry>;
+
+  static constexpr int kNoRssiFloor = INT8_MIN - 1;
+
+  // Returns |rssi| as compared against RSSI thresholds.
+  static int ReportRssi(int8_t rssi);
+
+  std::unordered_set<ScanId> Match(LazyAdvertisingData& ad,
+                                   bool connectable,
+                                   int8_t rssi) const;
+
+  // Returns true if |data| may contain a manufacturer code or UUID that is a
+  // key of one of the indexes, without parsing it into AdvertisingData.
+  bool ContainsIndexedKey(const ByteBuffer& data) const;
+
+  // Evaluates the filters in |bucket| that can still match a report with
+  // |rssi|, adding the scan sessions they match to |result|.
+  void MatchBucket(const Bucket& bucket,
+                   LazyAdvertisingData& ad,
+                   bool connectable,
+                   int8_t rssi,
+                   std::unordered_set<ScanId>& result) const;
+
+  // Evaluates the bucket for |key| in |index|, if there is one.
+  template <typename Key>
+  void MatchKey(const std::unordered_map<Key, Bucket>& index,
+                const Key& key,
+                LazyAdvertisingData& ad,
+                bool connectable,
+                int8_t rssi,
+                std::unordered_set<ScanId>& result) const {
+    auto iter = index.find(key);
+    if (iter != index.end()) {
+      MatchBucket(iter->second, ad, connectable, rssi, result);
+    }
+  }
+
+  std::vector<DiscoveryFilter> filters_;
+
+  // Scan sessions without filters, which match every report.
+  std::unordered_set<ScanId> unfiltered_scan_ids_;
+
+  Bucket unindexed_;
+  std::unordered_map<uint16_t, Bucket> manufacturer_code_index_;
+  std::unordered_map<UUID, Bucket> service_uuid_index_;
+  std::unordered_map<UUID, Bucket> service_data_uuid_index_;
+  std::unordered_map<UUID, Bucket> solicitation_uuid_index_;
+
+  // The lowest RSSI threshold of any indexed filter. Reports below it are not
+  // checked against the indexed filters.
+  int min_indexed_rssi_floor_ = INT8_MAX;
+
+  mutable size_t parse_count_ = 0;
+};
+
+}  // namespace bt::hci
@@ -20,9 +20,7 @@ namespace bt::l2cap::internal {
 
 ByteBufferPtr BasicModeRxEngine::ProcessPdu(PDU pdu) {
   PW_CHECK(pdu.is_valid());
-  auto sdu = std::make_unique<DynamicByteBuffer>(pdu.length());
-  pdu.Copy(sdu.get());
-  return sdu;
+  return pdu.ReleasePayload();
 }
 
 }  // namespace bt::l2cap::internal
@@ -51,6 +51,7 @@ Channel::Channel(ChannelId id,
       link_handle_(link_handle),
       info_(info),
       max_tx_queued_(max_tx_queued),
+      tx_priority_(hci::AclDataChannel::PacketPriority::kLow),
       requested_acl_priority_(AclPriority::kNormal) {
   PW_DCHECK(id_);
   PW_DCHECK(link_type_ == bt::LinkType::kLE ||
@@ -53,11 +53,10 @@ size_t OutboundFrame::size() const {
 void OutboundFrame::WriteToFragment(MutableBufferView fragment_payload,
                                     size_t offset) {
   // Build a table of the pages making up the frame's content, in sorted order.
+  // The FCS covers the whole frame, so it is computed once at construction
+  // rather than for every fragment.
   const StaticByteBuffer header_buffer = MakeBasicHeader();
-  const std::optional fcs_buffer =
-      include_fcs() ? std::optional(MakeFcs()) : std::nullopt;
-  const BufferView footer_buffer =
-      fcs_buffer ? fcs_buffer->view() : BufferView();
+  const BufferView footer_buffer = fcs_ ? fcs_->view() : BufferView();
   const std::array pages = {
       header_buffer.view(), data_.view(), footer_buffer, BufferView()};
   const std::array offsets = {size_t{0},
@@ -139,6 +138,15 @@ Fragmenter::Fragmenter(hci_spec::ConnectionHandle connection_handle,
 // fragment directly out of |data| and we would only construct the headers,
 // removing the extra copy.
 //
+// Inbound SDUs are already delivered without this copy (see
+// PDU::ReleasePayload()). Doing the same here is a separate change that needs:
+//   - an ACLDataPacket that holds its header apart from a reference to its
+//     payload fragment, rather than one contiguous buffer;
+//   - a Controller::SendAclData() that accepts the header and payload as
+//     separate spans, since it takes a single span today;
+//   - the SDU buffer to outlive every fragment of it queued for flow control
+//     in AclDataChannel, which currently owns copies.
+//
 // * Current theoretical number of data copies:
 //     1. service -> L2CAP channel
 //     2. channel -> fragmenter ->(move) HCI layer
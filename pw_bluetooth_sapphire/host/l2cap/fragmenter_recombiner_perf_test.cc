@@ -0,0 +1,158 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <pw_assert/check.h>
+#include <pw_log/log.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
+#include "pw_bluetooth_sapphire/internal/host/common/slab_allocator.h"
+#include "pw_bluetooth_sapphire/internal/host/l2cap/basic_mode_rx_engine.h"
+#include "pw_bluetooth_sapphire/internal/host/l2cap/fragmenter.h"
+#include "pw_bluetooth_sapphire/internal/host/l2cap/l2cap_defs.h"
+#include "pw_bluetooth_sapphire/internal/host/l2cap/pdu.h"
+#include "pw_bluetooth_sapphire/internal/host/l2cap/recombiner.h"
+#include "pw_bluetooth_sapphire/internal/host/transport/slab_allocators.h"
+#include "pw_bluetooth_sapphire/null_lease_provider.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace bt::l2cap {
+namespace {
+
+// Pushes a fixed number of ACL data packets through L2CAP fragmentation and
+// recombination. Every fragment, and every SDU copied out of a recombined
+// PDU, comes from the packet and buffer pools, so this measures the
+// allocation-heavy inbound and outbound data paths together.
+
+constexpr hci_spec::ConnectionHandle kTestHandle = 0x0001;
+constexpr ChannelId kTestChannelId = 0x0040;
+
+// Number of ACL data packets that make up a single iteration.
+constexpr size_t kNumAclPackets = 100'000;
+
+// Number of SDU bytes delivered per iteration of the transfer benchmarks.
+constexpr size_t kTransferSize = 1024 * 1024;
+
+void LogPoolMetrics(const char* name, const SlabPoolMetrics& metrics) {
+  PW_LOG_INFO("%s pool: peak %zu, %llu pooled, %llu fallback",
+              name,
+              metrics.peak_in_use,
+              static_cast<unsigned long long>(metrics.pool_allocations),
+              static_cast<unsigned long long>(metrics.fallback_allocations));
+}
+
+// |max_acl_payload_size| is the controller's ACL buffer size and |sdu_size|
+// is the size of each L2CAP payload that gets fragmented.
+void FragmentAndRecombine(pw::perf_test::State& state,
+                          uint16_t max_acl_payload_size,
+                          uint16_t sdu_size) {
+  pw::bluetooth_sapphire::NullLeaseProvider lease_provider;
+  Fragmenter fragmenter(kTestHandle, max_acl_payload_size);
+  Recombiner recombiner(kTestHandle, lease_provider);
+  DynamicByteBuffer sdu(sdu_size);
+  sdu.Fill('x');
+
+  size_t recombined_bytes = 0;
+  while (state.KeepRunning()) {
+    size_t packets = 0;
+    while (packets < kNumAclPackets) {
+      PDU outbound = fragmenter.BuildFrame(
+          kTestChannelId, sdu, FrameCheckSequenceOption::kNoFcs);
+      for (auto& fragment : outbound.ReleaseFragments()) {
+        packets++;
+        Recombiner::Result result =
+            recombiner.ConsumeFragment(std::move(fragment));
+        PW_CHECK(!result.frames_dropped);
+        if (result.pdu) {
+          MutableByteBufferPtr payload = NewBuffer(result.pdu->length());
+          result.pdu->Copy(payload.get());
+          recombined_bytes += payload->size();
+        }
+      }
+    }
+  }
+  PW_CHECK_UINT_NE(recombined_bytes, 0);
+
+  const hci::allocators::ACLDataPacketPoolMetrics acl =
+      hci::allocators::GetACLDataPacketPoolMetrics();
+  LogPoolMetrics("Small ACL packet", acl.small);
+  LogPoolMetrics("Medium ACL packet", acl.medium);
+  LogPoolMetrics("Large ACL packet", acl.large);
+  LogPoolMetrics("Small buffer", SmallBufferPoolMetrics());
+  LogPoolMetrics("Large buffer", LargeBufferPoolMetrics());
+}
+
+// LE controllers commonly report the minimum 27-byte ACL buffer size.
+PW_PERF_TEST(FragmentAndRecombineLeMinimum,
+             FragmentAndRecombine,
+             27,
+             kDefaultMTU);
+
+// BR/EDR controllers commonly report a 1021-byte ACL buffer size.
+PW_PERF_TEST(FragmentAndRecombineBrEdr,
+             FragmentAndRecombine,
+             1021,
+             kDefaultMTU);
+
+// Small SDUs that each fit in a single ACL packet.
+PW_PERF_TEST(FragmentAndRecombineSingleFragment,
+             FragmentAndRecombine,
+             251,
+             64);
+
+// Transfers 1 MiB of SDUs over a Basic Mode channel, from fragmentation
+// through recombination to the SDU that the receive engine delivers, as a
+// bulk transfer or an audio stream would.
+void Transfer(pw::perf_test::State& state,
+              uint16_t max_acl_payload_size,
+              uint16_t sdu_size) {
+  pw::bluetooth_sapphire::NullLeaseProvider lease_provider;
+  Fragmenter fragmenter(kTestHandle, max_acl_payload_size);
+  Recombiner recombiner(kTestHandle, lease_provider);
+  internal::BasicModeRxEngine rx_engine;
+  DynamicByteBuffer sdu(sdu_size);
+  sdu.Fill('x');
+
+  while (state.KeepRunning()) {
+    size_t transferred = 0;
+    while (transferred < kTransferSize) {
+      PDU outbound = fragmenter.BuildFrame(
+          kTestChannelId, sdu, FrameCheckSequenceOption::kNoFcs);
+      for (auto& fragment : outbound.ReleaseFragments()) {
+        Recombiner::Result result =
+            recombiner.ConsumeFragment(std::move(fragment));
+        PW_CHECK(!result.frames_dropped);
+        if (result.pdu) {
+          ByteBufferPtr received = rx_engine.ProcessPdu(std::move(*result.pdu));
+          transferred += received->size();
+        }
+      }
+    }
+  }
+}
+
+// Each SDU fits in one BR/EDR ACL packet, as with A2DP media packets.
+PW_PERF_TEST(Transfer1MiBBrEdrSingleFragment, Transfer, 1021, 1000);
+
+// Each SDU fits in one LE ACL packet with the maximum data length.
+PW_PERF_TEST(Transfer1MiBLeSingleFragment, Transfer, 251, 247);
+
+// Large SDUs fragmented over LE ACL packets, as with large GATT transfers.
+PW_PERF_TEST(Transfer1MiBLeFragmented, Transfer, 251, 2048);
+
+}  // namespace
+}  // namespace bt::l2cap
@@ -213,6 +213,12 @@ Channel::WeakPtr LogicalLink::OpenFixedChannel(ChannelId id) {
                                       a2dp_offload_manager_,
                                       wake_lease_provider_);
 
+  // Signaling PDUs are not queued behind bulk data, so that channel
+  // configuration and connection parameter updates are not delayed by it.
+  if (id == kSignalingChannelId || id == kLESignalingChannelId) {
+    chan->set_tx_priority(hci::AclDataChannel::PacketPriority::kHigh);
+  }
+
   auto pp_iter = pending_pdus_.find(id);
   if (pp_iter != pending_pdus_.end()) {
     for (auto& pdu : pp_iter->second) {
@@ -423,6 +429,22 @@ bool LogicalLink::HasAvailablePacket() const {
   return false;
 }
 
+hci::AclDataChannel::PacketPriority LogicalLink::NextPacketPriority() const {
+  using PacketPriority = hci::AclDataChannel::PacketPriority;
+
+  // The remaining fragments of a PDU must be sent before any other PDU.
+  if (IsNextPacketContinuingFragment()) {
+    return current_pdus_channel_->tx_priority();
+  }
+  for (auto& [_, channel] : channels_) {
+    if (channel->HasPDUs() &&
+        channel->tx_priority() == PacketPriority::kHigh) {
+      return PacketPriority::kHigh;
+    }
+  }
+  return PacketPriority::kLow;
+}
+
 void LogicalLink::RoundRobinChannels() {
   // Go through all channels in map
   if (next(current_channel_) == channels_.end()) {
@@ -438,6 +460,9 @@ bool LogicalLink::IsNextPacketContinuingFragment() const {
 }
 
 std::unique_ptr<hci::ACLDataPacket> LogicalLink::GetNextOutboundPacket() {
+  // Only channels of the highest priority class with queued PDUs are
+  // considered when starting a new PDU.
+  const hci::AclDataChannel::PacketPriority priority = NextPacketPriority();
   for (size_t i = 0; i < channels_.size(); i++) {
     if (!IsNextPacketContinuingFragment()) {
       current_pdus_channel_ = ChannelImpl::WeakPtr();
@@ -445,7 +470,8 @@ std::unique_ptr<hci::ACLDataPacket> LogicalLink::GetNextOutboundPacket() {
       // Go to next channel to try and get next packet to send
       RoundRobinChannels();
 
-      if (current_channel_->second->HasPDUs()) {
+      if (current_channel_->second->HasPDUs() &&
+          current_channel_->second->tx_priority() == priority) {
         current_pdus_channel_ = current_channel_->second->GetWeakPtr();
       }
     }
@@ -20,6 +20,26 @@
 #include "pw_bluetooth_sapphire/internal/host/transport/acl_data_packet.h"
 
 namespace bt::l2cap {
+namespace {
+
+// A read-only view into the payload of a PDU that keeps the PDU's fragments
+// alive, so that the payload can be delivered without being copied.
+class FragmentPayloadBuffer final : public ByteBuffer {
+ public:
+  FragmentPayloadBuffer(PDU::FragmentList fragments, BufferView payload)
+      : fragments_(std::move(fragments)), payload_(payload) {}
+
+  const uint8_t* data() const override { return payload_.data(); }
+  size_t size() const override { return payload_.size(); }
+  const_iterator cbegin() const override { return payload_.cbegin(); }
+  const_iterator cend() const override { return payload_.cend(); }
+
+ private:
+  PDU::FragmentList fragments_;
+  BufferView payload_;
+};
+
+}  // namespace
 
 // NOTE: The order in which these are initialized matters, as
 // other.ReleaseFragments() resets |other.fragment_count_|.
@@ -84,6 +104,42 @@ size_t PDU::Copy(MutableByteBuffer* out_buffer, size_t pos, size_t size) const {
   return offset;
 }
 
+ByteBufferPtr PDU::ReleasePayload(size_t pos, size_t size) {
+  PW_DCHECK(is_valid());
+  PW_DCHECK(pos <= length());
+
+  size = std::min(size, length() - pos);
+  if (!size) {
+    fragments_.clear();
+    return std::make_unique<DynamicByteBuffer>();
+  }
+
+  // Find the fragment that holds the first requested byte, and hand out a view
+  // into it if it also holds the last one.
+  size_t offset = pos;
+  for (auto iter = fragments_.begin(); iter != fragments_.end(); ++iter) {
+    BufferView payload = (*iter)->view().payload_data();
+    if (iter == fragments_.begin()) {
+      payload = payload.view(sizeof(BasicHeader));
+    }
+    if (offset >= payload.size()) {
+      offset -= payload.size();
+      continue;
+    }
+    if (offset + size <= payload.size()) {
+      return std::make_unique<FragmentPayloadBuffer>(
+          ReleaseFragments(), payload.view(offset, size));
+    }
+    break;
+  }
+
+  // The requested bytes span multiple fragments.
+  auto buffer = std::make_unique<DynamicByteBuffer>(size);
+  Copy(buffer.get(), pos, size);
+  fragments_.clear();
+  return buffer;
+}
+
 PDU::FragmentList PDU::ReleaseFragments() {
   auto out_list = std::move(fragments_);
 
@@ -308,5 +308,123 @@ TEST(PduTest, ReadMultipleFragments) {
   EXPECT_EQ("is a tesXXXXXXX", pdu_data.AsString());
 }
 
+TEST(PduTest, ReleasePayloadFromSingleFragmentDoesNotCopy) {
+  pw::bluetooth_sapphire::NullLeaseProvider lease_provider;
+  Recombiner recombiner(0x0001, lease_provider);
+
+  // clang-format off
+
+  auto packet = PacketFromBytes(
+    // ACL data header
+    0x01, 0x00, 0x08, 0x00,
+
+    // Basic l2cap header
+    0x04, 0x00, 0xFF, 0xFF, 'T', 'e', 's', 't'
+  );
+
+  // clang-format on
+
+  const uint8_t* information_payload =
+      packet->view().payload_data().data() + sizeof(BasicHeader);
+  auto result = recombiner.ConsumeFragment(std::move(packet));
+  ASSERT_TRUE(result.pdu);
+
+  PDU pdu = std::move(*result.pdu);
+  ByteBufferPtr payload = pdu.ReleasePayload(1, 2);
+  EXPECT_FALSE(pdu.is_valid());
+  ASSERT_TRUE(payload);
+  EXPECT_EQ("es", payload->AsString());
+  EXPECT_EQ(information_payload + 1, payload->data());
+}
+
+TEST(PduTest, ReleasePayloadAcrossFragmentsCopies) {
+  pw::bluetooth_sapphire::NullLeaseProvider lease_provider;
+  Recombiner recombiner(0x0001, lease_provider);
+
+  // clang-format off
+
+  // Partial initial fragment
+  auto packet0 = PacketFromBytes(
+    // ACL data header (PBF: initial fragment)
+    0x01, 0x00, 0x0A, 0x00,
+
+    // Basic l2cap header
+    0x0A, 0x00, 0xFF, 0xFF, 'T', 'h', 'i', 's', ' ', 'i'
+  );
+
+  // Continuation fragment
+  auto packet1 = PacketFromBytes(
+    // ACL data header (PBF: continuing fragment)
+    0x01, 0x10, 0x04, 0x00,
+
+    // L2CAP PDU fragment
+    's', ' ', 'i', 't'
+  );
+
+  // clang-format on
+
+  EXPECT_FALSE(recombiner.ConsumeFragment(std::move(packet0)).frames_dropped);
+  auto result = recombiner.ConsumeFragment(std::move(packet1));
+  ASSERT_TRUE(result.pdu);
+  PDU pdu = std::move(*result.pdu);
+
+  // Bytes from both fragments must be copied into a contiguous buffer.
+  ByteBufferPtr payload = pdu.ReleasePayload();
+  EXPECT_FALSE(pdu.is_valid());
+  ASSERT_TRUE(payload);
+  EXPECT_EQ("This is it", payload->AsString());
+}
+
+TEST(PduTest, ReleasePayloadWithinOneOfSeveralFragmentsDoesNotCopy) {
+  pw::bluetooth_sapphire::NullLeaseProvider lease_provider;
+  Recombiner recombiner(0x0001, lease_provider);
+
+  // clang-format off
+
+  // Partial initial fragment
+  auto packet0 = PacketFromBytes(
+    // ACL data header (PBF: initial fragment)
+    0x01, 0x00, 0x0A, 0x00,
+
+    // Basic l2cap header
+    0x0A, 0x00, 0xFF, 0xFF, 'T', 'h', 'i', 's', ' ', 'i'
+  );
+
+  // Continuation fragment
+  auto packet1 = PacketFromBytes(
+    // ACL data header (PBF: continuing fragment)
+    0x01, 0x10, 0x04, 0x00,
+
+    // L2CAP PDU fragment
+    's', ' ', 'i', 't'
+  );
+
+  // clang-format on
+
+  const uint8_t* second_fragment = packet1->view().payload_data().data();
+  EXPECT_FALSE(recombiner.ConsumeFragment(std::move(packet0)).frames_dropped);
+  auto result = recombiner.ConsumeFragment(std::move(packet1));
+  ASSERT_TRUE(result.pdu);
+
+  ByteBufferPtr payload = result.pdu->ReleasePayload(8, 2);
+  ASSERT_TRUE(payload);
+  EXPECT_EQ("it", payload->AsString());
+  EXPECT_EQ(second_fragment + 2, payload->data());
+}
+
+TEST(PduTest, ReleaseEmptyPayload) {
+  pw::bluetooth_sapphire::NullLeaseProvider lease_provider;
+  Recombiner recombiner(0x0001, lease_provider);
+
+  auto packet = PacketFromBytes(0x01, 0x00, 0x04, 0x00, 0x00, 0x00, 0xFF, 0xFF);
+  auto result = recombiner.ConsumeFragment(std::move(packet));
+  ASSERT_TRUE(result.pdu);
+
+  ByteBufferPtr payload = result.pdu->ReleasePayload();
+  ASSERT_TRUE(payload);
+  EXPECT_EQ(0u, payload->size());
+  EXPECT_FALSE(result.pdu->is_valid());
+}
+
 }  // namespace
 }  // namespace bt::l2cap
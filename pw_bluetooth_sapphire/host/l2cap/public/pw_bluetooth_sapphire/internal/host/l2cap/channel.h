@@ -137,6 +137,16 @@ class Channel : public WeakSelf<Channel> {
   uint16_t max_tx_queued() const { return max_tx_queued_; }
   void set_max_tx_queued(uint16_t count) { max_tx_queued_ = count; }
 
+  // The priority class of this channel's outbound PDUs. PDUs of high priority
+  // channels are sent before those of other channels on the same link, and
+  // before the packets of links without high priority PDUs.
+  hci::AclDataChannel::PacketPriority tx_priority() const {
+    return tx_priority_;
+  }
+  void set_tx_priority(hci::AclDataChannel::PacketPriority priority) {
+    tx_priority_ = priority;
+  }
+
   // Returns the current link security properties of the underlying link.
   // Returns the lowest security level if the link is closed.
   virtual const sm::SecurityProperties security() = 0;
@@ -251,6 +261,8 @@ class Channel : public WeakSelf<Channel> {
   ChannelInfo info_;
   // Maximum number of PDUs in the channel queue
   uint16_t max_tx_queued_;
+  // The priority class of outbound PDUs.
+  hci::AclDataChannel::PacketPriority tx_priority_;
   // The ACL priority that was requested by a client and accepted by the
   // controller.
   pw::bluetooth::AclPriority requested_acl_priority_;
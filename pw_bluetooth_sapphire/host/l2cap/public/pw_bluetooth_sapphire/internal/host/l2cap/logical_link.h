@@ -187,6 +187,7 @@ class LogicalLink : public hci::AclDataChannel::ConnectionInterface {
   bt::LinkType type() const override { return type_; }
   std::unique_ptr<hci::ACLDataPacket> GetNextOutboundPacket() override;
   bool HasAvailablePacket() const override;
+  hci::AclDataChannel::PacketPriority NextPacketPriority() const override;
 
   // Called by ChannelImpl::OnRxPacket() to return credits after the associated
   // packet has been handled.
@@ -19,6 +19,7 @@
 
 #include <list>
 
+#include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
 #include "pw_bluetooth_sapphire/internal/host/common/macros.h"
 #include "pw_bluetooth_sapphire/internal/host/l2cap/l2cap_defs.h"
 #include "pw_bluetooth_sapphire/internal/host/transport/acl_data_packet.h"
@@ -89,6 +90,17 @@ class PDU final {
               size_t pos = 0,
               size_t size = std::numeric_limits<std::size_t>::max()) const;
 
+  // Releases up to |size| bytes of the basic-frame information payload starting
+  // at offset |pos| as a read-only buffer. Once this is called, the PDU will
+  // become invalid.
+  //
+  // If the requested bytes lie within a single fragment, which is always the
+  // case for an unfragmented PDU, the returned buffer takes ownership of the
+  // fragments and refers to the payload in place. Otherwise, the bytes are
+  // copied into a new contiguous buffer.
+  ByteBufferPtr ReleasePayload(
+      size_t pos = 0, size_t size = std::numeric_limits<std::size_t>::max());
+
   // Release ownership of the current fragments, moving them to the caller. Once
   // this is called, the PDU will become invalid.
   FragmentList ReleaseFragments();
@@ -13,6 +13,8 @@
 // the License.
 
 #pragma once
+#include <pw_crypto/aes.h>
+
 #include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
 #include "pw_bluetooth_sapphire/internal/host/common/device_address.h"
 #include "pw_bluetooth_sapphire/internal/host/common/uint128.h"
@@ -22,6 +24,7 @@
 #include "pw_bluetooth_sapphire/internal/host/sm/error.h"
 #include "pw_bluetooth_sapphire/internal/host/sm/smp.h"
 #include "pw_bluetooth_sapphire/internal/host/sm/types.h"
+#include "pw_span/span.h"
 
 namespace bt::sm::util {
 // NOTE:
@@ -135,6 +138,28 @@ uint32_t Ah(const UInt128& k, uint32_t r);
 // described in Vol 6, Part B, 1.3.2.3.
 bool IrkCanResolveRpa(const UInt128& irk, const DeviceAddress& rpa);
 
+// An IRK with its AES key schedule expanded once, so that it can be checked
+// against many RPAs without expanding the key again for each one. Create one
+// when an IRK is stored, rather than for each resolution.
+class ResolvingKey final {
+ public:
+  explicit ResolvingKey(const UInt128& irk);
+
+  // Returns the 24-bit "ah" hash of |be_r_prime|, the padded random part of an
+  // RPA in big-endian order.
+  uint32_t Hash(const UInt128& be_r_prime) const;
+
+ private:
+  pw::crypto::unsafe::aes::BlockEncryptor encryptor_;
+};
+
+// Returns the index of the first key in |keys| that can resolve |rpa|, or
+// std::nullopt if none can. Equivalent to calling IrkCanResolveRpa() with each
+// IRK in turn, except that |rpa| is decoded once for the whole batch and no
+// key is expanded.
+std::optional<size_t> ResolveRpa(pw::span<const ResolvingKey> keys,
+                                 const DeviceAddress& rpa);
+
 // Generates a RPA using the given IRK based on the method described in Vol 6,
 // Part B, 1.3.2.2.
 DeviceAddress GenerateRpa(const UInt128& irk);
@@ -80,6 +80,13 @@ pw::span<std::byte, kUInt128Size> Bytes128(UInt128* value) {
       reinterpret_cast<std::byte*>(value->data()), value->size());
 }
 
+// Returns |irk| in the big-endian order that "e" uses for its key.
+UInt128 BigEndianKey(const UInt128& irk) {
+  UInt128 be_irk;
+  Swap128(irk, &be_irk);
+  return be_irk;
+}
+
 // XOR two 128-bit integers and return the result in |out|. It is possible to
 // pass a pointer to one of the inputs as |out|.
 void Xor128(const UInt128& int1, const UInt128& int2, UInt128* out) {
@@ -381,8 +388,31 @@ uint32_t Ah(const UInt128& k, uint32_t r) {
 }
 
 bool IrkCanResolveRpa(const UInt128& irk, const DeviceAddress& rpa) {
+  const ResolvingKey key(irk);
+  return ResolveRpa(pw::span<const ResolvingKey>(&key, 1), rpa).has_value();
+}
+
+ResolvingKey::ResolvingKey(const UInt128& irk)
+    : encryptor_(Bytes128(BigEndianKey(irk))) {}
+
+uint32_t ResolvingKey::Hash(const UInt128& be_r_prime) const {
+  UInt128 be_hash;
+  PW_CHECK_OK(
+      encryptor_.EncryptBlock(Bytes128(be_r_prime), Bytes128(&be_hash)),
+      "Encryption failed.");
+
+  // ah() keeps the least significant 24 bits of the result, which are the
+  // last three octets of the big-endian block.
+  uint32_t hash = be_hash[kUInt128Size - 1];
+  hash |= static_cast<uint32_t>(be_hash[kUInt128Size - 2]) << 8;
+  hash |= static_cast<uint32_t>(be_hash[kUInt128Size - 3]) << 16;
+  return hash;
+}
+
+std::optional<size_t> ResolveRpa(pw::span<const ResolvingKey> keys,
+                                 const DeviceAddress& rpa) {
   if (!rpa.IsResolvablePrivate()) {
-    return false;
+    return std::nullopt;
   }
 
   // The |rpa_hash| and |prand| values generated below should match the least
@@ -394,14 +424,21 @@ bool IrkCanResolveRpa(const UInt128& irk, const DeviceAddress& rpa) {
                                                   rpa_bytes.To<uint32_t>()) &
                       k24BitMax;
 
-  // Upper 24-bits (we avoid a cast to uint32_t to prevent an invalid access
-  // since the buffer would be too short).
+  // r' = padding || prand, built directly in the big-endian order that
+  // Encrypt() would otherwise produce by swapping.
   BufferView prand_bytes = rpa_bytes.view(3);
-  uint32_t prand = prand_bytes[0];
-  prand |= static_cast<uint32_t>(prand_bytes[1]) << 8;
-  prand |= static_cast<uint32_t>(prand_bytes[2]) << 16;
-
-  return Ah(irk, prand) == rpa_hash;
+  UInt128 be_r_prime;
+  be_r_prime.fill(0);
+  be_r_prime[kUInt128Size - 1] = prand_bytes[0];
+  be_r_prime[kUInt128Size - 2] = prand_bytes[1];
+  be_r_prime[kUInt128Size - 3] = prand_bytes[2];
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i].Hash(be_r_prime) == rpa_hash) {
+      return i;
+    }
+  }
+  return std::nullopt;
 }
 
 DeviceAddress GenerateRpa(const UInt128& irk) {
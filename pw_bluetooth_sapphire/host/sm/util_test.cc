@@ -16,9 +16,12 @@
 
 #include <array>
 #include <cstdint>
+#include <optional>
+#include <vector>
 
 #include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
 #include "pw_bluetooth_sapphire/internal/host/common/device_address.h"
+#include "pw_bluetooth_sapphire/internal/host/common/random.h"
 #include "pw_bluetooth_sapphire/internal/host/common/uint128.h"
 #include "pw_bluetooth_sapphire/internal/host/common/uint256.h"
 #include "pw_bluetooth_sapphire/internal/host/hci-spec/constants.h"
@@ -636,6 +639,38 @@ TEST(UtilTest, GenerateRpa) {
   EXPECT_TRUE(IrkCanResolveRpa(irk, rpa));
 }
 
+TEST(UtilTest, ResolveRpaBatch) {
+  std::vector<UInt128> irks;
+  std::vector<ResolvingKey> keys;
+  for (size_t i = 0; i < 8; i++) {
+    irks.push_back(Random<UInt128>());
+    keys.emplace_back(irks.back());
+  }
+  const DeviceAddress kNonResolvable(DeviceAddress::Type::kLERandom,
+                                     {0xA9, 0xFB, 0x0D, 0x94, 0x81, 0x00});
+
+  EXPECT_EQ(std::nullopt, ResolveRpa(keys, kNonResolvable));
+  EXPECT_EQ(std::nullopt, ResolveRpa({}, GenerateRpa(irks[0])));
+  EXPECT_EQ(std::nullopt, ResolveRpa(keys, GenerateRpa(Random<UInt128>())));
+  for (size_t i = 0; i < irks.size(); i++) {
+    DeviceAddress rpa = GenerateRpa(irks[i]);
+    EXPECT_EQ(std::optional<size_t>(i), ResolveRpa(keys, rpa));
+  }
+}
+
+TEST(UtilTest, ResolvingKeyMatchesAh) {
+  const UInt128 irk = Random<UInt128>();
+  const uint32_t prand = 0x5A1234;
+
+  // r' = padding || prand, in big-endian order.
+  UInt128 be_r_prime{};
+  be_r_prime[kUInt128Size - 1] = static_cast<uint8_t>(prand);
+  be_r_prime[kUInt128Size - 2] = static_cast<uint8_t>(prand >> 8);
+  be_r_prime[kUInt128Size - 3] = static_cast<uint8_t>(prand >> 16);
+
+  EXPECT_EQ(Ah(irk, prand), ResolvingKey(irk).Hash(be_r_prime));
+}
+
 TEST(UtilTest, GenerateRandomAddress) {
   DeviceAddress addr = GenerateRandomAddress(false);
   EXPECT_EQ(DeviceAddress::Type::kLERandom, addr.type());
@@ -17,7 +17,7 @@
 #include <pw_assert/check.h>
 #include <pw_bytes/endian.h>
 
-#include <iterator>
+#include <vector>
 
 #include "lib/fit/function.h"
 #include "pw_bluetooth/vendor.h"
@@ -25,6 +25,7 @@
 #include "pw_bluetooth_sapphire/internal/host/common/log.h"
 #include "pw_bluetooth_sapphire/internal/host/hci-spec/util.h"
 #include "pw_bluetooth_sapphire/internal/host/transport/acl_data_packet.h"
+#include "pw_bluetooth_sapphire/internal/host/transport/acl_scheduler.h"
 #include "pw_bluetooth_sapphire/internal/host/transport/link_type.h"
 #include "pw_bluetooth_sapphire/internal/host/transport/transport.h"
 #include "pw_bluetooth_sapphire/lease.h"
@@ -38,7 +39,8 @@ class AclDataChannelImpl final : public AclDataChannel {
       pw::bluetooth::Controller* hci,
       const DataBufferInfo& bredr_buffer_info,
       const DataBufferInfo& le_buffer_info,
-      pw::bluetooth_sapphire::LeaseProvider& wake_lease_provider);
+      pw::bluetooth_sapphire::LeaseProvider& wake_lease_provider,
+      SchedulerFactory scheduler_factory);
   ~AclDataChannelImpl() override;
 
   // AclDataChannel overrides:
@@ -56,12 +58,10 @@ class AclDataChannelImpl final : public AclDataChannel {
       fit::callback<void(fit::result<fit::failed>)> callback) override;
 
  private:
-  using ConnectionMap = std::unordered_map<hci_spec::ConnectionHandle,
-                                           WeakPtr<ConnectionInterface>>;
-
+  // Packet counts are 16 bits in HCI, so |count| never needs more.
   struct PendingPacketData {
     bt::LinkType ll_type = bt::LinkType::kACL;
-    size_t count = 0;
+    uint16_t count = 0;
   };
 
   // Handler for the HCI Number of Completed Packets Event, used for
@@ -70,12 +70,19 @@ class AclDataChannelImpl final : public AclDataChannel {
       const EventPacket& event);
 
   // Sends next queued packets over the ACL data channel while the controller
-  // has free buffer slots. If controller buffers are free and some links have
-  // queued packets, we round-robin iterate through links, sending a packet from
-  // each link with queued packets until the controller is full or we run out of
-  // packets.
+  // has free buffer slots. The scheduler of each controller buffer decides
+  // which link sends each packet, until the controller is full or we run out
+  // of packets.
   void TrySendNextPackets();
 
+  // Returns the scheduler of the controller buffer used by links of type
+  // |link_type|, taking shared buffers into account.
+  AclScheduler& GetSchedulerForLinkType(LinkType link_type);
+
+  // Returns the total number of controller buffer slots for packets of type
+  // |link_type|, taking shared buffers into account.
+  size_t GetMaxNumPacketsForLinkType(LinkType link_type) const;
+
   // Returns the number of free controller buffer slots for packets of type
   // |link_type|, taking shared buffers into account.
   size_t GetNumFreePacketsForLinkType(LinkType link_type) const;
@@ -95,29 +102,25 @@ class AclDataChannelImpl final : public AclDataChannel {
   // and calls the client's RX callback.
   void OnRxPacket(pw::span<const std::byte> packet);
 
-  // Increment connection iterators using round robin scheduling.
-  // If the BR/EDR buffer is shared, simply increment the iterator to the next
-  // connection. If the BR/EDR buffer isn't shared, increment the iterator to
-  // the next connection of type |connection_type|. No-op if |conn_iter| is
-  // |registered_connections_.end()|.
-  void IncrementRoundRobinIterator(ConnectionMap::iterator& conn_iter,
-                                   bt::LinkType connection_type);
+  // Returns true if |handle| is registered with either scheduler.
+  bool IsRegistered(hci_spec::ConnectionHandle handle) const;
+
+  // Returns the pending packet data of the link with |handle|, or nullptr if
+  // it has no pending packets.
+  PendingPacketData* FindPendingLink(hci_spec::ConnectionHandle handle);
 
   // Increments count of pending packets that have been sent to the controller
   // on |connection|.
-  void IncrementPendingPacketsForLink(WeakPtr<ConnectionInterface>& connection);
+  void IncrementPendingPacketsForLink(const ConnectionInterface& connection);
 
-  // Sends queued packets from links in a round-robin fashion, starting with
-  // |current_link|. |current_link| will be incremented to the next link that
-  // should send packets (according to the round-robin policy).
-  void SendPackets(ConnectionMap::iterator& current_link);
+  // Sends queued packets from the links that use the controller buffer of
+  // |link_type|, in the order chosen by the buffer's scheduler.
+  void SendPackets(LinkType link_type);
 
   // Handler for HCI_Buffer_Overflow_event.
   CommandChannel::EventCallbackResult DataBufferOverflowCallback(
       const EventPacket& event);
 
-  void ResetRoundRobinIterators();
-
   // Links this node to the inspect tree. Initialized as needed by
   // AttachInspect.
   inspect::Node node_;
@@ -160,19 +163,19 @@ class AclDataChannelImpl final : public AclDataChannel {
   UintInspectable<size_t> num_pending_le_packets_;
 
   // Stores per-connection information of unacknowledged packets sent to the
-  // controller. Entries are updated/removed on the HCI Number Of Completed
-  // Packets event and when a connection is unregistered (the controller does
-  // not acknowledge packets of disconnected links).
-  std::unordered_map<hci_spec::ConnectionHandle, PendingPacketData>
-      pending_links_;
-
-  // Stores connections registered by RegisterConnection().
-  ConnectionMap registered_connections_;
-
-  // Iterators used to round-robin through links for sending packets. When the
-  // BR/EDR buffer is shared with LE, |current_le_link_| is ignored
-  ConnectionMap::iterator current_bredr_link_ = registered_connections_.end();
-  ConnectionMap::iterator current_le_link_ = registered_connections_.end();
+  // controller, indexed by connection handle. Entries are updated/cleared on
+  // the HCI Number Of Completed Packets event and when a connection is
+  // unregistered (the controller does not acknowledge packets of disconnected
+  // links). This grows to cover the largest handle that has sent a packet, so
+  // controllers that number handles from zero keep it small.
+  std::vector<PendingPacketData> pending_links_;
+
+  // Schedule the connections registered by RegisterConnection() onto the
+  // BR/EDR and LE controller buffers. When the BR/EDR buffer is shared with
+  // LE, all connections are scheduled by |bredr_scheduler_| and
+  // |le_scheduler_| is unused.
+  std::unique_ptr<AclScheduler> bredr_scheduler_;
+  std::unique_ptr<AclScheduler> le_scheduler_;
 
   pw::bluetooth_sapphire::LeaseProvider& wake_lease_provider_;
   std::optional<pw::bluetooth_sapphire::Lease> wake_lease_;
@@ -185,9 +188,14 @@ std::unique_ptr<AclDataChannel> AclDataChannel::Create(
     pw::bluetooth::Controller* hci,
     const DataBufferInfo& bredr_buffer_info,
     const DataBufferInfo& le_buffer_info,
-    pw::bluetooth_sapphire::LeaseProvider& wake_lease_provider) {
-  return std::make_unique<AclDataChannelImpl>(
-      transport, hci, bredr_buffer_info, le_buffer_info, wake_lease_provider);
+    pw::bluetooth_sapphire::LeaseProvider& wake_lease_provider,
+    SchedulerFactory scheduler_factory) {
+  return std::make_unique<AclDataChannelImpl>(transport,
+                                              hci,
+                                              bredr_buffer_info,
+                                              le_buffer_info,
+                                              wake_lease_provider,
+                                              std::move(scheduler_factory));
 }
 
 AclDataChannelImpl::AclDataChannelImpl(
@@ -195,7 +203,8 @@ AclDataChannelImpl::AclDataChannelImpl(
     pw::bluetooth::Controller* hci,
     const DataBufferInfo& bredr_buffer_info,
     const DataBufferInfo& le_buffer_info,
-    pw::bluetooth_sapphire::LeaseProvider& wake_lease_provider)
+    pw::bluetooth_sapphire::LeaseProvider& wake_lease_provider,
+    SchedulerFactory scheduler_factory)
     : transport_(transport),
       hci_(hci),
       bredr_buffer_info_(bredr_buffer_info),
@@ -206,6 +215,13 @@ AclDataChannelImpl::AclDataChannelImpl(
 
   PW_DCHECK(bredr_buffer_info.IsAvailable() || le_buffer_info.IsAvailable());
 
+  if (!scheduler_factory) {
+    scheduler_factory = [] { return std::make_unique<FairAclScheduler>(); };
+  }
+  bredr_scheduler_ = scheduler_factory();
+  le_scheduler_ = scheduler_factory();
+  PW_CHECK(bredr_scheduler_ && le_scheduler_);
+
   num_completed_packets_event_handler_id_ =
       transport_->command_channel()->AddEventHandler(
           hci_spec::kNumberOfCompletedPacketsEventCode,
@@ -236,99 +252,74 @@ AclDataChannelImpl::~AclDataChannelImpl() {
 
 void AclDataChannelImpl::RegisterConnection(
     WeakPtr<ConnectionInterface> connection) {
-  bt_log(DEBUG,
-         "hci",
-         "ACL register connection (handle: %#.4x)",
-         connection->handle());
-  auto [_, inserted] =
-      registered_connections_.emplace(connection->handle(), connection);
-  PW_CHECK(inserted,
+  const hci_spec::ConnectionHandle handle = connection->handle();
+  bt_log(DEBUG, "hci", "ACL register connection (handle: %#.4x)", handle);
+  PW_CHECK(!IsRegistered(handle),
            "connection with handle %#.4x already registered",
-           connection->handle());
-
-  // Reset the round-robin iterators because they have been invalidated.
-  ResetRoundRobinIterators();
+           handle);
+  GetSchedulerForLinkType(connection->type()).AddLink(std::move(connection));
 }
 
 void AclDataChannelImpl::UnregisterConnection(
     hci_spec::ConnectionHandle handle) {
   bt_log(DEBUG, "hci", "ACL unregister link (handle: %#.4x)", handle);
-  auto iter = registered_connections_.find(handle);
-  if (iter == registered_connections_.end()) {
+  if (!IsRegistered(handle)) {
     bt_log(WARN,
            "hci",
            "attempt to unregister link that is not registered (handle: %#.4x)",
            handle);
     return;
   }
-  registered_connections_.erase(iter);
-
-  // Reset the round-robin iterators because they have been invalidated.
-  ResetRoundRobinIterators();
+  bredr_scheduler_->RemoveLink(handle);
+  le_scheduler_->RemoveLink(handle);
 }
 
 bool AclDataChannelImpl::IsBrEdrBufferShared() const {
   return !le_buffer_info_.IsAvailable();
 }
 
-void AclDataChannelImpl::IncrementRoundRobinIterator(
-    ConnectionMap::iterator& conn_iter, bt::LinkType connection_type) {
-  // Only update iterator if |registered_connections_| is non-empty
-  if (conn_iter == registered_connections_.end()) {
-    bt_log(
-        DEBUG, "hci", "no registered connections, cannot increment iterator");
-    return;
+bool AclDataChannelImpl::IsRegistered(hci_spec::ConnectionHandle handle) const {
+  return bredr_scheduler_->HasLink(handle) || le_scheduler_->HasLink(handle);
+}
+
+AclScheduler& AclDataChannelImpl::GetSchedulerForLinkType(LinkType link_type) {
+  if (link_type == LinkType::kLE && !IsBrEdrBufferShared()) {
+    return *le_scheduler_;
   }
+  return *bredr_scheduler_;
+}
 
-  // Prevent infinite looping by tracking |original_conn_iter|
-  const ConnectionMap::iterator original_conn_iter = conn_iter;
-  do {
-    conn_iter++;
-    if (conn_iter == registered_connections_.end()) {
-      conn_iter = registered_connections_.begin();
-    }
-  } while (!IsBrEdrBufferShared() &&
-           conn_iter->second->type() != connection_type &&
-           conn_iter != original_conn_iter);
-
-  // When buffer isn't shared, we must ensure |conn_iter| is assigned to a link
-  // of the same type.
-  if (!IsBrEdrBufferShared() && conn_iter->second->type() != connection_type) {
-    // There are no connections of |connection_type| in
-    // |registered_connections_|.
-    conn_iter = registered_connections_.end();
+AclDataChannelImpl::PendingPacketData* AclDataChannelImpl::FindPendingLink(
+    hci_spec::ConnectionHandle handle) {
+  if (handle >= pending_links_.size() || pending_links_[handle].count == 0) {
+    return nullptr;
   }
+  return &pending_links_[handle];
 }
 
 void AclDataChannelImpl::IncrementPendingPacketsForLink(
-    WeakPtr<ConnectionInterface>& connection) {
-  auto [iter, _] = pending_links_.try_emplace(
-      connection->handle(), PendingPacketData{connection->type()});
-  iter->second.count++;
-  IncrementPendingPacketsForLinkType(connection->type());
+    const ConnectionInterface& connection) {
+  const hci_spec::ConnectionHandle handle = connection.handle();
+  PW_DCHECK(handle <= hci_spec::kConnectionHandleMax);
+  if (handle >= pending_links_.size()) {
+    pending_links_.resize(handle + 1);
+  }
+  PendingPacketData& data = pending_links_[handle];
+  data.ll_type = connection.type();
+  data.count++;
+  IncrementPendingPacketsForLinkType(connection.type());
 }
 
-void AclDataChannelImpl::SendPackets(ConnectionMap::iterator& current_link) {
-  PW_DCHECK(current_link != registered_connections_.end());
-  const ConnectionMap::iterator original_link = current_link;
-  const LinkType link_type = original_link->second->type();
-  size_t free_buffer_packets = GetNumFreePacketsForLinkType(link_type);
-  bool is_packet_queued = true;
-
-  // Send packets as long as a link may have a packet queued and buffer space is
-  // available.
-  for (; free_buffer_packets != 0;
-       IncrementRoundRobinIterator(current_link, link_type)) {
-    if (current_link == original_link) {
-      if (!is_packet_queued) {
-        // All links are empty
-        break;
-      }
-      is_packet_queued = false;
-    }
+void AclDataChannelImpl::SendPackets(LinkType link_type) {
+  AclScheduler& scheduler = GetSchedulerForLinkType(link_type);
+  const size_t buffer_capacity = GetMaxNumPacketsForLinkType(link_type);
 
-    if (!current_link->second->HasAvailablePacket()) {
-      continue;
+  // Send packets as long as a link has a packet that may be sent and buffer
+  // space is available.
+  while (GetNumFreePacketsForLinkType(link_type) != 0) {
+    ConnectionInterface* connection = scheduler.NextLink(buffer_capacity);
+    if (!connection) {
+      break;
     }
 
     // Acquire a wake lease because we may be taking the last queued packet from
@@ -336,26 +327,21 @@ void AclDataChannelImpl::SendPackets(ConnectionMap::iterator& current_link) {
     pw::Result<pw::bluetooth_sapphire::Lease> lease = PW_SAPPHIRE_ACQUIRE_LEASE(
         wake_lease_provider_, "AclDataChannelImpl::SendPackets");
 
-    // If there is an available packet, send and update packet counts
-    ACLDataPacketPtr packet = current_link->second->GetNextOutboundPacket();
+    ACLDataPacketPtr packet = connection->GetNextOutboundPacket();
     PW_DCHECK(packet);
     hci_->SendAclData(packet->view().data().subspan());
 
-    is_packet_queued = true;
-    free_buffer_packets--;
-    IncrementPendingPacketsForLink(current_link->second);
+    scheduler.OnPacketSent(connection->handle(), packet->view().payload_size());
+    IncrementPendingPacketsForLink(*connection);
   }
 }
 
 void AclDataChannelImpl::TrySendNextPackets() {
-  if (current_bredr_link_ != registered_connections_.end()) {
-    // If the BR/EDR buffer is shared, this will also send LE packets.
-    SendPackets(current_bredr_link_);
-  }
+  // If the BR/EDR buffer is shared, this will also send LE packets.
+  SendPackets(LinkType::kACL);
 
-  if (!IsBrEdrBufferShared() &&
-      current_le_link_ != registered_connections_.end()) {
-    SendPackets(current_le_link_);
+  if (!IsBrEdrBufferShared()) {
+    SendPackets(LinkType::kLE);
   }
 }
 
@@ -386,15 +372,14 @@ void AclDataChannelImpl::ClearControllerPacketCount(
   // Ensure link has already been unregistered. Otherwise, queued packets for
   // this handle could be sent after clearing packet count, and the packet count
   // could become corrupted.
-  PW_CHECK(registered_connections_.find(handle) ==
-           registered_connections_.end());
+  PW_CHECK(!IsRegistered(handle));
 
   bt_log(DEBUG, "hci", "clearing pending packets (handle: %#.4x)", handle);
 
   // subtract removed packets from sent packet counts, because controller does
   // not send HCI Number of Completed Packets event for disconnected link
-  auto iter = pending_links_.find(handle);
-  if (iter == pending_links_.end()) {
+  PendingPacketData* data = FindPendingLink(handle);
+  if (!data) {
     bt_log(DEBUG,
            "hci",
            "no pending packets on connection (handle: %#.4x)",
@@ -402,10 +387,9 @@ void AclDataChannelImpl::ClearControllerPacketCount(
     return;
   }
 
-  const PendingPacketData& data = iter->second;
-  DecrementPendingPacketsForLinkType(data.ll_type, data.count);
+  DecrementPendingPacketsForLinkType(data->ll_type, data->count);
 
-  pending_links_.erase(iter);
+  data->count = 0;
 
   // Try sending the next batch of packets in case buffer space opened up.
   TrySendNextPackets();
@@ -507,8 +491,8 @@ AclDataChannelImpl::NumberOfCompletedPacketsCallback(const EventPacket& event) {
     uint16_t connection_handle = view.nocp_data()[i].connection_handle().Read();
     uint16_t num_completed_packets =
         view.nocp_data()[i].num_completed_packets().Read();
-    auto iter = pending_links_.find(connection_handle);
-    if (iter == pending_links_.end()) {
+    PendingPacketData* data = FindPendingLink(connection_handle);
+    if (!data) {
       // This is expected if the completed packet is a SCO packet.
       bt_log(TRACE,
              "hci",
@@ -519,7 +503,7 @@ AclDataChannelImpl::NumberOfCompletedPacketsCallback(const EventPacket& event) {
       continue;
     }
 
-    if (iter->second.count < num_completed_packets) {
+    if (data->count < num_completed_packets) {
       // TODO(fxbug.dev/42102535): This can be caused by the controller
       // reusing the connection handle of a connection that just disconnected.
       // We should somehow avoid sending the controller packets for a connection
@@ -529,25 +513,23 @@ AclDataChannelImpl::NumberOfCompletedPacketsCallback(const EventPacket& event) {
       // drivers.
       bt_log(ERROR,
              "hci",
-             "ACL packet tx count mismatch! (handle: %#.4x, expected: %zu, "
+             "ACL packet tx count mismatch! (handle: %#.4x, expected: %u, "
              "actual : %u)",
              connection_handle,
-             iter->second.count,
+             data->count,
              num_completed_packets);
       // This should eventually result in convergence with the correct pending
       // packet count. If it undercounts the true number of pending packets,
       // this branch will be reached again when the controller sends an updated
       // Number of Completed Packets event. However, AclDataChannel may overflow
       // the controller's buffer in the meantime!
-      num_completed_packets = static_cast<uint16_t>(iter->second.count);
+      num_completed_packets = data->count;
     }
 
-    iter->second.count -= num_completed_packets;
-    DecrementPendingPacketsForLinkType(iter->second.ll_type,
-                                       num_completed_packets);
-    if (!iter->second.count) {
-      pending_links_.erase(iter);
-    }
+    data->count -= num_completed_packets;
+    DecrementPendingPacketsForLinkType(data->ll_type, num_completed_packets);
+    GetSchedulerForLinkType(data->ll_type)
+        .OnPacketsCompleted(connection_handle, num_completed_packets);
   }
 
   TrySendNextPackets();
@@ -555,6 +537,16 @@ AclDataChannelImpl::NumberOfCompletedPacketsCallback(const EventPacket& event) {
   return CommandChannel::EventCallbackResult::kContinue;
 }
 
+size_t AclDataChannelImpl::GetMaxNumPacketsForLinkType(
+    LinkType link_type) const {
+  if (link_type == LinkType::kACL || IsBrEdrBufferShared()) {
+    return bredr_buffer_info_.max_num_packets();
+  } else if (link_type == LinkType::kLE) {
+    return le_buffer_info_.max_num_packets();
+  }
+  return 0;
+}
+
 size_t AclDataChannelImpl::GetNumFreePacketsForLinkType(
     LinkType link_type) const {
   if (link_type == LinkType::kACL || IsBrEdrBufferShared()) {
@@ -656,18 +648,4 @@ AclDataChannelImpl::DataBufferOverflowCallback(const EventPacket& event) {
   return CommandChannel::EventCallbackResult::kContinue;
 }
 
-void AclDataChannelImpl::ResetRoundRobinIterators() {
-  current_bredr_link_ = registered_connections_.begin();
-
-  // If the BR/EDR buffer isn't shared, we need to do extra work to ensure
-  // |current_bredr_link_| is initialized to a link of BR/EDR type. The same
-  // applies for |current_le_link_|.
-  if (!IsBrEdrBufferShared()) {
-    current_le_link_ = registered_connections_.begin();
-
-    IncrementRoundRobinIterator(current_bredr_link_, bt::LinkType::kACL);
-    IncrementRoundRobinIterator(current_le_link_, bt::LinkType::kLE);
-  }
-}
-
 }  // namespace bt::hci
@@ -1211,6 +1211,156 @@ TEST_F(AclDataChannelTest, WakeLeaseHeldWhileGettingLastPacketFromConnection) {
   EXPECT_EQ(lease_provider().lease_count(), 1u);
 }
 
+TEST_F(AclDataChannelTest, HighPriorityPacketSentBeforeQueuedLowPriority) {
+  constexpr size_t kMaxNumPackets = 1;
+  InitializeACLDataChannel(DataBufferInfo(kMaxMtu, kMaxNumPackets),
+                           DataBufferInfo());
+
+  FakeAclConnection connection_0(
+      acl_data_channel(), kConnectionHandle0, bt::LinkType::kACL);
+  FakeAclConnection connection_1(
+      acl_data_channel(), kConnectionHandle1, bt::LinkType::kACL);
+  connection_1.set_priority(AclDataChannel::PacketPriority::kHigh);
+
+  acl_data_channel()->RegisterConnection(connection_0.GetWeakPtr());
+  acl_data_channel()->RegisterConnection(connection_1.GetWeakPtr());
+
+  auto make_packet = [](hci_spec::ConnectionHandle handle, uint8_t payload) {
+    ACLDataPacketPtr packet =
+        ACLDataPacket::New(handle,
+                           hci_spec::ACLPacketBoundaryFlag::kFirstNonFlushable,
+                           hci_spec::ACLBroadcastFlag::kPointToPoint,
+                           /*payload_size=*/1);
+    packet->mutable_view()->mutable_payload_data()[0] = payload;
+    return packet;
+  };
+
+  // The first low priority packet fills the controller buffer.
+  EXPECT_ACL_PACKET_OUT(test_device(),
+                        StaticByteBuffer(LowerBits(kConnectionHandle0),
+                                         UpperBits(kConnectionHandle0),
+                                         // payload length
+                                         0x01,
+                                         0x00,
+                                         // payload
+                                         0x00));
+  for (uint8_t i = 0; i < 3; i++) {
+    connection_0.QueuePacket(make_packet(kConnectionHandle0, i));
+  }
+  connection_1.QueuePacket(make_packet(kConnectionHandle1, 0x10));
+  RunUntilIdle();
+  EXPECT_TRUE(test_device()->AllExpectedDataPacketsSent());
+  EXPECT_EQ(connection_0.queued_packets().size(), 2u);
+  EXPECT_EQ(connection_1.queued_packets().size(), 1u);
+
+  // The high priority packet takes the next free buffer slot, even though the
+  // low priority packets were queued first.
+  EXPECT_ACL_PACKET_OUT(test_device(),
+                        StaticByteBuffer(LowerBits(kConnectionHandle1),
+                                         UpperBits(kConnectionHandle1),
+                                         // payload length
+                                         0x01,
+                                         0x00,
+                                         // payload
+                                         0x10));
+  test_device()->SendCommandChannelPacket(
+      bt::testing::NumberOfCompletedPacketsPacket(kConnectionHandle0, 1));
+  RunUntilIdle();
+  EXPECT_TRUE(test_device()->AllExpectedDataPacketsSent());
+  EXPECT_EQ(connection_0.queued_packets().size(), 2u);
+  EXPECT_EQ(connection_1.queued_packets().size(), 0u);
+
+  EXPECT_ACL_PACKET_OUT(test_device(),
+                        StaticByteBuffer(LowerBits(kConnectionHandle0),
+                                         UpperBits(kConnectionHandle0),
+                                         // payload length
+                                         0x01,
+                                         0x00,
+                                         // payload
+                                         0x01));
+  test_device()->SendCommandChannelPacket(
+      bt::testing::NumberOfCompletedPacketsPacket(kConnectionHandle1, 1));
+  RunUntilIdle();
+  EXPECT_TRUE(test_device()->AllExpectedDataPacketsSent());
+  EXPECT_EQ(connection_0.queued_packets().size(), 1u);
+}
+
+TEST_F(AclDataChannelTest, PendingPacketsOfLargestConnectionHandle) {
+  constexpr size_t kMaxNumPackets = 1;
+  constexpr hci_spec::ConnectionHandle kHandle = hci_spec::kConnectionHandleMax;
+  InitializeACLDataChannel(DataBufferInfo(kMaxMtu, kMaxNumPackets),
+                           DataBufferInfo());
+
+  FakeAclConnection connection(acl_data_channel(), kHandle, bt::LinkType::kACL);
+  acl_data_channel()->RegisterConnection(connection.GetWeakPtr());
+
+  auto packet_bytes = [](uint8_t payload) {
+    return StaticByteBuffer(LowerBits(kHandle),
+                            UpperBits(kHandle),
+                            // payload length
+                            0x01,
+                            0x00,
+                            // payload
+                            payload);
+  };
+  for (uint8_t i = 0; i < 3; i++) {
+    ACLDataPacketPtr packet =
+        ACLDataPacket::New(kHandle,
+                           hci_spec::ACLPacketBoundaryFlag::kFirstNonFlushable,
+                           hci_spec::ACLBroadcastFlag::kPointToPoint,
+                           /*payload_size=*/1);
+    packet->mutable_view()->mutable_payload_data()[0] = i;
+    connection.QueuePacket(std::move(packet));
+  }
+  EXPECT_ACL_PACKET_OUT(test_device(), packet_bytes(0x00));
+  RunUntilIdle();
+  EXPECT_TRUE(test_device()->AllExpectedDataPacketsSent());
+  EXPECT_EQ(connection.queued_packets().size(), 2u);
+
+  // Completed packets of a smaller handle without pending packets free no
+  // buffer space.
+  test_device()->SendCommandChannelPacket(
+      bt::testing::NumberOfCompletedPacketsPacket(kHandle - 1, 1));
+  RunUntilIdle();
+  EXPECT_EQ(connection.queued_packets().size(), 2u);
+
+  EXPECT_ACL_PACKET_OUT(test_device(), packet_bytes(0x01));
+  test_device()->SendCommandChannelPacket(
+      bt::testing::NumberOfCompletedPacketsPacket(kHandle, 1));
+  RunUntilIdle();
+  EXPECT_TRUE(test_device()->AllExpectedDataPacketsSent());
+  EXPECT_EQ(connection.queued_packets().size(), 1u);
+
+  // Clearing the packet count of the unregistered link frees its buffer slot
+  // for other links.
+  acl_data_channel()->UnregisterConnection(kHandle);
+  FakeAclConnection connection_0(
+      acl_data_channel(), kConnectionHandle0, bt::LinkType::kACL);
+  acl_data_channel()->RegisterConnection(connection_0.GetWeakPtr());
+  ACLDataPacketPtr packet =
+      ACLDataPacket::New(kConnectionHandle0,
+                         hci_spec::ACLPacketBoundaryFlag::kFirstNonFlushable,
+                         hci_spec::ACLBroadcastFlag::kPointToPoint,
+                         /*payload_size=*/1);
+  packet->mutable_view()->mutable_payload_data()[0] = 0x10;
+  connection_0.QueuePacket(std::move(packet));
+  RunUntilIdle();
+  EXPECT_EQ(connection_0.queued_packets().size(), 1u);
+
+  EXPECT_ACL_PACKET_OUT(test_device(),
+                        StaticByteBuffer(LowerBits(kConnectionHandle0),
+                                         UpperBits(kConnectionHandle0),
+                                         // payload length
+                                         0x01,
+                                         0x00,
+                                         // payload
+                                         0x10));
+  acl_data_channel()->ClearControllerPacketCount(kHandle);
+  RunUntilIdle();
+  EXPECT_TRUE(test_device()->AllExpectedDataPacketsSent());
+  EXPECT_EQ(connection_0.queued_packets().size(), 0u);
+}
+
 INSTANTIATE_TEST_SUITE_P(AclDataChannelTest,
                          AclDataChannelBREDRAndBothBuffers,
                          ::testing::ValuesIn(bredr_both_buffers));
@@ -28,13 +28,16 @@ namespace {
 // and large.
 using SmallACLDataPacket =
     allocators::internal::FixedSizePacket<hci_spec::ACLDataHeader,
-                                          allocators::kSmallACLDataPacketSize>;
+                                          allocators::kSmallACLDataPacketSize,
+                                          allocators::kNumSmallACLDataPackets>;
 using MediumACLDataPacket =
     allocators::internal::FixedSizePacket<hci_spec::ACLDataHeader,
-                                          allocators::kMediumACLDataPacketSize>;
+                                          allocators::kMediumACLDataPacketSize,
+                                          allocators::kNumMediumACLDataPackets>;
 using LargeACLDataPacket =
     allocators::internal::FixedSizePacket<hci_spec::ACLDataHeader,
-                                          allocators::kLargeACLDataPacketSize>;
+                                          allocators::kLargeACLDataPacketSize,
+                                          allocators::kNumLargeACLDataPackets>;
 
 ACLDataPacketPtr NewACLDataPacket(size_t payload_size) {
   PW_CHECK(payload_size <= allocators::kLargeACLDataPayloadSize,
@@ -55,6 +58,18 @@ ACLDataPacketPtr NewACLDataPacket(size_t payload_size) {
 
 }  // namespace
 
+namespace allocators {
+
+ACLDataPacketPoolMetrics GetACLDataPacketPoolMetrics() {
+  return ACLDataPacketPoolMetrics{
+      .small = SmallACLDataPacket::slab_pool_metrics(),
+      .medium = MediumACLDataPacket::slab_pool_metrics(),
+      .large = LargeACLDataPacket::slab_pool_metrics(),
+  };
+}
+
+}  // namespace allocators
+
 // static
 ACLDataPacketPtr ACLDataPacket::New(uint16_t payload_size) {
   return NewACLDataPacket(payload_size);
@@ -0,0 +1,131 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_bluetooth_sapphire/internal/host/transport/acl_scheduler.h"
+
+#include <pw_assert/check.h>
+
+#include <algorithm>
+
+namespace bt::hci {
+
+using PacketPriority = AclDataChannel::PacketPriority;
+
+void FairAclScheduler::AddLink(WeakPtr<ConnectionInterface> connection) {
+  PW_CHECK(connection.is_alive());
+  const hci_spec::ConnectionHandle handle = connection->handle();
+  PW_CHECK(FindLink(handle) == links_.size(),
+           "link with handle %#.4x already scheduled",
+           handle);
+  // New links start at the current virtual time so that they do not get
+  // credit for the time before they were added.
+  links_.push_back(
+      Link{std::move(connection), handle, virtual_time_, /*in_flight=*/0});
+}
+
+void FairAclScheduler::RemoveLink(hci_spec::ConnectionHandle handle) {
+  const size_t index = FindLink(handle);
+  if (index == links_.size()) {
+    return;
+  }
+  links_.erase(links_.begin() + static_cast<std::ptrdiff_t>(index));
+
+  // Keep the round-robin position on the same link.
+  if (index < next_link_) {
+    next_link_--;
+  }
+  if (next_link_ >= links_.size()) {
+    next_link_ = 0;
+  }
+}
+
+bool FairAclScheduler::HasLink(hci_spec::ConnectionHandle handle) const {
+  return FindLink(handle) != links_.size();
+}
+
+AclScheduler::ConnectionInterface* FairAclScheduler::NextLink(
+    size_t buffer_capacity) {
+  size_t backlogged = 0;
+  for (const Link& link : links_) {
+    if (link.connection->HasAvailablePacket()) {
+      backlogged++;
+    }
+  }
+  if (backlogged == 0) {
+    return nullptr;
+  }
+
+  // Leave a buffer slot for each of the other links with queued packets. If
+  // every backlogged link is at this limit, the buffer is full, so free slots
+  // are never left unused.
+  const size_t max_in_flight = buffer_capacity > backlogged
+                                   ? buffer_capacity - (backlogged - 1)
+                                   : 1;
+
+  // Scan in round-robin order starting after the link that sent last, so that
+  // links with equal start times take turns.
+  Link* best = nullptr;
+  uint64_t best_start = 0;
+  bool best_is_high = false;
+  for (size_t i = 0; i < links_.size(); i++) {
+    Link& link = links_[(next_link_ + i) % links_.size()];
+    if (link.in_flight >= max_in_flight ||
+        !link.connection->HasAvailablePacket()) {
+      continue;
+    }
+
+    const bool is_high =
+        link.connection->NextPacketPriority() == PacketPriority::kHigh;
+    const uint64_t start = std::max(link.finish_time, virtual_time_);
+    if (!best || (is_high && !best_is_high) ||
+        (is_high == best_is_high && start < best_start)) {
+      best = &link;
+      best_start = start;
+      best_is_high = is_high;
+    }
+  }
+  return best ? &best->connection.get() : nullptr;
+}
+
+void FairAclScheduler::OnPacketSent(hci_spec::ConnectionHandle handle,
+                                    size_t size) {
+  const size_t index = FindLink(handle);
+  PW_CHECK(index != links_.size(), "unknown link %#.4x", handle);
+  Link& link = links_[index];
+  virtual_time_ = std::max(link.finish_time, virtual_time_);
+  link.finish_time = virtual_time_ + size;
+  link.in_flight++;
+  next_link_ = (index + 1) % links_.size();
+}
+
+void FairAclScheduler::OnPacketsCompleted(hci_spec::ConnectionHandle handle,
+                                          size_t count) {
+  const size_t index = FindLink(handle);
+  if (index == links_.size()) {
+    return;
+  }
+  Link& link = links_[index];
+  link.in_flight -= std::min(count, link.in_flight);
+}
+
+size_t FairAclScheduler::FindLink(hci_spec::ConnectionHandle handle) const {
+  for (size_t i = 0; i < links_.size(); i++) {
+    if (links_[i].handle == handle) {
+      return i;
+    }
+  }
+  return links_.size();
+}
+
+}  // namespace bt::hci
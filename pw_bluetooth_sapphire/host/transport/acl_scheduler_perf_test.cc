@@ -0,0 +1,300 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <pw_assert/check.h>
+#include <pw_log/log.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "pw_bluetooth_sapphire/internal/host/transport/acl_scheduler.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace bt::hci {
+namespace {
+
+// Simulates a small-packet link, such as a HID device, competing with bulk
+// links for the controller's LE data buffer. Each iteration simulates one
+// second of traffic and measures the time from when the small link queues a
+// report until the host sends it to the controller, which is the part of the
+// latency that the scheduler controls. Latency percentiles are logged.
+
+using PacketPriority = AclDataChannel::PacketPriority;
+
+constexpr size_t kBufferCapacity = 8;
+
+// Transmission time at 2 Mbit/s, ignoring link layer overhead.
+constexpr uint64_t kMicrosecondsPerByte = 4;
+
+constexpr uint64_t kSimulatedMicroseconds = 1'000'000;
+
+// Bulk links always have a maximum size LE data packet queued.
+constexpr size_t kNumBulkLinks = 3;
+constexpr size_t kBulkPacketSize = 251;
+
+// The small link queues a burst of reports every connection interval.
+constexpr size_t kReportSize = 27;
+constexpr size_t kReportsPerInterval = 2;
+constexpr uint64_t kReportIntervalMicroseconds = 7'500;
+
+class SimulatedLink : public AclDataChannel::ConnectionInterface {
+ public:
+  SimulatedLink(hci_spec::ConnectionHandle handle,
+                size_t packet_size,
+                bool bulk)
+      : handle_(handle),
+        packet_size_(packet_size),
+        bulk_(bulk),
+        weak_self_(this) {}
+
+  // Queues a packet at time |now|. Bulk links always have a packet queued.
+  void Queue(uint64_t now) { queued_.push_back(now); }
+
+  // Returns the time at which the next packet was queued.
+  uint64_t Dequeue() {
+    if (bulk_) {
+      return 0;
+    }
+    uint64_t queued_at = queued_.front();
+    queued_.pop_front();
+    return queued_at;
+  }
+
+  size_t packet_size() const { return packet_size_; }
+  bool bulk() const { return bulk_; }
+  void set_priority(PacketPriority priority) { priority_ = priority; }
+
+  WeakPtr<ConnectionInterface> GetWeakPtr() {
+    return weak_self_.GetWeakPtr();
+  }
+
+  // AclDataChannel::ConnectionInterface overrides:
+  hci_spec::ConnectionHandle handle() const override { return handle_; }
+  bt::LinkType type() const override { return bt::LinkType::kLE; }
+  // Unused: the simulation dequeues packets itself.
+  std::unique_ptr<ACLDataPacket> GetNextOutboundPacket() override {
+    return nullptr;
+  }
+  bool HasAvailablePacket() const override {
+    return bulk_ || !queued_.empty();
+  }
+  PacketPriority NextPacketPriority() const override { return priority_; }
+
+ private:
+  hci_spec::ConnectionHandle handle_;
+  size_t packet_size_;
+  bool bulk_;
+  std::deque<uint64_t> queued_;
+  PacketPriority priority_ = PacketPriority::kLow;
+  WeakSelf<ConnectionInterface> weak_self_;
+};
+
+// Baseline: the policy AclDataChannel used before AclScheduler, which sends one
+// packet from each link with queued packets in turn.
+class RoundRobinAclScheduler final : public AclScheduler {
+ public:
+  void AddLink(WeakPtr<ConnectionInterface> connection) override {
+    links_.push_back(std::move(connection));
+  }
+  void RemoveLink(hci_spec::ConnectionHandle) override {}
+  bool HasLink(hci_spec::ConnectionHandle) const override { return false; }
+  ConnectionInterface* NextLink(size_t) override {
+    for (size_t i = 0; i < links_.size(); i++) {
+      ConnectionInterface& link = links_[(next_ + i) % links_.size()].get();
+      if (link.HasAvailablePacket()) {
+        next_ = (next_ + i + 1) % links_.size();
+        return &link;
+      }
+    }
+    return nullptr;
+  }
+  void OnPacketSent(hci_spec::ConnectionHandle, size_t) override {}
+  void OnPacketsCompleted(hci_spec::ConnectionHandle, size_t) override {}
+
+ private:
+  std::vector<WeakPtr<ConnectionInterface>> links_;
+  size_t next_ = 0;
+};
+
+// A controller that transmits the packets in its buffer one at a time, taking
+// turns between links as connection events do.
+class SimulatedController {
+ public:
+  explicit SimulatedController(size_t num_links) : buffers_(num_links) {}
+
+  bool HasFreeSlot() const { return buffered_ < kBufferCapacity; }
+
+  // Buffers a packet of |link|, whose handle is its index.
+  void Send(size_t link_index, SimulatedLink* link) {
+    PW_CHECK(HasFreeSlot());
+    buffers_[link_index].push_back(link);
+    buffered_++;
+  }
+
+  // Starts transmitting the next packet at |now| if the radio is idle.
+  void StartTransmission(uint64_t now) {
+    if (transmitting_ || buffered_ == 0) {
+      return;
+    }
+    for (size_t i = 0; i < buffers_.size(); i++) {
+      size_t index = (next_link_ + i) % buffers_.size();
+      if (!buffers_[index].empty()) {
+        transmitting_link_ = index;
+        next_link_ = (index + 1) % buffers_.size();
+        break;
+      }
+    }
+    const SimulatedLink* link = buffers_[transmitting_link_].front();
+    transmitted_at_ = now + link->packet_size() * kMicrosecondsPerByte;
+    transmitting_ = true;
+  }
+
+  bool transmitting() const { return transmitting_; }
+  uint64_t transmitted_at() const { return transmitted_at_; }
+
+  // Completes the packet being transmitted and returns its link.
+  SimulatedLink* CompleteTransmission() {
+    SimulatedLink* link = buffers_[transmitting_link_].front();
+    buffers_[transmitting_link_].pop_front();
+    buffered_--;
+    transmitting_ = false;
+    return link;
+  }
+
+ private:
+  // The links of the packets in the buffer, by link.
+  std::vector<std::deque<SimulatedLink*>> buffers_;
+  size_t buffered_ = 0;
+  size_t next_link_ = 0;
+  size_t transmitting_link_ = 0;
+  bool transmitting_ = false;
+  uint64_t transmitted_at_ = 0;
+};
+
+// Simulates one second of traffic, adding the latency of each report of the
+// small link to |latencies|.
+void Simulate(AclScheduler& scheduler,
+              size_t num_links,
+              SimulatedLink& small_link,
+              std::vector<uint64_t>& latencies) {
+  SimulatedController controller(num_links);
+  uint64_t now = 0;
+  uint64_t next_report = 0;
+  while (now < kSimulatedMicroseconds) {
+    while (next_report <= now) {
+      for (size_t i = 0; i < kReportsPerInterval; i++) {
+        small_link.Queue(next_report);
+      }
+      next_report += kReportIntervalMicroseconds;
+    }
+
+    // Fill the free buffer slots, as AclDataChannel does.
+    while (controller.HasFreeSlot()) {
+      AclDataChannel::ConnectionInterface* next =
+          scheduler.NextLink(kBufferCapacity);
+      if (!next) {
+        break;
+      }
+      auto* link = static_cast<SimulatedLink*>(next);
+      const uint64_t queued_at = link->Dequeue();
+      if (!link->bulk()) {
+        latencies.push_back(now - queued_at);
+      }
+      controller.Send(link->handle(), link);
+      scheduler.OnPacketSent(link->handle(), link->packet_size());
+    }
+
+    controller.StartTransmission(now);
+    if (controller.transmitting() &&
+        controller.transmitted_at() <= next_report) {
+      now = controller.transmitted_at();
+      SimulatedLink* link = controller.CompleteTransmission();
+      scheduler.OnPacketsCompleted(link->handle(), 1);
+    } else {
+      now = next_report;
+    }
+  }
+}
+
+uint64_t Percentile(std::vector<uint64_t>& values, size_t percent) {
+  PW_CHECK(!values.empty());
+  const size_t index = (values.size() - 1) * percent / 100;
+  std::nth_element(values.begin(),
+                   values.begin() + static_cast<std::ptrdiff_t>(index),
+                   values.end());
+  return values[index];
+}
+
+void SmallLinkLatency(pw::perf_test::State& state,
+                      bool fair,
+                      PacketPriority small_link_priority) {
+  std::vector<std::unique_ptr<SimulatedLink>> links;
+  for (size_t i = 0; i < kNumBulkLinks; i++) {
+    links.push_back(std::make_unique<SimulatedLink>(
+        static_cast<hci_spec::ConnectionHandle>(i),
+        kBulkPacketSize,
+        /*bulk=*/true));
+  }
+  // Handles are indexes into |links|.
+  links.push_back(std::make_unique<SimulatedLink>(
+      static_cast<hci_spec::ConnectionHandle>(kNumBulkLinks),
+      kReportSize,
+      /*bulk=*/false));
+  SimulatedLink& small_link = *links.back();
+  small_link.set_priority(small_link_priority);
+
+  std::vector<uint64_t> latencies;
+  while (state.KeepRunning()) {
+    std::unique_ptr<AclScheduler> scheduler;
+    if (fair) {
+      scheduler = std::make_unique<FairAclScheduler>();
+    } else {
+      scheduler = std::make_unique<RoundRobinAclScheduler>();
+    }
+    for (auto& link : links) {
+      scheduler->AddLink(link->GetWeakPtr());
+    }
+    latencies.clear();
+    Simulate(*scheduler, links.size(), small_link, latencies);
+    // Discard reports still queued at the end of the simulation.
+    while (small_link.HasAvailablePacket()) {
+      small_link.Dequeue();
+    }
+  }
+
+  PW_LOG_INFO("Small link latency (us): p50 %u, p99 %u, max %u",
+              static_cast<unsigned>(Percentile(latencies, 50)),
+              static_cast<unsigned>(Percentile(latencies, 99)),
+              static_cast<unsigned>(Percentile(latencies, 100)));
+}
+
+PW_PERF_TEST(SmallLinkLatencyRoundRobin,
+             SmallLinkLatency,
+             /*fair=*/false,
+             PacketPriority::kLow);
+PW_PERF_TEST(SmallLinkLatencyFair,
+             SmallLinkLatency,
+             /*fair=*/true,
+             PacketPriority::kLow);
+PW_PERF_TEST(SmallLinkLatencyFairHighPriority,
+             SmallLinkLatency,
+             /*fair=*/true,
+             PacketPriority::kHigh);
+
+}  // namespace
+}  // namespace bt::hci
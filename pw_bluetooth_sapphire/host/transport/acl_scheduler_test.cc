@@ -0,0 +1,231 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_bluetooth_sapphire/internal/host/transport/acl_scheduler.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "pw_unit_test/framework.h"
+
+namespace bt::hci {
+namespace {
+
+using PacketPriority = AclDataChannel::PacketPriority;
+
+constexpr size_t kBufferCapacity = 8;
+constexpr hci_spec::ConnectionHandle kNoLink = 0xffff;
+
+// A link with a number of queued packets of a fixed size. The scheduler only
+// decides which link sends, so packets are dequeued by the test.
+class TestLink : public AclDataChannel::ConnectionInterface {
+ public:
+  TestLink(hci_spec::ConnectionHandle handle, size_t packet_size)
+      : handle_(handle), packet_size_(packet_size), weak_self_(this) {}
+
+  void Queue(size_t count) { queued_ += count; }
+  void Dequeue() { queued_--; }
+  size_t queued() const { return queued_; }
+  size_t packet_size() const { return packet_size_; }
+  void set_priority(PacketPriority priority) { priority_ = priority; }
+
+  WeakPtr<ConnectionInterface> GetWeakPtr() {
+    return weak_self_.GetWeakPtr();
+  }
+
+  // AclDataChannel::ConnectionInterface overrides:
+  hci_spec::ConnectionHandle handle() const override { return handle_; }
+  bt::LinkType type() const override { return bt::LinkType::kLE; }
+  std::unique_ptr<ACLDataPacket> GetNextOutboundPacket() override {
+    return nullptr;
+  }
+  bool HasAvailablePacket() const override { return queued_ != 0; }
+  PacketPriority NextPacketPriority() const override { return priority_; }
+
+ private:
+  hci_spec::ConnectionHandle handle_;
+  size_t packet_size_;
+  size_t queued_ = 0;
+  PacketPriority priority_ = PacketPriority::kLow;
+  WeakSelf<ConnectionInterface> weak_self_;
+};
+
+class FairAclSchedulerTest : public ::testing::Test {
+ protected:
+  TestLink& AddLink(hci_spec::ConnectionHandle handle, size_t packet_size) {
+    links_.push_back(std::make_unique<TestLink>(handle, packet_size));
+    scheduler_.AddLink(links_.back()->GetWeakPtr());
+    return *links_.back();
+  }
+
+  // Sends one packet from the link chosen by the scheduler and returns its
+  // handle, or kNoLink if no link was chosen.
+  hci_spec::ConnectionHandle SendNext(size_t capacity = kBufferCapacity) {
+    AclDataChannel::ConnectionInterface* next = scheduler_.NextLink(capacity);
+    if (!next) {
+      return kNoLink;
+    }
+    TestLink* link = static_cast<TestLink*>(next);
+    link->Dequeue();
+    scheduler_.OnPacketSent(link->handle(), link->packet_size());
+    return link->handle();
+  }
+
+  FairAclScheduler& scheduler() { return scheduler_; }
+
+ private:
+  FairAclScheduler scheduler_;
+  std::vector<std::unique_ptr<TestLink>> links_;
+};
+
+TEST_F(FairAclSchedulerTest, NoLinkWithoutQueuedPackets) {
+  EXPECT_EQ(SendNext(), kNoLink);
+  AddLink(0x0001, 10);
+  EXPECT_EQ(SendNext(), kNoLink);
+}
+
+TEST_F(FairAclSchedulerTest, AddAndRemoveLinks) {
+  AddLink(0x0001, 10);
+  AddLink(0x0002, 10);
+  EXPECT_TRUE(scheduler().HasLink(0x0001));
+  EXPECT_TRUE(scheduler().HasLink(0x0002));
+  EXPECT_FALSE(scheduler().HasLink(0x0003));
+
+  scheduler().RemoveLink(0x0001);
+  EXPECT_FALSE(scheduler().HasLink(0x0001));
+  EXPECT_TRUE(scheduler().HasLink(0x0002));
+
+  // Removing an unknown link is a no-op.
+  scheduler().RemoveLink(0x0003);
+  EXPECT_TRUE(scheduler().HasLink(0x0002));
+}
+
+TEST_F(FairAclSchedulerTest, EqualPacketsAlternateBetweenLinks) {
+  AddLink(0x0001, 10).Queue(3);
+  AddLink(0x0002, 10).Queue(3);
+
+  std::vector<hci_spec::ConnectionHandle> order;
+  for (size_t i = 0; i < 6; i++) {
+    order.push_back(SendNext(/*capacity=*/100));
+    scheduler().OnPacketsCompleted(order.back(), 1);
+  }
+  EXPECT_EQ(order,
+            (std::vector<hci_spec::ConnectionHandle>{
+                0x0001, 0x0002, 0x0001, 0x0002, 0x0001, 0x0002}));
+  EXPECT_EQ(SendNext(), kNoLink);
+}
+
+TEST_F(FairAclSchedulerTest, LinksShareBytesFairly) {
+  TestLink& bulk = AddLink(0x0001, 1000);
+  TestLink& small = AddLink(0x0002, 100);
+  bulk.Queue(100);
+  small.Queue(1000);
+
+  // While both links are backlogged, the small packet link sends ten packets
+  // for every packet of the bulk link.
+  size_t bulk_sent = 0;
+  size_t small_sent = 0;
+  for (size_t i = 0; i < 110; i++) {
+    hci_spec::ConnectionHandle handle = SendNext();
+    scheduler().OnPacketsCompleted(handle, 1);
+    if (handle == bulk.handle()) {
+      bulk_sent++;
+    } else {
+      small_sent++;
+    }
+  }
+  EXPECT_EQ(bulk_sent, 10u);
+  EXPECT_EQ(small_sent, 100u);
+}
+
+TEST_F(FairAclSchedulerTest, IdleLinkDoesNotBurstWhenItResumes) {
+  TestLink& link_0 = AddLink(0x0001, 10);
+  TestLink& link_1 = AddLink(0x0002, 10);
+  link_0.Queue(100);
+  for (size_t i = 0; i < 50; i++) {
+    scheduler().OnPacketsCompleted(SendNext(), 1);
+  }
+
+  // |link_1| was idle while |link_0| sent, so it does not get to send 50
+  // packets in a row when it resumes.
+  link_1.Queue(10);
+  std::vector<hci_spec::ConnectionHandle> order;
+  for (size_t i = 0; i < 4; i++) {
+    order.push_back(SendNext());
+    scheduler().OnPacketsCompleted(order.back(), 1);
+  }
+  EXPECT_EQ(order,
+            (std::vector<hci_spec::ConnectionHandle>{
+                0x0002, 0x0001, 0x0002, 0x0001}));
+}
+
+TEST_F(FairAclSchedulerTest, HighPriorityLinkSendsFirst) {
+  TestLink& bulk = AddLink(0x0001, 10);
+  TestLink& control = AddLink(0x0002, 10);
+  bulk.Queue(10);
+  control.Queue(3);
+  control.set_priority(PacketPriority::kHigh);
+
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_EQ(SendNext(/*capacity=*/100), control.handle());
+  }
+  EXPECT_EQ(SendNext(/*capacity=*/100), bulk.handle());
+}
+
+TEST_F(FairAclSchedulerTest, LinkLeavesBufferSlotsForOtherLinks) {
+  TestLink& link_0 = AddLink(0x0001, 10);
+  TestLink& link_1 = AddLink(0x0002, 1000);
+  TestLink& link_2 = AddLink(0x0003, 1000);
+  link_0.Queue(10);
+
+  // Alone, a link may fill the buffer.
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_EQ(SendNext(/*capacity=*/4), link_0.handle());
+  }
+
+  // With two other backlogged links, |link_0| may hold at most 2 of the 4
+  // buffer slots, even though it sent fewer bytes than the other links.
+  link_1.Queue(10);
+  link_2.Queue(10);
+  EXPECT_EQ(SendNext(/*capacity=*/4), link_1.handle());
+  scheduler().OnPacketsCompleted(link_1.handle(), 1);
+  EXPECT_EQ(SendNext(/*capacity=*/4), link_2.handle());
+  scheduler().OnPacketsCompleted(link_2.handle(), 1);
+
+  // Once the controller completes |link_0|'s packets, it may send again.
+  scheduler().OnPacketsCompleted(link_0.handle(), 2);
+  EXPECT_EQ(SendNext(/*capacity=*/4), link_0.handle());
+}
+
+TEST_F(FairAclSchedulerTest, RemovedLinkIsNotScheduled) {
+  TestLink& link_0 = AddLink(0x0001, 10);
+  TestLink& link_1 = AddLink(0x0002, 10);
+  TestLink& link_2 = AddLink(0x0003, 10);
+  link_0.Queue(10);
+  link_1.Queue(10);
+  link_2.Queue(10);
+
+  EXPECT_EQ(SendNext(/*capacity=*/100), link_0.handle());
+  EXPECT_EQ(SendNext(/*capacity=*/100), link_1.handle());
+  scheduler().RemoveLink(link_0.handle());
+  EXPECT_EQ(SendNext(/*capacity=*/100), link_2.handle());
+  EXPECT_EQ(SendNext(/*capacity=*/100), link_1.handle());
+  EXPECT_EQ(SendNext(/*capacity=*/100), link_2.handle());
+
+  // Completions for removed links are ignored.
+  scheduler().OnPacketsCompleted(link_0.handle(), 1);
+}
+
+}  // namespace
+}  // namespace bt::hci
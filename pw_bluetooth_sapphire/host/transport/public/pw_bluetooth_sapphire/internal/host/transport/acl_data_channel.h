@@ -38,6 +38,7 @@ namespace bt::hci {
 // in the l2cap library
 using UniqueChannelId = uint16_t;
 
+class AclScheduler;
 class Transport;
 
 // Represents the Bluetooth ACL Data channel and manages the Host<->Controller
@@ -47,6 +48,8 @@ class Transport;
 // Core Spec v5.0, Vol 2, Part E, Section 4.1.1.
 class AclDataChannel {
  public:
+  enum class PacketPriority { kHigh, kLow };
+
   // This interface will be implemented by l2cap::LogicalLink
   class ConnectionInterface {
    public:
@@ -61,6 +64,12 @@ class AclDataChannel {
 
     // Returns true if link has a queued packet
     virtual bool HasAvailablePacket() const = 0;
+
+    // Returns the priority class of the packet that GetNextOutboundPacket()
+    // would return. Only called while HasAvailablePacket() is true.
+    virtual PacketPriority NextPacketPriority() const {
+      return PacketPriority::kLow;
+    }
   };
 
   // Registers a connection. Failure to register a connection before sending
@@ -86,8 +95,6 @@ class AclDataChannel {
   // Called by LogicalLink when a packet is available
   virtual void OnOutboundPacketAvailable() = 0;
 
-  enum class PacketPriority { kHigh, kLow };
-
   using AclPacketPredicate = fit::function<bool(const ACLDataPacketPtr& packet,
                                                 UniqueChannelId channel_id)>;
 
@@ -104,12 +111,18 @@ class AclDataChannel {
   //
   // As this class is intended to support flow-control for both, this function
   // should be called based on what is reported by the controller.
+  //
+  // |scheduler_factory| creates the scheduler that decides which link sends
+  // next for each controller data buffer. FairAclScheduler is used if it is
+  // null.
+  using SchedulerFactory = fit::function<std::unique_ptr<AclScheduler>()>;
   static std::unique_ptr<AclDataChannel> Create(
       Transport* transport,
       pw::bluetooth::Controller* hci,
       const DataBufferInfo& bredr_buffer_info,
       const DataBufferInfo& le_buffer_info,
-      pw::bluetooth_sapphire::LeaseProvider& wake_lease_provider);
+      pw::bluetooth_sapphire::LeaseProvider& wake_lease_provider,
+      SchedulerFactory scheduler_factory = nullptr);
 
   virtual ~AclDataChannel() = default;
 
@@ -0,0 +1,112 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pw_bluetooth_sapphire/internal/host/common/weak_self.h"
+#include "pw_bluetooth_sapphire/internal/host/hci-spec/protocol.h"
+#include "pw_bluetooth_sapphire/internal/host/transport/acl_data_channel.h"
+
+namespace bt::hci {
+
+// Decides which logical link sends the next outbound ACL data packet when a
+// controller data buffer slot is free. AclDataChannel uses one scheduler per
+// controller data buffer: one for the BR/EDR buffer and, if the controller has
+// a dedicated LE buffer, one for the LE buffer.
+class AclScheduler {
+ public:
+  using ConnectionInterface = AclDataChannel::ConnectionInterface;
+
+  virtual ~AclScheduler() = default;
+
+  // Adds |connection| to the links that are scheduled. A link must not be
+  // added again until it has been removed.
+  virtual void AddLink(WeakPtr<ConnectionInterface> connection) = 0;
+
+  // Removes the link with |handle|. Its packets that are still in the
+  // controller's buffer are no longer accounted for.
+  virtual void RemoveLink(hci_spec::ConnectionHandle handle) = 0;
+
+  // Returns true if the link with |handle| has been added.
+  virtual bool HasLink(hci_spec::ConnectionHandle handle) const = 0;
+
+  // Returns the link that should send the next packet, or nullptr if no link
+  // may send one. Called only while the controller's buffer has a free slot.
+  // |buffer_capacity| is the total number of packets that the buffer holds.
+  virtual ConnectionInterface* NextLink(size_t buffer_capacity) = 0;
+
+  // Called after a packet with a payload of |size| bytes was taken from the
+  // link returned by NextLink() and sent to the controller.
+  virtual void OnPacketSent(hci_spec::ConnectionHandle handle, size_t size) = 0;
+
+  // Called when the controller reports that |count| packets of the link with
+  // |handle| have left its buffer.
+  virtual void OnPacketsCompleted(hci_spec::ConnectionHandle handle,
+                                  size_t count) = 0;
+};
+
+// The default AclScheduler. Links are served by strict priority class first:
+// while any link's next packet is PacketPriority::kHigh, only such links may
+// send. Within a class, links share the controller's buffer fairly by bytes
+// using start-time fair queueing, so a link sending small packets is not
+// starved by links sending large ones, with ties served in round-robin order.
+//
+// To keep a link that the controller drains slowly from occupying the whole
+// buffer, a link may not use the slots that would leave another link with
+// queued packets unable to send.
+class FairAclScheduler final : public AclScheduler {
+ public:
+  FairAclScheduler() = default;
+
+  // AclScheduler overrides:
+  void AddLink(WeakPtr<ConnectionInterface> connection) override;
+  void RemoveLink(hci_spec::ConnectionHandle handle) override;
+  bool HasLink(hci_spec::ConnectionHandle handle) const override;
+  ConnectionInterface* NextLink(size_t buffer_capacity) override;
+  void OnPacketSent(hci_spec::ConnectionHandle handle, size_t size) override;
+  void OnPacketsCompleted(hci_spec::ConnectionHandle handle,
+                          size_t count) override;
+
+ private:
+  struct Link {
+    WeakPtr<ConnectionInterface> connection;
+    hci_spec::ConnectionHandle handle;
+    // The virtual time, in bytes, at which the last packet of the link
+    // finished.
+    uint64_t finish_time = 0;
+    // Number of packets of the link in the controller's buffer.
+    size_t in_flight = 0;
+  };
+
+  // Returns the index of the link with |handle| in |links_|, or
+  // |links_.size()| if there is none.
+  size_t FindLink(hci_spec::ConnectionHandle handle) const;
+
+  // Controllers support few simultaneous links, so a linear search of a dense
+  // array is faster than a hash map lookup.
+  std::vector<Link> links_;
+
+  // Index in |links_| of the link after the one that sent the last packet,
+  // where the next round-robin scan starts.
+  size_t next_link_ = 0;
+
+  // The virtual start time of the last packet sent. Links that were idle
+  // resume from here rather than from their own finish time.
+  uint64_t virtual_time_ = 0;
+};
+
+}  // namespace bt::hci
@@ -65,6 +65,14 @@ class FakeAclConnection : public AclDataChannel::ConnectionInterface {
 
   bool HasAvailablePacket() const override { return !queued_packets_.empty(); }
 
+  AclDataChannel::PacketPriority NextPacketPriority() const override {
+    return priority_;
+  }
+
+  void set_priority(AclDataChannel::PacketPriority priority) {
+    priority_ = priority;
+  }
+
   void set_get_next_outbound_packet_callback(fit::function<void()> callback) {
     get_next_outbound_packet_cb_ = std::move(callback);
   }
@@ -74,6 +82,8 @@ class FakeAclConnection : public AclDataChannel::ConnectionInterface {
   bt::LinkType type_;
   AclDataChannel* data_channel_;
   fit::function<void()> get_next_outbound_packet_cb_ = nullptr;
+  AclDataChannel::PacketPriority priority_ =
+      AclDataChannel::PacketPriority::kLow;
   std::queue<ACLDataPacketPtr> queued_packets_;
   WeakSelf<ConnectionInterface> weak_interface_;
 };
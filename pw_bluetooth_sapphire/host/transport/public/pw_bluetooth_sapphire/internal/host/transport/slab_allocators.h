@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "pw_bluetooth_sapphire/internal/host/common/macros.h"
+#include "pw_bluetooth_sapphire/internal/host/common/slab_pool.h"
 #include "pw_bluetooth_sapphire/internal/host/hci-spec/constants.h"
 #include "pw_bluetooth_sapphire/internal/host/hci-spec/protocol.h"
 #include "pw_bluetooth_sapphire/internal/host/transport/packet.h"
@@ -74,6 +75,19 @@ inline constexpr size_t kMaxScoDataPacketSize =
 inline constexpr size_t kNumMaxScoDataPackets =
     kMaxScoSlabSize / kMaxScoDataPacketSize;
 
+// Usage of the pools backing ACLDataPacket::New(), by size class. Each pool
+// holds one slab's worth of packets; packets beyond that are allocated by the
+// system allocator.
+struct ACLDataPacketPoolMetrics {
+  SlabPoolMetrics small;
+  SlabPoolMetrics medium;
+  SlabPoolMetrics large;
+};
+ACLDataPacketPoolMetrics GetACLDataPacketPoolMetrics();
+
+// Usage of the pool backing ScoDataPacket::New().
+SlabPoolMetrics GetScoDataPacketPoolMetrics();
+
 namespace internal {
 
 template <size_t BufferSize>
@@ -84,10 +98,14 @@ class FixedSizePacketStorage {
 
 // A FixedSizePacket provides fixed-size buffer storage for Packets and is the
 // basis for a slab-allocated Packet. Multiple inheritance is required to
-// initialize the underlying buffer before PacketBase.
-template <typename HeaderType, size_t BufferSize>
-class FixedSizePacket : public FixedSizePacketStorage<BufferSize>,
-                        public Packet<HeaderType> {
+// initialize the underlying buffer before PacketBase. Up to |NumPooled|
+// packets are allocated from a pool whose storage is reserved on first use.
+template <typename HeaderType, size_t BufferSize, size_t NumPooled>
+class FixedSizePacket
+    : public FixedSizePacketStorage<BufferSize>,
+      public Packet<HeaderType>,
+      public SlabAllocated<FixedSizePacket<HeaderType, BufferSize, NumPooled>,
+                           NumPooled> {
  public:
   explicit FixedSizePacket(size_t payload_size = 0u)
       : Packet<HeaderType>(
@@ -25,7 +25,16 @@ namespace bt::hci {
 // interface to the buffer.
 using MaxScoDataPacket =
     allocators::internal::FixedSizePacket<hci_spec::SynchronousDataHeader,
-                                          allocators::kMaxScoDataPacketSize>;
+                                          allocators::kMaxScoDataPacketSize,
+                                          allocators::kNumMaxScoDataPackets>;
+
+namespace allocators {
+
+SlabPoolMetrics GetScoDataPacketPoolMetrics() {
+  return MaxScoDataPacket::slab_pool_metrics();
+}
+
+}  // namespace allocators
 
 std::unique_ptr<ScoDataPacket> ScoDataPacket::New(uint8_t payload_size) {
   return std::make_unique<MaxScoDataPacket>(payload_size);
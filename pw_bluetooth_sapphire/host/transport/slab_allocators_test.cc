@@ -19,6 +19,7 @@
 
 #include "pw_bluetooth_sapphire/internal/host/transport/acl_data_packet.h"
 #include "pw_bluetooth_sapphire/internal/host/transport/control_packets.h"
+#include "pw_bluetooth_sapphire/internal/host/transport/sco_data_packet.h"
 #include "pw_unit_test/framework.h"
 
 namespace bt::hci::allocators {
@@ -95,5 +96,52 @@ TEST(SlabAllocatorsTest, LargeACLDataPacketFallback) {
   packet->mutable_view()->mutable_data().Fill('m');
 }
 
+TEST(SlabAllocatorsTest, ACLDataPacketPoolMetrics) {
+  const ACLDataPacketPoolMetrics before = GetACLDataPacketPoolMetrics();
+
+  auto small = ACLDataPacket::New(kSmallACLDataPayloadSize);
+  auto medium = ACLDataPacket::New(kMediumACLDataPayloadSize);
+  auto large = ACLDataPacket::New(kLargeACLDataPayloadSize);
+  ACLDataPacketPoolMetrics metrics = GetACLDataPacketPoolMetrics();
+  EXPECT_EQ(before.small.in_use + 1, metrics.small.in_use);
+  EXPECT_EQ(before.medium.in_use + 1, metrics.medium.in_use);
+  EXPECT_EQ(before.large.in_use + 1, metrics.large.in_use);
+  EXPECT_EQ(before.small.pool_allocations + 1, metrics.small.pool_allocations);
+
+  small = nullptr;
+  medium = nullptr;
+  large = nullptr;
+  metrics = GetACLDataPacketPoolMetrics();
+  EXPECT_EQ(before.small.in_use, metrics.small.in_use);
+  EXPECT_EQ(before.medium.in_use, metrics.medium.in_use);
+  EXPECT_EQ(before.large.in_use, metrics.large.in_use);
+}
+
+TEST(SlabAllocatorsTest, ACLDataPacketPoolExhaustionIsCounted) {
+  const ACLDataPacketPoolMetrics before = GetACLDataPacketPoolMetrics();
+  std::list<hci::ACLDataPacketPtr> packets;
+  for (size_t i = before.large.in_use; i <= kNumLargeACLDataPackets; i++) {
+    packets.push_front(ACLDataPacket::New(kLargeACLDataPayloadSize));
+  }
+
+  ACLDataPacketPoolMetrics metrics = GetACLDataPacketPoolMetrics();
+  EXPECT_EQ(kNumLargeACLDataPackets, metrics.large.in_use);
+  EXPECT_EQ(kNumLargeACLDataPackets, metrics.large.peak_in_use);
+  EXPECT_EQ(before.large.fallback_allocations + 1,
+            metrics.large.fallback_allocations);
+
+  // Releasing a fallback-allocated packet does not touch the pool.
+  packets.clear();
+  EXPECT_EQ(before.large.in_use, GetACLDataPacketPoolMetrics().large.in_use);
+}
+
+TEST(SlabAllocatorsTest, ScoDataPacketPoolMetrics) {
+  const SlabPoolMetrics before = GetScoDataPacketPoolMetrics();
+  auto packet = ScoDataPacket::New(/*payload_size=*/10);
+  EXPECT_EQ(before.in_use + 1, GetScoDataPacketPoolMetrics().in_use);
+  packet = nullptr;
+  EXPECT_EQ(before.in_use, GetScoDataPacketPoolMetrics().in_use);
+}
+
 }  // namespace
 }  // namespace bt::hci::allocators
@@ -0,0 +1,145 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/dynamic_hash_map.h"
+
+#include "pw_allocator/fault_injecting_allocator.h"
+#include "pw_allocator/testing.h"
+#include "pw_containers/internal/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using pw::DynamicHashMap;
+using pw::containers::test::Counter;
+
+class DynamicHashMapTest : public ::testing::Test {
+ protected:
+  DynamicHashMapTest() : allocator_(allocator_for_test_) {}
+
+  pw::allocator::test::AllocatorForTest<4096> allocator_for_test_;
+  pw::allocator::test::FaultInjectingAllocator allocator_;
+};
+
+TEST_F(DynamicHashMapTest, Constructor_DoesNotAllocate) {
+  DynamicHashMap<int, int> map(allocator_);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.capacity(), 0u);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(allocator_for_test_.metrics().num_allocations.value(), 0u);
+}
+
+TEST_F(DynamicHashMapTest, Insert_Grows) {
+  DynamicHashMap<int, int> map(allocator_);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(map.try_emplace(i, i * 3).second);
+  }
+  EXPECT_EQ(map.size(), 100u);
+  EXPECT_GE(map.capacity(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(map.at(i), i * 3);
+  }
+}
+
+TEST_F(DynamicHashMapTest, Reserve_AvoidsReallocation) {
+  DynamicHashMap<int, int> map(allocator_);
+  map.reserve(50);
+  EXPECT_GE(map.capacity(), 50u);
+  size_t num_allocations =
+      allocator_for_test_.metrics().num_allocations.value();
+  for (int i = 0; i < 50; ++i) {
+    map[i] = i;
+  }
+  EXPECT_EQ(allocator_for_test_.metrics().num_allocations.value(),
+            num_allocations);
+}
+
+TEST_F(DynamicHashMapTest, TryReserve_FailsWithoutAllocator) {
+  DynamicHashMap<int, int> map(allocator_);
+  map[1] = 1;
+  size_t capacity = map.capacity();
+  allocator_.DisableAll();
+  EXPECT_FALSE(map.try_reserve(100));
+  EXPECT_EQ(map.capacity(), capacity);
+  EXPECT_EQ(map.at(1), 1);
+  allocator_.EnableAll();
+}
+
+TEST_F(DynamicHashMapTest, Churn_DoesNotKeepGrowing) {
+  DynamicHashMap<int, int> map(allocator_);
+  for (int i = 0; i < 20; ++i) {
+    map[i] = i;
+  }
+  // The table may grow once if too few of its slots are tombstones to be
+  // worth reclaiming, but must then reach a steady state.
+  for (int i = 20; i < 200; ++i) {
+    ASSERT_EQ(map.erase(i - 20), 1u);
+    map[i] = i;
+  }
+  size_t bucket_count = map.bucket_count();
+  for (int i = 200; i < 2000; ++i) {
+    ASSERT_EQ(map.erase(i - 20), 1u);
+    map[i] = i;
+  }
+  EXPECT_EQ(map.bucket_count(), bucket_count);
+  for (int i = 1980; i < 2000; ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+}
+
+TEST_F(DynamicHashMapTest, Move_TransfersStorage) {
+  DynamicHashMap<int, Counter> map(allocator_);
+  map.try_emplace(1, 10);
+  map.try_emplace(2, 20);
+
+  DynamicHashMap<int, Counter> moved(std::move(map));
+  EXPECT_EQ(moved.size(), 2u);
+  EXPECT_EQ(moved.at(2), 20);
+  EXPECT_TRUE(map.empty());  // NOLINT(bugprone-use-after-move)
+
+  DynamicHashMap<int, Counter> assigned(allocator_);
+  assigned.try_emplace(3, 30);
+  assigned = std::move(moved);
+  EXPECT_EQ(assigned.size(), 2u);
+  EXPECT_FALSE(assigned.contains(3));
+}
+
+TEST_F(DynamicHashMapTest, Destructor_FreesMemory) {
+  Counter::Reset();
+  {
+    DynamicHashMap<int, Counter> map(allocator_);
+    for (int i = 0; i < 32; ++i) {
+      map.try_emplace(i, i);
+    }
+    map.erase(3);
+  }
+  EXPECT_EQ(Counter::created + Counter::moved, Counter::destroyed);
+  EXPECT_EQ(allocator_for_test_.metrics().num_allocations.value(),
+            allocator_for_test_.metrics().num_deallocations.value());
+}
+
+TEST_F(DynamicHashMapTest, ShrinkToFit_FreesEmptyMap) {
+  DynamicHashMap<int, int> map(allocator_);
+  map[1] = 1;
+  map.erase(1);
+  map.shrink_to_fit();
+  EXPECT_EQ(map.capacity(), 0u);
+  EXPECT_EQ(allocator_for_test_.metrics().num_allocations.value(),
+            allocator_for_test_.metrics().num_deallocations.value());
+  map[2] = 2;
+  EXPECT_EQ(map.at(2), 2);
+}
+
+}  // namespace
@@ -0,0 +1,182 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_containers/flat_map.h"
+#include "pw_containers/inline_hash_map.h"
+#include "pw_containers/intrusive_map.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::containers {
+namespace {
+
+// Compares lookups and insertions in `pw::InlineHashMap` with the sorted-array
+// `pw::containers::FlatMap` and the AA-tree `pw::IntrusiveMap`.
+
+/// Returns a key for the given index. Keys are scattered so that neither the
+/// trees nor the hash table see them in order.
+constexpr uint32_t KeyAt(size_t index) {
+  return static_cast<uint32_t>(index + 1) * 2654435761u;
+}
+
+template <size_t kSize>
+constexpr std::array<uint32_t, kSize> MakeKeys() {
+  std::array<uint32_t, kSize> keys{};
+  for (size_t i = 0; i < kSize; ++i) {
+    keys[i] = KeyAt(i);
+  }
+  return keys;
+}
+
+class MapItem : public IntrusiveMap<uint32_t, MapItem>::Pair {
+ public:
+  constexpr explicit MapItem(uint32_t key)
+      : IntrusiveMap<uint32_t, MapItem>::Pair(key), value(key) {}
+  uint32_t value;
+};
+
+template <size_t... kIndices>
+std::array<MapItem, sizeof...(kIndices)> MakeItems(
+    std::index_sequence<kIndices...>) {
+  return {MapItem(KeyAt(kIndices))...};
+}
+
+template <size_t kSize, size_t... kIndices>
+constexpr FlatMap<uint32_t, uint32_t, kSize> MakeFlatMap(
+    std::index_sequence<kIndices...>) {
+  return FlatMap<uint32_t, uint32_t, kSize>(
+      std::array<Pair<uint32_t, uint32_t>, kSize>{
+          Pair<uint32_t, uint32_t>{KeyAt(kIndices), KeyAt(kIndices)}...});
+}
+
+// Lookups
+
+template <size_t kSize>
+void FlatMapFind(perf_test::State& state) {
+  static constexpr auto kKeys = MakeKeys<kSize>();
+  static constexpr auto kMap =
+      MakeFlatMap<kSize>(std::make_index_sequence<kSize>());
+  uint32_t sum = 0;
+  while (state.KeepRunning()) {
+    for (uint32_t key : kKeys) {
+      sum += kMap.find(key)->second;
+    }
+  }
+  PW_ASSERT(sum != 1);
+}
+
+template <size_t kSize>
+void IntrusiveMapFind(perf_test::State& state) {
+  static constexpr auto kKeys = MakeKeys<kSize>();
+  auto items = MakeItems(std::make_index_sequence<kSize>());
+  IntrusiveMap<uint32_t, MapItem> map(items.begin(), items.end());
+  uint32_t sum = 0;
+  while (state.KeepRunning()) {
+    for (uint32_t key : kKeys) {
+      sum += map.find(key)->value;
+    }
+  }
+  PW_ASSERT(sum != 1);
+  map.clear();
+}
+
+template <size_t kSize>
+void InlineHashMapFind(perf_test::State& state) {
+  static constexpr auto kKeys = MakeKeys<kSize>();
+  InlineHashMap<uint32_t, uint32_t, kSize> map;
+  for (uint32_t key : kKeys) {
+    map[key] = key;
+  }
+  uint32_t sum = 0;
+  while (state.KeepRunning()) {
+    for (uint32_t key : kKeys) {
+      sum += map.find(key)->second;
+    }
+  }
+  PW_ASSERT(sum != 1);
+}
+
+template <size_t kSize>
+void InlineHashMapFindMissing(perf_test::State& state) {
+  static constexpr auto kKeys = MakeKeys<kSize>();
+  InlineHashMap<uint32_t, uint32_t, kSize> map;
+  for (uint32_t key : kKeys) {
+    map[key] = key;
+  }
+  size_t found = 0;
+  while (state.KeepRunning()) {
+    for (uint32_t key : kKeys) {
+      found += map.count(key + 1);
+    }
+  }
+  PW_ASSERT(found == 0);
+}
+
+// Insertions
+
+template <size_t kSize>
+void IntrusiveMapInsertAndClear(perf_test::State& state) {
+  auto items = MakeItems(std::make_index_sequence<kSize>());
+  IntrusiveMap<uint32_t, MapItem> map;
+  while (state.KeepRunning()) {
+    for (MapItem& item : items) {
+      map.insert(item);
+    }
+    map.clear();
+  }
+}
+
+template <size_t kSize>
+void InlineHashMapInsertAndClear(perf_test::State& state) {
+  static constexpr auto kKeys = MakeKeys<kSize>();
+  InlineHashMap<uint32_t, uint32_t, kSize> map;
+  while (state.KeepRunning()) {
+    for (uint32_t key : kKeys) {
+      map.try_emplace(key, key);
+    }
+    map.clear();
+  }
+}
+
+PW_PERF_TEST(FlatMapFind8, FlatMapFind<8>);
+PW_PERF_TEST(FlatMapFind32, FlatMapFind<32>);
+PW_PERF_TEST(FlatMapFind128, FlatMapFind<128>);
+
+PW_PERF_TEST(IntrusiveMapFind8, IntrusiveMapFind<8>);
+PW_PERF_TEST(IntrusiveMapFind32, IntrusiveMapFind<32>);
+PW_PERF_TEST(IntrusiveMapFind128, IntrusiveMapFind<128>);
+
+PW_PERF_TEST(InlineHashMapFind8, InlineHashMapFind<8>);
+PW_PERF_TEST(InlineHashMapFind32, InlineHashMapFind<32>);
+PW_PERF_TEST(InlineHashMapFind128, InlineHashMapFind<128>);
+
+PW_PERF_TEST(InlineHashMapFindMissing8, InlineHashMapFindMissing<8>);
+PW_PERF_TEST(InlineHashMapFindMissing32, InlineHashMapFindMissing<32>);
+PW_PERF_TEST(InlineHashMapFindMissing128, InlineHashMapFindMissing<128>);
+
+PW_PERF_TEST(IntrusiveMapInsertAndClear8, IntrusiveMapInsertAndClear<8>);
+PW_PERF_TEST(IntrusiveMapInsertAndClear32, IntrusiveMapInsertAndClear<32>);
+PW_PERF_TEST(IntrusiveMapInsertAndClear128, IntrusiveMapInsertAndClear<128>);
+
+PW_PERF_TEST(InlineHashMapInsertAndClear8, InlineHashMapInsertAndClear<8>);
+PW_PERF_TEST(InlineHashMapInsertAndClear32, InlineHashMapInsertAndClear<32>);
+PW_PERF_TEST(InlineHashMapInsertAndClear128, InlineHashMapInsertAndClear<128>);
+
+}  // namespace
+}  // namespace pw::containers
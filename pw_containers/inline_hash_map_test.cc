@@ -0,0 +1,254 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/inline_hash_map.h"
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "pw_containers/internal/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using pw::InlineHashMap;
+using pw::containers::test::Counter;
+using pw::containers::test::MoveOnly;
+
+// Hash that sends every key to the same probe sequence, to exercise
+// collisions.
+struct CollidingHash {
+  size_t operator()(int) const { return 42; }
+};
+
+TEST(InlineHashMapTest, Constructor_Empty) {
+  InlineHashMap<int, int, 8> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0u);
+  EXPECT_EQ(map.capacity(), 8u);
+  EXPECT_GT(map.bucket_count(), 8u);
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(InlineHashMapTest, Constructor_InitializerList) {
+  InlineHashMap<int, char, 4> map = {{1, 'a'}, {2, 'b'}, {3, 'c'}};
+  EXPECT_EQ(map.size(), 3u);
+  EXPECT_EQ(map.at(1), 'a');
+  EXPECT_EQ(map.at(2), 'b');
+  EXPECT_EQ(map.at(3), 'c');
+}
+
+TEST(InlineHashMapTest, Constructor_Copy) {
+  InlineHashMap<int, Counter, 4> map = {{1, 10}, {2, 20}};
+  InlineHashMap<int, Counter, 4> copy(map);
+  EXPECT_EQ(copy.size(), 2u);
+  EXPECT_EQ(copy.at(1), 10);
+  EXPECT_EQ(copy.at(2), 20);
+
+  InlineHashMap<int, Counter, 4> other = {{3, 30}};
+  other = map;
+  EXPECT_EQ(other.size(), 2u);
+  EXPECT_FALSE(other.contains(3));
+  EXPECT_EQ(other.at(2), 20);
+}
+
+TEST(InlineHashMapTest, Insert_NewAndExistingKeys) {
+  InlineHashMap<int, int, 4> map;
+  auto [it, inserted] = map.insert({1, 100});
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(it->first, 1);
+  EXPECT_EQ(it->second, 100);
+
+  std::tie(it, inserted) = map.insert({1, 200});
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(it->second, 100);
+  EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(InlineHashMapTest, Insert_RvalueMovesValueButNotKey) {
+  InlineHashMap<int, MoveOnly, 4> map;
+  std::pair<const int, MoveOnly> value(1, MoveOnly(5));
+  EXPECT_TRUE(map.insert(std::move(value)).second);
+  EXPECT_EQ(map.at(1).value, 5);
+  EXPECT_EQ(value.first, 1);
+  EXPECT_EQ(value.second.value, MoveOnly::kDeleted);
+}
+
+TEST(InlineHashMapTest, InsertOrAssign) {
+  InlineHashMap<int, int, 4> map;
+  EXPECT_TRUE(map.insert_or_assign(1, 100).second);
+  EXPECT_FALSE(map.insert_or_assign(1, 200).second);
+  EXPECT_EQ(map.at(1), 200);
+}
+
+TEST(InlineHashMapTest, TryEmplace_DoesNotMoveIfPresent) {
+  InlineHashMap<int, MoveOnly, 4> map;
+  EXPECT_TRUE(map.try_emplace(1, MoveOnly(5)).second);
+
+  MoveOnly value(6);
+  EXPECT_FALSE(map.try_emplace(1, std::move(value)).second);
+  EXPECT_EQ(value.value, 6);
+  EXPECT_EQ(map.at(1).value, 5);
+}
+
+TEST(InlineHashMapTest, Emplace) {
+  InlineHashMap<int, Counter, 4> map;
+  EXPECT_TRUE(map.emplace(1, 11).second);
+  EXPECT_FALSE(map.emplace(1, 12).second);
+  EXPECT_EQ(map.at(1), 11);
+}
+
+TEST(InlineHashMapTest, IndexOperator_InsertsDefault) {
+  InlineHashMap<std::string_view, int, 4> map;
+  map["one"] = 1;
+  map["two"] += 2;
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map["one"], 1);
+  EXPECT_EQ(map["two"], 2);
+  EXPECT_EQ(map["three"], 0);
+  EXPECT_EQ(map.size(), 3u);
+}
+
+TEST(InlineHashMapTest, Find) {
+  InlineHashMap<int, int, 8> map = {{1, 10}, {2, 20}, {3, 30}};
+  auto it = map.find(2);
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ(it->second, 20);
+  EXPECT_EQ(map.find(4), map.end());
+
+  const auto& const_map = map;
+  EXPECT_NE(const_map.find(3), const_map.end());
+  EXPECT_EQ(const_map.count(3), 1u);
+  EXPECT_EQ(const_map.count(4), 0u);
+}
+
+TEST(InlineHashMapTest, Iterate_VisitsEachValueOnce) {
+  InlineHashMap<int, int, 32> map;
+  for (int i = 0; i < 32; ++i) {
+    map[i] = i * 2;
+  }
+  uint32_t seen = 0;
+  size_t count = 0;
+  for (const auto& [key, value] : map) {
+    EXPECT_EQ(value, key * 2);
+    EXPECT_EQ(seen & (1u << key), 0u);
+    seen |= 1u << key;
+    ++count;
+  }
+  EXPECT_EQ(count, 32u);
+  EXPECT_EQ(seen, 0xFFFFFFFFu);
+}
+
+TEST(InlineHashMapTest, Erase_ByKey) {
+  InlineHashMap<int, int, 4> map = {{1, 10}, {2, 20}};
+  EXPECT_EQ(map.erase(1), 1u);
+  EXPECT_EQ(map.erase(1), 0u);
+  EXPECT_EQ(map.size(), 1u);
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_TRUE(map.contains(2));
+}
+
+TEST(InlineHashMapTest, Erase_ByIterator) {
+  InlineHashMap<int, int, 16> map;
+  for (int i = 0; i < 16; ++i) {
+    map[i] = i;
+  }
+  for (auto it = map.begin(); it != map.end();) {
+    if (it->first % 2 == 0) {
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(map.size(), 8u);
+  for (const auto& [key, value] : map) {
+    EXPECT_EQ(key % 2, 1);
+  }
+}
+
+TEST(InlineHashMapTest, Full) {
+  InlineHashMap<int, int, 3> map;
+  map[1] = 1;
+  map[2] = 2;
+  EXPECT_FALSE(map.full());
+  map[3] = 3;
+  EXPECT_TRUE(map.full());
+
+  // Existing keys can still be updated.
+  map[3] = 4;
+  EXPECT_EQ(map.at(3), 4);
+}
+
+TEST(InlineHashMapTest, Churn_ReusesDeletedSlots) {
+  InlineHashMap<int, int, 20> map;
+  for (int i = 0; i < 20; ++i) {
+    map[i] = i;
+  }
+  // Repeatedly replace keys. Without reclaiming tombstones, the table would
+  // run out of slots.
+  for (int i = 20; i < 2000; ++i) {
+    ASSERT_EQ(map.erase(i - 20), 1u);
+    map[i] = i;
+    ASSERT_EQ(map.size(), 20u);
+  }
+  for (int i = 1980; i < 2000; ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+}
+
+TEST(InlineHashMapTest, Churn_WithCollisions) {
+  InlineHashMap<int, int, 24, CollidingHash> map;
+  for (int i = 0; i < 24; ++i) {
+    map[i] = i;
+  }
+  for (int i = 24; i < 500; ++i) {
+    ASSERT_EQ(map.erase(i - 24), 1u);
+    map[i] = i;
+  }
+  for (int i = 476; i < 500; ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+  EXPECT_FALSE(map.contains(0));
+}
+
+TEST(InlineHashMapTest, Clear_DestroysValues) {
+  Counter::Reset();
+  {
+    InlineHashMap<int, Counter, 8> map;
+    for (int i = 0; i < 8; ++i) {
+      map.try_emplace(i, i);
+    }
+    EXPECT_EQ(Counter::created, 8);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(Counter::destroyed, 8);
+    map.try_emplace(1, 1);
+  }
+  EXPECT_EQ(Counter::created, Counter::destroyed);
+}
+
+TEST(InlineHashMapTest, Destructor_DestroysValues) {
+  Counter::Reset();
+  {
+    InlineHashMap<int, Counter, 40> map;
+    for (int i = 0; i < 200; ++i) {
+      map.erase(i - 40);
+      map.try_emplace(i, i);
+    }
+  }
+  EXPECT_EQ(Counter::created + Counter::moved, Counter::destroyed);
+}
+
+}  // namespace
@@ -0,0 +1,140 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/intrusive_hash_set.h"
+
+#include <array>
+#include <cstddef>
+
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+// Test fixtures.
+
+struct TestItemHash;
+
+class TestItem
+    : public pw::IntrusiveHashSet<TestItem, 8, TestItemHash>::Item {
+ public:
+  constexpr explicit TestItem(int key = 0) : key_(key) {}
+
+  int key() const { return key_; }
+
+  bool operator==(const TestItem& rhs) const { return key_ == rhs.key_; }
+
+ private:
+  int key_;
+};
+
+struct TestItemHash {
+  size_t operator()(const TestItem& item) const {
+    return static_cast<size_t>(item.key());
+  }
+};
+
+using TestSet = pw::IntrusiveHashSet<TestItem, 8, TestItemHash>;
+
+class IntrusiveHashSetTest : public ::testing::Test {
+ protected:
+  void TearDown() override { set_.clear(); }
+
+  // Items must be declared before the set, so that they outlive it.
+  std::array<TestItem, 8> items_ = {
+      TestItem(0),
+      TestItem(10),
+      TestItem(20),
+      TestItem(30),
+      TestItem(40),
+      TestItem(50),
+      TestItem(60),
+      TestItem(70),
+  };
+  TestSet set_;
+};
+
+// Unit tests.
+
+TEST_F(IntrusiveHashSetTest, Construct_Empty) {
+  EXPECT_TRUE(set_.empty());
+  EXPECT_EQ(set_.size(), 0u);
+  EXPECT_EQ(set_.begin(), set_.end());
+}
+
+TEST_F(IntrusiveHashSetTest, Construct_InitializerList) {
+  TestSet set({&items_[0], &items_[2]});
+  EXPECT_EQ(set.size(), 2u);
+  EXPECT_TRUE(set.contains(items_[0]));
+  EXPECT_FALSE(set.contains(items_[1]));
+  set.clear();
+}
+
+TEST_F(IntrusiveHashSetTest, Insert_FindsItem) {
+  for (auto& item : items_) {
+    EXPECT_TRUE(set_.insert(item).second);
+  }
+  EXPECT_TRUE(set_.full());
+  for (auto& item : items_) {
+    auto it = set_.find(TestItem(item.key()));
+    ASSERT_NE(it, set_.end());
+    EXPECT_EQ(&(*it), &item);
+  }
+  EXPECT_EQ(set_.find(TestItem(5)), set_.end());
+}
+
+TEST_F(IntrusiveHashSetTest, Insert_DuplicateKey) {
+  TestItem duplicate(items_[3].key());
+  set_.insert(items_[3]);
+  auto [it, inserted] = set_.insert(duplicate);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(&(*it), &items_[3]);
+  EXPECT_EQ(set_.size(), 1u);
+}
+
+TEST_F(IntrusiveHashSetTest, Iterate_VisitsEachItem) {
+  set_.insert(items_.begin(), items_.end());
+  int sum = 0;
+  for (const TestItem& item : set_) {
+    sum += item.key();
+  }
+  EXPECT_EQ(sum, 280);
+}
+
+TEST_F(IntrusiveHashSetTest, Erase_ByKeyAndIterator) {
+  set_.insert(items_.begin(), items_.end());
+  EXPECT_EQ(set_.erase(items_[1]), 1u);
+  EXPECT_EQ(set_.erase(items_[1]), 0u);
+
+  auto it = set_.find(items_[2]);
+  set_.erase(it);
+  EXPECT_EQ(set_.size(), 6u);
+  EXPECT_FALSE(set_.contains(items_[2]));
+
+  // Erased items may be added to another set.
+  TestSet other;
+  EXPECT_TRUE(other.insert(items_[1]).second);
+  other.clear();
+}
+
+TEST_F(IntrusiveHashSetTest, Churn_ReusesDeletedSlots) {
+  set_.insert(items_.begin(), items_.end());
+  for (int i = 0; i < 500; ++i) {
+    TestItem& item = items_[static_cast<size_t>(i) % items_.size()];
+    ASSERT_EQ(set_.erase(item), 1u);
+    ASSERT_TRUE(set_.insert(item).second);
+  }
+  EXPECT_EQ(set_.size(), 8u);
+}
+
+}  // namespace
@@ -44,3 +44,14 @@
 #ifndef PW_CONTAINERS_USE_LEGACY_INTRUSIVE_LIST
 #define PW_CONTAINERS_USE_LEGACY_INTRUSIVE_LIST 1
 #endif  // PW_CONTAINERS_USE_LEGACY_INTRUSIVE_LIST
+
+// Controls whether the hash tables used by `pw::InlineHashMap`,
+// `pw::DynamicHashMap`, and `pw::IntrusiveHashSet` probe control bytes using
+// SIMD instructions when the target supports them.
+//
+// Currently, SSE2 is used when available, which compares 16 control bytes at a
+// time. If disabled or unsupported, a portable implementation compares 8
+// control bytes at a time using 64-bit arithmetic.
+#ifndef PW_CONTAINERS_HASH_TABLE_USE_SIMD
+#define PW_CONTAINERS_HASH_TABLE_USE_SIMD 1
+#endif  // PW_CONTAINERS_HASH_TABLE_USE_SIMD
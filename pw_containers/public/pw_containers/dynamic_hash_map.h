@@ -0,0 +1,176 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <utility>
+
+#include "pw_allocator/allocator.h"
+#include "pw_assert/assert.h"
+#include "pw_containers/internal/generic_hash_map.h"
+#include "pw_containers/internal/hash_table.h"
+
+namespace pw {
+
+/// Unordered map similar to `std::unordered_map`, backed by a `pw::Allocator`.
+///
+/// Key features of `pw::DynamicHashMap`:
+///
+/// - Stores values in an open-addressing "Swiss table" held in a single
+///   allocation, together with one control byte per slot.
+/// - Lookups compare a group of 8 or 16 control bytes at once, using SIMD
+///   instructions when available, so most lookups compare at most one key.
+/// - Never allocates in the constructor. Grows geometrically when full, and
+///   reclaims erased slots in place instead of growing when possible.
+/// - Offers `reserve()`/`try_reserve()` to allocate up front. Operations that
+///   insert crash if allocation fails.
+///
+/// Keys must be copy-constructible, since values may be relocated within the
+/// table when it is cleaned up. `Hash` and `KeyEqual` must be stateless.
+template <typename Key,
+          typename Value,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class DynamicHashMap
+    : public containers::internal::GenericHashMap<
+          DynamicHashMap<Key, Value, Hash, KeyEqual>,
+          Key,
+          Value,
+          Hash,
+          KeyEqual> {
+ private:
+  using Base = containers::internal::GenericHashMap<DynamicHashMap,
+                                                    Key,
+                                                    Value,
+                                                    Hash,
+                                                    KeyEqual>;
+
+ public:
+  using typename Base::const_iterator;
+  using typename Base::iterator;
+  using typename Base::size_type;
+  using typename Base::value_type;
+  using allocator_type = Allocator;
+
+  /// Constructs an empty map. No memory is allocated.
+  constexpr explicit DynamicHashMap(Allocator& allocator)
+      : allocator_(&allocator) {}
+
+  DynamicHashMap(const DynamicHashMap&) = delete;
+  DynamicHashMap& operator=(const DynamicHashMap&) = delete;
+
+  /// Move construction/assignment is supported since it cannot fail.
+  DynamicHashMap(DynamicHashMap&& other)
+      : Base(std::move(other)), allocator_(other.allocator_) {}
+
+  DynamicHashMap& operator=(DynamicHashMap&& other) {
+    if (&other != this) {
+      Release();
+      Base::operator=(std::move(other));
+      allocator_ = other.allocator_;  // The other map keeps its allocator
+    }
+    return *this;
+  }
+
+  ~DynamicHashMap() { Release(); }
+
+  constexpr allocator_type& get_allocator() const { return *allocator_; }
+
+  // Capacity
+
+  /// Returns the number of values the map can hold without allocating.
+  size_type capacity() const {
+    return this->bucket_count() == 0
+               ? 0
+               : containers::internal::HashMaxLoad(this->bucket_count());
+  }
+
+  /// Attempts to allocate room for at least `count` values.
+  ///
+  /// @returns  false if allocation fails, in which case the map is unchanged.
+  [[nodiscard]] bool try_reserve(size_type count) {
+    return count <= capacity() ||
+           Rehash(containers::internal::HashSlotsFor(count));
+  }
+
+  /// Allocates room for at least `count` values. Crashes on failure.
+  void reserve(size_type count) { PW_ASSERT(try_reserve(count)); }
+
+  /// Frees the map's storage if it is empty.
+  void shrink_to_fit() {
+    if (this->empty()) {
+      Release();
+    }
+  }
+
+ private:
+  friend Base;
+
+  using HashCtrl = containers::internal::HashCtrl;
+
+  static constexpr allocator::Layout LayoutFor(size_t num_slots) {
+    return allocator::Layout(
+        sizeof(value_type) * num_slots +
+            containers::internal::HashCtrlBytes(num_slots),
+        alignof(value_type));
+  }
+
+  bool EnsureRoomForInsert() {
+    if (this->growth_left() != 0) {
+      return true;
+    }
+    size_t num_slots = this->bucket_count();
+    if (num_slots != 0 &&
+        this->size() <= containers::internal::HashMaxLoad(num_slots) / 2) {
+      // At least half of the used slots are tombstones. Reclaim them instead
+      // of growing.
+      this->DropDeletesWithoutResize();
+      return true;
+    }
+    size_t min_slots = containers::internal::HashSlotsFor(this->size() + 1);
+    return Rehash(std::max(num_slots * 2, min_slots));
+  }
+
+  bool Rehash(size_t num_slots) {
+    auto* buffer =
+        static_cast<std::byte*>(allocator_->Allocate(LayoutFor(num_slots)));
+    if (buffer == nullptr) {
+      return false;
+    }
+    HashCtrl* old_ctrl = this->ctrl();
+    value_type* old_slots = this->slots();
+    size_t old_num_slots = this->bucket_count();
+
+    this->Reset(
+        reinterpret_cast<HashCtrl*>(buffer + sizeof(value_type) * num_slots),
+        std::launder(reinterpret_cast<value_type*>(buffer)),
+        num_slots);
+    this->MoveFrom(old_ctrl, old_slots, old_num_slots);
+    allocator_->Deallocate(old_slots);
+    return true;
+  }
+
+  void Release() {
+    this->DestroyAll();
+    allocator_->Deallocate(this->slots());
+    this->Reset(nullptr, nullptr, 0);
+  }
+
+  Allocator* allocator_;
+};
+
+}  // namespace pw
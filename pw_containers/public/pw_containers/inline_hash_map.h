@@ -0,0 +1,133 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+
+#include "pw_containers/internal/generic_hash_map.h"
+#include "pw_containers/internal/hash_table.h"
+
+namespace pw {
+
+/// Unordered map with a fixed capacity, similar to `std::unordered_map`.
+///
+/// Key features of `pw::InlineHashMap`:
+///
+/// - Stores values inline in an open-addressing "Swiss table". Never
+///   allocates.
+/// - Lookups compare a group of 8 or 16 one-byte control values at once,
+///   using SIMD instructions when available, so most lookups compare at most
+///   one key.
+/// - Holds up to `kCapacity` values. The table reserves additional slots to
+///   keep probe sequences short.
+/// - Crashes if a value is inserted when the map is `full()`.
+///
+/// Keys must be copy-constructible, since values may be relocated within the
+/// table when it is cleaned up. `Hash` and `KeyEqual` must be stateless.
+template <typename Key,
+          typename Value,
+          size_t kCapacity,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class InlineHashMap
+    : public containers::internal::GenericHashMap<
+          InlineHashMap<Key, Value, kCapacity, Hash, KeyEqual>,
+          Key,
+          Value,
+          Hash,
+          KeyEqual> {
+ private:
+  using Base = containers::internal::GenericHashMap<InlineHashMap,
+                                                    Key,
+                                                    Value,
+                                                    Hash,
+                                                    KeyEqual>;
+
+ public:
+  using typename Base::const_iterator;
+  using typename Base::iterator;
+  using typename Base::size_type;
+  using typename Base::value_type;
+
+  static_assert(kCapacity > 0, "InlineHashMap must have a nonzero capacity");
+
+  /// Constructs an empty map.
+  InlineHashMap() { this->Reset(ctrl_.data(), slots(), kSlots); }
+
+  InlineHashMap(std::initializer_list<value_type> ilist) : InlineHashMap() {
+    this->insert(ilist);
+  }
+
+  template <typename InputIt>
+  InlineHashMap(InputIt first, InputIt last) : InlineHashMap() {
+    this->insert(first, last);
+  }
+
+  InlineHashMap(const InlineHashMap& other) : InlineHashMap() {
+    this->insert(other.begin(), other.end());
+  }
+
+  InlineHashMap& operator=(const InlineHashMap& other) {
+    if (&other != this) {
+      this->clear();
+      this->insert(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  // Values point into the object itself, so the map cannot be moved.
+  InlineHashMap(InlineHashMap&&) = delete;
+  InlineHashMap& operator=(InlineHashMap&&) = delete;
+
+  ~InlineHashMap() { this->DestroyAll(); }
+
+  // Capacity
+
+  /// Returns the maximum number of values the map can hold.
+  static constexpr size_type capacity() { return kCapacity; }
+  static constexpr size_type max_size() { return kCapacity; }
+
+  /// Returns whether inserting a new key would fail.
+  bool full() const { return this->size() >= kCapacity; }
+
+ private:
+  friend Base;
+
+  static constexpr size_t kSlots =
+      containers::internal::HashSlotsFor(kCapacity);
+
+  value_type* slots() {
+    return std::launder(reinterpret_cast<value_type*>(slots_));
+  }
+
+  bool EnsureRoomForInsert() {
+    if (full()) {
+      return false;
+    }
+    if (this->growth_left() == 0) {
+      this->DropDeletesWithoutResize();
+    }
+    return true;
+  }
+
+  std::array<containers::internal::HashCtrl,
+             containers::internal::HashCtrlBytes(kSlots)>
+      ctrl_;
+  alignas(value_type) std::byte slots_[sizeof(value_type) * kSlots];
+};
+
+}  // namespace pw
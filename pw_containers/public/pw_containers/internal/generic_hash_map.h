@@ -0,0 +1,221 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_containers/internal/hash_table.h"
+
+namespace pw::containers::internal {
+
+template <typename Key, typename Value>
+struct HashMapPolicy {
+  using key_type = Key;
+  using value_type = std::pair<const Key, Value>;
+
+  static const Key& GetKey(const value_type& value) { return value.first; }
+};
+
+/// Map operations shared by `pw::InlineHashMap` and `pw::DynamicHashMap`.
+///
+/// `Derived` must provide `bool EnsureRoomForInsert()`, which is called before
+/// inserting a key that is not already in the map. It should clean up or grow
+/// the table as needed and return whether a value can be inserted.
+template <typename Derived,
+          typename Key,
+          typename Value,
+          typename Hash,
+          typename KeyEqual>
+class GenericHashMap
+    : public HashTable<HashMapPolicy<Key, Value>, Hash, KeyEqual> {
+ private:
+  using Base = HashTable<HashMapPolicy<Key, Value>, Hash, KeyEqual>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = typename Base::value_type;
+  using size_type = typename Base::size_type;
+  using difference_type = typename Base::difference_type;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = typename Base::iterator;
+  using const_iterator = typename Base::const_iterator;
+
+  // Element access
+
+  /// Returns a reference to the value mapped to `key`.
+  ///
+  /// Crashes if the map does not contain `key`.
+  mapped_type& at(const key_type& key) {
+    iterator it = this->find(key);
+    PW_ASSERT(it != this->end());
+    return it->second;
+  }
+
+  const mapped_type& at(const key_type& key) const {
+    const_iterator it = this->find(key);
+    PW_ASSERT(it != this->end());
+    return it->second;
+  }
+
+  /// Returns a reference to the value mapped to `key`, inserting a
+  /// default-constructed value if the key is not present.
+  ///
+  /// Crashes if the key must be inserted and there is no room for it.
+  mapped_type& operator[](const key_type& key) {
+    return try_emplace(key).first->second;
+  }
+
+  mapped_type& operator[](key_type&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  // Modifiers
+
+  /// Removes all values from the map.
+  void clear() { this->DestroyAll(); }
+
+  /// Inserts a value if the map does not already contain its key.
+  ///
+  /// Crashes if the key must be inserted and there is no room for it.
+  ///
+  /// @returns  An iterator to the value with the key, and whether the value
+  ///           was inserted.
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return InsertUnique(value.first, value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return InsertUnique(value.first, std::move(value));
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  /// Inserts a value, or assigns to the existing value if the map already
+  /// contains the key.
+  ///
+  /// Crashes if the key must be inserted and there is no room for it.
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  /// Constructs a value in place if the map does not already contain the key
+  /// of the value constructed from `args`.
+  ///
+  /// Crashes if the key must be inserted and there is no room for it.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  /// Constructs a value in place from `args` if the map does not already
+  /// contain `key`. Unlike `emplace`, `args` are not used if the key is
+  /// present.
+  ///
+  /// Crashes if the key must be inserted and there is no room for it.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+    return TryEmplaceImpl(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return TryEmplaceImpl(std::move(key), std::forward<Args>(args)...);
+  }
+
+  /// Removes the value at `pos` and returns an iterator to the next value.
+  iterator erase(const_iterator pos) {
+    size_t index = this->IndexOf(pos);
+    this->EraseAt(index);
+    return this->IteratorAt(index, true);
+  }
+
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  /// Removes the value with the given key, if any.
+  ///
+  /// @returns  The number of values removed, which is 0 or 1.
+  size_type erase(const key_type& key) {
+    size_t index = this->FindIndex(key, this->HashOf(key));
+    if (index == Base::kNotFound) {
+      return 0;
+    }
+    this->EraseAt(index);
+    return 1;
+  }
+
+ protected:
+  constexpr GenericHashMap() = default;
+  GenericHashMap(GenericHashMap&&) = default;
+  GenericHashMap& operator=(GenericHashMap&&) = default;
+
+ private:
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplaceImpl(K&& key, Args&&... args) {
+    const key_type& lookup = key;
+    return InsertUnique(lookup,
+                        std::piecewise_construct,
+                        std::forward_as_tuple(std::forward<K>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  /// Constructs a value from `args` if the map does not already contain
+  /// `key`, which must be the key of the value that would be constructed.
+  template <typename... Args>
+  std::pair<iterator, bool> InsertUnique(const key_type& key, Args&&... args) {
+    size_t hash = this->HashOf(key);
+    size_t index = this->FindIndex(key, hash);
+    if (index != Base::kNotFound) {
+      return std::make_pair(this->IteratorAt(index), false);
+    }
+    PW_ASSERT(static_cast<Derived&>(*this).EnsureRoomForInsert());
+    index = this->PrepareInsert(hash);
+    new (&this->slots()[index]) value_type(std::forward<Args>(args)...);
+    return std::make_pair(this->IteratorAt(index), true);
+  }
+};
+
+}  // namespace pw::containers::internal
@@ -0,0 +1,601 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_containers/config.h"
+
+#if PW_CONTAINERS_HASH_TABLE_USE_SIMD && defined(__SSE2__)
+#include <emmintrin.h>
+#define PW_CONTAINERS_HASH_TABLE_SSE2 1
+#else
+#define PW_CONTAINERS_HASH_TABLE_SSE2 0
+#endif
+
+namespace pw::containers::internal {
+
+// Open-addressing hash table engine shared by `pw::InlineHashMap`,
+// `pw::DynamicHashMap`, and `pw::IntrusiveHashSet`.
+//
+// The table follows the "Swiss table" design. Each slot has a one-byte control
+// value that is either empty, deleted (a tombstone), or full. Full control
+// bytes hold the low 7 bits of the slot's hash ("H2"), while the remaining bits
+// ("H1") select where probing starts. Lookups compare H2 against a whole group
+// of control bytes at once, and only compare keys for slots whose H2 matches.
+//
+// Groups are 16 bytes wide and compared using SSE2 instructions when
+// available, or 8 bytes wide and compared using 64-bit arithmetic otherwise.
+//
+// The control array has `capacity + kWidth` bytes. The first `kWidth` control
+// bytes are mirrored after the last slot, so that a group may be loaded
+// starting at any slot without wrapping. If the capacity is smaller than a
+// group, the bytes past the mirrored ones are sentinels that never match.
+
+using HashCtrl = int8_t;
+
+inline constexpr HashCtrl kHashCtrlEmpty = -128;   // 0b10000000
+inline constexpr HashCtrl kHashCtrlDeleted = -2;   // 0b11111110
+inline constexpr HashCtrl kHashCtrlSentinel = -1;  // 0b11111111
+
+constexpr bool IsHashCtrlFull(HashCtrl ctrl) { return ctrl >= 0; }
+
+/// Spreads the entropy of a user-provided hash across all bits.
+///
+/// Many `std::hash` implementations are the identity function for integers,
+/// which would leave H2 with little entropy for small keys.
+constexpr size_t MixHash(size_t hash) {
+  if constexpr (sizeof(size_t) == sizeof(uint64_t)) {
+    uint64_t mixed = static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ull;
+    return static_cast<size_t>(mixed ^ (mixed >> 32));
+  } else {
+    uint32_t mixed = static_cast<uint32_t>(hash) * 0x9e3779b9u;
+    return static_cast<size_t>(mixed ^ (mixed >> 16));
+  }
+}
+
+constexpr size_t HashH1(size_t hash) { return hash >> 7; }
+constexpr HashCtrl HashH2(size_t hash) {
+  return static_cast<HashCtrl>(hash & 0x7f);
+}
+
+/// Set of slots within a group, represented as a bit mask with `1 << kShift`
+/// bits per slot.
+template <typename T, int kWidth, int kShift>
+class HashBitMask {
+ public:
+  static_assert(std::is_unsigned_v<T>);
+  static_assert(sizeof(T) * 8 == (kWidth << kShift));
+
+  explicit constexpr HashBitMask(T mask) : mask_(mask) {}
+
+  explicit constexpr operator bool() const { return mask_ != 0; }
+
+  /// Returns the index of the first slot in the set.
+  size_t LowestBitSet() const {
+    return static_cast<size_t>(cpp20::countr_zero(mask_)) >> kShift;
+  }
+
+  /// Returns the number of slots before the first slot in the set.
+  size_t TrailingZeros() const {
+    return static_cast<size_t>(cpp20::countr_zero(mask_)) >> kShift;
+  }
+
+  /// Returns the number of slots after the last slot in the set.
+  size_t LeadingZeros() const {
+    return static_cast<size_t>(cpp20::countl_zero(mask_)) >> kShift;
+  }
+
+  // Iteration over the indices of slots in the set.
+  HashBitMask begin() const { return *this; }
+  HashBitMask end() const { return HashBitMask(0); }
+  size_t operator*() const { return LowestBitSet(); }
+  HashBitMask& operator++() {
+    mask_ &= static_cast<T>(mask_ - 1);
+    return *this;
+  }
+  bool operator!=(const HashBitMask& other) const {
+    return mask_ != other.mask_;
+  }
+
+ private:
+  T mask_;
+};
+
+#if PW_CONTAINERS_HASH_TABLE_SSE2
+
+/// Group of control bytes compared using SSE2 instructions.
+class HashGroup {
+ public:
+  static constexpr size_t kWidth = 16;
+  using BitMask = HashBitMask<uint16_t, kWidth, 0>;
+
+  explicit HashGroup(const HashCtrl* pos)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+  /// Returns the slots whose control byte is `h2`.
+  BitMask Match(HashCtrl h2) const {
+    return ToBitMask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+  }
+
+  /// Returns the slots that are empty.
+  BitMask MaskEmpty() const { return Match(kHashCtrlEmpty); }
+
+  /// Returns the slots that are either empty or deleted.
+  BitMask MaskEmptyOrDeleted() const {
+    return ToBitMask(_mm_cmpgt_epi8(_mm_set1_epi8(kHashCtrlSentinel), ctrl_));
+  }
+
+ private:
+  static BitMask ToBitMask(__m128i mask) {
+    return BitMask(static_cast<uint16_t>(_mm_movemask_epi8(mask)));
+  }
+
+  __m128i ctrl_;
+};
+
+#else  // !PW_CONTAINERS_HASH_TABLE_SSE2
+
+/// Group of control bytes compared eight at a time using 64-bit arithmetic.
+class HashGroup {
+ public:
+  static constexpr size_t kWidth = 8;
+  using BitMask = HashBitMask<uint64_t, kWidth, 3>;
+
+  explicit HashGroup(const HashCtrl* pos) {
+    // Assemble the group in little-endian order, regardless of the target's
+    // endianness, so that slot `i` is always byte `i` of the word.
+    ctrl_ = 0;
+    for (size_t i = 0; i < kWidth; ++i) {
+      ctrl_ |= static_cast<uint64_t>(static_cast<uint8_t>(pos[i])) << (i * 8);
+    }
+  }
+
+  /// Returns the slots whose control byte is `h2`.
+  ///
+  /// This may return false positives for full slots adjacent to a match,
+  /// which are filtered out by comparing keys.
+  BitMask Match(HashCtrl h2) const {
+    uint64_t x = ctrl_ ^ (kLsbs * static_cast<uint8_t>(h2));
+    return BitMask((x - kLsbs) & ~x & kMsbs);
+  }
+
+  /// Returns the slots that are empty.
+  BitMask MaskEmpty() const { return BitMask(ctrl_ & ~(ctrl_ << 6) & kMsbs); }
+
+  /// Returns the slots that are either empty or deleted.
+  BitMask MaskEmptyOrDeleted() const {
+    return BitMask(ctrl_ & ~(ctrl_ << 7) & kMsbs);
+  }
+
+ private:
+  static constexpr uint64_t kMsbs = 0x8080808080808080ull;
+  static constexpr uint64_t kLsbs = 0x0101010101010101ull;
+
+  uint64_t ctrl_;
+};
+
+#endif  // PW_CONTAINERS_HASH_TABLE_SSE2
+
+/// Returns the number of control bytes needed for a table with the given
+/// number of slots.
+constexpr size_t HashCtrlBytes(size_t capacity) {
+  return capacity + HashGroup::kWidth;
+}
+
+/// Returns the maximum number of full and deleted slots before a table with
+/// the given number of slots must be cleaned up or grown.
+constexpr size_t HashMaxLoad(size_t capacity) {
+  return capacity < HashGroup::kWidth ? capacity - 1 : capacity - capacity / 8;
+}
+
+/// Returns the number of slots needed to hold the given number of elements.
+constexpr size_t HashSlotsFor(size_t num_elements) {
+  size_t capacity = cpp20::bit_ceil(num_elements + 1);
+  return HashMaxLoad(capacity) < num_elements ? capacity * 2 : capacity;
+}
+
+/// Hash table storing values of `Policy::value_type`, keyed by
+/// `Policy::GetKey(value)`.
+///
+/// This type does not own its storage. Derived types provide control bytes and
+/// slots via `Reset`, and are responsible for ensuring there is room before
+/// calling `PrepareInsert`.
+template <typename Policy, typename Hash, typename KeyEqual>
+class HashTable {
+ public:
+  using key_type = typename Policy::key_type;
+  using value_type = typename Policy::value_type;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+  template <typename ValueType>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ValueType;
+    using difference_type = ptrdiff_t;
+    using pointer = ValueType*;
+    using reference = ValueType&;
+
+    constexpr Iterator() = default;
+
+    // Allow conversion from non-const to const iterators.
+    template <typename OtherValueType,
+              typename = std::enable_if_t<
+                  std::is_same_v<const OtherValueType, ValueType>>>
+    constexpr Iterator(const Iterator<OtherValueType>& other)
+        : ctrl_(other.ctrl_), end_(other.end_), slot_(other.slot_) {}
+
+    reference operator*() const { return *slot_; }
+    pointer operator->() const { return slot_; }
+
+    Iterator& operator++() {
+      ++ctrl_;
+      ++slot_;
+      SkipEmptySlots();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.slot_ == rhs.slot_;
+    }
+    friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.slot_ != rhs.slot_;
+    }
+
+   private:
+    friend class HashTable;
+
+    template <typename>
+    friend class Iterator;
+
+    Iterator(const HashCtrl* ctrl, const HashCtrl* end, ValueType* slot)
+        : ctrl_(ctrl), end_(end), slot_(slot) {}
+
+    void SkipEmptySlots() {
+      while (ctrl_ != end_ && !IsHashCtrlFull(*ctrl_)) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+
+    const HashCtrl* ctrl_ = nullptr;
+    const HashCtrl* end_ = nullptr;
+    ValueType* slot_ = nullptr;
+  };
+
+  using iterator = Iterator<value_type>;
+  using const_iterator = Iterator<const value_type>;
+
+  HashTable(const HashTable&) = delete;
+  HashTable& operator=(const HashTable&) = delete;
+
+  // Iterators
+
+  iterator begin() { return IteratorAt(0, true); }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const {
+    return const_cast<HashTable*>(this)->IteratorAt(0, true);
+  }
+
+  iterator end() { return IteratorAt(capacity_, false); }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const {
+    return const_cast<HashTable*>(this)->IteratorAt(capacity_, false);
+  }
+
+  // Capacity
+
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+
+  /// Returns the number of slots in the table, including those reserved to
+  /// keep the load factor low.
+  size_type bucket_count() const { return capacity_; }
+
+  // Lookup
+
+  template <typename K>
+  iterator find(const K& key) {
+    return IteratorAt(FindIndex(key, HashOf(key)));
+  }
+
+  template <typename K>
+  const_iterator find(const K& key) const {
+    return const_cast<HashTable*>(this)->find(key);
+  }
+
+  template <typename K>
+  bool contains(const K& key) const {
+    return FindIndex(key, HashOf(key)) != kNotFound;
+  }
+
+  template <typename K>
+  size_type count(const K& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+ protected:
+  constexpr HashTable() = default;
+
+  HashTable(HashTable&& other) { *this = std::move(other); }
+
+  HashTable& operator=(HashTable&& other) {
+    ctrl_ = std::exchange(other.ctrl_, nullptr);
+    slots_ = std::exchange(other.slots_, nullptr);
+    capacity_ = std::exchange(other.capacity_, 0);
+    size_ = std::exchange(other.size_, 0);
+    num_deleted_ = std::exchange(other.num_deleted_, 0);
+    return *this;
+  }
+
+  ~HashTable() = default;
+
+  template <typename K>
+  static size_t HashOf(const K& key) {
+    return MixHash(Hash{}(key));
+  }
+
+  HashCtrl* ctrl() const { return ctrl_; }
+  value_type* slots() const { return slots_; }
+  size_t num_deleted() const { return num_deleted_; }
+
+  /// Returns how many more values can be inserted before the table needs to be
+  /// cleaned up or grown.
+  size_t growth_left() const {
+    return capacity_ == 0 ? 0
+                          : HashMaxLoad(capacity_) - size_ - num_deleted_;
+  }
+
+  iterator IteratorAt(size_t index, bool skip_empty = false) {
+    if (index == kNotFound) {
+      index = capacity_;
+    }
+    iterator it(ctrl_ + index, ctrl_ + capacity_, slots_ + index);
+    if (skip_empty) {
+      it.SkipEmptySlots();
+    }
+    return it;
+  }
+
+  size_t IndexOf(const_iterator it) const {
+    return static_cast<size_t>(it.slot_ - slots_);
+  }
+
+  /// Sets up the table to use the given storage, which must be able to hold
+  /// `HashCtrlBytes(capacity)` control bytes and `capacity` slots.
+  ///
+  /// The table must be empty.
+  void Reset(HashCtrl* ctrl, value_type* slots, size_t capacity) {
+    ctrl_ = ctrl;
+    slots_ = slots;
+    capacity_ = capacity;
+    size_ = 0;
+    ResetCtrl();
+  }
+
+  /// Returns the index of the slot with the given key, or `kNotFound`.
+  template <typename K>
+  size_t FindIndex(const K& key, size_t hash) const {
+    if (size_ == 0) {
+      return kNotFound;
+    }
+    size_t mask = capacity_ - 1;
+    size_t offset = HashH1(hash) & mask;
+    for (size_t probed = 0; probed < capacity_; probed += HashGroup::kWidth) {
+      HashGroup group(ctrl_ + offset);
+      for (size_t i : group.Match(HashH2(hash))) {
+        size_t index = (offset + i) & mask;
+        if (KeyEqual{}(Policy::GetKey(slots_[index]), key)) {
+          return index;
+        }
+      }
+      if (group.MaskEmpty()) {
+        break;
+      }
+      offset = (offset + probed + HashGroup::kWidth) & mask;
+    }
+    return kNotFound;
+  }
+
+  /// Claims a non-full slot for a value with the given hash and returns its
+  /// index. The caller must construct the value in the slot.
+  ///
+  /// The caller must ensure that `growth_left()` is not zero.
+  size_t PrepareInsert(size_t hash) {
+    size_t index = FindFirstNonFull(hash);
+    if (ctrl_[index] == kHashCtrlDeleted) {
+      --num_deleted_;
+    }
+    SetCtrl(index, HashH2(hash));
+    ++size_;
+    return index;
+  }
+
+  /// Destroys the value at the given index and marks the slot as non-full.
+  void EraseAt(size_t index) {
+    std::destroy_at(&slots_[index]);
+    --size_;
+    if (size_ == 0) {
+      ResetCtrl();
+      return;
+    }
+    if (WasNeverFull(index)) {
+      SetCtrl(index, kHashCtrlEmpty);
+    } else {
+      SetCtrl(index, kHashCtrlDeleted);
+      ++num_deleted_;
+    }
+  }
+
+  /// Destroys all values.
+  void DestroyAll() {
+    if (size_ == 0) {
+      return;
+    }
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      for (size_t i = 0; i < capacity_; ++i) {
+        if (IsHashCtrlFull(ctrl_[i])) {
+          std::destroy_at(&slots_[i]);
+        }
+      }
+    }
+    size_ = 0;
+    ResetCtrl();
+  }
+
+  /// Moves all values into the table's current storage from `ctrl` and
+  /// `slots`, which hold `capacity` slots.
+  void MoveFrom(HashCtrl* ctrl, value_type* slots, size_t capacity) {
+    for (size_t i = 0; i < capacity; ++i) {
+      if (!IsHashCtrlFull(ctrl[i])) {
+        continue;
+      }
+      size_t index = PrepareInsert(HashOf(Policy::GetKey(slots[i])));
+      new (&slots_[index]) value_type(std::move(slots[i]));
+      std::destroy_at(&slots[i]);
+    }
+  }
+
+  /// Removes all tombstones by rearranging values within the current storage.
+  void DropDeletesWithoutResize() {
+    // Mark tombstones as empty and full slots as deleted. Each "deleted" slot
+    // is then visited and moved to its ideal position.
+    for (size_t i = 0; i < capacity_; ++i) {
+      ctrl_[i] = IsHashCtrlFull(ctrl_[i]) ? kHashCtrlDeleted : kHashCtrlEmpty;
+    }
+    CopyClonedCtrl();
+    num_deleted_ = 0;
+
+    size_t mask = capacity_ - 1;
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] != kHashCtrlDeleted) {
+        continue;
+      }
+      size_t hash = HashOf(Policy::GetKey(slots_[i]));
+      size_t new_i = FindFirstNonFull(hash);
+      size_t probe_start = HashH1(hash) & mask;
+      auto probe_group = [probe_start, mask](size_t pos) {
+        return ((pos - probe_start) & mask) / HashGroup::kWidth;
+      };
+
+      // Values already in the first group they would be probed from stay put.
+      if (probe_group(new_i) == probe_group(i)) {
+        SetCtrl(i, HashH2(hash));
+        continue;
+      }
+      if (ctrl_[new_i] == kHashCtrlEmpty) {
+        SetCtrl(new_i, HashH2(hash));
+        new (&slots_[new_i]) value_type(std::move(slots_[i]));
+        std::destroy_at(&slots_[i]);
+        SetCtrl(i, kHashCtrlEmpty);
+      } else {
+        // The target holds a value that has not been visited yet. Swap them,
+        // and process the displaced value in this slot again.
+        SetCtrl(new_i, HashH2(hash));
+        alignas(value_type) std::byte tmp_storage[sizeof(value_type)];
+        auto* tmp = new (tmp_storage) value_type(std::move(slots_[i]));
+        std::destroy_at(&slots_[i]);
+        new (&slots_[i]) value_type(std::move(slots_[new_i]));
+        std::destroy_at(&slots_[new_i]);
+        new (&slots_[new_i]) value_type(std::move(*tmp));
+        std::destroy_at(tmp);
+        --i;
+      }
+    }
+  }
+
+ private:
+  void ResetCtrl() {
+    num_deleted_ = 0;
+    if (ctrl_ == nullptr) {
+      return;
+    }
+    std::memset(ctrl_, static_cast<uint8_t>(kHashCtrlEmpty), capacity_);
+    std::memset(ctrl_ + capacity_,
+                static_cast<uint8_t>(kHashCtrlSentinel),
+                HashGroup::kWidth);
+    CopyClonedCtrl();
+  }
+
+  void CopyClonedCtrl() {
+    size_t num_cloned = std::min(capacity_, HashGroup::kWidth);
+    std::memcpy(ctrl_ + capacity_, ctrl_, num_cloned);
+  }
+
+  void SetCtrl(size_t index, HashCtrl ctrl) {
+    ctrl_[index] = ctrl;
+    if (index < HashGroup::kWidth) {
+      ctrl_[capacity_ + index] = ctrl;
+    }
+  }
+
+  size_t FindFirstNonFull(size_t hash) const {
+    size_t mask = capacity_ - 1;
+    size_t offset = HashH1(hash) & mask;
+    for (size_t probed = 0;; probed += HashGroup::kWidth) {
+      HashGroup group(ctrl_ + offset);
+      auto mask_empty = group.MaskEmptyOrDeleted();
+      if (mask_empty) {
+        return (offset + mask_empty.LowestBitSet()) & mask;
+      }
+      offset = (offset + probed + HashGroup::kWidth) & mask;
+    }
+  }
+
+  /// Returns whether a slot can be marked empty instead of deleted when
+  /// erased, i.e. no probe sequence could have passed over it while it was
+  /// full without finding an empty slot.
+  bool WasNeverFull(size_t index) const {
+    if (capacity_ <= HashGroup::kWidth) {
+      // Every probe examines every slot, so there are no probe sequences to
+      // preserve.
+      return true;
+    }
+    size_t index_before = (index - HashGroup::kWidth) & (capacity_ - 1);
+    auto empty_after = HashGroup(ctrl_ + index).MaskEmpty();
+    auto empty_before = HashGroup(ctrl_ + index_before).MaskEmpty();
+    return empty_before && empty_after &&
+           empty_after.TrailingZeros() + empty_before.LeadingZeros() <
+               HashGroup::kWidth;
+  }
+
+  HashCtrl* ctrl_ = nullptr;
+  value_type* slots_ = nullptr;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+  size_t num_deleted_ = 0;
+};
+
+}  // namespace pw::containers::internal
@@ -0,0 +1,337 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_containers/internal/hash_table.h"
+#include "pw_containers/internal/intrusive_item.h"
+
+namespace pw {
+
+template <typename T, size_t kCapacity, typename Hash, typename KeyEqual>
+class IntrusiveHashSet;
+
+namespace containers::internal {
+
+/// Base type for items stored in a `pw::IntrusiveHashSet`.
+///
+/// Unlike other intrusive containers, the links between items live in the
+/// set's table. The item only records whether it is in a set.
+class IntrusiveHashSetItem {
+ public:
+  /// Destructor. An item cannot be part of a set when it is destroyed.
+  ~IntrusiveHashSetItem() { CheckIntrusiveItemIsUncontained(!in_set_); }
+
+  // IntrusiveHashSetItems are not copyable.
+  IntrusiveHashSetItem(const IntrusiveHashSetItem&) = delete;
+  IntrusiveHashSetItem& operator=(const IntrusiveHashSetItem&) = delete;
+
+ protected:
+  constexpr explicit IntrusiveHashSetItem() = default;
+
+ private:
+  template <typename, size_t, typename, typename>
+  friend class ::pw::IntrusiveHashSet;
+
+  bool in_set_ = false;
+};
+
+template <typename T>
+struct IntrusiveHashSetPolicy {
+  using key_type = T;
+  using value_type = T*;
+
+  static const T& GetKey(const value_type& value) { return *value; }
+};
+
+}  // namespace containers::internal
+
+/// A `std::unordered_set<T>`-like class that uses intrusive items.
+///
+/// Items must derive from `IntrusiveHashSet<T, kCapacity>::Item`, and must
+/// outlive any set they are a part of. Each item may be part of at most one
+/// set at a time.
+///
+/// The set holds pointers to up to `kCapacity` items in an inline
+/// open-addressing "Swiss table", so it never allocates and, unlike
+/// `pw::IntrusiveSet`, does not require items to be ordered. Lookups compare a
+/// group of 8 or 16 one-byte control values at once, using SIMD instructions
+/// when available, so most lookups compare at most one item.
+///
+/// This set requires unique keys. Attempting to add an item with the same key
+/// as an item already in the set will fail. Inserting an item when the set is
+/// `full()` crashes.
+///
+/// `Hash` and `KeyEqual` must be stateless.
+///
+/// @tparam   T           Type of items stored in the set.
+/// @tparam   kCapacity   Maximum number of items in the set.
+/// @tparam   Hash        Function object that hashes a `const T&`.
+/// @tparam   KeyEqual    Function object that compares two `const T&`s.
+template <typename T,
+          size_t kCapacity,
+          typename Hash = std::hash<T>,
+          typename KeyEqual = std::equal_to<T>>
+class IntrusiveHashSet {
+ private:
+  using Policy = containers::internal::IntrusiveHashSetPolicy<T>;
+  using Table = containers::internal::HashTable<Policy, Hash, KeyEqual>;
+
+  template <typename ValueType, typename TableIterator>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ValueType;
+    using difference_type = ptrdiff_t;
+    using pointer = ValueType*;
+    using reference = ValueType&;
+
+    constexpr Iterator() = default;
+
+    reference operator*() const { return **iter_; }
+    pointer operator->() const { return *iter_; }
+
+    Iterator& operator++() {
+      ++iter_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++iter_;
+      return tmp;
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.iter_ == rhs.iter_;
+    }
+    friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.iter_ != rhs.iter_;
+    }
+
+   private:
+    friend IntrusiveHashSet;
+
+    constexpr explicit Iterator(TableIterator iter) : iter_(iter) {}
+
+    TableIterator iter_;
+  };
+
+ public:
+  /// IntrusiveHashSet items must derive from `Item`.
+  using Item = containers::internal::IntrusiveHashSetItem;
+
+  using key_type = T;
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = Iterator<T, typename Table::iterator>;
+  using const_iterator = Iterator<const T, typename Table::const_iterator>;
+
+  static_assert(kCapacity > 0, "IntrusiveHashSet must have a nonzero capacity");
+
+  /// Constructs an empty set of items.
+  IntrusiveHashSet() {
+    static_assert(std::is_base_of_v<Item, T>,
+                  "IntrusiveHashSet items must be derived from "
+                  "IntrusiveHashSet<T, kCapacity>::Item");
+    table_.Reset(ctrl_.data(), slots_.data(), kSlots);
+  }
+
+  /// Constructs an IntrusiveHashSet from an iterator over items.
+  ///
+  /// The iterator may dereference as either T& or T*.
+  template <typename InputIt>
+  IntrusiveHashSet(InputIt first, InputIt last) : IntrusiveHashSet() {
+    insert(first, last);
+  }
+
+  /// Constructs an IntrusiveHashSet from a std::initializer_list of pointers
+  /// to items.
+  IntrusiveHashSet(std::initializer_list<T*> items) : IntrusiveHashSet() {
+    insert(items.begin(), items.end());
+  }
+
+  // The set holds pointers into itself, so it cannot be copied or moved.
+  IntrusiveHashSet(const IntrusiveHashSet&) = delete;
+  IntrusiveHashSet& operator=(const IntrusiveHashSet&) = delete;
+
+  /// Destructor. The set must be empty when it is destroyed.
+  ~IntrusiveHashSet() {
+    containers::internal::CheckIntrusiveContainerIsEmpty(empty());
+  }
+
+  // Iterators
+
+  iterator begin() { return iterator(table_.begin()); }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator(table_.cbegin()); }
+
+  iterator end() { return iterator(table_.end()); }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator(table_.cend()); }
+
+  // Capacity
+
+  [[nodiscard]] bool empty() const { return table_.empty(); }
+  size_type size() const { return table_.size(); }
+  static constexpr size_type max_size() { return kCapacity; }
+
+  /// Returns whether inserting a new item would fail.
+  bool full() const { return size() >= kCapacity; }
+
+  // Modifiers
+
+  /// Removes all items from the set.
+  void clear() {
+    for (T& item : *this) {
+      item.Item::in_set_ = false;
+    }
+    table_.DestroyAll();
+  }
+
+  /// Attempts to add the given item to the set.
+  ///
+  /// The item will be added if the set does not already contain an equal item.
+  /// Crashes if the item is added and the set is full.
+  ///
+  /// @returns  An iterator to the item with the same key, and whether the item
+  ///           was added.
+  std::pair<iterator, bool> insert(T& item) {
+    containers::internal::CheckIntrusiveItemIsUncontained(
+        !item.Item::in_set_);
+    size_t hash = TableImpl::HashOf(static_cast<const T&>(item));
+    size_t index = table_.FindIndex(static_cast<const T&>(item), hash);
+    if (index != Table::kNotFound) {
+      return std::make_pair(iterator(table_.IteratorAt(index)), false);
+    }
+    PW_ASSERT(!full());
+    if (table_.growth_left() == 0) {
+      table_.DropDeletesWithoutResize();
+    }
+    index = table_.PrepareInsert(hash);
+    table_.slots()[index] = &item;
+    item.Item::in_set_ = true;
+    return std::make_pair(iterator(table_.IteratorAt(index)), true);
+  }
+
+  /// Adds items from an iterator that dereferences as either T& or T*.
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      if constexpr (std::is_pointer_v<
+                        typename std::iterator_traits<InputIt>::value_type>) {
+        insert(**first);
+      } else {
+        insert(*first);
+      }
+    }
+  }
+
+  void insert(std::initializer_list<T*> items) {
+    insert(items.begin(), items.end());
+  }
+
+  /// Removes the item at `pos` from the set.
+  ///
+  /// @returns  An iterator to the next item.
+  iterator erase(iterator pos) {
+    size_t index = table_.IndexOf(pos.iter_);
+    EraseAt(index);
+    return iterator(table_.IteratorAt(index, true));
+  }
+
+  /// Removes the item equal to `key` from the set, if any.
+  ///
+  /// @returns  The number of items removed, which is 0 or 1.
+  template <typename K>
+  size_type erase(const K& key) {
+    size_t index = table_.FindIndex(key, TableImpl::HashOf(key));
+    if (index == Table::kNotFound) {
+      return 0;
+    }
+    EraseAt(index);
+    return 1;
+  }
+
+  // Lookup
+
+  /// Returns an iterator to the item equal to `key`, or `end()`.
+  template <typename K>
+  iterator find(const K& key) {
+    return iterator(table_.find(key));
+  }
+
+  template <typename K>
+  const_iterator find(const K& key) const {
+    return const_iterator(table_.find(key));
+  }
+
+  template <typename K>
+  bool contains(const K& key) const {
+    return table_.contains(key);
+  }
+
+  template <typename K>
+  size_type count(const K& key) const {
+    return table_.count(key);
+  }
+
+ private:
+  // Exposes the protected table operations to the set.
+  class TableImpl : public Table {
+   public:
+    using Table::DestroyAll;
+    using Table::DropDeletesWithoutResize;
+    using Table::EraseAt;
+    using Table::FindIndex;
+    using Table::growth_left;
+    using Table::HashOf;
+    using Table::IndexOf;
+    using Table::IteratorAt;
+    using Table::PrepareInsert;
+    using Table::Reset;
+    using Table::slots;
+  };
+
+  static constexpr size_t kSlots =
+      containers::internal::HashSlotsFor(kCapacity);
+
+  void EraseAt(size_t index) {
+    table_.slots()[index]->Item::in_set_ = false;
+    table_.EraseAt(index);
+  }
+
+  TableImpl table_;
+  std::array<containers::internal::HashCtrl,
+             containers::internal::HashCtrlBytes(kSlots)>
+      ctrl_;
+  std::array<T*, kSlots> slots_;
+};
+
+}  // namespace pw
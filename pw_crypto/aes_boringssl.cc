@@ -89,4 +89,21 @@ Status DoEncryptBlock(ConstByteSpan key,
 
   return OkStatus();
 }
+
+Status DoInit(NativeBlockCipherContext& ctx, ConstByteSpan key) {
+  auto key_u8 = span_cast<uint8_t>(key);
+  if (AES_set_encrypt_key(key_u8.data(), key_u8.size() * kBits, &ctx) != 0) {
+    return Status::Internal();
+  }
+  return OkStatus();
+}
+
+Status DoEncryptBlock(const NativeBlockCipherContext& ctx,
+                      ConstBlockSpan plaintext,
+                      BlockSpan out_ciphertext) {
+  auto plaintext_u8 = span_cast<uint8_t>(plaintext);
+  auto ciphertext_u8 = span_cast<uint8_t>(out_ciphertext);
+  AES_encrypt(plaintext_u8.data(), ciphertext_u8.data(), &ctx);
+  return OkStatus();
+}
 }  // namespace pw::crypto::aes::backend
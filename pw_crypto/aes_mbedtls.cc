@@ -100,4 +100,23 @@ Status DoEncryptBlock(ConstByteSpan key,
   return OkStatus();
 }
 
+Status DoInit(NativeBlockCipherContext& ctx, ConstByteSpan key) {
+  const auto key_data = reinterpret_cast<const unsigned char*>(key.data());
+  if (mbedtls_aes_setkey_enc(&ctx.aes, key_data, key.size() * kBits)) {
+    return Status::Internal();
+  }
+  return OkStatus();
+}
+
+Status DoEncryptBlock(const NativeBlockCipherContext& ctx,
+                      ConstBlockSpan plaintext,
+                      BlockSpan out_ciphertext) {
+  const auto in = reinterpret_cast<const unsigned char*>(plaintext.data());
+  const auto out = reinterpret_cast<unsigned char*>(out_ciphertext.data());
+  if (mbedtls_aes_crypt_ecb(&ctx.aes, MBEDTLS_AES_ENCRYPT, in, out)) {
+    return Status::Internal();
+  }
+  return OkStatus();
+}
+
 }  // namespace pw::crypto::aes::backend
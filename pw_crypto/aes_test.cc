@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <utility>
 
 #include "pw_assert/assert.h"
 #include "pw_containers/vector.h"
@@ -32,6 +33,7 @@ namespace {
 using backend::AesOperation;
 using backend::SupportedKeySize;
 using internal::BackendSupports;
+using unsafe::aes::BlockEncryptor;
 using unsafe::aes::EncryptBlock;
 using Cmac = aes_cmac::Cmac;
 
@@ -242,5 +244,56 @@ TEST(Aes, UnsafeEncryptApi) {
   }
 }
 
+TEST(Aes, UnsafeBlockEncryptor) {
+  constexpr auto kRawEncryptBlockOp = AesOperation::kUnsafeEncryptBlock;
+  ConstBlockSpan message_block = STR_TO_BYTES("hello, world!\0\0\0");
+  Block encrypted_block;
+
+  // Ensure dynamically-sized keys will work.
+  Vector<std::byte, kMaxVectorSize> dynamic_key;
+
+  if constexpr (BackendSupports<kRawEncryptBlockOp>(SupportedKeySize::k128)) {
+    span<const std::byte, 16> key = STR_TO_BYTES(
+        "\x13\xA2\x27\x93\x8D\x1D\x89\x46\x07\x4C\xA0\x71\xF2\xF7\x54\xC5");
+    Block expected = SpanToArray(STR_TO_BYTES(
+        "\xC0\x9A\x54\x34\xFD\xB8\xB4\x37\xAD\x84\x67\x60\x79\x8D\xCE\x40"));
+
+    const BlockEncryptor encryptor(key);
+    // The expanded key is reused for every block.
+    for (int i = 0; i < 2; ++i) {
+      ZeroOut(encrypted_block);
+      EXPECT_OK(encryptor.EncryptBlock(message_block, encrypted_block));
+      EXPECT_EQ(encrypted_block, expected);
+    }
+
+    // A moved-to encryptor keeps the expanded key.
+    BlockEncryptor original(key);
+    BlockEncryptor moved(std::move(original));
+    ZeroOut(encrypted_block);
+    EXPECT_OK(moved.EncryptBlock(message_block, encrypted_block));
+    EXPECT_EQ(encrypted_block, expected);
+
+    ZeroOut(dynamic_key);
+    dynamic_key.clear();
+    std::copy(key.begin(), key.end(), std::back_inserter(dynamic_key));
+    ZeroOut(encrypted_block);
+    EXPECT_OK(BlockEncryptor(View(dynamic_key))
+                  .EncryptBlock(message_block, encrypted_block));
+    EXPECT_EQ(encrypted_block, expected);
+  }
+
+  if constexpr (BackendSupports<kRawEncryptBlockOp>(SupportedKeySize::k256)) {
+    span<const std::byte, 32> key = STR_TO_BYTES(
+        "\xA4\xB9\x15\x76\xF2\x16\x67\xB0\x33\x5E\xA6\x8D\xBD\x23\xDF\x29"
+        "\x84\xBF\x8D\xBE\x56\x77\x13\x28\x14\x55\xD9\x75\xDD\xEE\x4E\x0B");
+    Block expected = SpanToArray(STR_TO_BYTES(
+        "\x9B\xC4\x12\x39\xB7\x2A\xA1\x14\xB3\x6E\x6C\xAE\x2C\x7f\xDD\xE7"));
+
+    ZeroOut(encrypted_block);
+    EXPECT_OK(BlockEncryptor(key).EncryptBlock(message_block, encrypted_block));
+    EXPECT_EQ(encrypted_block, expected);
+  }
+}
+
 }  // namespace
 }  // namespace pw::crypto::aes
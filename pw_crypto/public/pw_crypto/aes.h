@@ -20,6 +20,7 @@
 #include "pw_crypto/aes_backend_defs.h"
 #include "pw_log/log.h"
 #include "pw_status/status.h"
+#include "pw_status/try.h"
 
 namespace pw::crypto::aes {
 
@@ -95,6 +96,11 @@ Status DoFinal(NativeCmacContext& ctx, BlockSpan out_mac);
 Status DoEncryptBlock(ConstByteSpan key,
                       ConstBlockSpan plaintext,
                       BlockSpan out_ciphertext);
+
+Status DoInit(NativeBlockCipherContext& ctx, ConstByteSpan key);
+Status DoEncryptBlock(const NativeBlockCipherContext& ctx,
+                      ConstBlockSpan plaintext,
+                      BlockSpan out_ciphertext);
 }  // namespace backend
 
 }  // namespace pw::crypto::aes
@@ -155,4 +161,52 @@ inline Status EncryptBlock<dynamic_extent>(
       key, plaintext, out_ciphertext);
 }
 
+/// Encrypts single blocks with AES under a fixed key, like `EncryptBlock()`.
+///
+/// The key schedule is expanded once, when the `BlockEncryptor` is
+/// constructed, instead of on every call. Prefer this over `EncryptBlock()`
+/// when encrypting many blocks with the same key.
+///
+/// @warning This is the same low-level operation as `EncryptBlock()`, with the
+/// same caveats.
+class BlockEncryptor {
+ public:
+  /// Expands `key` for encryption.
+  ///
+  /// @note Any error during initialization will be reflected in the return
+  /// value of `EncryptBlock()`.
+  template <size_t KeySize>
+  explicit BlockEncryptor(span<const std::byte, KeySize> key) {
+    constexpr auto kThisOp =
+        pw::crypto::aes::backend::AesOperation::kUnsafeEncryptBlock;
+    static_assert(pw::crypto::aes::internal::BackendSupports<kThisOp>(KeySize),
+                  "Unsupported key size for EncryptBlock for backend.");
+    init_status_ = pw::crypto::aes::backend::DoInit(native_ctx_, key);
+  }
+
+  explicit BlockEncryptor(span<const std::byte, dynamic_extent> key) {
+    constexpr auto kThisOp =
+        pw::crypto::aes::backend::AesOperation::kUnsafeEncryptBlock;
+    PW_ASSERT(pw::crypto::aes::internal::BackendSupports<kThisOp>(key.size()));
+    init_status_ = pw::crypto::aes::backend::DoInit(native_ctx_, key);
+  }
+
+  /// Encrypts `plaintext` with the expanded key.
+  ///
+  /// @returns @pw_status{OK} if the block was encrypted and written to
+  /// `out_ciphertext`, or the error encountered while expanding the key or
+  /// encrypting the block.
+  Status EncryptBlock(pw::crypto::aes::ConstBlockSpan plaintext,
+                      pw::crypto::aes::BlockSpan out_ciphertext) const {
+    PW_TRY(init_status_);
+    return pw::crypto::aes::backend::DoEncryptBlock(
+        native_ctx_, plaintext, out_ciphertext);
+  }
+
+ private:
+  Status init_status_;
+  // Backend-specific context holding the expanded key.
+  pw::crypto::aes::backend::NativeBlockCipherContext native_ctx_;
+};
+
 }  // namespace pw::crypto::unsafe::aes
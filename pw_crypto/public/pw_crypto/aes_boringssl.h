@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <openssl/aes.h>
 #include <openssl/cmac.h>
 
 #include "pw_crypto/aes_backend_defs.h"
@@ -37,4 +38,6 @@ struct CmacContextDeleter final {
 
 /// A ``CMAC_CTX*`` wrapped in a ``std::unique_ptr`` for lifetime management.
 using NativeCmacContext = std::unique_ptr<CMAC_CTX, CmacContextDeleter>;
+
+using NativeBlockCipherContext = AES_KEY;
 }  // namespace pw::crypto::aes::backend
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <mbedtls/aes.h>
 #include <mbedtls/cipher.h>
 
 #include "pw_crypto/aes_backend_defs.h"
@@ -59,4 +60,30 @@ struct NativeCmacContext final {
     return *this;
   }
 };
+
+struct NativeBlockCipherContext final {
+  // Mutable because encrypting a block does not change the expanded key, but
+  // mbedtls_aes_crypt_ecb() takes a non-const context.
+  mutable mbedtls_aes_context aes;
+
+  NativeBlockCipherContext() { mbedtls_aes_init(&aes); }
+  ~NativeBlockCipherContext() { mbedtls_aes_free(&aes); }
+
+  NativeBlockCipherContext(const NativeBlockCipherContext&) = delete;
+  NativeBlockCipherContext& operator=(const NativeBlockCipherContext&) =
+      delete;
+
+  // Mbed TLS 3 locates the round keys by an offset into the context rather
+  // than by a pointer, so the context can be moved by copying it.
+  NativeBlockCipherContext(NativeBlockCipherContext&& other) : aes(other.aes) {
+    mbedtls_aes_init(&other.aes);
+  }
+
+  NativeBlockCipherContext& operator=(NativeBlockCipherContext&& other) {
+    mbedtls_aes_free(&aes);
+    aes = other.aes;
+    mbedtls_aes_init(&other.aes);
+    return *this;
+  }
+};
 }  // namespace pw::crypto::aes::backend
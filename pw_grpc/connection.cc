@@ -46,7 +46,6 @@ enum class FrameType : uint8_t {
 };
 
 // RFC 9113 §4.1
-constexpr size_t kFrameHeaderEncodedSize = 9;
 struct FrameHeader {
   uint32_t payload_length;
   FrameType type;
@@ -80,6 +79,7 @@ namespace {
 using internal::FrameHeader;
 using internal::FrameType;
 using internal::Http2Error;
+using internal::kFrameHeaderEncodedSize;
 using internal::kMaxConcurrentStreams;
 using internal::kMaxGrpcMessageSize;
 
@@ -109,22 +109,10 @@ enum SettingType : uint16_t {
   SETTINGS_MAX_HEADER_LIST_SIZE = 0x06,
 };
 
-Status ReadExactly(stream::Reader& reader, ByteSpan buffer) {
-  size_t bytes_read = 0;
-  while (bytes_read < buffer.size()) {
-    PW_TRY_ASSIGN(auto out, reader.Read(buffer.subspan(bytes_read)));
-    bytes_read += out.size();
-  }
-  return OkStatus();
-}
-
-Result<FrameHeader> ReadFrameHeader(stream::Reader& reader) {
-  std::array<std::byte, internal::kFrameHeaderEncodedSize> buffer;
-  PW_TRY(ReadExactly(reader, buffer));
-
+FrameHeader ParseFrameHeader(ByteSpan buffer) {
   // RFC 9113 §4.1
   FrameHeader out;
-  ByteBuilder builder(as_writable_bytes(span{buffer}));
+  ByteBuilder builder(buffer.first(kFrameHeaderEncodedSize));
   auto it = builder.begin();
   auto type_and_length = it.ReadUint32(endian::big);
   out.payload_length = type_and_length >> 8;
@@ -167,6 +155,7 @@ Connection::Connection(stream::ReaderWriter& socket,
                        allocator::Allocator* message_assembly_allocator,
                        multibuf::MultiBufAllocator& multibuf_allocator)
     : socket_(socket),
+      send_queue_(send_queue),
       shared_state_(std::in_place,
                     message_assembly_allocator,
                     multibuf_allocator,
@@ -179,7 +168,23 @@ Status Connection::Reader::ProcessFrame() {
     return Status::FailedPrecondition();
   }
 
-  PW_TRY_ASSIGN(auto frame, ReadFrameHeader(connection_.socket_.as_reader()));
+  PW_TRY(ReceiveFrame());
+
+  // Process all of the frames that have been received. Sends are held until
+  // all of them are processed, so that their responses, such as the responses
+  // to many short RPCs, are written to the socket together.
+  connection_.send_queue_.HoldSends();
+  Status status;
+  do {
+    status = ProcessReceivedFrame();
+  } while (status.ok() && HasReceivedFrame());
+  connection_.send_queue_.ReleaseSends();
+  return status;
+}
+
+Status Connection::Reader::ProcessReceivedFrame() {
+  PW_TRY_ASSIGN(ByteSpan header, Consume(kFrameHeaderEncodedSize));
+  const FrameHeader frame = ParseFrameHeader(header);
   switch (frame.type) {
     // Frames that we handle.
     case FrameType::DATA:
@@ -600,10 +605,8 @@ Status Connection::Reader::ProcessConnectionPreface() {
   callbacks_.OnNewConnection();
 
   // The preface starts with a literal string.
-  auto literal = span{payload_scratch_}.subspan(
-      0, kExpectedConnectionPrefaceLiteral.size());
-
-  PW_TRY(ReadExactly(connection_.socket_.as_reader(), literal));
+  PW_TRY_ASSIGN(ByteSpan literal,
+                Consume(kExpectedConnectionPrefaceLiteral.size()));
   if (std::memcmp(literal.data(),
                   kExpectedConnectionPrefaceLiteral.data(),
                   kExpectedConnectionPrefaceLiteral.size()) != 0) {
@@ -614,8 +617,9 @@ Status Connection::Reader::ProcessConnectionPreface() {
   PW_LOG_DEBUG("Conn.Preface received literal");
 
   // Client must send a SETTINGS frames.
-  PW_TRY_ASSIGN(auto client_frame,
-                ReadFrameHeader(connection_.socket_.as_reader()));
+  PW_TRY_ASSIGN(ByteSpan client_frame_header,
+                Consume(kFrameHeaderEncodedSize));
+  const FrameHeader client_frame = ParseFrameHeader(client_frame_header);
   if (client_frame.type != FrameType::SETTINGS) {
     PW_LOG_ERROR(
         "Connection preface missing SETTINGS frame, found frame.type=%d",
@@ -1323,30 +1327,86 @@ Status Connection::Reader::ProcessWindowUpdateFrame(const FrameHeader& frame) {
 Status Connection::Reader::ProcessIgnoredFrame(const FrameHeader& frame) {
   size_t to_read = frame.payload_length;
   while (to_read > 0) {
-    auto chunk = span{payload_scratch_}.subspan(
-        0, std::min(payload_scratch_.size(), to_read));
-    PW_TRY(ReadExactly(connection_.socket_.as_reader(), chunk));
+    PW_TRY_ASSIGN(ByteSpan chunk,
+                  Consume(std::min(receive_buffer_.size(), to_read)));
     to_read -= chunk.size();
   }
   return OkStatus();
 }
 
+// The payload is returned in place in the receive buffer.
 Result<ByteSpan> Connection::Reader::ReadFramePayload(
     const FrameHeader& frame) {
   if (frame.payload_length == 0) {
     return ByteSpan();
   }
-  if (frame.payload_length > payload_scratch_.size()) {
+  if (frame.payload_length > internal::kMaxFramePayloadSize) {
     PW_LOG_ERROR("Frame type=%d payload too large: %" PRIu32 " > %" PRIu32,
                  static_cast<int>(frame.type),
                  frame.payload_length,
-                 static_cast<uint32_t>(payload_scratch_.size()));
+                 internal::kMaxFramePayloadSize);
     SendGoAway(Http2Error::FRAME_SIZE_ERROR);
     return Status::Internal();
   }
-  auto payload = span{payload_scratch_}.subspan(0, frame.payload_length);
-  PW_TRY(ReadExactly(connection_.socket_.as_reader(), payload));
-  return payload;
+  return Consume(frame.payload_length);
+}
+
+Status Connection::Reader::ReceiveFrame() {
+  PW_TRY(Receive(kFrameHeaderEncodedSize));
+  const FrameHeader frame = ParseFrameHeader(
+      span(receive_buffer_).subspan(receive_start_, kFrameHeaderEncodedSize));
+  return Receive(std::min(kFrameHeaderEncodedSize + frame.payload_length,
+                          receive_buffer_.size()));
+}
+
+bool Connection::Reader::HasReceivedFrame() const {
+  const size_t received = receive_end_ - receive_start_;
+  if (received < kFrameHeaderEncodedSize) {
+    return false;
+  }
+  // The payload length is the first 24 bits of the header.
+  const auto* header = &receive_buffer_[receive_start_];
+  const size_t payload_length = static_cast<size_t>(header[0]) << 16 |
+                                static_cast<size_t>(header[1]) << 8 |
+                                static_cast<size_t>(header[2]);
+  return received >= kFrameHeaderEncodedSize + payload_length;
+}
+
+Status Connection::Reader::Receive(size_t size) {
+  PW_DCHECK_UINT_LE(size, receive_buffer_.size());
+  if (receive_end_ - receive_start_ >= size) {
+    return OkStatus();
+  }
+
+  // Move the received bytes to the front of the buffer if the rest would not
+  // fit after them.
+  if (receive_start_ + size > receive_buffer_.size()) {
+    std::memmove(receive_buffer_.data(),
+                 receive_buffer_.data() + receive_start_,
+                 receive_end_ - receive_start_);
+    receive_end_ -= receive_start_;
+    receive_start_ = 0;
+  }
+
+  // Read as much as is available, which may include more frames.
+  while (receive_end_ - receive_start_ < size) {
+    PW_TRY_ASSIGN(ByteSpan read,
+                  connection_.socket_.as_reader().Read(
+                      span(receive_buffer_).subspan(receive_end_)));
+    receive_end_ += read.size();
+  }
+  return OkStatus();
+}
+
+Result<ByteSpan> Connection::Reader::Consume(size_t size) {
+  PW_TRY(Receive(size));
+  ByteSpan bytes = span(receive_buffer_).subspan(receive_start_, size);
+  receive_start_ += size;
+  if (receive_start_ == receive_end_) {
+    receive_start_ = 0;
+    receive_end_ = 0;
+  }
+  return bytes;
 }
 
 // RFC 9113 §6.8
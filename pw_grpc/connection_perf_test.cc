@@ -0,0 +1,258 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "pw_allocator/libc_allocator.h"
+#include "pw_assert/check.h"
+#include "pw_bytes/span.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_grpc/connection.h"
+#include "pw_grpc/send_queue.h"
+#include "pw_log/log.h"
+#include "pw_multibuf/simple_allocator.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_stream/stream.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/yield.h"
+
+namespace pw::grpc {
+namespace {
+
+// Measures the rate at which a Connection serves many small unary calls. The
+// stand-in client pipelines the calls in groups of concurrent streams, as a
+// gRPC client does when many calls are started at once. The echo service
+// responds to each call from its callbacks. The number of requests per second
+// and the number of socket writes per call are logged.
+
+constexpr size_t kNumCalls = 512;
+constexpr std::string_view kMethod = "/pw.grpc.Echo/UnaryEcho";
+constexpr size_t kMessageSize = 16;
+
+constexpr uint8_t kFrameTypeData = 0x00;
+constexpr uint8_t kFrameTypeHeaders = 0x01;
+constexpr uint8_t kFrameTypeSettings = 0x04;
+constexpr uint8_t kFlagEndStream = 0x01;
+constexpr uint8_t kFlagEndHeaders = 0x04;
+
+void AppendFrameHeader(std::vector<std::byte>& out,
+                       size_t payload_length,
+                       uint8_t type,
+                       uint8_t flags,
+                       StreamId stream_id) {
+  const uint8_t header[internal::kFrameHeaderEncodedSize] = {
+      static_cast<uint8_t>(payload_length >> 16),
+      static_cast<uint8_t>(payload_length >> 8),
+      static_cast<uint8_t>(payload_length),
+      type,
+      flags,
+      static_cast<uint8_t>(stream_id >> 24),
+      static_cast<uint8_t>(stream_id >> 16),
+      static_cast<uint8_t>(stream_id >> 8),
+      static_cast<uint8_t>(stream_id),
+  };
+  for (uint8_t byte : header) {
+    out.push_back(static_cast<std::byte>(byte));
+  }
+}
+
+// Encodes the bytes a client sends for `kNumCalls` unary calls, starting
+// `concurrency` calls at a time.
+std::vector<std::byte> EncodeRequests(size_t concurrency) {
+  std::vector<std::byte> out;
+  for (char c : std::string_view("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n")) {
+    out.push_back(static_cast<std::byte>(c));
+  }
+  AppendFrameHeader(out, 0, kFrameTypeSettings, 0, 0);
+
+  // RFC 7541 §6.2.2: literal header field without indexing, with the name of
+  // static table entry 4, which is :path.
+  std::vector<std::byte> headers = {std::byte{0x04},
+                                    static_cast<std::byte>(kMethod.size())};
+  for (char c : kMethod) {
+    headers.push_back(static_cast<std::byte>(c));
+  }
+
+  // Length-Prefixed-Message: not compressed, 32-bit length, message.
+  std::vector<std::byte> message = {
+      std::byte{0}, std::byte{0}, std::byte{0}, std::byte{0}};
+  message.push_back(static_cast<std::byte>(kMessageSize));
+  message.resize(message.size() + kMessageSize, std::byte{0x5a});
+
+  for (size_t first = 0; first < kNumCalls; first += concurrency) {
+    const size_t last = std::min(first + concurrency, kNumCalls);
+    for (size_t i = first; i < last; ++i) {
+      const auto id = static_cast<StreamId>(2 * i + 1);
+      AppendFrameHeader(
+          out, headers.size(), kFrameTypeHeaders, kFlagEndHeaders, id);
+      out.insert(out.end(), headers.begin(), headers.end());
+    }
+    for (size_t i = first; i < last; ++i) {
+      const auto id = static_cast<StreamId>(2 * i + 1);
+      AppendFrameHeader(out, message.size(), kFrameTypeData, 0, id);
+      out.insert(out.end(), message.begin(), message.end());
+      AppendFrameHeader(out, 0, kFrameTypeData, kFlagEndStream, id);
+    }
+  }
+  return out;
+}
+
+// Stands in for the socket to a client. Reads return as much of the encoded
+// requests as fits, as a socket does when the client sends faster than the
+// server reads. Writes are parsed to count the completed calls.
+class FakeClientSocket : public stream::NonSeekableReaderWriter {
+ public:
+  explicit FakeClientSocket(ConstByteSpan requests) : requests_(requests) {}
+
+  void Reset() {
+    read_offset_ = 0;
+    completed_calls_ = 0;
+    num_writes_ = 0;
+  }
+
+  size_t completed_calls() const { return completed_calls_.load(); }
+  size_t num_writes() const { return num_writes_.load(); }
+
+ private:
+  StatusWithSize DoRead(ByteSpan destination) override {
+    if (read_offset_ == requests_.size()) {
+      return StatusWithSize::OutOfRange();
+    }
+    const size_t size =
+        std::min(destination.size(), requests_.size() - read_offset_);
+    std::copy_n(requests_.begin() + read_offset_, size, destination.begin());
+    read_offset_ += size;
+    return StatusWithSize(size);
+  }
+
+  // SendQueue writes whole frames.
+  Status DoWrite(ConstByteSpan data) override {
+    num_writes_.fetch_add(1);
+    while (data.size() >= internal::kFrameHeaderEncodedSize) {
+      const size_t payload_length = static_cast<size_t>(data[0]) << 16 |
+                                    static_cast<size_t>(data[1]) << 8 |
+                                    static_cast<size_t>(data[2]);
+      const auto type = static_cast<uint8_t>(data[3]);
+      const auto flags = static_cast<uint8_t>(data[4]);
+      if (type == kFrameTypeHeaders && (flags & kFlagEndStream) != 0) {
+        completed_calls_.fetch_add(1);
+      }
+      data = data.subspan(std::min(
+          data.size(), internal::kFrameHeaderEncodedSize + payload_length));
+    }
+    return OkStatus();
+  }
+
+  ConstByteSpan requests_;
+  size_t read_offset_ = 0;
+  std::atomic<size_t> completed_calls_ = 0;
+  std::atomic<size_t> num_writes_ = 0;
+};
+
+class EchoCallbacks : public Connection::RequestCallbacks {
+ public:
+  void set_connection(Connection& connection) { connection_ = &connection; }
+
+  void OnNewConnection() override {}
+
+  Status OnNew(StreamId, InlineString<kMaxMethodNameSize>) override {
+    return OkStatus();
+  }
+
+  Status OnMessage(StreamId id, ByteSpan message) override {
+    return connection_->SendResponseMessage(id, message);
+  }
+
+  void OnHalfClose(StreamId id) override {
+    connection_->SendResponseComplete(id, OkStatus()).IgnoreError();
+  }
+
+  void OnCancel(StreamId) override {}
+
+ private:
+  Connection* connection_ = nullptr;
+};
+
+void UnaryCalls(perf_test::State& state, size_t concurrency) {
+  const std::vector<std::byte> requests = EncodeRequests(concurrency);
+  FakeClientSocket socket(requests);
+
+  std::vector<std::byte> data_area(64 * 1024);
+  Allocator& allocator = allocator::GetLibCAllocator();
+  multibuf::SimpleAllocator multibuf_allocator(data_area, allocator);
+
+  SendQueue send_queue(socket);
+  thread::test::TestThreadContext send_thread_context;
+  Thread send_thread(send_thread_context.options(), send_queue);
+
+  EchoCallbacks callbacks;
+  size_t num_iterations = 0;
+  size_t num_writes = 0;
+  chrono::SystemClock::duration elapsed{};
+  while (state.KeepRunning()) {
+    const auto start = chrono::SystemClock::now();
+    socket.Reset();
+    Connection connection(socket,
+                          send_queue,
+                          callbacks,
+                          /*message_assembly_allocator=*/nullptr,
+                          multibuf_allocator);
+    callbacks.set_connection(connection);
+
+    PW_CHECK_OK(connection.ProcessConnectionPreface());
+    Status status;
+    while (status.ok()) {
+      status = connection.ProcessFrame();
+    }
+    PW_CHECK_INT_EQ(status.code(), PW_STATUS_OUT_OF_RANGE);
+    while (socket.completed_calls() < kNumCalls) {
+      this_thread::yield();
+    }
+
+    elapsed += chrono::SystemClock::now() - start;
+    num_writes += socket.num_writes();
+    ++num_iterations;
+  }
+
+  send_queue.RequestStop();
+  send_thread.join();
+
+  const auto elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  const uint64_t num_requests = uint64_t{kNumCalls} * num_iterations;
+  PW_LOG_INFO("%zu concurrent calls: %" PRIu64 " requests/s, %" PRIu64
+              " socket writes per 100 calls",
+              concurrency,
+              elapsed_us > 0
+                  ? num_requests * 1'000'000 / static_cast<uint64_t>(elapsed_us)
+                  : 0,
+              uint64_t{num_writes} * 100 / num_requests);
+}
+
+PW_PERF_TEST(UnaryCallsSequential, UnaryCalls, /*concurrency=*/1);
+PW_PERF_TEST(UnaryCallsConcurrent,
+             UnaryCalls,
+             /*concurrency=*/internal::kMaxConcurrentStreams);
+
+}  // namespace
+}  // namespace pw::grpc
@@ -20,6 +20,7 @@
 #include "pw_bytes/byte_builder.h"
 #include "pw_bytes/span.h"
 #include "pw_function/function.h"
+#include "pw_grpc/internal/config.h"
 #include "pw_grpc/send_queue.h"
 #include "pw_multibuf/allocator.h"
 #include "pw_multibuf/multibuf.h"
@@ -39,7 +40,11 @@ enum class Http2Error : uint32_t;
 
 // Parameters of this implementation.
 // RFC 9113 §5.1.2
-inline constexpr uint32_t kMaxConcurrentStreams = 16;
+inline constexpr uint32_t kMaxConcurrentStreams =
+    PW_GRPC_MAX_CONCURRENT_STREAMS;
+
+// RFC 9113 §4.1
+inline constexpr size_t kFrameHeaderEncodedSize = 9;
 
 // RFC 9113 §4.2 and §6.5.2
 inline constexpr uint32_t kMaxFramePayloadSize = 16384;
@@ -69,7 +74,9 @@ inline constexpr uint32_t kMaxMethodNameSize = 127;
 //   stream should be closed, the provided connection_close_callback will be
 //   called.
 // * Drive the connection by calling ProcessConnectionPreface then ProcessFrame
-//   in a loop while status is Ok on one thread.
+//   in a loop while status is Ok on one thread. Each call processes all of
+//   the complete frames received from the stream, and their responses are
+//   written to the stream together.
 // * RPC responses can be sent from any thread by calling
 //   SendResponseMessage/SendResponseComplete. The SendQueue object will
 //   handle concurrent access.
@@ -84,6 +91,9 @@ inline constexpr uint32_t kMaxMethodNameSize = 127;
 // provide a message_assembly_allocator, which will be used to allocate
 // temporary storage for fragmented gRPC messages when required. If no
 // allocator is provided, or allocation fails, the stream will be closed.
+//
+// Up to internal::kMaxConcurrentStreams concurrent streams are supported, set
+// by PW_GRPC_MAX_CONCURRENT_STREAMS.
 class Connection {
  public:
   // Callbacks invoked on requests from the client. Called on same thread as
@@ -126,8 +136,9 @@ class Connection {
     return reader_.ProcessConnectionPreface();
   }
 
-  // Reads from stream and processes next frame on connection. Returns OK
-  // as long as connection is open. Should be called from a single thread.
+  // Reads from stream and processes the next frames on connection: waits for
+  // a frame, then processes it and any other frames already received. Returns
+  // OK as long as connection is open. Should be called from a single thread.
   Status ProcessFrame() { return reader_.ProcessFrame(); }
 
   // Sends a response message for an RPC. The `message` will not be accessed
@@ -340,6 +351,24 @@ class Connection {
     Status ProcessIgnoredFrame(const internal::FrameHeader&);
     Result<ByteSpan> ReadFramePayload(const internal::FrameHeader&);
 
+    // Processes the next frame, which must have been received.
+    Status ProcessReceivedFrame();
+
+    // Reads from the stream until a frame has been received, or until the
+    // receive buffer is full for frames larger than it.
+    Status ReceiveFrame();
+
+    // Returns true if a complete frame has been received and not processed.
+    bool HasReceivedFrame() const;
+
+    // Reads from the stream until `size` bytes have been received and not
+    // consumed. `size` must not exceed the size of the receive buffer.
+    Status Receive(size_t size);
+
+    // Receives and consumes `size` bytes, returning a span of them in the
+    // receive buffer, which remains valid until the next Receive().
+    Result<ByteSpan> Consume(size_t size);
+
     // Send GOAWAY frame and signal connection should be closed.
     void SendGoAway(internal::Http2Error code);
     Status SendRstStreamAndClose(sync::BorrowedPointer<SharedState>& state,
@@ -351,7 +380,14 @@ class Connection {
     int32_t initial_send_window_ = kDefaultInitialWindowSize;
     bool received_connection_preface_ = false;
 
-    std::array<std::byte, internal::kMaxFramePayloadSize> payload_scratch_{};
+    // Bytes read from the stream. Frames are parsed in place, and bytes in
+    // [receive_start_, receive_end_) have been received but not consumed.
+    std::array<std::byte,
+               internal::kFrameHeaderEncodedSize +
+                   internal::kMaxFramePayloadSize>
+        receive_buffer_{};
+    size_t receive_start_ = 0;
+    size_t receive_end_ = 0;
     StreamId last_stream_id_ = 0;
   };
 
@@ -364,8 +400,10 @@ class Connection {
     static_cast<void>(moved_state);
   }
 
-  // Shared state that is thread-safe.
   stream::ReaderWriter& socket_;
+  SendQueue& send_queue_;
+
+  // Shared state that is thread-safe.
 
   sync::InlineBorrowable<SharedState> shared_state_;
   Reader reader_;
@@ -0,0 +1,24 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+// Maximum number of concurrent streams per connection, advertised to the client
+// in SETTINGS_MAX_CONCURRENT_STREAMS. The state of each stream is held inline
+// by Connection and PwRpcHandler.
+#ifndef PW_GRPC_MAX_CONCURRENT_STREAMS
+#define PW_GRPC_MAX_CONCURRENT_STREAMS 16
+#endif  // PW_GRPC_MAX_CONCURRENT_STREAMS
+
+static_assert(PW_GRPC_MAX_CONCURRENT_STREAMS > 0);
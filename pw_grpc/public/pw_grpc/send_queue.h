@@ -13,6 +13,8 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <optional>
 
 #include "pw_async/dispatcher.h"
@@ -29,8 +31,15 @@ namespace pw::grpc {
 // SendQueue is a queue+thread that serializes sending MultiBuf's to
 // a blocking stream. The queue length is implicitly limited by the allocator
 // that is creating the multibuf's to send.
+//
+// Buffers queued while sends are held are written together, with small buffers
+// coalesced into a single socket write. Other buffers are written directly.
 class SendQueue : public thread::ThreadCore {
  public:
+  // Held buffers up to this size are copied into a write buffer and written to
+  // the socket together. Larger buffers are written directly.
+  static constexpr size_t kWriteBufferSize = 1024;
+
   SendQueue(stream::ReaderWriter& socket)
       : socket_(socket),
         send_task_(pw::bind_member<&SendQueue::ProcessSendQueue>(this)) {}
@@ -38,6 +47,12 @@ class SendQueue : public thread::ThreadCore {
   // Thread safe. Queues buffer to be sent on send thread.
   void QueueSend(multibuf::MultiBuf&& buffer) PW_LOCKS_EXCLUDED(send_mutex_);
 
+  // Thread safe. Holds queued buffers until the matching ReleaseSends(), so
+  // that buffers queued in between are written together. Sending starts
+  // anyway once kWriteBufferSize bytes are held. Calls may be nested.
+  void HoldSends() PW_LOCKS_EXCLUDED(send_mutex_);
+  void ReleaseSends() PW_LOCKS_EXCLUDED(send_mutex_);
+
   // ThreadCore impl.
   void Run() override { send_dispatcher_.Run(); }
   // Call before attempting to join thread.
@@ -47,11 +62,25 @@ class SendQueue : public thread::ThreadCore {
   void ProcessSendQueue(async::Context& context, Status status)
       PW_LOCKS_EXCLUDED(send_mutex_);
 
+  // Writes out the bytes in write_buffer_. Only called on the send thread.
+  Status FlushWriteBuffer();
+
+  // Posts the send task to write the queued buffers.
+  void PostSendTask() PW_EXCLUSIVE_LOCKS_REQUIRED(send_mutex_);
+
   stream::ReaderWriter& socket_;
   async::BasicDispatcher send_dispatcher_;
   async::Task send_task_;
   sync::Mutex send_mutex_;
   multibuf::MultiBuf buffer_to_write_ PW_GUARDED_BY(send_mutex_);
+  size_t queued_bytes_ PW_GUARDED_BY(send_mutex_) = 0;
+  size_t hold_count_ PW_GUARDED_BY(send_mutex_) = 0;
+  // Whether buffer_to_write_ holds buffers queued while sends were held.
+  bool held_ PW_GUARDED_BY(send_mutex_) = false;
+
+  // Only accessed on the send thread.
+  std::array<std::byte, kWriteBufferSize> write_buffer_;
+  size_t write_buffer_size_ = 0;
 };
 
 }  // namespace pw::grpc
@@ -14,6 +14,9 @@
 
 #include "pw_grpc/send_queue.h"
 
+#include <algorithm>
+
+#include "pw_assert/check.h"
 #include "pw_log/log.h"
 #include "pw_status/try.h"
 
@@ -25,24 +28,99 @@ void SendQueue::ProcessSendQueue(async::Context&, Status task_status) {
   }
 
   multibuf::MultiBuf buffer;
+  bool held;
   {
     std::lock_guard lock(send_mutex_);
     if (buffer_to_write_.empty()) {
       return;
     }
     buffer = std::move(buffer_to_write_);
+    queued_bytes_ = 0;
+    held = held_;
+    held_ = false;
+  }
+
+  if (!held) {
+    // Nothing to coalesce with, so write the buffers without copying them.
+    for (const auto& chunk : buffer.Chunks()) {
+      if (Status status = socket_.Write(chunk); !status.ok()) {
+        PW_LOG_ERROR("Failed to write to socket in SendQueue: %s",
+                     status.str());
+        return;
+      }
+    }
+    return;
   }
+
+  // Held buffers are typically many small frames, so copy them into the write
+  // buffer to write them with as few socket writes as possible.
+  Status status;
   for (const auto& chunk : buffer.Chunks()) {
-    if (Status status = socket_.Write(chunk); !status.ok()) {
-      PW_LOG_ERROR("Failed to write to socket in SendQueue: %s", status.str());
-      return;
+    if (chunk.size() > write_buffer_.size() - write_buffer_size_) {
+      status = FlushWriteBuffer();
+      if (!status.ok()) {
+        break;
+      }
+    }
+    if (chunk.size() > write_buffer_.size()) {
+      status = socket_.Write(chunk);
+      if (!status.ok()) {
+        break;
+      }
+      continue;
     }
+    std::copy(chunk.begin(),
+              chunk.end(),
+              write_buffer_.begin() + write_buffer_size_);
+    write_buffer_size_ += chunk.size();
+  }
+  if (status.ok()) {
+    status = FlushWriteBuffer();
+  }
+  if (!status.ok()) {
+    write_buffer_size_ = 0;
+    PW_LOG_ERROR("Failed to write to socket in SendQueue: %s", status.str());
+  }
+}
+
+Status SendQueue::FlushWriteBuffer() {
+  if (write_buffer_size_ == 0) {
+    return OkStatus();
   }
+  const size_t size = write_buffer_size_;
+  write_buffer_size_ = 0;
+  return socket_.Write(span(write_buffer_).first(size));
 }
 
 void SendQueue::QueueSend(multibuf::MultiBuf&& buffer) {
   std::lock_guard lock(send_mutex_);
+  queued_bytes_ += buffer.size();
   buffer_to_write_.PushSuffix(std::move(buffer));
+  if (hold_count_ > 0) {
+    held_ = true;
+  }
+  // Don't hold more than a write buffer's worth of data, so that held sends
+  // don't exhaust the allocator the buffers are allocated from.
+  if (hold_count_ == 0 || queued_bytes_ >= kWriteBufferSize) {
+    PostSendTask();
+  }
+}
+
+void SendQueue::HoldSends() {
+  std::lock_guard lock(send_mutex_);
+  ++hold_count_;
+}
+
+void SendQueue::ReleaseSends() {
+  std::lock_guard lock(send_mutex_);
+  PW_CHECK_UINT_GT(hold_count_, 0);
+  --hold_count_;
+  if (hold_count_ == 0 && !buffer_to_write_.empty()) {
+    PostSendTask();
+  }
+}
+
+void SendQueue::PostSendTask() {
   send_dispatcher_.Cancel(send_task_);
   send_dispatcher_.Post(send_task_);
 }
@@ -0,0 +1,157 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_grpc/send_queue.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "pw_allocator/testing.h"
+#include "pw_bytes/span.h"
+#include "pw_multibuf/simple_allocator.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_stream/stream.h"
+#include "pw_sync/mutex.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/yield.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::grpc {
+namespace {
+
+using ::pw::allocator::test::AllocatorForTest;
+
+constexpr size_t kDataAreaSize = 4096;
+constexpr size_t kMetaSize = 4096;
+
+// Records each write as a separate buffer.
+class RecordingSocket : public stream::NonSeekableReaderWriter {
+ public:
+  size_t bytes_written() const { return bytes_written_.load(); }
+
+  std::vector<std::vector<std::byte>> writes() {
+    std::lock_guard lock(mutex_);
+    return writes_;
+  }
+
+ private:
+  StatusWithSize DoRead(ByteSpan) override { return StatusWithSize(0); }
+
+  Status DoWrite(ConstByteSpan data) override {
+    {
+      std::lock_guard lock(mutex_);
+      writes_.emplace_back(data.begin(), data.end());
+    }
+    bytes_written_.fetch_add(data.size());
+    return OkStatus();
+  }
+
+  sync::Mutex mutex_;
+  std::vector<std::vector<std::byte>> writes_;
+  std::atomic<size_t> bytes_written_ = 0;
+};
+
+class SendQueueTest : public ::testing::Test {
+ protected:
+  SendQueueTest() : multibuf_allocator_(data_area_, meta_alloc_) {}
+
+  // Queues a buffer of `size` bytes, all set to `value`.
+  void QueueSend(size_t size, std::byte value) {
+    std::optional<multibuf::MultiBuf> buffer =
+        multibuf_allocator_.AllocateContiguous(size);
+    ASSERT_TRUE(buffer.has_value());
+    for (std::byte& byte : *buffer) {
+      byte = value;
+    }
+    send_queue_.QueueSend(std::move(*buffer));
+  }
+
+  // Runs the send thread until `size` bytes have been written.
+  void SendUntilWritten(size_t size) {
+    Thread send_thread(send_thread_context_.options(), send_queue_);
+    while (socket_.bytes_written() < size) {
+      this_thread::yield();
+    }
+    send_queue_.RequestStop();
+    send_thread.join();
+  }
+
+  std::array<std::byte, kDataAreaSize> data_area_{};
+  AllocatorForTest<kMetaSize> meta_alloc_;
+  multibuf::SimpleAllocator multibuf_allocator_;
+  RecordingSocket socket_;
+  SendQueue send_queue_{socket_};
+  thread::test::TestThreadContext send_thread_context_;
+};
+
+TEST_F(SendQueueTest, SendsWithoutHoldAreWrittenDirectly) {
+  QueueSend(10, std::byte{1});
+  QueueSend(20, std::byte{2});
+  SendUntilWritten(30);
+
+  const auto writes = socket_.writes();
+  ASSERT_EQ(writes.size(), 2u);
+  EXPECT_EQ(writes[0], std::vector<std::byte>(10, std::byte{1}));
+  EXPECT_EQ(writes[1], std::vector<std::byte>(20, std::byte{2}));
+}
+
+TEST_F(SendQueueTest, HeldSendsAreCoalesced) {
+  send_queue_.HoldSends();
+  QueueSend(10, std::byte{1});
+  QueueSend(20, std::byte{2});
+  send_queue_.ReleaseSends();
+  SendUntilWritten(30);
+
+  std::vector<std::byte> expected(10, std::byte{1});
+  expected.resize(30, std::byte{2});
+  const auto writes = socket_.writes();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_EQ(writes[0], expected);
+}
+
+TEST_F(SendQueueTest, HeldSendsAreWrittenOnceWriteBufferIsFull) {
+  constexpr size_t kHalf = SendQueue::kWriteBufferSize / 2;
+  send_queue_.HoldSends();
+  QueueSend(kHalf, std::byte{1});
+  QueueSend(kHalf, std::byte{2});
+  SendUntilWritten(2 * kHalf);
+  send_queue_.ReleaseSends();
+
+  const auto writes = socket_.writes();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_EQ(writes[0].size(), 2 * kHalf);
+}
+
+TEST_F(SendQueueTest, HeldSendsLargerThanWriteBufferAreWrittenDirectly) {
+  constexpr size_t kLarge = SendQueue::kWriteBufferSize + 1;
+  send_queue_.HoldSends();
+  QueueSend(10, std::byte{1});
+  QueueSend(kLarge, std::byte{2});
+  send_queue_.ReleaseSends();
+  SendUntilWritten(10 + kLarge);
+
+  const auto writes = socket_.writes();
+  ASSERT_EQ(writes.size(), 2u);
+  EXPECT_EQ(writes[0], std::vector<std::byte>(10, std::byte{1}));
+  EXPECT_EQ(writes[1], std::vector<std::byte>(kLarge, std::byte{2}));
+}
+
+}  // namespace
+}  // namespace pw::grpc
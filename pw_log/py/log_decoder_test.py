@@ -115,6 +115,16 @@ def _create_drop_count_message_log_entry(
     return log_entry
 
 
+def _compress_literals(data: bytes) -> bytes:
+    """Encodes data as an LZ4 block made of a single literal run."""
+    if len(data) < 15:
+        return bytes([len(data) << 4]) + data
+    length = len(data) - 15
+    return bytes([0xF0]) + b'\xff' * (length // 255) + bytes(
+        [length % 255]
+    ) + data
+
+
 class TestLogStreamDecoderBase(TestCase):
     """Base Test class for LogStreamDecoder."""
 
@@ -867,6 +877,58 @@ class TestLogStreamDecoderLogDropDetectionFunctionality(
             self.captured_logs[2].message,
         )
 
+    def test_parse_compressed_log_entries(self) -> None:
+        """Tests that compressed entries are decompressed and parsed."""
+        entries = [_create_random_log_entry() for _ in range(4)]
+        compressed = _compress_literals(
+            log_pb2.LogEntries(entries=entries).SerializeToString()
+        )
+        self.decoder.parse_log_entries_proto(
+            log_pb2.LogEntries(
+                first_entry_sequence_id=0, compressed_entries=compressed
+            )
+        )
+        self.decoder.parse_log_entries_proto(
+            log_pb2.LogEntries(
+                first_entry_sequence_id=len(entries),
+                compressed_entries=compressed,
+            )
+        )
+
+        # No drops are detected, since the sequence IDs account for the
+        # compressed entries.
+        self.assertEqual(
+            [log.message for log in self.captured_logs],
+            [entry.message.decode() for entry in entries] * 2,
+            msg=self._captured_logs_as_str(),
+        )
+
+    def test_parse_malformed_compressed_log_entries(self) -> None:
+        """Tests that malformed compressed entries are reported as drops."""
+        self.decoder.parse_log_entries_proto(
+            log_pb2.LogEntries(
+                first_entry_sequence_id=0,
+                compressed_entries=b'\x4fnot compressed',
+            )
+        )
+        self.decoder.parse_log_entries_proto(
+            log_pb2.LogEntries(
+                first_entry_sequence_id=3,
+                entries=[_create_random_log_entry()],
+            )
+        )
+
+        self.assertEqual(
+            len(self.captured_logs), 2, msg=self._captured_logs_as_str()
+        )
+        self.assertEqual(
+            (
+                'Dropped 3 logs due to '
+                f'{LogStreamDecoder.DROP_REASON_SOURCE_NOT_CONNECTED}'
+            ),
+            self.captured_logs[0].message,
+        )
+
 
 class TestTimestampFormatting(TestCase):
     """Tests for log_decoder.timestamp_parser_* functions."""
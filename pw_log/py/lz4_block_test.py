@@ -0,0 +1,79 @@
+# Copyright 2025 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+
+"""Tests for the LZ4 block decompressor."""
+
+import unittest
+
+from pw_log import lz4_block
+
+
+def _literals_block(data: bytes) -> bytes:
+    """Encodes data as an LZ4 block made of a single literal run."""
+    if len(data) < 15:
+        return bytes([len(data) << 4]) + data
+    length = len(data) - 15
+    extra_length = b'\xff' * (length // 255) + bytes([length % 255])
+    return b'\xf0' + extra_length + data
+
+
+class Lz4BlockTest(unittest.TestCase):
+    """Tests decompressing LZ4 blocks."""
+
+    def test_empty_block(self) -> None:
+        self.assertEqual(lz4_block.decompress(b''), b'')
+        self.assertEqual(lz4_block.decompress(b'\x00'), b'')
+
+    def test_literals(self) -> None:
+        for size in (1, 14, 15, 16, 269, 270, 271, 600):
+            data = bytes(i % 251 for i in range(size))
+            self.assertEqual(lz4_block.decompress(_literals_block(data)), data)
+
+    def test_overlapping_match(self) -> None:
+        block = b'\x35abc\x03\x00\x60abcabc'
+        self.assertEqual(lz4_block.decompress(block), b'abc' * 6)
+
+    def test_long_match(self) -> None:
+        # One literal, then a 300-byte match of the previous byte.
+        block = b'\x1fa\x01\x00' + bytes([0xFF, 300 - 4 - 15 - 0xFF]) + b'\x00'
+        self.assertEqual(lz4_block.decompress(block), b'a' * 301)
+
+    def test_non_overlapping_match(self) -> None:
+        block = b'\x62abcdef\x06\x00\x20gh'
+        self.assertEqual(lz4_block.decompress(block), b'abcdefabcdefgh')
+
+    def test_max_size(self) -> None:
+        block = b'\x35abc\x03\x00\x60abcabc'
+        self.assertEqual(len(lz4_block.decompress(block, max_size=18)), 18)
+        with self.assertRaises(lz4_block.DecompressionError):
+            lz4_block.decompress(block, max_size=17)
+        with self.assertRaises(lz4_block.DecompressionError):
+            lz4_block.decompress(block, max_size=10)
+
+    def test_malformed(self) -> None:
+        for block in (
+            b'\x40a',  # Literals extend past the end.
+            b'\x10a\x02\x00',  # Offset before the start of the output.
+            b'\x10a\x00\x00',  # Zero offset.
+            b'\x10a\x01',  # Truncated offset.
+            b'\xf0',  # Truncated literal length.
+            b'\x1fa\x01\x00\xff',  # Truncated match length.
+        ):
+            with self.subTest(block=block):
+                with self.assertRaises(lz4_block.DecompressionError):
+                    lz4_block.decompress(block)
+
+
+if __name__ == '__main__':
+    unittest.main()
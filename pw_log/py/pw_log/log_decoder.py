@@ -20,6 +20,9 @@ import logging
 import re
 from typing import Any, Callable
 
+from google.protobuf.message import DecodeError
+
+from pw_log import lz4_block
 from pw_log.proto import log_pb2
 import pw_log_tokenized
 import pw_status
@@ -310,6 +313,9 @@ class LogStreamDecoder:
         Returns:
             A Log object with the decoded log_entry_proto.
         """
+        if log_entries_proto.compressed_entries:
+            log_entries_proto = self._decompress_log_entries(log_entries_proto)
+
         has_received_logs = self._expected_log_sequence_id > 0
         dropped_log_count = self._calculate_dropped_logs(log_entries_proto)
         if dropped_log_count > 0:
@@ -336,6 +342,25 @@ class LogStreamDecoder:
             parsed_log = self.parse_log_entry_proto(log_entry_proto)
             self.decoded_log_handler(parsed_log)
 
+    @staticmethod
+    def _decompress_log_entries(
+        log_entries_proto: log_pb2.LogEntries,
+    ) -> log_pb2.LogEntries:
+        """Returns the LogEntries with its compressed entries decompressed."""
+        decompressed = log_pb2.LogEntries(
+            entries=log_entries_proto.entries,
+            first_entry_sequence_id=log_entries_proto.first_entry_sequence_id,
+        )
+        try:
+            compressed_entries = log_pb2.LogEntries.FromString(
+                lz4_block.decompress(log_entries_proto.compressed_entries)
+            )
+        except (lz4_block.DecompressionError, DecodeError) as err:
+            _LOG.error('Failed to decompress log entries: %s', err)
+            return decompressed
+        decompressed.entries.extend(compressed_entries.entries)
+        return decompressed
+
     def parse_log_entry_proto(self, log_entry_proto: log_pb2.LogEntry) -> Log:
         """Parses the log_entry_proto contents into a human readable format.
 
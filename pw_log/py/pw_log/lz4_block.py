@@ -0,0 +1,87 @@
+# Copyright 2025 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+
+"""Decompresses LZ4 blocks, as used for compressed LogEntries bundles."""
+
+_MIN_MATCH = 4
+_RUN_MASK = 0xF
+
+
+class DecompressionError(Exception):
+    """Raised when a compressed block is malformed."""
+
+
+def _read_length(block: bytes, index: int, length: int) -> tuple[int, int]:
+    """Reads the bytes that extend a length nibble of 15 or more."""
+    if length < _RUN_MASK:
+        return index, length
+    while True:
+        if index >= len(block):
+            raise DecompressionError('Truncated length')
+        byte = block[index]
+        index += 1
+        length += byte
+        if byte != 0xFF:
+            return index, length
+
+
+def decompress(block: bytes, max_size: int | None = None) -> bytes:
+    """Decompresses an LZ4 block.
+
+    Args:
+        block: The compressed block, without any LZ4 frame.
+        max_size: Optional limit on the size of the decompressed data.
+
+    Raises:
+        DecompressionError: The block is malformed or decompresses to more than
+          max_size bytes.
+    """
+    output = bytearray()
+    index = 0
+    while index < len(block):
+        token = block[index]
+        index += 1
+
+        index, literal_length = _read_length(block, index, token >> 4)
+        if literal_length > len(block) - index:
+            raise DecompressionError('Literals extend past the end of block')
+        output += block[index : index + literal_length]
+        index += literal_length
+
+        # The last sequence has no match.
+        if index == len(block):
+            break
+
+        if len(block) - index < 2:
+            raise DecompressionError('Truncated match offset')
+        offset = block[index] | (block[index + 1] << 8)
+        index += 2
+        if offset == 0 or offset > len(output):
+            raise DecompressionError(f'Invalid match offset {offset}')
+        index, match_length = _read_length(block, index, token & _RUN_MASK)
+        match_length += _MIN_MATCH
+
+        if max_size is not None and len(output) + match_length > max_size:
+            raise DecompressionError('Decompressed data is too large')
+        start = len(output) - offset
+        if match_length <= offset:
+            output += output[start : start + match_length]
+        else:
+            # The match overlaps the bytes it produces.
+            for i in range(match_length):
+                output.append(output[start + i])
+
+    if max_size is not None and len(output) > max_size:
+        raise DecompressionError('Decompressed data is too large')
+    return bytes(output)
@@ -0,0 +1,209 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_log_rpc/log_bundle_compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace pw::log_rpc {
+namespace {
+
+// Constants from the LZ4 block format.
+constexpr size_t kMinMatch = 4;
+// The last match must start at least this many bytes before the end.
+constexpr size_t kMatchLimit = 12;
+// The last bytes are always literals.
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMaxOffset = 0xffff;
+constexpr unsigned kRunMask = 0xf;
+
+uint32_t Read32(const std::byte* data) {
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+size_t Hash(uint32_t sequence, size_t hash_bits) {
+  return (sequence * 2654435761u) >> (32 - hash_bits);
+}
+
+// Writes LZ4 blocks, tracking whether they fit in the output.
+class BlockWriter {
+ public:
+  explicit BlockWriter(ByteSpan output) : output_(output) {}
+
+  bool ok() const { return ok_; }
+  size_t size() const { return size_; }
+
+  // Writes a sequence of literals, followed by a match unless this is the last
+  // sequence.
+  void WriteSequence(ConstByteSpan literals,
+                     size_t match_offset = 0,
+                     size_t match_length = 0) {
+    const size_t match_code = match_length == 0 ? 0 : match_length - kMinMatch;
+    const size_t token = (std::min<size_t>(literals.size(), kRunMask) << 4) |
+                         std::min<size_t>(match_code, kRunMask);
+    WriteByte(token);
+    WriteLength(literals.size());
+    if (!Reserve(literals.size())) {
+      return;
+    }
+    std::memcpy(&output_[size_], literals.data(), literals.size());
+    size_ += literals.size();
+    if (match_length == 0) {
+      return;
+    }
+    WriteByte(match_offset & 0xff);
+    WriteByte(match_offset >> 8);
+    WriteLength(match_code);
+  }
+
+ private:
+  bool Reserve(size_t bytes) {
+    ok_ = ok_ && bytes <= output_.size() - size_;
+    return ok_;
+  }
+
+  void WriteByte(size_t value) {
+    if (Reserve(1)) {
+      output_[size_++] = static_cast<std::byte>(value);
+    }
+  }
+
+  // Writes the bytes that extend a length that does not fit in a token nibble.
+  void WriteLength(size_t length) {
+    if (length < kRunMask) {
+      return;
+    }
+    for (length -= kRunMask; length >= 0xff; length -= 0xff) {
+      WriteByte(0xff);
+    }
+    WriteByte(length);
+  }
+
+  ByteSpan output_;
+  size_t size_ = 0;
+  bool ok_ = true;
+};
+
+// Reads a length that does not fit in a token nibble.
+bool ReadLength(ConstByteSpan input, size_t& index, size_t& length) {
+  if (length < kRunMask) {
+    return true;
+  }
+  uint8_t byte;
+  do {
+    if (index >= input.size()) {
+      return false;
+    }
+    byte = static_cast<uint8_t>(input[index++]);
+    length += byte;
+  } while (byte == 0xff);
+  return true;
+}
+
+}  // namespace
+
+Result<ConstByteSpan> LogBundleCompressor::Compress(ConstByteSpan bundle) {
+  if (bundle.size() > kMaxBundleSize) {
+    return Status::OutOfRange();
+  }
+
+  BlockWriter writer(buffer_);
+  size_t anchor = 0;
+  if (bundle.size() > kMatchLimit) {
+    positions_ = {};
+    const std::byte* data = bundle.data();
+    const size_t last_match_start = bundle.size() - kMatchLimit;
+    const size_t last_match_end = bundle.size() - kLastLiterals;
+    size_t position = 0;
+    while (position <= last_match_start && writer.ok()) {
+      const uint32_t sequence = Read32(data + position);
+      uint16_t& entry = positions_[Hash(sequence, cfg::kCompressionHashBits)];
+      const size_t candidate = entry;
+      entry = static_cast<uint16_t>(position);
+      if (candidate >= position || position - candidate > kMaxOffset ||
+          Read32(data + candidate) != sequence) {
+        ++position;
+        continue;
+      }
+
+      size_t length = kMinMatch;
+      while (position + length < last_match_end &&
+             data[candidate + length] == data[position + length]) {
+        ++length;
+      }
+      writer.WriteSequence(bundle.subspan(anchor, position - anchor),
+                           position - candidate,
+                           length);
+      position += length;
+      anchor = position;
+    }
+  }
+  writer.WriteSequence(bundle.subspan(anchor));
+
+  if (!writer.ok()) {
+    return Status::ResourceExhausted();
+  }
+  return ConstByteSpan(buffer_.first(writer.size()));
+}
+
+StatusWithSize DecompressLogBundle(ConstByteSpan compressed, ByteSpan output) {
+  size_t in = 0;
+  size_t out = 0;
+  while (in < compressed.size()) {
+    const auto token = static_cast<uint8_t>(compressed[in++]);
+
+    size_t literal_length = token >> 4;
+    if (!ReadLength(compressed, in, literal_length) ||
+        literal_length > compressed.size() - in) {
+      return StatusWithSize::DataLoss(out);
+    }
+    if (literal_length > output.size() - out) {
+      return StatusWithSize::ResourceExhausted(out);
+    }
+    std::memcpy(&output[out], &compressed[in], literal_length);
+    in += literal_length;
+    out += literal_length;
+
+    // The last sequence has no match.
+    if (in == compressed.size()) {
+      break;
+    }
+
+    if (compressed.size() - in < 2) {
+      return StatusWithSize::DataLoss(out);
+    }
+    const size_t offset = static_cast<size_t>(compressed[in]) |
+                          (static_cast<size_t>(compressed[in + 1]) << 8);
+    in += 2;
+    size_t match_length = token & kRunMask;
+    if (offset == 0 || offset > out ||
+        !ReadLength(compressed, in, match_length)) {
+      return StatusWithSize::DataLoss(out);
+    }
+    match_length += kMinMatch;
+    if (match_length > output.size() - out) {
+      return StatusWithSize::ResourceExhausted(out);
+    }
+    // Copy byte by byte, since matches may overlap the bytes they produce.
+    for (size_t i = 0; i < match_length; ++i, ++out) {
+      output[out] = output[out - offset];
+    }
+  }
+  return StatusWithSize(out);
+}
+
+}  // namespace pw::log_rpc
@@ -0,0 +1,132 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/span.h"
+#include "pw_log/levels.h"
+#include "pw_log/log.h"
+#include "pw_log/proto/log.pwpb.h"
+#include "pw_log/proto_utils.h"
+#include "pw_log_rpc/log_bundle_compression.h"
+#include "pw_log_tokenized/metadata.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::log_rpc {
+namespace {
+
+// Measures compressing and decompressing log bundles of the size a drain
+// typically sends, with text and with tokenized log messages. The compressed
+// size of each bundle is logged once.
+
+constexpr size_t kBundleSize = 512;
+constexpr std::string_view kModules[] = {"net", "ui", "rpc", "fs"};
+constexpr std::string_view kThreads[] = {"main", "rpc", "worker"};
+constexpr std::string_view kMessages[] = {
+    "Connected to access point",
+    "Received 128 bytes on channel 3",
+    "Battery level at 87%",
+    "Flushed 4 pages to flash",
+    "Received 64 bytes on channel 1",
+};
+
+struct Bundle {
+  explicit Bundle(bool tokenized) {
+    log::pwpb::LogEntries::MemoryEncoder encoder(buffer);
+    for (size_t i = 0;; ++i) {
+      std::array<std::byte, 96> entry_buffer;
+      Result<ConstByteSpan> entry = Status::Unknown();
+      if (tokenized) {
+        // Tokenized messages are a 4-byte token and a few varint arguments.
+        const std::array<uint8_t, 6> message = {
+            0x3a,
+            0x91,
+            static_cast<uint8_t>(0x10 + i % 5),
+            0x7c,
+            static_cast<uint8_t>(i * 2),
+            0x06};
+        entry = log::EncodeTokenizedLog(
+            log_tokenized::Metadata::Set<PW_LOG_LEVEL_INFO, 5, 0, 0>(),
+            as_bytes(span(message)),
+            static_cast<int64_t>(100000 + i * 1234),
+            entry_buffer);
+      } else {
+        entry = log::EncodeLog(PW_LOG_LEVEL_INFO,
+                               0,
+                               kModules[i % 4],
+                               kThreads[i % 3],
+                               "pw_example/service.cc",
+                               static_cast<int>(100 + i % 7),
+                               static_cast<int64_t>(100000 + i * 1234),
+                               kMessages[i % 5],
+                               entry_buffer);
+      }
+      PW_CHECK_OK(entry.status());
+      if (encoder.size() + entry.value().size() + 2 > kBundleSize) {
+        break;
+      }
+      PW_CHECK_OK(encoder.WriteBytes(
+          static_cast<uint32_t>(log::pwpb::LogEntries::Fields::kEntries),
+          entry.value()));
+    }
+    size = encoder.size();
+  }
+
+  std::array<std::byte, kBundleSize> buffer;
+  size_t size;
+
+  ConstByteSpan entries() const { return span(buffer).first(size); }
+};
+
+void Compress(perf_test::State& state, bool tokenized) {
+  const Bundle bundle(tokenized);
+  std::array<std::byte, kBundleSize> compressed_buffer;
+  LogBundleCompressor compressor(compressed_buffer);
+  size_t compressed_size = 0;
+  while (state.KeepRunning()) {
+    Result<ConstByteSpan> compressed = compressor.Compress(bundle.entries());
+    compressed_size = compressed.value_or(ConstByteSpan()).size();
+  }
+  PW_LOG_INFO("Compressed %u-byte %s bundle to %u bytes",
+              static_cast<unsigned>(bundle.size),
+              tokenized ? "tokenized" : "text",
+              static_cast<unsigned>(compressed_size));
+}
+
+void Decompress(perf_test::State& state, bool tokenized) {
+  const Bundle bundle(tokenized);
+  std::array<std::byte, kBundleSize> compressed_buffer;
+  LogBundleCompressor compressor(compressed_buffer);
+  Result<ConstByteSpan> compressed = compressor.Compress(bundle.entries());
+  PW_CHECK_OK(compressed.status());
+  std::array<std::byte, kBundleSize> decompressed;
+  size_t decompressed_size = 0;
+  while (state.KeepRunning()) {
+    decompressed_size =
+        DecompressLogBundle(compressed.value(), decompressed).size();
+  }
+  PW_CHECK_UINT_EQ(decompressed_size, bundle.size);
+}
+
+PW_PERF_TEST(CompressTextBundle, Compress, false);
+PW_PERF_TEST(CompressTokenizedBundle, Compress, true);
+PW_PERF_TEST(DecompressTextBundle, Decompress, false);
+PW_PERF_TEST(DecompressTokenizedBundle, Decompress, true);
+
+}  // namespace
+}  // namespace pw::log_rpc
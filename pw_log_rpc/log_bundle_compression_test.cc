@@ -0,0 +1,158 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_log_rpc/log_bundle_compression.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "pw_bytes/array.h"
+#include "pw_bytes/span.h"
+#include "pw_log/levels.h"
+#include "pw_log/proto_utils.h"
+#include "pw_status/status.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::log_rpc {
+namespace {
+
+ConstByteSpan AsBytes(std::string_view text) { return as_bytes(span(text)); }
+
+// Compresses and decompresses data, checking that it is unchanged.
+template <size_t kBufferSize = 1024>
+size_t RoundTrip(ConstByteSpan data) {
+  std::array<std::byte, kBufferSize> compressed_buffer;
+  LogBundleCompressor compressor(compressed_buffer);
+  Result<ConstByteSpan> compressed = compressor.Compress(data);
+  EXPECT_EQ(compressed.status(), OkStatus());
+  if (!compressed.ok()) {
+    return 0;
+  }
+
+  std::array<std::byte, kBufferSize> decompressed;
+  StatusWithSize result = DecompressLogBundle(*compressed, decompressed);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), data.size());
+  EXPECT_EQ(std::memcmp(decompressed.data(), data.data(), data.size()), 0);
+  return compressed->size();
+}
+
+TEST(LogBundleCompression, EmptyBundle) {
+  EXPECT_EQ(RoundTrip({}), 1u);
+}
+
+TEST(LogBundleCompression, ShortBundleIsLiterals) {
+  EXPECT_EQ(RoundTrip(AsBytes("aaaaaaaaaaaa")), 13u);
+}
+
+TEST(LogBundleCompression, RepeatedDataIsSmaller) {
+  EXPECT_LT(RoundTrip(AsBytes("module=net thread=rx module=net thread=rx "
+                              "module=net thread=rx module=net thread=rx")),
+            40u);
+}
+
+TEST(LogBundleCompression, LongLiteralsAndMatches) {
+  std::array<std::byte, 700> data;
+  // 300 bytes without 4-byte repeats, followed by a long run.
+  for (size_t i = 0; i < 300; ++i) {
+    data[i] = static_cast<std::byte>((i * 7919u) >> 3);
+  }
+  for (size_t i = 300; i < data.size(); ++i) {
+    data[i] = std::byte{0x5a};
+  }
+  EXPECT_LT(RoundTrip(data), 320u);
+}
+
+TEST(LogBundleCompression, LogEntries) {
+  std::array<std::byte, 512> bundle;
+  size_t size = 0;
+  for (int i = 0; i < 8; ++i) {
+    std::array<std::byte, 64> entry_buffer;
+    const Result<ConstByteSpan> entry = log::EncodeLog(PW_LOG_LEVEL_INFO,
+                                                       0,
+                                                       "BLE",
+                                                       "host",
+                                                       "pw_bluetooth/l2cap.cc",
+                                                       100 + i,
+                                                       1000 * i,
+                                                       "Channel opened",
+                                                       entry_buffer);
+    ASSERT_EQ(entry.status(), OkStatus());
+    ASSERT_LE(size + entry->size(), bundle.size());
+    std::memcpy(&bundle[size], entry->data(), entry->size());
+    size += entry->size();
+  }
+  const size_t compressed_size = RoundTrip(span(bundle).first(size));
+  EXPECT_LT(compressed_size, size / 3);
+}
+
+TEST(LogBundleCompression, BufferTooSmall) {
+  std::array<std::byte, 8> compressed_buffer;
+  LogBundleCompressor compressor(compressed_buffer);
+  EXPECT_EQ(compressor.Compress(AsBytes("not compressible")).status(),
+            Status::ResourceExhausted());
+}
+
+TEST(LogBundleCompression, BundleTooLarge) {
+  static std::array<std::byte, LogBundleCompressor::kMaxBundleSize + 1> data;
+  LogBundleCompressor compressor(data);
+  EXPECT_EQ(compressor.Compress(data).status(), Status::OutOfRange());
+}
+
+TEST(LogBundleCompression, DecompressLz4Block) {
+  // "abcabcabcabcabcabc" as a literal run followed by an overlapping match.
+  constexpr auto kBlock = bytes::Array<0x35, 'a', 'b', 'c', 0x03, 0x00, 0x60,
+                                       'a', 'b', 'c', 'a', 'b', 'c'>();
+  std::array<std::byte, 32> output;
+  StatusWithSize result = DecompressLogBundle(kBlock, output);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(output.data()),
+                             result.size()),
+            "abcabcabcabcabcabc");
+}
+
+TEST(LogBundleCompression, DecompressOutputTooSmall) {
+  constexpr auto kBlock = bytes::Array<0x35, 'a', 'b', 'c', 0x03, 0x00, 0x60,
+                                       'a', 'b', 'c', 'a', 'b', 'c'>();
+  std::array<std::byte, 10> output;
+  EXPECT_EQ(DecompressLogBundle(kBlock, output).status(),
+            Status::ResourceExhausted());
+}
+
+TEST(LogBundleCompression, DecompressMalformed) {
+  std::array<std::byte, 32> output;
+  // Literals run past the end of the block.
+  EXPECT_EQ(DecompressLogBundle(bytes::Array<0x40, 'a'>(), output).status(),
+            Status::DataLoss());
+  // Offset points before the start of the output.
+  EXPECT_EQ(
+      DecompressLogBundle(bytes::Array<0x10, 'a', 0x02, 0x00>(), output)
+          .status(),
+      Status::DataLoss());
+  // Zero offset.
+  EXPECT_EQ(
+      DecompressLogBundle(bytes::Array<0x10, 'a', 0x00, 0x00>(), output)
+          .status(),
+      Status::DataLoss());
+  // Truncated offset.
+  EXPECT_EQ(DecompressLogBundle(bytes::Array<0x10, 'a', 0x01>(), output)
+                .status(),
+            Status::DataLoss());
+}
+
+}  // namespace
+}  // namespace pw::log_rpc
@@ -14,6 +14,7 @@
 
 #include "pw_log_rpc/log_filter.h"
 
+#include "lib/stdcompat/bit.h"
 #include "pw_log/levels.h"
 #include "pw_protobuf/decoder.h"
 #include "pw_status/try.h"
@@ -57,7 +58,15 @@ Status Filter::UpdateRulesFromProto(ConstByteSpan buffer) {
   if (rules_.empty()) {
     return Status::FailedPrecondition();
   }
+  // Rules are reset even if decoding fails partway, so always recompile them.
+  const Status status = DecodeRulesFromProto(buffer);
+  if (compiles_rules_) {
+    CompileRules();
+  }
+  return status;
+}
 
+Status Filter::DecodeRulesFromProto(ConstByteSpan buffer) {
   // Reset rules.
   for (auto& rule : rules_) {
     rule = {};
@@ -105,41 +114,118 @@ Status Filter::UpdateRulesFromProto(ConstByteSpan buffer) {
   return status.IsOutOfRange() ? OkStatus() : status;
 }
 
-bool Filter::ShouldDropLog(ConstByteSpan entry) const {
-  if (rules_.empty()) {
-    return false;
-  }
-
-  uint32_t log_level = 0;
-  ConstByteSpan log_module;
-  ConstByteSpan log_thread;
-  uint32_t log_flags = 0;
+LogEntryAttributes LogEntryAttributes::Decode(ConstByteSpan entry) {
+  LogEntryAttributes attributes;
   protobuf::Decoder decoder(entry);
   while (decoder.Next().ok()) {
     const auto field_num = static_cast<LogEntry::Fields>(decoder.FieldNumber());
 
     if (field_num == LogEntry::Fields::kLineLevel) {
-      if (decoder.ReadUint32(&log_level).ok()) {
-        log_level &= PW_LOG_LEVEL_BITMASK;
+      uint32_t line_level = 0;
+      if (decoder.ReadUint32(&line_level).ok()) {
+        attributes.level_ = line_level & PW_LOG_LEVEL_BITMASK;
       }
 
     } else if (field_num == LogEntry::Fields::kModule) {
-      decoder.ReadBytes(&log_module).IgnoreError();
+      ConstByteSpan module;
+      if (decoder.ReadBytes(&module).ok()) {
+        attributes.module_offset_ =
+            static_cast<uint32_t>(module.data() - entry.data());
+        attributes.module_size_ = static_cast<uint32_t>(module.size());
+        attributes.module_hash_ = Hash(module);
+      }
 
     } else if (field_num == LogEntry::Fields::kFlags) {
-      decoder.ReadUint32(&log_flags).IgnoreError();
+      decoder.ReadUint32(&attributes.flags_).IgnoreError();
 
     } else if (field_num == LogEntry::Fields::kThread) {
-      decoder.ReadBytes(&log_thread).IgnoreError();
+      ConstByteSpan thread;
+      if (decoder.ReadBytes(&thread).ok()) {
+        attributes.thread_offset_ =
+            static_cast<uint32_t>(thread.data() - entry.data());
+        attributes.thread_size_ = static_cast<uint32_t>(thread.size());
+        attributes.thread_hash_ = Hash(thread);
+      }
     }
   }
+  return attributes;
+}
+
+void Filter::CompileRules() {
+  compiles_rules_ = true;
+  compiled_ = rules_.size() <= kMaxCompiledRules;
+  rules_by_level_ = {};
+  rules_for_any_module_ = 0;
+  rules_for_any_thread_ = 0;
+  rules_by_module_ = {};
+  rules_by_thread_ = {};
+  if (!compiled_) {
+    return;
+  }
+
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    const Rule& rule = rules_[i];
+    if (rule.action == Rule::Action::kInactive) {
+      continue;
+    }
+    const uint32_t bit = 1u << i;
+    for (size_t level = 0; level < rules_by_level_.size(); ++level) {
+      if (level >= static_cast<uint32_t>(rule.level_greater_than_or_equal)) {
+        rules_by_level_[level] |= bit;
+      }
+    }
+    if (rule.module_equals.empty()) {
+      rules_for_any_module_ |= bit;
+    } else {
+      const uint32_t hash = LogEntryAttributes::Hash(
+          ConstByteSpan(rule.module_equals.data(), rule.module_equals.size()));
+      rules_by_module_[hash % kBuckets] |= bit;
+    }
+    if (rule.thread_equals.empty()) {
+      rules_for_any_thread_ |= bit;
+    } else {
+      const uint32_t hash = LogEntryAttributes::Hash(
+          ConstByteSpan(rule.thread_equals.data(), rule.thread_equals.size()));
+      rules_by_thread_[hash % kBuckets] |= bit;
+    }
+  }
+}
+
+uint32_t Filter::CandidateRules(const LogEntryAttributes& attributes) const {
+  return rules_by_level_[attributes.level() % rules_by_level_.size()] &
+         (rules_for_any_module_ |
+          rules_by_module_[attributes.module_hash() % kBuckets]) &
+         (rules_for_any_thread_ |
+          rules_by_thread_[attributes.thread_hash() % kBuckets]);
+}
+
+bool Filter::ShouldDropLog(ConstByteSpan entry,
+                           const LogEntryAttributes& attributes) const {
+  const ConstByteSpan module = attributes.module(entry);
+  const ConstByteSpan thread = attributes.thread(entry);
+
+  // Follow the action of the first rule whose condition is met. Compiled
+  // filters only check the rules whose level, module and thread hash may match,
+  // in the same order.
+  if (compiled_) {
+    for (uint32_t candidates = CandidateRules(attributes); candidates != 0;
+         candidates &= candidates - 1) {
+      const auto index = static_cast<size_t>(cpp20::countr_zero(candidates));
+      const Rule& rule = rules_[index];
+      if (IsRuleMet(
+              rule, attributes.level(), module, attributes.flags(), thread)) {
+        return rule.action == Rule::Action::kDrop;
+      }
+    }
+    return false;
+  }
 
-  // Follow the action of the first rule whose condition is met.
   for (const auto& rule : rules_) {
     if (rule.action == Filter::Rule::Action::kInactive) {
       continue;
     }
-    if (IsRuleMet(rule, log_level, log_module, log_flags, log_thread)) {
+    if (IsRuleMet(
+            rule, attributes.level(), module, attributes.flags(), thread)) {
       return rule.action == Filter::Rule::Action::kDrop;
     }
   }
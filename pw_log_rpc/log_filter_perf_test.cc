@@ -0,0 +1,163 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/span.h"
+#include "pw_log/proto_utils.h"
+#include "pw_log_rpc/log_entry_attributes_cache.h"
+#include "pw_log_rpc/log_filter.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::log_rpc {
+namespace {
+
+// Compares checking log entries against several drains' filters by decoding
+// each entry once per filter, by decoding it once for all filters, and by
+// sharing decoded attributes through a LogEntryAttributesCache.
+
+namespace FilterRule = ::pw::log::pwpb::FilterRule;
+
+constexpr size_t kNumFilters = 8;
+constexpr size_t kNumEntries = 16;
+constexpr std::string_view kNames[] = {
+    "net", "ui", "rpc", "fs", "ble", "usb", "pwr", "sys"};
+
+void AssignName(Vector<std::byte>& name, std::string_view value) {
+  name.clear();
+  for (char c : value) {
+    name.push_back(std::byte(c));
+  }
+}
+
+// Each filter keeps errors from every module, then drops or keeps the logs of
+// a few modules and threads.
+template <size_t kNumRules>
+struct Filters {
+  Filters() {
+    constexpr std::array<std::byte, 1> kId = {std::byte(1)};
+    for (size_t f = 0; f < kNumFilters; ++f) {
+      auto& rules = rules_by_filter[f];
+      rules[0].action = Filter::Rule::Action::kKeep;
+      rules[0].level_greater_than_or_equal = FilterRule::Level::ERROR_LEVEL;
+      for (size_t i = 1; i < kNumRules && i <= 16; ++i) {
+        rules[i].action = (i + f) % 2 == 0 ? Filter::Rule::Action::kDrop
+                                           : Filter::Rule::Action::kKeep;
+        rules[i].level_greater_than_or_equal =
+            static_cast<FilterRule::Level>(i % 4);
+        AssignName(rules[i].module_equals, kNames[(i + f) % 8]);
+        if (i % 2 == 0) {
+          AssignName(rules[i].thread_equals, kNames[i % 8]);
+        }
+      }
+      filters[f].emplace(span(kId), span(rules));
+      filters[f]->CompileRules();
+    }
+  }
+
+  std::array<std::array<Filter::Rule, kNumRules>, kNumFilters> rules_by_filter;
+  std::array<std::optional<Filter>, kNumFilters> filters;
+};
+
+struct Entries {
+  Entries() {
+    for (size_t i = 0; i < kNumEntries; ++i) {
+      auto result = log::EncodeLog(static_cast<int>(i % 8),
+                                   0,
+                                   kNames[i % 8],
+                                   kNames[(i * 3) % 8],
+                                   "",
+                                   0,
+                                   0,
+                                   "message",
+                                   buffers[i]);
+      PW_CHECK_OK(result.status());
+      entries[i] = result.value();
+    }
+  }
+
+  std::array<std::array<std::byte, 64>, kNumEntries> buffers;
+  std::array<ConstByteSpan, kNumEntries> entries;
+};
+
+template <size_t kNumRules>
+void DecodePerFilter(perf_test::State& state) {
+  Filters<kNumRules> filters;
+  Entries entries;
+  size_t dropped = 0;
+  while (state.KeepRunning()) {
+    for (ConstByteSpan entry : entries.entries) {
+      for (auto& filter : filters.filters) {
+        dropped += filter->ShouldDropLog(entry) ? 1 : 0;
+      }
+    }
+  }
+  PW_CHECK_UINT_NE(dropped, 1);
+}
+
+template <size_t kNumRules>
+void DecodeOnce(perf_test::State& state) {
+  Filters<kNumRules> filters;
+  Entries entries;
+  size_t dropped = 0;
+  while (state.KeepRunning()) {
+    for (ConstByteSpan entry : entries.entries) {
+      const LogEntryAttributes attributes = LogEntryAttributes::Decode(entry);
+      for (auto& filter : filters.filters) {
+        dropped += filter->ShouldDropLog(entry, attributes) ? 1 : 0;
+      }
+    }
+  }
+  PW_CHECK_UINT_NE(dropped, 1);
+}
+
+// Drains read every entry in turn, as RpcLogDrainThread flushes them.
+template <size_t kNumRules>
+void SharedCache(perf_test::State& state) {
+  Filters<kNumRules> filters;
+  Entries entries;
+  std::array<LogEntryAttributesCache::Slot, kNumEntries> slots;
+  LogEntryAttributesCache cache(slots);
+  uint32_t first_sequence_id = 0;
+  size_t dropped = 0;
+  while (state.KeepRunning()) {
+    for (auto& filter : filters.filters) {
+      uint32_t sequence_id = first_sequence_id;
+      for (ConstByteSpan entry : entries.entries) {
+        dropped +=
+            filter->ShouldDropLog(entry, cache.Get(sequence_id++, entry)) ? 1
+                                                                          : 0;
+      }
+    }
+    first_sequence_id += kNumEntries;
+  }
+  PW_CHECK_UINT_NE(dropped, 1);
+}
+
+// Filters with more than kMaxCompiledRules rules check every rule in order.
+constexpr size_t kUncompiled = Filter::kMaxCompiledRules + 1;
+
+PW_PERF_TEST(DecodePerFilterCompiled, DecodePerFilter<17>);
+PW_PERF_TEST(DecodePerFilterInOrder, DecodePerFilter<kUncompiled>);
+PW_PERF_TEST(DecodeOnceCompiled, DecodeOnce<17>);
+PW_PERF_TEST(DecodeOnceInOrder, DecodeOnce<kUncompiled>);
+PW_PERF_TEST(SharedCacheCompiled, SharedCache<17>);
+
+}  // namespace
+}  // namespace pw::log_rpc
@@ -17,6 +17,7 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
+#include <string_view>
 
 #include "pw_bytes/endian.h"
 #include "pw_log/levels.h"
@@ -718,5 +719,224 @@ TEST(FilterTest, UpdateFilterWithLargeThreadNameFails) {
   EXPECT_EQ(filter.UpdateRulesFromProto(ConstByteSpan(encoder)),
             Status::InvalidArgument());
 }
+
+// Returns a rule that checks a combination of conditions based on `index`.
+Filter::Rule MakeMixedRule(size_t index) {
+  static constexpr std::string_view kNames[] = {"", "net", "ui", "rpc"};
+  const std::string_view module = kNames[index % 4];
+  const std::string_view thread = kNames[(index / 4) % 4];
+  Filter::Rule rule{
+      .action = index % 3 == 0 ? Filter::Rule::Action::kDrop
+                               : Filter::Rule::Action::kKeep,
+      .level_greater_than_or_equal =
+          static_cast<FilterRule::Level>((index * 5) % 8),
+      .any_flags_set = index % 5 == 0 ? 0x2u : 0u,
+      .module_equals = {},
+      .thread_equals = {},
+  };
+  for (char c : module) {
+    rule.module_equals.push_back(std::byte(c));
+  }
+  for (char c : thread) {
+    rule.thread_equals.push_back(std::byte(c));
+  }
+  if (index % 7 == 6) {
+    rule.action = Filter::Rule::Action::kInactive;
+  }
+  return rule;
+}
+
+TEST(FilterTest, CompiledRulesMatchInOrderEvaluation) {
+  static constexpr size_t kNumRules = 24;
+  static_assert(kNumRules <= Filter::kMaxCompiledRules);
+  // Both filters start with the same rules, but the second has too many rules
+  // to be compiled, so it checks every rule in order.
+  std::array<Filter::Rule, kNumRules> compiled_rules;
+  std::array<Filter::Rule, Filter::kMaxCompiledRules + 1> in_order_rules;
+  for (size_t i = 0; i < kNumRules; ++i) {
+    compiled_rules[i] = MakeMixedRule(i);
+    in_order_rules[i] = MakeMixedRule(i);
+  }
+  const std::array<std::byte, cfg::kMaxFilterIdBytes> filter_id{
+      std::byte(0xba), std::byte(0x1d), std::byte(0xba), std::byte(0xb1)};
+  Filter compiled_filter(filter_id, compiled_rules);
+  Filter in_order_filter(filter_id, in_order_rules);
+  compiled_filter.CompileRules();
+  in_order_filter.CompileRules();
+
+  static constexpr std::string_view kNames[] = {"", "net", "ui", "rpc", "x"};
+  std::array<std::byte, 64> buffer;
+  size_t dropped = 0;
+  for (int level = 0; level < 8; ++level) {
+    for (unsigned int flags = 0; flags < 4; ++flags) {
+      for (std::string_view module : kNames) {
+        for (std::string_view thread : kNames) {
+          const Result<ConstByteSpan> entry = log::EncodeLog(
+              level, flags, module, thread, "", 0, 0, kSampleMessage, buffer);
+          ASSERT_EQ(entry.status(), OkStatus());
+          const bool drop = in_order_filter.ShouldDropLog(entry.value());
+          EXPECT_EQ(compiled_filter.ShouldDropLog(entry.value()), drop);
+          EXPECT_EQ(compiled_filter.ShouldDropLog(
+                        entry.value(),
+                        LogEntryAttributes::Decode(entry.value())),
+                    drop);
+          dropped += drop ? 1 : 0;
+        }
+      }
+    }
+  }
+  // Make sure the rules exercise both actions.
+  EXPECT_GT(dropped, 0u);
+  EXPECT_LT(dropped, 8u * 4u * 5u * 5u);
+}
+
+TEST(FilterTest, UncompiledFilterSeesModifiedRules) {
+  std::array<Filter::Rule, 1> rules;
+  const std::array<std::byte, cfg::kMaxFilterIdBytes> filter_id{
+      std::byte(0xba), std::byte(0x1d), std::byte(0xba), std::byte(0xb1)};
+  const Filter filter(filter_id, rules);
+  EXPECT_FALSE(filter.compiles_rules());
+
+  std::array<std::byte, 50> buffer;
+  const Result<ConstByteSpan> log_entry =
+      EncodeLogEntry<PW_LOG_LEVEL_INFO, kSampleModule, kSampleFlags>(
+          kSampleMessage, buffer, kSampleThread);
+  ASSERT_EQ(log_entry.status(), OkStatus());
+  EXPECT_FALSE(filter.ShouldDropLog(log_entry.value()));
+
+  rules[0] = {
+      .action = Filter::Rule::Action::kDrop,
+      .level_greater_than_or_equal = FilterRule::Level::INFO_LEVEL,
+      .any_flags_set = kSampleFlags,
+      .module_equals = {kSampleModuleLittleEndian.begin(),
+                        kSampleModuleLittleEndian.end()},
+      .thread_equals = {kSampleThread.begin(), kSampleThread.end()},
+  };
+  EXPECT_TRUE(filter.ShouldDropLog(log_entry.value()));
+
+  rules[0].action = Filter::Rule::Action::kKeep;
+  EXPECT_FALSE(filter.ShouldDropLog(log_entry.value()));
+}
+
+TEST(FilterTest, CompileRulesAfterModifyingRules) {
+  std::array<Filter::Rule, 1> rules;
+  const std::array<std::byte, cfg::kMaxFilterIdBytes> filter_id{
+      std::byte(0xba), std::byte(0x1d), std::byte(0xba), std::byte(0xb1)};
+  Filter filter(filter_id, rules);
+  filter.CompileRules();
+  EXPECT_TRUE(filter.compiles_rules());
+
+  std::array<std::byte, 50> buffer;
+  const Result<ConstByteSpan> log_entry =
+      EncodeLogEntry<PW_LOG_LEVEL_INFO, kSampleModule, kSampleFlags>(
+          kSampleMessage, buffer, kSampleThread);
+  ASSERT_EQ(log_entry.status(), OkStatus());
+  EXPECT_FALSE(filter.ShouldDropLog(log_entry.value()));
+
+  rules[0] = {
+      .action = Filter::Rule::Action::kDrop,
+      .level_greater_than_or_equal = FilterRule::Level::INFO_LEVEL,
+      .any_flags_set = kSampleFlags,
+      .module_equals = {kSampleModuleLittleEndian.begin(),
+                        kSampleModuleLittleEndian.end()},
+      .thread_equals = {kSampleThread.begin(), kSampleThread.end()},
+  };
+  filter.CompileRules();
+  EXPECT_TRUE(filter.ShouldDropLog(log_entry.value()));
+}
+
+TEST(FilterTest, UpdateRecompilesCompiledRules) {
+  std::array<Filter::Rule, 2> rules;
+  const std::array<std::byte, cfg::kMaxFilterIdBytes> filter_id{
+      std::byte(0xba), std::byte(0x1d), std::byte(0xba), std::byte(0xb1)};
+  Filter filter(filter_id, rules);
+  filter.CompileRules();
+
+  std::array<std::byte, 50> buffer;
+  const Result<ConstByteSpan> log_entry =
+      EncodeLogEntry<PW_LOG_LEVEL_INFO, kSampleModule, kSampleFlags>(
+          kSampleMessage, buffer, kSampleThread);
+  ASSERT_EQ(log_entry.status(), OkStatus());
+  EXPECT_FALSE(filter.ShouldDropLog(log_entry.value()));
+
+  std::byte filter_buffer[64];
+  log::pwpb::Filter::MemoryEncoder encoder(filter_buffer);
+  {
+    FilterRule::StreamEncoder rule_encoder = encoder.GetRuleEncoder();
+    ASSERT_EQ(rule_encoder.WriteLevelGreaterThanOrEqual(
+                  FilterRule::Level::INFO_LEVEL),
+              OkStatus());
+    ASSERT_EQ(rule_encoder.WriteAction(FilterRule::Action::DROP), OkStatus());
+  }
+  ASSERT_EQ(encoder.status(), OkStatus());
+  EXPECT_EQ(filter.UpdateRulesFromProto(ConstByteSpan(encoder)), OkStatus());
+  EXPECT_TRUE(filter.compiles_rules());
+  EXPECT_TRUE(filter.ShouldDropLog(log_entry.value()));
+}
+
+TEST(FilterTest, FailedUpdateRecompilesRules) {
+  std::array<Filter::Rule, 1> rules{{{
+      .action = Filter::Rule::Action::kDrop,
+      .level_greater_than_or_equal = FilterRule::Level::ANY_LEVEL,
+      .any_flags_set = 0,
+      .module_equals = {},
+      .thread_equals = {},
+  }}};
+  const std::array<std::byte, cfg::kMaxFilterIdBytes> filter_id{
+      std::byte(0xba), std::byte(0x1d), std::byte(0xba), std::byte(0xb1)};
+  Filter filter(filter_id, rules);
+  filter.CompileRules();
+
+  std::array<std::byte, 50> buffer;
+  const Result<ConstByteSpan> log_entry =
+      EncodeLogEntry<PW_LOG_LEVEL_INFO, kSampleModule, kSampleFlags>(
+          kSampleMessage, buffer, kSampleThread);
+  ASSERT_EQ(log_entry.status(), OkStatus());
+  EXPECT_TRUE(filter.ShouldDropLog(log_entry.value()));
+
+  // A rule with a module name that is too long resets the rules and fails.
+  std::byte filter_buffer[64];
+  log::pwpb::Filter::MemoryEncoder encoder(filter_buffer);
+  {
+    const std::array<std::byte, cfg::kMaxModuleNameBytes + 1> long_module{};
+    FilterRule::StreamEncoder rule_encoder = encoder.GetRuleEncoder();
+    ASSERT_EQ(rule_encoder.WriteModuleEquals(long_module), OkStatus());
+  }
+  EXPECT_EQ(filter.UpdateRulesFromProto(ConstByteSpan(encoder)),
+            Status::InvalidArgument());
+  EXPECT_FALSE(filter.ShouldDropLog(log_entry.value()));
+}
+
+TEST(LogEntryAttributes, DecodeEntry) {
+  std::array<std::byte, 64> buffer;
+  const Result<ConstByteSpan> entry = log::EncodeLog(
+      PW_LOG_LEVEL_WARN, 0x5, "net", "rx", "", 0, 0, kSampleMessage, buffer);
+  ASSERT_EQ(entry.status(), OkStatus());
+
+  const LogEntryAttributes attributes =
+      LogEntryAttributes::Decode(entry.value());
+  EXPECT_EQ(attributes.level(), static_cast<uint32_t>(PW_LOG_LEVEL_WARN));
+  EXPECT_EQ(attributes.flags(), 0x5u);
+  const ConstByteSpan module = attributes.module(entry.value());
+  EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(module.data()),
+                             module.size()),
+            "net");
+  const ConstByteSpan thread = attributes.thread(entry.value());
+  EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(thread.data()),
+                             thread.size()),
+            "rx");
+  EXPECT_EQ(attributes.module_hash(), LogEntryAttributes::Hash(module));
+  EXPECT_EQ(attributes.thread_hash(), LogEntryAttributes::Hash(thread));
+}
+
+TEST(LogEntryAttributes, DecodeEmptyEntry) {
+  const LogEntryAttributes attributes = LogEntryAttributes::Decode({});
+  EXPECT_EQ(attributes.level(), 0u);
+  EXPECT_EQ(attributes.flags(), 0u);
+  EXPECT_TRUE(attributes.module({}).empty());
+  EXPECT_TRUE(attributes.thread({}).empty());
+  EXPECT_EQ(attributes.module_hash(), LogEntryAttributes::Hash({}));
+}
+
 }  // namespace
 }  // namespace pw::log_rpc
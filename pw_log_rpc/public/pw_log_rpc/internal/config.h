@@ -41,6 +41,13 @@
 #define PW_LOG_RPC_CONFIG_MAX_FILTER_ID_SIZE 4
 #endif  // PW_LOG_RPC_CONFIG_MAX_FILTER_ID_SIZE
 
+// Log bundle compression finds repeated data using a hash table with 2^N
+// entries of 2 bytes each. Larger tables find more matches in large bundles at
+// the cost of RAM. Default to 1024 entries, or 2KB.
+#ifndef PW_LOG_RPC_CONFIG_COMPRESSION_HASH_BITS
+#define PW_LOG_RPC_CONFIG_COMPRESSION_HASH_BITS 10
+#endif  // PW_LOG_RPC_CONFIG_COMPRESSION_HASH_BITS
+
 // The log level to use for this module. Logs below this level are omitted.
 #ifndef PW_LOG_RPC_CONFIG_LOG_LEVEL
 #define PW_LOG_RPC_CONFIG_LOG_LEVEL PW_LOG_LEVEL_INFO
@@ -91,4 +98,7 @@ inline constexpr size_t kMaxFilterIdBytes =
 
 inline constexpr size_t kMaxThreadNameBytes =
     PW_LOG_RPC_CONFIG_MAX_FILTER_RULE_THREAD_NAME_SIZE;
+
+inline constexpr size_t kCompressionHashBits =
+    PW_LOG_RPC_CONFIG_COMPRESSION_HASH_BITS;
 }  // namespace pw::log_rpc::cfg
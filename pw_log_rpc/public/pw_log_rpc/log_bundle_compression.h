@@ -0,0 +1,76 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_log_rpc/internal/config.h"
+#include "pw_result/result.h"
+#include "pw_status/status_with_size.h"
+
+namespace pw::log_rpc {
+
+// Compresses log bundles, i.e. the entries of proto-encoded log::LogEntries
+// messages, in the LZ4 block format.
+//
+// Each bundle is compressed on its own, so it can be decompressed even if
+// other bundles were lost. Logs in a bundle often repeat their module, thread,
+// file and parts of their messages, which the compressor replaces with short
+// references to earlier bytes.
+class LogBundleCompressor {
+ public:
+  // The largest bundle that can be compressed. LZ4 references are limited to
+  // 16-bit offsets.
+  static constexpr size_t kMaxBundleSize = 0xffff;
+
+  // Compressed bundles are written to the provided buffer. Bundles that do not
+  // fit in it compressed are not compressed.
+  explicit constexpr LogBundleCompressor(ByteSpan buffer) : buffer_(buffer) {}
+
+  // Not copyable.
+  LogBundleCompressor(const LogBundleCompressor&) = delete;
+  LogBundleCompressor& operator=(const LogBundleCompressor&) = delete;
+
+  // Compresses a bundle into the buffer given in the constructor.
+  //
+  // Return values:
+  // OK - the compressed bundle, which is valid until the next call.
+  // OUT_OF_RANGE - the bundle is larger than kMaxBundleSize.
+  // RESOURCE_EXHAUSTED - the compressed bundle does not fit in the buffer.
+  Result<ConstByteSpan> Compress(ConstByteSpan bundle);
+
+ private:
+  static constexpr size_t kHashTableSize = size_t{1}
+                                           << cfg::kCompressionHashBits;
+
+  ByteSpan buffer_;
+  // Most recent position of each hashed 4-byte sequence.
+  std::array<uint16_t, kHashTableSize> positions_ = {};
+};
+
+// Decompresses a bundle compressed by LogBundleCompressor, or any other LZ4
+// block, into the output buffer. A log::LogEntries message's
+// compressed_entries field decompresses to the message's entries.
+//
+// Return values:
+// OK - the bundle was decompressed; the size is the decompressed size.
+// RESOURCE_EXHAUSTED - the decompressed bundle does not fit in the output.
+// DATA_LOSS - the compressed bundle is malformed.
+StatusWithSize DecompressLogBundle(ConstByteSpan compressed, ByteSpan output);
+
+}  // namespace pw::log_rpc
@@ -0,0 +1,76 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+#include "pw_bytes/span.h"
+#include "pw_log_rpc/log_filter.h"
+#include "pw_span/span.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::log_rpc {
+
+// Caches the LogEntryAttributes of MultiSink entries, so that RpcLogDrains with
+// filters decode each entry once rather than once per drain.
+//
+// Entries are identified by their MultiSink sequence ID, so a cache must only
+// be shared by drains attached to the same MultiSink. Each entry is stored in
+// the slot given by its sequence ID modulo the number of slots. Drains usually
+// flush one after another, so for every drain to find an entry's attributes
+// cached, there should be at least as many slots as entries read per flush.
+// Entries evicted before a drain reads them are decoded again.
+class LogEntryAttributesCache {
+ public:
+  struct Slot {
+    LogEntryAttributes attributes;
+    uint32_t sequence_id = 0;
+    bool valid = false;
+  };
+
+  explicit LogEntryAttributesCache(span<Slot> slots)
+      : slots_(slots) {}
+
+  // Not copyable nor movable.
+  LogEntryAttributesCache(const LogEntryAttributesCache&) = delete;
+  LogEntryAttributesCache& operator=(const LogEntryAttributesCache&) = delete;
+  LogEntryAttributesCache(LogEntryAttributesCache&&) = delete;
+  LogEntryAttributesCache& operator=(LogEntryAttributesCache&&) = delete;
+
+  // Returns the attributes of the entry with the given sequence ID, decoding
+  // and caching them if they are not cached.
+  LogEntryAttributes Get(uint32_t sequence_id, ConstByteSpan entry)
+      PW_LOCKS_EXCLUDED(mutex_) {
+    if (slots_.empty()) {
+      return LogEntryAttributes::Decode(entry);
+    }
+    std::lock_guard lock(mutex_);
+    Slot& slot = slots_[sequence_id % slots_.size()];
+    if (!slot.valid || slot.sequence_id != sequence_id) {
+      slot.attributes = LogEntryAttributes::Decode(entry);
+      slot.sequence_id = sequence_id;
+      slot.valid = true;
+    }
+    return slot.attributes;
+  }
+
+ private:
+  sync::Mutex mutex_;
+  const span<Slot> slots_ PW_GUARDED_BY(mutex_);
+};
+
+}  // namespace pw::log_rpc
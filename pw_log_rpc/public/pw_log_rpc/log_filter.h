@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 
 #include "pw_assert/assert.h"
@@ -27,6 +29,56 @@
 
 namespace pw::log_rpc {
 
+// The fields of a proto-encoded log::LogEntry that filter rules check. Decoding
+// these once allows any number of filters to check the same entry.
+//
+// The module and thread are stored as offsets into the entry, so the same
+// LogEntryAttributes can be used with any copy of the entry's bytes.
+class LogEntryAttributes {
+ public:
+  constexpr LogEntryAttributes() = default;
+
+  // Decodes the attributes of a proto-encoded log::LogEntry. Fields that are
+  // missing or cannot be decoded keep their default, empty values.
+  static LogEntryAttributes Decode(ConstByteSpan entry);
+
+  // Returns a 32-bit FNV-1a hash of the given bytes, as used for the module
+  // and thread hashes.
+  static constexpr uint32_t Hash(ConstByteSpan bytes) {
+    uint32_t hash = 2166136261u;
+    for (std::byte b : bytes) {
+      hash = (hash ^ static_cast<uint32_t>(b)) * 16777619u;
+    }
+    return hash;
+  }
+
+  // The line_level field, masked to the log level.
+  uint32_t level() const { return level_; }
+  uint32_t flags() const { return flags_; }
+
+  // Returns the module or thread, given the entry these attributes were
+  // decoded from.
+  ConstByteSpan module(ConstByteSpan entry) const {
+    return entry.subspan(module_offset_, module_size_);
+  }
+  ConstByteSpan thread(ConstByteSpan entry) const {
+    return entry.subspan(thread_offset_, thread_size_);
+  }
+
+  uint32_t module_hash() const { return module_hash_; }
+  uint32_t thread_hash() const { return thread_hash_; }
+
+ private:
+  uint32_t level_ = 0;
+  uint32_t flags_ = 0;
+  uint32_t module_hash_ = Hash({});
+  uint32_t thread_hash_ = Hash({});
+  uint32_t module_offset_ = 0;
+  uint32_t module_size_ = 0;
+  uint32_t thread_offset_ = 0;
+  uint32_t thread_size_ = 0;
+};
+
 // A Filter is a collection of rules used to check if a log entry can be kept
 // or dropped wherever the filter is placed in the log path.
 class Filter {
@@ -55,6 +107,10 @@ class Filter {
     Vector<std::byte, cfg::kMaxThreadNameBytes> thread_equals{};
   };
 
+  // The maximum number of rules that can be checked using compiled lookup
+  // tables. Filters with more rules check every rule in order.
+  static constexpr size_t kMaxCompiledRules = 32;
+
   Filter(span<const std::byte> id, span<Rule> rules) : rules_(rules) {
     PW_ASSERT(!id.empty());
     id_.assign(id.begin(), id.end());
@@ -71,7 +127,31 @@ class Filter {
   // provided, stopping at the first rule that matches.
   // Returns true when the log should be dropped, false otherwise. Defaults to
   // false if there are no rules, or no rules were matched.
-  bool ShouldDropLog(ConstByteSpan entry) const;
+  bool ShouldDropLog(ConstByteSpan entry) const {
+    if (rules_.empty()) {
+      return false;
+    }
+    return ShouldDropLog(entry, LogEntryAttributes::Decode(entry));
+  }
+
+  // Like ShouldDropLog(entry), but uses attributes already decoded from the
+  // entry, so that an entry checked by several filters is decoded only once.
+  bool ShouldDropLog(ConstByteSpan entry,
+                     const LogEntryAttributes& attributes) const;
+
+  // Compiles the rules into lookup tables, so that checking a log only
+  // evaluates the rules that may match it. Until this is called, the filter
+  // checks every rule in order and sees changes made to the rules through the
+  // span passed to the constructor immediately.
+  //
+  // Once called, the tables are rebuilt by UpdateRulesFromProto() and when an
+  // RpcLogDrain using the filter is opened. Rules modified through the span at
+  // any other time are not seen until CompileRules() is called again.
+  void CompileRules();
+
+  // Whether CompileRules() has been called, so the rules must be recompiled
+  // after modifying them.
+  bool compiles_rules() const { return compiles_rules_; }
 
   // Decodes and updates the filter's rules given a buffer with a proto-encoded
   // log::Filter message. If there are more rules than this filter can hold, the
@@ -84,8 +164,32 @@ class Filter {
   Status UpdateRulesFromProto(ConstByteSpan buffer);
 
  private:
+  // Number of hash buckets for the module and thread lookup tables.
+  static constexpr size_t kBuckets = 8;
+
+  // Resets the rules and decodes them from a log::Filter message.
+  Status DecodeRulesFromProto(ConstByteSpan buffer);
+
+  // Returns a mask of the compiled rules that may match the given attributes.
+  uint32_t CandidateRules(const LogEntryAttributes& attributes) const;
+
   Vector<std::byte, cfg::kMaxFilterIdBytes> id_;
   span<Rule> rules_;
+
+  // Set by CompileRules().
+  bool compiles_rules_ = false;
+
+  // Lookup tables for up to kMaxCompiledRules rules. Bit i of each mask refers
+  // to rules_[i].
+  bool compiled_ = false;
+  // Active rules that accept each log level.
+  std::array<uint32_t, 8> rules_by_level_ = {};
+  // Active rules without a module or thread condition.
+  uint32_t rules_for_any_module_ = 0;
+  uint32_t rules_for_any_thread_ = 0;
+  // Active rules with a module or thread condition, by the condition's hash.
+  std::array<uint32_t, kBuckets> rules_by_module_ = {};
+  std::array<uint32_t, kBuckets> rules_by_thread_ = {};
 };
 
 }  // namespace pw::log_rpc
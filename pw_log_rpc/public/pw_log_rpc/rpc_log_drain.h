@@ -27,6 +27,8 @@
 #include "pw_function/function.h"
 #include "pw_log/proto/log.pwpb.h"
 #include "pw_log_rpc/internal/config.h"
+#include "pw_log_rpc/log_bundle_compression.h"
+#include "pw_log_rpc/log_entry_attributes_cache.h"
 #include "pw_log_rpc/log_filter.h"
 #include "pw_multisink/multisink.h"
 #include "pw_protobuf/serialized_size.h"
@@ -201,6 +203,43 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
     on_open_callback_ = std::move(callback);
   }
 
+  // Compresses outgoing bundles with the given compressor, sending them in the
+  // log::LogEntries compressed_entries field. Bundles that compression does
+  // not make smaller are sent uncompressed. Pass nullptr to stop compressing.
+  void set_compressor(LogBundleCompressor* compressor)
+      PW_LOCKS_EXCLUDED(mutex_) {
+    std::lock_guard lock(mutex_);
+    compressor_ = compressor;
+  }
+
+  // Adapts the size of bundles to the writer's success. Bundles start as large
+  // as the encoding buffer allows. Each failed write halves the bundle size
+  // limit, down to min_bundle_size, and each successful write raises it by
+  // min_bundle_size. This limits the logs lost or retried on a congested
+  // channel, while sending fewer, larger and better compressed bundles when
+  // writes succeed. Entries larger than the limit are still sent on their own.
+  // Pass 0 to always fill the encoding buffer.
+  void set_min_bundle_size(size_t min_bundle_size) PW_LOCKS_EXCLUDED(mutex_) {
+    std::lock_guard lock(mutex_);
+    min_bundle_size_ = min_bundle_size;
+    bundle_size_limit_ = std::numeric_limits<size_t>::max();
+  }
+
+  // The current limit on the size of uncompressed bundles.
+  size_t bundle_size_limit() const PW_LOCKS_EXCLUDED(mutex_) {
+    std::lock_guard lock(mutex_);
+    return bundle_size_limit_;
+  }
+
+  // Sets a cache of decoded entry attributes to share with other drains of the
+  // same MultiSink, so that each entry is decoded once for all their filters.
+  // Pass nullptr to decode entries in this drain.
+  void set_attributes_cache(LogEntryAttributesCache* attributes_cache)
+      PW_LOCKS_EXCLUDED(mutex_) {
+    std::lock_guard lock(mutex_);
+    attributes_cache_ = attributes_cache;
+  }
+
  private:
   enum class LogDrainState {
     kCaughtUp,
@@ -216,6 +255,19 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
       log::pwpb::LogEntries::MemoryEncoder& encoder,
       uint32_t& packed_entry_count_out) PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Writes the bundle in the encoder, compressing it if enabled.
+  Status WriteBundle(log::pwpb::LogEntries::MemoryEncoder& encoder,
+                     ByteSpan encoding_buffer)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Updates the bundle size limit after a write.
+  void AdaptBundleSize(bool write_succeeded, size_t encoding_buffer_size)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Checks the entry against the filter, which must not be null.
+  bool ShouldDropEntry(const multisink::MultiSink::Drain::PeekedEntry& entry)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   const uint32_t channel_id_;
   const LogDrainErrorHandling error_handling_;
   rpc::RawServerWriter server_writer_ PW_GUARDED_BY(mutex_);
@@ -227,6 +279,11 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
   uint32_t drop_count_writer_error_ PW_GUARDED_BY(mutex_);
   sync::Mutex& mutex_;
   Filter* filter_;
+  LogEntryAttributesCache* attributes_cache_ PW_GUARDED_BY(mutex_) = nullptr;
+  LogBundleCompressor* compressor_ PW_GUARDED_BY(mutex_) = nullptr;
+  size_t min_bundle_size_ PW_GUARDED_BY(mutex_) = 0;
+  size_t bundle_size_limit_ PW_GUARDED_BY(mutex_) =
+      std::numeric_limits<size_t>::max();
   uint32_t sequence_id_;
   size_t max_bundles_per_trickle_;
   pw::chrono::SystemClock::duration trickle_delay_;
@@ -60,6 +60,16 @@ void TryEncodeDropMessage(
 
 }  // namespace
 
+bool RpcLogDrain::ShouldDropEntry(
+    const multisink::MultiSink::Drain::PeekedEntry& entry) {
+  if (attributes_cache_ == nullptr) {
+    return filter_->ShouldDropLog(entry.entry());
+  }
+  return filter_->ShouldDropLog(
+      entry.entry(),
+      attributes_cache_->Get(entry.sequence_id(), entry.entry()));
+}
+
 Status RpcLogDrain::Open(rpc::RawServerWriter& writer) {
   if (!writer.active()) {
     return Status::FailedPrecondition();
@@ -70,6 +80,11 @@ Status RpcLogDrain::Open(rpc::RawServerWriter& writer) {
   }
   server_writer_ = std::move(writer);
 
+  // Compiled rules may have been modified directly since they were compiled.
+  if (filter_ != nullptr && filter_->compiles_rules()) {
+    filter_->CompileRules();
+  }
+
   // Set a callback to close the drain when RequestCompletion() is requested by
   // the reader. This callback is only set and invoked if
   // PW_RPC_COMPLETION_REQUEST_CALLBACK is enabled.
@@ -133,11 +148,12 @@ RpcLogDrain::LogDrainState RpcLogDrain::SendLogs(size_t max_num_bundles,
       continue;
     }
 
-    encoder.WriteFirstEntrySequenceId(sequence_id_)
-        .IgnoreError();  // TODO: b/242598609 - Handle Status properly
+    const Status status = WriteBundle(encoder, encoding_buffer);
     sequence_id_ += packed_entry_count;
-    const Status status = server_writer_.Write(encoder);
     sent_bundle_count++;
+    if (min_bundle_size_ != 0) {
+      AdaptBundleSize(status.ok(), encoding_buffer.size());
+    }
 
     if (!status.ok() &&
         error_handling_ == LogDrainErrorHandling::kCloseStreamOnWriterError) {
@@ -151,6 +167,41 @@ RpcLogDrain::LogDrainState RpcLogDrain::SendLogs(size_t max_num_bundles,
   return log_sink_state;
 }
 
+Status RpcLogDrain::WriteBundle(log::pwpb::LogEntries::MemoryEncoder& encoder,
+                                ByteSpan encoding_buffer) {
+  if (compressor_ != nullptr) {
+    const ConstByteSpan entries(encoder);
+    const Result<ConstByteSpan> compressed = compressor_->Compress(entries);
+    if (compressed.ok() &&
+        protobuf::SizeOfFieldBytes(
+            log::pwpb::LogEntries::Fields::kCompressedEntries,
+            compressed.value().size()) < entries.size()) {
+      // The compressed entries are smaller than the entries they replace, so
+      // they fit in the encoding buffer.
+      log::pwpb::LogEntries::MemoryEncoder compressed_encoder(encoding_buffer);
+      PW_CHECK_OK(
+          compressed_encoder.WriteCompressedEntries(compressed.value()));
+      compressed_encoder.WriteFirstEntrySequenceId(sequence_id_)
+          .IgnoreError();  // TODO: b/242598609 - Handle Status properly
+      return server_writer_.Write(compressed_encoder);
+    }
+  }
+  encoder.WriteFirstEntrySequenceId(sequence_id_)
+      .IgnoreError();  // TODO: b/242598609 - Handle Status properly
+  return server_writer_.Write(encoder);
+}
+
+void RpcLogDrain::AdaptBundleSize(bool write_succeeded,
+                                  size_t encoding_buffer_size) {
+  if (!write_succeeded) {
+    bundle_size_limit_ = std::max(
+        min_bundle_size_,
+        std::min(bundle_size_limit_, encoding_buffer_size) / 2);
+  } else if (bundle_size_limit_ < encoding_buffer_size) {
+    bundle_size_limit_ += min_bundle_size_;
+  }
+}
+
 RpcLogDrain::LogDrainState RpcLogDrain::EncodeOutgoingPacket(
     log::pwpb::LogEntries::MemoryEncoder& encoder,
     uint32_t& packed_entry_count_out) {
@@ -181,8 +232,7 @@ RpcLogDrain::LogDrainState RpcLogDrain::EncodeOutgoingPacket(
     PW_CHECK_OK(possible_entry.status());
 
     // Check if the entry passes any set filter rules.
-    if (filter_ != nullptr &&
-        filter_->ShouldDropLog(possible_entry.value().entry())) {
+    if (filter_ != nullptr && ShouldDropEntry(possible_entry.value())) {
       // Add the drop count from the multisink peek, stored in `drop_count`, to
       // the total drop count. Then drop the entry without counting it towards
       // the total drop count. Drops will be reported later all together.
@@ -249,8 +299,11 @@ RpcLogDrain::LogDrainState RpcLogDrain::EncodeOutgoingPacket(
                       .status());
     }
 
-    // Check if the entry fits in the partially filled encoder buffer.
-    if (encoded_entry_size > encoder.ConservativeWriteLimit()) {
+    // Check if the entry fits in the partially filled encoder buffer, and
+    // within the bundle size limit unless it is the first entry.
+    if (encoded_entry_size > encoder.ConservativeWriteLimit() ||
+        (packed_entry_count_out > 0 &&
+         encoder.size() + encoded_entry_size > bundle_size_limit_)) {
       // Notify the caller there are more entries to send.
       return LogDrainState::kMoreEntriesRemaining;
     }
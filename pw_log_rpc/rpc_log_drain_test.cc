@@ -20,8 +20,11 @@
 
 #include "pw_bytes/array.h"
 #include "pw_bytes/span.h"
+#include "pw_log/levels.h"
 #include "pw_log/proto/log.pwpb.h"
 #include "pw_log/proto_utils.h"
+#include "pw_log_rpc/log_bundle_compression.h"
+#include "pw_log_rpc/log_entry_attributes_cache.h"
 #include "pw_log_rpc/log_filter.h"
 #include "pw_log_rpc/log_service.h"
 #include "pw_log_rpc/rpc_log_drain_map.h"
@@ -412,6 +415,154 @@ TEST_F(TrickleTest, LimitedFlushOverflowsToNextPayload) {
   EXPECT_EQ(entries_count, 3u);
 }
 
+TEST_F(TrickleTest, CompressedEntriesDecompressToBundle) {
+  AttachDrain();
+  OpenWriter();
+
+  // Entries with the same metadata and thread compress well.
+  Vector<TestLogEntry, 3> kExpectedEntries{
+      BasicLog("Compress me"), BasicLog("Compress me too"), BasicLog(":D")};
+  AddLogEntries(kExpectedEntries);
+
+  std::array<std::byte, kChannelEncodeBufferSize> compression_buffer;
+  LogBundleCompressor compressor(compression_buffer);
+  ASSERT_TRUE(writer_.active());
+  EXPECT_EQ(drains_[0].Open(writer_), OkStatus());
+  drains_[0].set_compressor(&compressor);
+
+  std::optional<chrono::SystemClock::duration> min_delay =
+      drains_[0].Trickle(channel_encode_buffer_);
+  EXPECT_EQ(min_delay.has_value(), false);
+
+  rpc::PayloadsView payloads =
+      output_.payloads<log::pw_rpc::raw::Logs::Listen>(kDrainChannelId);
+  ASSERT_EQ(payloads.size(), 1u);
+
+  ConstByteSpan compressed_entries;
+  uint32_t first_entry_sequence_id = 1;
+  protobuf::Decoder payload_decoder(payloads[0]);
+  while (payload_decoder.Next().ok()) {
+    switch (static_cast<log::pwpb::LogEntries::Fields>(
+        payload_decoder.FieldNumber())) {
+      case log::pwpb::LogEntries::Fields::kEntries:
+        FAIL() << "Entries were not compressed";
+        break;
+      case log::pwpb::LogEntries::Fields::kFirstEntrySequenceId:
+        EXPECT_EQ(payload_decoder.ReadUint32(&first_entry_sequence_id),
+                  OkStatus());
+        break;
+      case log::pwpb::LogEntries::Fields::kCompressedEntries:
+        EXPECT_EQ(payload_decoder.ReadBytes(&compressed_entries), OkStatus());
+        break;
+    }
+  }
+  EXPECT_EQ(first_entry_sequence_id, 0u);
+
+  std::array<std::byte, kChannelEncodeBufferSize> decompressed;
+  StatusWithSize result =
+      DecompressLogBundle(compressed_entries, decompressed);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_LT(payloads[0].size(), result.size());
+
+  uint32_t drop_count = 0;
+  size_t entries_count = 0;
+  protobuf::Decoder entries_decoder(
+      ConstByteSpan(decompressed).first(result.size()));
+  VerifyLogEntries(
+      entries_decoder, kExpectedEntries, 0, entries_count, drop_count);
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(entries_count, 3u);
+}
+
+TEST_F(TrickleTest, IncompressibleBundleIsSentUncompressed) {
+  AttachDrain();
+  OpenWriter();
+
+  Vector<TestLogEntry, 1> kExpectedEntries{BasicLog(":D")};
+  AddLogEntries(kExpectedEntries);
+
+  std::array<std::byte, kChannelEncodeBufferSize> compression_buffer;
+  LogBundleCompressor compressor(compression_buffer);
+  ASSERT_TRUE(writer_.active());
+  EXPECT_EQ(drains_[0].Open(writer_), OkStatus());
+  drains_[0].set_compressor(&compressor);
+  drains_[0].Trickle(channel_encode_buffer_);
+
+  rpc::PayloadsView payloads =
+      output_.payloads<log::pw_rpc::raw::Logs::Listen>(kDrainChannelId);
+  ASSERT_EQ(payloads.size(), 1u);
+
+  uint32_t drop_count = 0;
+  size_t entries_count = 0;
+  protobuf::Decoder payload_decoder(payloads[0]);
+  VerifyLogEntries(
+      payload_decoder, kExpectedEntries, 0, entries_count, drop_count);
+  EXPECT_EQ(entries_count, 1u);
+}
+
+TEST_F(TrickleTest, BundleSizeAdaptsToWriteResults) {
+  AttachDrain();
+  OpenWriter();
+  ASSERT_TRUE(writer_.active());
+  EXPECT_EQ(drains_[0].Open(writer_), OkStatus());
+  drains_[0].set_min_bundle_size(kBasicLogSizeWithoutPayload);
+
+  // A failed write halves the bundle size limit.
+  AddLogEntry(BasicLog("This write fails"));
+  output_.set_send_status(Status::Unavailable());
+  drains_[0].Trickle(channel_encode_buffer_);
+  EXPECT_EQ(drains_[0].bundle_size_limit(), channel_encode_buffer_.size() / 2);
+
+  output_.set_send_status(OkStatus());
+  output_.clear();
+  OpenWriter();
+  ASSERT_TRUE(writer_.active());
+  EXPECT_EQ(drains_[0].Open(writer_), OkStatus());
+
+  // The lower limit splits entries that would fit in one bundle, and each
+  // successful write raises it again.
+  Vector<TestLogEntry, 3> kEntries{
+      BasicLog("Use longer logs in this test"),
+      BasicLog("My feet are cold"),
+      BasicLog("I'm hungry, what's for dinner?")};
+  AddLogEntries(kEntries);
+  drains_[0].Trickle(channel_encode_buffer_);
+
+  rpc::PayloadsView payloads =
+      output_.payloads<log::pw_rpc::raw::Logs::Listen>(kDrainChannelId);
+  ASSERT_EQ(payloads.size(), 2u);
+  EXPECT_EQ(drains_[0].bundle_size_limit(),
+            channel_encode_buffer_.size() / 2 +
+                2 * kBasicLogSizeWithoutPayload);
+
+  // The entry lost in the failed write is reported first.
+  Vector<TestLogEntry, 4> kExpectedEntries{
+      {.metadata = log_tokenized::Metadata::Set<0, 0, 0, 0>(),
+       .dropped = 1,
+       .tokenized_data = as_bytes(
+           span(std::string_view(RpcLogDrain::kWriterErrorMessage)))}};
+  for (const TestLogEntry& entry : kEntries) {
+    kExpectedEntries.push_back(entry);
+  }
+  uint32_t drop_count = 0;
+  size_t entries_count = 0;
+  protobuf::Decoder payload_decoder(payloads[0]);
+  VerifyLogEntries(
+      payload_decoder, kExpectedEntries, 1, entries_count, drop_count);
+  EXPECT_EQ(drop_count, 1u);
+  EXPECT_GE(entries_count, 1u);
+
+  // Drop messages do not take sequence IDs or count as entries.
+  payload_decoder.Reset(payloads[1]);
+  VerifyLogEntries(payload_decoder,
+                   kEntries,
+                   1 + static_cast<uint32_t>(entries_count),
+                   entries_count,
+                   drop_count);
+  EXPECT_EQ(drop_count, 1u);
+  EXPECT_EQ(entries_count, 3u);
+}
+
 TEST(RpcLogDrain, OnOpenCallbackCalled) {
   // Create drain and log components.
   const uint32_t drain_id = 1;
@@ -463,5 +614,45 @@ TEST(RpcLogDrain, OnOpenCallbackCalled) {
   EXPECT_EQ(callback_call_times, 1);
 }
 
+TEST(LogEntryAttributesCache, DecodesEachEntryOnce) {
+  std::array<std::byte, 64> buffer1;
+  const Result<ConstByteSpan> entry1 = log::EncodeLog(
+      PW_LOG_LEVEL_INFO, 0, "net", "rx", "", 0, 0, "message", buffer1);
+  ASSERT_EQ(entry1.status(), OkStatus());
+  std::array<std::byte, 64> buffer2;
+  const Result<ConstByteSpan> entry2 = log::EncodeLog(
+      PW_LOG_LEVEL_ERROR, 0, "ui", "", "", 0, 0, "message", buffer2);
+  ASSERT_EQ(entry2.status(), OkStatus());
+
+  std::array<LogEntryAttributesCache::Slot, 2> slots;
+  LogEntryAttributesCache cache(slots);
+
+  const uint32_t info_level = PW_LOG_LEVEL_INFO;
+  const uint32_t error_level = PW_LOG_LEVEL_ERROR;
+  EXPECT_EQ(cache.Get(4, entry1.value()).level(), info_level);
+  // Sequence ID 4 is cached, so the entry is not decoded again.
+  EXPECT_EQ(cache.Get(4, entry2.value()).level(), info_level);
+
+  // Sequence ID 5 uses the other slot.
+  EXPECT_EQ(cache.Get(5, entry2.value()).level(), error_level);
+  EXPECT_EQ(cache.Get(4, entry1.value()).level(), info_level);
+
+  // Sequence ID 6 replaces sequence ID 4.
+  EXPECT_EQ(cache.Get(6, entry2.value()).level(), error_level);
+  EXPECT_EQ(cache.Get(4, entry1.value()).level(), info_level);
+}
+
+TEST(LogEntryAttributesCache, WithoutSlotsDecodesEveryEntry) {
+  std::array<std::byte, 64> buffer;
+  const Result<ConstByteSpan> entry = log::EncodeLog(
+      PW_LOG_LEVEL_WARN, 0, "net", "rx", "", 0, 0, "message", buffer);
+  ASSERT_EQ(entry.status(), OkStatus());
+
+  LogEntryAttributesCache cache({});
+  const uint32_t warn_level = PW_LOG_LEVEL_WARN;
+  EXPECT_EQ(cache.Get(1, entry.value()).level(), warn_level);
+  EXPECT_EQ(cache.Get(1, {}).level(), 0u);
+}
+
 }  // namespace
 }  // namespace pw::log_rpc
@@ -16,6 +16,7 @@
 
 #include <array>
 #include <atomic>
+#include <cstdint>
 #include <limits>
 
 #include "pw_assert/check.h"
@@ -51,8 +52,111 @@ const char* Indent(int level) {
   return kWhitespace10 + 8 - 2 * level;
 }
 
+// The generation that changes are currently stamped with. Starts after 0, so
+// that ChangedSince(0) is true even for metrics that never changed.
+std::atomic<uint32_t> current_generation{1};
+
+// Stamps a change with the current generation.
+//
+// The stamp is rewritten if a new generation started while storing it. Once
+// the loop exits, any snapshot that starts a later generation is guaranteed to
+// see both the stamp and the change it records, so no change is missed.
+[[maybe_unused]] void StampGeneration(std::atomic<uint32_t>& generation) {
+  uint32_t current = current_generation.load();
+  uint32_t stamped;
+  do {
+    stamped = current;
+    generation.store(stamped);
+    current = current_generation.load();
+  } while (current != stamped);
+}
+
 }  // namespace
 
+uint32_t AdvanceChangeGeneration() {
+  return current_generation.fetch_add(1) + 1;
+}
+
+namespace internal {
+
+Token HistogramBucketName(size_t lower_bound_index) {
+  // Each name is tokenized separately so that every bucket name lands in the
+  // token database, regardless of which histograms a binary instantiates.
+  switch (lower_bound_index) {
+    case 0:
+      return PW_METRIC_TOKEN("0");
+    case 1:
+      return PW_METRIC_TOKEN("1");
+    case 2:
+      return PW_METRIC_TOKEN("2");
+    case 3:
+      return PW_METRIC_TOKEN("4");
+    case 4:
+      return PW_METRIC_TOKEN("8");
+    case 5:
+      return PW_METRIC_TOKEN("16");
+    case 6:
+      return PW_METRIC_TOKEN("32");
+    case 7:
+      return PW_METRIC_TOKEN("64");
+    case 8:
+      return PW_METRIC_TOKEN("128");
+    case 9:
+      return PW_METRIC_TOKEN("256");
+    case 10:
+      return PW_METRIC_TOKEN("512");
+    case 11:
+      return PW_METRIC_TOKEN("1024");
+    case 12:
+      return PW_METRIC_TOKEN("2048");
+    case 13:
+      return PW_METRIC_TOKEN("4096");
+    case 14:
+      return PW_METRIC_TOKEN("8192");
+    case 15:
+      return PW_METRIC_TOKEN("16384");
+    case 16:
+      return PW_METRIC_TOKEN("32768");
+    case 17:
+      return PW_METRIC_TOKEN("65536");
+    case 18:
+      return PW_METRIC_TOKEN("131072");
+    case 19:
+      return PW_METRIC_TOKEN("262144");
+    case 20:
+      return PW_METRIC_TOKEN("524288");
+    case 21:
+      return PW_METRIC_TOKEN("1048576");
+    case 22:
+      return PW_METRIC_TOKEN("2097152");
+    case 23:
+      return PW_METRIC_TOKEN("4194304");
+    case 24:
+      return PW_METRIC_TOKEN("8388608");
+    case 25:
+      return PW_METRIC_TOKEN("16777216");
+    case 26:
+      return PW_METRIC_TOKEN("33554432");
+    case 27:
+      return PW_METRIC_TOKEN("67108864");
+    case 28:
+      return PW_METRIC_TOKEN("134217728");
+    case 29:
+      return PW_METRIC_TOKEN("268435456");
+    case 30:
+      return PW_METRIC_TOKEN("536870912");
+    case 31:
+      return PW_METRIC_TOKEN("1073741824");
+    case 32:
+      return PW_METRIC_TOKEN("2147483648");
+    default:
+      PW_CRASH("Histogram bucket index %u out of range",
+               static_cast<unsigned>(lower_bound_index));
+  }
+}
+
+}  // namespace internal
+
 // Enable easier registration when used as a member.
 Metric::Metric(Token name, float value, IntrusiveList<Metric>& metrics)
     : Metric(name, value) {
@@ -88,6 +192,8 @@ void Metric::Increment(uint32_t amount) {
       updated = std::numeric_limits<uint32_t>::max();
     }
   } while (!uint_.compare_exchange_weak(value, updated));
+
+  MarkChanged();
 }
 
 void Metric::Decrement(uint32_t amount) {
@@ -105,16 +211,36 @@ void Metric::Decrement(uint32_t amount) {
       updated = 0;
     }
   } while (!uint_.compare_exchange_weak(value, updated));
+
+  MarkChanged();
 }
 
 void Metric::SetInt(uint32_t value) {
   PW_DCHECK(is_int());
-  uint_.store(value, std::memory_order_relaxed);
+  if (uint_.exchange(value, std::memory_order_relaxed) != value) {
+    MarkChanged();
+  }
 }
 
 void Metric::SetFloat(float value) {
   PW_DCHECK(is_float());
-  float_.store(value, std::memory_order_relaxed);
+  if (float_.exchange(value, std::memory_order_relaxed) != value) {
+    MarkChanged();
+  }
+}
+
+bool Metric::ChangedSince([[maybe_unused]] uint32_t generation) const {
+#if PW_METRIC_TRACK_CHANGES
+  return generation_.load() >= generation;
+#else
+  return true;
+#endif  // PW_METRIC_TRACK_CHANGES
+}
+
+void Metric::MarkChanged() {
+#if PW_METRIC_TRACK_CHANGES
+  StampGeneration(generation_);
+#endif  // PW_METRIC_TRACK_CHANGES
 }
 
 void Metric::Dump(int level, bool last) const {
@@ -146,6 +272,66 @@ void Metric::Dump(const IntrusiveList<Metric>& metrics, int level) {
   }
 }
 
+ShardedCounter::ShardedCounter(Token name,
+                               IntrusiveList<ShardedCounter>& counters)
+    : ShardedCounter(name) {
+  counters.push_front(*this);
+}
+
+void ShardedCounter::IncrementShard(size_t shard_index, uint32_t amount) {
+  Shard& shard = shards_[shard_index % kNumShards];
+  std::atomic<uint32_t>& shard_value = shard.value;
+
+  // Shards are rarely contended, so relaxed ordering is enough; the shards are
+  // only ever summed.
+  uint32_t value = shard_value.load(std::memory_order_relaxed);
+  uint32_t updated;
+
+  if (value == std::numeric_limits<uint32_t>::max()) {
+    return;
+  }
+
+  do {
+    if (!CheckedAdd(value, amount, updated)) {
+      updated = std::numeric_limits<uint32_t>::max();
+    }
+  } while (!shard_value.compare_exchange_weak(
+      value, updated, std::memory_order_relaxed));
+
+#if PW_METRIC_TRACK_CHANGES
+  StampGeneration(shard.generation);
+#endif  // PW_METRIC_TRACK_CHANGES
+}
+
+void ShardedCounter::MarkChanged() {
+#if PW_METRIC_TRACK_CHANGES
+  StampGeneration(shards_.front().generation);
+#endif  // PW_METRIC_TRACK_CHANGES
+}
+
+uint32_t ShardedCounter::value() const {
+  uint32_t sum = 0;
+  for (const Shard& shard : shards_) {
+    if (!CheckedAdd(sum, shard.value.load(std::memory_order_relaxed), sum)) {
+      return std::numeric_limits<uint32_t>::max();
+    }
+  }
+  return sum;
+}
+
+bool ShardedCounter::ChangedSince([[maybe_unused]] uint32_t generation) const {
+#if PW_METRIC_TRACK_CHANGES
+  for (const Shard& shard : shards_) {
+    if (shard.generation.load() >= generation) {
+      return true;
+    }
+  }
+  return false;
+#else
+  return true;
+#endif  // PW_METRIC_TRACK_CHANGES
+}
+
 Group::Group(Token name, IntrusiveList<Group>& groups) : name_(name) {
   groups.push_front(*this);
 }
@@ -162,6 +348,14 @@ void Group::Dump(int level, bool last) const {
   const char* comma = last ? "" : ",";
   PW_LOG_INFO("%s\"%s\": {", indent, encoded_name.value());
   Group::Dump(children(), level + 1);
+#if PW_METRIC_GROUP_SHARDED_COUNTERS
+  for (auto iter = sharded_counters().begin();
+       iter != sharded_counters().end();) {
+    const TypedMetric<uint32_t> snapshot = (iter++)->Snapshot();
+    snapshot.Dump(level + 1,
+                  iter == sharded_counters().end() && metrics().empty());
+  }
+#endif  // PW_METRIC_GROUP_SHARDED_COUNTERS
   Metric::Dump(metrics(), level + 1);
   PW_LOG_INFO("%s}%s", indent, comma);
 }
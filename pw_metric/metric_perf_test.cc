@@ -0,0 +1,113 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/check.h"
+#include "pw_metric/metric.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+
+namespace pw::metric {
+namespace {
+
+// Compares incrementing a plain `TypedMetric<uint32_t>`, whose single atomic
+// word is shared by every writer, with a `ShardedCounter`, which spreads
+// writers across cache-line-aligned shards. Each benchmark is run alone and
+// alongside background threads that increment the same counter.
+
+constexpr size_t kMaxContenders = 3;
+
+/// Runs threads that increment a counter until destroyed.
+template <typename Counter>
+class Contenders {
+ public:
+  Contenders(Counter& counter, size_t num_threads) : counter_(counter) {
+    PW_CHECK_UINT_LE(num_threads, kMaxContenders);
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads_[i] = Thread(contexts_[i].options(), [this] { Run(); });
+    }
+  }
+
+  ~Contenders() {
+    stop_.store(true, std::memory_order_relaxed);
+#if PW_THREAD_JOINING_ENABLED
+    for (Thread& thread : threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+#endif  // PW_THREAD_JOINING_ENABLED
+  }
+
+ private:
+  void Run() {
+    while (!stop_.load(std::memory_order_relaxed)) {
+      counter_.Increment();
+    }
+  }
+
+  Counter& counter_;
+  std::atomic<bool> stop_{false};
+  std::array<thread::test::TestThreadContext, kMaxContenders> contexts_;
+  std::array<Thread, kMaxContenders> threads_;
+};
+
+template <typename Counter>
+void IncrementWithContenders(perf_test::State& state,
+                             Counter& counter,
+                             size_t num_contenders) {
+  Contenders<Counter> contenders(counter, num_contenders);
+  while (state.KeepRunning()) {
+    counter.Increment();
+  }
+}
+
+void MetricIncrement(perf_test::State& state, size_t num_contenders) {
+  PW_METRIC(counter, "counter", 0u);
+  IncrementWithContenders(state, counter, num_contenders);
+}
+
+void ShardedCounterIncrement(perf_test::State& state, size_t num_contenders) {
+  PW_METRIC_SHARDED(counter, "counter");
+  IncrementWithContenders(state, counter, num_contenders);
+}
+
+void HistogramRecord(perf_test::State& state) {
+  PW_METRIC_HISTOGRAM(histogram, "histogram", 16, 1);
+  uint32_t value = 1;
+  while (state.KeepRunning()) {
+    histogram.Record(value);
+    value = value * 3 + 1;
+  }
+}
+
+PW_PERF_TEST(MetricIncrementAlone, MetricIncrement, 0);
+PW_PERF_TEST(ShardedCounterIncrementAlone, ShardedCounterIncrement, 0);
+
+#if PW_THREAD_JOINING_ENABLED
+PW_PERF_TEST(MetricIncrementContended, MetricIncrement, kMaxContenders);
+PW_PERF_TEST(ShardedCounterIncrementContended,
+             ShardedCounterIncrement,
+             kMaxContenders);
+#endif  // PW_THREAD_JOINING_ENABLED
+
+PW_PERF_TEST(HistogramRecord16, HistogramRecord);
+
+}  // namespace
+}  // namespace pw::metric
@@ -0,0 +1,147 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/check.h"
+#include "pw_containers/vector.h"
+#include "pw_log/log.h"
+#include "pw_metric/metric.h"
+#include "pw_metric_private/metric_walker.h"
+#include "pw_metric_proto/metric_service.pwpb.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_status/status.h"
+#include "pw_status/try.h"
+
+namespace pw::metric {
+namespace {
+
+// Compares scraping a metric tree in full, as MetricService::Get does, with
+// scraping only the metrics that changed, as MetricService::GetChanges does.
+// Both encode each metric the way the pwpb MetricService does and count the
+// encoded bytes, which are logged once per test.
+
+/// Encodes each metric as a `Metric` proto and counts the bytes.
+class CountingMetricWriter : public internal::MetricWriter {
+ public:
+  Status Write(const Metric& metric, const Vector<Token>& path) override {
+    std::array<std::byte, 48> buffer;
+    proto::pwpb::Metric::MemoryEncoder encoder(buffer);
+    PW_TRY(encoder.WriteTokenPath(path));
+    if (metric.is_float()) {
+      PW_TRY(encoder.WriteAsFloat(metric.as_float()));
+    } else {
+      PW_TRY(encoder.WriteAsInt(metric.as_int()));
+    }
+    bytes_ += encoder.size();
+    return OkStatus();
+  }
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  size_t bytes_ = 0;
+};
+
+constexpr size_t kMetricsPerGroup = 16;
+
+/// A tree of 4 groups with 16 metrics each.
+class MetricTree {
+ public:
+  MetricTree() {
+    for (Group& group : groups_) {
+      root_.Add(group);
+    }
+    for (size_t i = 0; i < metrics_.size(); ++i) {
+      groups_[i / kMetricsPerGroup].Add(metrics_[i]);
+    }
+  }
+
+  ~MetricTree() {
+    for (Group& group : groups_) {
+      group.metrics().clear();
+    }
+    root_.children().clear();
+  }
+
+  /// Increments `num_changes` metrics spread across the groups.
+  void Change(size_t num_changes) {
+    for (size_t i = 0; i < num_changes; ++i) {
+      metrics_[(i * 7) % metrics_.size()].Increment();
+    }
+  }
+
+  const Group& root() const { return root_; }
+  size_t size() const { return metrics_.size(); }
+
+ private:
+  // Names don't affect the encoded size, since tokens are fixed32 fields, so
+  // the tree uses arbitrary token values rather than tokenized strings.
+  Group root_{0x1000};
+  std::array<Group, 4> groups_{
+      Group(0x1001), Group(0x1002), Group(0x1003), Group(0x1004)};
+  std::array<TypedMetric<uint32_t>, 4 * kMetricsPerGroup> metrics_ =
+      MakeMetrics(std::make_index_sequence<4 * kMetricsPerGroup>());
+
+  template <size_t... kIndices>
+  static std::array<TypedMetric<uint32_t>, sizeof...(kIndices)> MakeMetrics(
+      std::index_sequence<kIndices...>) {
+    return {TypedMetric<uint32_t>(static_cast<Token>(kIndices + 1), 0u)...};
+  }
+};
+
+void ScrapeAll(perf_test::State& state, size_t num_changes) {
+  MetricTree tree;
+  size_t bytes = 0;
+  while (state.KeepRunning()) {
+    tree.Change(num_changes);
+    CountingMetricWriter writer;
+    internal::MetricWalker walker(writer);
+    PW_CHECK_OK(walker.Walk(tree.root()));
+    bytes = writer.bytes();
+  }
+  PW_LOG_INFO("Full scrape of %u metrics with %u changed: %u bytes",
+              static_cast<unsigned>(tree.size()),
+              static_cast<unsigned>(num_changes),
+              static_cast<unsigned>(bytes));
+}
+
+void ScrapeChanges(perf_test::State& state, size_t num_changes) {
+  MetricTree tree;
+  size_t bytes = 0;
+  uint32_t generation = 0;
+  while (state.KeepRunning()) {
+    tree.Change(num_changes);
+    const uint32_t next_generation = AdvanceChangeGeneration();
+    CountingMetricWriter writer;
+    internal::MetricWalker walker(writer, generation);
+    PW_CHECK_OK(walker.Walk(tree.root()));
+    generation = next_generation;
+    bytes = writer.bytes();
+  }
+  PW_LOG_INFO("Changes scrape of %u metrics with %u changed: %u bytes",
+              static_cast<unsigned>(tree.size()),
+              static_cast<unsigned>(num_changes),
+              static_cast<unsigned>(bytes));
+}
+
+PW_PERF_TEST(ScrapeAllWith4Changed, ScrapeAll, 4);
+PW_PERF_TEST(ScrapeChangesWith4Changed, ScrapeChanges, 4);
+PW_PERF_TEST(ScrapeAllWith64Changed, ScrapeAll, 64);
+PW_PERF_TEST(ScrapeChangesWith64Changed, ScrapeChanges, 64);
+
+}  // namespace
+}  // namespace pw::metric
@@ -82,6 +82,15 @@ class NanopbMetricWriter : public virtual internal::MetricWriter {
     }
   }
 
+  // Sends the remaining metrics along with the generation for the client's
+  // next GetChanges call. Always sends a response, even if it has no metrics.
+  void Finish(uint32_t generation) {
+    response_.generation = generation;
+    response_writer_.Write(response_)
+        .IgnoreError();  // TODO: b/242598609 - Handle Status properly
+    response_ = pw_metric_proto_MetricResponse_init_zero;
+  }
+
  private:
   pw_metric_proto_MetricResponse response_;
   // This RPC stream writer handle must be valid for the metric writer lifetime.
@@ -109,4 +118,25 @@ void MetricService::Get(
   writer.Flush();
 }
 
+void MetricService::GetChanges(
+    const pw_metric_proto_MetricChangesRequest& request,
+    ServerWriter<pw_metric_proto_MetricResponse>& response) {
+  // Start a new generation before walking, so that metrics which change during
+  // the walk are sent again in the next call.
+  const uint32_t generation = AdvanceChangeGeneration();
+
+  // A generation that was never returned, e.g. one from before a reboot, can't
+  // be compared with the current ones, so send everything.
+  const uint32_t since_generation =
+      request.since_generation < generation ? request.since_generation : 0;
+
+  NanopbMetricWriter writer(response);
+  internal::MetricWalker walker(writer, since_generation);
+
+  // Like Get(), this streams all the changed metrics in the span of this call.
+  walker.Walk(metrics_).IgnoreError();
+  walker.Walk(groups_).IgnoreError();
+  writer.Finish(generation);
+}
+
 }  // namespace pw::metric
@@ -202,5 +202,53 @@ TEST(MetricService, TokenPaths) {
   }
 }
 
+TEST(MetricService, GetChangesSendsAllMetricsForUnknownGeneration) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+
+  PW_NANOPB_TEST_METHOD_CONTEXT(MetricService, GetChanges, 4, 256)
+  context(root.metrics(), root.children());
+
+  // A generation from before a reboot may be ahead of the current one.
+  context.call({.since_generation = 1000000u});
+  EXPECT_TRUE(context.done());
+  ASSERT_EQ(1u, context.responses().size());
+  EXPECT_EQ(2, context.responses()[0].metrics_count);
+}
+
+#if PW_METRIC_TRACK_CHANGES
+
+TEST(MetricService, GetChangesSendsOnlyChangedMetrics) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+
+  PW_METRIC_GROUP(inner, "inner");
+  PW_METRIC(inner, x, "x", 3u);
+  root.Add(inner);
+
+  PW_NANOPB_TEST_METHOD_CONTEXT(MetricService, GetChanges, 4, 256)
+  context(root.metrics(), root.children());
+
+  // Starting from generation 0 returns every metric.
+  context.call({.since_generation = 0});
+  EXPECT_TRUE(context.done());
+  ASSERT_EQ(1u, context.responses().size());
+  EXPECT_EQ(3, context.responses()[0].metrics_count);
+  const uint32_t generation = context.responses()[0].generation;
+  EXPECT_NE(0u, generation);
+
+  x.Increment();
+  context.call({.since_generation = generation});
+  EXPECT_TRUE(context.done());
+  ASSERT_EQ(1u, context.responses().size());
+  ASSERT_EQ(1, context.responses()[0].metrics_count);
+  EXPECT_EQ(4u, context.responses()[0].metrics[0].value.as_int);
+  EXPECT_GT(context.responses()[0].generation, generation);
+}
+
+#endif  // PW_METRIC_TRACK_CHANGES
+
 }  // namespace
 }  // namespace pw::metric
@@ -22,6 +22,7 @@
 #include "pw_metric_private/metric_walker.h"
 #include "pw_metric_proto/metric_service.pwpb.h"
 #include "pw_preprocessor/util.h"
+#include "pw_protobuf/decoder.h"
 #include "pw_protobuf/serialized_size.h"
 #include "pw_rpc/raw/server_reader_writer.h"
 #include "pw_span/span.h"
@@ -72,43 +73,54 @@ class PwpbMetricWriter : public virtual internal::MetricWriter {
   Status Flush() {
     Status status;
     if (metrics_count) {
-      status = response_writer_.Write(encoder_);
-      // Different way to clear MemoryEncoder. Copy constructor is disabled
-      // for memory encoder, and there is no "clear()" method.
-      encoder_.~MemoryEncoder();
-      new (&encoder_) proto::pwpb::MetricRequest::MemoryEncoder(response_);
-      metrics_count = 0;
+      status = Send();
     }
     return status;
   }
 
+  // Sends the remaining metrics along with the generation for the client's
+  // next GetChanges call. Always sends a response, even if it has no metrics.
+  Status Finish(uint32_t generation) {
+    PW_TRY(encoder_.WriteGeneration(generation));
+    return Send();
+  }
+
  private:
   span<std::byte> response_;
   // This RPC stream writer handle must be valid for the metric writer
   // lifetime.
   rpc::RawServerWriter& response_writer_;
-  proto::pwpb::MetricRequest::MemoryEncoder encoder_;
+  Status Send() {
+    Status status = response_writer_.Write(encoder_);
+    // Different way to clear MemoryEncoder. Copy constructor is disabled
+    // for memory encoder, and there is no "clear()" method.
+    encoder_.~MemoryEncoder();
+    new (&encoder_) proto::pwpb::MetricResponse::MemoryEncoder(response_);
+    metrics_count = 0;
+    return status;
+  }
+
+  proto::pwpb::MetricResponse::MemoryEncoder encoder_;
   size_t metrics_count = 0;
 };
+
+// The `string_path` field of Metric is not supported. The maximum size without
+// values includes the maximum token path. Additionally, include the maximum
+// size of the `as_int` field.
+constexpr size_t kSizeOfOneMetric =
+    pw::metric::proto::pwpb::MetricResponse::kMaxEncodedSizeBytesWithoutValues +
+    pw::metric::proto::pwpb::Metric::kMaxEncodedSizeBytesWithoutValues +
+    protobuf::SizeOfFieldUint32(
+        pw::metric::proto::pwpb::Metric::Fields::kAsInt);
+
+// TODO(amontanez): Make this follow the metric_service.options configuration.
+constexpr size_t kEncodeBufferSize = kMaxNumPackedEntries * kSizeOfOneMetric;
+
 }  // namespace
 
 void MetricService::Get(ConstByteSpan /*request*/,
                         rpc::RawServerWriter& raw_response) {
   // For now, ignore the request and just stream all the metrics back.
-
-  // The `string_path` field of Metric is not supported. The maximum size
-  // without values includes the maximum token path. Additionally, include the
-  // maximum size of the `as_int` field.
-  constexpr size_t kSizeOfOneMetric =
-      pw::metric::proto::pwpb::MetricResponse::
-          kMaxEncodedSizeBytesWithoutValues +
-      pw::metric::proto::pwpb::Metric::kMaxEncodedSizeBytesWithoutValues +
-      protobuf::SizeOfFieldUint32(
-          pw::metric::proto::pwpb::Metric::Fields::kAsInt);
-
-  // TODO(amontanez): Make this follow the metric_service.options configuration.
-  constexpr size_t kEncodeBufferSize = kMaxNumPackedEntries * kSizeOfOneMetric;
-
   std::array<std::byte, kEncodeBufferSize> encode_buffer;
 
   PwpbMetricWriter writer(encode_buffer, raw_response);
@@ -129,4 +141,48 @@ void MetricService::Get(ConstByteSpan /*request*/,
   status.Update(writer.Flush());
   raw_response.Finish(status).IgnoreError();
 }
+
+void MetricService::GetChanges(ConstByteSpan request,
+                               rpc::RawServerWriter& raw_response) {
+  uint32_t since_generation = 0;
+  protobuf::Decoder decoder(request);
+  Status status;
+  while ((status = decoder.Next()).ok()) {
+    if (decoder.FieldNumber() ==
+        static_cast<uint32_t>(proto::pwpb::MetricChangesRequest::Fields::
+                                  kSinceGeneration)) {
+      status = decoder.ReadUint32(&since_generation);
+      if (!status.ok()) {
+        break;
+      }
+    }
+  }
+  if (!status.IsOutOfRange()) {
+    raw_response.Finish(Status::DataLoss()).IgnoreError();
+    return;
+  }
+
+  // Start a new generation before walking, so that metrics which change during
+  // the walk are sent again in the next call.
+  const uint32_t generation = AdvanceChangeGeneration();
+
+  // A generation that was never returned, e.g. one from before a reboot, can't
+  // be compared with the current ones, so send everything.
+  if (since_generation >= generation) {
+    since_generation = 0;
+  }
+
+  std::array<std::byte, kEncodeBufferSize> encode_buffer;
+
+  PwpbMetricWriter writer(encode_buffer, raw_response);
+  internal::MetricWalker walker(writer, since_generation);
+
+  // Like Get(), this streams all the changed metrics in the span of this call.
+  status = OkStatus();
+  status.Update(walker.Walk(metrics_));
+  status.Update(walker.Walk(groups_));
+  status.Update(writer.Finish(generation));
+  raw_response.Finish(status).IgnoreError();
+}
+
 }  // namespace pw::metric
@@ -14,6 +14,8 @@
 
 #include "pw_metric/metric_service_pwpb.h"
 
+#include <array>
+
 #include "pw_log/log.h"
 #include "pw_metric_proto/metric_service.pwpb.h"
 #include "pw_protobuf/decoder.h"
@@ -74,6 +76,19 @@ size_t GetMetricsSum(ConstByteSpan serialized_metric_buffer) {
   return metrics_sum;
 }
 
+uint32_t GetGeneration(ConstByteSpan serialized_metric_buffer) {
+  protobuf::Decoder decoder(serialized_metric_buffer);
+  uint32_t generation = 0;
+  while (decoder.Next().ok()) {
+    if (decoder.FieldNumber() ==
+        static_cast<uint32_t>(
+            pw::metric::proto::pwpb::MetricResponse::Fields::kGeneration)) {
+      EXPECT_EQ(OkStatus(), decoder.ReadUint32(&generation));
+    }
+  }
+  return generation;
+}
+
 TEST(MetricService, EmptyGroupAndNoMetrics) {
   // Empty root group.
   PW_METRIC_GROUP(root, "/");
@@ -169,6 +184,39 @@ TEST(MetricService, NestedGroupFiveMetrics) {
       GetMetricsSum(ctx.responses()[0]) + GetMetricsSum(ctx.responses()[1]));
 }
 
+#if PW_METRIC_GROUP_SHARDED_COUNTERS
+TEST(MetricService, ShardedCountersAndHistograms) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC_GROUP(root, network, "network");
+  PW_METRIC_SHARDED(network, packets, "packets");
+  PW_METRIC_HISTOGRAM(root, latency, "latency", 3, 4);
+  packets.IncrementShard(0, 10u);
+  packets.IncrementShard(1, 20u);
+  latency.Record(2u);
+  latency.Record(100u);
+
+  // Run the RPC and ensure it completes.
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Get)
+  ctx{root.metrics(), root.children()};
+  ctx.call({});
+  EXPECT_TRUE(ctx.done());
+  EXPECT_EQ(OkStatus(), ctx.status());
+
+  // The sharded counter is sent as one metric with the sum of its shards, and
+  // each histogram bucket as one metric.
+  size_t num_metrics = 0;
+  size_t metrics_sum = 0;
+  for (ConstByteSpan response : ctx.responses()) {
+    num_metrics += CountEncodedMetrics(response);
+    metrics_sum += GetMetricsSum(response);
+  }
+  EXPECT_EQ(5u, num_metrics);
+  EXPECT_EQ(33u, metrics_sum);
+}
+#endif  // PW_METRIC_GROUP_SHARDED_COUNTERS
+
 TEST(MetricService, NestedGroupsWithBatches) {
   // Set up a nested group of metrics that will not fit in a single batch.
   PW_METRIC_GROUP(root, "/");
@@ -245,5 +293,173 @@ TEST(MetricService, MaxDepth4) {
   EXPECT_EQ(6u, GetMetricsSum(ctx.responses()[0]));
 }
 
+class GetChangesTest : public ::testing::Test {
+ protected:
+  // Calls GetChanges with the given generation and returns the generation for
+  // the next call.
+  template <typename Context>
+  uint32_t CallGetChanges(Context& ctx, uint32_t since_generation) {
+    std::array<std::byte, 8> request_buffer;
+    proto::pwpb::MetricChangesRequest::MemoryEncoder request(request_buffer);
+    EXPECT_EQ(OkStatus(), request.WriteSinceGeneration(since_generation));
+    ctx.call(request);
+    EXPECT_TRUE(ctx.done());
+    EXPECT_EQ(OkStatus(), ctx.status());
+
+    // The stream always ends with the generation.
+    EXPECT_FALSE(ctx.responses().empty());
+    num_metrics_ = 0;
+    metrics_sum_ = 0;
+    for (ConstByteSpan response : ctx.responses()) {
+      num_metrics_ += CountEncodedMetrics(response);
+      metrics_sum_ += GetMetricsSum(response);
+    }
+    return GetGeneration(ctx.responses().back());
+  }
+
+  size_t num_metrics_ = 0;
+  size_t metrics_sum_ = 0;
+};
+
+TEST_F(GetChangesTest, SendsAllMetricsForUnknownGeneration) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, GetChanges)
+  ctx{root.metrics(), root.children()};
+
+  // A generation from before a reboot may be ahead of the current one.
+  const uint32_t generation = CallGetChanges(ctx, 0);
+  CallGetChanges(ctx, generation + 1000u);
+  EXPECT_EQ(2u, num_metrics_);
+  EXPECT_EQ(3u, metrics_sum_);
+}
+
+#if PW_METRIC_TRACK_CHANGES
+
+TEST_F(GetChangesTest, SendsOnlyChangedMetrics) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+  PW_METRIC(root, f, "f", 1.5f);
+
+  PW_METRIC_GROUP(inner, "inner");
+  PW_METRIC(inner, c, "c", 3u);
+  PW_METRIC(inner, d, "d", 0u);
+  root.Add(inner);
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, GetChanges)
+  ctx{root.metrics(), root.children()};
+
+  // Starting from generation 0 returns every metric.
+  uint32_t generation = CallGetChanges(ctx, 0);
+  EXPECT_NE(0u, generation);
+  EXPECT_EQ(5u, num_metrics_);
+  EXPECT_EQ(6u, metrics_sum_);
+
+  // Nothing changed, so only the generation is sent.
+  uint32_t next_generation = CallGetChanges(ctx, generation);
+  EXPECT_EQ(1u, ctx.responses().size());
+  EXPECT_EQ(0u, num_metrics_);
+  EXPECT_GT(next_generation, generation);
+  generation = next_generation;
+
+  b.Increment(10);
+  d.Increment(5);
+  c.Set(3u);  // Unchanged value.
+  f.Set(2.5f);
+
+  generation = CallGetChanges(ctx, generation);
+  EXPECT_EQ(3u, num_metrics_);
+  EXPECT_EQ(17u, metrics_sum_);
+
+  a.Decrement();
+  generation = CallGetChanges(ctx, generation);
+  EXPECT_EQ(1u, num_metrics_);
+  EXPECT_EQ(0u, metrics_sum_);
+
+  CallGetChanges(ctx, generation);
+  EXPECT_EQ(0u, num_metrics_);
+}
+
+#if PW_METRIC_GROUP_SHARDED_COUNTERS
+TEST_F(GetChangesTest, SendsChangedShardedCounters) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC_GROUP(root, network, "network");
+  PW_METRIC_SHARDED(network, packets, "packets");
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, GetChanges)
+  ctx{root.metrics(), root.children()};
+
+  uint32_t generation = CallGetChanges(ctx, 0);
+  EXPECT_EQ(2u, num_metrics_);
+
+  packets.IncrementShard(0, 4u);
+  packets.IncrementShard(1, 5u);
+  generation = CallGetChanges(ctx, generation);
+  EXPECT_EQ(1u, num_metrics_);
+  EXPECT_EQ(9u, metrics_sum_);
+
+  CallGetChanges(ctx, generation);
+  EXPECT_EQ(0u, num_metrics_);
+}
+#endif  // PW_METRIC_GROUP_SHARDED_COUNTERS
+
+TEST_F(GetChangesTest, ClientsTrackChangesIndependently) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, GetChanges)
+  ctx{root.metrics(), root.children()};
+
+  const uint32_t first_client = CallGetChanges(ctx, 0);
+  a.Increment();
+  const uint32_t second_client = CallGetChanges(ctx, 0);
+  b.Increment();
+
+  // The first client missed both changes, the second only the last one.
+  CallGetChanges(ctx, first_client);
+  EXPECT_EQ(2u, num_metrics_);
+  CallGetChanges(ctx, second_client);
+  EXPECT_EQ(1u, num_metrics_);
+  EXPECT_EQ(3u, metrics_sum_);
+}
+
+#if LIB_STDCOMPAT_CONSTEVAL_SUPPORT
+TEST_F(GetChangesTest, SendsMetricsCreatedAfterPreviousCall) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, GetChanges)
+  ctx{root.metrics(), root.children()};
+
+  const uint32_t generation = CallGetChanges(ctx, 0);
+  PW_METRIC(root, b, "b", 2u);
+  CallGetChanges(ctx, generation);
+  EXPECT_EQ(1u, num_metrics_);
+  EXPECT_EQ(2u, metrics_sum_);
+}
+#endif  // LIB_STDCOMPAT_CONSTEVAL_SUPPORT
+
+#else
+
+TEST_F(GetChangesTest, SendsAllMetricsWithoutTracking) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, GetChanges)
+  ctx{root.metrics(), root.children()};
+
+  const uint32_t generation = CallGetChanges(ctx, 0);
+  CallGetChanges(ctx, generation);
+  EXPECT_EQ(2u, num_metrics_);
+}
+
+#endif  // PW_METRIC_TRACK_CHANGES
+
 }  // namespace
 }  // namespace pw::metric
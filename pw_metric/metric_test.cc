@@ -14,6 +14,7 @@
 
 #include "pw_metric/metric.h"
 
+#include <array>
 #include <limits>
 
 #include "pw_log/log.h"
@@ -286,5 +287,177 @@ TEST(Metric, StaticWithinAFunction) {
   EXPECT_EQ(metric->as_int(), 2u);
 }
 
+#if PW_METRIC_TRACK_CHANGES
+
+TEST(Metric, ChangedSince) {
+  PW_METRIC(counter, "counter", 1u);
+  PW_METRIC(ratio, "ratio", 0.5f);
+  EXPECT_TRUE(counter.ChangedSince(0));
+  EXPECT_TRUE(ratio.ChangedSince(0));
+
+  uint32_t generation = AdvanceChangeGeneration();
+  EXPECT_FALSE(counter.ChangedSince(generation));
+  EXPECT_FALSE(ratio.ChangedSince(generation));
+
+  counter.Increment();
+  ratio.Set(0.5f);  // Setting the same value is not a change.
+  EXPECT_TRUE(counter.ChangedSince(generation));
+  EXPECT_FALSE(ratio.ChangedSince(generation));
+
+  generation = AdvanceChangeGeneration();
+  counter.Set(2u);  // Unchanged.
+  ratio.Set(0.75f);
+  EXPECT_FALSE(counter.ChangedSince(generation));
+  EXPECT_TRUE(ratio.ChangedSince(generation));
+
+  // Saturated counters don't change.
+  counter.Set(std::numeric_limits<uint32_t>::max());
+  generation = AdvanceChangeGeneration();
+  counter.Increment();
+  EXPECT_FALSE(counter.ChangedSince(generation));
+  counter.Decrement();
+  EXPECT_TRUE(counter.ChangedSince(generation));
+}
+
+TEST(Metric, CreatedAfterGenerationHasChanged) {
+  PW_METRIC_GROUP(group, "group");
+  const uint32_t generation = AdvanceChangeGeneration();
+  PW_METRIC(group, counter, "counter", 1u);
+  PW_METRIC(group, ratio, "ratio", 0.5f);
+#if LIB_STDCOMPAT_CONSTEVAL_SUPPORT
+  EXPECT_TRUE(counter.ChangedSince(generation));
+  EXPECT_TRUE(ratio.ChangedSince(generation));
+#endif  // LIB_STDCOMPAT_CONSTEVAL_SUPPORT
+  EXPECT_FALSE(counter.ChangedSince(AdvanceChangeGeneration()));
+  EXPECT_FALSE(ratio.ChangedSince(AdvanceChangeGeneration()));
+}
+
+TEST(ShardedCounter, ChangedSince) {
+  PW_METRIC_SHARDED(counter, "counter");
+  EXPECT_TRUE(counter.ChangedSince(0));
+
+  const uint32_t generation = AdvanceChangeGeneration();
+  EXPECT_FALSE(counter.ChangedSince(generation));
+  counter.IncrementShard(ShardedCounter::kNumShards - 1);
+  EXPECT_TRUE(counter.ChangedSince(generation));
+  EXPECT_FALSE(counter.ChangedSince(AdvanceChangeGeneration()));
+}
+
+#endif  // PW_METRIC_TRACK_CHANGES
+
+TEST(ShardedCounter, SumsShards) {
+  PW_METRIC_SHARDED(counter, "counter");
+  static constexpr Token kToken = PW_METRIC_TOKEN("counter");
+  EXPECT_EQ(counter.name(), kToken);
+  EXPECT_EQ(counter.value(), 0u);
+
+  counter.Increment();
+  counter.Increment(4u);
+  for (size_t shard = 0; shard < ShardedCounter::kNumShards * 2; ++shard) {
+    counter.IncrementShard(shard, 10u);
+  }
+  EXPECT_EQ(counter.value(), 5u + ShardedCounter::kNumShards * 20u);
+}
+
+TEST(ShardedCounter, Saturates) {
+  PW_METRIC_SHARDED(counter, "counter");
+  counter.IncrementShard(0, std::numeric_limits<uint32_t>::max() - 1);
+  counter.IncrementShard(0, 5u);
+  EXPECT_EQ(counter.value(), std::numeric_limits<uint32_t>::max());
+
+  PW_METRIC_SHARDED(split_counter, "split_counter");
+  split_counter.IncrementShard(0, std::numeric_limits<uint32_t>::max() - 1);
+  split_counter.IncrementShard(1, 5u);
+  EXPECT_EQ(split_counter.value(), std::numeric_limits<uint32_t>::max());
+}
+
+TEST(ShardedCounter, Snapshot) {
+  PW_METRIC_SHARDED(counter, "counter");
+  counter.IncrementShard(1, 3u);
+  counter.IncrementShard(2, 4u);
+
+  const TypedMetric<uint32_t> snapshot = counter.Snapshot();
+  EXPECT_EQ(snapshot.name(), counter.name());
+  EXPECT_TRUE(snapshot.is_int());
+  EXPECT_EQ(snapshot.value(), 7u);
+}
+
+#if PW_METRIC_GROUP_SHARDED_COUNTERS
+TEST(ShardedCounter, GroupMacroInFunctionContext) {
+  PW_METRIC_GROUP(group, "network");
+  PW_METRIC(group, errors, "errors", 1u);
+  PW_METRIC_SHARDED(group, packets, "packets");
+  packets.Increment(12u);
+  errors.Increment();
+
+  group.Dump();
+  EXPECT_EQ(group.metrics().size(), 1u);
+  ASSERT_EQ(group.sharded_counters().size(), 1u);
+  EXPECT_EQ(&group.sharded_counters().front(), &packets);
+}
+#endif  // PW_METRIC_GROUP_SHARDED_COUNTERS
+
+TEST(Histogram, BucketBounds) {
+  using Latency = Histogram<5, 16>;
+  EXPECT_EQ(Latency::lower_bound(0), 0u);
+  EXPECT_EQ(Latency::lower_bound(1), 16u);
+  EXPECT_EQ(Latency::lower_bound(2), 32u);
+  EXPECT_EQ(Latency::lower_bound(4), 128u);
+
+  EXPECT_EQ(Latency::BucketIndex(0), 0u);
+  EXPECT_EQ(Latency::BucketIndex(15), 0u);
+  EXPECT_EQ(Latency::BucketIndex(16), 1u);
+  EXPECT_EQ(Latency::BucketIndex(31), 1u);
+  EXPECT_EQ(Latency::BucketIndex(32), 2u);
+  EXPECT_EQ(Latency::BucketIndex(127), 3u);
+  EXPECT_EQ(Latency::BucketIndex(128), 4u);
+  EXPECT_EQ(Latency::BucketIndex(std::numeric_limits<uint32_t>::max()), 4u);
+
+  using Full = Histogram<33>;
+  EXPECT_EQ(Full::BucketIndex(0), 0u);
+  EXPECT_EQ(Full::BucketIndex(1), 1u);
+  EXPECT_EQ(Full::lower_bound(32), 1u << 31);
+  EXPECT_EQ(Full::BucketIndex(std::numeric_limits<uint32_t>::max()), 32u);
+}
+
+TEST(Histogram, RecordCountsValuesInBuckets) {
+  PW_METRIC_HISTOGRAM(latency, "latency", 4, 8);
+  for (uint32_t value : {0u, 7u, 8u, 9u, 20u, 1000u, 64u}) {
+    latency.Record(value);
+  }
+  EXPECT_EQ(latency.count(0), 2u);
+  EXPECT_EQ(latency.count(1), 2u);
+  EXPECT_EQ(latency.count(2), 1u);
+  EXPECT_EQ(latency.count(3), 2u);
+}
+
+TEST(Histogram, BucketsAreMetricsNamedByLowerBound) {
+  PW_METRIC_GROUP(group, "storage");
+  PW_METRIC_HISTOGRAM(group, latency, "latency", 4, 8);
+  latency.Record(9u);
+
+  ASSERT_EQ(group.children().size(), 1u);
+  EXPECT_EQ(&group.children().front(), &latency);
+  static constexpr Token kName =
+      PW_TOKENIZE_STRING_DOMAIN("metrics", "latency");
+  EXPECT_EQ(latency.name(), kName);
+
+  // Buckets are listed in increasing order.
+  static constexpr Token kBucket0 = PW_METRIC_TOKEN("0");
+  static constexpr Token kBucket8 = PW_METRIC_TOKEN("8");
+  static constexpr Token kBucket16 = PW_METRIC_TOKEN("16");
+  static constexpr Token kBucket32 = PW_METRIC_TOKEN("32");
+  static constexpr std::array<Token, 4> kBucketNames = {
+      kBucket0, kBucket8, kBucket16, kBucket32};
+  ASSERT_EQ(latency.metrics().size(), kBucketNames.size());
+  size_t i = 0;
+  for (const Metric& bucket : latency.metrics()) {
+    EXPECT_EQ(bucket.name(), kBucketNames[i]);
+    EXPECT_EQ(bucket.as_int(), i == 1 ? 1u : 0u);
+    ++i;
+  }
+  group.Dump();
+}
+
 }  // namespace
 }  // namespace pw::metric
@@ -0,0 +1,69 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+// The number of shards in a pw::metric::ShardedCounter. Each shard takes
+// PW_METRIC_SHARD_ALIGNMENT bytes. More shards reduce contention when many
+// threads increment the same counter at once.
+#ifndef PW_METRIC_SHARDED_COUNTER_SHARDS
+#define PW_METRIC_SHARDED_COUNTER_SHARDS 4
+#endif  // PW_METRIC_SHARDED_COUNTER_SHARDS
+
+// The alignment of each shard of a pw::metric::ShardedCounter. This should be
+// the size of a cache line, so that threads incrementing different shards do
+// not contend for the same line.
+#ifndef PW_METRIC_SHARD_ALIGNMENT
+#define PW_METRIC_SHARD_ALIGNMENT 64
+#endif  // PW_METRIC_SHARD_ALIGNMENT
+
+// The number of low bits of a stack address discarded by
+// pw::metric::ThisThreadShard(). Threads whose stack pointers are within the
+// same 2^PW_METRIC_THREAD_SHARD_STACK_SHIFT bytes may share a shard, so this
+// should be less than log2 of the smallest thread stack. A thread may move
+// between shards as its call depth changes, which only costs locality.
+#ifndef PW_METRIC_THREAD_SHARD_STACK_SHIFT
+#define PW_METRIC_THREAD_SHARD_STACK_SHIFT 8
+#endif  // PW_METRIC_THREAD_SHARD_STACK_SHIFT
+
+// Whether groups hold a list of pw::metric::ShardedCounters, which are reported
+// along with their metrics. This adds a pointer to every group.
+#ifndef PW_METRIC_GROUP_SHARDED_COUNTERS
+#define PW_METRIC_GROUP_SHARDED_COUNTERS 0
+#endif  // PW_METRIC_GROUP_SHARDED_COUNTERS
+
+// Whether metrics record when they last changed, so that MetricService can
+// send only the metrics that changed since a client's previous request. This
+// adds 4 bytes to each metric and each sharded counter shard, so it is disabled
+// by default. When disabled, every metric is reported as changed.
+#ifndef PW_METRIC_TRACK_CHANGES
+#define PW_METRIC_TRACK_CHANGES 0
+#endif  // PW_METRIC_TRACK_CHANGES
+
+namespace pw::metric::cfg {
+
+inline constexpr size_t kShardedCounterShards =
+    PW_METRIC_SHARDED_COUNTER_SHARDS;
+
+inline constexpr size_t kShardAlignment = PW_METRIC_SHARD_ALIGNMENT;
+
+inline constexpr size_t kThreadShardStackShift =
+    PW_METRIC_THREAD_SHARD_STACK_SHIFT;
+
+inline constexpr bool kGroupShardedCounters = PW_METRIC_GROUP_SHARDED_COUNTERS;
+
+inline constexpr bool kTrackChanges = PW_METRIC_TRACK_CHANGES;
+
+}  // namespace pw::metric::cfg
@@ -14,11 +14,18 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
+#include <utility>
 
+#include "lib/stdcompat/bit.h"
+#include "lib/stdcompat/type_traits.h"
 #include "pw_containers/intrusive_list.h"
+#include "pw_metric/config.h"
+#include "pw_metric/thread_shard.h"
 #include "pw_preprocessor/arguments.h"
 #include "pw_tokenizer/tokenize.h"
 
@@ -31,11 +38,21 @@ using tokenizer::Token;
 
 #define _PW_METRIC_TOKEN_MASK 0x7fffffff
 
+// Starts a new change generation and returns it. Metrics and sharded counters
+// changed after this call return true from ChangedSince() with the returned
+// generation, while those last changed before it return false. Generation 0
+// precedes all changes, so ChangedSince(0) is always true.
+//
+// Clients that track changes keep the generation from one snapshot and pass it
+// to ChangedSince() for the next, e.g. via MetricService::GetChanges.
+uint32_t AdvanceChangeGeneration();
+
 // An individual metric. There are only two supported types: uint32_t and
 // float. More complicated compound metrics can be built on these primitives.
 // See the documentation for a discussion for this design was selected.
 //
-// Size: 12 bytes / 96 bits - next, name, value.
+// Size: 12 bytes / 96 bits - next, name, value. If PW_METRIC_TRACK_CHANGES is
+// enabled, 16 bytes / 128 bits - next, name, value, generation.
 //
 // TODO(keir): Implement Set() and Increment() using atomics.
 // TODO(keir): Consider an alternative structure where metrics have pointers to
@@ -56,6 +73,11 @@ class Metric : public IntrusiveList<Metric>::Item {
   float as_float() const;
   uint32_t as_int() const;
 
+  // Returns whether the value changed after the given generation was returned
+  // by AdvanceChangeGeneration(). Always true if PW_METRIC_TRACK_CHANGES is
+  // disabled.
+  bool ChangedSince(uint32_t generation) const;
+
   // Dump a metric or metrics to logs. Level determines the indentation
   // indent_level up to a maximum of 4. Example output:
   //
@@ -68,10 +90,14 @@ class Metric : public IntrusiveList<Metric>::Item {
 
  protected:
   constexpr Metric(Token name, float value)
-      : name_and_type_((name & kTokenMask) | kTypeFloat), float_(value) {}
+      : name_and_type_((name & kTokenMask) | kTypeFloat), float_(value) {
+    MarkCreated();
+  }
 
   constexpr Metric(Token name, uint32_t value)
-      : name_and_type_((name & kTokenMask) | kTypeInt), uint_(value) {}
+      : name_and_type_((name & kTokenMask) | kTypeInt), uint_(value) {
+    MarkCreated();
+  }
 
   Metric(Token name, float value, IntrusiveList<Metric>& metrics);
   Metric(Token name, uint32_t value, IntrusiveList<Metric>& metrics);
@@ -91,6 +117,21 @@ class Metric : public IntrusiveList<Metric>::Item {
   void SetFloat(float value);
 
  private:
+  // Records a metric created at run time, such as a local or a member of an
+  // object, as changed in the current generation, so that clients which last
+  // scraped before it existed still receive it. Constant-initialized metrics
+  // exist before the first generation and are not stamped.
+  constexpr void MarkCreated() {
+#if PW_METRIC_TRACK_CHANGES && LIB_STDCOMPAT_CONSTEVAL_SUPPORT
+    if (!cpp20::is_constant_evaluated()) {
+      MarkChanged();
+    }
+#endif  // PW_METRIC_TRACK_CHANGES && LIB_STDCOMPAT_CONSTEVAL_SUPPORT
+  }
+
+  // Records that the value changed in the current generation.
+  void MarkChanged();
+
   // The name of this metric as a token; from PW_TOKENIZE_STRING("my_metric").
   // Last bit of the token is used to store int or float; 0 == int, 1 == float.
   Token name_and_type_;
@@ -100,6 +141,11 @@ class Metric : public IntrusiveList<Metric>::Item {
     std::atomic<uint32_t> uint_;
   };
 
+#if PW_METRIC_TRACK_CHANGES
+  // The generation in which the value last changed.
+  std::atomic<uint32_t> generation_{0};
+#endif  // PW_METRIC_TRACK_CHANGES
+
   enum : uint32_t {
     kTokenMask = _PW_METRIC_TOKEN_MASK,  // 0x7fff'ffff
     kTypeMask = 0x8000'0000,
@@ -151,9 +197,93 @@ class TypedMetric<uint32_t> : public Metric {
   uint32_t as_int() const { return 0; }
 };
 
-// A metric tree; consisting of children groups and leaf metrics.
+// A uint32_t counter for hot paths that many threads increment at once.
+//
+// Increments are spread over PW_METRIC_SHARDED_COUNTER_SHARDS shards, each on
+// its own cache line, and summed when the counter is read. Threads
+// incrementing different shards do not contend for the same cache line, unlike
+// threads incrementing a TypedMetric<uint32_t>. Like other metrics, the value
+// saturates at the maximum uint32_t.
+//
+// Increment() picks a shard with ThisThreadShard(), from the calling thread's
+// stack address. Callers that know their CPU or thread index can pick the
+// shard with IncrementShard() instead.
 //
-// Size: 16 bytes/128 bits - next, name, metrics, children.
+// If PW_METRIC_GROUP_SHARDED_COUNTERS is enabled, sharded counters in a Group
+// are reported along with its metrics, for example by MetricService and
+// Group::Dump().
+//
+// Size: (PW_METRIC_SHARDED_COUNTER_SHARDS + 1) * PW_METRIC_SHARD_ALIGNMENT
+// bytes - next and name, then each shard on its own cache line.
+class ShardedCounter : public IntrusiveList<ShardedCounter>::Item {
+ public:
+  static constexpr size_t kNumShards = cfg::kShardedCounterShards;
+
+  constexpr ShardedCounter(Token name) : name_(name & kTokenMask) {
+    MarkCreated();
+  }
+  ShardedCounter(Token name, IntrusiveList<ShardedCounter>& counters);
+
+  // Disallow copy and assign.
+  ShardedCounter(ShardedCounter const&) = delete;
+  void operator=(const ShardedCounter&) = delete;
+
+  Token name() const { return name_; }
+
+  // Saturating add to the calling thread's shard.
+  void Increment(uint32_t amount = 1u) {
+    IncrementShard(ThisThreadShard(), amount);
+  }
+
+  // Saturating add to the given shard, modulo the number of shards.
+  void IncrementShard(size_t shard, uint32_t amount = 1u);
+
+  // Returns the sum of the shards. Increments made while reading may or may
+  // not be included.
+  uint32_t value() const;
+
+  // Returns a snapshot of the value as a metric with the same name, which can
+  // be dumped or serialized like the metrics of a group.
+  TypedMetric<uint32_t> Snapshot() const { return {name_, value()}; }
+
+  // Returns whether any shard changed after the given generation was returned
+  // by AdvanceChangeGeneration(). Always true if PW_METRIC_TRACK_CHANGES is
+  // disabled.
+  bool ChangedSince(uint32_t generation) const;
+
+ private:
+  static constexpr Token kTokenMask = _PW_METRIC_TOKEN_MASK;
+
+  // Like Metric::MarkCreated(); stamps the first shard.
+  constexpr void MarkCreated() {
+#if PW_METRIC_TRACK_CHANGES && LIB_STDCOMPAT_CONSTEVAL_SUPPORT
+    if (!cpp20::is_constant_evaluated()) {
+      MarkChanged();
+    }
+#endif  // PW_METRIC_TRACK_CHANGES && LIB_STDCOMPAT_CONSTEVAL_SUPPORT
+  }
+
+  // Records that the first shard changed in the current generation.
+  void MarkChanged();
+
+  // Each shard records its own change generation, so that tracking changes
+  // does not make the shards share a cache line again.
+  struct alignas(cfg::kShardAlignment) Shard {
+    std::atomic<uint32_t> value{0};
+#if PW_METRIC_TRACK_CHANGES
+    std::atomic<uint32_t> generation{0};
+#endif  // PW_METRIC_TRACK_CHANGES
+  };
+
+  Token name_;
+  std::array<Shard, kNumShards> shards_;
+};
+
+// A metric tree; consisting of children groups, leaf metrics and, if
+// PW_METRIC_GROUP_SHARDED_COUNTERS is enabled, sharded counters.
+//
+// Size: 16 bytes/128 bits - next, name, metrics, children. 20 bytes/160 bits
+// with sharded counters.
 class Group : public IntrusiveList<Group>::Item {
  public:
   constexpr Group(Token name) : name_(name) {}
@@ -167,12 +297,25 @@ class Group : public IntrusiveList<Group>::Item {
 
   void Add(Metric& metric) { metrics_.push_front(metric); }
   void Add(Group& group) { children_.push_front(group); }
+#if PW_METRIC_GROUP_SHARDED_COUNTERS
+  void Add(ShardedCounter& counter) { sharded_counters_.push_front(counter); }
+#endif  // PW_METRIC_GROUP_SHARDED_COUNTERS
 
   IntrusiveList<Metric>& metrics() { return metrics_; }
   IntrusiveList<Group>& children() { return children_; }
+#if PW_METRIC_GROUP_SHARDED_COUNTERS
+  IntrusiveList<ShardedCounter>& sharded_counters() {
+    return sharded_counters_;
+  }
+#endif  // PW_METRIC_GROUP_SHARDED_COUNTERS
 
   const IntrusiveList<Metric>& metrics() const { return metrics_; }
   const IntrusiveList<Group>& children() const { return children_; }
+#if PW_METRIC_GROUP_SHARDED_COUNTERS
+  const IntrusiveList<ShardedCounter>& sharded_counters() const {
+    return sharded_counters_;
+  }
+#endif  // PW_METRIC_GROUP_SHARDED_COUNTERS
 
   // Dump a metric group or groups to logs. Level determines the indentation
   // indent_level up to a maximum of 4. Example output:
@@ -201,6 +344,91 @@ class Group : public IntrusiveList<Group>::Item {
 
   IntrusiveList<Metric> metrics_;
   IntrusiveList<Group> children_;
+#if PW_METRIC_GROUP_SHARDED_COUNTERS
+  IntrusiveList<ShardedCounter> sharded_counters_;
+#endif  // PW_METRIC_GROUP_SHARDED_COUNTERS
+};
+
+namespace internal {
+
+// Returns the token of the name of a histogram bucket with the given lower
+// bound: "0" for 0, or the decimal value of 2^(index - 1).
+Token HistogramBucketName(size_t lower_bound_index);
+
+}  // namespace internal
+
+// A histogram of uint32_t values, such as latencies, with buckets whose bounds
+// are powers of two.
+//
+// The first bucket counts values below kMinBound, which must be a power of
+// two. Each following bucket counts values up to twice its lower bound, and the
+// last bucket counts all values from its lower bound up. For example,
+// Histogram<5, 16> has buckets for [0, 16), [16, 32), [32, 64), [64, 128) and
+// [128, max].
+//
+// A histogram is a group with one uint32_t metric per bucket, named after the
+// bucket's lower bound, so it is reported like any other group. Add it to a
+// parent group to include it in the parent's metrics.
+//
+// Size: a Group, and a TypedMetric<uint32_t> for each bucket.
+template <size_t kNumBuckets, uint32_t kMinBound = 1u>
+class Histogram : public Group {
+ public:
+  static_assert(kNumBuckets >= 2, "Histograms need at least two buckets");
+  static_assert(cpp20::has_single_bit(kMinBound),
+                "The minimum bound must be a power of two");
+  static_assert(static_cast<size_t>(cpp20::countr_zero(kMinBound)) +
+                        kNumBuckets - 1 <=
+                    32,
+                "The bucket bounds must fit in a uint32_t");
+
+  Histogram(Token name) : Histogram(name, Indices()) {}
+  Histogram(Token name, IntrusiveList<Group>& groups) : Histogram(name) {
+    groups.push_front(*this);
+  }
+
+  // Counts the value in its bucket.
+  void Record(uint32_t value) { buckets_[BucketIndex(value)].Increment(); }
+
+  // Returns the number of values counted in a bucket.
+  uint32_t count(size_t bucket) const { return buckets_[bucket].value(); }
+
+  // Returns the smallest value counted in a bucket.
+  static constexpr uint32_t lower_bound(size_t bucket) {
+    return bucket == 0 ? 0u : kMinBound << (bucket - 1);
+  }
+
+  // Returns the index of the bucket that counts a value.
+  static constexpr size_t BucketIndex(uint32_t value) {
+    if (value < kMinBound) {
+      return 0;
+    }
+    const size_t bucket =
+        static_cast<size_t>(cpp20::bit_width(value / kMinBound));
+    return std::min(bucket, kNumBuckets - 1);
+  }
+
+ private:
+  using Indices = std::make_index_sequence<kNumBuckets>;
+
+  static constexpr size_t kMinBoundIndex =
+      static_cast<size_t>(cpp20::countr_zero(kMinBound));
+
+  template <size_t... kIndices>
+  Histogram(Token name, std::index_sequence<kIndices...>)
+      : Group(name),
+        buckets_{TypedMetric<uint32_t>(
+            internal::HistogramBucketName(
+                kIndices == 0 ? 0 : kMinBoundIndex + kIndices),
+            0u)...} {
+    // Groups list their metrics in reverse order of addition, so add the
+    // buckets from the last to list them in increasing order.
+    for (size_t i = kNumBuckets; i > 0; --i) {
+      Add(buckets_[i - 1]);
+    }
+  }
+
+  std::array<TypedMetric<uint32_t>, kNumBuckets> buckets_;
 };
 
 // Declare a metric, optionally adding it to a group. Use:
@@ -323,4 +551,65 @@ class Group : public IntrusiveList<Group>::Item {
   static_def ::pw::metric::Group variable_name = {variable_name##_token,  \
                                                   parent.children()}
 
+// Define a sharded counter, optionally adding it to a group. Works like
+// PW_METRIC, in the same contexts, but without an initial value. Adding it to a
+// group requires PW_METRIC_GROUP_SHARDED_COUNTERS. Use:
+//
+//   PW_METRIC_SHARDED(variable_name, metric_name)
+//   PW_METRIC_SHARDED(group, variable_name, metric_name)
+//
+// Example:
+//
+//   PW_METRIC_GROUP(metrics_, "network");
+//   PW_METRIC_SHARDED(metrics_, packets_received_, "packets_received");
+//
+#define PW_METRIC_SHARDED(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_SHARDED_, , __VA_ARGS__)
+#define PW_METRIC_SHARDED_STATIC(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_SHARDED_, static, __VA_ARGS__)
+
+#define _PW_METRIC_SHARDED_3(static_def, variable_name, metric_name) \
+  static constexpr uint32_t variable_name##_token =                  \
+      PW_METRIC_TOKEN(metric_name);                                  \
+  static_def ::pw::metric::ShardedCounter variable_name = {          \
+      variable_name##_token}
+
+#define _PW_METRIC_SHARDED_4(static_def, group, variable_name, metric_name) \
+  static constexpr uint32_t variable_name##_token =                         \
+      PW_METRIC_TOKEN(metric_name);                                         \
+  static_def ::pw::metric::ShardedCounter variable_name = {                 \
+      variable_name##_token, group.sharded_counters()}
+
+// Define a histogram, optionally adding it to a group. Works like
+// PW_METRIC_GROUP, in the same contexts. Use:
+//
+//   PW_METRIC_HISTOGRAM(variable_name, name, num_buckets, min_bound)
+//   PW_METRIC_HISTOGRAM(group, variable_name, name, num_buckets, min_bound)
+//
+// Example:
+//
+//   PW_METRIC_GROUP(metrics_, "storage");
+//   // Buckets for [0, 16), [16, 32), ... [4096, max] microseconds.
+//   PW_METRIC_HISTOGRAM(metrics_, write_latency_us_, "write_latency_us", 10,
+//                       16);
+//
+#define PW_METRIC_HISTOGRAM(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_HISTOGRAM_, , __VA_ARGS__)
+#define PW_METRIC_HISTOGRAM_STATIC(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_HISTOGRAM_, static, __VA_ARGS__)
+
+#define _PW_METRIC_HISTOGRAM_5(                                              \
+    static_def, variable_name, histogram_name, num_buckets, min_bound)       \
+  static constexpr uint32_t variable_name##_token =                          \
+      PW_TOKENIZE_STRING_DOMAIN("metrics", histogram_name);                  \
+  static_def ::pw::metric::Histogram<num_buckets, min_bound> variable_name = \
+      {variable_name##_token}
+
+#define _PW_METRIC_HISTOGRAM_6(                                               \
+    static_def, group, variable_name, histogram_name, num_buckets, min_bound) \
+  static constexpr uint32_t variable_name##_token =                           \
+      PW_TOKENIZE_STRING_DOMAIN("metrics", histogram_name);                   \
+  static_def ::pw::metric::Histogram<num_buckets, min_bound> variable_name =  \
+      {variable_name##_token, group.children()}
+
 }  // namespace pw::metric
@@ -41,6 +41,11 @@ class MetricService final
   void Get(const pw_metric_proto_MetricRequest& request,
            ServerWriter<pw_metric_proto_MetricResponse>& response);
 
+  // Streams only the metrics that changed since the generation in the request.
+  // The last response sets the generation for the client's next request.
+  void GetChanges(const pw_metric_proto_MetricChangesRequest& request,
+                  ServerWriter<pw_metric_proto_MetricResponse>& response);
+
  private:
   const IntrusiveList<Metric>& metrics_;
   const IntrusiveList<Group>& groups_;
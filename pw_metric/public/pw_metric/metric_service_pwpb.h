@@ -42,6 +42,10 @@ class MetricService final
 
   void Get(ConstByteSpan request, rpc::RawServerWriter& response);
 
+  // Streams only the metrics that changed since the generation in the request.
+  // The last response sets the generation for the client's next request.
+  void GetChanges(ConstByteSpan request, rpc::RawServerWriter& response);
+
  private:
   const IntrusiveList<Metric>& metrics_;
   const IntrusiveList<Group>& groups_;
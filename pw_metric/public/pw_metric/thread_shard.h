@@ -0,0 +1,39 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_metric/config.h"
+
+namespace pw::metric {
+
+// Returns a number that tends to differ between threads, for spreading writes
+// from several threads over the shards of a data structure. Reduce it modulo
+// the number of shards.
+//
+// Each thread runs on its own stack, so the address of a local variable
+// identifies the calling thread without depending on a thread library. The low
+// PW_METRIC_THREAD_SHARD_STACK_SHIFT bits, which vary with the call depth, are
+// discarded and the rest are mixed. This is only a hint: threads may share a
+// shard, and a thread may use different shards at different call depths.
+inline size_t ThisThreadShard() {
+  const int marker = 0;
+  const uintptr_t stack_block =
+      reinterpret_cast<uintptr_t>(&marker) >> cfg::kThreadShardStackShift;
+  return static_cast<size_t>((stack_block * 2654435761u) >> 16);
+}
+
+}  // namespace pw::metric
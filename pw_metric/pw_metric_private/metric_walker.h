@@ -13,11 +13,14 @@
 // the License.
 #pragma once
 
+#include <cstdint>
+
 #include "pw_assert/check.h"
 #include "pw_containers/intrusive_list.h"
 #include "pw_containers/vector.h"
 #include "pw_metric/metric.h"
 #include "pw_status/status.h"
+#include "pw_status/try.h"
 #include "pw_tokenizer/tokenize.h"
 
 namespace pw::metric::internal {
@@ -29,19 +32,38 @@ class MetricWriter {
 };
 
 // Walk a metric tree recursively; passing metrics with their path (names) to a
-// MetricWriter that can consume them.
+// MetricWriter that can consume them. If a generation from
+// AdvanceChangeGeneration() is given, only metrics that changed since that
+// generation are written; groups are always walked.
 class MetricWalker {
  public:
-  MetricWalker(MetricWriter& writer) : writer_(writer) {}
+  MetricWalker(MetricWriter& writer, uint32_t since_generation = 0)
+      : writer_(writer), since_generation_(since_generation) {}
 
   Status Walk(const IntrusiveList<Metric>& metrics) {
     for (const auto& m : metrics) {
+      if (!m.ChangedSince(since_generation_)) {
+        continue;
+      }
       ScopedName scoped_name(m.name(), *this);
       PW_TRY(writer_.Write(m, path_));
     }
     return OkStatus();
   }
 
+  // Sharded counters are written as a snapshot of their value.
+  Status Walk(const IntrusiveList<ShardedCounter>& counters) {
+    for (const auto& c : counters) {
+      if (!c.ChangedSince(since_generation_)) {
+        continue;
+      }
+      ScopedName scoped_name(c.name(), *this);
+      const TypedMetric<uint32_t> snapshot = c.Snapshot();
+      PW_TRY(writer_.Write(snapshot, path_));
+    }
+    return OkStatus();
+  }
+
   Status Walk(const IntrusiveList<Group>& groups) {
     for (const auto& g : groups) {
       PW_TRY(Walk(g));
@@ -52,6 +74,9 @@ class MetricWalker {
   Status Walk(const Group& group) {
     ScopedName scoped_name(group.name(), *this);
     PW_TRY(Walk(group.children()));
+#if PW_METRIC_GROUP_SHARDED_COUNTERS
+    PW_TRY(Walk(group.sharded_counters()));
+#endif  // PW_METRIC_GROUP_SHARDED_COUNTERS
     PW_TRY(Walk(group.metrics()));
     return OkStatus();
   }
@@ -70,6 +95,7 @@ class MetricWalker {
 
   Vector<Token, /*capacity=*/4> path_;
   MetricWriter& writer_;
+  uint32_t since_generation_;
 };
 
 }  // namespace pw::metric::internal
@@ -49,6 +49,11 @@ class MultiSink {
       // Provides access to the peeked entry's data.
       ConstByteSpan entry() const { return entry_; }
 
+      // Returns the entry's sequence ID in the MultiSink. Every drain that
+      // peeks the same entry gets the same ID, so it can be used to share data
+      // derived from the entry between drains.
+      uint32_t sequence_id() const { return sequence_id_; }
+
      private:
       friend MultiSink;
       friend MultiSink::Drain;
@@ -56,8 +61,6 @@ class MultiSink {
       constexpr PeekedEntry(ConstByteSpan entry, uint32_t sequence_id)
           : entry_(entry), sequence_id_(sequence_id) {}
 
-      uint32_t sequence_id() const { return sequence_id_; }
-
       const ConstByteSpan entry_;
       const uint32_t sequence_id_;
     };
@@ -54,5 +54,17 @@ PW_PERF_TEST(
     4);
 // DOCSTAG: [pw_perf_test_examples-lambda_example]
 
+// DOCSTAG: [pw_perf_test_examples-range_example]
+void ProcessBytes(pw::perf_test::State& state) {
+  const auto size = static_cast<size_t>(state.argument());
+  state.SetBytesPerIteration(size);
+  while (state.KeepRunning()) {
+    SimulateWork(size, 1);
+  }
+}
+// Runs with arguments 1, 4, and 10.
+PW_PERF_TEST_RANGE(ProcessBytesRange, ProcessBytes, 1, 10, 4);
+// DOCSTAG: [pw_perf_test_examples-range_example]
+
 }  // namespace
 }  // namespace pw::perf_test
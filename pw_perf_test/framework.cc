@@ -29,17 +29,39 @@ int Framework::RunAllTests() {
   event_handler_->RunAllTestsStart(run_info_);
 
   for (const TestInfo* test = tests_; test != nullptr; test = test->next()) {
-    State test_state = internal::CreateState(
-        kDefaultIterations, *event_handler_, test->test_name());
-    test->Run(test_state);
+    const ArgumentRange* arguments = test->arguments();
+    if (arguments == nullptr) {
+      RunTest(*test, TestCase{.name = test->test_name()});
+      continue;
+    }
+    int64_t argument = arguments->first;
+    while (true) {
+      RunTest(*test,
+              TestCase{.name = test->test_name(),
+                       .argument = argument,
+                       .has_argument = true});
+      if (argument == arguments->last) {
+        break;
+      }
+      argument = arguments->Next(argument);
+    }
   }
   internal::TimerCleanup();
   event_handler_->RunAllTestsEnd();
   return true;
 }
 
+void Framework::RunTest(const TestInfo& test, const TestCase& test_case) {
+  State test_state = internal::CreateState(kDefaultIterations,
+                                           PW_PERF_TEST_MIN_SAMPLE_DURATION,
+                                           *event_handler_,
+                                           test_case);
+  test.Run(test_state);
+}
+
 void Framework::RegisterTest(TestInfo& new_test) {
-  ++run_info_.total_tests;
+  const ArgumentRange* arguments = new_test.arguments();
+  run_info_.total_tests += arguments == nullptr ? 1 : arguments->count();
   if (tests_ == nullptr) {
     tests_ = &new_test;
     return;
@@ -0,0 +1,64 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_perf_test/json_event_handler.h"
+
+#include "pw_bytes/span.h"
+#include "pw_json/builder.h"
+#include "pw_perf_test/internal/timer.h"
+
+namespace pw::perf_test {
+
+void JsonEventHandler::RunAllTestsStart(const TestRunInfo&) {}
+
+void JsonEventHandler::RunAllTestsEnd() {}
+
+void JsonEventHandler::TestCaseStart(const TestCase&) {}
+
+void JsonEventHandler::TestCaseIteration(const TestIteration&) {}
+
+void JsonEventHandler::TestCaseEnd(const TestCase& info,
+                                   const TestMeasurement& measurement) {
+  JsonBuffer<kMaxObjectSize> json;
+  JsonObject& object = json.StartObject().Add("name", info.name);
+  if (info.has_argument) {
+    object.Add("argument", info.argument);
+  }
+  object.Add("unit", internal::GetDurationUnitStr())
+      .Add("samples", measurement.samples)
+      .Add("iterations_per_sample", measurement.iterations_per_sample)
+      .Add("mean", measurement.mean)
+      .Add("min", measurement.min)
+      .Add("max", measurement.max)
+      .Add("sample_p50", measurement.sample_p50)
+      .Add("sample_p90", measurement.sample_p90)
+      .Add("sample_p99", measurement.sample_p99)
+      .Add("stddev", measurement.stddev)
+      .Add("bytes_per_second", measurement.bytes_per_second)
+      .Add("items_per_second", measurement.items_per_second);
+  if (!measurement.counters.empty()) {
+    NestedJsonObject counters = object.AddNestedObject("counters");
+    for (const TestCounter& counter : measurement.counters) {
+      counters.Add(counter.name, counter.per_iteration);
+    }
+  }
+  if (!object.ok()) {
+    return;  // The name is too long; skip this test rather than emit bad JSON.
+  }
+  // Output is best effort, since there is nowhere to report a failure.
+  writer_.Write(as_bytes(span(json.data(), json.size()))).IgnoreError();
+  writer_.Write(as_bytes(span("\n", 1))).IgnoreError();
+}
+
+}  // namespace pw::perf_test
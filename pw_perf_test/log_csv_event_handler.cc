@@ -18,11 +18,14 @@
 
 #include "pw_log/log.h"
 #include "pw_perf_test/internal/timer.h"
+#include "pw_string/string_builder.h"
 
 namespace pw::perf_test {
 
 void LogCsvEventHandler::RunAllTestsStart(const TestRunInfo&) {
-  PW_LOG_INFO("test name,total iterations,min,max,mean,unit");
+  PW_LOG_INFO(
+      "test name,total iterations,min,max,mean,unit,"
+      "sample p50,sample p90,sample p99,stddev,iterations per sample");
 }
 
 void LogCsvEventHandler::RunAllTestsEnd() {}
@@ -35,14 +38,26 @@ void LogCsvEventHandler::TestCaseIteration(const TestIteration&) {
 
 void LogCsvEventHandler::TestCaseEnd(const TestCase& info,
                                      const TestMeasurement& measurement) {
+  // Parameterized tests are named "name/argument".
+  StringBuffer<kMaxNameSize> name;
+  name << info.name;
+  if (info.has_argument) {
+    name.Format("/%ld", static_cast<long>(info.argument));
+  }
+
   // Use long instead of long long since some platforms don't support %lld
-  PW_LOG_INFO("%s,%d,%ld,%ld,%ld,%s",
-              info.name,
+  PW_LOG_INFO("%s,%d,%ld,%ld,%ld,%s,%ld,%ld,%ld,%ld,%u",
+              name.c_str(),
               iterations_,
               static_cast<long>(measurement.min),
               static_cast<long>(measurement.max),
               static_cast<long>(measurement.mean),
-              internal::GetDurationUnitStr());
+              internal::GetDurationUnitStr(),
+              static_cast<long>(measurement.sample_p50),
+              static_cast<long>(measurement.sample_p90),
+              static_cast<long>(measurement.sample_p99),
+              static_cast<long>(measurement.stddev),
+              static_cast<unsigned>(measurement.iterations_per_sample));
 }
 
 }  // namespace pw::perf_test
@@ -15,6 +15,8 @@
 
 #include "pw_perf_test/logging_event_handler.h"
 
+#include <cmath>
+
 #include "pw_log/log.h"
 #include "pw_perf_test/event_handler.h"
 #include "pw_perf_test/googletest_style_event_handler.h"
@@ -34,7 +36,13 @@ void LoggingEventHandler::RunAllTestsEnd() {
 }
 
 void LoggingEventHandler::TestCaseStart(const TestCase& info) {
-  PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_START, info.name);
+  if (info.has_argument) {
+    PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_START_WITH_ARGUMENT,
+                info.name,
+                static_cast<long>(info.argument));
+  } else {
+    PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_START, info.name);
+  }
 }
 
 void LoggingEventHandler::TestCaseIteration(const TestIteration& iteration) {
@@ -54,7 +62,41 @@ void LoggingEventHandler::TestCaseEnd(const TestCase& info,
               internal::GetDurationUnitStr(),
               static_cast<long>(measurement.max),
               internal::GetDurationUnitStr());
-  PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_END, info.name);
+  PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_PERCENTILES,
+              static_cast<long>(measurement.sample_p50),
+              internal::GetDurationUnitStr(),
+              static_cast<long>(measurement.sample_p90),
+              internal::GetDurationUnitStr(),
+              static_cast<long>(measurement.sample_p99),
+              internal::GetDurationUnitStr(),
+              static_cast<long>(measurement.stddev),
+              internal::GetDurationUnitStr());
+  PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_SAMPLES,
+              static_cast<unsigned>(measurement.samples),
+              static_cast<unsigned>(measurement.iterations_per_sample));
+  if (measurement.bytes_per_second != 0) {
+    PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_BYTES_PER_SECOND,
+                static_cast<long>(measurement.bytes_per_second));
+  }
+  if (measurement.items_per_second != 0) {
+    PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_ITEMS_PER_SECOND,
+                static_cast<long>(measurement.items_per_second));
+  }
+  for (const TestCounter& counter : measurement.counters) {
+    // Print with two decimal places, since not all platforms support %f.
+    const long hundredths = std::lround(counter.per_iteration * 100);
+    PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_COUNTER,
+                counter.name,
+                hundredths / 100,
+                hundredths % 100);
+  }
+  if (info.has_argument) {
+    PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_END_WITH_ARGUMENT,
+                info.name,
+                static_cast<long>(info.argument));
+  } else {
+    PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_END, info.name);
+  }
 }
 
 }  // namespace pw::perf_test
@@ -0,0 +1,153 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_log/log.h"
+#include "pw_perf_test/internal/perf_event_timer_interface.h"
+
+namespace pw::perf_test::internal::backend {
+namespace {
+
+struct CounterType {
+  const char* name;
+  uint64_t config;
+};
+
+constexpr std::array<CounterType, kMaxCounters> kCounterTypes = {{
+    {"cycles", PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache_misses", PERF_COUNT_HW_CACHE_MISSES},
+    {"branch_misses", PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+// Layout of a read from a group leader with PERF_FORMAT_GROUP,
+// PERF_FORMAT_TOTAL_TIME_ENABLED, and PERF_FORMAT_TOTAL_TIME_RUNNING.
+struct GroupReadFormat {
+  uint64_t nr;
+  uint64_t time_enabled;
+  uint64_t time_running;
+  uint64_t values[kMaxCounters];
+};
+
+// File descriptors and names of the opened counters. The first counter is the
+// leader of the group, which lets all counters be read with a single call.
+std::array<int, kMaxCounters> fds;
+std::array<const char*, kMaxCounters> names;
+size_t num_counters = 0;
+
+int OpenCounter(uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  // Only the leader needs to be disabled; the others count when it does.
+  attr.disabled = group_fd < 0 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                     PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // Count events for the calling thread on any CPU.
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+}  // namespace
+
+bool TimerPrepare() {
+  num_counters = 0;
+  for (const CounterType& type : kCounterTypes) {
+    const int group_fd = num_counters == 0 ? -1 : fds[0];
+    const int fd = OpenCounter(type.config, group_fd);
+    if (fd < 0) {
+      PW_LOG_DEBUG("Unable to count %s: %s", type.name, std::strerror(errno));
+      continue;
+    }
+    fds[num_counters] = fd;
+    names[num_counters] = type.name;
+    ++num_counters;
+  }
+  if (num_counters == 0) {
+    PW_LOG_WARN("perf events are unavailable; only measuring time");
+    return true;
+  }
+  ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return true;
+}
+
+void TimerCleanup() {
+  if (num_counters == 0) {
+    return;
+  }
+  ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  // Close the leader last.
+  for (size_t i = num_counters; i != 0; --i) {
+    close(fds[i - 1]);
+  }
+  num_counters = 0;
+}
+
+Timestamp GetCurrentTimestamp() {
+  Timestamp timestamp;
+  if (num_counters != 0) {
+    GroupReadFormat data;
+    const ssize_t size = read(fds[0], &data, sizeof(data));
+    if (size >= static_cast<ssize_t>(offsetof(GroupReadFormat, values)) &&
+        data.nr == num_counters) {
+      timestamp.time_enabled = data.time_enabled;
+      timestamp.time_running = data.time_running;
+      for (size_t i = 0; i < num_counters; ++i) {
+        timestamp.counts[i] = data.values[i];
+      }
+    }
+  }
+  timestamp.time = chrono::SystemClock::now();
+  return timestamp;
+}
+
+size_t GetNumCounters() { return num_counters; }
+
+const char* GetCounterName(size_t index) {
+  return index < num_counters ? names[index] : "";
+}
+
+int64_t GetCounterDelta(size_t index, Timestamp begin, Timestamp end) {
+  if (index >= num_counters) {
+    return 0;
+  }
+  const uint64_t delta = end.counts[index] - begin.counts[index];
+  const uint64_t enabled = end.time_enabled - begin.time_enabled;
+  const uint64_t running = end.time_running - begin.time_running;
+  if (running == 0) {
+    return 0;  // The counters were never scheduled.
+  }
+  if (running < enabled) {
+    // The kernel multiplexed the counters, so extrapolate.
+    return static_cast<int64_t>(static_cast<double>(delta) *
+                                static_cast<double>(enabled) /
+                                static_cast<double>(running));
+  }
+  return static_cast<int64_t>(delta);
+}
+
+}  // namespace pw::perf_test::internal::backend
@@ -0,0 +1,79 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <chrono>
+#include <cstring>
+
+#include "pw_chrono/system_clock.h"
+#include "pw_perf_test/internal/perf_event_timer_interface.h"
+#include "pw_thread/sleep.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::perf_test::internal::backend {
+namespace {
+
+constexpr chrono::SystemClock::duration kArbitraryDuration =
+    chrono::SystemClock::for_at_least(std::chrono::milliseconds(1));
+
+volatile int sink = 0;
+
+class PerfEventTimerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(TimerPrepare()); }
+  void TearDown() override { TimerCleanup(); }
+};
+
+TEST_F(PerfEventTimerTest, DurationIsReasonable) {
+  Timestamp start = GetCurrentTimestamp();
+  this_thread::sleep_for(kArbitraryDuration);
+  Timestamp end = GetCurrentTimestamp();
+  int64_t duration = GetDuration(start, end);
+  EXPECT_GE(duration, 1000000);
+}
+
+TEST_F(PerfEventTimerTest, CountersAreNamed) {
+  ASSERT_LE(GetNumCounters(), kMaxCounters);
+  for (size_t i = 0; i < GetNumCounters(); ++i) {
+    EXPECT_NE(GetCounterName(i)[0], '\0');
+  }
+  EXPECT_STREQ(GetCounterName(kMaxCounters), "");
+}
+
+TEST_F(PerfEventTimerTest, CountersIncreaseWithWork) {
+  // Perf events may be unavailable, e.g. in containers. In that case, no
+  // counters are reported, and there is nothing else to check.
+  Timestamp start = GetCurrentTimestamp();
+  for (int i = 0; i < 100000; ++i) {
+    sink = i;
+  }
+  Timestamp end = GetCurrentTimestamp();
+  for (size_t i = 0; i < GetNumCounters(); ++i) {
+    EXPECT_GE(GetCounterDelta(i, start, end), 0);
+    if (std::strcmp(GetCounterName(i), "instructions") == 0) {
+      EXPECT_GE(GetCounterDelta(i, start, end), 100000);
+    }
+  }
+}
+
+TEST_F(PerfEventTimerTest, Cleanup_RemovesCounters) {
+  TimerCleanup();
+  EXPECT_EQ(GetNumCounters(), 0u);
+  Timestamp start = GetCurrentTimestamp();
+  Timestamp end = GetCurrentTimestamp();
+  EXPECT_EQ(GetCounterDelta(0, start, end), 0);
+  EXPECT_GE(GetDuration(start, end), 0);
+}
+
+}  // namespace
+}  // namespace pw::perf_test::internal::backend
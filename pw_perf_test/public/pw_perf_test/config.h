@@ -0,0 +1,43 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+/// @module{pw_perf_test}
+
+/// Number of samples collected for each performance test.
+///
+/// Each sample measures one or more iterations of the test loop, and reports
+/// the average duration of those iterations. Samples are stored in the test's
+/// `State` in order to calculate percentiles, so this also sets the size of
+/// that object.
+#ifndef PW_PERF_TEST_SAMPLES
+#define PW_PERF_TEST_SAMPLES 100
+#endif  // PW_PERF_TEST_SAMPLES
+
+/// Minimum duration of a single sample, in the timer's units.
+///
+/// Before collecting samples, each test is calibrated by running increasing
+/// numbers of iterations per sample until a sample takes at least this long.
+/// This keeps the timer's resolution and overhead from dominating the results
+/// of very fast tests.
+///
+/// Set to 0 to measure exactly one iteration per sample.
+#ifndef PW_PERF_TEST_MIN_SAMPLE_DURATION
+#define PW_PERF_TEST_MIN_SAMPLE_DURATION 10000
+#endif  // PW_PERF_TEST_MIN_SAMPLE_DURATION
+
+/// Maximum number of iterations measured in a single sample.
+#ifndef PW_PERF_TEST_MAX_ITERATIONS_PER_SAMPLE
+#define PW_PERF_TEST_MAX_ITERATIONS_PER_SAMPLE 1000000
+#endif  // PW_PERF_TEST_MAX_ITERATIONS_PER_SAMPLE
@@ -15,6 +15,8 @@
 
 #include <cstdint>
 
+#include "pw_span/span.h"
+
 /// Micro-benchmarks library
 namespace pw::perf_test {
 
@@ -24,11 +26,49 @@ struct TestIteration {
   float result = 0;
 };
 
+/// Average count of a hardware event per iteration, such as CPU cycles or
+/// cache misses. These are only reported by timer backends that support them.
+struct TestCounter {
+  const char* name = nullptr;
+  float per_iteration = 0;
+};
+
 /// Data reported for each `Measurement` upon completion of a performance test.
+///
+/// Durations are per iteration of the test loop, in the timer's units. Each
+/// sample is the average duration of an iteration in a batch of
+/// `iterations_per_sample` iterations, and the statistics below are computed
+/// over these averages.
 struct TestMeasurement {
   int64_t mean = 0;
   int64_t max = 0;
   int64_t min = 0;
+
+  /// Percentiles of the samples. Unless `iterations_per_sample` is 1, these
+  /// are percentiles of batch averages rather than of individual iterations,
+  /// so they understate the tail latency of single iterations.
+  int64_t sample_p50 = 0;
+  int64_t sample_p90 = 0;
+  int64_t sample_p99 = 0;
+
+  /// Standard deviation of the per-iteration durations of the samples.
+  int64_t stddev = 0;
+
+  /// Number of samples that were collected.
+  uint32_t samples = 0;
+
+  /// Number of iterations of the test loop measured by each sample.
+  uint32_t iterations_per_sample = 0;
+
+  /// Throughput, if the test called `State::SetBytesPerIteration` or
+  /// `State::SetItemsPerIteration`. These are only calculated when the timer
+  /// measures nanoseconds, and are 0 otherwise.
+  int64_t bytes_per_second = 0;
+  int64_t items_per_second = 0;
+
+  /// Hardware event counts, if supported by the timer backend. This is only
+  /// valid for the duration of the `EventHandler::TestCaseEnd` call.
+  span<const TestCounter> counters;
 };
 
 /// Stores information on the upcoming collection of tests.
@@ -36,12 +76,20 @@ struct TestMeasurement {
 /// In order to match gtest, these integer types are not sized
 struct TestRunInfo {
   int total_tests = 0;
+
+  /// Number of samples collected for each test.
   int default_iterations = 0;
 };
 
 /// Describes the performance test being run.
 struct TestCase {
   const char* name = nullptr;
+
+  /// Argument passed to a test defined by `PW_PERF_TEST_RANGE`. Each argument
+  /// is reported as a separate test case, and should be displayed along with
+  /// the name, e.g. "name/argument".
+  int64_t argument = 0;
+  bool has_argument = false;
 };
 
 /// Collects and reports test results.
@@ -61,7 +109,9 @@ class EventHandler {
   /// A performance test case is starting.
   virtual void TestCaseStart(const TestCase& test_case) = 0;
 
-  /// A performance test case has completed an iteration.
+  /// A performance test case has completed a sample.
+  ///
+  /// The result is the average duration of the iterations in the sample.
   virtual void TestCaseIteration(const TestIteration& test_iteration) = 0;
 
   /// A performance test case has ended.
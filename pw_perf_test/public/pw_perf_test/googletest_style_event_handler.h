@@ -21,7 +21,18 @@
   "[==========] Done running all tests."
 
 #define PW_PERF_TEST_GOOGLETEST_CASE_START "[ RUN      ] %s"
+#define PW_PERF_TEST_GOOGLETEST_CASE_START_WITH_ARGUMENT "[ RUN      ] %s/%ld"
 #define PW_PERF_TEST_GOOGLETEST_CASE_ITERATION "[ Iteration ] #%u: %lu %s"
 #define PW_PERF_TEST_GOOGLETEST_CASE_MEASUREMENT \
   "[  RESULT  ] MEAN: %ld %s, MIN: %ld %s, MAX: %ld %s"
+#define PW_PERF_TEST_GOOGLETEST_CASE_PERCENTILES                              \
+  "[  RESULT  ] SAMPLE P50: %ld %s, SAMPLE P90: %ld %s, SAMPLE P99: %ld %s, " \
+  "STDDEV: %ld %s"
+#define PW_PERF_TEST_GOOGLETEST_CASE_SAMPLES \
+  "[  RESULT  ] %u sample(s) of %u iteration(s) each"
+#define PW_PERF_TEST_GOOGLETEST_CASE_BYTES_PER_SECOND "[  RESULT  ] %ld bytes/s"
+#define PW_PERF_TEST_GOOGLETEST_CASE_ITEMS_PER_SECOND "[  RESULT  ] %ld items/s"
+#define PW_PERF_TEST_GOOGLETEST_CASE_COUNTER \
+  "[  RESULT  ] %s: %ld.%02ld per iteration"
 #define PW_PERF_TEST_GOOGLETEST_CASE_END "[     DONE ] %s"
+#define PW_PERF_TEST_GOOGLETEST_CASE_END_WITH_ARGUMENT "[     DONE ] %s/%ld"
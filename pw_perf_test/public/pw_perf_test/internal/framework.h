@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include "pw_perf_test/config.h"
 #include "pw_perf_test/event_handler.h"
 
 namespace pw::perf_test::internal {
@@ -41,7 +42,9 @@ class Framework {
   int RunAllTests();
 
  private:
-  static constexpr int kDefaultIterations = 100;
+  static constexpr int kDefaultIterations = PW_PERF_TEST_SAMPLES;
+
+  void RunTest(const TestInfo& test, const TestCase& test_case);
 
   EventHandler* event_handler_;
 
@@ -0,0 +1,75 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// This timing interface measures wall-clock time and, when available, counts
+// hardware events using the Linux perf_event_open system call. The
+// documentation can be found here:
+// https://man7.org/linux/man-pages/man2/perf_event_open.2.html
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_chrono/system_clock.h"
+#include "pw_perf_test/internal/duration_unit.h"
+
+namespace pw::perf_test::internal::backend {
+
+// Cycles, instructions, cache misses, and branch misses.
+inline constexpr size_t kMaxCounters = 4;
+
+struct Timestamp {
+  chrono::SystemClock::time_point time;
+
+  // How long the counters were enabled and actually counting. These differ if
+  // the kernel multiplexed the counters with other users of the PMU.
+  uint64_t time_enabled = 0;
+  uint64_t time_running = 0;
+
+  std::array<uint64_t, kMaxCounters> counts{};
+};
+
+inline constexpr DurationUnit kDurationUnit = DurationUnit::kNanoseconds;
+
+// Opens the hardware counters. If perf events are unavailable, e.g. in a
+// container or due to `perf_event_paranoid`, this still succeeds and only
+// wall-clock time is measured.
+[[nodiscard]] bool TimerPrepare();
+
+// Closes the hardware counters.
+void TimerCleanup();
+
+// Reads the hardware counters, if any, and then the system clock.
+Timestamp GetCurrentTimestamp();
+
+inline int64_t GetDuration(Timestamp begin, Timestamp end) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(end.time -
+                                                              begin.time)
+      .count();
+}
+
+// Returns the number of hardware counters that were successfully opened.
+size_t GetNumCounters();
+
+// Returns the name of an opened counter.
+const char* GetCounterName(size_t index);
+
+// Returns the change in an opened counter, scaled up if the counters were only
+// running for part of the time between the timestamps.
+int64_t GetCounterDelta(size_t index, Timestamp begin, Timestamp end);
+
+}  // namespace pw::perf_test::internal::backend
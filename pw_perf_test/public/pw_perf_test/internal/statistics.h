@@ -0,0 +1,38 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+#include "pw_perf_test/event_handler.h"
+#include "pw_span/span.h"
+
+namespace pw::perf_test::internal {
+
+/// Sorts the given per-iteration durations and summarizes them in the
+/// duration fields of `measurement`.
+///
+/// Percentiles use the nearest-rank method, so each reported percentile is one
+/// of the measured samples.
+void CalculateStatistics(span<int64_t> samples, TestMeasurement& measurement);
+
+/// Returns the value at the given percentile of the sorted `samples`, using
+/// the nearest-rank method.
+int64_t Percentile(span<const int64_t> sorted_samples, uint32_t percentile);
+
+/// Returns the rate per second of `count` events that took `nanoseconds`, or 0
+/// if the duration is not positive.
+int64_t PerSecond(uint64_t count, int64_t nanoseconds);
+
+}  // namespace pw::perf_test::internal
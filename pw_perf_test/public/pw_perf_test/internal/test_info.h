@@ -13,10 +13,35 @@
 // the License.
 #pragma once
 
+#include <cstdint>
+
 #include "pw_perf_test/state.h"
 
 namespace pw::perf_test::internal {
 
+/// Arguments passed to a test defined by `PW_PERF_TEST_RANGE`.
+///
+/// The test is run with `first`, then repeatedly multiplied by `multiplier`
+/// while less than `last`, and finally with `last`.
+struct ArgumentRange {
+  int64_t first = 0;
+  int64_t last = 0;
+  int64_t multiplier = 2;
+
+  // Returns the argument after `argument`. Always makes progress, even if the
+  // argument is not positive.
+  constexpr int64_t Next(int64_t argument) const {
+    int64_t next = argument * multiplier;
+    if (next <= argument) {
+      next = argument + 1;
+    }
+    return next < last ? next : last;
+  }
+
+  // Returns the number of arguments in the range.
+  int count() const;
+};
+
 /// Represents a single test case.
 ///
 /// Each instance includes a pointer to a function which constructs and runs the
@@ -28,6 +53,10 @@ class TestInfo {
  public:
   TestInfo(const char* test_name, void (*function_body)(State&));
 
+  TestInfo(const char* test_name,
+           void (*function_body)(State&),
+           const ArgumentRange& arguments);
+
   // Returns the next registered test
   TestInfo* next() const { return next_; }
 
@@ -37,6 +66,11 @@ class TestInfo {
 
   const char* test_name() const { return test_name_; }
 
+  // Returns the range of arguments, or null if the test takes no argument.
+  const ArgumentRange* arguments() const {
+    return has_arguments_ ? &arguments_ : nullptr;
+  }
+
  private:
   // Function pointer to the code that will be measured
   void (*run_)(State&);
@@ -45,6 +79,9 @@ class TestInfo {
   TestInfo* next_ = nullptr;
 
   const char* test_name_;
+
+  ArgumentRange arguments_;
+  bool has_arguments_ = false;
 };
 
 }  // namespace pw::perf_test::internal
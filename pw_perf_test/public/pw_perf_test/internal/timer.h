@@ -13,9 +13,19 @@
 // the License.
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 #include "pw_perf_test/internal/duration_unit.h"
 #include "pw_perf_test_timer_backend/timer.h"
 
+// Backends that count hardware events in addition to measuring durations set
+// this to 1 and provide `kMaxCounters`, `GetNumCounters`, `GetCounterName`, and
+// `GetCounterDelta`.
+#ifndef PW_PERF_TEST_TIMER_BACKEND_HAS_COUNTERS
+#define PW_PERF_TEST_TIMER_BACKEND_HAS_COUNTERS 0
+#endif  // PW_PERF_TEST_TIMER_BACKEND_HAS_COUNTERS
+
 namespace pw::perf_test::internal {
 
 using Timestamp = backend::Timestamp;  // implementation-defined type
@@ -40,6 +50,37 @@ inline int64_t GetDuration(Timestamp begin, Timestamp end) {
   return backend::GetDuration(begin, end);
 }
 
+#if PW_PERF_TEST_TIMER_BACKEND_HAS_COUNTERS
+
+// Maximum number of hardware event counters reported by the backend.
+inline constexpr size_t kMaxCounters = backend::kMaxCounters;
+
+// Returns the number of counters that are available. This may be less than
+// `kMaxCounters`, e.g. if the OS does not allow access to some of them.
+inline size_t GetNumCounters() { return backend::GetNumCounters(); }
+
+// Returns the name of a counter, e.g. "instructions".
+inline const char* GetCounterName(size_t index) {
+  return backend::GetCounterName(index);
+}
+
+// Returns how much a counter changed between two timestamps.
+inline int64_t GetCounterDelta(size_t index, Timestamp begin, Timestamp end) {
+  return backend::GetCounterDelta(index, begin, end);
+}
+
+#else
+
+inline constexpr size_t kMaxCounters = 0;
+
+inline size_t GetNumCounters() { return 0; }
+
+inline const char* GetCounterName(size_t) { return ""; }
+
+inline int64_t GetCounterDelta(size_t, Timestamp, Timestamp) { return 0; }
+
+#endif  // PW_PERF_TEST_TIMER_BACKEND_HAS_COUNTERS
+
 constexpr const char* GetDurationUnitStr() {
   switch (kDurationUnit) {
     case DurationUnit::kNanoseconds:
@@ -0,0 +1,48 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_perf_test/event_handler.h"
+#include "pw_stream/stream.h"
+
+namespace pw::perf_test {
+
+/// Event handler that writes the results of each test case as a JSON object on
+/// its own line, i.e. in the JSON Lines format.
+///
+/// Each object includes the test name, the argument of parameterized tests, the
+/// duration unit, and every field of `TestMeasurement`. This output is meant to
+/// be saved and compared across builds, e.g. with
+/// `python -m pw_perf_test.compare`.
+class JsonEventHandler : public EventHandler {
+ public:
+  /// Maximum size of the JSON object written for a single test case.
+  static constexpr size_t kMaxObjectSize = 512;
+
+  explicit JsonEventHandler(stream::Writer& writer) : writer_(writer) {}
+
+  void RunAllTestsStart(const TestRunInfo& summary) override;
+  void RunAllTestsEnd() override;
+  void TestCaseStart(const TestCase& info) override;
+  void TestCaseIteration(const TestIteration& iteration) override;
+  void TestCaseEnd(const TestCase& info,
+                   const TestMeasurement& measurement) override;
+
+ private:
+  stream::Writer& writer_;
+};
+
+}  // namespace pw::perf_test
@@ -13,6 +13,8 @@
 // the License.
 #pragma once
 
+#include <cstddef>
+
 #include "pw_perf_test/event_handler.h"
 
 namespace pw::perf_test {
@@ -29,6 +31,8 @@ class LogCsvEventHandler : public EventHandler {
                    const TestMeasurement& measurement) override;
 
  private:
+  static constexpr size_t kMaxNameSize = 64;
+
   int iterations_;
 };
 
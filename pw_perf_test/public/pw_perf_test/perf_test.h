@@ -41,6 +41,36 @@
             function(pw_perf_test_state PW_COMMA_ARGS(__VA_ARGS__))); \
       })
 
+/// Defines a performance test that is run once for each of a range of
+/// arguments.
+///
+/// The test is run with `first`, then with each successive argument multiplied
+/// by `multiplier` while less than `last`, and finally with `last`. The test
+/// function can get the current argument from `State::argument()`. Each
+/// argument is reported as a separate test case named "name/argument".
+///
+/// Example:
+/// @code{.cpp}
+///   void TestFunction(::pw::perf_test::State& state) {
+///     std::array<std::byte, 4096> buffer;
+///     auto size = static_cast<size_t>(state.argument());
+///     state.SetBytesPerIteration(size);
+///     while (state.KeepRunning()) {
+///       Checksum(pw::span(buffer).first(size));
+///     }
+///   }
+///   // Runs with 16, 128, 1024, and 4096 bytes.
+///   PW_PERF_TEST_RANGE(ChecksumSize, TestFunction, 16, 4096, 8);
+/// @endcode
+#define PW_PERF_TEST_RANGE(name, function, first, last, multiplier, ...) \
+  const ::pw::perf_test::internal::TestInfo PwPerfTest_##name(          \
+      #name,                                                             \
+      [](::pw::perf_test::State& pw_perf_test_state) {                   \
+        static_cast<void>(                                               \
+            function(pw_perf_test_state PW_COMMA_ARGS(__VA_ARGS__)));    \
+      },                                                                 \
+      ::pw::perf_test::internal::ArgumentRange{first, last, multiplier})
+
 /// Defines a simple performance test.
 ///
 /// This macro is similar to `PW_PERF_TEST`, except that the provided function
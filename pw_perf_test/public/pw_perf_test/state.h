@@ -13,10 +13,12 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <limits>
 
 #include "pw_assert/assert.h"
+#include "pw_perf_test/config.h"
 #include "pw_perf_test/event_handler.h"
 #include "pw_perf_test/internal/timer.h"
 
@@ -32,62 +34,127 @@ State CreateState(int durations,
                   EventHandler& event_handler,
                   const char* test_name);
 
+// Creates a state that calibrates the number of iterations in each sample so
+// that a sample takes at least `min_sample_duration`.
+State CreateState(int samples,
+                  int64_t min_sample_duration,
+                  EventHandler& event_handler,
+                  const TestCase& test_case);
+
 }  // namespace internal
 
 /// Records the performance of a test case over many iterations.
+///
+/// The test loop is first run once to warm up, and then in increasingly large
+/// batches until a batch takes at least `PW_PERF_TEST_MIN_SAMPLE_DURATION`.
+/// Each sample then measures a batch of that many iterations, and the average
+/// duration of an iteration in each sample is used to calculate the reported
+/// statistics.
 class State {
  public:
+  /// Maximum number of samples that can be collected for a test.
+  static constexpr int kMaxSamples = PW_PERF_TEST_SAMPLES;
+
   // KeepRunning() should be called in a while loop. Responsible for managing
   // iterations and timestamps.
   bool KeepRunning() {
-    internal::Timestamp iteration_end = internal::GetCurrentTimestamp();
-    const bool keep_running = KeepRunningInternal(iteration_end);
-    iteration_start_ = internal::GetCurrentTimestamp();
+    // Only read the timer at the end of each batch of iterations.
+    if (--iterations_left_ > 0) {
+      return true;
+    }
+    internal::Timestamp batch_end = internal::GetCurrentTimestamp();
+    const bool keep_running = KeepRunningInternal(batch_end);
+    batch_start_ = internal::GetCurrentTimestamp();
     return keep_running;
   }
 
+  /// Returns the argument of a test defined by `PW_PERF_TEST_RANGE`.
+  int64_t argument() const { return test_info.argument; }
+
+  /// Sets the number of bytes processed by each iteration of the test loop.
+  /// If set, the measurement includes the throughput in bytes per second.
+  void SetBytesPerIteration(size_t bytes) { bytes_per_iteration_ = bytes; }
+
+  /// Sets the number of items processed by each iteration of the test loop.
+  /// If set, the measurement includes the throughput in items per second.
+  void SetItemsPerIteration(size_t items) { items_per_iteration_ = items; }
+
  private:
   // Allows the framework to create state objects and unit tests for the state
   // class
   friend State internal::CreateState(int durations,
                                      EventHandler& event_handler,
                                      const char* test_name);
+  friend State internal::CreateState(int samples,
+                                     int64_t min_sample_duration,
+                                     EventHandler& event_handler,
+                                     const TestCase& test_case);
+
+  enum class Phase {
+    kStarting,
+    kWarmingUp,
+    kCalibrating,
+    kSampling,
+    kDone,
+  };
 
-  bool KeepRunningInternal(internal::Timestamp iteration_end);
+  bool KeepRunningInternal(internal::Timestamp batch_end);
+
+  // Returns the size of the next calibration batch.
+  int64_t NextBatchSize(int64_t duration) const;
+
+  void RecordSample(int64_t duration, internal::Timestamp batch_end);
+
+  void Finish();
 
   // Privated constructor to prevent unauthorized instances of the state class.
-  constexpr State(int iterations,
+  constexpr State(int samples,
+                  int64_t min_sample_duration,
                   EventHandler& event_handler,
-                  const char* test_name)
-      : test_iterations_(iterations),
-        iteration_start_(),
+                  const TestCase& test_case)
+      : test_samples_(samples),
+        min_sample_duration_(min_sample_duration),
+        batch_start_(),
         event_handler_(&event_handler),
-        test_info{.name = test_name} {
-    PW_ASSERT(test_iterations_ > 0);
+        test_info(test_case) {
+    PW_ASSERT(test_samples_ > 0);
+    PW_ASSERT(test_samples_ <= kMaxSamples);
   }
 
-  int64_t mean_ = -1;
+  // Stores the total number of samples wanted
+  const int test_samples_;
+
+  // Calibrate until a batch takes at least this long.
+  const int64_t min_sample_duration_;
 
-  // Stores the total number of iterations wanted
-  const int test_iterations_;
+  // Per-iteration duration of each sample.
+  std::array<int64_t, kMaxSamples> samples_{};
 
-  // Stores the total duration of the tests.
+  // Number of samples recorded so far.
+  int num_samples_ = 0;
+
+  // Stores the total duration of the sampled batches.
   int64_t total_duration_ = 0;
 
-  // Smallest value of the iterations
-  int64_t min_ = std::numeric_limits<int64_t>::max();
+  // Stores the total change in each hardware counter over the sampled batches.
+  std::array<int64_t, internal::kMaxCounters> counter_totals_{};
+
+  // Iterations left in the current batch, including the current one.
+  int64_t iterations_left_ = 0;
 
-  // Largest value of the iterations
-  int64_t max_ = std::numeric_limits<int64_t>::min();
+  // Number of iterations in each calibration batch or sample.
+  int64_t batch_size_ = 1;
 
-  // Time at the start of the iteration
-  internal::Timestamp iteration_start_;
+  // Time at the start of the batch
+  internal::Timestamp batch_start_;
 
   // Run the loop this many times before recording data.
   static constexpr int kWarmUpIterations = 1;
 
-  // The current iteration.
-  int current_iteration_ = -(kWarmUpIterations + 1);
+  Phase phase_ = Phase::kStarting;
+
+  size_t bytes_per_iteration_ = 0;
+  size_t items_per_iteration_ = 0;
 
   EventHandler* event_handler_;
 
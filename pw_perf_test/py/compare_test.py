@@ -0,0 +1,135 @@
+# Copyright 2025 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Tests comparing performance test results."""
+
+import io
+import math
+import unittest
+
+from pw_perf_test import compare
+
+
+def _result(name: str, mean: float, stddev: float, samples: int = 100):
+    return compare.Result(
+        name=name, unit='ns', samples=samples, mean=mean, stddev=stddev
+    )
+
+
+class TestParseResults(unittest.TestCase):
+    """Tests parsing JSON Lines output."""
+
+    def test_parse_with_prefixes_and_noise(self):
+        lines = [
+            'INF  [==========] Running all tests.\n',
+            '{"name": "Foo", "unit": "ns", "samples": 10, "mean": 5, '
+            '"stddev": 1, "sample_p50": 5, "sample_p90": 6, '
+            '"sample_p99": 7}\n',
+            '12:00:00 {"name": "Bar", "argument": 8, "unit": "ns", '
+            '"samples": 10, "mean": 9, "stddev": 2}\n',
+            '{"not": "a result"}\n',
+            '{truncated\n',
+        ]
+        results = compare.parse_results(lines)
+        self.assertEqual(set(results), {'Foo', 'Bar/8'})
+        self.assertEqual(results['Foo'].sample_p99, 7)
+        self.assertEqual(results['Bar/8'].mean, 9.0)
+
+
+class TestStatistics(unittest.TestCase):
+    """Tests the t-test implementation."""
+
+    def test_student_t_p_values(self):
+        # Reference values from standard t-distribution tables.
+        self.assertAlmostEqual(
+            compare.student_t_two_sided_p(2.228, 10), 0.05, places=3
+        )
+        self.assertAlmostEqual(
+            compare.student_t_two_sided_p(2.576, 1e6), 0.01, places=3
+        )
+        self.assertAlmostEqual(compare.student_t_two_sided_p(0, 5), 1.0)
+        self.assertEqual(compare.student_t_two_sided_p(math.inf, 5), 0.0)
+
+    def test_welch_identical(self):
+        base = _result('a', 100, 10)
+        self.assertAlmostEqual(compare.welch_t_test(base, base), 1.0)
+
+    def test_welch_no_variance(self):
+        self.assertAlmostEqual(
+            compare.welch_t_test(_result('a', 100, 0), _result('a', 100, 0)),
+            1.0,
+        )
+        self.assertLess(
+            compare.welch_t_test(_result('a', 100, 0), _result('a', 200, 0)),
+            0.01,
+        )
+
+    def test_welch_stddev_rounded_to_zero_is_not_exact(self):
+        # A stddev of 0 may be up to half a unit, which does not make a one
+        # unit difference between two samples significant.
+        p_value = compare.welch_t_test(
+            _result('a', 100, 0, samples=2), _result('a', 101, 0, samples=2)
+        )
+        self.assertGreater(p_value, 0.05)
+
+
+class TestCompare(unittest.TestCase):
+    """Tests flagging regressions."""
+
+    def test_significant_regression(self):
+        [comparison] = compare.compare(
+            {'a': _result('a', 100, 5)}, {'a': _result('a', 120, 5)}
+        )
+        self.assertAlmostEqual(comparison.change, 0.2)
+        self.assertTrue(comparison.is_regression(threshold=0.05, alpha=0.01))
+
+    def test_noisy_change_is_not_regression(self):
+        [comparison] = compare.compare(
+            {'a': _result('a', 100, 200, samples=10)},
+            {'a': _result('a', 120, 200, samples=10)},
+        )
+        self.assertFalse(comparison.is_regression(threshold=0.05, alpha=0.01))
+
+    def test_small_change_is_not_regression(self):
+        [comparison] = compare.compare(
+            {'a': _result('a', 100, 1)}, {'a': _result('a', 102, 1)}
+        )
+        self.assertTrue(comparison.is_significant(alpha=0.01))
+        self.assertFalse(comparison.is_regression(threshold=0.05, alpha=0.01))
+
+    def test_improvement(self):
+        [comparison] = compare.compare(
+            {'a': _result('a', 100, 5)}, {'a': _result('a', 80, 5)}
+        )
+        self.assertTrue(comparison.is_improvement(threshold=0.05, alpha=0.01))
+
+    def test_unmatched_tests_are_skipped(self):
+        self.assertEqual(
+            compare.compare(
+                {'a': _result('a', 1, 1)}, {'b': _result('b', 1, 1)}
+            ),
+            [],
+        )
+
+    def test_report_counts_regressions(self):
+        comparisons = compare.compare(
+            {'a': _result('a', 100, 5), 'b': _result('b', 100, 5)},
+            {'a': _result('a', 150, 5), 'b': _result('b', 100, 5)},
+        )
+        output = io.StringIO()
+        self.assertEqual(compare.report(comparisons, 0.05, 0.01, output), 1)
+        self.assertIn('REGRESSION', output.getvalue())
+
+
+if __name__ == '__main__':
+    unittest.main()
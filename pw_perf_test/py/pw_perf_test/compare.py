@@ -0,0 +1,275 @@
+# Copyright 2025 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Compares pw_perf_test results against a baseline.
+
+Reads the JSON Lines output of `pw::perf_test::JsonEventHandler` for a baseline
+and a current build, and reports each test case whose mean duration changed.
+A change is flagged as a regression only if it is larger than a threshold AND
+Welch's t-test finds it statistically significant, so noisy test cases do not
+cause spurious failures.
+
+Example:
+
+    python -m pw_perf_test.compare baseline.jsonl current.jsonl
+"""
+
+import argparse
+import dataclasses
+import json
+import math
+import sys
+
+from pathlib import Path
+from typing import Iterable, TextIO
+
+
+@dataclasses.dataclass(frozen=True)
+class Result:
+    """Summary statistics of a single performance test case."""
+
+    name: str
+    unit: str
+    samples: int
+    mean: float
+    stddev: float
+    sample_p50: int = 0
+    sample_p90: int = 0
+    sample_p99: int = 0
+
+    @classmethod
+    def from_json(cls, obj: dict) -> 'Result':
+        name = obj['name']
+        if 'argument' in obj:
+            name = f'{name}/{obj["argument"]}'
+        return cls(
+            name=name,
+            unit=obj['unit'],
+            samples=int(obj['samples']),
+            mean=float(obj['mean']),
+            stddev=float(obj['stddev']),
+            sample_p50=int(obj.get('sample_p50', 0)),
+            sample_p90=int(obj.get('sample_p90', 0)),
+            sample_p99=int(obj.get('sample_p99', 0)),
+        )
+
+
+@dataclasses.dataclass(frozen=True)
+class Comparison:
+    """The change in a test case between a baseline and current result."""
+
+    baseline: Result
+    current: Result
+    p_value: float
+
+    @property
+    def name(self) -> str:
+        return self.current.name
+
+    @property
+    def change(self) -> float:
+        """Relative change of the mean, e.g. 0.1 if 10% slower."""
+        if self.baseline.mean == 0:
+            return 0.0 if self.current.mean == 0 else math.inf
+        return (self.current.mean - self.baseline.mean) / self.baseline.mean
+
+    def is_significant(self, alpha: float) -> bool:
+        return self.p_value < alpha
+
+    def is_regression(self, threshold: float, alpha: float) -> bool:
+        return self.change > threshold and self.is_significant(alpha)
+
+    def is_improvement(self, threshold: float, alpha: float) -> bool:
+        return self.change < -threshold and self.is_significant(alpha)
+
+
+def parse_results(lines: Iterable[str]) -> dict[str, Result]:
+    """Parses results from JSON Lines, ignoring any other output.
+
+    Lines may have a prefix, such as a log timestamp, before the JSON object.
+    """
+    results: dict[str, Result] = {}
+    for line in lines:
+        start = line.find('{')
+        if start < 0:
+            continue
+        try:
+            obj = json.loads(line[start:])
+            result = Result.from_json(obj)
+        except (ValueError, KeyError, TypeError):
+            continue
+        results[result.name] = result
+    return results
+
+
+def load_results(path: Path) -> dict[str, Result]:
+    with path.open() as file:
+        return parse_results(file)
+
+
+def _continued_fraction(a: float, b: float, x: float) -> float:
+    """Evaluates the continued fraction of the incomplete beta function."""
+    tiny = 1e-300
+    qab = a + b
+    qap = a + 1.0
+    qam = a - 1.0
+    c = 1.0
+    d = 1.0 - qab * x / qap
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    h = d
+    for m in range(1, 300):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + aa / (c if abs(c) > tiny else tiny)
+        h *= d * c
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + aa / (c if abs(c) > tiny else tiny)
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-12:
+            break
+    return h
+
+
+def _regularized_incomplete_beta(a: float, b: float, x: float) -> float:
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    log_front = (
+        math.lgamma(a + b)
+        - math.lgamma(a)
+        - math.lgamma(b)
+        + a * math.log(x)
+        + b * math.log1p(-x)
+    )
+    front = math.exp(log_front)
+    # The continued fraction converges quickly only on one side of the mean.
+    if x < (a + 1.0) / (a + b + 2.0):
+        return front * _continued_fraction(a, b, x) / a
+    return 1.0 - front * _continued_fraction(b, a, 1.0 - x) / b
+
+
+def student_t_two_sided_p(t: float, df: float) -> float:
+    """Returns the two-sided p-value of Student's t-distribution."""
+    if math.isinf(t):
+        return 0.0
+    return _regularized_incomplete_beta(df / 2.0, 0.5, df / (df + t * t))
+
+
+# Results are reported in whole timer units, so a standard deviation of 0 only
+# means it was less than half a unit.
+_MIN_STDDEV = 0.5
+
+
+def welch_t_test(baseline: Result, current: Result) -> float:
+    """Returns the p-value of Welch's t-test for a difference in means."""
+    if baseline.samples < 2 or current.samples < 2:
+        return 1.0
+    # Without a lower bound, a standard deviation that rounded to 0 would make
+    # any difference in means appear infinitely significant.
+    var_base = max(baseline.stddev, _MIN_STDDEV) ** 2 / baseline.samples
+    var_current = max(current.stddev, _MIN_STDDEV) ** 2 / current.samples
+    standard_error = math.sqrt(var_base + var_current)
+    t = (current.mean - baseline.mean) / standard_error
+    # Welch-Satterthwaite approximation of the degrees of freedom.
+    df = (var_base + var_current) ** 2 / (
+        var_base**2 / (baseline.samples - 1)
+        + var_current**2 / (current.samples - 1)
+    )
+    return student_t_two_sided_p(t, df)
+
+
+def compare(
+    baseline: dict[str, Result], current: dict[str, Result]
+) -> list[Comparison]:
+    """Compares test cases present in both sets of results."""
+    comparisons = []
+    for name, result in current.items():
+        base = baseline.get(name)
+        if base is None or base.unit != result.unit:
+            continue
+        comparisons.append(Comparison(base, result, welch_t_test(base, result)))
+    return comparisons
+
+
+def report(
+    comparisons: list[Comparison],
+    threshold: float,
+    alpha: float,
+    output: TextIO,
+) -> int:
+    """Prints a comparison table and returns the number of regressions."""
+    regressions = 0
+    width = max((len(c.name) for c in comparisons), default=4)
+    output.write(
+        f'{"test":<{width}}  {"baseline":>12}  {"current":>12}  '
+        f'{"change":>8}  {"p-value":>8}\n'
+    )
+    for comparison in sorted(comparisons, key=lambda c: c.name):
+        if comparison.is_regression(threshold, alpha):
+            verdict = 'REGRESSION'
+            regressions += 1
+        elif comparison.is_improvement(threshold, alpha):
+            verdict = 'improved'
+        else:
+            verdict = ''
+        line = (
+            f'{comparison.name:<{width}}  '
+            f'{comparison.baseline.mean:>9.0f} {comparison.baseline.unit:<2}  '
+            f'{comparison.current.mean:>9.0f} {comparison.current.unit:<2}  '
+            f'{comparison.change:>+8.1%}  '
+            f'{comparison.p_value:>8.4f}  {verdict}'
+        )
+        output.write(line.rstrip() + '\n')
+    return regressions
+
+
+def _parse_args() -> argparse.Namespace:
+    """Parse arguments."""
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('baseline', type=Path, help='Baseline JSON Lines file')
+    parser.add_argument('current', type=Path, help='Current JSON Lines file')
+    parser.add_argument(
+        '--threshold',
+        type=float,
+        default=0.05,
+        help='Minimum relative slowdown to report as a regression',
+    )
+    parser.add_argument(
+        '--alpha',
+        type=float,
+        default=0.01,
+        help='Significance level of the t-test',
+    )
+    return parser.parse_args()
+
+
+def main() -> int:
+    args = _parse_args()
+    comparisons = compare(
+        load_results(args.baseline), load_results(args.current)
+    )
+    regressions = report(comparisons, args.threshold, args.alpha, sys.stdout)
+    if regressions:
+        print(f'{regressions} significant regression(s) found.')
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
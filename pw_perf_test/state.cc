@@ -16,7 +16,10 @@
 
 #include "pw_perf_test/state.h"
 
+#include <algorithm>
+
 #include "pw_log/log.h"
+#include "pw_perf_test/internal/statistics.h"
 #include "pw_numeric/integer_division.h"
 
 namespace pw::perf_test {
@@ -25,57 +28,135 @@ namespace internal {
 State CreateState(int durations,
                   EventHandler& event_handler,
                   const char* test_name) {
-  return State(durations, event_handler, test_name);
+  return State(durations, 0, event_handler, TestCase{.name = test_name});
+}
+
+State CreateState(int samples,
+                  int64_t min_sample_duration,
+                  EventHandler& event_handler,
+                  const TestCase& test_case) {
+  return State(samples, min_sample_duration, event_handler, test_case);
 }
 
 }  // namespace internal
 
-bool State::KeepRunningInternal(internal::Timestamp iteration_end) {
-  current_iteration_ += 1;
-  if (current_iteration_ < 0) {
-    return true;  // Do nothing for warm up iterations.
+namespace {
+
+// Bounds on how quickly calibration batches grow. Growing by at least 2x keeps
+// the number of calibration batches logarithmic; growing by at most 10x keeps a
+// single noisy batch from overshooting by too much.
+constexpr int64_t kMinBatchGrowth = 2;
+constexpr int64_t kMaxBatchGrowth = 10;
+
+constexpr int64_t kMaxBatchSize = PW_PERF_TEST_MAX_ITERATIONS_PER_SAMPLE;
+
+}  // namespace
+
+bool State::KeepRunningInternal(internal::Timestamp batch_end) {
+  const int64_t duration = internal::GetDuration(batch_start_, batch_end);
+  switch (phase_) {
+    case Phase::kStarting:
+      phase_ = Phase::kWarmingUp;
+      iterations_left_ = kWarmUpIterations;
+      return true;
+
+    case Phase::kWarmingUp:
+      // Send the TestCaseStart event before the first measured iteration.
+      event_handler_->TestCaseStart(test_info);
+      phase_ =
+          min_sample_duration_ > 0 ? Phase::kCalibrating : Phase::kSampling;
+      iterations_left_ = batch_size_;
+      return true;
+
+    case Phase::kCalibrating:
+      if (duration < min_sample_duration_ && batch_size_ < kMaxBatchSize) {
+        batch_size_ = NextBatchSize(duration);
+      } else {
+        PW_LOG_DEBUG("Iterations per sample: %ld",
+                     static_cast<long>(batch_size_));
+        phase_ = Phase::kSampling;
+      }
+      iterations_left_ = batch_size_;
+      return true;
+
+    case Phase::kSampling:
+      RecordSample(duration, batch_end);
+      if (num_samples_ < test_samples_) {
+        iterations_left_ = batch_size_;
+        return true;
+      }
+      Finish();
+      phase_ = Phase::kDone;
+      return false;
+
+    case Phase::kDone:
+      break;
   }
+  return false;
+}
 
-  // Send the TestCaseStart event before the first iteration.
-  if (current_iteration_ == 0) {
-    event_handler_->TestCaseStart(test_info);
-    return true;
+int64_t State::NextBatchSize(int64_t duration) const {
+  // Aim slightly past the minimum so the next batch is likely to be the last.
+  int64_t growth = kMaxBatchGrowth;
+  if (duration > 0) {
+    growth = (min_sample_duration_ + min_sample_duration_ / 2) / duration;
   }
+  growth = std::clamp(growth, kMinBatchGrowth, kMaxBatchGrowth);
+  return std::min(batch_size_ * growth, kMaxBatchSize);
+}
 
-  int64_t duration = internal::GetDuration(iteration_start_, iteration_end);
-  if (duration > max_) {
-    max_ = duration;
+void State::RecordSample(int64_t duration, internal::Timestamp batch_end) {
+  total_duration_ += duration;
+  for (size_t i = 0; i < internal::GetNumCounters(); ++i) {
+    counter_totals_[i] +=
+        internal::GetCounterDelta(i, batch_start_, batch_end);
   }
-  if (duration < min_) {
-    min_ = duration;
+  const int64_t per_iteration =
+      IntegerDivisionRoundNearest(duration, batch_size_);
+  samples_[static_cast<size_t>(num_samples_)] = per_iteration;
+  num_samples_ += 1;
+  PW_LOG_DEBUG("Sample number: %d - Duration: %ld",
+               num_samples_,
+               static_cast<long>(per_iteration));
+  event_handler_->TestCaseIteration({static_cast<uint32_t>(num_samples_),
+                                     static_cast<float>(duration) /
+                                         static_cast<float>(batch_size_)});
+}
+
+void State::Finish() {
+  TestMeasurement test_measurement;
+  internal::CalculateStatistics(
+      span<int64_t>(samples_.data(), static_cast<size_t>(num_samples_)),
+      test_measurement);
+  test_measurement.iterations_per_sample = static_cast<uint32_t>(batch_size_);
+
+  const auto iterations =
+      static_cast<uint64_t>(batch_size_) * static_cast<uint64_t>(num_samples_);
+  if constexpr (internal::kDurationUnit ==
+                internal::DurationUnit::kNanoseconds) {
+    test_measurement.bytes_per_second = internal::PerSecond(
+        bytes_per_iteration_ * iterations, total_duration_);
+    test_measurement.items_per_second = internal::PerSecond(
+        items_per_iteration_ * iterations, total_duration_);
   }
-  total_duration_ += duration;
-  PW_LOG_DEBUG("Iteration number: %d - Duration: %ld",
-               current_iteration_,
-               static_cast<long>(duration));
-  event_handler_->TestCaseIteration({static_cast<uint32_t>(current_iteration_),
-                                     static_cast<float>(duration)});
-
-  if (current_iteration_ < test_iterations_) {
-    return true;
+
+  std::array<TestCounter, internal::kMaxCounters> counters;
+  const size_t num_counters = internal::GetNumCounters();
+  for (size_t i = 0; i < num_counters; ++i) {
+    counters[i].name = internal::GetCounterName(i);
+    counters[i].per_iteration = static_cast<float>(counter_totals_[i]) /
+                                static_cast<float>(iterations);
   }
+  test_measurement.counters =
+      span<const TestCounter>(counters.data(), num_counters);
 
-  // Final iteration
-  PW_LOG_DEBUG("Total Duration: %ld  Total Iterations: %d",
+  PW_LOG_DEBUG("Total Duration: %ld  Total Samples: %d",
                static_cast<long>(total_duration_),
-               test_iterations_);
-  mean_ =
-      IntegerDivisionRoundNearest(total_duration_, int64_t{test_iterations_});
-  PW_LOG_DEBUG("Mean: %ld", static_cast<long>(mean_));
-  PW_LOG_DEBUG("Minimum: %ld", static_cast<long>(min_));
-  PW_LOG_DEBUG("Maximum: %ld", static_cast<long>(max_));
-  TestMeasurement test_measurement = {
-      .mean = mean_,
-      .max = max_,
-      .min = min_,
-  };
+               num_samples_);
+  PW_LOG_DEBUG("Mean: %ld", static_cast<long>(test_measurement.mean));
+  PW_LOG_DEBUG("Minimum: %ld", static_cast<long>(test_measurement.min));
+  PW_LOG_DEBUG("Maximum: %ld", static_cast<long>(test_measurement.max));
   event_handler_->TestCaseEnd(test_info, test_measurement);
-  return false;
 }
 
 }  // namespace pw::perf_test
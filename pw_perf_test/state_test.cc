@@ -31,8 +31,11 @@ class EmptyEventHandler : public EventHandler {
 
 EmptyEventHandler handler;
 
+volatile int sink = 0;
+
 void TestFunction() {
-  for (volatile int i = 0; i < 10; i = i + 1) {
+  for (int i = 0; i < 10; ++i) {
+    sink = i;
   }
 }
 
@@ -60,5 +63,74 @@ TEST(StateTest, SingleTest) {
   EXPECT_EQ(total_iterations, kWarmUpIterations + test_iterations);
 }
 
+class RecordingEventHandler : public EmptyEventHandler {
+ public:
+  void TestCaseStart(const TestCase& test_case) override {
+    started = test_case;
+  }
+  void TestCaseIteration(const TestIteration&) override { ++samples; }
+  void TestCaseEnd(const TestCase&, const TestMeasurement& result) override {
+    measurement = result;
+  }
+
+  TestCase started;
+  int samples = 0;
+  TestMeasurement measurement;
+};
+
+TEST(StateTest, Calibrate_BatchesFastIterations) {
+  constexpr int kSamples = 10;
+  RecordingEventHandler recorder;
+  State state_obj = internal::CreateState(
+      kSamples, /*min_sample_duration=*/100000, recorder, {.name = "test"});
+  int total_iterations = 0;
+  while (state_obj.KeepRunning()) {
+    ++total_iterations;
+    TestFunction();
+  }
+  EXPECT_EQ(recorder.samples, kSamples);
+  EXPECT_EQ(recorder.measurement.samples, static_cast<uint32_t>(kSamples));
+  EXPECT_GT(recorder.measurement.iterations_per_sample, 1u);
+  EXPECT_GT(total_iterations,
+            kSamples * static_cast<int>(
+                           recorder.measurement.iterations_per_sample));
+  EXPECT_LE(recorder.measurement.min, recorder.measurement.sample_p50);
+  EXPECT_LE(recorder.measurement.sample_p50, recorder.measurement.sample_p90);
+  EXPECT_LE(recorder.measurement.sample_p90, recorder.measurement.sample_p99);
+  EXPECT_LE(recorder.measurement.sample_p99, recorder.measurement.max);
+}
+
+TEST(StateTest, Argument_IsReported) {
+  RecordingEventHandler recorder;
+  State state_obj = internal::CreateState(
+      1, 0, recorder, {.name = "test", .argument = 64, .has_argument = true});
+  EXPECT_EQ(state_obj.argument(), 64);
+  while (state_obj.KeepRunning()) {
+  }
+  EXPECT_TRUE(recorder.started.has_argument);
+  EXPECT_EQ(recorder.started.argument, 64);
+}
+
+TEST(StateTest, Throughput) {
+  RecordingEventHandler recorder;
+  State state_obj = internal::CreateState(5, 10000, recorder, {.name = "test"});
+  state_obj.SetBytesPerIteration(128);
+  state_obj.SetItemsPerIteration(1);
+  while (state_obj.KeepRunning()) {
+    TestFunction();
+  }
+  if constexpr (internal::kDurationUnit ==
+                internal::DurationUnit::kNanoseconds) {
+    EXPECT_GT(recorder.measurement.items_per_second, 0);
+    // Allow for rounding of each rate.
+    EXPECT_NEAR(recorder.measurement.bytes_per_second,
+                recorder.measurement.items_per_second * 128,
+                128);
+  } else {
+    EXPECT_EQ(recorder.measurement.bytes_per_second, 0);
+    EXPECT_EQ(recorder.measurement.items_per_second, 0);
+  }
+}
+
 }  // namespace
 }  // namespace pw::perf_test
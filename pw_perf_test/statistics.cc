@@ -0,0 +1,76 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_perf_test/internal/statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "pw_assert/check.h"
+#include "pw_numeric/integer_division.h"
+
+namespace pw::perf_test::internal {
+
+void CalculateStatistics(span<int64_t> samples, TestMeasurement& measurement) {
+  PW_CHECK(!samples.empty());
+  std::sort(samples.begin(), samples.end());
+
+  int64_t total = 0;
+  for (int64_t sample : samples) {
+    total += sample;
+  }
+  const auto count = static_cast<int64_t>(samples.size());
+  measurement.mean = IntegerDivisionRoundNearest(total, count);
+  measurement.min = samples.front();
+  measurement.max = samples.back();
+  measurement.sample_p50 = Percentile(samples, 50);
+  measurement.sample_p90 = Percentile(samples, 90);
+  measurement.sample_p99 = Percentile(samples, 99);
+
+  // Use the exact mean rather than the rounded one for the deviations.
+  const double mean = static_cast<double>(total) / static_cast<double>(count);
+  double sum_of_squares = 0;
+  for (int64_t sample : samples) {
+    const double deviation = static_cast<double>(sample) - mean;
+    sum_of_squares += deviation * deviation;
+  }
+  // Samples are a subset of all possible runs, so use the sample standard
+  // deviation, i.e. Bessel's correction.
+  double variance = 0;
+  if (count > 1) {
+    variance = sum_of_squares / static_cast<double>(count - 1);
+  }
+  measurement.stddev = std::llround(std::sqrt(variance));
+  measurement.samples = static_cast<uint32_t>(samples.size());
+}
+
+int64_t Percentile(span<const int64_t> sorted_samples, uint32_t percentile) {
+  PW_CHECK(!sorted_samples.empty());
+  PW_CHECK_UINT_LE(percentile, 100);
+  // Nearest rank: the smallest sample such that at least `percentile` percent
+  // of the samples are less than or equal to it.
+  size_t rank = (sorted_samples.size() * percentile + 99) / 100;
+  return sorted_samples[rank == 0 ? 0 : rank - 1];
+}
+
+int64_t PerSecond(uint64_t count, int64_t nanoseconds) {
+  if (nanoseconds <= 0) {
+    return 0;
+  }
+  constexpr double kNanosecondsPerSecond = 1e9;
+  return std::llround(static_cast<double>(count) * kNanosecondsPerSecond /
+                      static_cast<double>(nanoseconds));
+}
+
+}  // namespace pw::perf_test::internal
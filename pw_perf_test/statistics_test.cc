@@ -0,0 +1,89 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_perf_test/internal/statistics.h"
+
+#include <array>
+#include <cstdint>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::perf_test::internal {
+namespace {
+
+TEST(StatisticsTest, SingleSample) {
+  std::array<int64_t, 1> samples = {42};
+  TestMeasurement measurement;
+  CalculateStatistics(samples, measurement);
+  EXPECT_EQ(measurement.mean, 42);
+  EXPECT_EQ(measurement.min, 42);
+  EXPECT_EQ(measurement.max, 42);
+  EXPECT_EQ(measurement.sample_p50, 42);
+  EXPECT_EQ(measurement.sample_p99, 42);
+  EXPECT_EQ(measurement.stddev, 0);
+  EXPECT_EQ(measurement.samples, 1u);
+}
+
+TEST(StatisticsTest, UnsortedSamples) {
+  std::array<int64_t, 8> samples = {9, 2, 5, 4, 4, 7, 5, 4};
+  TestMeasurement measurement;
+  CalculateStatistics(samples, measurement);
+  EXPECT_EQ(measurement.mean, 5);
+  EXPECT_EQ(measurement.min, 2);
+  EXPECT_EQ(measurement.max, 9);
+  EXPECT_EQ(measurement.sample_p50, 4);
+  EXPECT_EQ(measurement.sample_p90, 9);
+  // Sum of squared deviations is 32, so the sample variance is 32 / 7.
+  EXPECT_EQ(measurement.stddev, 2);
+  EXPECT_EQ(measurement.samples, 8u);
+}
+
+TEST(StatisticsTest, Percentile_NearestRank) {
+  std::array<int64_t, 100> samples;
+  for (size_t i = 0; i < samples.size(); ++i) {
+    samples[i] = static_cast<int64_t>(i + 1);
+  }
+  EXPECT_EQ(Percentile(samples, 0), 1);
+  EXPECT_EQ(Percentile(samples, 1), 1);
+  EXPECT_EQ(Percentile(samples, 50), 50);
+  EXPECT_EQ(Percentile(samples, 90), 90);
+  EXPECT_EQ(Percentile(samples, 99), 99);
+  EXPECT_EQ(Percentile(samples, 100), 100);
+
+  std::array<int64_t, 3> few = {10, 20, 30};
+  EXPECT_EQ(Percentile(few, 50), 20);
+  EXPECT_EQ(Percentile(few, 90), 30);
+}
+
+TEST(StatisticsTest, Percentile_TailIsRobustToOutliers) {
+  std::array<int64_t, 100> samples;
+  samples.fill(100);
+  samples[0] = 100000;
+  TestMeasurement measurement;
+  CalculateStatistics(samples, measurement);
+  EXPECT_EQ(measurement.sample_p50, 100);
+  EXPECT_EQ(measurement.sample_p99, 100);
+  EXPECT_EQ(measurement.max, 100000);
+  EXPECT_GT(measurement.mean, 100);
+}
+
+TEST(StatisticsTest, PerSecond) {
+  EXPECT_EQ(PerSecond(1000, 1'000'000'000), 1000);
+  EXPECT_EQ(PerSecond(1, 4), 250'000'000);
+  EXPECT_EQ(PerSecond(0, 10), 0);
+  EXPECT_EQ(PerSecond(10, 0), 0);
+}
+
+}  // namespace
+}  // namespace pw::perf_test::internal
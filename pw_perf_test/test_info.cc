@@ -14,6 +14,7 @@
 
 #include "pw_perf_test/internal/test_info.h"
 
+#include "pw_assert/assert.h"
 #include "pw_perf_test/internal/framework.h"
 
 namespace pw::perf_test::internal {
@@ -25,4 +26,24 @@ TestInfo::TestInfo(const char* test_name, void (*function_body)(State&))
   Framework::Get().RegisterTest(*this);
 }
 
+TestInfo::TestInfo(const char* test_name,
+                   void (*function_body)(State&),
+                   const ArgumentRange& arguments)
+    : run_(function_body),
+      test_name_(test_name),
+      arguments_(arguments),
+      has_arguments_(true) {
+  PW_ASSERT(arguments_.first <= arguments_.last);
+  PW_ASSERT(arguments_.multiplier > 1);
+  Framework::Get().RegisterTest(*this);
+}
+
+int ArgumentRange::count() const {
+  int count = 1;
+  for (int64_t argument = first; argument != last; argument = Next(argument)) {
+    ++count;
+  }
+  return count;
+}
+
 }  // namespace pw::perf_test::internal
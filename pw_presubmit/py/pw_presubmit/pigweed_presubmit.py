@@ -1002,6 +1002,7 @@ def pw_transfer_integration_test(ctx: PresubmitContext) -> None:
         '//pw_transfer/integration_test:cross_language_large_read_test',
         '//pw_transfer/integration_test:cross_language_large_write_test',
         '//pw_transfer/integration_test:multi_transfer_test',
+        '//pw_transfer/integration_test:lossy_channel_test',
         '//pw_transfer/integration_test:expected_errors_test',
         '//pw_transfer/integration_test:legacy_binaries_test',
         '--test_output=errors',
@@ -0,0 +1,182 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "pw_assert/assert.h"
+#include "pw_bytes/span.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_protobuf/wire_format.h"
+#include "pw_protobuf_test_protos/wide.pwpb.h"
+#include "pw_span/span.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_varint/varint.h"
+
+namespace pw::protobuf {
+namespace {
+
+// Measures decoding messages with many fields into their generated structs.
+//
+// Each message is decoded with its fields in table order, as written by
+// `StreamEncoder::Write()`, and in the reverse order. Fields of `WideTest` are
+// numbered from 1 in order, while those of `SparseWideTest` are not. Messages
+// are decoded both through a stream and directly from their buffer.
+
+namespace SparseWideTest = test::pwpb::SparseWideTest;
+namespace WideTest = test::pwpb::WideTest;
+
+constexpr size_t kNumFields = 64;
+constexpr size_t kMaxEncodedSize = 1024;
+
+/// An encoded message, with its fields in a chosen order.
+class Encoded {
+ public:
+  template <typename Encoder, typename Message>
+  static Encoded Of(const Message& message) {
+    Encoded encoded;
+    Encoder encoder(encoded.buffer_);
+    PW_ASSERT(encoder.Write(message).ok());
+    encoded.size_ = encoder.size();
+    return encoded;
+  }
+
+  ConstByteSpan bytes() const { return span(buffer_).first(size_); }
+
+  /// Returns a copy of this message with its fields in the reverse order.
+  Encoded Reversed() const {
+    std::array<ConstByteSpan, kNumFields> fields;
+    size_t num_fields = 0;
+    ConstByteSpan remaining = bytes();
+    while (!remaining.empty()) {
+      PW_ASSERT(num_fields < fields.size());
+      size_t field_size = FieldSize(remaining);
+      fields[num_fields++] = remaining.first(field_size);
+      remaining = remaining.subspan(field_size);
+    }
+    Encoded reversed;
+    while (num_fields != 0) {
+      ConstByteSpan field = fields[--num_fields];
+      std::copy(field.begin(), field.end(), reversed.buffer_ + reversed.size_);
+      reversed.size_ += field.size();
+    }
+    return reversed;
+  }
+
+ private:
+  // Returns the size of the first field of `bytes`. The wide test messages
+  // only have varint and fixed32 fields.
+  static size_t FieldSize(ConstByteSpan bytes) {
+    uint64_t key = 0;
+    size_t key_size = varint::Decode(bytes, &key);
+    PW_ASSERT(key_size != 0 && FieldKey::IsValidKey(key));
+    switch (FieldKey(static_cast<uint32_t>(key)).wire_type()) {
+      case WireType::kVarint: {
+        uint64_t value = 0;
+        size_t value_size = varint::Decode(bytes.subspan(key_size), &value);
+        PW_ASSERT(value_size != 0);
+        return key_size + value_size;
+      }
+      case WireType::kFixed32:
+        return key_size + sizeof(uint32_t);
+      default:
+        PW_CRASH("Unexpected wire type");
+    }
+  }
+
+  std::byte buffer_[kMaxEncodedSize];
+  size_t size_ = 0;
+};
+
+// Sets every field of a message to a distinct, non-default value, so that all
+// of them are encoded.
+template <typename Fields>
+void Fill(Fields fields) {
+  std::apply(
+      [](auto&... field) {
+        uint32_t value = 0;
+        ((field = static_cast<std::remove_reference_t<decltype(field)>>(
+              ++value)),
+         ...);
+      },
+      fields);
+}
+
+// Where decoders read the encoded message from.
+enum class Source {
+  kStream,  // A generated StreamDecoder with a stream::MemoryReader.
+  kSpan,    // The generated Decode() function, which reads the buffer directly.
+};
+
+template <typename Decoder, typename Message>
+void MeasureDecode(perf_test::State& state,
+                   Source source,
+                   const Encoded& encoded) {
+  while (state.KeepRunning()) {
+    Message message{};
+    if (source == Source::kSpan) {
+      // Found by argument-dependent lookup in the message's namespace.
+      PW_ASSERT(Decode(encoded.bytes(), message).ok());
+    } else {
+      stream::MemoryReader reader(encoded.bytes());
+      Decoder decoder(reader);
+      PW_ASSERT(decoder.Read(message).ok());
+    }
+  }
+}
+
+void DecodeWide(perf_test::State& state, Source source, bool reversed) {
+  WideTest::Message message{};
+  Fill(WideTest::ToMutableTuple(message));
+  Encoded encoded = Encoded::Of<WideTest::MemoryEncoder>(message);
+  MeasureDecode<WideTest::StreamDecoder, WideTest::Message>(
+      state, source, reversed ? encoded.Reversed() : encoded);
+}
+
+void DecodeSparseWide(perf_test::State& state, Source source, bool reversed) {
+  SparseWideTest::Message message{};
+  Fill(SparseWideTest::ToMutableTuple(message));
+  Encoded encoded = Encoded::Of<SparseWideTest::MemoryEncoder>(message);
+  MeasureDecode<SparseWideTest::StreamDecoder, SparseWideTest::Message>(
+      state, source, reversed ? encoded.Reversed() : encoded);
+}
+
+PW_PERF_TEST(DecodeWideInOrder, DecodeWide, Source::kStream, false);
+PW_PERF_TEST(DecodeWideReversed, DecodeWide, Source::kStream, true);
+PW_PERF_TEST(DecodeSparseWideInOrder,
+             DecodeSparseWide,
+             Source::kStream,
+             false);
+PW_PERF_TEST(DecodeSparseWideReversed,
+             DecodeSparseWide,
+             Source::kStream,
+             true);
+
+PW_PERF_TEST(DecodeWideInOrderFromSpan, DecodeWide, Source::kSpan, false);
+PW_PERF_TEST(DecodeWideReversedFromSpan, DecodeWide, Source::kSpan, true);
+PW_PERF_TEST(DecodeSparseWideInOrderFromSpan,
+             DecodeSparseWide,
+             Source::kSpan,
+             false);
+PW_PERF_TEST(DecodeSparseWideReversedFromSpan,
+             DecodeSparseWide,
+             Source::kSpan,
+             true);
+
+}  // namespace
+}  // namespace pw::protobuf
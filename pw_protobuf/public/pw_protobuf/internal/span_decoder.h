@@ -0,0 +1,56 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_protobuf/internal/codegen.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw::protobuf::internal {
+
+// Returns the entry in `table` for `field_number`, or nullptr if there is none.
+//
+// `next` should start at zero for each message. It is updated to the index
+// after the returned entry, which is the likely next field when a message's
+// fields are serialized in table order.
+const MessageField* FindMessageField(span<const MessageField> table,
+                                     uint32_t field_number,
+                                     size_t& next);
+
+// Stores a decoded varint in `out`, which holds a bool, a 32-bit integer or a
+// 64-bit integer. Signed values are converted according to `decode_type`.
+//
+// Returns FAILED_PRECONDITION if the value does not fit in `out`.
+Status StoreVarint(uint64_t value, VarintType decode_type, span<std::byte> out);
+
+// Decodes a serialized protobuf held in a contiguous buffer into the structure
+// contained within message according to the description of fields in table.
+//
+// This is equivalent to `StreamDecoder::Read()` over a `stream::MemoryReader`,
+// but reads the buffer directly instead of through the `stream::Reader`
+// interface, and checks bounds once per field instead of once per byte.
+// Repeated fields, fixed-size arrays and callbacks are decoded by handing
+// that field's bytes to a `StreamDecoder`.
+//
+// This is called by the codegen `Decode()` functions and by `pw_rpc` when the
+// serialized message is already in memory.
+Status DecodeMessage(ConstByteSpan data,
+                     span<std::byte> message,
+                     span<const MessageField> table);
+
+}  // namespace pw::protobuf::internal
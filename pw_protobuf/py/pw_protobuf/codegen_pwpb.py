@@ -3448,6 +3448,20 @@ def generate_table_for_message(
             'MessageField> kMessageFields;'
         )
 
+    # Decoding from a buffer reads it directly rather than through a
+    # StreamDecoder and stream::MemoryReader.
+    output.write_line(
+        'inline ::pw::Status Decode(::pw::ConstByteSpan buffer, '
+        'Message& message) {'
+    )
+    with output.indent():
+        output.write_line(
+            f'return {_INTERNAL_NAMESPACE}::DecodeMessage('
+            'buffer, ::pw::as_writable_bytes(::pw::span(&message, 1)), '
+            'kMessageFields);'
+        )
+    output.write_line('}')
+
     output.write_line(f'}}  // namespace {namespace}')
 
 
@@ -3651,6 +3665,7 @@ def generate_code_for_package(
     output.write_line('#include "pw_protobuf/encoder.h"')
     output.write_line('#include "pw_protobuf/find.h"')
     output.write_line('#include "pw_protobuf/internal/codegen.h"')
+    output.write_line('#include "pw_protobuf/internal/span_decoder.h"')
     output.write_line('#include "pw_protobuf/serialized_size.h"')
     output.write_line('#include "pw_protobuf/stream_decoder.h"')
     output.write_line('#include "pw_result/result.h"')
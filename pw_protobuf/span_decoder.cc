@@ -0,0 +1,299 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_protobuf/internal/span_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/bit.h"
+#include "pw_containers/vector.h"
+#include "pw_protobuf/stream_decoder.h"
+#include "pw_protobuf/wire_format.h"
+#include "pw_status/try.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_string/string.h"
+#include "pw_varint/varint.h"
+
+namespace pw::protobuf::internal {
+namespace {
+
+// Exposes the table-driven `Read()` of `StreamDecoder`, which decodes the
+// fields that `DecodeMessage()` does not handle itself.
+class FieldDecoder : public StreamDecoder {
+ public:
+  constexpr explicit FieldDecoder(stream::Reader& reader)
+      : StreamDecoder(reader) {}
+
+  using StreamDecoder::Read;
+};
+
+// Decodes the varint at the start of `data`. Returns the number of bytes read,
+// or 0 if the varint is truncated or too long.
+size_t DecodeVarint(ConstByteSpan data, uint64_t& value) {
+  // Most keys, lengths and small values fit in a single byte.
+  if (!data.empty() && static_cast<uint8_t>(data[0]) < 0x80) {
+    value = static_cast<uint8_t>(data[0]);
+    return 1;
+  }
+  return varint::Decode(data, &value);
+}
+
+template <typename T>
+void AssignOptional(std::byte* out, T value) {
+  *reinterpret_cast<std::optional<T>*>(out) = value;
+}
+
+Status DecodeVarintField(const MessageField& field,
+                         uint64_t value,
+                         span<std::byte> out) {
+  PW_CHECK(field.elem_size() == sizeof(uint64_t) ||
+               field.elem_size() == sizeof(uint32_t) ||
+               field.elem_size() == sizeof(bool),
+           "Mismatched message field type and size");
+  if (!field.is_optional()) {
+    PW_CHECK(out.size() == field.elem_size(),
+             "Mismatched message field type and size");
+    return StoreVarint(value, field.varint_type(), out);
+  }
+  // The struct member for this field is a std::optional of a type
+  // corresponding to the field element size. Assign through a temporary of
+  // that type, as StreamDecoder does.
+  if (field.elem_size() == sizeof(uint64_t)) {
+    uint64_t result = 0;
+    PW_TRY(StoreVarint(
+        value, field.varint_type(), as_writable_bytes(span(&result, 1))));
+    AssignOptional(out.data(), result);
+  } else if (field.elem_size() == sizeof(uint32_t)) {
+    uint32_t result = 0;
+    PW_TRY(StoreVarint(
+        value, field.varint_type(), as_writable_bytes(span(&result, 1))));
+    AssignOptional(out.data(), result);
+  } else {
+    bool result = false;
+    PW_TRY(StoreVarint(
+        value, field.varint_type(), as_writable_bytes(span(&result, 1))));
+    AssignOptional(out.data(), result);
+  }
+  return OkStatus();
+}
+
+void DecodeFixedField(const MessageField& field,
+                      ConstByteSpan value,
+                      span<std::byte> out) {
+  PW_CHECK(field.elem_size() == value.size(),
+           "Mismatched message field type and size");
+  std::byte result[sizeof(uint64_t)];
+  std::memcpy(result, value.data(), value.size());
+  if (endian::native != endian::little) {
+    std::reverse(result, result + value.size());
+  }
+  if (!field.is_optional()) {
+    PW_CHECK(out.size() == value.size(),
+             "Mismatched message field type and size");
+    std::memcpy(out.data(), result, value.size());
+  } else if (value.size() == sizeof(uint64_t)) {
+    uint64_t fixed;
+    std::memcpy(&fixed, result, sizeof(fixed));
+    AssignOptional(out.data(), fixed);
+  } else {
+    uint32_t fixed;
+    std::memcpy(&fixed, result, sizeof(fixed));
+    AssignOptional(out.data(), fixed);
+  }
+}
+
+template <typename Container>
+Status DecodeStringOrBytesField(ConstByteSpan value, std::byte* out) {
+  auto& container = *reinterpret_cast<Container*>(out);
+  if (container.capacity() < value.size()) {
+    return Status::ResourceExhausted();
+  }
+  container.resize(static_cast<uint16_t>(value.size()));
+  std::memcpy(container.data(), value.data(), value.size());
+  return OkStatus();
+}
+
+// Decodes a field by handing its bytes to a `StreamDecoder`.
+Status DecodeWithStream(ConstByteSpan field_bytes,
+                        span<std::byte> message,
+                        const MessageField& field) {
+  stream::MemoryReader reader(field_bytes);
+  FieldDecoder decoder(reader);
+  return decoder.Read(message, span(&field, 1));
+}
+
+}  // namespace
+
+const MessageField* FindMessageField(span<const MessageField> table,
+                                     uint32_t field_number,
+                                     size_t& next) {
+  // Checking every entry makes decoding a message quadratic in its number of
+  // fields, so two constant-time lookups are tried first:
+  //
+  //  - `next` is the entry after the previously decoded field. Messages written
+  //    by `StreamEncoder::Write()` list their fields in table order, so this
+  //    finds each field regardless of how they are numbered.
+  //  - Fields are usually numbered from 1 in the order they are declared, in
+  //    which case the entry at index `field_number - 1` is the field itself.
+  size_t index = next;
+  if (index >= table.size() || table[index].field_number() != field_number) {
+    index = static_cast<size_t>(field_number) - 1;
+  }
+  if (index >= table.size() || table[index].field_number() != field_number) {
+    auto field = std::find(table.begin(), table.end(), field_number);
+    if (field == table.end()) {
+      return nullptr;
+    }
+    index = static_cast<size_t>(field - table.begin());
+  }
+  next = index + 1;
+  return &table[index];
+}
+
+Status StoreVarint(uint64_t value, VarintType decode_type, span<std::byte> out) {
+  if (out.size() == sizeof(uint64_t)) {
+    if (decode_type == VarintType::kUnsigned) {
+      std::memcpy(out.data(), &value, out.size());
+    } else {
+      const int64_t signed_value = decode_type == VarintType::kZigZag
+                                       ? varint::ZigZagDecode(value)
+                                       : static_cast<int64_t>(value);
+      std::memcpy(out.data(), &signed_value, out.size());
+    }
+  } else if (out.size() == sizeof(uint32_t)) {
+    if (decode_type == VarintType::kUnsigned) {
+      if (value > std::numeric_limits<uint32_t>::max()) {
+        return Status::FailedPrecondition();
+      }
+      std::memcpy(out.data(), &value, out.size());
+    } else {
+      const int64_t signed_value = decode_type == VarintType::kZigZag
+                                       ? varint::ZigZagDecode(value)
+                                       : static_cast<int64_t>(value);
+      if (signed_value > std::numeric_limits<int32_t>::max() ||
+          signed_value < std::numeric_limits<int32_t>::min()) {
+        return Status::FailedPrecondition();
+      }
+      std::memcpy(out.data(), &signed_value, out.size());
+    }
+  } else if (out.size() == sizeof(bool)) {
+    PW_CHECK(decode_type == VarintType::kUnsigned,
+             "Protobuf bool can never be signed");
+    std::memcpy(out.data(), &value, out.size());
+  }
+  return OkStatus();
+}
+
+Status DecodeMessage(ConstByteSpan data,
+                     span<std::byte> message,
+                     span<const MessageField> table) {
+  size_t next_index = 0;
+  while (!data.empty()) {
+    uint64_t key = 0;
+    size_t key_size = DecodeVarint(data, key);
+    if (key_size == 0 || !FieldKey::IsValidKey(key)) {
+      return Status::DataLoss();
+    }
+    const FieldKey field_key(static_cast<uint32_t>(key));
+
+    // Find the extent of the field's value, and check that it is entirely
+    // within the buffer before reading any of it.
+    ConstByteSpan remaining = data.subspan(key_size);
+    uint64_t varint_value = 0;
+    size_t value_offset = key_size;
+    size_t value_size = 0;
+    switch (field_key.wire_type()) {
+      case WireType::kVarint:
+        value_size = DecodeVarint(remaining, varint_value);
+        if (value_size == 0) {
+          return Status::DataLoss();
+        }
+        break;
+      case WireType::kFixed32:
+        value_size = sizeof(uint32_t);
+        break;
+      case WireType::kFixed64:
+        value_size = sizeof(uint64_t);
+        break;
+      case WireType::kDelimited: {
+        uint64_t length = 0;
+        size_t length_size = DecodeVarint(remaining, length);
+        if (length_size == 0 || length > remaining.size() - length_size) {
+          return Status::DataLoss();
+        }
+        value_offset += length_size;
+        value_size = static_cast<size_t>(length);
+        break;
+      }
+    }
+    if (value_size > data.size() - value_offset) {
+      return Status::DataLoss();
+    }
+    const ConstByteSpan field_bytes = data.first(value_offset + value_size);
+    const ConstByteSpan value = field_bytes.subspan(value_offset);
+    data = data.subspan(field_bytes.size());
+
+    const MessageField* field =
+        FindMessageField(table, field_key.field_number(), next_index);
+    if (field == nullptr) {
+      // TODO: b/234873295 - Provide a way to allow the caller to inspect
+      // unknown fields, and serialize them back out later.
+      continue;
+    }
+
+    const auto out = message.subspan(field->field_offset(), field->field_size());
+    PW_CHECK(out.begin() >= message.begin() && out.end() <= message.end());
+
+    // Only singular fields of the expected wire type are decoded here. The
+    // rest, including callbacks and wire type mismatches, are decoded by
+    // `StreamDecoder` so that they behave exactly the same.
+    if (field->callback_type() != CallbackType::kNone ||
+        field->is_repeated() || field->is_fixed_size() ||
+        field_key.wire_type() != field->wire_type()) {
+      PW_TRY(DecodeWithStream(field_bytes, message, *field));
+      continue;
+    }
+
+    switch (field->wire_type()) {
+      case WireType::kVarint:
+        PW_TRY(DecodeVarintField(*field, varint_value, out));
+        break;
+      case WireType::kFixed32:
+      case WireType::kFixed64:
+        DecodeFixedField(*field, value, out);
+        break;
+      case WireType::kDelimited:
+        if (field->nested_message_fields()) {
+          PW_TRY(DecodeMessage(value, out, *field->nested_message_fields()));
+        } else {
+          PW_CHECK(field->elem_size() == sizeof(std::byte),
+                   "Mismatched message field type and size");
+          if (field->is_string()) {
+            PW_TRY(DecodeStringOrBytesField<InlineString<>>(value, out.data()));
+          } else {
+            PW_TRY(DecodeStringOrBytesField<Vector<std::byte>>(value,
+                                                                out.data()));
+          }
+        }
+        break;
+    }
+  }
+  return OkStatus();
+}
+
+}  // namespace pw::protobuf::internal
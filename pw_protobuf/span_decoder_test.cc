@@ -0,0 +1,376 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_protobuf/internal/span_decoder.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_bytes/span.h"
+#include "pw_containers/vector.h"
+#include "pw_preprocessor/compiler.h"
+#include "pw_protobuf/encoder.h"
+#include "pw_protobuf/internal/codegen.h"
+#include "pw_protobuf/stream_decoder.h"
+#include "pw_status/status.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_string/string.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::protobuf {
+namespace {
+
+using internal::CallbackType;
+using internal::MessageField;
+using internal::VarintType;
+
+struct NestedMessage {
+  uint32_t one;
+  uint32_t two;
+};
+
+struct TestMessage {
+  uint32_t uint32;
+  int32_t sint32;
+  int64_t int64;
+  bool flag;
+  uint32_t fixed32;
+  uint64_t fixed64;
+  std::optional<uint32_t> optional;
+  InlineString<8> string;
+  Vector<std::byte, 4> bytes;
+  NestedMessage nested;
+  Vector<uint32_t, 4> repeated;
+  Callback<StreamEncoder, StreamDecoder> callback;
+};
+
+constexpr MessageField kNestedFields[] = {
+    {1,
+     WireType::kVarint,
+     sizeof(uint32_t),
+     VarintType::kUnsigned,
+     false,
+     false,
+     false,
+     false,
+     CallbackType::kNone,
+     offsetof(NestedMessage, one),
+     sizeof(uint32_t),
+     nullptr},
+    {2,
+     WireType::kVarint,
+     sizeof(uint32_t),
+     VarintType::kUnsigned,
+     false,
+     false,
+     false,
+     false,
+     CallbackType::kNone,
+     offsetof(NestedMessage, two),
+     sizeof(uint32_t),
+     nullptr},
+};
+constexpr span<const MessageField> kNestedTable = kNestedFields;
+
+PW_MODIFY_DIAGNOSTICS_PUSH();
+PW_MODIFY_DIAGNOSTIC(ignored, "-Winvalid-offsetof");
+
+constexpr MessageField Field(uint32_t field_number,
+                             WireType wire_type,
+                             size_t elem_size,
+                             VarintType varint_type,
+                             size_t offset,
+                             size_t size) {
+  return MessageField(field_number,
+                      wire_type,
+                      elem_size,
+                      varint_type,
+                      false,
+                      false,
+                      false,
+                      false,
+                      CallbackType::kNone,
+                      offset,
+                      size,
+                      nullptr);
+}
+
+constexpr MessageField kTestFields[] = {
+    Field(1,
+          WireType::kVarint,
+          sizeof(uint32_t),
+          VarintType::kUnsigned,
+          offsetof(TestMessage, uint32),
+          sizeof(uint32_t)),
+    Field(2,
+          WireType::kVarint,
+          sizeof(int32_t),
+          VarintType::kZigZag,
+          offsetof(TestMessage, sint32),
+          sizeof(int32_t)),
+    Field(3,
+          WireType::kVarint,
+          sizeof(int64_t),
+          VarintType::kNormal,
+          offsetof(TestMessage, int64),
+          sizeof(int64_t)),
+    Field(4,
+          WireType::kVarint,
+          sizeof(bool),
+          VarintType::kUnsigned,
+          offsetof(TestMessage, flag),
+          sizeof(bool)),
+    Field(5,
+          WireType::kFixed32,
+          sizeof(uint32_t),
+          VarintType::kUnsigned,
+          offsetof(TestMessage, fixed32),
+          sizeof(uint32_t)),
+    Field(6,
+          WireType::kFixed64,
+          sizeof(uint64_t),
+          VarintType::kUnsigned,
+          offsetof(TestMessage, fixed64),
+          sizeof(uint64_t)),
+    {7,
+     WireType::kVarint,
+     sizeof(uint32_t),
+     VarintType::kUnsigned,
+     false,
+     false,
+     false,
+     true,
+     CallbackType::kNone,
+     offsetof(TestMessage, optional),
+     sizeof(std::optional<uint32_t>),
+     nullptr},
+    {8,
+     WireType::kDelimited,
+     sizeof(std::byte),
+     VarintType::kUnsigned,
+     true,
+     false,
+     false,
+     false,
+     CallbackType::kNone,
+     offsetof(TestMessage, string),
+     sizeof(InlineString<8>),
+     nullptr},
+    Field(9,
+          WireType::kDelimited,
+          sizeof(std::byte),
+          VarintType::kUnsigned,
+          offsetof(TestMessage, bytes),
+          sizeof(Vector<std::byte, 4>)),
+    {10,
+     WireType::kDelimited,
+     sizeof(std::byte),
+     VarintType::kUnsigned,
+     false,
+     false,
+     false,
+     false,
+     CallbackType::kNone,
+     offsetof(TestMessage, nested),
+     sizeof(NestedMessage),
+     &kNestedTable},
+    {11,
+     WireType::kVarint,
+     sizeof(uint32_t),
+     VarintType::kUnsigned,
+     false,
+     false,
+     true,
+     false,
+     CallbackType::kNone,
+     offsetof(TestMessage, repeated),
+     sizeof(Vector<uint32_t, 4>),
+     nullptr},
+    {12,
+     WireType::kDelimited,
+     sizeof(std::byte),
+     VarintType::kUnsigned,
+     false,
+     false,
+     false,
+     false,
+     CallbackType::kSingleField,
+     offsetof(TestMessage, callback),
+     sizeof(Callback<StreamEncoder, StreamDecoder>),
+     nullptr},
+};
+
+PW_MODIFY_DIAGNOSTICS_POP();
+
+// Exposes the table-driven Read() used by generated decoders.
+class TableDecoder : public StreamDecoder {
+ public:
+  using StreamDecoder::StreamDecoder;
+  using StreamDecoder::Read;
+};
+
+Status DecodeWithSpan(ConstByteSpan data, TestMessage& message) {
+  return internal::DecodeMessage(
+      data, as_writable_bytes(span(&message, 1)), kTestFields);
+}
+
+Status DecodeWithStream(ConstByteSpan data, TestMessage& message) {
+  stream::MemoryReader reader(data);
+  TableDecoder decoder(reader);
+  return decoder.Read(as_writable_bytes(span(&message, 1)), kTestFields);
+}
+
+class SpanDecoderTest : public ::testing::Test {
+ protected:
+  SpanDecoderTest() : encoder_(buffer_) {}
+
+  ConstByteSpan encoded() const {
+    return ConstByteSpan(encoder_.data(), encoder_.size());
+  }
+
+  // Decodes the encoded message with both decoders, and checks that they
+  // return the same status.
+  Status Decode() {
+    Status status = DecodeWithSpan(encoded(), message_);
+    EXPECT_EQ(DecodeWithStream(encoded(), stream_message_), status);
+    return status;
+  }
+
+  std::array<std::byte, 128> buffer_{};
+  MemoryEncoder encoder_;
+  TestMessage message_{};
+  TestMessage stream_message_{};
+};
+
+TEST_F(SpanDecoderTest, Decode_AllFieldTypes) {
+  ASSERT_EQ(encoder_.WriteUint32(1, 300), OkStatus());
+  ASSERT_EQ(encoder_.WriteSint32(2, -5), OkStatus());
+  ASSERT_EQ(encoder_.WriteInt64(3, -1), OkStatus());
+  ASSERT_EQ(encoder_.WriteBool(4, true), OkStatus());
+  ASSERT_EQ(encoder_.WriteFixed32(5, 0x12345678), OkStatus());
+  ASSERT_EQ(encoder_.WriteFixed64(6, 0x0123456789abcdef), OkStatus());
+  ASSERT_EQ(encoder_.WriteUint32(7, 7), OkStatus());
+  ASSERT_EQ(encoder_.WriteString(8, "pigweed"), OkStatus());
+  constexpr std::array<std::byte, 3> kBytes = {
+      std::byte{1}, std::byte{2}, std::byte{3}};
+  ASSERT_EQ(encoder_.WriteBytes(9, kBytes), OkStatus());
+  {
+    StreamEncoder nested = encoder_.GetNestedEncoder(10);
+    ASSERT_EQ(nested.WriteUint32(2, 22), OkStatus());
+    ASSERT_EQ(nested.WriteUint32(1, 11), OkStatus());
+  }
+  ASSERT_EQ(encoder_.status(), OkStatus());
+
+  ASSERT_EQ(Decode(), OkStatus());
+  for (const TestMessage* message : {&message_, &stream_message_}) {
+    EXPECT_EQ(message->uint32, 300u);
+    EXPECT_EQ(message->sint32, -5);
+    EXPECT_EQ(message->int64, -1);
+    EXPECT_TRUE(message->flag);
+    EXPECT_EQ(message->fixed32, 0x12345678u);
+    EXPECT_EQ(message->fixed64, 0x0123456789abcdefu);
+    EXPECT_EQ(message->optional, 7u);
+    EXPECT_EQ(message->string, "pigweed");
+    ASSERT_EQ(message->bytes.size(), kBytes.size());
+    EXPECT_TRUE(std::equal(
+        message->bytes.begin(), message->bytes.end(), kBytes.begin()));
+    EXPECT_EQ(message->nested.one, 11u);
+    EXPECT_EQ(message->nested.two, 22u);
+  }
+}
+
+TEST_F(SpanDecoderTest, Decode_SkipsUnknownFields) {
+  ASSERT_EQ(encoder_.WriteString(100, "unknown"), OkStatus());
+  ASSERT_EQ(encoder_.WriteUint32(1, 1), OkStatus());
+  ASSERT_EQ(encoder_.WriteFixed64(101, 0), OkStatus());
+  ASSERT_EQ(encoder_.WriteUint64(102, 1'000'000'000'000), OkStatus());
+  ASSERT_EQ(encoder_.WriteFixed32(103, 0), OkStatus());
+  ASSERT_EQ(encoder_.WriteSint32(2, 2), OkStatus());
+
+  ASSERT_EQ(Decode(), OkStatus());
+  EXPECT_EQ(message_.uint32, 1u);
+  EXPECT_EQ(message_.sint32, 2);
+}
+
+TEST_F(SpanDecoderTest, Decode_RepeatedField) {
+  constexpr std::array<uint32_t, 2> kPacked = {1, 2};
+  ASSERT_EQ(encoder_.WritePackedUint32(11, kPacked), OkStatus());
+  ASSERT_EQ(encoder_.WriteUint32(11, 3), OkStatus());
+
+  ASSERT_EQ(Decode(), OkStatus());
+  ASSERT_EQ(message_.repeated.size(), 3u);
+  EXPECT_EQ(message_.repeated[0], 1u);
+  EXPECT_EQ(message_.repeated[1], 2u);
+  EXPECT_EQ(message_.repeated[2], 3u);
+}
+
+TEST_F(SpanDecoderTest, Decode_Callback) {
+  ASSERT_EQ(encoder_.WriteUint32(1, 1), OkStatus());
+  ASSERT_EQ(encoder_.WriteString(12, "callback"), OkStatus());
+  ASSERT_EQ(encoder_.WriteSint32(2, 2), OkStatus());
+
+  InlineString<16> value;
+  message_.callback.SetDecoder([&value](StreamDecoder& decoder) {
+    EXPECT_EQ(decoder.FieldNumber().value(), 12u);
+    value.resize(value.capacity());
+    StatusWithSize sws = decoder.ReadString(value);
+    value.resize(sws.size());
+    return sws.status();
+  });
+  EXPECT_EQ(DecodeWithSpan(encoded(), message_), OkStatus());
+  EXPECT_EQ(value, "callback");
+  EXPECT_EQ(message_.uint32, 1u);
+  EXPECT_EQ(message_.sint32, 2);
+}
+
+TEST_F(SpanDecoderTest, Decode_TruncatedVarint) {
+  ASSERT_EQ(encoder_.WriteUint32(1, 300), OkStatus());
+  ConstByteSpan truncated = encoded().first(encoded().size() - 1);
+  EXPECT_EQ(DecodeWithSpan(truncated, message_), Status::DataLoss());
+  EXPECT_EQ(DecodeWithStream(truncated, stream_message_), Status::DataLoss());
+}
+
+TEST_F(SpanDecoderTest, Decode_TruncatedDelimited) {
+  ASSERT_EQ(encoder_.WriteString(8, "pigweed"), OkStatus());
+  ConstByteSpan truncated = encoded().first(encoded().size() - 1);
+  EXPECT_EQ(DecodeWithSpan(truncated, message_), Status::DataLoss());
+  EXPECT_EQ(DecodeWithStream(truncated, stream_message_), Status::DataLoss());
+}
+
+TEST_F(SpanDecoderTest, Decode_TruncatedFixed) {
+  ASSERT_EQ(encoder_.WriteFixed64(6, 1), OkStatus());
+  ConstByteSpan truncated = encoded().first(encoded().size() - 1);
+  EXPECT_EQ(DecodeWithSpan(truncated, message_), Status::DataLoss());
+  EXPECT_EQ(DecodeWithStream(truncated, stream_message_), Status::DataLoss());
+}
+
+TEST_F(SpanDecoderTest, Decode_StringTooLong) {
+  ASSERT_EQ(encoder_.WriteString(8, "pigweed!!"), OkStatus());
+  EXPECT_EQ(Decode(), Status::ResourceExhausted());
+}
+
+TEST_F(SpanDecoderTest, Decode_ValueOutOfRange) {
+  ASSERT_EQ(encoder_.WriteUint64(1, uint64_t{1} << 32), OkStatus());
+  EXPECT_EQ(Decode(), Status::FailedPrecondition());
+}
+
+TEST_F(SpanDecoderTest, Decode_WrongWireType) {
+  ASSERT_EQ(encoder_.WriteFixed32(1, 1), OkStatus());
+  EXPECT_EQ(Decode(), Status::NotFound());
+}
+
+}  // namespace
+}  // namespace pw::protobuf
@@ -27,6 +27,7 @@
 #include "pw_function/function.h"
 #include "pw_protobuf/encoder.h"
 #include "pw_protobuf/internal/codegen.h"
+#include "pw_protobuf/internal/span_decoder.h"
 #include "pw_protobuf/wire_format.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
@@ -339,35 +340,9 @@ StatusWithSize StreamDecoder::ReadOneVarint(span<std::byte> out,
     return sws;
   }
 
-  if (out.size() == sizeof(uint64_t)) {
-    if (decode_type == VarintType::kUnsigned) {
-      std::memcpy(out.data(), &value, out.size());
-    } else {
-      const int64_t signed_value = decode_type == VarintType::kZigZag
-                                       ? varint::ZigZagDecode(value)
-                                       : static_cast<int64_t>(value);
-      std::memcpy(out.data(), &signed_value, out.size());
-    }
-  } else if (out.size() == sizeof(uint32_t)) {
-    if (decode_type == VarintType::kUnsigned) {
-      if (value > std::numeric_limits<uint32_t>::max()) {
-        return StatusWithSize(Status::FailedPrecondition(), sws.size());
-      }
-      std::memcpy(out.data(), &value, out.size());
-    } else {
-      const int64_t signed_value = decode_type == VarintType::kZigZag
-                                       ? varint::ZigZagDecode(value)
-                                       : static_cast<int64_t>(value);
-      if (signed_value > std::numeric_limits<int32_t>::max() ||
-          signed_value < std::numeric_limits<int32_t>::min()) {
-        return StatusWithSize(Status::FailedPrecondition(), sws.size());
-      }
-      std::memcpy(out.data(), &signed_value, out.size());
-    }
-  } else if (out.size() == sizeof(bool)) {
-    PW_CHECK(decode_type == VarintType::kUnsigned,
-             "Protobuf bool can never be signed");
-    std::memcpy(out.data(), &value, out.size());
+  if (Status status = internal::StoreVarint(value, decode_type, out);
+      !status.ok()) {
+    return StatusWithSize(status, sws.size());
   }
 
   return sws;
@@ -523,12 +498,13 @@ Status StreamDecoder::Read(span<std::byte> message,
                            span<const internal::MessageField> table) {
   PW_TRY(status_);
 
+  size_t next_index = 0;
   while (Next().ok()) {
-    // Find the field in the table,
-    // TODO: b/234876102 - Finding the field can be made more efficient.
-    const auto field =
-        std::find(table.begin(), table.end(), current_field_.field_number());
-    if (field == table.end()) {
+    // Find the field in the table.
+    const internal::MessageField* field =
+        internal::FindMessageField(
+            table, current_field_.field_number(), next_index);
+    if (field == nullptr) {
       // If the field is not found, skip to the next one.
       // TODO: b/234873295 - Provide a way to allow the caller to inspect
       // unknown fields, and serialize them back out later.
@@ -15,7 +15,10 @@
 #include "pw_protobuf/stream_decoder.h"
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 
+#include "pw_protobuf/internal/codegen.h"
 #include "pw_status/status.h"
 #include "pw_status/status_with_size.h"
 #include "pw_stream/memory_stream.h"
@@ -1638,5 +1641,113 @@ TEST(StreamDecoder, DelimitedFieldSizeLargerThanRemainingSpan_ReturnsDataLoss) {
   EXPECT_EQ(decoder.Next(), Status::DataLoss());
 }
 
+// Exposes the table-driven Read() used by generated decoders.
+class TableDecoder : public StreamDecoder {
+ public:
+  using StreamDecoder::StreamDecoder;
+
+  template <typename Message>
+  Status Read(Message& message, span<const internal::MessageField> table) {
+    return StreamDecoder::Read(as_writable_bytes(span(&message, 1)), table);
+  }
+};
+
+struct FourFields {
+  uint32_t a;
+  uint32_t b;
+  uint32_t c;
+  uint32_t d;
+};
+
+constexpr internal::MessageField Uint32Field(uint32_t field_number,
+                                             size_t offset) {
+  return internal::MessageField(field_number,
+                                WireType::kVarint,
+                                sizeof(uint32_t),
+                                internal::VarintType::kUnsigned,
+                                false,
+                                false,
+                                false,
+                                false,
+                                internal::CallbackType::kNone,
+                                offset,
+                                sizeof(uint32_t),
+                                nullptr);
+}
+
+constexpr internal::MessageField kDenseFields[] = {
+    Uint32Field(1, offsetof(FourFields, a)),
+    Uint32Field(2, offsetof(FourFields, b)),
+    Uint32Field(3, offsetof(FourFields, c)),
+    Uint32Field(4, offsetof(FourFields, d)),
+};
+
+constexpr internal::MessageField kSparseFields[] = {
+    Uint32Field(9, offsetof(FourFields, a)),
+    Uint32Field(3, offsetof(FourFields, b)),
+    Uint32Field(700, offsetof(FourFields, c)),
+    Uint32Field(12, offsetof(FourFields, d)),
+};
+
+// Returns the key of a varint field numbered below 16, which fits in a single
+// byte.
+constexpr std::byte Key(uint32_t field_number) {
+  return static_cast<std::byte>(
+      static_cast<uint32_t>(FieldKey(field_number, WireType::kVarint)));
+}
+
+TEST(StreamDecoder, Read_DenseFieldsInAnyOrder) {
+  constexpr std::byte kInput[] = {
+      Key(4), std::byte{4}, Key(2), std::byte{2}, Key(3), std::byte{3},
+      Key(1), std::byte{1}, Key(5), std::byte{5}, Key(4), std::byte{44},
+  };
+  stream::MemoryReader reader(kInput);
+  TableDecoder decoder(reader);
+  FourFields message{};
+  ASSERT_EQ(decoder.Read(message, kDenseFields), OkStatus());
+  EXPECT_EQ(message.a, 1u);
+  EXPECT_EQ(message.b, 2u);
+  EXPECT_EQ(message.c, 3u);
+  EXPECT_EQ(message.d, 44u);
+}
+
+TEST(StreamDecoder, Read_SparseFieldsInTableOrder) {
+  constexpr std::byte kInput[] = {
+      Key(9),
+      std::byte{1},
+      Key(3),
+      std::byte{2},
+      // Field 700 has a two-byte key.
+      std::byte{0xe0},
+      std::byte{0x2b},
+      std::byte{3},
+      Key(12),
+      std::byte{4},
+  };
+  stream::MemoryReader reader(kInput);
+  TableDecoder decoder(reader);
+  FourFields message{};
+  ASSERT_EQ(decoder.Read(message, kSparseFields), OkStatus());
+  EXPECT_EQ(message.a, 1u);
+  EXPECT_EQ(message.b, 2u);
+  EXPECT_EQ(message.c, 3u);
+  EXPECT_EQ(message.d, 4u);
+}
+
+TEST(StreamDecoder, Read_SparseFieldsInAnyOrder) {
+  constexpr std::byte kInput[] = {
+      Key(12), std::byte{4}, Key(4), std::byte{5}, Key(3), std::byte{2},
+      Key(9),  std::byte{1}, Key(1), std::byte{6},
+  };
+  stream::MemoryReader reader(kInput);
+  TableDecoder decoder(reader);
+  FourFields message{};
+  ASSERT_EQ(decoder.Read(message, kSparseFields), OkStatus());
+  EXPECT_EQ(message.a, 1u);
+  EXPECT_EQ(message.b, 2u);
+  EXPECT_EQ(message.c, 0u);
+  EXPECT_EQ(message.d, 4u);
+}
+
 }  // namespace
 }  // namespace pw::protobuf
@@ -62,9 +62,13 @@ Result<ConstByteSpan> EncodeCallbackToPayloadBuffer(
 
   ByteSpan payload_buffer =
       encoding_buffer.AllocatePayloadBuffer(MaxSafePayloadSize());
-  PW_TRY_ASSIGN(const size_t payload_size, callback(payload_buffer));
+  const StatusWithSize result = callback(payload_buffer);
+  if (!result.ok()) {
+    encoding_buffer.Release();
+    return result.status();
+  }
 
-  return payload_buffer.first(payload_size);
+  return payload_buffer.first(result.size());
 }
 
 // Creates an active server-side Call.
@@ -17,6 +17,7 @@
 
 #include "pw_protobuf/encoder.h"
 #include "pw_protobuf/internal/codegen.h"
+#include "pw_protobuf/internal/span_decoder.h"
 #include "pw_protobuf/stream_decoder.h"
 #include "pw_span/span.h"
 #include "pw_stream/null_stream.h"
@@ -59,7 +60,8 @@ class PwpbSerde {
   // Decodes a serialized protobuf into a pw_protobuf message struct.
   template <typename Message>
   Status Decode(ConstByteSpan buffer, Message& message) const {
-    return Decoder(buffer).Read(as_writable_bytes(span(&message, 1)), table_);
+    return protobuf::internal::DecodeMessage(
+        buffer, as_writable_bytes(span(&message, 1)), *table_);
   }
 
  private:
@@ -81,19 +83,6 @@ class PwpbSerde {
     using protobuf::StreamEncoder::Write;  // Make this method public
   };
 
-  class Decoder : public protobuf::StreamDecoder {
-   public:
-    constexpr Decoder(ConstByteSpan buffer)
-        : protobuf::StreamDecoder(reader_), reader_(buffer) {}
-
-    Status Read(ByteSpan message, PwpbMessageDescriptor table) {
-      return protobuf::StreamDecoder::Read(message, *table);
-    }
-
-   private:
-    stream::MemoryReader reader_;
-  };
-
   PwpbMessageDescriptor table_;
 };
 
@@ -29,6 +29,40 @@ namespace pw::transfer::internal {
 
 namespace ProtoChunk = transfer::pwpb::Chunk;
 
+namespace {
+
+// Parses a serialized Chunk.Range message. Missing offsets are zero.
+Result<Chunk::Range> ParseRange(ConstByteSpan message) {
+  protobuf::Decoder decoder(message);
+  Status status;
+  Chunk::Range range{0, 0};
+
+  while ((status = decoder.Next()).ok()) {
+    switch (static_cast<ProtoChunk::Range::Fields>(decoder.FieldNumber())) {
+      case ProtoChunk::Range::Fields::kStartOffset:
+        PW_TRY(decoder.ReadUint32(&range.start_offset));
+        break;
+      case ProtoChunk::Range::Fields::kEndOffset:
+        PW_TRY(decoder.ReadUint32(&range.end_offset));
+        break;
+    }
+  }
+
+  if (!status.IsOutOfRange()) {
+    return Status::DataLoss();
+  }
+  return range;
+}
+
+size_t RangeEncodedSize(const Chunk::Range& range) {
+  return protobuf::SizeOfVarintField(ProtoChunk::Range::Fields::kStartOffset,
+                                     range.start_offset) +
+         protobuf::SizeOfVarintField(ProtoChunk::Range::Fields::kEndOffset,
+                                     range.end_offset);
+}
+
+}  // namespace
+
 Result<Chunk::Identifier> Chunk::ExtractIdentifier(ConstByteSpan message) {
   protobuf::Decoder decoder(message);
 
@@ -193,6 +227,19 @@ Result<Chunk> Chunk::Parse(ConstByteSpan message) {
         chunk.set_initial_offset(value);
         break;
 
+      case ProtoChunk::Fields::kReceivedRanges: {
+        // Received ranges are advisory: any beyond those which fit in the
+        // chunk, or which are invalid, are dropped.
+        ConstByteSpan range_message;
+        PW_TRY(decoder.ReadBytes(&range_message));
+        PW_TRY_ASSIGN(const Range range, ParseRange(range_message));
+        if (range.start_offset < range.end_offset &&
+            chunk.num_received_ranges_ < chunk.received_ranges_.size()) {
+          chunk.received_ranges_[chunk.num_received_ranges_++] = range;
+        }
+        break;
+      }
+
         // Silently ignore any unrecognized fields.
     }
   }
@@ -306,6 +353,13 @@ Result<ConstByteSpan> Chunk::Encode(ByteSpan buffer) const {
     encoder.WriteStatus(status_.value().code()).IgnoreError();
   }
 
+  for (const Range& range : received_ranges()) {
+    ProtoChunk::Range::StreamEncoder range_encoder =
+        encoder.GetReceivedRangesEncoder();
+    range_encoder.WriteStartOffset(range.start_offset).IgnoreError();
+    range_encoder.WriteEndOffset(range.end_offset).IgnoreError();
+  }
+
   PW_TRY(encoder.status());
   return ConstByteSpan(encoder);
 }
@@ -392,6 +446,11 @@ size_t Chunk::EncodedSize() const {
                                         status_.value().code());
   }
 
+  for (const Range& range : received_ranges()) {
+    size += protobuf::SizeOfDelimitedField(ProtoChunk::Fields::kReceivedRanges,
+                                           RangeEncodedSize(range));
+  }
+
   return size;
 }
 
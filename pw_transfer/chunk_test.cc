@@ -14,6 +14,8 @@
 
 #include "pw_transfer/internal/chunk.h"
 
+#include <iterator>
+
 #include "pw_bytes/array.h"
 #include "pw_unit_test/framework.h"
 
@@ -62,5 +64,28 @@ TEST(Chunk, EncodedSizeMatchesBuffer) {
   EXPECT_EQ(chunk.EncodedSize(), result->size_bytes());
 }
 
+TEST(Chunk, ReceivedRanges_EncodeAndParse) {
+  constexpr Chunk::Range kRanges[] = {{16, 24}, {200, 4096}};
+  Chunk chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kParametersRetransmit);
+  chunk.set_session_id(42)
+      .set_offset(8)
+      .set_window_end_offset(4096)
+      .set_received_ranges(kRanges);
+
+  std::array<std::byte, 64> buffer;
+  auto result = chunk.Encode(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(chunk.EncodedSize(), result->size_bytes());
+
+  Result<Chunk> parsed = Chunk::Parse(*result);
+  ASSERT_EQ(parsed.status(), OkStatus());
+  ASSERT_EQ(parsed->received_ranges().size(), std::size(kRanges));
+  for (size_t i = 0; i < std::size(kRanges); ++i) {
+    EXPECT_EQ(parsed->received_ranges()[i].start_offset,
+              kRanges[i].start_offset);
+    EXPECT_EQ(parsed->received_ranges()[i].end_offset, kRanges[i].end_offset);
+  }
+}
+
 }  // namespace
 }  // namespace pw::transfer::internal
@@ -80,6 +80,15 @@ constexpr auto kData32 = bytes::Initialized<32>([](size_t i) { return i; });
 constexpr auto kData64 = bytes::Initialized<64>([](size_t i) { return i; });
 constexpr auto kData256 = bytes::Initialized<256>([](size_t i) { return i; });
 
+// Writes to a buffer without supporting seeking, so data received out of order
+// can't be held.
+class FakeNonSeekableWriter final : public stream::NonSeekableWriter {
+ private:
+  Status DoWrite(ConstByteSpan data) final { return writer_.Write(data); }
+
+  stream::MemoryWriterBuffer<64> writer_;
+};
+
 TEST_F(ReadTransfer, SingleChunk) {
   stream::MemoryWriterBuffer<64> writer;
   Status transfer_status = Status::Unknown();
@@ -589,7 +598,9 @@ TEST_F(ReadTransfer, ServerError) {
 }
 
 TEST_F(ReadTransfer, OnlySendsParametersOnceAfterDrop) {
-  stream::MemoryWriterBuffer<64> writer;
+  // The writer can't hold the data following the dropped chunk, so all of it
+  // must be retransmitted.
+  FakeNonSeekableWriter writer;
   Status transfer_status = Status::Unknown();
 
   ASSERT_EQ(
@@ -661,7 +672,7 @@ TEST_F(ReadTransfer, OnlySendsParametersOnceAfterDrop) {
 }
 
 TEST_F(ReadTransfer, ResendsParametersIfSentRepeatedChunkDuringRecovery) {
-  stream::MemoryWriterBuffer<64> writer;
+  FakeNonSeekableWriter writer;
   Status transfer_status = Status::Unknown();
 
   ASSERT_EQ(
@@ -753,6 +764,216 @@ TEST_F(ReadTransfer, ResendsParametersIfSentRepeatedChunkDuringRecovery) {
   EXPECT_EQ(transfer_status, OkStatus());
 }
 
+TEST_F(ReadTransferMaxBytes32, OutOfOrder_HoldsDataAndRequestsMissingData) {
+  stream::MemoryWriterBuffer<64> writer;
+  Status transfer_status = Status::Unknown();
+
+  ASSERT_EQ(
+      OkStatus(),
+      legacy_client_
+          .Read(12,
+                writer,
+                [&transfer_status](Status status) { transfer_status = status; })
+          .status());
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  rpc::PayloadsView payloads =
+      context_.output().payloads<Transfer::Read>(context_.channel().id());
+  ASSERT_EQ(payloads.size(), 1u);
+  ASSERT_EQ(DecodeChunk(payloads[0]).window_end_offset(), 32u);
+
+  constexpr ConstByteSpan data(kData32);
+
+  // Drop offset 8.
+  for (uint32_t offset : {0u, 16u}) {
+    context_.server().SendServerStream<Transfer::Read>(
+        EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                        .set_session_id(12)
+                        .set_offset(offset)
+                        .set_payload(data.subspan(offset, 8))));
+  }
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  // The dropped data is requested right away, along with the data held.
+  ASSERT_EQ(payloads.size(), 2u);
+
+  Chunk c1 = DecodeChunk(payloads[1]);
+  EXPECT_EQ(c1.type(), Chunk::Type::kParametersRetransmit);
+  EXPECT_EQ(c1.offset(), 8u);
+  EXPECT_EQ(c1.window_end_offset(), 40u);
+  ASSERT_EQ(c1.received_ranges().size(), 1u);
+  EXPECT_EQ(c1.received_ranges()[0].start_offset, 16u);
+  EXPECT_EQ(c1.received_ranges()[0].end_offset, 24u);
+
+  // Data still in flight from the window is held as well.
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(12)
+                      .set_offset(24)
+                      .set_payload(data.subspan(24, 8))));
+  transfer_thread_.WaitUntilEventIsProcessed();
+  ASSERT_EQ(payloads.size(), 2u);
+
+  // Receiving the dropped data skips over the data which was already held.
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(12)
+                      .set_offset(8)
+                      .set_payload(data.subspan(8, 8))));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(payloads.size(), 3u);
+
+  Chunk c2 = DecodeChunk(payloads[2]);
+  EXPECT_EQ(c2.type(), Chunk::Type::kParametersContinue);
+  EXPECT_EQ(c2.offset(), 32u);
+
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(12)
+                      .set_offset(32)
+                      .set_remaining_bytes(0)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(payloads.size(), 4u);
+
+  Chunk c3 = DecodeChunk(payloads[3]);
+  ASSERT_TRUE(c3.status().has_value());
+  EXPECT_EQ(c3.status().value(), OkStatus());
+
+  EXPECT_EQ(transfer_status, OkStatus());
+  ASSERT_EQ(writer.bytes_written(), data.size());
+  EXPECT_EQ(std::memcmp(writer.data(), data.data(), data.size()), 0);
+}
+
+TEST_F(ReadTransferMaxBytes32, OutOfOrder_TransmitterIgnoresReceivedRanges) {
+  stream::MemoryWriterBuffer<64> writer;
+  Status transfer_status = Status::Unknown();
+
+  ASSERT_EQ(
+      OkStatus(),
+      legacy_client_
+          .Read(13,
+                writer,
+                [&transfer_status](Status status) { transfer_status = status; })
+          .status());
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  rpc::PayloadsView payloads =
+      context_.output().payloads<Transfer::Read>(context_.channel().id());
+  ASSERT_EQ(payloads.size(), 1u);
+
+  constexpr ConstByteSpan data(kData32);
+
+  // Drop offset 8 and send the rest of the window.
+  for (uint32_t offset : {0u, 16u, 24u}) {
+    context_.server().SendServerStream<Transfer::Read>(
+        EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                        .set_session_id(13)
+                        .set_offset(offset)
+                        .set_payload(data.subspan(offset, 8))));
+  }
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(payloads.size(), 2u);
+  EXPECT_EQ(DecodeChunk(payloads[1]).offset(), 8u);
+
+  // A transmitter which doesn't support received ranges resends everything
+  // from the dropped offset. The data which was already held is dropped
+  // without requesting another retransmission.
+  for (uint32_t offset : {8u, 16u, 24u}) {
+    context_.server().SendServerStream<Transfer::Read>(
+        EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                        .set_session_id(13)
+                        .set_offset(offset)
+                        .set_payload(data.subspan(offset, 8))));
+  }
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(13)
+                      .set_offset(32)
+                      .set_remaining_bytes(0)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(payloads.size(), 4u);
+  EXPECT_EQ(DecodeChunk(payloads[2]).type(), Chunk::Type::kParametersContinue);
+
+  Chunk c3 = DecodeChunk(payloads[3]);
+  ASSERT_TRUE(c3.status().has_value());
+  EXPECT_EQ(c3.status().value(), OkStatus());
+
+  EXPECT_EQ(transfer_status, OkStatus());
+  ASSERT_EQ(writer.bytes_written(), data.size());
+  EXPECT_EQ(std::memcmp(writer.data(), data.data(), data.size()), 0);
+}
+
+TEST_F(ReadTransferMaxBytes32, OutOfOrder_DuplicateAfterCatchingUp) {
+  stream::MemoryWriterBuffer<64> writer;
+  Status transfer_status = Status::Unknown();
+
+  ASSERT_EQ(
+      OkStatus(),
+      legacy_client_
+          .Read(14,
+                writer,
+                [&transfer_status](Status status) { transfer_status = status; })
+          .status());
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  rpc::PayloadsView payloads =
+      context_.output().payloads<Transfer::Read>(context_.channel().id());
+  ASSERT_EQ(payloads.size(), 1u);
+
+  constexpr ConstByteSpan data(kData64);
+
+  // Drop offset 8, then receive it to skip over the data which was held.
+  for (uint32_t offset : {0u, 16u, 24u, 8u}) {
+    context_.server().SendServerStream<Transfer::Read>(
+        EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                        .set_session_id(14)
+                        .set_offset(offset)
+                        .set_payload(data.subspan(offset, 8))));
+  }
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(payloads.size(), 3u);
+  EXPECT_EQ(DecodeChunk(payloads[2]).offset(), 32u);
+
+  // The transmitter continues past the data which was skipped.
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(14)
+                      .set_offset(32)
+                      .set_payload(data.subspan(32, 8))));
+  transfer_thread_.WaitUntilEventIsProcessed();
+  const size_t num_payloads = payloads.size();
+
+  // Data from before the skipped range is now a duplicate rather than resent
+  // data, so the receiver responds with its current parameters.
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(14)
+                      .set_offset(16)
+                      .set_payload(data.subspan(16, 8))));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(payloads.size(), num_payloads + 1);
+  Chunk duplicate_response = DecodeChunk(payloads.back());
+  EXPECT_EQ(duplicate_response.type(), Chunk::Type::kParametersContinue);
+  EXPECT_EQ(duplicate_response.offset(), 40u);
+
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(14)
+                      .set_offset(40)
+                      .set_remaining_bytes(0)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  EXPECT_EQ(transfer_status, OkStatus());
+  ASSERT_EQ(writer.bytes_written(), 40u);
+  EXPECT_EQ(std::memcmp(writer.data(), data.data(), 40), 0);
+}
+
 // Use a long timeout to avoid accidentally triggering timeouts.
 constexpr chrono::SystemClock::duration kTestTimeout = std::chrono::seconds(30);
 constexpr uint8_t kTestRetries = 3;
@@ -1342,6 +1563,63 @@ TEST_F(WriteTransfer, OutOfOrder_SeekNotSupported) {
   EXPECT_EQ(transfer_status, Status::Unimplemented());
 }
 
+TEST_F(WriteTransfer, OutOfOrder_SkipsReceivedRanges) {
+  stream::MemoryReader reader(kData32);
+  Status transfer_status = Status::Unknown();
+
+  ASSERT_EQ(OkStatus(),
+            legacy_client_
+                .Write(6,
+                       reader,
+                       [&transfer_status](Status status) {
+                         transfer_status = status;
+                       })
+                .status());
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  rpc::PayloadsView payloads =
+      context_.output().payloads<Transfer::Write>(context_.channel().id());
+  ASSERT_EQ(payloads.size(), 1u);
+
+  // Request a retransmission from offset 8 from a receiver which already holds
+  // the data from 16 to 24. Only the missing data should be sent, followed by
+  // the final chunk.
+  constexpr Chunk::Range kReceived[] = {{16, 24}};
+  rpc::test::WaitForPackets(context_.output(), 3, [this, &kReceived] {
+    context_.server().SendServerStream<Transfer::Write>(EncodeChunk(
+        Chunk(ProtocolVersion::kLegacy, Chunk::Type::kParametersRetransmit)
+            .set_session_id(6)
+            .set_offset(8)
+            .set_window_end_offset(64)
+            .set_max_chunk_size_bytes(16)
+            .set_received_ranges(kReceived)));
+  });
+
+  ASSERT_EQ(payloads.size(), 4u);
+
+  Chunk c1 = DecodeChunk(payloads[1]);
+  EXPECT_EQ(c1.offset(), 8u);
+  ASSERT_EQ(c1.payload().size(), 8u);
+  EXPECT_EQ(std::memcmp(c1.payload().data(), kData32.data() + 8, 8), 0);
+
+  Chunk c2 = DecodeChunk(payloads[2]);
+  EXPECT_EQ(c2.offset(), 24u);
+  ASSERT_EQ(c2.payload().size(), 8u);
+  EXPECT_EQ(std::memcmp(c2.payload().data(), kData32.data() + 24, 8), 0);
+
+  Chunk c3 = DecodeChunk(payloads[3]);
+  EXPECT_EQ(c3.offset(), 32u);
+  ASSERT_TRUE(c3.remaining_bytes().has_value());
+  EXPECT_EQ(c3.remaining_bytes().value(), 0u);
+
+  context_.server().SendServerStream<Transfer::Write>(
+      EncodeChunk(Chunk::Final(ProtocolVersion::kLegacy, 6, OkStatus())));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  EXPECT_EQ(payloads.size(), 4u);
+  EXPECT_EQ(transfer_status, OkStatus());
+}
+
 TEST_F(WriteTransfer, ServerError) {
   stream::MemoryReader reader(kData32);
   Status transfer_status = Status::Unknown();
@@ -17,7 +17,9 @@
 
 #include "pw_transfer/internal/context.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <limits>
 
 #include "pw_assert/check.h"
@@ -27,6 +29,7 @@
 #include "pw_preprocessor/compiler.h"
 #include "pw_protobuf/serialized_size.h"
 #include "pw_transfer/internal/config.h"
+#include "pw_transfer/stream_io_worker.h"
 #include "pw_transfer/transfer.pwpb.h"
 #include "pw_transfer/transfer_thread.h"
 #include "pw_varint/varint.h"
@@ -104,6 +107,7 @@ void Context::HandleEvent(const Event& event) {
 void Context::InitiateTransferAsClient() {
   PW_DCHECK(active());
 
+  OpenAsyncStream();
   SetTimeout(initial_chunk_timeout_);
 
   PW_LOG_INFO("Starting transfer for resource %u",
@@ -179,6 +183,7 @@ bool Context::StartTransferAsServer(const NewTransferEvent& new_transfer) {
   // Server transfers use the stream provided by the handler rather than the
   // stream included in the NewTransferEvent.
   stream_ = &new_transfer.handler->stream();
+  OpenAsyncStream();
 
   return true;
 }
@@ -250,6 +255,14 @@ void Context::UpdateTransferParameters(TransmitAction action) {
 
   window_size_ = window_size;
   window_end_offset_ = offset_ + window_size;
+
+  // Data received out of order was within the previous window. Keep it within
+  // the new one so that the transmitter can skip it.
+  if (num_received_ranges_ > 0) {
+    window_end_offset_ =
+        std::max(window_end_offset_,
+                 received_ranges_[num_received_ranges_ - 1].end_offset);
+  }
 }
 
 void Context::SetTransferParameters(Chunk& parameters) {
@@ -285,6 +298,10 @@ void Context::SendTransferParameters(TransmitAction action) {
   parameters.set_session_id(session_id_);
   SetTransferParameters(parameters);
 
+  if (type == Chunk::Type::kParametersRetransmit) {
+    parameters.set_received_ranges(received_ranges());
+  }
+
   PW_LOG_EVERY_N_DURATION(
       PW_LOG_LEVEL_INFO,
       log_rate_limit_,
@@ -383,6 +400,7 @@ void Context::Initialize(const NewTransferEvent& new_transfer) {
 
   rpc_writer_ = new_transfer.rpc_writer;
   stream_ = new_transfer.stream;
+  async_stream_ = nullptr;
 
   offset_ = new_transfer.initial_offset;
   initial_offset_ = new_transfer.initial_offset;
@@ -398,6 +416,8 @@ void Context::Initialize(const NewTransferEvent& new_transfer) {
 
   last_chunk_sent_ = Chunk::Type::kStart;
   last_chunk_offset_ = 0;
+  num_received_ranges_ = 0;
+  out_of_order_start_offset_ = kNoOutOfOrderData;
   chunk_timeout_ = new_transfer.timeout;
   initial_chunk_timeout_ = new_transfer.initial_timeout;
   interchunk_delay_ = chrono::SystemClock::for_at_least(
@@ -651,6 +671,14 @@ void Context::HandleTransferParametersUpdate(const Chunk& chunk) {
     }
 
     offset_ = chunk.offset();
+
+    // Only the data which the receiver doesn't already hold is resent.
+    num_received_ranges_ = 0;
+    for (const Chunk::Range& range : chunk.received_ranges()) {
+      if (!AddReceivedRange(range.start_offset, range.end_offset)) {
+        break;
+      }
+    }
   } else if (chunk.window_end_offset() <= offset_) {
     PW_LOG_DEBUG("Transfer %u ignoring old rolling window chunk", id_for_log());
     SetTimeout(chunk_timeout_);
@@ -694,6 +722,19 @@ void Context::HandleTransferParametersUpdate(const Chunk& chunk) {
 }
 
 void Context::TransmitNextChunk(bool retransmit_requested) {
+  const uint32_t previous_offset = offset_;
+  if (!SkipReceivedRanges()) {
+    // The reader can't skip the data which the receiver holds; resend it.
+    num_received_ranges_ = 0;
+  }
+
+  if (offset_ != previous_offset && offset_ == window_end_offset_) {
+    // The receiver already holds the rest of the window.
+    set_transfer_state(TransferState::kWaiting);
+    SetTimeout(chunk_timeout_);
+    return;
+  }
+
   Chunk chunk(configured_protocol_version_, Chunk::Type::kData);
   chunk.set_session_id(session_id_);
   chunk.set_offset(offset_);
@@ -718,6 +759,12 @@ void Context::TransmitNextChunk(bool retransmit_requested) {
     size_t max_bytes_to_send =
         std::min(window_end_offset_ - offset_, max_chunk_size_bytes_);
 
+    // Stop at the next range of data which the receiver holds.
+    if (num_received_ranges_ > 0) {
+      max_bytes_to_send = std::min<size_t>(
+          max_bytes_to_send, received_ranges_[0].start_offset - offset_);
+    }
+
     if (max_bytes_to_send < data_buffer.size()) {
       data_buffer = data_buffer.first(max_bytes_to_send);
     }
@@ -842,6 +889,10 @@ void Context::HandleReceiveChunk(const Chunk& chunk) {
       PW_UNREACHABLE;
 
     case TransferState::kRecovery:
+      if (chunk.offset() > offset_ && HandleOutOfOrderData(chunk)) {
+        return;
+      }
+
       if (chunk.offset() != offset_) {
         if (last_chunk_offset_ == chunk.offset()) {
           PW_LOG_DEBUG(
@@ -887,8 +938,20 @@ void Context::HandleReceiveChunk(const Chunk& chunk) {
 
 void Context::HandleReceivedData(const Chunk& chunk) {
   if (chunk.offset() != offset_) {
+    if (chunk.offset() > offset_ && HandleOutOfOrderData(chunk)) {
+      return;
+    }
+
     if (chunk.offset() + chunk.payload().size() <= offset_ &&
-        chunk.type() != Chunk::Type::kStartAckConfirmation) {
+        chunk.offset() >= out_of_order_start_offset_) {
+      // The transmitter ignored the received ranges and is resending data
+      // which was received out of order. It will catch up once it has resent
+      // them, so there is no need to shrink the window.
+      PW_LOG_DEBUG("Transfer %u dropping resent chunk with offset %u",
+                   id_for_log(),
+                   static_cast<unsigned>(chunk.offset()));
+    } else if (chunk.offset() + chunk.payload().size() <= offset_ &&
+               chunk.type() != Chunk::Type::kStartAckConfirmation) {
       // If the chunk's data has already been received, don't go through a full
       // recovery cycle to avoid shrinking the window size and potentially
       // thrashing. The expected data may already be in-flight, so just allow
@@ -966,6 +1029,19 @@ void Context::HandleReceivedData(const Chunk& chunk) {
   // Update the transfer state.
   offset_ += chunk.payload().size();
 
+  // The transmitter has caught up past any data which was skipped, so earlier
+  // data received from now on is duplicated rather than resent.
+  out_of_order_start_offset_ = kNoOutOfOrderData;
+
+  // Skip over the data which was already written out of order.
+  if (num_received_ranges_ > 0 && received_ranges_[0].start_offset <= offset_) {
+    out_of_order_start_offset_ = offset_;
+    if (!SkipReceivedRanges()) {
+      TerminateTransfer(Status::DataLoss());
+      return;
+    }
+  }
+
   // When the client sets remaining_bytes to 0, it indicates completion of the
   // transfer. Acknowledge the completion through a status chunk and clean up.
   if (chunk.IsFinalTransmitChunk()) {
@@ -1026,6 +1102,148 @@ void Context::HandleReceivedData(const Chunk& chunk) {
   }
 }
 
+bool Context::HandleOutOfOrderData(const Chunk& chunk) {
+  if (cfg::kMaxReceivedRanges == 0 ||
+      !writer().seekable(stream::Stream::kCurrent)) {
+    return false;
+  }
+
+  const uint32_t end_offset =
+      chunk.offset() + static_cast<uint32_t>(chunk.payload().size());
+
+  // The final chunk is not held, as the transfer ends as soon as it is written.
+  if (chunk.type() == Chunk::Type::kData && chunk.has_payload() &&
+      !chunk.IsFinalTransmitChunk() && end_offset <= window_end_offset_ &&
+      writer()
+          .Seek(static_cast<ptrdiff_t>(chunk.offset() - offset_),
+                stream::Stream::kCurrent)
+          .ok()) {
+    Status status = writer().Write(chunk.payload());
+    if (status.ok()) {
+      status = writer().Seek(-static_cast<ptrdiff_t>(end_offset - offset_),
+                             stream::Stream::kCurrent);
+    }
+    if (!status.ok()) {
+      PW_LOG_ERROR(
+          "Transfer %u write of %u B chunk at offset %u failed with status %u; "
+          "aborting with DATA_LOSS",
+          id_for_log(),
+          static_cast<unsigned>(chunk.payload().size()),
+          static_cast<unsigned>(chunk.offset()),
+          status.code());
+      TerminateTransfer(Status::DataLoss());
+      return true;
+    }
+
+    // If there is no room to record the range, the data is resent and
+    // written again.
+    if (AddReceivedRange(chunk.offset(), end_offset)) {
+      transfer_rate_.Update(chunk.payload().size());
+    }
+  } else if (num_received_ranges_ == 0) {
+    return false;
+  }
+
+  if (transfer_state_ != TransferState::kRecovery) {
+    PW_LOG_WARN(
+        "Transfer %u expected offset %u, received %u; entering recovery "
+        "state and holding data received out of order",
+        id_for_log(),
+        static_cast<unsigned>(offset_),
+        static_cast<unsigned>(chunk.offset()));
+    set_transfer_state(TransferState::kRecovery);
+
+    // Request the missing data right away, as when no data is held. The
+    // request lists the data held so far, which the transmitter skips.
+    UpdateAndSendTransferParameters(TransmitAction::kRetransmit);
+    if (DataTransferComplete()) {
+      return true;
+    }
+  } else if (last_chunk_offset_ == chunk.offset()) {
+    PW_LOG_DEBUG(
+        "Transfer %u received repeated offset %u; retry detected, "
+        "resending transfer parameters",
+        id_for_log(),
+        static_cast<unsigned>(chunk.offset()));
+    UpdateAndSendTransferParameters(TransmitAction::kRetransmit);
+    if (DataTransferComplete()) {
+      return true;
+    }
+  }
+
+  last_chunk_offset_ = chunk.offset();
+  SetTimeout(chunk_timeout_);
+  return true;
+}
+
+bool Context::AddReceivedRange(uint32_t start_offset, uint32_t end_offset) {
+  // Find the ranges which overlap or adjoin the new one.
+  size_t first = 0;
+  while (first < num_received_ranges_ &&
+         received_ranges_[first].end_offset < start_offset) {
+    ++first;
+  }
+  size_t last = first;
+  while (last < num_received_ranges_ &&
+         received_ranges_[last].start_offset <= end_offset) {
+    start_offset = std::min(start_offset, received_ranges_[last].start_offset);
+    end_offset = std::max(end_offset, received_ranges_[last].end_offset);
+    ++last;
+  }
+
+  if (first == last) {
+    if (num_received_ranges_ == received_ranges_.size()) {
+      return false;
+    }
+    std::move_backward(received_ranges_.begin() + first,
+                       received_ranges_.begin() + num_received_ranges_,
+                       received_ranges_.begin() + num_received_ranges_ + 1);
+    ++num_received_ranges_;
+  } else {
+    // Merge the ranges into the first.
+    std::move(received_ranges_.begin() + last,
+              received_ranges_.begin() + num_received_ranges_,
+              received_ranges_.begin() + first + 1);
+    num_received_ranges_ -= static_cast<uint8_t>(last - first - 1);
+  }
+
+  received_ranges_[first] = {start_offset, end_offset};
+  return true;
+}
+
+void Context::PopReceivedRange() {
+  std::move(received_ranges_.begin() + 1,
+            received_ranges_.begin() + num_received_ranges_,
+            received_ranges_.begin());
+  --num_received_ranges_;
+}
+
+bool Context::SkipReceivedRanges() {
+  while (num_received_ranges_ > 0 &&
+         received_ranges_[0].start_offset <= offset_) {
+    const uint32_t end_offset = received_ranges_[0].end_offset;
+
+    if (end_offset > offset_) {
+      const Status status =
+          type() == TransferType::kReceive
+              ? writer().Seek(static_cast<ptrdiff_t>(end_offset - offset_),
+                              stream::Stream::kCurrent)
+              : SeekReader(end_offset);
+      if (!status.ok()) {
+        PW_LOG_WARN("Transfer %u seek to %u failed with status %u",
+                    id_for_log(),
+                    static_cast<unsigned>(end_offset),
+                    status.code());
+        return false;
+      }
+      offset_ = end_offset;
+    }
+
+    PopReceivedRange();
+  }
+  return true;
+}
+
 void Context::HandleTerminatingChunk(const Chunk& chunk) {
   switch (chunk.type()) {
     case Chunk::Type::kCompletion:
@@ -1128,12 +1346,50 @@ void Context::SendFinalStatusChunk(bool with_resource_id) {
 void Context::Finish(Status status) {
   PW_DCHECK(active());
 
+  status.Update(CloseAsyncStream());
   status.Update(FinalCleanup(status));
   status_ = status;
 
   SetTimeout(kFinalChunkAckTimeout);
 }
 
+void Context::OpenAsyncStream() {
+  StreamIoWorker* worker = thread_->stream_io_worker_;
+  if (worker == nullptr) {
+    return;
+  }
+
+  async_stream_ = worker->Open(*stream_, type());
+  if (async_stream_ == nullptr) {
+    PW_LOG_DEBUG(
+        "Transfer %u: all stream I/O buffers are in use; doing I/O on the "
+        "transfer thread",
+        id_for_log());
+    return;
+  }
+  stream_ = async_stream_;
+}
+
+Status Context::CloseAsyncStream() {
+  if (async_stream_ == nullptr) {
+    return OkStatus();
+  }
+
+  stream_ = &async_stream_->stream();
+  const Status status = async_stream_->Close();
+  async_stream_ = nullptr;
+
+  if (!status.ok()) {
+    PW_LOG_ERROR(
+        "Transfer %u buffered write failed with status %u; aborting with "
+        "DATA_LOSS",
+        id_for_log(),
+        status.code());
+    return Status::DataLoss();
+  }
+  return OkStatus();
+}
+
 void Context::SetTimeout(chrono::SystemClock::duration timeout) {
   next_timeout_ = chrono::SystemClock::TimePointAfterAtLeast(timeout);
 }
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+# Copyright 2026 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Cross-language pw_transfer tests over a lossy channel.
+
+Each test logs its goodput: the number of bytes transferred per second of wall
+time, including the time spent recovering from lost chunks. Receivers with a
+seekable stream report the data they already have when requesting a
+retransmission, so that senders which support it resend only lost chunks.
+
+Usage:
+
+   bazel run pw_transfer/integration_test:lossy_channel_test
+
+Command-line arguments must be provided after a double-dash:
+
+   bazel run pw_transfer/integration_test:lossy_channel_test -- \
+       --server-port 3318
+
+Which tests to run can be specified as command-line arguments:
+
+  bazel run pw_transfer/integration_test:lossy_channel_test -- \
+      LossyChannelIntegrationTest.test_lossy_write_0_cpp
+
+"""
+
+import logging
+import random
+import sys
+import time
+
+from google.protobuf import text_format
+from parameterized import parameterized
+
+from pw_transfer.integration_test import config_pb2
+from pw_transfer.integration_test import test_fixture
+from test_fixture import TransferIntegrationTestHarness, TransferConfig
+
+_LOG = logging.getLogger('pw_transfer_lossy_channel_test')
+_LOG.level = logging.INFO
+_LOG.addHandler(logging.StreamHandler(sys.stdout))
+
+_PAYLOAD_SIZE = 64 * 1024
+
+
+class LossyChannelIntegrationTest(test_fixture.TransferIntegrationTest):
+    # Each set of transfer tests uses a different client/server port pair to
+    # allow tests to be run in parallel.
+    HARNESS_CONFIG = TransferIntegrationTestHarness.Config(
+        server_port=3318, client_port=3319
+    )
+
+    @staticmethod
+    def _lossy_config(drop_rate: float) -> TransferConfig:
+        """Returns a config which drops `drop_rate` of packets each way."""
+        proxy_config = text_format.Parse(
+            f"""
+            client_filter_stack: [
+                {{ rate_limiter: {{rate: 200000}} }},
+                {{ hdlc_packetizer: {{}} }},
+                {{ data_dropper: {{rate: {drop_rate}, seed: 2913408151}} }}
+            ]
+
+            server_filter_stack: [
+                {{ rate_limiter: {{rate: 200000}} }},
+                {{ hdlc_packetizer: {{}} }},
+                {{ data_dropper: {{rate: {drop_rate}, seed: 2913408152}} }}
+            ]""",
+            config_pb2.ProxyConfig(),
+        )
+        server_config = LossyChannelIntegrationTest.default_server_config()
+        # Short timeouts, so that goodput reflects the data resent after a loss
+        # more than the time taken to detect it.
+        server_config.chunk_timeout_seconds = 1
+        client_config = LossyChannelIntegrationTest.default_client_config()
+        client_config.chunk_timeout_ms = 1000
+        return TransferConfig(server_config, client_config, proxy_config)
+
+    def _log_goodput(
+        self, direction: str, client_type: str, drop_rate: float, start: float
+    ) -> None:
+        elapsed = time.monotonic() - start
+        _LOG.info(
+            '%s client %s, %.0f%% loss: %d bytes in %.2f s, %.0f B/s goodput',
+            client_type,
+            direction,
+            drop_rate * 100,
+            _PAYLOAD_SIZE,
+            elapsed,
+            _PAYLOAD_SIZE / elapsed,
+        )
+
+    @parameterized.expand(
+        [
+            ("cpp"),
+            ("java"),
+            ("python"),
+        ]
+    )
+    def test_lossy_write(self, client_type):
+        drop_rate = 0.02
+        payload = random.Random(2913408153).randbytes(_PAYLOAD_SIZE)
+        config = self._lossy_config(drop_rate)
+        start = time.monotonic()
+        self.do_single_write(
+            client_type,
+            config,
+            resource_id=18,
+            data=payload,
+            permanent_resource_id=True,
+        )
+        self._log_goodput('write', client_type, drop_rate, start)
+
+    @parameterized.expand(
+        [
+            ("cpp"),
+            ("java"),
+            ("python"),
+        ]
+    )
+    def test_lossy_read(self, client_type):
+        drop_rate = 0.02
+        payload = random.Random(2913408154).randbytes(_PAYLOAD_SIZE)
+        config = self._lossy_config(drop_rate)
+        start = time.monotonic()
+        self.do_single_read(
+            client_type,
+            config,
+            resource_id=19,
+            data=payload,
+            permanent_resource_id=True,
+        )
+        self._log_goodput('read', client_type, drop_rate, start)
+
+
+if __name__ == '__main__':
+    test_fixture.run_tests_for(LossyChannelIntegrationTest)
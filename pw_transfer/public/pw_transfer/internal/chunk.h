@@ -13,11 +13,15 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <optional>
 
 #include "pw_bytes/span.h"
 #include "pw_chrono/system_clock.h"
 #include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_transfer/internal/config.h"
 #include "pw_transfer/internal/protocol.h"
 #include "pw_transfer/transfer.pwpb.h"
 
@@ -27,6 +31,13 @@ class Chunk {
  public:
   using Type = transfer::pwpb::Chunk::Type;
 
+  // A range of transfer data, from start_offset up to but not including
+  // end_offset.
+  struct Range {
+    uint32_t start_offset;
+    uint32_t end_offset;
+  };
+
   class Identifier {
    public:
     constexpr bool is_session() const { return type_ == kSession; }
@@ -150,6 +161,19 @@ class Chunk {
     return *this;
   }
 
+  // Sets the ranges of data following the offset which the receiver holds.
+  // Ranges beyond the first cfg::kMaxReceivedRanges are dropped.
+  constexpr Chunk& set_received_ranges(span<const Range> ranges) {
+    num_received_ranges_ = 0;
+    for (const Range& range : ranges) {
+      if (num_received_ranges_ == received_ranges_.size()) {
+        break;
+      }
+      received_ranges_[num_received_ranges_++] = range;
+    }
+    return *this;
+  }
+
   // TODO(frolv): For some reason, the compiler complains if this setter is
   // marked constexpr. Leaving it off for now, but this should be investigated
   // and fixed.
@@ -227,6 +251,10 @@ class Chunk {
 
   constexpr uint32_t initial_offset() const { return initial_offset_; }
 
+  constexpr span<const Range> received_ranges() const {
+    return span(received_ranges_).first(num_received_ranges_);
+  }
+
   // Returns true if this parameters chunk is requesting that the transmitter
   // transmit from its set offset instead of simply ACKing.
   constexpr bool RequestsTransmissionFromOffset() const {
@@ -279,7 +307,9 @@ class Chunk {
         remaining_bytes_(std::nullopt),
         status_(std::nullopt),
         type_(type),
-        protocol_version_(version) {}
+        protocol_version_(version),
+        received_ranges_{},
+        num_received_ranges_(0) {}
 
   constexpr Chunk() : Chunk(ProtocolVersion::kUnknown, std::nullopt) {}
 
@@ -308,6 +338,8 @@ class Chunk {
   std::optional<Status> status_;
   std::optional<Type> type_;
   ProtocolVersion protocol_version_;
+  std::array<Range, cfg::kMaxReceivedRanges> received_ranges_;
+  uint8_t num_received_ranges_;
 };
 
 }  // namespace pw::transfer::internal
@@ -17,6 +17,7 @@
 
 #include <chrono>
 #include <cinttypes>
+#include <cstddef>
 #include <limits>
 
 #include "pw_chrono/system_clock.h"
@@ -168,6 +169,18 @@ static_assert(PW_TRANSFER_DEFAULT_INITIAL_TIMEOUT_MS > 0);
 
 static_assert(PW_TRANSFER_DEFAULT_EXTEND_WINDOW_DIVISOR > 1);
 
+// The maximum number of ranges of data received out of order which a receive
+// transfer holds and reports to the transmitter, so that only lost data is
+// resent. Data is only received out of order when the transfer's writer is
+// seekable. Setting this to 0 disables out of order reception, in which case
+// all data following a lost chunk is resent.
+#ifndef PW_TRANSFER_MAX_RECEIVED_RANGES
+#define PW_TRANSFER_MAX_RECEIVED_RANGES 4
+#endif  // PW_TRANSFER_MAX_RECEIVED_RANGES
+
+static_assert(PW_TRANSFER_MAX_RECEIVED_RANGES <=
+              std::numeric_limits<uint8_t>::max());
+
 // Number of chunks to send repetitative logs at full rate before reducing to
 // rate_limit. Retransmit parameter chunks will restart at this chunk count
 // limit.
@@ -223,6 +236,8 @@ inline constexpr chrono::SystemClock::duration kDefaultInitialChunkTimeout =
 inline constexpr uint32_t kDefaultExtendWindowDivisor =
     PW_TRANSFER_DEFAULT_EXTEND_WINDOW_DIVISOR;
 
+inline constexpr size_t kMaxReceivedRanges = PW_TRANSFER_MAX_RECEIVED_RANGES;
+
 inline constexpr uint16_t kLogDefaultChunksBeforeRateLimit =
     PW_TRANSFER_LOG_DEFAULT_CHUNKS_BEFORE_RATE_LIMIT;
 inline constexpr chrono::SystemClock::duration kLogDefaultRateLimit =
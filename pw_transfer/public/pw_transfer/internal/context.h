@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <array>
 #include <cinttypes>
 #include <cstddef>
 #include <limits>
@@ -31,6 +32,7 @@
 
 namespace pw::transfer::internal {
 
+class AsyncStream;
 class TransferThread;
 
 class TransferParameters {
@@ -131,6 +133,7 @@ class Context {
         lifetime_retries_(0),
         max_lifetime_retries_(0),
         stream_(nullptr),
+        async_stream_(nullptr),
         rpc_writer_(nullptr),
         offset_(0),
         window_size_(0),
@@ -142,6 +145,9 @@ class Context {
         thread_(nullptr),
         last_chunk_sent_(Chunk::Type::kData),
         last_chunk_offset_(0),
+        received_ranges_{},
+        num_received_ranges_(0),
+        out_of_order_start_offset_(kNoOutOfOrderData),
         chunk_timeout_(chrono::SystemClock::duration::zero()),
         initial_chunk_timeout_(chrono::SystemClock::duration::zero()),
         interchunk_delay_(chrono::SystemClock::for_at_least(
@@ -309,6 +315,31 @@ class Context {
   // Processes a data chunk in a received while in the kWaiting state.
   void HandleReceivedData(const Chunk& chunk);
 
+  // In a receive transfer, writes a data chunk following the current offset to
+  // the writer and records it as a received range. Requests retransmission of
+  // the missing data when entering the recovery state, listing the ranges
+  // received so far. Returns false if the chunk was not handled, in which case
+  // all data from the current offset must be retransmitted.
+  bool HandleOutOfOrderData(const Chunk& chunk);
+
+  // Records that the data from start_offset to end_offset was received,
+  // merging it with any adjacent received ranges. Returns false if there is
+  // no room for another range.
+  bool AddReceivedRange(uint32_t start_offset, uint32_t end_offset);
+
+  // Removes the first received range.
+  void PopReceivedRange();
+
+  // Advances the offset past the received ranges which it has reached. In a
+  // receive transfer, seeks the writer past the data which was written out of
+  // order; in a transmit transfer, seeks the reader past the data which the
+  // receiver already has. Returns false if seeking failed.
+  bool SkipReceivedRanges();
+
+  span<const Chunk::Range> received_ranges() const {
+    return span(received_ranges_).first(num_received_ranges_);
+  }
+
   // Sends the first chunk in a legacy transmit transfer.
   void SendInitialLegacyTransmitChunk();
 
@@ -352,6 +383,14 @@ class Context {
   // is called.
   void Finish(Status status);
 
+  // If the transfer thread has a StreamIoWorker, moves the I/O of stream_ to
+  // it.
+  void OpenAsyncStream();
+
+  // Waits for the StreamIoWorker to finish the transfer's I/O, then returns the
+  // stream to stream_. Returns DATA_LOSS if writing the stream failed.
+  Status CloseAsyncStream();
+
   // Encodes the specified chunk to the encode buffer and sends it with the
   // rpc_writer_. Calls Finish() with an error if the operation fails.
   void EncodeAndSendChunk(const Chunk& chunk);
@@ -388,6 +427,9 @@ class Context {
   static constexpr chrono::SystemClock::duration kNoRateLimit =
       chrono::SystemClock::duration::zero();
 
+  static constexpr uint32_t kNoOutOfOrderData =
+      std::numeric_limits<uint32_t>::max();
+
   uint32_t session_id_;
   uint32_t resource_id_;
 
@@ -407,6 +449,11 @@ class Context {
 
   // The stream from which to read or to which to write data.
   stream::Stream* stream_;
+
+  // Does the I/O of the transfer's stream on the transfer thread's
+  // StreamIoWorker, if it has one. stream_ points to it while set.
+  AsyncStream* async_stream_;
+
   rpc::Writer* rpc_writer_;
 
   uint32_t offset_;
@@ -427,6 +474,18 @@ class Context {
     uint32_t last_chunk_offset_;  // Used in states kWaiting and kRecovery.
   };
 
+  // Ranges of data following offset_ which the receiver holds, in increasing
+  // order. In a receive transfer, this is data which was written out of order;
+  // in a transmit transfer, it is data which is not resent.
+  std::array<Chunk::Range, cfg::kMaxReceivedRanges> received_ranges_;
+  uint8_t num_received_ranges_;
+
+  // In a receive transfer, the offset at which received ranges were last
+  // skipped, or kNoOutOfOrderData. Transmitters which ignore received ranges
+  // resend the data following it, which is dropped without shrinking the
+  // window.
+  uint32_t out_of_order_start_offset_;
+
   // How long to wait for a chunk from the other end.
   chrono::SystemClock::duration chunk_timeout_;
 
@@ -0,0 +1,201 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_stream/stream.h"
+#include "pw_sync/counting_semaphore.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/thread_core.h"
+#include "pw_transfer/internal/event.h"
+
+namespace pw::transfer {
+namespace internal {
+
+class StreamIoWorker;
+
+// Stands in for the stream of a transfer whose reads or writes are done by a
+// StreamIoWorker. In a read transfer, the worker reads ahead of the transfer
+// into a buffer. In a write transfer, writes are copied into the buffer and the
+// worker writes them to the stream behind the transfer.
+//
+// Reads wait only if the worker has not yet read the data, and writes only if
+// the buffer is full. Seeks and limit queries wait for the worker to finish
+// the I/O in progress, then use the stream from the calling thread. Seeks
+// within data that has already been read ahead do not touch the stream.
+//
+// Errors from write-behind are returned from the next Write() or Seek() call,
+// and from Close().
+class AsyncStream final : public stream::SeekableReaderWriter {
+ public:
+  AsyncStream() = default;
+
+  AsyncStream(const AsyncStream&) = delete;
+  AsyncStream& operator=(const AsyncStream&) = delete;
+
+  void set_buffer(ByteSpan buffer) { buffer_ = buffer; }
+
+  // Starts doing the I/O of a transfer on `stream` with `worker`. Returns false
+  // if the AsyncStream is already in use.
+  bool Open(StreamIoWorker& worker, stream::Stream& stream, TransferType type)
+      PW_LOCKS_EXCLUDED(mutex_);
+
+  // Waits for buffered writes to be written to the stream and for any I/O in
+  // progress to finish, then releases the stream. Returns the first error from
+  // writing the stream.
+  Status Close() PW_LOCKS_EXCLUDED(mutex_);
+
+  // The stream whose I/O this does. Only valid while open, and only called by
+  // the thread that opened the AsyncStream.
+  stream::Stream& stream() const { return *stream_; }
+
+ private:
+  friend class StreamIoWorker;
+
+  enum class Mode : uint8_t { kClosed, kRead, kWrite };
+
+  // Called by the worker. Does the next read or write of the stream, if it has
+  // one to do. Returns true if it did I/O.
+  bool DoNextIo() PW_LOCKS_EXCLUDED(mutex_);
+
+  StatusWithSize DoRead(ByteSpan destination) override
+      PW_LOCKS_EXCLUDED(mutex_);
+  Status DoWrite(ConstByteSpan data) override PW_LOCKS_EXCLUDED(mutex_);
+  Status DoSeek(ptrdiff_t offset, Whence origin) override
+      PW_LOCKS_EXCLUDED(mutex_);
+  size_t DoTell() override PW_LOCKS_EXCLUDED(mutex_);
+  size_t ConservativeLimit(LimitType type) const override;
+
+  size_t GetLimit(LimitType type) PW_LOCKS_EXCLUDED(mutex_);
+
+  // Stops the worker from starting new I/O and waits for the I/O in progress to
+  // finish. If `flush` is true, first waits for buffered writes to be written.
+  void Pause(bool flush) PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Releases the mutex while waiting for the worker to do I/O.
+  void WaitForWorker() PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Drops `size` bytes from the front of the buffer.
+  void Discard(size_t size) PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  StreamIoWorker* worker_ = nullptr;
+  ByteSpan buffer_;
+
+  sync::Mutex mutex_;
+
+  // Signaled by the worker after each read or write.
+  sync::ThreadNotification io_done_;
+
+  // Set with mutex_ held by the thread that opens and closes the AsyncStream,
+  // which may read it without the mutex.
+  stream::Stream* stream_ = nullptr;
+  Mode mode_ PW_GUARDED_BY(mutex_) = Mode::kClosed;
+
+  // The buffered data starts at head_ and wraps around the end of buffer_.
+  size_t head_ PW_GUARDED_BY(mutex_) = 0;
+  size_t size_ PW_GUARDED_BY(mutex_) = 0;
+
+  // Position of the transfer in the stream, or kUnknownPosition.
+  size_t position_ PW_GUARDED_BY(mutex_) = kUnknownPosition;
+
+  // Error from the worker's I/O. OUT_OF_RANGE at the end of a read stream.
+  Status status_ PW_GUARDED_BY(mutex_);
+
+  bool io_in_progress_ PW_GUARDED_BY(mutex_) = false;
+  bool paused_ PW_GUARDED_BY(mutex_) = false;
+
+  // A read returned no data. The worker waits for the transfer to read before
+  // trying again.
+  bool stalled_ PW_GUARDED_BY(mutex_) = false;
+};
+
+// Does the stream I/O of transfers for one or more TransferThreads, so that
+// the transfer threads only encode and decode chunks. Reads are prefetched and
+// writes are buffered, up to the size of the buffer of each transfer.
+//
+// Run() may be called from several threads to do the I/O of different
+// transfers in parallel.
+class StreamIoWorker : public thread::ThreadCore {
+ public:
+  // Returns an AsyncStream through which to do the I/O of a transfer on
+  // `stream`, or nullptr if the maximum number of transfers are already using
+  // the worker.
+  AsyncStream* Open(stream::Stream& stream, TransferType type);
+
+  // Makes all threads running the worker return from Run(). The worker must not
+  // be used by any transfers.
+  void RequestStop() PW_LOCKS_EXCLUDED(mutex_);
+
+ protected:
+  explicit StreamIoWorker(span<AsyncStream> streams) : streams_(streams) {}
+
+ private:
+  friend class AsyncStream;
+
+  void Run() final;
+
+  // Wakes a thread to look for I/O to do.
+  void Wake() PW_LOCKS_EXCLUDED(mutex_);
+  void WakeLocked() PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  span<AsyncStream> streams_;
+
+  sync::CountingSemaphore work_available_;
+
+  sync::Mutex mutex_;
+
+  // Whether work_available_ was released and no thread has acquired it yet. At
+  // most one release is kept pending, as a thread that finds I/O to do wakes
+  // another to look for more.
+  bool wake_pending_ PW_GUARDED_BY(mutex_) = false;
+  bool stop_requested_ PW_GUARDED_BY(mutex_) = false;
+};
+
+}  // namespace internal
+
+using StreamIoWorker = internal::StreamIoWorker;
+
+// A StreamIoWorker for up to kMaxConcurrentTransfers transfers at a time, each
+// with a kBufferSizeBytes buffer. Transfers started while all buffers are in
+// use do their I/O on the transfer thread.
+//
+// A read returns at most kBufferSizeBytes, so the buffer should be at least as
+// large as the maximum chunk size of the transfer thread.
+template <size_t kMaxConcurrentTransfers, size_t kBufferSizeBytes>
+class IoWorker final : public internal::StreamIoWorker {
+ public:
+  static_assert(kBufferSizeBytes > 0);
+
+  IoWorker() : internal::StreamIoWorker(streams_) {
+    for (size_t i = 0; i < kMaxConcurrentTransfers; ++i) {
+      streams_[i].set_buffer(buffers_[i]);
+    }
+  }
+
+ private:
+  std::array<internal::AsyncStream, kMaxConcurrentTransfers> streams_;
+  std::array<std::array<std::byte, kBufferSizeBytes>, kMaxConcurrentTransfers>
+      buffers_;
+};
+
+}  // namespace pw::transfer
@@ -31,6 +31,7 @@
 #include "pw_transfer/internal/context.h"
 #include "pw_transfer/internal/event.h"
 #include "pw_transfer/internal/server_context.h"
+#include "pw_transfer/stream_io_worker.h"
 
 namespace pw::transfer {
 
@@ -239,6 +240,13 @@ class TransferThread : public thread::ThreadCore {
 
   size_t max_chunk_size() const { return chunk_buffer_.size(); }
 
+  /// Does the stream reads and writes of this thread's transfers on `worker`
+  /// instead of on the transfer thread. Must be called before any transfer is
+  /// started.
+  void set_stream_io_worker(StreamIoWorker& worker) {
+    stream_io_worker_ = &worker;
+  }
+
   // For testing only: terminates the transfer thread with a kTerminate event.
   void Terminate();
 
@@ -426,6 +434,9 @@ class TransferThread : public thread::ThreadCore {
   ByteSpan encode_buffer_;
 
   ResourceStatusCallback resource_status_callback_ = nullptr;
+
+  // Does the stream I/O of transfers, if set.
+  StreamIoWorker* stream_io_worker_ = nullptr;
 };
 
 }  // namespace internal
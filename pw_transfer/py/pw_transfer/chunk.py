@@ -68,6 +68,8 @@ class Chunk:
         max_chunk_size_bytes: Maximum number of bytes to send in a single data
             chunk.
         min_delay_microseconds: Delay between data chunks to be sent.
+        received_ranges: In a PARAMETERS_RETRANSMIT chunk, (start, end) offset
+            pairs of data beyond the offset that the receiver already has.
     """
 
     # pylint: disable=too-many-instance-attributes
@@ -91,6 +93,7 @@ class Chunk:
         min_delay_microseconds: int | None = None,
         status: Status | None = None,
         initial_offset: int = 0,
+        received_ranges: list[tuple[int, int]] | None = None,
     ):
         """Creates a new transfer chunk.
 
@@ -114,6 +117,9 @@ class Chunk:
             status: In a COMPLETION chunk, final status of the transfer.
             initial_offset: Initial offset for non-zero starting offset
             transfers
+            received_ranges: In a PARAMETERS_RETRANSMIT chunk, (start, end)
+                offset pairs of data beyond the offset that the receiver
+                already has.
         """
         self.protocol_version = protocol_version
         self.type = chunk_type
@@ -128,6 +134,9 @@ class Chunk:
         self.min_delay_microseconds = min_delay_microseconds
         self.status = status
         self.initial_offset = initial_offset
+        self.received_ranges = (
+            received_ranges if received_ranges is not None else []
+        )
 
     @classmethod
     def from_message(cls, message: transfer_pb2.Chunk) -> Chunk:
@@ -159,6 +168,11 @@ class Chunk:
             window_end_offset=message.window_end_offset,
             data=message.data,
             initial_offset=message.initial_offset,
+            received_ranges=[
+                (r.start_offset, r.end_offset)
+                for r in message.received_ranges
+                if r.start_offset < r.end_offset
+            ],
         )
 
         if message.HasField('session_id'):
@@ -256,6 +270,11 @@ class Chunk:
 
         message.initial_offset = self.initial_offset
 
+        for start_offset, end_offset in self.received_ranges:
+            message.received_ranges.add(
+                start_offset=start_offset, end_offset=end_offset
+            )
+
         return message
 
     def id(self) -> int:
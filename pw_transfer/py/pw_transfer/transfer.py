@@ -491,6 +491,10 @@ class WriteTransfer(Transfer):
 
         self._bytes_confirmed_received = 0
 
+        # Sorted (start, end) offsets of data beyond the current offset which
+        # the server already has and which are not resent.
+        self._received_ranges: list[tuple[int, int]] = []
+
     @property
     def data(self) -> bytes:
         return self._data
@@ -539,6 +543,12 @@ class WriteTransfer(Transfer):
             _LOG.debug('Transfer %d: Skipping stale window', self.id)
             return
 
+        self._skip_received_ranges()
+        if self._offset >= self._window_end_offset:
+            # The rest of the window was already received.
+            self._state = Transfer._State.WAITING
+            return
+
         chunk = self._next_chunk()
         self._offset += len(chunk.data)
 
@@ -600,6 +610,11 @@ class WriteTransfer(Transfer):
                 )
 
             self._offset = chunk.offset
+            self._received_ranges = sorted(
+                (start, end)
+                for start, end in chunk.received_ranges
+                if start > chunk.offset
+            )
         elif (
             chunk.type is Chunk.Type.PARAMETERS_CONTINUE
             and chunk.window_end_offset <= self._offset
@@ -618,6 +633,15 @@ class WriteTransfer(Transfer):
 
         return True
 
+    def _skip_received_ranges(self) -> None:
+        """Advances the offset past data that the server already has."""
+        while self._received_ranges:
+            start, end = self._received_ranges[0]
+            if start > self._offset:
+                break
+            self._offset = max(self._offset, end)
+            self._received_ranges.pop(0)
+
     def _retry_after_data_timeout(self) -> None:
         if (
             self._state is Transfer._State.WAITING
@@ -637,6 +661,12 @@ class WriteTransfer(Transfer):
         max_bytes_in_chunk = min(
             self._max_chunk_size, self._window_end_offset - self._offset
         )
+        if self._received_ranges:
+            # Stop at the next range the server already has.
+            max_bytes_in_chunk = min(
+                max_bytes_in_chunk, self._received_ranges[0][0] - self._offset
+            )
+
         chunk.data = self.data[
             self._offset
             - self.initial_offset : self._offset
@@ -1113,6 +1113,52 @@ class TransferManagerTest(unittest.TestCase):
         self.assertEqual(self._sent_chunks[3].data, b'eed data')
         self.assertEqual(self._sent_chunks[4].data, b' transfer')
 
+    def test_write_transfer_skips_received_ranges(self) -> None:
+        """Write transfer in which the server has some data past the offset."""
+        manager = pw_transfer.Manager(
+            self._service, default_response_timeout_s=DEFAULT_TIMEOUT_S
+        )
+
+        self._enqueue_server_responses(
+            _Method.WRITE,
+            (
+                (
+                    transfer_pb2.Chunk(
+                        transfer_id=4,
+                        offset=0,
+                        pending_bytes=16,
+                        max_chunk_size_bytes=8,
+                    ),
+                ),
+                (),
+                (
+                    transfer_pb2.Chunk(
+                        transfer_id=4,
+                        offset=4,  # rewind, but 8-16 was received
+                        pending_bytes=17,
+                        max_chunk_size_bytes=8,
+                        received_ranges=[
+                            transfer_pb2.Chunk.Range(
+                                start_offset=8, end_offset=16
+                            )
+                        ],
+                    ),
+                ),
+                (),
+                (transfer_pb2.Chunk(transfer_id=4, status=Status.OK.value),),
+            ),
+        )
+
+        manager.write(4, b'pigweed data transfer')
+        self.assertEqual(len(self._sent_chunks), 5)
+        self.assertEqual(self._sent_chunks[1].data, b'pigweed ')
+        self.assertEqual(self._sent_chunks[2].data, b'data tra')
+        self.assertEqual(self._sent_chunks[3].offset, 4)
+        self.assertEqual(self._sent_chunks[3].data, b'eed ')
+        self.assertEqual(self._sent_chunks[4].offset, 16)
+        self.assertEqual(self._sent_chunks[4].data, b'nsfer')
+        self.assertEqual(self._sent_chunks[4].remaining_bytes, 0)
+
     def test_write_transfer_bad_offset(self) -> None:
         manager = pw_transfer.Manager(
             self._service, default_response_timeout_s=DEFAULT_TIMEOUT_S
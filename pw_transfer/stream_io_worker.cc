@@ -0,0 +1,377 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_transfer/stream_io_worker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "pw_result/result.h"
+
+namespace pw::transfer::internal {
+
+bool AsyncStream::Open(StreamIoWorker& worker,
+                       stream::Stream& stream,
+                       TransferType type) {
+  {
+    std::lock_guard lock(mutex_);
+    if (mode_ != Mode::kClosed) {
+      return false;
+    }
+    worker_ = &worker;
+    stream_ = &stream;
+    mode_ = type == TransferType::kTransmit ? Mode::kRead : Mode::kWrite;
+    head_ = 0;
+    size_ = 0;
+    position_ = stream.Tell();
+    status_ = OkStatus();
+    io_in_progress_ = false;
+    paused_ = false;
+    stalled_ = false;
+  }
+
+  // Start reading ahead.
+  worker.Wake();
+  return true;
+}
+
+Status AsyncStream::Close() {
+  mutex_.lock();
+  Pause(/*flush=*/true);
+  const Status status = mode_ == Mode::kWrite ? status_ : OkStatus();
+  mode_ = Mode::kClosed;
+  stream_ = nullptr;
+  head_ = 0;
+  size_ = 0;
+  paused_ = false;
+  mutex_.unlock();
+  return status;
+}
+
+bool AsyncStream::DoNextIo() {
+  mutex_.lock();
+  if (mode_ == Mode::kClosed || io_in_progress_ || paused_ || !status_.ok()) {
+    mutex_.unlock();
+    return false;
+  }
+
+  if (mode_ == Mode::kRead) {
+    if (stalled_ || size_ == buffer_.size()) {
+      mutex_.unlock();
+      return false;
+    }
+
+    // Read into the free space up to the end of the buffer or the start of the
+    // buffered data.
+    const size_t tail = (head_ + size_) % buffer_.size();
+    const size_t end = tail < head_ ? head_ : buffer_.size();
+    stream::Reader& reader = static_cast<stream::Reader&>(*stream_);
+
+    io_in_progress_ = true;
+    mutex_.unlock();
+    // Another thread may do the I/O of other transfers meanwhile.
+    worker_->Wake();
+    const Result<ByteSpan> result =
+        reader.Read(buffer_.subspan(tail, end - tail));
+    mutex_.lock();
+    io_in_progress_ = false;
+
+    if (!result.ok()) {
+      status_ = result.status();
+    } else if (result->empty()) {
+      stalled_ = true;
+    } else {
+      size_ += result->size();
+    }
+  } else {
+    if (size_ == 0u) {
+      mutex_.unlock();
+      return false;
+    }
+
+    // Write the buffered data up to the end of the buffer.
+    const size_t end = std::min(head_ + size_, buffer_.size());
+    const ConstByteSpan data = buffer_.subspan(head_, end - head_);
+    stream::Writer& writer = static_cast<stream::Writer&>(*stream_);
+
+    io_in_progress_ = true;
+    mutex_.unlock();
+    worker_->Wake();
+    const Status status = writer.Write(data);
+    mutex_.lock();
+    io_in_progress_ = false;
+
+    if (status.ok()) {
+      Discard(data.size());
+    } else {
+      status_ = status;
+    }
+  }
+
+  mutex_.unlock();
+  io_done_.release();
+  return true;
+}
+
+StatusWithSize AsyncStream::DoRead(ByteSpan destination) {
+  mutex_.lock();
+
+  // Wait until the read can be filled, as it would be by reading the stream.
+  // Empty reads wait for some data, so that they detect the end of the stream.
+  const size_t wanted =
+      std::clamp(destination.size(), size_t{1}, buffer_.size());
+  while (mode_ == Mode::kRead && size_ < wanted && status_.ok() && !stalled_) {
+    WaitForWorker();
+  }
+
+  if (mode_ != Mode::kRead) {
+    mutex_.unlock();
+    return StatusWithSize::FailedPrecondition();
+  }
+
+  if (size_ == 0u && !status_.ok()) {
+    const Status status = status_;
+    mutex_.unlock();
+    return StatusWithSize(status, 0);
+  }
+
+  // The buffered data may wrap around the end of the buffer.
+  const size_t size = std::min(destination.size(), size_);
+  const size_t first = std::min(size, buffer_.size() - head_);
+  std::memcpy(destination.data(), buffer_.data() + head_, first);
+  std::memcpy(destination.data() + first, buffer_.data(), size - first);
+  Discard(size);
+  if (position_ != kUnknownPosition) {
+    position_ += size;
+  }
+  stalled_ = false;
+
+  mutex_.unlock();
+  worker_->Wake();
+  return StatusWithSize(size);
+}
+
+Status AsyncStream::DoWrite(ConstByteSpan data) {
+  mutex_.lock();
+  if (mode_ != Mode::kWrite) {
+    mutex_.unlock();
+    return Status::FailedPrecondition();
+  }
+
+  const size_t total = data.size();
+  while (!data.empty() && status_.ok()) {
+    if (size_ == buffer_.size()) {
+      WaitForWorker();
+      continue;
+    }
+
+    // Copy into the free space up to the end of the buffer or the start of the
+    // buffered data.
+    if (size_ == 0u) {
+      head_ = 0;
+    }
+    const size_t tail = (head_ + size_) % buffer_.size();
+    const size_t end = tail < head_ ? head_ : buffer_.size();
+    const size_t size = std::min(data.size(), end - tail);
+    std::memcpy(buffer_.data() + tail, data.data(), size);
+    size_ += size;
+    data = data.subspan(size);
+    worker_->Wake();
+  }
+
+  const Status status = status_;
+  if (status.ok() && position_ != kUnknownPosition) {
+    position_ += total;
+  }
+  mutex_.unlock();
+  return status;
+}
+
+Status AsyncStream::DoSeek(ptrdiff_t offset, Whence origin) {
+  mutex_.lock();
+  if (mode_ == Mode::kClosed) {
+    mutex_.unlock();
+    return Status::FailedPrecondition();
+  }
+  if (!stream_->seekable()) {
+    mutex_.unlock();
+    return Status::Unimplemented();
+  }
+
+  // Seeking forward within the data read ahead skips it.
+  if (mode_ == Mode::kRead) {
+    ptrdiff_t skip = -1;
+    if (origin == kCurrent) {
+      skip = offset;
+    } else if (origin == kBeginning && position_ != kUnknownPosition) {
+      skip = offset - static_cast<ptrdiff_t>(position_);
+    }
+    if (skip >= 0 && static_cast<size_t>(skip) <= size_) {
+      Discard(static_cast<size_t>(skip));
+      if (position_ != kUnknownPosition) {
+        position_ += static_cast<size_t>(skip);
+      }
+      mutex_.unlock();
+      worker_->Wake();
+      return OkStatus();
+    }
+  }
+
+  Pause(/*flush=*/true);
+
+  Status status;
+  if (mode_ == Mode::kWrite && !status_.ok()) {
+    status = status_;
+  } else {
+    // The stream is ahead of the transfer by the data read ahead.
+    if (mode_ == Mode::kRead && origin == kCurrent) {
+      offset -= static_cast<ptrdiff_t>(size_);
+    }
+    status = stream_->Seek(offset, origin);
+    if (status.ok()) {
+      if (mode_ == Mode::kRead) {
+        head_ = 0;
+        size_ = 0;
+        status_ = OkStatus();
+        stalled_ = false;
+      }
+      position_ = stream_->Tell();
+    }
+  }
+
+  paused_ = false;
+  mutex_.unlock();
+  worker_->Wake();
+  return status;
+}
+
+size_t AsyncStream::DoTell() {
+  std::lock_guard lock(mutex_);
+  return position_;
+}
+
+size_t AsyncStream::ConservativeLimit(LimitType type) const {
+  // Querying the stream requires pausing the worker's I/O.
+  return const_cast<AsyncStream*>(this)->GetLimit(type);
+}
+
+size_t AsyncStream::GetLimit(LimitType type) {
+  mutex_.lock();
+  size_t limit = 0;
+  if (mode_ == Mode::kRead && type == LimitType::kRead) {
+    Pause(/*flush=*/false);
+    const size_t stream_limit =
+        status_.ok() ? stream_->ConservativeReadLimit() : 0;
+    limit = stream_limit == kUnlimited ? kUnlimited : stream_limit + size_;
+  } else if (mode_ == Mode::kWrite && type == LimitType::kWrite &&
+             status_.ok()) {
+    Pause(/*flush=*/false);
+    const size_t stream_limit = stream_->ConservativeWriteLimit();
+    limit = stream_limit == kUnlimited
+                ? kUnlimited
+                : stream_limit - std::min(stream_limit, size_);
+  }
+  paused_ = false;
+  mutex_.unlock();
+  if (worker_ != nullptr) {
+    worker_->Wake();
+  }
+  return limit;
+}
+
+void AsyncStream::Pause(bool flush) {
+  if (flush) {
+    while (mode_ == Mode::kWrite && size_ > 0u && status_.ok()) {
+      WaitForWorker();
+    }
+  }
+  paused_ = true;
+  while (io_in_progress_) {
+    WaitForWorker();
+  }
+}
+
+void AsyncStream::WaitForWorker() {
+  mutex_.unlock();
+  worker_->Wake();
+  io_done_.acquire();
+  mutex_.lock();
+}
+
+void AsyncStream::Discard(size_t size) {
+  head_ = (head_ + size) % buffer_.size();
+  size_ -= size;
+  // A read by the worker in progress appends to the buffered data at its tail,
+  // so the data must not move until the read is done.
+  if (size_ == 0u && !io_in_progress_) {
+    head_ = 0;
+  }
+}
+
+AsyncStream* StreamIoWorker::Open(stream::Stream& stream, TransferType type) {
+  for (AsyncStream& async_stream : streams_) {
+    if (async_stream.Open(*this, stream, type)) {
+      return &async_stream;
+    }
+  }
+  return nullptr;
+}
+
+void StreamIoWorker::RequestStop() {
+  std::lock_guard lock(mutex_);
+  stop_requested_ = true;
+  WakeLocked();
+}
+
+void StreamIoWorker::Run() {
+  while (true) {
+    work_available_.acquire();
+    {
+      std::lock_guard lock(mutex_);
+      wake_pending_ = false;
+      if (stop_requested_) {
+        // Wake the next thread running the worker so that it stops as well.
+        WakeLocked();
+        return;
+      }
+    }
+
+    // Do one read or write of each stream in turn, so that every transfer makes
+    // progress, until none has I/O to do.
+    bool did_io = true;
+    while (did_io) {
+      did_io = false;
+      for (AsyncStream& stream : streams_) {
+        if (stream.DoNextIo()) {
+          did_io = true;
+        }
+      }
+    }
+  }
+}
+
+void StreamIoWorker::Wake() {
+  std::lock_guard lock(mutex_);
+  WakeLocked();
+}
+
+void StreamIoWorker::WakeLocked() {
+  if (!wake_pending_) {
+    wake_pending_ = true;
+    work_available_.release();
+  }
+}
+
+}  // namespace pw::transfer::internal
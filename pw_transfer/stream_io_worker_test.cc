@@ -0,0 +1,281 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_transfer/stream_io_worker.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_bytes/span.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_stream/stream.h"
+#include "pw_sync/counting_semaphore.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::transfer {
+namespace {
+
+using internal::AsyncStream;
+using internal::TransferType;
+
+constexpr size_t kBufferSize = 16;
+
+constexpr std::array<std::byte, 100> kData = [] {
+  std::array<std::byte, 100> data{};
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::byte>(i);
+  }
+  return data;
+}();
+
+// Reader which returns at most kMaxReadSize bytes per read, and which blocks
+// each read until the test allows it to proceed.
+class ShortReader final : public stream::SeekableReader {
+ public:
+  static constexpr size_t kMaxReadSize = 5;
+
+  // Waits until the worker has started a read.
+  void WaitForRead() { read_started_.acquire(); }
+
+  // Allows the given number of reads, started or not, to finish.
+  void FinishReads(ptrdiff_t count = 1) { proceed_.release(count); }
+
+ private:
+  StatusWithSize DoRead(ByteSpan destination) override {
+    read_started_.release();
+    proceed_.acquire();
+    const Result<ByteSpan> result = reader_.Read(
+        destination.first(std::min(destination.size(), kMaxReadSize)));
+    return StatusWithSize(result.status(), result.ok() ? result->size() : 0);
+  }
+
+  Status DoSeek(ptrdiff_t offset, Whence origin) override {
+    return reader_.Seek(offset, origin);
+  }
+
+  size_t DoTell() override { return reader_.Tell(); }
+
+  stream::MemoryReader reader_{kData};
+  sync::CountingSemaphore read_started_;
+  sync::CountingSemaphore proceed_;
+};
+
+class StreamIoWorkerTest : public ::testing::Test {
+ protected:
+  StreamIoWorkerTest() : thread_(options_, worker_) {}
+
+  ~StreamIoWorkerTest() override {
+    worker_.RequestStop();
+    thread_.join();
+  }
+
+  IoWorker<2, kBufferSize> worker_;
+
+ private:
+  thread::stl::Options options_;
+  pw::Thread thread_;
+};
+
+TEST_F(StreamIoWorkerTest, Read_ReturnsAllDataThenOutOfRange) {
+  stream::MemoryReader reader(kData);
+  AsyncStream* stream = worker_.Open(reader, TransferType::kTransmit);
+  ASSERT_NE(stream, nullptr);
+
+  std::array<std::byte, 10> buffer;
+  for (size_t offset = 0; offset < kData.size(); offset += buffer.size()) {
+    EXPECT_EQ(stream->Tell(), offset);
+    Result<ByteSpan> result = stream->Read(buffer);
+    ASSERT_EQ(result.status(), OkStatus());
+    ASSERT_EQ(result.value().size(), buffer.size());
+    EXPECT_EQ(std::memcmp(
+                  buffer.data(), kData.data() + offset, result.value().size()),
+              0);
+  }
+
+  EXPECT_EQ(stream->Read(buffer).status(), Status::OutOfRange());
+  EXPECT_EQ(stream->Close(), OkStatus());
+}
+
+TEST_F(StreamIoWorkerTest, Read_LargerThanBuffer_ReturnsBufferedData) {
+  stream::MemoryReader reader(kData);
+  AsyncStream* stream = worker_.Open(reader, TransferType::kTransmit);
+  ASSERT_NE(stream, nullptr);
+
+  std::array<std::byte, 40> buffer;
+  Result<ByteSpan> result = stream->Read(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_GT(result.value().size(), 0u);
+  ASSERT_LE(result.value().size(), kBufferSize);
+  EXPECT_EQ(std::memcmp(buffer.data(), kData.data(), result.value().size()),
+            0);
+
+  EXPECT_EQ(stream->Close(), OkStatus());
+}
+
+TEST_F(StreamIoWorkerTest, Seek_WithinAndOutsideReadAhead) {
+  stream::MemoryReader reader(kData);
+  AsyncStream* stream = worker_.Open(reader, TransferType::kTransmit);
+  ASSERT_NE(stream, nullptr);
+
+  std::array<std::byte, 4> buffer;
+  ASSERT_EQ(stream->Read(buffer).status(), OkStatus());
+
+  // Forward, possibly within the data read ahead.
+  ASSERT_EQ(stream->Seek(10), OkStatus());
+  EXPECT_EQ(stream->Tell(), 10u);
+  ASSERT_EQ(stream->Read(buffer).status(), OkStatus());
+  EXPECT_EQ(buffer[0], kData[10]);
+  EXPECT_EQ(buffer[3], kData[13]);
+
+  // Backward, which always seeks the stream.
+  ASSERT_EQ(stream->Seek(2), OkStatus());
+  EXPECT_EQ(stream->Tell(), 2u);
+  ASSERT_EQ(stream->Read(buffer).status(), OkStatus());
+  EXPECT_EQ(buffer[0], kData[2]);
+  EXPECT_EQ(buffer[3], kData[5]);
+
+  // Forward, beyond the data read ahead.
+  ASSERT_EQ(stream->Seek(80), OkStatus());
+  EXPECT_EQ(stream->Tell(), 80u);
+  ASSERT_EQ(stream->Read(buffer).status(), OkStatus());
+  EXPECT_EQ(buffer[0], kData[80]);
+  EXPECT_EQ(buffer[3], kData[83]);
+
+  EXPECT_EQ(stream->Close(), OkStatus());
+}
+
+TEST_F(StreamIoWorkerTest, Read_DrainsBufferDuringWorkerRead) {
+  ShortReader reader;
+  AsyncStream* stream = worker_.Open(reader, TransferType::kTransmit);
+  ASSERT_NE(stream, nullptr);
+
+  // The first read returns less than the buffer, so the worker starts another
+  // read after the buffered data.
+  reader.WaitForRead();
+  reader.FinishReads();
+  reader.WaitForRead();
+
+  // Reading all of the buffered data doesn't wait for the worker's read.
+  std::array<std::byte, ShortReader::kMaxReadSize> buffer;
+  Result<ByteSpan> result = stream->Read(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result.value().size(), buffer.size());
+  EXPECT_EQ(std::memcmp(buffer.data(), kData.data(), buffer.size()), 0);
+
+  // The data the worker read meanwhile follows the data already read.
+  reader.FinishReads();
+  result = stream->Read(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result.value().size(), buffer.size());
+  EXPECT_EQ(
+      std::memcmp(buffer.data(), kData.data() + buffer.size(), buffer.size()),
+      0);
+
+  reader.FinishReads(static_cast<ptrdiff_t>(kData.size()));
+  EXPECT_EQ(stream->Close(), OkStatus());
+}
+
+TEST_F(StreamIoWorkerTest, Seek_SkipsBufferDuringWorkerRead) {
+  ShortReader reader;
+  AsyncStream* stream = worker_.Open(reader, TransferType::kTransmit);
+  ASSERT_NE(stream, nullptr);
+
+  reader.WaitForRead();
+  reader.FinishReads();
+  reader.WaitForRead();
+
+  // Skipping all of the buffered data doesn't wait for the worker's read.
+  ASSERT_EQ(stream->Seek(ShortReader::kMaxReadSize), OkStatus());
+  EXPECT_EQ(stream->Tell(), ShortReader::kMaxReadSize);
+
+  reader.FinishReads();
+  std::array<std::byte, ShortReader::kMaxReadSize> buffer;
+  Result<ByteSpan> result = stream->Read(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result.value().size(), buffer.size());
+  EXPECT_EQ(
+      std::memcmp(buffer.data(), kData.data() + buffer.size(), buffer.size()),
+      0);
+
+  reader.FinishReads(static_cast<ptrdiff_t>(kData.size()));
+  EXPECT_EQ(stream->Close(), OkStatus());
+}
+
+TEST_F(StreamIoWorkerTest, Write_FlushedByClose) {
+  stream::MemoryWriterBuffer<kData.size()> writer;
+  AsyncStream* stream = worker_.Open(writer, TransferType::kReceive);
+  ASSERT_NE(stream, nullptr);
+
+  // Writes larger than the buffer wait for the worker to write the stream.
+  ASSERT_EQ(stream->Write(span(kData).first(30)), OkStatus());
+  ASSERT_EQ(stream->Write(span(kData).subspan(30, 7)), OkStatus());
+  ASSERT_EQ(stream->Write(span(kData).subspan(37)), OkStatus());
+  EXPECT_EQ(stream->Tell(), kData.size());
+
+  EXPECT_EQ(stream->Close(), OkStatus());
+  ASSERT_EQ(writer.bytes_written(), kData.size());
+  EXPECT_EQ(std::memcmp(writer.data(), kData.data(), kData.size()), 0);
+}
+
+TEST_F(StreamIoWorkerTest, Write_SeekFlushesFirst) {
+  stream::MemoryWriterBuffer<kData.size()> writer;
+  AsyncStream* stream = worker_.Open(writer, TransferType::kReceive);
+  ASSERT_NE(stream, nullptr);
+
+  ASSERT_EQ(stream->Write(span(kData).first(8)), OkStatus());
+  ASSERT_EQ(stream->Seek(4), OkStatus());
+  EXPECT_EQ(writer.bytes_written(), 4u);
+  ASSERT_EQ(stream->Write(span(kData).subspan(4, 8)), OkStatus());
+
+  EXPECT_EQ(stream->Close(), OkStatus());
+  ASSERT_EQ(writer.bytes_written(), 12u);
+  EXPECT_EQ(std::memcmp(writer.data(), kData.data(), 12), 0);
+}
+
+TEST_F(StreamIoWorkerTest, Write_ErrorReturnedByClose) {
+  stream::MemoryWriterBuffer<8> writer;
+  AsyncStream* stream = worker_.Open(writer, TransferType::kReceive);
+  ASSERT_NE(stream, nullptr);
+
+  // The write fits in the buffer, so it succeeds before the stream is written.
+  EXPECT_EQ(stream->Write(span(kData).first(12)), OkStatus());
+  EXPECT_EQ(stream->Close(), Status::ResourceExhausted());
+}
+
+TEST_F(StreamIoWorkerTest, Open_AllBuffersInUse_ReturnsNull) {
+  stream::MemoryReader reader_1(kData);
+  stream::MemoryReader reader_2(kData);
+  stream::MemoryReader reader_3(kData);
+  AsyncStream* first = worker_.Open(reader_1, TransferType::kTransmit);
+  AsyncStream* second = worker_.Open(reader_2, TransferType::kTransmit);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(worker_.Open(reader_3, TransferType::kTransmit), nullptr);
+
+  EXPECT_EQ(first->Close(), OkStatus());
+  EXPECT_EQ(worker_.Open(reader_3, TransferType::kTransmit), first);
+
+  EXPECT_EQ(first->Close(), OkStatus());
+  EXPECT_EQ(second->Close(), OkStatus());
+}
+
+}  // namespace
+}  // namespace pw::transfer
@@ -0,0 +1,353 @@
+// Copyright 2026 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/span.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_rpc/channel.h"
+#include "pw_rpc/client_server.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_stream/null_stream.h"
+#include "pw_stream/seek.h"
+#include "pw_stream/stream.h"
+#include "pw_sync/counting_semaphore.h"
+#include "pw_sync/mutex.h"
+#include "pw_thread/sleep.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/thread_core.h"
+#include "pw_transfer/client.h"
+#include "pw_transfer/stream_io_worker.h"
+#include "pw_transfer/transfer.h"
+#include "pw_transfer/transfer_thread.h"
+
+namespace pw::transfer {
+namespace {
+
+// Measures the aggregate throughput of 1 to 8 concurrent transfers between a
+// client and a service connected by an in-process channel. The service's
+// resources stand in for flash or files: each read or write blocks for a fixed
+// time plus a time per byte. Without a StreamIoWorker, every transfer waits for
+// the I/O of the others on the service's transfer thread. With one, the I/O is
+// done by the worker's threads, ahead of reads and behind writes.
+
+constexpr uint32_t kChannelId = 1;
+constexpr size_t kMaxTransfers = 8;
+
+// A transfer's context stays in use for a short time after its completion
+// callback, waiting for the final acknowledgement.
+constexpr size_t kMaxContexts = 2 * kMaxTransfers;
+constexpr size_t kMaxIoThreads = 4;
+constexpr size_t kTransferSize = 8 * 1024;
+constexpr size_t kChunkSize = 256;
+constexpr uint32_t kWindowSize = 2048;
+constexpr size_t kIoBufferSize = 1024;
+
+// Each chunk of a transfer is sent at least 2 ms after the previous one, so
+// I/O this slow is what limits the rate of concurrent transfers.
+constexpr auto kIoLatency = std::chrono::microseconds(500);
+constexpr size_t kIoBytesPerMillisecond = 1024;
+
+enum class Direction { kRead, kWrite };
+
+// Delivers the packets sent on the channel from a thread of its own, so that
+// neither transfer thread processes the other's packets.
+class LoopbackChannel : public rpc::ChannelOutput, public thread::ThreadCore {
+ public:
+  LoopbackChannel() : rpc::ChannelOutput("loopback") {}
+
+  void set_client_server(rpc::ClientServer& client_server) {
+    client_server_ = &client_server;
+  }
+
+  Status Send(span<const std::byte> buffer) override {
+    {
+      std::lock_guard lock(mutex_);
+      packets_.emplace_back(buffer.begin(), buffer.end());
+    }
+    packet_available_.release();
+    return OkStatus();
+  }
+
+  void RequestStop() {
+    {
+      std::lock_guard lock(mutex_);
+      stop_requested_ = true;
+    }
+    packet_available_.release();
+  }
+
+ private:
+  void Run() override {
+    while (true) {
+      packet_available_.acquire();
+      std::vector<std::byte> packet;
+      {
+        std::lock_guard lock(mutex_);
+        if (stop_requested_) {
+          return;
+        }
+        packet = std::move(packets_.front());
+        packets_.pop_front();
+      }
+      client_server_->ProcessPacket(packet).IgnoreError();
+    }
+  }
+
+  rpc::ClientServer* client_server_ = nullptr;
+  sync::CountingSemaphore packet_available_;
+  sync::Mutex mutex_;
+  std::deque<std::vector<std::byte>> packets_;
+  bool stop_requested_ = false;
+};
+
+// A resource of kTransferSize bytes whose reads and writes take as long as
+// those of a slow storage device.
+class SlowStream final : public stream::SeekableReaderWriter {
+ private:
+  static void WaitForIo(size_t size_bytes) {
+    this_thread::sleep_for(chrono::SystemClock::for_at_least(
+        kIoLatency +
+        std::chrono::microseconds(size_bytes * 1000 / kIoBytesPerMillisecond)));
+  }
+
+  StatusWithSize DoRead(ByteSpan destination) override {
+    if (position_ == kTransferSize) {
+      return StatusWithSize::OutOfRange();
+    }
+    const size_t size = std::min(destination.size(), kTransferSize - position_);
+    WaitForIo(size);
+    std::fill_n(destination.begin(), size, std::byte{0x5a});
+    position_ += size;
+    return StatusWithSize(size);
+  }
+
+  Status DoWrite(ConstByteSpan data) override {
+    WaitForIo(data.size());
+    position_ += data.size();
+    return OkStatus();
+  }
+
+  Status DoSeek(ptrdiff_t offset, Whence origin) override {
+    return stream::CalculateSeek(offset, origin, kTransferSize, position_);
+  }
+
+  size_t DoTell() override { return position_; }
+
+  size_t ConservativeLimit(LimitType type) const override {
+    return type == LimitType::kRead ? kTransferSize - position_ : kUnlimited;
+  }
+
+  size_t position_ = 0;
+};
+
+class SlowResource final : public ReadWriteHandler {
+ public:
+  explicit SlowResource(uint32_t resource_id)
+      : ReadWriteHandler(resource_id, stream_) {}
+
+  Status PrepareRead() override { return stream_.Seek(0); }
+  Status PrepareWrite() override { return stream_.Seek(0); }
+
+ private:
+  SlowStream stream_;
+};
+
+// Counts the transfers that have completed. Transfers aborted when the
+// transfer threads are terminated after the test loop are not checked.
+struct Completions {
+  void Add(Status status) {
+    if (!status.ok()) {
+      PW_LOG_ERROR("Transfer failed: %s", status.str());
+      failed.fetch_add(1);
+    }
+    done.release();
+  }
+
+  sync::CountingSemaphore done;
+  std::atomic<size_t> failed = 0;
+};
+
+void ConcurrentTransfers(perf_test::State& state,
+                         Direction direction,
+                         size_t io_threads) {
+  const auto num_transfers = static_cast<size_t>(state.argument());
+  PW_CHECK_UINT_LE(num_transfers, kMaxTransfers);
+  PW_CHECK_UINT_LE(io_threads, kMaxIoThreads);
+
+  LoopbackChannel channel;
+  std::array<rpc::Channel, 1> channels = {
+      rpc::Channel::Create<kChannelId>(&channel)};
+  rpc::ClientServer client_server(channels);
+  channel.set_client_server(client_server);
+  thread::test::TestThreadContext channel_thread_context;
+  pw::Thread channel_thread(channel_thread_context.options(), channel);
+
+  std::array<std::byte, kChunkSize> server_chunk_buffer;
+  std::array<std::byte, kChunkSize> server_encode_buffer;
+  transfer::Thread<0, kMaxContexts> server_thread(server_chunk_buffer,
+                                                   server_encode_buffer);
+  thread::test::TestThreadContext server_thread_context;
+  pw::Thread server_system_thread(server_thread_context.options(),
+                                  server_thread);
+
+  std::array<std::byte, kChunkSize> client_chunk_buffer;
+  std::array<std::byte, kChunkSize> client_encode_buffer;
+  transfer::Thread<kMaxContexts, 0> client_thread(client_chunk_buffer,
+                                                   client_encode_buffer);
+  thread::test::TestThreadContext client_thread_context;
+  pw::Thread client_system_thread(client_thread_context.options(),
+                                  client_thread);
+
+  IoWorker<kMaxContexts, kIoBufferSize> io_worker;
+  std::array<thread::test::TestThreadContext, kMaxIoThreads> io_thread_contexts;
+  std::array<std::optional<pw::Thread>, kMaxIoThreads> io_system_threads;
+  for (size_t i = 0; i < io_threads; ++i) {
+    io_system_threads[i].emplace(io_thread_contexts[i].options(), io_worker);
+  }
+  if (io_threads > 0) {
+    server_thread.set_stream_io_worker(io_worker);
+  }
+
+  TransferService service(server_thread, kWindowSize);
+  std::array<std::optional<SlowResource>, kMaxTransfers> resources;
+  for (size_t i = 0; i < num_transfers; ++i) {
+    resources[i].emplace(static_cast<uint32_t>(i));
+    service.RegisterHandler(*resources[i]);
+  }
+  client_server.server().RegisterService(service);
+
+  Client client(client_server.client(), kChannelId, client_thread, kWindowSize);
+
+  static constexpr std::array<std::byte, kTransferSize> kData{};
+  std::array<stream::NullStream, kMaxTransfers> read_destinations;
+  Completions completions;
+
+  state.SetBytesPerIteration(num_transfers * kTransferSize);
+  size_t num_iterations = 0;
+  chrono::SystemClock::duration elapsed{};
+  while (state.KeepRunning()) {
+    const auto start = chrono::SystemClock::now();
+    std::array<std::optional<stream::MemoryReader>, kMaxTransfers> sources;
+    for (size_t i = 0; i < num_transfers; ++i) {
+      const auto on_completion = [&completions](Status status) {
+        completions.Add(status);
+      };
+      const auto resource_id = static_cast<uint32_t>(i);
+      if (direction == Direction::kRead) {
+        PW_CHECK_OK(
+            client.Read(resource_id, read_destinations[i], on_completion)
+                .status());
+      } else {
+        sources[i].emplace(kData);
+        PW_CHECK_OK(
+            client.Write(resource_id, *sources[i], on_completion).status());
+      }
+    }
+    for (size_t i = 0; i < num_transfers; ++i) {
+      completions.done.acquire();
+    }
+    elapsed += chrono::SystemClock::now() - start;
+    ++num_iterations;
+  }
+  PW_CHECK_UINT_EQ(completions.failed.load(), 0u);
+
+  for (size_t i = 0; i < num_transfers; ++i) {
+    service.UnregisterHandler(*resources[i]);
+  }
+  client_thread.Terminate();
+  client_system_thread.join();
+  server_thread.Terminate();
+  server_system_thread.join();
+  io_worker.RequestStop();
+  for (size_t i = 0; i < io_threads; ++i) {
+    io_system_threads[i]->join();
+  }
+  channel.RequestStop();
+  channel_thread.join();
+
+  const auto elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  const uint64_t total_bytes =
+      uint64_t{kTransferSize} * num_transfers * num_iterations;
+  PW_LOG_INFO("%zu concurrent %s, %zu I/O threads: %" PRIu64 " KiB/s",
+              num_transfers,
+              direction == Direction::kRead ? "reads" : "writes",
+              io_threads,
+              elapsed_us > 0 ? total_bytes * 1'000'000 /
+                                   static_cast<uint64_t>(elapsed_us) / 1024
+                             : 0);
+}
+
+PW_PERF_TEST_RANGE(ReadsSynchronousIo,
+                   ConcurrentTransfers,
+                   1,
+                   kMaxTransfers,
+                   2,
+                   Direction::kRead,
+                   /*io_threads=*/0);
+PW_PERF_TEST_RANGE(ReadsIoWorker1Thread,
+                   ConcurrentTransfers,
+                   1,
+                   kMaxTransfers,
+                   2,
+                   Direction::kRead,
+                   /*io_threads=*/1);
+PW_PERF_TEST_RANGE(ReadsIoWorker4Threads,
+                   ConcurrentTransfers,
+                   1,
+                   kMaxTransfers,
+                   2,
+                   Direction::kRead,
+                   /*io_threads=*/4);
+PW_PERF_TEST_RANGE(WritesSynchronousIo,
+                   ConcurrentTransfers,
+                   1,
+                   kMaxTransfers,
+                   2,
+                   Direction::kWrite,
+                   /*io_threads=*/0);
+PW_PERF_TEST_RANGE(WritesIoWorker1Thread,
+                   ConcurrentTransfers,
+                   1,
+                   kMaxTransfers,
+                   2,
+                   Direction::kWrite,
+                   /*io_threads=*/1);
+PW_PERF_TEST_RANGE(WritesIoWorker4Threads,
+                   ConcurrentTransfers,
+                   1,
+                   kMaxTransfers,
+                   2,
+                   Direction::kWrite,
+                   /*io_threads=*/4);
+
+}  // namespace
+}  // namespace pw::transfer
@@ -120,7 +120,8 @@ constexpr uint32_t kArbitrarySessionId = 123;
 
 class ReadTransfer : public ::testing::Test {
  protected:
-  ReadTransfer(size_t max_chunk_size_bytes = 64)
+  ReadTransfer(size_t max_chunk_size_bytes = 64,
+               StreamIoWorker* io_worker = nullptr)
       : handler_(3, kData),
         transfer_thread_(span(data_buffer_).first(max_chunk_size_bytes),
                          encode_buffer_),
@@ -129,6 +130,9 @@ class ReadTransfer : public ::testing::Test {
              // Use a long timeout to avoid accidentally triggering timeouts.
              std::chrono::minutes(1)),
         system_thread_(TransferThreadOptions(), transfer_thread_) {
+    if (io_worker != nullptr) {
+      transfer_thread_.set_stream_io_worker(*io_worker);
+    }
     ctx_.service().RegisterHandler(handler_);
 
     PW_CHECK(!handler_.prepare_read_called);
@@ -251,6 +255,77 @@ TEST_F(ReadTransfer, MultiChunk) {
   EXPECT_EQ(handler_.finalize_read_status, OkStatus());
 }
 
+// Runs an IoWorker to do the stream I/O of a fixture's transfers. Inherited
+// before the fixture so that the worker outlives the transfer thread.
+class IoWorkerThread {
+ protected:
+  IoWorkerThread() : io_thread_(TransferThreadOptions(), io_worker_) {}
+
+  ~IoWorkerThread() {
+    io_worker_.RequestStop();
+    io_thread_.join();
+  }
+
+  // Buffers as large as a chunk, so that chunks are the same size as without
+  // the worker.
+  IoWorker<1, 64> io_worker_;
+
+ private:
+  pw::Thread io_thread_;
+};
+
+class ReadTransferWithIoWorker : public IoWorkerThread, public ReadTransfer {
+ protected:
+  ReadTransferWithIoWorker() : ReadTransfer(64, &io_worker_) {}
+};
+
+TEST_F(ReadTransferWithIoWorker, MultiChunk) {
+  ctx_.SendClientStream(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kStart)
+                      .set_session_id(3)
+                      .set_window_end_offset(16)
+                      .set_offset(0)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(ctx_.total_responses(), 1u);
+  Chunk c0 = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(c0.offset(), 0u);
+  ASSERT_EQ(c0.payload().size(), 16u);
+  EXPECT_EQ(std::memcmp(c0.payload().data(), kData.data(), c0.payload().size()),
+            0);
+
+  // Retransmit from an earlier offset, which seeks back in the stream.
+  rpc::test::WaitForPackets(ctx_.output(), 2, [this] {
+    ctx_.SendClientStream(
+        EncodeChunk(Chunk(ProtocolVersion::kLegacy,
+                          Chunk::Type::kParametersRetransmit)
+                        .set_session_id(3)
+                        .set_window_end_offset(64)
+                        .set_offset(8)));
+    transfer_thread_.WaitUntilEventIsProcessed();
+  });
+
+  ASSERT_EQ(ctx_.total_responses(), 3u);
+  Chunk c1 = DecodeChunk(ctx_.responses()[1]);
+  EXPECT_EQ(c1.offset(), 8u);
+  ASSERT_EQ(c1.payload().size(), kData.size() - 8);
+  EXPECT_EQ(
+      std::memcmp(c1.payload().data(), kData.data() + 8, c1.payload().size()),
+      0);
+
+  Chunk c2 = DecodeChunk(ctx_.responses()[2]);
+  EXPECT_FALSE(c2.has_payload());
+  ASSERT_TRUE(c2.remaining_bytes().has_value());
+  EXPECT_EQ(c2.remaining_bytes().value(), 0u);
+
+  ctx_.SendClientStream(
+      EncodeChunk(Chunk::Final(ProtocolVersion::kLegacy, 3, OkStatus())));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  EXPECT_TRUE(handler_.finalize_read_called);
+  EXPECT_EQ(handler_.finalize_read_status, OkStatus());
+}
+
 TEST_F(ReadTransfer, MultiChunk_RepeatedContinuePackets) {
   ctx_.SendClientStream(
       EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kStart)
@@ -744,7 +819,8 @@ class SimpleWriteTransfer final : public WriteOnlyHandler {
 
 class WriteTransfer : public ::testing::Test {
  protected:
-  WriteTransfer(size_t max_bytes_to_receive = 64)
+  WriteTransfer(size_t max_bytes_to_receive = 64,
+                StreamIoWorker* io_worker = nullptr)
       : buffer{},
         handler_(7, buffer),
         transfer_thread_(data_buffer_, encode_buffer_),
@@ -754,6 +830,9 @@ class WriteTransfer : public ::testing::Test {
              // Use a long timeout to avoid accidentally triggering timeouts.
              std::chrono::minutes(1),
              /*max_retries=*/3) {
+    if (io_worker != nullptr) {
+      transfer_thread_.set_stream_io_worker(*io_worker);
+    }
     ctx_.service().RegisterHandler(handler_);
 
     PW_CHECK(!handler_.prepare_write_called);
@@ -905,6 +984,44 @@ TEST_F(WriteTransfer, MultiChunk) {
   EXPECT_EQ(std::memcmp(buffer.data(), kData.data(), kData.size()), 0);
 }
 
+class WriteTransferWithIoWorker : public IoWorkerThread, public WriteTransfer {
+ protected:
+  WriteTransferWithIoWorker() : WriteTransfer(64, &io_worker_) {}
+};
+
+TEST_F(WriteTransferWithIoWorker, MultiChunk) {
+  ctx_.SendClientStream(EncodeChunk(
+      Chunk(ProtocolVersion::kLegacy, Chunk::Type::kStart).set_session_id(7)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(ctx_.total_responses(), 1u);
+
+  ctx_.SendClientStream<64>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(7)
+                      .set_offset(0)
+                      .set_payload(span(kData).first(8))));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ctx_.SendClientStream<64>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(7)
+                      .set_offset(8)
+                      .set_payload(span(kData).subspan(8))
+                      .set_remaining_bytes(0)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(ctx_.total_responses(), 2u);
+  Chunk chunk = DecodeChunk(ctx_.responses().back());
+  ASSERT_TRUE(chunk.status().has_value());
+  EXPECT_EQ(chunk.status().value(), OkStatus());
+
+  // The buffered data is written before the handler is finalized.
+  EXPECT_TRUE(handler_.finalize_write_called);
+  EXPECT_EQ(handler_.finalize_write_status, OkStatus());
+  EXPECT_EQ(std::memcmp(buffer.data(), kData.data(), kData.size()), 0);
+}
+
 TEST_F(WriteTransfer, WriteFailsOnRetry) {
   // Skip one packet to fail on a retry.
   ctx_.output().set_send_status(Status::FailedPrecondition(), 1);
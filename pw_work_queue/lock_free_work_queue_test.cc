@@ -0,0 +1,196 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_work_queue/lock_free_work_queue.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+#include "pw_function/function.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/yield.h"
+#include "pw_unit_test/framework.h"
+#include "pw_work_queue/internal/mpmc_ring.h"
+#include "pw_work_queue/test_thread.h"
+
+namespace pw::work_queue {
+namespace {
+
+TEST(MpmcRing, PushPopInOrderAcrossLaps) {
+  std::array<internal::MpmcRing<int>::Slot, 4> slots;
+  internal::MpmcRing<int> ring(slots);
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.capacity(), 4u);
+
+  int next_push = 0;
+  int next_pop = 0;
+  for (int lap = 0; lap < 5; ++lap) {
+    for (int i = 0; i < 3; ++i) {
+      int item = next_push++;
+      EXPECT_TRUE(ring.TryPush(std::move(item)));
+    }
+    EXPECT_EQ(ring.size(), 3u);
+    for (int i = 0; i < 3; ++i) {
+      std::optional<int> item = ring.TryPop();
+      ASSERT_TRUE(item.has_value());
+      EXPECT_EQ(*item, next_pop++);
+    }
+  }
+  EXPECT_TRUE(ring.empty());
+  EXPECT_FALSE(ring.TryPop().has_value());
+}
+
+TEST(MpmcRing, FullRingRejectsPush) {
+  std::array<internal::MpmcRing<int>::Slot, 2> slots;
+  internal::MpmcRing<int> ring(slots);
+  int item = 1;
+  EXPECT_TRUE(ring.TryPush(std::move(item)));
+  item = 2;
+  EXPECT_TRUE(ring.TryPush(std::move(item)));
+  item = 3;
+  EXPECT_FALSE(ring.TryPush(std::move(item)));
+  EXPECT_EQ(ring.size(), 2u);
+
+  EXPECT_EQ(*ring.TryPop(), 1);
+  EXPECT_TRUE(ring.TryPush(std::move(item)));
+  EXPECT_EQ(*ring.TryPop(), 2);
+  EXPECT_EQ(*ring.TryPop(), 3);
+}
+
+TEST(MpmcRing, DestroysRemainingItems) {
+  struct Counted {
+    Counted(int& count) : live(&count) { ++*live; }
+    Counted(Counted&& other) : live(other.live) { ++*live; }
+    ~Counted() { --*live; }
+    int* live;
+  };
+
+  int live = 0;
+  {
+    std::array<internal::MpmcRing<Counted>::Slot, 4> slots;
+    internal::MpmcRing<Counted> ring(slots);
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_TRUE(ring.TryPush(Counted(live)));
+    }
+    EXPECT_EQ(live, 3);
+    ring.TryPop();
+    EXPECT_EQ(live, 2);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(LockFreeWorkQueue, PingPong) {
+  struct {
+    int counter = 0;
+    sync::ThreadNotification worker_ping;
+  } context;
+
+  LockFreeWorkQueueWithBuffer<8> work_queue;
+
+  // Start the worker thread.
+  Thread work_thread(test::WorkQueueThreadOptions(), work_queue);
+
+  // Pick a number bigger than the ring to ensure we loop around.
+  const int kPingPongs = 300;
+
+  for (int i = 0; i < kPingPongs; ++i) {
+    EXPECT_EQ(OkStatus(), work_queue.PushWork([&context] {
+      context.counter++;
+      context.worker_ping.release();
+    }));
+
+    // Throw a distraction in the queue.
+    EXPECT_EQ(OkStatus(), work_queue.PushWork([] {}));
+
+    context.worker_ping.acquire();
+  }
+
+  // Wait for the worker thread to terminate.
+  work_queue.RequestStop();
+  work_thread.join();
+
+  EXPECT_EQ(context.counter, kPingPongs);
+}
+
+TEST(LockFreeWorkQueue, CustomWorkItem) {
+  struct CustomWorkItem {
+    int counter;
+  };
+
+  int counter = 0;
+
+  CustomLockFreeWorkQueueWithBuffer<4, CustomWorkItem> work_queue(
+      [&counter](CustomWorkItem& work_item) { counter += work_item.counter; });
+
+  // Queue work before the worker starts, so that it runs in one batch.
+  EXPECT_EQ(OkStatus(), work_queue.PushWork({.counter = 5}));
+  EXPECT_EQ(OkStatus(), work_queue.PushWork({.counter = 10}));
+  EXPECT_EQ(OkStatus(), work_queue.PushWork({.counter = 20}));
+
+  Thread work_thread(test::WorkQueueThreadOptions(), work_queue);
+
+  // Wait for the worker thread to terminate.
+  work_queue.RequestStop();
+  work_thread.join();
+
+  EXPECT_EQ(counter, 5 + 10 + 20);
+}
+
+TEST(LockFreeWorkQueue, FullAndStoppedQueuesRejectWork) {
+  CustomLockFreeWorkQueueWithBuffer<2, int> work_queue([](int&) {});
+
+  EXPECT_EQ(OkStatus(), work_queue.PushWork(1));
+  EXPECT_EQ(OkStatus(), work_queue.PushWork(2));
+  EXPECT_EQ(Status::ResourceExhausted(), work_queue.PushWork(3));
+
+  work_queue.RequestStop();
+  EXPECT_EQ(Status::FailedPrecondition(), work_queue.PushWork(4));
+
+  // The worker still runs the queued work before returning.
+  Thread work_thread(test::WorkQueueThreadOptions(), work_queue);
+  work_thread.join();
+}
+
+TEST(LockFreeWorkQueue, MultipleWorkers) {
+  std::atomic<int> counter = 0;
+  LockFreeWorkQueueWithBuffer<16> work_queue;
+
+  std::array<thread::test::TestThreadContext, 3> contexts;
+  std::array<Thread, 3> work_threads;
+  for (size_t i = 0; i < work_threads.size(); ++i) {
+    work_threads[i] = Thread(contexts[i].options(), work_queue);
+  }
+
+  constexpr int kItems = 1000;
+  for (int i = 0; i < kItems; ++i) {
+    // Retry while the workers catch up with the producer.
+    while (work_queue.PushWork([&counter] { counter++; })
+               .IsResourceExhausted()) {
+      this_thread::yield();
+    }
+  }
+
+  work_queue.RequestStop();
+  for (Thread& thread : work_threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.load(), kItems);
+}
+
+}  // namespace
+}  // namespace pw::work_queue
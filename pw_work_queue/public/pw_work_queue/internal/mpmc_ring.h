@@ -0,0 +1,154 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_span/span.h"
+
+namespace pw::work_queue::internal {
+
+/// Bounded multi-producer, multi-consumer ring of `T`.
+///
+/// Each slot carries a sequence number that says whether it is ready to be
+/// written or read for a given lap around the ring, so producers and
+/// consumers only contend on their own index and never take a lock. Pushing
+/// and popping are lock-free and interrupt-safe, as long as an interrupt does
+/// not wait on a push or pop that it preempted.
+///
+/// The number of slots must be a power of two.
+template <typename T>
+class MpmcRing {
+ public:
+  /// Storage for one item. Arrays of slots are provided by the owner.
+  class Slot {
+   private:
+    friend class MpmcRing;
+
+    T& item() { return *std::launder(reinterpret_cast<T*>(&storage_)); }
+
+    std::atomic<size_t> sequence_;
+    alignas(T) std::byte storage_[sizeof(T)];
+  };
+
+  explicit MpmcRing(span<Slot> slots)
+      : slots_(slots), mask_(slots.size() - 1), head_(0), tail_(0) {
+    PW_ASSERT(!slots.empty() && (slots.size() & mask_) == 0);
+    for (size_t i = 0; i < slots.size(); ++i) {
+      slots_[i].sequence_.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcRing(const MpmcRing&) = delete;
+  MpmcRing& operator=(const MpmcRing&) = delete;
+
+  ~MpmcRing() {
+    while (TryPop().has_value()) {
+    }
+  }
+
+  /// Moves `item` into the ring. Returns false, leaving `item` untouched, if
+  /// the ring is full.
+  bool TryPush(T&& item) {
+    size_t position = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = slots_[position & mask_];
+      const size_t sequence = slot.sequence_.load(std::memory_order_acquire);
+      const auto lap = static_cast<ptrdiff_t>(sequence - position);
+      if (lap == 0) {
+        if (tail_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          new (&slot.storage_) T(std::move(item));
+          slot.sequence_.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lap < 0) {
+        return false;  // The slot still holds an item from the previous lap.
+      } else {
+        position = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Removes the oldest item, or returns `std::nullopt` if the ring is empty.
+  std::optional<T> TryPop() {
+    size_t position = head_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = slots_[position & mask_];
+      const size_t sequence = slot.sequence_.load(std::memory_order_acquire);
+      const auto lap = static_cast<ptrdiff_t>(sequence - (position + 1));
+      if (lap == 0) {
+        if (head_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          std::optional<T> item(std::move(slot.item()));
+          slot.item().~T();
+          slot.sequence_.store(position + slots_.size(),
+                               std::memory_order_release);
+          return item;
+        }
+      } else if (lap < 0) {
+        return std::nullopt;  // The slot has not been written this lap.
+      } else {
+        position = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Returns whether an item is ready to be popped.
+  bool empty() const {
+    size_t position = head_.load(std::memory_order_relaxed);
+    while (true) {
+      const size_t sequence =
+          slots_[position & mask_].sequence_.load(std::memory_order_acquire);
+      const auto lap = static_cast<ptrdiff_t>(sequence - (position + 1));
+      if (lap == 0) {
+        return false;
+      }
+      if (lap < 0) {
+        return true;
+      }
+      // Another consumer popped this slot; check the new head instead.
+      position = head_.load(std::memory_order_relaxed);
+    }
+  }
+
+  /// Returns the number of items in the ring. Only approximate while items are
+  /// being pushed or popped.
+  size_t size() const {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const auto size = static_cast<ptrdiff_t>(tail - head);
+    if (size < 0) {
+      return 0;
+    }
+    return std::min(static_cast<size_t>(size), slots_.size());
+  }
+
+  size_t capacity() const { return slots_.size(); }
+
+ private:
+  span<Slot> slots_;
+  const size_t mask_;
+  std::atomic<size_t> head_;
+  std::atomic<size_t> tail_;
+};
+
+}  // namespace pw::work_queue::internal
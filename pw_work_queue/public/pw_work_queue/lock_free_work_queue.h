@@ -0,0 +1,286 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_assert/assert.h"
+#include "pw_function/function.h"
+#include "pw_metric/metric.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_sync/counting_semaphore.h"
+#include "pw_thread/thread_core.h"
+#include "pw_work_queue/internal/mpmc_ring.h"
+
+namespace pw::work_queue {
+
+/// A work queue like `pw::work_queue::CustomWorkQueue`, backed by a lock-free
+/// ring instead of a locked queue.
+///
+/// **Batching**: Producers only signal the worker when it is waiting for work,
+/// and a woken worker runs every queued item before it waits again. A burst of
+/// `PushWork` calls therefore costs one wakeup instead of one per item, and
+/// producers never block each other or the worker.
+///
+/// **Multiple workers**: Like `CustomWorkQueue`, this class is a
+/// `pw::thread::ThreadCore`. Unlike it, the same queue may be run by several
+/// threads at once, each of which takes items from the shared ring. With more
+/// than one worker, work items run concurrently and may finish out of order,
+/// so `fn` must be thread-safe.
+///
+/// **Queue sizing**: The queue holds as many items as there are slots in the
+/// `slots` buffer passed into the constructor, which must be a power of two.
+/// `pw::work_queue::CustomLockFreeWorkQueueWithBuffer` provides the buffer.
+///
+/// **Cooperative thread cancellation**: `RequestStop()` stops the queue from
+/// accepting further work. Every worker returns once the queued work is done.
+///
+/// The entire API is thread-safe and interrupt-safe.
+template <typename WorkItem>
+class CustomLockFreeWorkQueue : public thread::ThreadCore {
+ public:
+  using Slot = typename internal::MpmcRing<WorkItem>::Slot;
+
+  /// @param[in] slots Storage for the enqueued work entries. The number of
+  /// slots must be a power of two.
+  ///
+  /// @param[in] fn The function to invoke on each enqueued WorkItem
+  CustomLockFreeWorkQueue(span<Slot> slots,
+                          pw::Function<void(WorkItem&)>&& fn)
+      : ring_(slots), fn_(std::move(fn)) {
+    min_queue_remaining_.Set(static_cast<uint32_t>(ring_.capacity()));
+  }
+
+  /// Enqueues a `work_item` for execution by a worker thread.
+  ///
+  /// @param[in] work_item The entry to enqueue.
+  ///
+  /// @returns @rst
+  ///
+  /// .. pw-status-codes::
+  ///
+  ///    OK: Success. Entry was enqueued for execution.
+  ///
+  ///    FAILED_PRECONDITION: The work queue is shutting down. Entries are no
+  ///    longer permitted.
+  ///
+  ///    RESOURCE_EXHAUSTED: Internal work queue is full. Entry was not
+  ///    enqueued.
+  ///
+  /// @endrst
+  Status PushWork(WorkItem&& work_item) {
+    return InternalPushWork(std::move(work_item));
+  }
+
+  /// Queues work for execution. Crashes if the work cannot be queued due to a
+  /// full queue or a stopped queue.
+  ///
+  /// @param[in] work_item The entry to enqueue.
+  ///
+  /// @pre
+  /// * The queue must not overflow, i.e. be full.
+  /// * The queue must not have been requested to stop, i.e. it must
+  ///   not be in the process of shutting down.
+  void CheckPushWork(WorkItem&& work_item) {
+    PW_ASSERT_OK(InternalPushWork(std::move(work_item)),
+                 "Failed to push work item into the work queue");
+  }
+  void CheckPushWork(WorkItem& work_item) {
+    PW_ASSERT_OK(InternalPushWork(std::move(work_item)),
+                 "Failed to push work item into the work queue");
+  }
+
+  /// Prevents further work enqueing, finishes outstanding work, then shuts
+  /// down every worker thread.
+  ///
+  /// The queue cannot be resumed after stopping. It must be reconstructed for
+  /// re-use after its threads have been joined.
+  void RequestStop() {
+    state_.fetch_or(kStopRequested);
+    WakeAllWorkers();
+  }
+
+ private:
+  // state_ holds the stop flag and the number of PushWork calls in progress,
+  // so that workers only return once no more items can be pushed.
+  static constexpr uint32_t kStopRequested = uint32_t{1} << 31;
+
+  void Run() override {
+    while (true) {
+      // Run everything that is queued before waiting again, so that a burst of
+      // pushes only wakes the worker once.
+      while (std::optional<WorkItem> work_item = ring_.TryPop()) {
+        fn_(*work_item);
+      }
+      if (Stopped()) {
+        return;
+      }
+      WaitForWork();
+    }
+  }
+
+  // True once stop was requested, no push is in progress, and the queue is
+  // drained.
+  bool Stopped() const {
+    return state_.load() == kStopRequested && ring_.empty();
+  }
+
+  void WaitForWork() {
+    // Register as waiting before checking for work. A producer that pushes
+    // after the check sees the registration and releases the semaphore.
+    sleeping_workers_.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (ring_.empty() && !Stopped()) {
+      work_semaphore_.acquire();
+      // Allow the next push to wake another worker. Clearing the flag before
+      // checking the ring again ensures that an item pushed while it was set
+      // is seen here.
+      wake_pending_.store(false);
+    }
+    sleeping_workers_.fetch_sub(1);
+  }
+
+  // Wakes a waiting worker, if any. Only one wakeup is outstanding at a time,
+  // since the woken worker drains every queued item before waiting again.
+  void WakeOneWorker() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_workers_.load() > 0 && !wake_pending_.exchange(true)) {
+      work_semaphore_.release();
+    }
+  }
+
+  // Releases the semaphore once per waiting worker. Not every backend wakes
+  // more than one waiter for a single release(n) call.
+  void WakeAllWorkers() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (uint32_t i = sleeping_workers_.load(); i > 0; --i) {
+      work_semaphore_.release();
+    }
+  }
+
+  // Marks a push as finished. The last push to finish after a stop request
+  // wakes the workers so that they can return.
+  void FinishPush() {
+    if (state_.fetch_sub(1) - 1 == kStopRequested) {
+      WakeAllWorkers();
+    }
+  }
+
+  Status InternalPushWork(WorkItem&& work_item) {
+    if ((state_.fetch_add(1) & kStopRequested) != 0) {
+      // Entries are not permitted to be enqueued once stop has been requested.
+      FinishPush();
+      return Status::FailedPrecondition();
+    }
+
+    if (!ring_.TryPush(std::move(work_item))) {
+      FinishPush();
+      return Status::ResourceExhausted();
+    }
+    UpdateWatermarks();
+    FinishPush();
+    WakeOneWorker();
+    return OkStatus();
+  }
+
+  // Updates the watermarks for the queue. The metrics are only written when a
+  // watermark moves, so that producers rarely write to shared memory.
+  void UpdateWatermarks() {
+    const uint32_t queue_entries = static_cast<uint32_t>(ring_.size());
+    if (queue_entries > max_queue_used_.value()) {
+      max_queue_used_.Set(queue_entries);
+    }
+    const uint32_t queue_remaining =
+        static_cast<uint32_t>(ring_.capacity()) - queue_entries;
+    if (queue_remaining < min_queue_remaining_.value()) {
+      min_queue_remaining_.Set(queue_remaining);
+    }
+  }
+
+  std::atomic<uint32_t> state_{0};
+  std::atomic<uint32_t> sleeping_workers_{0};
+  std::atomic<bool> wake_pending_{false};
+  sync::CountingSemaphore work_semaphore_;
+  internal::MpmcRing<WorkItem> ring_;
+  pw::Function<void(WorkItem&)> fn_;
+
+  PW_METRIC_GROUP(metrics_, "pw::work_queue::LockFreeWorkQueue");
+  PW_METRIC(metrics_, max_queue_used_, "max_queue_used", 0u);
+  PW_METRIC(metrics_, min_queue_remaining_, "min_queue_remaining", 0u);
+};
+
+/// Creates a lock-free work queue that enqueues `pw_function::Closure` and
+/// whose worker threads invoke the Closure.
+class LockFreeWorkQueue : public CustomLockFreeWorkQueue<Closure> {
+ public:
+  /// @param[in] slots Storage for the enqueued work entries. The number of
+  /// slots must be a power of two.
+  LockFreeWorkQueue(span<Slot> slots)
+      : CustomLockFreeWorkQueue(slots, [](Closure& fn) { fn(); }) {}
+};
+
+namespace internal {
+
+// Storage base class for the LockFreeWorkQueueWithBuffer classes, initialized
+// before it is passed to the CustomLockFreeWorkQueue base.
+template <typename WorkItem, size_t kWorkQueueEntries>
+struct LockFreeStorage {
+  static_assert(kWorkQueueEntries > 0 &&
+                    (kWorkQueueEntries & (kWorkQueueEntries - 1)) == 0,
+                "The number of work queue entries must be a power of two");
+
+  std::array<typename MpmcRing<WorkItem>::Slot, kWorkQueueEntries> slots;
+};
+
+}  // namespace internal
+
+/// Creates a lock-free work queue and the backing ring.
+///
+/// @param kWorkQueueEntries The number of entries in the work queue. Must be a
+/// power of two.
+///
+/// @param WorkItem The type that will enqueued.
+template <size_t kWorkQueueEntries, typename WorkItem>
+class CustomLockFreeWorkQueueWithBuffer
+    : private internal::LockFreeStorage<WorkItem, kWorkQueueEntries>,
+      public CustomLockFreeWorkQueue<WorkItem> {
+ public:
+  /// @param[in] fn The function to invoke on each enqueued WorkItem
+  CustomLockFreeWorkQueueWithBuffer(pw::Function<void(WorkItem&)>&& fn)
+      : CustomLockFreeWorkQueue<WorkItem>(
+            internal::LockFreeStorage<WorkItem, kWorkQueueEntries>::slots,
+            std::move(fn)) {}
+};
+
+/// Creates a lock-free work queue that enqueues `pw_function::Closure`, and
+/// the backing ring.
+///
+/// @param kWorkQueueEntries The number of entries in the work queue. Must be a
+/// power of two.
+template <size_t kWorkQueueEntries>
+class LockFreeWorkQueueWithBuffer
+    : private internal::LockFreeStorage<Closure, kWorkQueueEntries>,
+      public LockFreeWorkQueue {
+ public:
+  LockFreeWorkQueueWithBuffer()
+      : LockFreeWorkQueue(
+            internal::LockFreeStorage<Closure, kWorkQueueEntries>::slots) {}
+};
+
+}  // namespace pw::work_queue
@@ -0,0 +1,147 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/check.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_work_queue/lock_free_work_queue.h"
+#include "pw_work_queue/work_queue.h"
+
+namespace pw::work_queue {
+namespace {
+
+// Compares the locked `WorkQueue` with the `LockFreeWorkQueue`, run by one
+// and by two worker threads. Latency is measured by pushing one item and
+// waiting for it to run. Throughput is measured by pushing a burst of items
+// and waiting for all of them to run.
+
+constexpr size_t kQueueSize = 16;
+constexpr size_t kBurstSize = kQueueSize;
+constexpr size_t kMaxWorkers = 2;
+
+/// Runs a work queue on worker threads until destroyed.
+template <typename Queue>
+class Workers {
+ public:
+  Workers(Queue& queue, size_t num_workers) : queue_(queue) {
+    PW_CHECK_UINT_LE(num_workers, kMaxWorkers);
+    for (size_t i = 0; i < num_workers; ++i) {
+      threads_[i] = Thread(contexts_[i].options(), queue_);
+    }
+  }
+
+  ~Workers() {
+    queue_.RequestStop();
+#if PW_THREAD_JOINING_ENABLED
+    for (Thread& thread : threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+#endif  // PW_THREAD_JOINING_ENABLED
+  }
+
+ private:
+  Queue& queue_;
+  std::array<thread::test::TestThreadContext, kMaxWorkers> contexts_;
+  std::array<Thread, kMaxWorkers> threads_;
+};
+
+template <typename Queue>
+void PushAndWait(perf_test::State& state, Queue& queue, size_t num_workers) {
+  Workers<Queue> workers(queue, num_workers);
+  sync::ThreadNotification done;
+  while (state.KeepRunning()) {
+    queue.CheckPushWork([&done] { done.release(); });
+    done.acquire();
+  }
+}
+
+/// Signals once every item in a burst has run.
+class Burst {
+ public:
+  void Start() { remaining_.store(kBurstSize, std::memory_order_relaxed); }
+
+  void ItemDone() {
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      done_.release();
+    }
+  }
+
+  void Wait() { done_.acquire(); }
+
+ private:
+  std::atomic<size_t> remaining_ = 0;
+  sync::ThreadNotification done_;
+};
+
+template <typename Queue>
+void PushBurstAndWait(perf_test::State& state,
+                      Queue& queue,
+                      size_t num_workers) {
+  Workers<Queue> workers(queue, num_workers);
+  Burst burst;
+  while (state.KeepRunning()) {
+    burst.Start();
+    for (size_t i = 0; i < kBurstSize; ++i) {
+      queue.CheckPushWork([&burst] { burst.ItemDone(); });
+    }
+    burst.Wait();
+  }
+}
+
+void WorkQueueLatency(perf_test::State& state) {
+  WorkQueueWithBuffer<kQueueSize> queue;
+  PushAndWait(state, queue, 1);
+}
+
+void LockFreeWorkQueueLatency(perf_test::State& state, size_t num_workers) {
+  LockFreeWorkQueueWithBuffer<kQueueSize> queue;
+  PushAndWait(state, queue, num_workers);
+}
+
+void WorkQueueThroughput(perf_test::State& state) {
+  WorkQueueWithBuffer<kQueueSize> queue;
+  PushBurstAndWait(state, queue, 1);
+}
+
+void LockFreeWorkQueueThroughput(perf_test::State& state,
+                                 size_t num_workers) {
+  LockFreeWorkQueueWithBuffer<kQueueSize> queue;
+  PushBurstAndWait(state, queue, num_workers);
+}
+
+#if PW_THREAD_JOINING_ENABLED
+PW_PERF_TEST(WorkQueueLatency, WorkQueueLatency);
+PW_PERF_TEST(LockFreeWorkQueueLatency1Worker, LockFreeWorkQueueLatency, 1);
+PW_PERF_TEST(LockFreeWorkQueueLatency2Workers, LockFreeWorkQueueLatency, 2);
+
+PW_PERF_TEST(WorkQueueThroughput16, WorkQueueThroughput);
+PW_PERF_TEST(LockFreeWorkQueueThroughput16With1Worker,
+             LockFreeWorkQueueThroughput,
+             1);
+PW_PERF_TEST(LockFreeWorkQueueThroughput16With2Workers,
+             LockFreeWorkQueueThroughput,
+             2);
+#endif  // PW_THREAD_JOINING_ENABLED
+
+}  // namespace
+}  // namespace pw::work_queue